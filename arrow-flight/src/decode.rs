@@ -0,0 +1,336 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Decoding streams of [`FlightData`] into Arrow record batches
+
+use std::pin::Pin;
+use std::ptr::NonNull;
+use std::sync::Arc;
+use std::task::{Context, Poll};
+
+use arrow::array::ArrayRef;
+use arrow::buffer::Buffer;
+use arrow::datatypes::SchemaRef;
+use arrow::error::{ArrowError, Result};
+use arrow::ipc::{self, convert, reader};
+use arrow::record_batch::RecordBatch;
+use futures::Stream;
+
+use crate::FlightData;
+
+/// Decodes the messages of a Flight stream: a schema followed by dictionary batches
+/// and record batches. The decoder keeps the dictionaries it reads to decode the
+/// record batches that use them.
+///
+/// The message bodies are not copied. The arrays of the decoded batches share the
+/// memory of [`FlightData::data_body`], except for buffers that are compressed or
+/// not aligned.
+#[derive(Debug, Default)]
+pub struct FlightDataDecoder {
+    schema: Option<SchemaRef>,
+    dictionaries_by_field: Vec<Option<ArrayRef>>,
+}
+
+impl FlightDataDecoder {
+    /// Creates a decoder of a stream that starts with a schema message.
+    pub fn new() -> Self {
+        Self::default()
+    }
+
+    /// Creates a decoder of a stream whose schema is already known, for example from
+    /// the `FlightInfo`. Such a stream may skip the schema message.
+    pub fn with_schema(schema: SchemaRef) -> Self {
+        Self {
+            dictionaries_by_field: vec![None; schema.fields().len()],
+            schema: Some(schema),
+        }
+    }
+
+    /// Returns the schema of the stream, if it is known yet.
+    pub fn schema(&self) -> Option<&SchemaRef> {
+        self.schema.as_ref()
+    }
+
+    /// Decodes the message `data`. Returns its record batch, or `None` if the message
+    /// is a schema or a dictionary batch, which only updates this decoder.
+    pub fn decode(&mut self, data: FlightData) -> Result<Option<RecordBatch>> {
+        let message = ipc::root_as_message(&data.data_header[..]).map_err(|err| {
+            ArrowError::ParseError(format!("Unable to get root as message: {:?}", err))
+        })?;
+
+        match message.header_type() {
+            ipc::MessageHeader::Schema => {
+                let schema = message.header_as_schema().ok_or_else(|| {
+                    ArrowError::IoError("Unable to read IPC message as schema".to_string())
+                })?;
+                let schema = convert::fb_to_schema(schema);
+                self.dictionaries_by_field = vec![None; schema.fields().len()];
+                self.schema = Some(Arc::new(schema));
+                Ok(None)
+            }
+            ipc::MessageHeader::DictionaryBatch => {
+                let schema = self.schema.as_ref().ok_or_else(missing_schema)?;
+                let batch = message.header_as_dictionary_batch().ok_or_else(|| {
+                    ArrowError::IoError(
+                        "Unable to read IPC message as dictionary batch".to_string(),
+                    )
+                })?;
+                reader::read_dictionary_from_buffer(
+                    &body_buffer(data.data_body),
+                    batch,
+                    schema,
+                    &mut self.dictionaries_by_field,
+                )?;
+                Ok(None)
+            }
+            ipc::MessageHeader::RecordBatch => {
+                let schema = self.schema.as_ref().ok_or_else(missing_schema)?;
+                let batch = message.header_as_record_batch().ok_or_else(|| {
+                    ArrowError::IoError(
+                        "Unable to read IPC message as record batch".to_string(),
+                    )
+                })?;
+                reader::read_record_batch_from_buffer(
+                    &body_buffer(data.data_body),
+                    batch,
+                    schema.clone(),
+                    &self.dictionaries_by_field,
+                )
+                .map(Some)
+            }
+            t => Err(ArrowError::IoError(format!(
+                "Reading types other than record batches not yet supported, unable to read {:?}",
+                t
+            ))),
+        }
+    }
+}
+
+fn missing_schema() -> ArrowError {
+    ArrowError::IoError(
+        "Unable to read a batch before the schema of the Flight stream".to_string(),
+    )
+}
+
+/// Wraps the message body `body` in a buffer, without copying it.
+fn body_buffer(body: Vec<u8>) -> Buffer {
+    let len = body.len();
+    let body = Arc::new(body);
+    // the buffer keeps the `Vec` alive, and its memory does not move when it does
+    unsafe {
+        let ptr = NonNull::new_unchecked(body.as_ptr() as *mut u8);
+        Buffer::from_custom_allocation(ptr, len, body)
+    }
+}
+
+/// A stream of the record batches decoded from a stream of [`FlightData`], such as
+/// the response of `do_get`, with a [`FlightDataDecoder`].
+///
+/// Errors of the stream of [`FlightData`] are returned as
+/// [`ArrowError::ExternalError`].
+#[derive(Debug)]
+pub struct FlightRecordBatchStream<S> {
+    inner: S,
+    decoder: FlightDataDecoder,
+}
+
+impl<S> FlightRecordBatchStream<S> {
+    /// Creates a stream of the record batches of `inner`, which starts with a schema
+    /// message.
+    pub fn new(inner: S) -> Self {
+        Self::with_decoder(inner, FlightDataDecoder::new())
+    }
+
+    /// Creates a stream of the record batches of `inner`, decoded with `decoder`.
+    pub fn with_decoder(inner: S, decoder: FlightDataDecoder) -> Self {
+        Self { inner, decoder }
+    }
+
+    /// Returns the schema of the stream, if it is known yet.
+    pub fn schema(&self) -> Option<&SchemaRef> {
+        self.decoder.schema()
+    }
+
+    /// Returns the stream of [`FlightData`].
+    pub fn into_inner(self) -> S {
+        self.inner
+    }
+}
+
+impl<S, E> Stream for FlightRecordBatchStream<S>
+where
+    S: Stream<Item = std::result::Result<FlightData, E>> + Unpin,
+    E: std::error::Error + Send + Sync + 'static,
+{
+    type Item = Result<RecordBatch>;
+
+    fn poll_next(
+        mut self: Pin<&mut Self>,
+        cx: &mut Context<'_>,
+    ) -> Poll<Option<Self::Item>> {
+        loop {
+            let data = match Pin::new(&mut self.inner).poll_next(cx) {
+                Poll::Ready(Some(Ok(data))) => data,
+                Poll::Ready(Some(Err(err))) => {
+                    return Poll::Ready(Some(Err(ArrowError::ExternalError(Box::new(
+                        err,
+                    )))))
+                }
+                Poll::Ready(None) => return Poll::Ready(None),
+                Poll::Pending => return Poll::Pending,
+            };
+            match self.decoder.decode(data) {
+                Ok(Some(batch)) => return Poll::Ready(Some(Ok(batch))),
+                Ok(None) => continue,
+                Err(err) => return Poll::Ready(Some(Err(err))),
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use arrow::array::{Array, DictionaryArray, Int32Array, StringArray};
+    use arrow::compute::concat;
+    use arrow::datatypes::Int8Type;
+    use arrow::ipc::writer::IpcWriteOptions;
+    use futures::StreamExt;
+
+    use crate::encode::{FlightDataEncoder, FlightDataStream};
+
+    fn test_batch(len: usize) -> RecordBatch {
+        let keys: DictionaryArray<Int8Type> =
+            (0..len).map(|i| ["a", "b", "c"][i % 3]).collect();
+        let values = Int32Array::from((0..len as i32).collect::<Vec<_>>());
+        let strings: StringArray = (0..len)
+            .map(|i| Some(format!("value {}", i)).filter(|_| i % 4 != 0))
+            .collect();
+        RecordBatch::try_from_iter(vec![
+            ("keys", Arc::new(keys) as ArrayRef),
+            ("values", Arc::new(values) as ArrayRef),
+            ("strings", Arc::new(strings) as ArrayRef),
+        ])
+        .unwrap()
+    }
+
+    /// Asserts that `batches` have the rows of `expected`, in order.
+    fn assert_rows(batches: &[RecordBatch], expected: &RecordBatch) {
+        let mut offset = 0;
+        for batch in batches {
+            assert_eq!(batch.schema(), expected.schema());
+            for (column, expected_column) in
+                batch.columns().iter().zip(expected.columns())
+            {
+                let expected_column =
+                    concat(&[expected_column.slice(offset, batch.num_rows()).as_ref()])
+                        .unwrap();
+                assert_eq!(column, &expected_column);
+            }
+            offset += batch.num_rows();
+        }
+        assert_eq!(offset, expected.num_rows());
+    }
+
+    #[test]
+    fn test_decode_split_batches() {
+        let batch = test_batch(1000);
+        let mut encoder = FlightDataEncoder::new(IpcWriteOptions::default())
+            .with_max_message_size(4096);
+        let mut messages = vec![encoder.encode_schema(&batch.schema())];
+        messages.extend(encoder.encode_batch(&batch).unwrap());
+        // a new dictionary with the same values is not sent again
+        let num_messages = messages.len();
+        messages.extend(encoder.encode_batch(&test_batch(1000)).unwrap());
+        assert_eq!(messages.len(), 2 * num_messages - 2);
+
+        let mut decoder = FlightDataDecoder::new();
+        let mut batches = vec![];
+        for data in messages {
+            assert!(data.data_body.len() <= 4096);
+            let body = data.data_body.as_ptr_range();
+            if let Some(batch) = decoder.decode(data).unwrap() {
+                let values = batch.column(1).data().buffers()[0].as_ptr();
+                if body.start as usize % 8 == 0 {
+                    assert!(body.contains(&values), "the values were copied");
+                }
+                batches.push(batch);
+            }
+        }
+        assert!(batches.len() > 2);
+        assert_rows(&batches[..batches.len() / 2], &batch);
+        assert_rows(&batches[batches.len() / 2..], &batch);
+    }
+
+    #[test]
+    fn test_encode_sliced_batch() {
+        let batch = test_batch(1000);
+        let columns = batch.columns().iter().map(|c| c.slice(500, 10)).collect();
+        let sliced = RecordBatch::try_new(batch.schema(), columns).unwrap();
+        let mut encoder = FlightDataEncoder::new(IpcWriteOptions::default())
+            .with_max_message_size(4096);
+        // only the rows of the slice count, so they are copied into a single batch
+        let messages = encoder.encode_batch(&sliced).unwrap();
+        assert_eq!(messages.len(), 2);
+
+        let mut decoder = FlightDataDecoder::with_schema(batch.schema());
+        let mut batches = vec![];
+        for data in messages {
+            assert!(data.data_body.len() <= 4096);
+            batches.extend(decoder.decode(data).unwrap());
+        }
+        assert_rows(&batches, &sliced);
+    }
+
+    #[test]
+    fn test_decode_without_schema() {
+        let batch = test_batch(10);
+        let mut encoder = FlightDataEncoder::new(IpcWriteOptions::default());
+        let messages = encoder.encode_batch(&batch).unwrap();
+
+        let mut decoder = FlightDataDecoder::new();
+        let err = decoder.decode(messages[0].clone()).unwrap_err();
+        assert!(err.to_string().contains("before the schema"));
+
+        let mut decoder = FlightDataDecoder::with_schema(batch.schema());
+        let mut batches = vec![];
+        for data in messages {
+            batches.extend(decoder.decode(data).unwrap());
+        }
+        assert_rows(&batches, &batch);
+    }
+
+    #[tokio::test]
+    async fn test_record_batch_stream() {
+        let batch = test_batch(100);
+        let batches = vec![Ok(batch.clone()), Ok(batch.clone())];
+        let encoder = FlightDataEncoder::new(IpcWriteOptions::default());
+        let messages = FlightDataStream::new(
+            batch.schema(),
+            futures::stream::iter(batches),
+            encoder,
+        );
+
+        let stream = FlightRecordBatchStream::new(messages);
+        let decoded: Vec<RecordBatch> =
+            stream.map(|batch| batch.unwrap()).collect().await;
+        assert_eq!(decoded.len(), 2);
+        assert_rows(&decoded[..1], &batch);
+        assert_rows(&decoded[1..], &batch);
+    }
+}
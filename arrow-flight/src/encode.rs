@@ -0,0 +1,215 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Encoding Arrow record batches into streams of [`FlightData`]
+
+use std::cmp;
+use std::collections::VecDeque;
+use std::pin::Pin;
+use std::task::{Context, Poll};
+
+use arrow::compute::{concat, estimate_array_bytes};
+use arrow::datatypes::{Schema, SchemaRef};
+use arrow::error::Result;
+use arrow::ipc::writer::{DictionaryTracker, IpcDataGenerator, IpcWriteOptions};
+use arrow::record_batch::RecordBatch;
+use futures::Stream;
+
+use crate::FlightData;
+
+/// Encodes record batches as the messages of a Flight stream. It emits the
+/// dictionaries of each batch before the batch, but only when they were not sent
+/// yet or have changed since.
+///
+/// # Example
+/// ```
+/// # use std::sync::Arc;
+/// # use arrow::array::{DictionaryArray, Int32Array};
+/// # use arrow::datatypes::Int8Type;
+/// # use arrow::ipc::writer::IpcWriteOptions;
+/// # use arrow::record_batch::RecordBatch;
+/// # use arrow_flight::decode::FlightDataDecoder;
+/// # use arrow_flight::encode::FlightDataEncoder;
+/// let keys: DictionaryArray<Int8Type> = vec!["a", "b", "a"].into_iter().collect();
+/// let values = Int32Array::from(vec![1, 2, 3]);
+/// let batch = RecordBatch::try_from_iter(vec![
+///     ("keys", Arc::new(keys) as _),
+///     ("values", Arc::new(values) as _),
+/// ])
+/// .unwrap();
+///
+/// let mut encoder = FlightDataEncoder::new(IpcWriteOptions::default());
+/// let mut messages = vec![encoder.encode_schema(&batch.schema())];
+/// messages.extend(encoder.encode_batch(&batch).unwrap());
+/// // the dictionary is only sent with the first batch
+/// assert_eq!(messages.len(), 3);
+/// messages.extend(encoder.encode_batch(&batch).unwrap());
+/// assert_eq!(messages.len(), 4);
+///
+/// let mut decoder = FlightDataDecoder::new();
+/// let mut batches = vec![];
+/// for message in messages {
+///     batches.extend(decoder.decode(message).unwrap());
+/// }
+/// assert_eq!(batches.len(), 2);
+/// assert_eq!(batches[1].column(0), batch.column(0));
+/// ```
+#[derive(Debug)]
+pub struct FlightDataEncoder {
+    options: IpcWriteOptions,
+    data_gen: IpcDataGenerator,
+    dictionary_tracker: DictionaryTracker,
+    max_message_size: Option<usize>,
+}
+
+impl FlightDataEncoder {
+    /// Creates an encoder which writes the messages with the options `options`.
+    pub fn new(options: IpcWriteOptions) -> Self {
+        Self {
+            options,
+            data_gen: IpcDataGenerator::default(),
+            dictionary_tracker: DictionaryTracker::new(false),
+            max_message_size: None,
+        }
+    }
+
+    /// Splits the record batches whose arrays take more than `max_message_size` bytes
+    /// into batches of fewer rows. This keeps the messages under the size limit of the
+    /// gRPC transport, which is 4MB by default.
+    ///
+    /// The rows of the split batches are copied, because IPC messages cannot reference
+    /// a slice of an array.
+    ///
+    /// The dictionaries of dictionary arrays are sent in their own messages, which are
+    /// not split, and so may be larger than `max_message_size`.
+    pub fn with_max_message_size(mut self, max_message_size: usize) -> Self {
+        self.max_message_size = Some(max_message_size);
+        self
+    }
+
+    /// Encodes the schema message, which starts a stream.
+    pub fn encode_schema(&self, schema: &Schema) -> FlightData {
+        self.data_gen.schema_to_bytes(schema, &self.options).into()
+    }
+
+    /// Encodes `batch` as the messages of its new or changed dictionaries, followed by
+    /// the messages of its rows.
+    pub fn encode_batch(&mut self, batch: &RecordBatch) -> Result<Vec<FlightData>> {
+        let mut messages = vec![];
+        for batch in self.split_batch(batch)? {
+            let (dictionaries, batch) = self.data_gen.encoded_batch(
+                &batch,
+                &mut self.dictionary_tracker,
+                &self.options,
+            )?;
+            messages.extend(dictionaries.into_iter().map(Into::into));
+            messages.push(batch.into());
+        }
+        Ok(messages)
+    }
+
+    /// Splits `batch` into batches of rows whose arrays take about `max_message_size`
+    /// bytes.
+    fn split_batch(&self, batch: &RecordBatch) -> Result<Vec<RecordBatch>> {
+        let num_rows = batch.num_rows();
+        let buffer_size: usize = batch
+            .columns()
+            .iter()
+            .map(|column| column.get_buffer_memory_size())
+            .sum();
+        let max_message_size = match self.max_message_size {
+            Some(max_message_size) if buffer_size > max_message_size && num_rows > 0 => {
+                max_message_size
+            }
+            _ => return Ok(vec![batch.clone()]),
+        };
+
+        // the buffers of sliced arrays also have the rows outside of the slice, which
+        // are not copied into the split batches
+        let size: usize = batch
+            .columns()
+            .iter()
+            .map(|column| estimate_array_bytes(column.data_ref()))
+            .sum();
+        let num_batches = cmp::max((size + max_message_size - 1) / max_message_size, 1);
+        let batch_rows = (num_rows + num_batches - 1) / num_batches;
+        (0..num_rows)
+            .step_by(batch_rows)
+            .map(|offset| {
+                let len = cmp::min(batch_rows, num_rows - offset);
+                let columns = batch
+                    .columns()
+                    .iter()
+                    .map(|column| concat(&[column.slice(offset, len).as_ref()]))
+                    .collect::<Result<Vec<_>>>()?;
+                RecordBatch::try_new(batch.schema(), columns)
+            })
+            .collect()
+    }
+}
+
+/// A stream of the [`FlightData`] messages of a stream of record batches, such as
+/// the response of `do_get`. It starts with the schema message, then the messages
+/// that a [`FlightDataEncoder`] produces for each batch.
+#[derive(Debug)]
+pub struct FlightDataStream<S> {
+    inner: S,
+    encoder: FlightDataEncoder,
+    queue: VecDeque<FlightData>,
+}
+
+impl<S> FlightDataStream<S> {
+    /// Creates a stream of the messages of the batches of `inner`, which have the
+    /// schema `schema`, encoded with `encoder`.
+    pub fn new(schema: SchemaRef, inner: S, encoder: FlightDataEncoder) -> Self {
+        let mut queue = VecDeque::new();
+        queue.push_back(encoder.encode_schema(&schema));
+        Self {
+            inner,
+            encoder,
+            queue,
+        }
+    }
+}
+
+impl<S> Stream for FlightDataStream<S>
+where
+    S: Stream<Item = Result<RecordBatch>> + Unpin,
+{
+    type Item = Result<FlightData>;
+
+    fn poll_next(
+        mut self: Pin<&mut Self>,
+        cx: &mut Context<'_>,
+    ) -> Poll<Option<Self::Item>> {
+        loop {
+            if let Some(data) = self.queue.pop_front() {
+                return Poll::Ready(Some(Ok(data)));
+            }
+            let batch = match Pin::new(&mut self.inner).poll_next(cx) {
+                Poll::Ready(Some(Ok(batch))) => batch,
+                Poll::Ready(Some(Err(err))) => return Poll::Ready(Some(Err(err))),
+                Poll::Ready(None) => return Poll::Ready(None),
+                Poll::Pending => return Poll::Pending,
+            };
+            match self.encoder.encode_batch(&batch) {
+                Ok(messages) => self.queue.extend(messages),
+                Err(err) => return Poll::Ready(Some(Err(err))),
+            }
+        }
+    }
+}
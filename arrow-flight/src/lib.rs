@@ -17,4 +17,6 @@
 
 include!("arrow.flight.protocol.rs");
 
+pub mod decode;
+pub mod encode;
 pub mod utils;
@@ -91,6 +91,7 @@ fn add_benchmark(c: &mut Criterion) {
     let i64_array = build_array::<Int64Type>(512);
     let f32_array = build_array::<Float32Type>(512);
     let f32_utf8_array = cast(&build_array::<Float32Type>(512), &DataType::Utf8).unwrap();
+    let i32_utf8_array = cast(&build_array::<Int32Type>(512), &DataType::Utf8).unwrap();
 
     let f64_array = build_array::<Float64Type>(512);
     let date64_array = build_array::<Date64Type>(512);
@@ -163,6 +164,12 @@ fn add_benchmark(c: &mut Criterion) {
     c.bench_function("cast utf8 to f32", |b| {
         b.iter(|| cast_array(&f32_utf8_array, DataType::Float32))
     });
+    c.bench_function("cast utf8 to i32 512", |b| {
+        b.iter(|| cast_array(&i32_utf8_array, DataType::Int32))
+    });
+    c.bench_function("cast utf8 to decimal 512", |b| {
+        b.iter(|| cast_array(&f32_utf8_array, DataType::Decimal(38, 10)))
+    });
     c.bench_function("cast i64 to string 512", |b| {
         b.iter(|| cast_array(&i64_array, DataType::Utf8))
     });
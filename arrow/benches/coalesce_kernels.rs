@@ -0,0 +1,87 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#[macro_use]
+extern crate criterion;
+use criterion::Criterion;
+
+extern crate arrow;
+
+use std::sync::Arc;
+
+use arrow::array::*;
+use arrow::compute::{filter_record_batch, BatchCoalescer};
+use arrow::datatypes::Int32Type;
+use arrow::record_batch::RecordBatch;
+use arrow::util::bench_util::*;
+
+/// Coalesces the rows of `batches` selected by `filter` into batches of 8192 rows,
+/// filtering each batch first, as a pipeline does without `push_filtered`.
+fn bench_filter_then_coalesce(batches: &[RecordBatch], filter: &BooleanArray) {
+    let mut coalescer = BatchCoalescer::new(batches[0].schema(), 8192);
+    for batch in batches {
+        coalescer
+            .push(filter_record_batch(batch, filter).unwrap())
+            .unwrap();
+    }
+    coalescer.finish().unwrap();
+    while let Some(batch) = coalescer.next_batch() {
+        criterion::black_box(batch);
+    }
+}
+
+fn bench_push_filtered(batches: &[RecordBatch], filter: &BooleanArray) {
+    let mut coalescer = BatchCoalescer::new(batches[0].schema(), 8192);
+    for batch in batches {
+        coalescer.push_filtered(batch.clone(), filter).unwrap();
+    }
+    coalescer.finish().unwrap();
+    while let Some(batch) = coalescer.next_batch() {
+        criterion::black_box(batch);
+    }
+}
+
+fn add_benchmark(c: &mut Criterion) {
+    let size = 8192;
+    let batches = (0..16)
+        .map(|_| {
+            RecordBatch::try_from_iter(vec![
+                (
+                    "ints",
+                    Arc::new(create_primitive_array::<Int32Type>(size, 0.1)) as ArrayRef,
+                ),
+                (
+                    "strings",
+                    Arc::new(create_string_array::<i32>(size, 0.1)) as ArrayRef,
+                ),
+            ])
+            .unwrap()
+        })
+        .collect::<Vec<_>>();
+
+    for &(name, true_density) in &[("1%", 0.01), ("50%", 0.5)] {
+        let filter = create_boolean_array(size, 0.0, true_density);
+        c.bench_function(&format!("filter then coalesce {}", name), |b| {
+            b.iter(|| bench_filter_then_coalesce(&batches, &filter))
+        });
+        c.bench_function(&format!("coalesce filtered {}", name), |b| {
+            b.iter(|| bench_push_filtered(&batches, &filter))
+        });
+    }
+}
+
+criterion_group!(benches, add_benchmark);
+criterion_main!(benches);
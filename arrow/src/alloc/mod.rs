@@ -26,9 +26,11 @@ use std::{
 };
 
 mod alignment;
+mod pool;
 mod types;
 
 pub use alignment::ALIGNMENT;
+pub use pool::{MemoryPool, TrackingMemoryPool};
 pub use types::NativeType;
 
 // If this number is not zero after all objects have been `drop`, there is a memory leak
@@ -0,0 +1,318 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Defines [`MemoryPool`], a source of cache-aligned memory regions that accounts for
+//! the memory it allocates, and [`TrackingMemoryPool`], a pool with an optional limit
+//! which reuses the regions freed into it.
+
+use std::collections::HashMap;
+use std::fmt::Debug;
+use std::ptr::NonNull;
+use std::sync::atomic::{AtomicUsize, Ordering};
+use std::sync::Mutex;
+
+use crate::error::{ArrowError, Result};
+
+use super::{allocate_aligned, free_aligned, null_pointer, reallocate, ALIGNMENT};
+
+/// A source of memory regions aligned to [`ALIGNMENT`], from which
+/// [`MutableBuffer`](crate::buffer::MutableBuffer)s can allocate, see
+/// [`MutableBuffer::try_with_capacity_in`](crate::buffer::MutableBuffer::try_with_capacity_in).
+///
+/// Unlike the functions of [`alloc`](crate::alloc), a pool returns an error instead of
+/// allocating when it cannot provide a region, for example because of a limit.
+/// Like them, a pool returns a dangling pointer for regions of `0` bytes, and freeing
+/// such a region does nothing.
+pub trait MemoryPool: Debug + Send + Sync {
+    /// Allocates a region of `size` bytes with uninitialized values.
+    fn allocate(&self, size: usize) -> Result<NonNull<u8>>;
+
+    /// Allocates a region of `size` bytes with `0` on all of them.
+    fn allocate_zeroed(&self, size: usize) -> Result<NonNull<u8>> {
+        let ptr = self.allocate(size)?;
+        unsafe { std::ptr::write_bytes(ptr.as_ptr(), 0, size) };
+        Ok(ptr)
+    }
+
+    /// Grows or shrinks the region `ptr` of `old_size` bytes to `new_size` bytes,
+    /// keeping its first `min(old_size, new_size)` bytes. On error, `ptr` is still
+    /// allocated for `old_size` bytes.
+    ///
+    /// # Safety
+    ///
+    /// `ptr` must have been allocated from this pool for `old_size` bytes.
+    unsafe fn reallocate(
+        &self,
+        ptr: NonNull<u8>,
+        old_size: usize,
+        new_size: usize,
+    ) -> Result<NonNull<u8>>;
+
+    /// Returns the region `ptr` of `size` bytes to this pool.
+    ///
+    /// # Safety
+    ///
+    /// `ptr` must have been allocated from this pool for `size` bytes, and must not be
+    /// used afterwards.
+    unsafe fn free(&self, ptr: NonNull<u8>, size: usize);
+
+    /// Returns the number of bytes of the regions allocated from this pool which have
+    /// not been freed.
+    fn allocated(&self) -> usize;
+}
+
+/// A region freed into a [`TrackingMemoryPool`] to be reused.
+#[derive(Debug)]
+struct Block(NonNull<u8>);
+
+// the pool owns its cached blocks, which are not referenced anywhere else
+unsafe impl Send for Block {}
+
+/// A [`MemoryPool`] that counts the bytes allocated from it, fails allocations which
+/// would exceed its limit, and keeps up to `cache_capacity` bytes of freed regions to
+/// reuse them for allocations of the same size.
+///
+/// # Example
+/// ```
+/// # use std::sync::Arc;
+/// # use arrow::alloc::{MemoryPool, TrackingMemoryPool};
+/// # use arrow::buffer::MutableBuffer;
+/// let pool = Arc::new(TrackingMemoryPool::new(Some(1024)));
+///
+/// let mut buffer = MutableBuffer::try_with_capacity_in(512, pool.clone()).unwrap();
+/// buffer.extend_from_slice(&[1u8; 512]);
+/// assert_eq!(pool.allocated(), 512);
+///
+/// // growing the buffer past the limit fails instead of allocating
+/// assert!(buffer.try_reserve(1024).is_err());
+///
+/// drop(buffer);
+/// assert_eq!(pool.allocated(), 0);
+/// assert_eq!(pool.peak(), 512);
+/// ```
+#[derive(Debug)]
+pub struct TrackingMemoryPool {
+    limit: Option<usize>,
+    cache_capacity: usize,
+    allocated: AtomicUsize,
+    peak: AtomicUsize,
+    /// The freed blocks by their size, and the number of bytes of all of them
+    cache: Mutex<(HashMap<usize, Vec<Block>>, usize)>,
+}
+
+impl TrackingMemoryPool {
+    /// Creates a pool which allocates at most `limit` bytes at any time, if any, and
+    /// does not reuse freed regions.
+    pub fn new(limit: Option<usize>) -> Self {
+        Self::with_cache_capacity(limit, 0)
+    }
+
+    /// Creates a pool which allocates at most `limit` bytes at any time, if any, and
+    /// keeps up to `cache_capacity` bytes of freed regions to reuse them.
+    pub fn with_cache_capacity(limit: Option<usize>, cache_capacity: usize) -> Self {
+        Self {
+            limit,
+            cache_capacity,
+            allocated: AtomicUsize::new(0),
+            peak: AtomicUsize::new(0),
+            cache: Mutex::new((HashMap::new(), 0)),
+        }
+    }
+
+    /// Returns the maximum number of bytes allocated from this pool, if any.
+    pub fn limit(&self) -> Option<usize> {
+        self.limit
+    }
+
+    /// Returns the highest number of bytes allocated from this pool at any time.
+    pub fn peak(&self) -> usize {
+        self.peak.load(Ordering::SeqCst)
+    }
+
+    /// Returns the number of bytes of the freed regions kept to be reused.
+    pub fn cached(&self) -> usize {
+        self.cache.lock().unwrap().1
+    }
+
+    /// Accounts for `size` more allocated bytes, unless it exceeds the limit.
+    fn grow(&self, size: usize) -> Result<()> {
+        let mut allocated = self.allocated.load(Ordering::SeqCst);
+        loop {
+            let new_allocated = allocated.checked_add(size);
+            let new_allocated = match (new_allocated, self.limit) {
+                (Some(new_allocated), Some(limit)) if new_allocated <= limit => {
+                    new_allocated
+                }
+                (Some(new_allocated), None) => new_allocated,
+                _ => {
+                    return Err(ArrowError::MemoryError(format!(
+                        "Failed to allocate {} bytes: {} of the {} bytes of the memory pool are allocated",
+                        size,
+                        allocated,
+                        self.limit.unwrap_or(std::usize::MAX)
+                    )))
+                }
+            };
+            match self.allocated.compare_exchange_weak(
+                allocated,
+                new_allocated,
+                Ordering::SeqCst,
+                Ordering::SeqCst,
+            ) {
+                Ok(_) => {
+                    self.peak.fetch_max(new_allocated, Ordering::SeqCst);
+                    return Ok(());
+                }
+                Err(current) => allocated = current,
+            }
+        }
+    }
+
+    /// Accounts for `size` fewer allocated bytes.
+    fn shrink(&self, size: usize) {
+        self.allocated.fetch_sub(size, Ordering::SeqCst);
+    }
+}
+
+impl MemoryPool for TrackingMemoryPool {
+    fn allocate(&self, size: usize) -> Result<NonNull<u8>> {
+        if size == 0 {
+            return Ok(unsafe { null_pointer() });
+        }
+        self.grow(size)?;
+        let mut cache = self.cache.lock().unwrap();
+        let (blocks, cached) = &mut *cache;
+        if let Some(block) = blocks.get_mut(&size).and_then(|blocks| blocks.pop()) {
+            *cached -= size;
+            return Ok(block.0);
+        }
+        drop(cache);
+        Ok(allocate_aligned(size))
+    }
+
+    unsafe fn reallocate(
+        &self,
+        ptr: NonNull<u8>,
+        old_size: usize,
+        new_size: usize,
+    ) -> Result<NonNull<u8>> {
+        if old_size == 0 {
+            return self.allocate(new_size);
+        }
+        if new_size == 0 {
+            self.free(ptr, old_size);
+            return Ok(null_pointer());
+        }
+        if new_size > old_size {
+            self.grow(new_size - old_size)?;
+        } else {
+            self.shrink(old_size - new_size);
+        }
+        Ok(reallocate(ptr, old_size, new_size))
+    }
+
+    unsafe fn free(&self, ptr: NonNull<u8>, size: usize) {
+        if size == 0 {
+            return;
+        }
+        self.shrink(size);
+        if size <= self.cache_capacity {
+            let mut cache = self.cache.lock().unwrap();
+            let (blocks, cached) = &mut *cache;
+            if *cached + size <= self.cache_capacity {
+                *cached += size;
+                blocks.entry(size).or_insert_with(Vec::new).push(Block(ptr));
+                return;
+            }
+        }
+        free_aligned(ptr, size);
+    }
+
+    fn allocated(&self) -> usize {
+        self.allocated.load(Ordering::SeqCst)
+    }
+}
+
+impl Drop for TrackingMemoryPool {
+    fn drop(&mut self) {
+        let (blocks, _) = self.cache.get_mut().unwrap();
+        for (size, blocks) in blocks.drain() {
+            for block in blocks {
+                unsafe { free_aligned(block.0, size) };
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_tracking_pool_limit() {
+        let pool = TrackingMemoryPool::new(Some(256));
+        let a = pool.allocate(128).unwrap();
+        assert_eq!(a.as_ptr() as usize % ALIGNMENT, 0);
+        let a = unsafe { pool.reallocate(a, 128, 192).unwrap() };
+        assert_eq!(pool.allocated(), 192);
+
+        let err = pool.allocate(128).unwrap_err();
+        assert!(matches!(err, ArrowError::MemoryError(_)));
+        assert!(unsafe { pool.reallocate(a, 192, 320) }.is_err());
+        assert_eq!(pool.allocated(), 192);
+
+        let b = pool.allocate(64).unwrap();
+        unsafe {
+            pool.free(a, 192);
+            pool.free(b, 64);
+        }
+        assert_eq!(pool.allocated(), 0);
+        assert_eq!(pool.peak(), 256);
+        assert_eq!(pool.cached(), 0);
+    }
+
+    #[test]
+    fn test_tracking_pool_cache() {
+        let pool = TrackingMemoryPool::with_cache_capacity(None, 128);
+        let a = pool.allocate(64).unwrap();
+        let b = pool.allocate(128).unwrap();
+        unsafe {
+            pool.free(a, 64);
+            // exceeds the capacity of the cache
+            pool.free(b, 128);
+        }
+        assert_eq!(pool.allocated(), 0);
+        assert_eq!(pool.cached(), 64);
+
+        let c = pool.allocate(64).unwrap();
+        assert_eq!(c, a);
+        assert_eq!(pool.cached(), 0);
+
+        let d = pool.allocate_zeroed(64).unwrap();
+        unsafe { pool.free(c, 64) };
+        let e = pool.allocate_zeroed(64).unwrap();
+        assert_eq!(e, c);
+        let zeroed = unsafe { std::slice::from_raw_parts(e.as_ptr(), 64) };
+        assert!(zeroed.iter().all(|byte| *byte == 0));
+        unsafe {
+            pool.free(d, 64);
+            pool.free(e, 64);
+        }
+        assert_eq!(pool.allocated(), 0);
+        assert_eq!(pool.cached(), 128);
+    }
+}
@@ -27,6 +27,7 @@ use std::marker::PhantomData;
 use std::mem;
 use std::sync::Arc;
 
+use crate::alloc::MemoryPool;
 use crate::array::*;
 use crate::buffer::{Buffer, MutableBuffer};
 use crate::datatypes::*;
@@ -118,6 +119,22 @@ impl<T: ArrowNativeType> BufferBuilder<T> {
         }
     }
 
+    /// Creates a new builder with initial capacity for _at least_ `capacity`
+    /// elements of type `T`, whose buffer allocates from `pool`.
+    ///
+    /// Returns an error if `pool` cannot allocate the initial capacity.
+    #[inline]
+    pub fn try_new_in(capacity: usize, pool: Arc<dyn MemoryPool>) -> Result<Self> {
+        let buffer =
+            MutableBuffer::try_with_capacity_in(capacity * mem::size_of::<T>(), pool)?;
+
+        Ok(Self {
+            buffer,
+            len: 0,
+            _marker: PhantomData,
+        })
+    }
+
     /// Returns the current number of array elements in the internal buffer.
     ///
     /// # Example:
@@ -277,7 +294,8 @@ impl<T: ArrowNativeType> BufferBuilder<T> {
     /// ```
     #[inline]
     pub fn finish(&mut self) -> Buffer {
-        let buf = std::mem::replace(&mut self.buffer, MutableBuffer::new(0));
+        let empty = self.buffer.new_empty_like();
+        let buf = std::mem::replace(&mut self.buffer, empty);
         self.len = 0;
         buf.into()
     }
@@ -297,6 +315,17 @@ impl BooleanBufferBuilder {
         Self { buffer, len: 0 }
     }
 
+    /// Creates a new builder with initial capacity for _at least_ `capacity` bits,
+    /// whose buffer allocates from `pool`.
+    ///
+    /// Returns an error if `pool` cannot allocate the initial capacity.
+    #[inline]
+    pub fn try_new_in(capacity: usize, pool: Arc<dyn MemoryPool>) -> Result<Self> {
+        let byte_capacity = bit_util::ceil(capacity, 8);
+        let buffer = MutableBuffer::try_from_len_zeroed_in(byte_capacity, pool)?;
+        Ok(Self { buffer, len: 0 })
+    }
+
     #[inline]
     pub fn len(&self) -> usize {
         self.len
@@ -335,6 +364,20 @@ impl BooleanBufferBuilder {
         }
     }
 
+    /// Reserve space to at least `additional` new bits, like
+    /// [`reserve`](BooleanBufferBuilder::reserve), but returns an error instead of
+    /// panicking if the memory pool of this builder cannot allocate it.
+    #[inline]
+    pub fn try_reserve(&mut self, additional: usize) -> Result<()> {
+        let capacity = self.len + additional;
+        if capacity > self.capacity() {
+            // convert differential to bytes
+            let additional = bit_util::ceil(capacity, 8) - self.buffer.len();
+            self.buffer.try_reserve(additional)?;
+        }
+        Ok(())
+    }
+
     #[inline]
     pub fn append(&mut self, v: bool) {
         self.advance(1);
@@ -369,7 +412,8 @@ impl BooleanBufferBuilder {
 
     #[inline]
     pub fn finish(&mut self) -> Buffer {
-        let buf = std::mem::replace(&mut self.buffer, MutableBuffer::new(0));
+        let empty = self.buffer.new_empty_like();
+        let buf = std::mem::replace(&mut self.buffer, empty);
         self.len = 0;
         buf.into()
     }
@@ -2105,6 +2149,29 @@ mod tests {
         assert_eq!(0, a.len());
     }
 
+    #[test]
+    fn test_builder_i32_pool() {
+        let pool = Arc::new(crate::alloc::TrackingMemoryPool::new(None));
+        let mut b = Int32BufferBuilder::try_new_in(5, pool.clone()).unwrap();
+        assert_eq!(pool.allocated(), 64);
+        b.append_slice(&[7; 20]);
+        assert_eq!(pool.allocated(), 128);
+
+        let a = b.finish();
+        assert_eq!(80, a.len());
+        b.append(1);
+        assert_eq!(pool.allocated(), 192);
+        drop(a);
+        drop(b);
+        assert_eq!(pool.allocated(), 0);
+
+        let mut b = BooleanBufferBuilder::try_new_in(10, pool.clone()).unwrap();
+        b.append_n(1000, true);
+        assert!(pool.allocated() >= 125);
+        drop(b);
+        assert_eq!(pool.allocated(), 0);
+    }
+
     #[test]
     fn test_builder_i32_alloc_zero_bytes() {
         let mut b = Int32BufferBuilder::new(0);
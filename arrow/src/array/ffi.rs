@@ -32,7 +32,8 @@ impl TryFrom<ffi::ArrowArray> for ArrayData {
     type Error = ArrowError;
 
     fn try_from(value: ffi::ArrowArray) -> Result<Self> {
-        let child_data = value.children()?;
+        // `value` is consumed, so that its children are moved out only once
+        let child_data = value.move_children()?;
 
         let child_type = if !child_data.is_empty() {
             Some(child_data[0].data_type().clone())
@@ -71,51 +72,30 @@ impl TryFrom<ArrayData> for ffi::ArrowArray {
             DataType::LargeList(field) => field.is_nullable(),
             _ => false,
         };
+        export(&value, nullable)
+    }
+}
 
-        let len = value.len();
-        let offset = value.offset() as usize;
-        let null_count = value.null_count();
-        let buffers = value.buffers().to_vec();
-        let null_buffer = value.null_buffer().cloned();
-        let child_data = value
-            .child_data()
-            .iter()
-            .map(|arr| {
-                let len = arr.len();
-                let offset = arr.offset() as usize;
-                let null_count = arr.null_count();
-                let buffers = arr.buffers().to_vec();
-                let null_buffer = arr.null_buffer().cloned();
-
-                // Note: the nullable comes from the parent data.
-                unsafe {
-                    ArrowArray::try_new(
-                        arr.data_type(),
-                        len,
-                        null_count,
-                        null_buffer,
-                        offset,
-                        buffers,
-                        vec![],
-                        nullable,
-                    )
-                    .expect("infallible")
-                }
-            })
-            .collect::<Vec<_>>();
-
-        unsafe {
-            ffi::ArrowArray::try_new(
-                value.data_type(),
-                len,
-                null_count,
-                null_buffer,
-                offset,
-                buffers,
-                child_data,
-                nullable,
-            )
-        }
+/// Exports `data` and, recursively, its children, whose nullability is that of the
+/// fields of the data type of `data`.
+fn export(data: &ArrayData, nullable: bool) -> Result<ArrowArray> {
+    let child_data = data
+        .child_data()
+        .iter()
+        .map(|child| export(child, nullable))
+        .collect::<Result<Vec<_>>>()?;
+
+    unsafe {
+        ArrowArray::try_new(
+            data.data_type(),
+            data.len(),
+            data.null_count(),
+            data.null_buffer().cloned(),
+            data.offset(),
+            data.buffers().to_vec(),
+            child_data,
+            nullable,
+        )
     }
 }
 
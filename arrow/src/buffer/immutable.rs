@@ -23,7 +23,7 @@ use std::{convert::AsRef, usize};
 
 use crate::util::bit_chunk_iterator::BitChunks;
 use crate::{
-    bytes::{Bytes, Deallocation},
+    bytes::{Allocation, Bytes, Deallocation},
     datatypes::ArrowNativeType,
     ffi,
 };
@@ -100,6 +100,43 @@ impl Buffer {
         Buffer::build_with_arguments(ptr, len, Deallocation::Foreign(data))
     }
 
+    /// Creates a buffer from an existing memory region owned by `owner`, such as a
+    /// memory mapped file. The region is kept alive until all the buffers created from
+    /// it are dropped.
+    ///
+    /// # Arguments
+    ///
+    /// * `ptr` - Pointer to raw parts
+    /// * `len` - Length of raw parts in **bytes**
+    /// * `owner` - The owner of the memory region
+    ///
+    /// # Safety
+    ///
+    /// This function is unsafe as there is no guarantee that the given pointer is valid for `len`
+    /// bytes while `owner` is alive.
+    ///
+    /// # Example
+    ///
+    /// ```
+    /// use std::ptr::NonNull;
+    /// use std::sync::Arc;
+    /// use arrow::buffer::{Allocation, Buffer};
+    ///
+    /// let region: Vec<u8> = vec![1, 2, 3, 4];
+    /// let ptr = NonNull::new(region.as_ptr() as *mut u8).unwrap();
+    /// let owner: Arc<dyn Allocation> = Arc::new(region);
+    /// // the vector stays alive, and its memory valid, as long as the buffer
+    /// let buffer = unsafe { Buffer::from_custom_allocation(ptr, 4, owner) };
+    /// assert_eq!(buffer.as_slice(), &[1, 2, 3, 4]);
+    /// ```
+    pub unsafe fn from_custom_allocation(
+        ptr: NonNull<u8>,
+        len: usize,
+        owner: Arc<dyn Allocation>,
+    ) -> Self {
+        Buffer::build_with_arguments(ptr, len, Deallocation::Custom(owner))
+    }
+
     /// Auxiliary method to create a new Buffer
     unsafe fn build_with_arguments(
         ptr: NonNull<u8>,
@@ -149,6 +186,23 @@ impl Buffer {
         }
     }
 
+    /// Returns a new [Buffer] of `len` bytes of this buffer starting at `offset`. Unlike
+    /// [Buffer::slice], the new buffer does not extend to the end of this buffer, while
+    /// still sharing its memory region.
+    /// # Panics
+    /// Panics iff `offset + len` is larger than `len`.
+    pub fn slice_with_length(&self, offset: usize, len: usize) -> Self {
+        assert!(
+            offset.saturating_add(len) <= self.len(),
+            "the offset and length of the new Buffer cannot exceed the existing length"
+        );
+        // the new buffer keeps this buffer, and thus its memory region, alive
+        unsafe {
+            let ptr = NonNull::new_unchecked(self.as_ptr().add(offset) as *mut u8);
+            Buffer::from_custom_allocation(ptr, len, Arc::new(self.clone()))
+        }
+    }
+
     /// Returns a pointer to the start of this buffer.
     ///
     /// Note that this should be used cautiously, and the returned pointer should not be
@@ -415,6 +469,35 @@ mod tests {
         buf.slice(6);
     }
 
+    #[test]
+    fn test_slice_with_length() {
+        let buf = Buffer::from(&[2, 4, 6, 8, 10]);
+        let buf2 = buf.slice_with_length(1, 3);
+        assert_eq!([4, 6, 8], buf2.as_slice());
+        assert_eq!(3, buf2.len());
+        assert_eq!(unsafe { buf.as_ptr().offset(1) }, buf2.as_ptr());
+        assert_eq!(0, buf2.capacity());
+
+        let buf3 = buf2.slice_with_length(2, 1);
+        assert_eq!([8], buf3.as_slice());
+        assert_eq!(unsafe { buf.as_ptr().offset(3) }, buf3.as_ptr());
+
+        // the memory region outlives the buffer it was sliced from
+        drop(buf);
+        drop(buf2);
+        assert_eq!([8], buf3.as_slice());
+        assert!(buf3.slice_with_length(1, 0).is_empty());
+    }
+
+    #[test]
+    #[should_panic(
+        expected = "the offset and length of the new Buffer cannot exceed the existing length"
+    )]
+    fn test_slice_with_length_out_of_bound() {
+        let buf = Buffer::from(&[2, 4, 6, 8, 10]);
+        buf.slice_with_length(3, 3);
+    }
+
     #[test]
     fn test_access_concurrently() {
         let buffer = Buffer::from(vec![1, 2, 3, 4, 5]);
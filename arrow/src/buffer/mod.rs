@@ -25,6 +25,8 @@ pub use mutable::*;
 mod ops;
 pub(super) use ops::*;
 
+pub use crate::bytes::Allocation;
+
 use crate::error::{ArrowError, Result};
 use std::ops::{BitAnd, BitOr, Not};
 
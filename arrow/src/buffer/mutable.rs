@@ -1,9 +1,11 @@
 use std::ptr::NonNull;
+use std::sync::Arc;
 
 use crate::{
-    alloc,
+    alloc::{self, MemoryPool},
     bytes::{Bytes, Deallocation},
     datatypes::{ArrowNativeType, ToByteSlice},
+    error::Result,
     util::bit_util,
 };
 
@@ -40,6 +42,9 @@ use super::Buffer;
 /// let buffer: Buffer = buffer.into();
 /// assert_eq!(buffer.as_slice(), &[0u8, 1, 0, 0, 1, 0, 0, 0])
 /// ```
+///
+/// A [`MutableBuffer`] created with [MutableBuffer::try_with_capacity_in] allocates from a
+/// [`MemoryPool`], which also frees the memory of the [`Buffer`] it is converted to.
 #[derive(Debug)]
 pub struct MutableBuffer {
     // dangling iff capacity = 0
@@ -47,6 +52,8 @@ pub struct MutableBuffer {
     // invariant: len <= capacity
     len: usize,
     capacity: usize,
+    // allocates `data` if any, and the global allocator otherwise
+    pool: Option<Arc<dyn MemoryPool>>,
 }
 
 impl MutableBuffer {
@@ -65,6 +72,55 @@ impl MutableBuffer {
             data: ptr,
             len: 0,
             capacity,
+            pool: None,
+        }
+    }
+
+    /// Allocate a new [MutableBuffer] from `pool` with initial capacity to be at least
+    /// `capacity`. The buffer grows within `pool`, see [MutableBuffer::try_reserve].
+    ///
+    /// Returns an error if `pool` cannot allocate `capacity` bytes.
+    pub fn try_with_capacity_in(
+        capacity: usize,
+        pool: Arc<dyn MemoryPool>,
+    ) -> Result<Self> {
+        let capacity = bit_util::round_upto_multiple_of_64(capacity);
+        let ptr = pool.allocate(capacity)?;
+        Ok(Self {
+            data: ptr,
+            len: 0,
+            capacity,
+            pool: Some(pool),
+        })
+    }
+
+    /// Allocate a new [MutableBuffer] from `pool` with `len` and capacity to be at least
+    /// `len` where all bytes are guaranteed to be `0u8`.
+    ///
+    /// Returns an error if `pool` cannot allocate `len` bytes.
+    pub fn try_from_len_zeroed_in(len: usize, pool: Arc<dyn MemoryPool>) -> Result<Self> {
+        let capacity = bit_util::round_upto_multiple_of_64(len);
+        let ptr = pool.allocate_zeroed(capacity)?;
+        Ok(Self {
+            data: ptr,
+            len,
+            capacity,
+            pool: Some(pool),
+        })
+    }
+
+    /// Returns the [`MemoryPool`] this buffer allocates from, if any.
+    pub fn pool(&self) -> Option<&Arc<dyn MemoryPool>> {
+        self.pool.as_ref()
+    }
+
+    /// Returns an empty [MutableBuffer] which allocates from the same pool as this one.
+    pub(crate) fn new_empty_like(&self) -> Self {
+        Self {
+            data: alloc::allocate_aligned(0),
+            len: 0,
+            capacity: 0,
+            pool: self.pool.clone(),
         }
     }
 
@@ -86,6 +142,7 @@ impl MutableBuffer {
             data: ptr,
             len,
             capacity: new_capacity,
+            pool: None,
         }
     }
 
@@ -135,22 +192,48 @@ impl MutableBuffer {
     /// let buffer: Buffer = buffer.into();
     /// assert_eq!(buffer.len(), 253);
     /// ```
+    ///
+    /// # Panics
+    ///
+    /// Panics if the [`MemoryPool`] of this buffer cannot allocate the new capacity, see
+    /// [MutableBuffer::try_reserve] for a fallible version.
     // For performance reasons, this must be inlined so that the `if` is executed inside the caller, and not as an extra call that just
     // exits.
     #[inline(always)]
     pub fn reserve(&mut self, additional: usize) {
         let required_cap = self.len + additional;
         if required_cap > self.capacity {
-            // JUSTIFICATION
-            //  Benefit
-            //      necessity
-            //  Soundness
-            //      `self.data` is valid for `self.capacity`.
-            let (ptr, new_capacity) =
-                unsafe { reallocate(self.data, self.capacity, required_cap) };
-            self.data = ptr;
-            self.capacity = new_capacity;
+            if let Err(e) = self.grow(required_cap) {
+                panic!("{}", e)
+            }
+        }
+    }
+
+    /// Ensures that this buffer has at least `self.len + additional` bytes, like
+    /// [MutableBuffer::reserve], but returns an error instead of panicking if the
+    /// [`MemoryPool`] of this buffer cannot allocate the new capacity. On error, the
+    /// buffer is unchanged.
+    #[inline]
+    pub fn try_reserve(&mut self, additional: usize) -> Result<()> {
+        let required_cap = self.len + additional;
+        if required_cap > self.capacity {
+            self.grow(required_cap)?;
         }
+        Ok(())
+    }
+
+    fn grow(&mut self, required_cap: usize) -> Result<()> {
+        // JUSTIFICATION
+        //  Benefit
+        //      necessity
+        //  Soundness
+        //      `self.data` is valid for `self.capacity`, and allocated from `self.pool`.
+        let (ptr, new_capacity) = unsafe {
+            reallocate(self.data, self.capacity, required_cap, self.pool.as_deref())?
+        };
+        self.data = ptr;
+        self.capacity = new_capacity;
+        Ok(())
     }
 
     /// Resizes the buffer, either truncating its contents (with no change in capacity), or
@@ -235,10 +318,12 @@ impl MutableBuffer {
     }
 
     #[inline]
-    pub(super) fn into_buffer(self) -> Buffer {
-        let bytes = unsafe {
-            Bytes::new(self.data, self.len, Deallocation::Native(self.capacity))
+    pub(super) fn into_buffer(mut self) -> Buffer {
+        let deallocation = match self.pool.take() {
+            Some(pool) => Deallocation::Pool(pool, self.capacity),
+            None => Deallocation::Native(self.capacity),
         };
+        let bytes = unsafe { Bytes::new(self.data, self.len, deallocation) };
         std::mem::forget(self);
         Buffer::from_bytes(bytes)
     }
@@ -322,17 +407,21 @@ impl MutableBuffer {
 }
 
 /// # Safety
-/// `ptr` must be allocated for `old_capacity`.
+/// `ptr` must be allocated for `old_capacity`, from `pool` if any.
 #[inline]
 unsafe fn reallocate(
     ptr: NonNull<u8>,
     old_capacity: usize,
     new_capacity: usize,
-) -> (NonNull<u8>, usize) {
+    pool: Option<&dyn MemoryPool>,
+) -> Result<(NonNull<u8>, usize)> {
     let new_capacity = bit_util::round_upto_multiple_of_64(new_capacity);
     let new_capacity = std::cmp::max(new_capacity, old_capacity * 2);
-    let ptr = alloc::reallocate(ptr, old_capacity, new_capacity);
-    (ptr, new_capacity)
+    let ptr = match pool {
+        Some(pool) => pool.reallocate(ptr, old_capacity, new_capacity)?,
+        None => alloc::reallocate(ptr, old_capacity, new_capacity),
+    };
+    Ok((ptr, new_capacity))
 }
 
 impl<A: ArrowNativeType> Extend<A> for MutableBuffer {
@@ -525,7 +614,10 @@ impl std::ops::DerefMut for MutableBuffer {
 
 impl Drop for MutableBuffer {
     fn drop(&mut self) {
-        unsafe { alloc::free_aligned(self.data, self.capacity) };
+        match &self.pool {
+            Some(pool) => unsafe { pool.free(self.data, self.capacity) },
+            None => unsafe { alloc::free_aligned(self.data, self.capacity) },
+        }
     }
 }
 
@@ -624,6 +716,8 @@ impl std::iter::FromIterator<bool> for MutableBuffer {
 #[cfg(test)]
 mod tests {
     use super::*;
+    use crate::alloc::TrackingMemoryPool;
+    use crate::error::ArrowError;
 
     #[test]
     fn test_mutable_new() {
@@ -746,4 +840,35 @@ mod tests {
         buf2.reserve(65);
         assert!(buf != buf2);
     }
+
+    #[test]
+    fn test_mutable_pool() {
+        let pool = Arc::new(TrackingMemoryPool::new(Some(256)));
+        let mut buf = MutableBuffer::try_with_capacity_in(1, pool.clone()).unwrap();
+        assert_eq!(pool.allocated(), 64);
+
+        buf.extend_from_slice(&[1u32; 20]);
+        assert_eq!(buf.capacity(), 128);
+        assert_eq!(pool.allocated(), 128);
+
+        let err = buf.try_reserve(256).unwrap_err();
+        assert!(matches!(err, ArrowError::MemoryError(_)));
+        assert_eq!(buf.capacity(), 128);
+
+        let zeroed = MutableBuffer::try_from_len_zeroed_in(100, pool.clone()).unwrap();
+        assert_eq!(zeroed.as_slice(), &[0u8; 100][..]);
+        assert_eq!(pool.allocated(), 256);
+        assert!(MutableBuffer::try_with_capacity_in(1, pool.clone()).is_err());
+        drop(zeroed);
+
+        let buffer: Buffer = buf.into();
+        assert_eq!(buffer.capacity(), 128);
+        assert_eq!(unsafe { buffer.typed_data::<u32>() }, &[1u32; 20][..]);
+        let slice = buffer.slice(4);
+        drop(buffer);
+        assert_eq!(pool.allocated(), 128);
+        drop(slice);
+        assert_eq!(pool.allocated(), 0);
+        assert_eq!(pool.peak(), 256);
+    }
 }
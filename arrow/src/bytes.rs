@@ -24,7 +24,14 @@ use std::ptr::NonNull;
 use std::sync::Arc;
 use std::{fmt::Debug, fmt::Formatter};
 
-use crate::{alloc, ffi};
+use crate::alloc::{self, MemoryPool};
+use crate::ffi;
+
+/// An owner of a memory region that is not allocated by this crate, such as a memory
+/// mapped file, which keeps the region alive until it is dropped.
+pub trait Allocation: Send + Sync {}
+
+impl<T: Send + Sync> Allocation for T {}
 
 /// Mode of deallocating memory regions
 pub enum Deallocation {
@@ -32,6 +39,10 @@ pub enum Deallocation {
     Native(usize),
     /// Foreign interface, via a callback
     Foreign(Arc<ffi::FFI_ArrowArray>),
+    /// Custom allocation, deallocated when its owner is dropped
+    Custom(Arc<dyn Allocation>),
+    /// Allocation from a memory pool, returned to the pool with its capacity
+    Pool(Arc<dyn MemoryPool>, usize),
 }
 
 impl Debug for Deallocation {
@@ -43,6 +54,12 @@ impl Debug for Deallocation {
             Deallocation::Foreign(_) => {
                 write!(f, "Deallocation::Foreign {{ capacity: unknown }}")
             }
+            Deallocation::Custom(_) => {
+                write!(f, "Deallocation::Custom {{ capacity: unknown }}")
+            }
+            Deallocation::Pool(_, capacity) => {
+                write!(f, "Deallocation::Pool {{ capacity: {} }}", capacity)
+            }
         }
     }
 }
@@ -113,10 +130,10 @@ impl Bytes {
 
     pub fn capacity(&self) -> usize {
         match self.deallocation {
-            Deallocation::Native(capacity) => capacity,
+            Deallocation::Native(capacity) | Deallocation::Pool(_, capacity) => capacity,
             // we cannot determine this in general,
             // and thus we state that this is externally-owned memory
-            Deallocation::Foreign(_) => 0,
+            Deallocation::Foreign(_) | Deallocation::Custom(_) => 0,
         }
     }
 }
@@ -130,6 +147,11 @@ impl Drop for Bytes {
             }
             // foreign interface knows how to deallocate itself.
             Deallocation::Foreign(_) => (),
+            // the owner of a custom allocation deallocates it once it is dropped.
+            Deallocation::Custom(_) => (),
+            Deallocation::Pool(pool, capacity) => {
+                unsafe { pool.free(self.ptr, *capacity) };
+            }
         }
     }
 }
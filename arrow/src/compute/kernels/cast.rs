@@ -41,9 +41,12 @@ use std::sync::Arc;
 use crate::buffer::MutableBuffer;
 use crate::compute::kernels::arithmetic::{divide, multiply};
 use crate::compute::kernels::arity::unary;
-use crate::compute::kernels::cast_utils::string_to_timestamp_nanos;
+use crate::compute::kernels::cast_utils::{
+    string_to_date, string_to_datetime, string_to_decimal, string_to_timestamp_nanos,
+};
 use crate::datatypes::*;
 use crate::error::{ArrowError, Result};
+use crate::util::bit_util;
 use crate::{array::*, compute::take};
 use crate::{buffer::Buffer, util::serialization::lexical_to_string};
 use num::{NumCast, ToPrimitive};
@@ -96,10 +99,12 @@ pub fn can_cast_types(from_type: &DataType, to_type: &DataType) -> bool {
         (Utf8, Date32) => true,
         (Utf8, Date64) => true,
         (Utf8, Timestamp(TimeUnit::Nanosecond, None)) => true,
+        (Utf8, Decimal(_, _)) => true,
         (Utf8, _) => DataType::is_numeric(to_type),
         (LargeUtf8, Date32) => true,
         (LargeUtf8, Date64) => true,
         (LargeUtf8, Timestamp(TimeUnit::Nanosecond, None)) => true,
+        (LargeUtf8, Decimal(_, _)) => true,
         (LargeUtf8, _) => DataType::is_numeric(to_type),
         (_, Utf8) | (_, LargeUtf8) => {
             DataType::is_numeric(from_type) || from_type == &Binary
@@ -249,6 +254,8 @@ pub fn can_cast_types(from_type: &DataType, to_type: &DataType) -> bool {
 /// * Boolean to Utf8: `true` => '1', `false` => `0`
 /// * Utf8 to numeric: strings that can't be parsed to numbers return null, float strings
 ///   in integer casts return null
+/// * Utf8 to decimal: strings with more fractional digits than the scale, other than
+///   trailing zeros, or with more digits than the precision return null
 /// * Numeric to boolean: 0 returns `false`, any other value returns `true`
 /// * List to List: the underlying data type is cast
 /// * Primitive to List: a list array with 1 value per slot is created
@@ -274,6 +281,8 @@ pub fn cast(array: &ArrayRef, to_type: &DataType) -> Result<ArrayRef> {
 /// * Boolean to Utf8: `true` => '1', `false` => `0`
 /// * Utf8 to numeric: strings that can't be parsed to numbers return null, float strings
 ///   in integer casts return null
+/// * Utf8 to decimal: strings with more fractional digits than the scale, other than
+///   trailing zeros, or with more digits than the precision return null
 /// * Numeric to boolean: 0 returns `false`, any other value returns `true`
 /// * List to List: the underlying data type is cast
 /// * Primitive to List: a list array with 1 value per slot is created
@@ -446,6 +455,9 @@ pub fn cast_with_options(
             Int64 => cast_string_to_numeric::<Int64Type, i32>(array, cast_options),
             Float32 => cast_string_to_numeric::<Float32Type, i32>(array, cast_options),
             Float64 => cast_string_to_numeric::<Float64Type, i32>(array, cast_options),
+            Decimal(precision, scale) => {
+                cast_string_to_decimal::<i32>(&**array, *precision, *scale, cast_options)
+            }
             Date32 => cast_string_to_date32::<i32>(&**array, cast_options),
             Date64 => cast_string_to_date64::<i32>(&**array, cast_options),
             Timestamp(TimeUnit::Nanosecond, None) => {
@@ -548,6 +560,9 @@ pub fn cast_with_options(
             Int64 => cast_string_to_numeric::<Int64Type, i64>(array, cast_options),
             Float32 => cast_string_to_numeric::<Float32Type, i64>(array, cast_options),
             Float64 => cast_string_to_numeric::<Float64Type, i64>(array, cast_options),
+            Decimal(precision, scale) => {
+                cast_string_to_decimal::<i64>(&**array, *precision, *scale, cast_options)
+            }
             Date32 => cast_string_to_date32::<i64>(&**array, cast_options),
             Date64 => cast_string_to_date64::<i64>(&**array, cast_options),
             Timestamp(TimeUnit::Nanosecond, None) => {
@@ -1034,8 +1049,7 @@ where
         .collect()
 }
 
-/// Cast numeric types to Utf8
-#[allow(clippy::unnecessary_wraps)]
+/// Cast Utf8 to numeric types
 fn cast_string_to_numeric<T, Offset: StringOffsetSizeTrait>(
     from: &ArrayRef,
     cast_options: &CastOptions,
@@ -1060,48 +1074,15 @@ where
     T: ArrowNumericType,
     <T as ArrowPrimitiveType>::Native: lexical_core::FromLexical,
 {
-    if cast_options.safe {
-        let iter = (0..from.len()).map(|i| {
-            if from.is_null(i) {
-                None
-            } else {
-                lexical_core::parse(from.value(i).as_bytes()).ok()
-            }
-        });
-        // Benefit:
-        //     20% performance improvement
-        // Soundness:
-        //     The iterator is trustedLen because it comes from an `StringArray`.
-        Ok(unsafe { PrimitiveArray::<T>::from_trusted_len_iter(iter) })
-    } else {
-        let vec = (0..from.len())
-            .map(|i| {
-                if from.is_null(i) {
-                    Ok(None)
-                } else {
-                    let string = from.value(i);
-                    let result = lexical_core::parse(string.as_bytes());
-                    Some(result.map_err(|_| {
-                        ArrowError::CastError(format!(
-                            "Cannot cast string '{}' to value of {} type",
-                            string,
-                            std::any::type_name::<T>()
-                        ))
-                    }))
-                    .transpose()
-                }
-            })
-            .collect::<Result<Vec<_>>>()?;
-        // Benefit:
-        //     20% performance improvement
-        // Soundness:
-        //     The iterator is trustedLen because it comes from an `StringArray`.
-        Ok(unsafe { PrimitiveArray::<T>::from_trusted_len_iter(vec.iter()) })
-    }
+    parse_strings_to_primitive::<T, _, _, _>(
+        from,
+        cast_options,
+        |string| lexical_core::parse(string.as_bytes()).ok(),
+        string_cast_error::<T>,
+    )
 }
 
 /// Casts generic string arrays to Date32Array
-#[allow(clippy::unnecessary_wraps)]
 fn cast_string_to_date32<Offset: StringOffsetSizeTrait>(
     array: &dyn Array,
     cast_options: &CastOptions,
@@ -1112,59 +1093,19 @@ fn cast_string_to_date32<Offset: StringOffsetSizeTrait>(
         .downcast_ref::<GenericStringArray<Offset>>()
         .unwrap();
 
-    let array = if cast_options.safe {
-        let iter = (0..string_array.len()).map(|i| {
-            if string_array.is_null(i) {
-                None
-            } else {
-                string_array
-                    .value(i)
-                    .parse::<chrono::NaiveDate>()
-                    .map(|date| date.num_days_from_ce() - EPOCH_DAYS_FROM_CE)
-                    .ok()
-            }
-        });
-
-        // Benefit:
-        //     20% performance improvement
-        // Soundness:
-        //     The iterator is trustedLen because it comes from an `StringArray`.
-        unsafe { Date32Array::from_trusted_len_iter(iter) }
-    } else {
-        let vec = (0..string_array.len())
-            .map(|i| {
-                if string_array.is_null(i) {
-                    Ok(None)
-                } else {
-                    let string = string_array
-                        .value(i);
-
-                    let result = string
-                        .parse::<chrono::NaiveDate>()
-                        .map(|date| date.num_days_from_ce() - EPOCH_DAYS_FROM_CE);
-
-                    Some(result.map_err(|_| {
-                        ArrowError::CastError(
-                            format!("Cannot cast string '{}' to value of arrow::datatypes::types::Date32Type type", string),
-                        )
-                    }))
-                        .transpose()
-                }
-            })
-            .collect::<Result<Vec<Option<i32>>>>()?;
-
-        // Benefit:
-        //     20% performance improvement
-        // Soundness:
-        //     The iterator is trustedLen because it comes from an `StringArray`.
-        unsafe { Date32Array::from_trusted_len_iter(vec.iter()) }
-    };
-
+    let array = parse_strings_to_primitive::<Date32Type, _, _, _>(
+        string_array,
+        cast_options,
+        |string| {
+            string_to_date(string)
+                .map(|date| date.num_days_from_ce() - EPOCH_DAYS_FROM_CE)
+        },
+        string_cast_error::<Date32Type>,
+    )?;
     Ok(Arc::new(array) as ArrayRef)
 }
 
 /// Casts generic string arrays to Date64Array
-#[allow(clippy::unnecessary_wraps)]
 fn cast_string_to_date64<Offset: StringOffsetSizeTrait>(
     array: &dyn Array,
     cast_options: &CastOptions,
@@ -1174,59 +1115,16 @@ fn cast_string_to_date64<Offset: StringOffsetSizeTrait>(
         .downcast_ref::<GenericStringArray<Offset>>()
         .unwrap();
 
-    let array = if cast_options.safe {
-        let iter = (0..string_array.len()).map(|i| {
-            if string_array.is_null(i) {
-                None
-            } else {
-                string_array
-                    .value(i)
-                    .parse::<chrono::NaiveDateTime>()
-                    .map(|datetime| datetime.timestamp_millis())
-                    .ok()
-            }
-        });
-
-        // Benefit:
-        //     20% performance improvement
-        // Soundness:
-        //     The iterator is trustedLen because it comes from an `StringArray`.
-        unsafe { Date64Array::from_trusted_len_iter(iter) }
-    } else {
-        let vec = (0..string_array.len())
-            .map(|i| {
-                if string_array.is_null(i) {
-                    Ok(None)
-                } else {
-                let string = string_array
-                        .value(i);
-
-                    let result = string
-                        .parse::<chrono::NaiveDateTime>()
-                        .map(|datetime| datetime.timestamp_millis());
-
-                    Some(result.map_err(|_| {
-                        ArrowError::CastError(
-                            format!("Cannot cast string '{}' to value of arrow::datatypes::types::Date64Type type", string),
-                        )
-                    }))
-                        .transpose()
-                }
-            })
-            .collect::<Result<Vec<Option<i64>>>>()?;
-
-        // Benefit:
-        //     20% performance improvement
-        // Soundness:
-        //     The iterator is trustedLen because it comes from an `StringArray`.
-        unsafe { Date64Array::from_trusted_len_iter(vec.iter()) }
-    };
-
+    let array = parse_strings_to_primitive::<Date64Type, _, _, _>(
+        string_array,
+        cast_options,
+        |string| string_to_datetime(string).map(|datetime| datetime.timestamp_millis()),
+        string_cast_error::<Date64Type>,
+    )?;
     Ok(Arc::new(array) as ArrayRef)
 }
 
 /// Casts generic string arrays to TimeStampNanosecondArray
-#[allow(clippy::unnecessary_wraps)]
 fn cast_string_to_timestamp_ns<Offset: StringOffsetSizeTrait>(
     array: &dyn Array,
     cast_options: &CastOptions,
@@ -1236,39 +1134,141 @@ fn cast_string_to_timestamp_ns<Offset: StringOffsetSizeTrait>(
         .downcast_ref::<GenericStringArray<Offset>>()
         .unwrap();
 
-    let array = if cast_options.safe {
-        let iter = (0..string_array.len()).map(|i| {
-            if string_array.is_null(i) {
-                None
-            } else {
-                string_to_timestamp_nanos(string_array.value(i)).ok()
+    let array = parse_strings_to_primitive::<TimestampNanosecondType, _, _, _>(
+        string_array,
+        cast_options,
+        |string| string_to_timestamp_nanos(string).ok(),
+        // only called for the string that fails the cast, to get chrono's error
+        |string| string_to_timestamp_nanos(string).unwrap_err(),
+    )?;
+    Ok(Arc::new(array) as ArrayRef)
+}
+
+/// Casts generic string arrays to DecimalArray
+fn cast_string_to_decimal<Offset: StringOffsetSizeTrait>(
+    array: &dyn Array,
+    precision: usize,
+    scale: usize,
+    cast_options: &CastOptions,
+) -> Result<ArrayRef> {
+    let string_array = array
+        .as_any()
+        .downcast_ref::<GenericStringArray<Offset>>()
+        .unwrap();
+
+    let data = parse_strings(
+        string_array,
+        DataType::Decimal(precision, scale),
+        16,
+        cast_options,
+        |string, slot| match string_to_decimal(string, precision, scale) {
+            Some(value) => {
+                slot.copy_from_slice(&value.to_le_bytes());
+                true
             }
-        });
-        // Benefit:
-        //     20% performance improvement
-        // Soundness:
-        //     The iterator is trustedLen because it comes from an `StringArray`.
-        unsafe { TimestampNanosecondArray::from_trusted_len_iter(iter) }
-    } else {
-        let vec = (0..string_array.len())
-            .map(|i| {
-                if string_array.is_null(i) {
-                    Ok(None)
-                } else {
-                    let result = string_to_timestamp_nanos(string_array.value(i));
-                    Some(result).transpose()
-                }
-            })
-            .collect::<Result<Vec<Option<i64>>>>()?;
+            None => false,
+        },
+        |string| {
+            ArrowError::CastError(format!(
+                "Cannot cast string '{}' to value of Decimal({}, {}) type",
+                string, precision, scale
+            ))
+        },
+    )?;
+    Ok(Arc::new(DecimalArray::from(data)) as ArrayRef)
+}
 
-        // Benefit:
-        //     20% performance improvement
-        // Soundness:
-        //     The iterator is trustedLen because it comes from an `StringArray`.
-        unsafe { TimestampNanosecondArray::from_trusted_len_iter(vec.iter()) }
-    };
+fn string_cast_error<T>(string: &str) -> ArrowError {
+    ArrowError::CastError(format!(
+        "Cannot cast string '{}' to value of {} type",
+        string,
+        std::any::type_name::<T>()
+    ))
+}
 
-    Ok(Arc::new(array) as ArrayRef)
+/// Parses the strings of `from` into a [`PrimitiveArray`] with `parse`, which
+/// returns `None` for the strings that are not valid, see [`parse_strings`].
+fn parse_strings_to_primitive<T, Offset, F, E>(
+    from: &GenericStringArray<Offset>,
+    cast_options: &CastOptions,
+    parse: F,
+    error: E,
+) -> Result<PrimitiveArray<T>>
+where
+    T: ArrowPrimitiveType,
+    Offset: StringOffsetSizeTrait,
+    F: Fn(&str) -> Option<T::Native>,
+    E: Fn(&str) -> ArrowError,
+{
+    let data = parse_strings(
+        from,
+        T::DATA_TYPE,
+        std::mem::size_of::<T::Native>(),
+        cast_options,
+        |string, slot| match parse(string) {
+            Some(value) => {
+                slot.copy_from_slice(value.to_byte_slice());
+                true
+            }
+            None => false,
+        },
+        error,
+    )?;
+    Ok(PrimitiveArray::<T>::from(data))
+}
+
+/// Parses the strings of `from` into the values of an array of `data_type`, whose
+/// values are `width` bytes wide.
+///
+/// The values and the validity of the result are written straight into its buffers,
+/// rather than collected as `Option`s first: `parse` writes the value of a string
+/// into its slot and returns whether the string is valid. Strings that are not
+/// valid are nulls if `cast_options.safe`, and otherwise fail the cast with the
+/// error returned by `error`.
+fn parse_strings<Offset, F, E>(
+    from: &GenericStringArray<Offset>,
+    data_type: DataType,
+    width: usize,
+    cast_options: &CastOptions,
+    mut parse: F,
+    error: E,
+) -> Result<ArrayData>
+where
+    Offset: StringOffsetSizeTrait,
+    F: FnMut(&str, &mut [u8]) -> bool,
+    E: Fn(&str) -> ArrowError,
+{
+    let len = from.len();
+    let mut values = MutableBuffer::from_len_zeroed(len * width);
+    let mut nulls = MutableBuffer::new_null(len);
+    let null_slice = nulls.as_slice_mut();
+    let mut null_count = 0;
+
+    for (i, slot) in values.as_slice_mut().chunks_exact_mut(width).enumerate() {
+        if from.is_null(i) {
+            null_count += 1;
+            continue;
+        }
+        // Safety: `i < from.len()`
+        let string = unsafe { from.value_unchecked(i) };
+        if parse(string, slot) {
+            bit_util::set_bit(null_slice, i);
+        } else if cast_options.safe {
+            null_count += 1;
+        } else {
+            return Err(error(string));
+        }
+    }
+
+    Ok(ArrayData::new(
+        data_type,
+        len,
+        Some(null_count),
+        Some(nulls.into()),
+        0,
+        vec![values.into()],
+        vec![],
+    ))
 }
 
 /// Cast numeric types to Boolean
@@ -1940,6 +1940,61 @@ mod tests {
         }
     }
 
+    #[test]
+    fn test_cast_sliced_utf8_to_i32() {
+        let a = StringArray::from(vec![Some("1"), None, Some("x"), Some("4"), None]);
+        let array = Arc::new(a) as ArrayRef;
+        let array = array.slice(1, 4);
+        let b = cast(&array, &DataType::Int32).unwrap();
+        let c = b.as_any().downcast_ref::<Int32Array>().unwrap();
+        assert_eq!(c, &Int32Array::from(vec![None, None, Some(4), None]));
+        assert_eq!(3, c.null_count());
+    }
+
+    #[test]
+    fn test_cast_utf8_to_decimal() {
+        let a = Arc::new(StringArray::from(vec![
+            Some("123.45"),
+            Some("-0.5"),
+            None,
+            Some("1.234"),
+            Some("12345"),
+            Some("abc"),
+        ])) as ArrayRef;
+        let a2 = Arc::new(LargeStringArray::from(vec![
+            Some("123.45"),
+            Some("-0.5"),
+            None,
+            Some("1.234"),
+            Some("12345"),
+            Some("abc"),
+        ])) as ArrayRef;
+        for array in &[a, a2] {
+            let b = cast(array, &DataType::Decimal(5, 2)).unwrap();
+            assert_eq!(b.data_type(), &DataType::Decimal(5, 2));
+            let c = b.as_any().downcast_ref::<DecimalArray>().unwrap();
+            assert_eq!(12345, c.value(0));
+            assert_eq!(-50, c.value(1));
+            assert!(c.is_null(2));
+            // more fractional digits than the scale
+            assert!(c.is_null(3));
+            // more digits than the precision
+            assert!(c.is_null(4));
+            assert!(c.is_null(5));
+            assert_eq!(4, c.null_count());
+
+            let err = cast_with_options(
+                array,
+                &DataType::Decimal(5, 2),
+                &CastOptions { safe: false },
+            )
+            .unwrap_err();
+            assert!(err
+                .to_string()
+                .contains("Cannot cast string '1.234' to value of Decimal(5, 2) type"));
+        }
+    }
+
     #[test]
     fn test_cast_bool_to_i32() {
         let a = BooleanArray::from(vec![Some(true), Some(false), None]);
@@ -67,6 +67,13 @@ use chrono::{prelude::*, LocalResult};
 /// `1997-01-31T09:26:56.123-05:00`
 #[inline]
 pub fn string_to_timestamp_nanos(s: &str) -> Result<i64> {
+    // Fastest path: a timestamp with an explicit offset in the usual
+    // `YYYY-MM-DD?HH:MM:SS.fffffffff` shape, parsed without chrono's format parser
+    // Example: 2020-09-08T13:42:29.190855Z
+    if let Some(ts) = parse_timestamp_with_offset(s.as_bytes()) {
+        return Ok(ts);
+    }
+
     // Fast path:  RFC3339 timestamp (with a T)
     // Example: 2020-09-08T13:42:29.190855Z
     if let Ok(ts) = DateTime::parse_from_rfc3339(s) {
@@ -154,6 +161,158 @@ fn naive_datetime_to_timestamp(s: &str, datetime: NaiveDateTime) -> Result<i64>
     }
 }
 
+/// Parses `s` like `str::parse::<NaiveDate>`, which accepts dates such as
+/// `2020-09-08` or `2020-9-8`.
+///
+/// Dates in the `YYYY-MM-DD` shape are parsed without going through chrono's
+/// format parser, which is several times slower.
+#[inline]
+pub fn string_to_date(s: &str) -> Option<NaiveDate> {
+    let bytes = s.as_bytes();
+    if bytes.len() == 10 {
+        if let Some(date) = parse_date(bytes) {
+            return Some(date);
+        }
+    }
+    s.parse().ok()
+}
+
+/// Parses `s` like `str::parse::<NaiveDateTime>`, which accepts datetimes such as
+/// `2020-09-08T13:42:29.190855` or `2020-9-8T13:42:29`.
+///
+/// Datetimes in the `YYYY-MM-DDTHH:MM:SS.fffffffff` shape, with an optional
+/// fraction of up to nine digits, are parsed without going through chrono's format
+/// parser.
+#[inline]
+pub fn string_to_datetime(s: &str) -> Option<NaiveDateTime> {
+    match parse_datetime(s.as_bytes()) {
+        Some((datetime, b'T', rest)) if rest.is_empty() => Some(datetime),
+        _ => s.parse().ok(),
+    }
+}
+
+/// Parses `s`, a decimal number such as `-12.345`, as a decimal with `precision`
+/// digits of which `scale` are fractional, and returns its unscaled value.
+///
+/// Returns `None` if `s` is not a number, if it has more fractional digits than
+/// `scale` other than trailing zeros, or if it does not fit `precision` digits.
+pub fn string_to_decimal(s: &str, precision: usize, scale: usize) -> Option<i128> {
+    let bytes = s.as_bytes();
+    let (negative, bytes) = match bytes.first() {
+        Some(b'-') => (true, &bytes[1..]),
+        Some(b'+') => (false, &bytes[1..]),
+        _ => (false, bytes),
+    };
+    let (integer, fraction) = match bytes.iter().position(|&b| b == b'.') {
+        Some(point) => (&bytes[..point], &bytes[point + 1..]),
+        None => (bytes, &[][..]),
+    };
+    if integer.is_empty() && fraction.is_empty() {
+        return None;
+    }
+    let (fraction, extra) = fraction.split_at(fraction.len().min(scale));
+    if !extra.iter().all(|&b| b == b'0') {
+        return None;
+    }
+
+    let mut value: i128 = 0;
+    for &b in integer.iter().chain(fraction) {
+        let digit = b.wrapping_sub(b'0');
+        if digit > 9 {
+            return None;
+        }
+        value = value.checked_mul(10)?.checked_add(digit as i128)?;
+    }
+    value = value.checked_mul(10i128.checked_pow((scale - fraction.len()) as u32)?)?;
+    if let Some(max) = 10i128.checked_pow(precision as u32) {
+        if value >= max {
+            return None;
+        }
+    }
+    Some(if negative { -value } else { value })
+}
+
+/// Parses the `n` ASCII digits at the start of `s`.
+#[inline]
+fn parse_digits(s: &[u8], n: usize) -> Option<u32> {
+    s.get(..n)?.iter().try_fold(0u32, |value, &b| {
+        let digit = b.wrapping_sub(b'0');
+        if digit < 10 {
+            Some(value * 10 + digit as u32)
+        } else {
+            None
+        }
+    })
+}
+
+/// Parses the `YYYY-MM-DD` date at the start of `s`.
+#[inline]
+fn parse_date(s: &[u8]) -> Option<NaiveDate> {
+    if s.len() < 10 || s[4] != b'-' || s[7] != b'-' {
+        return None;
+    }
+    let year = parse_digits(s, 4)?;
+    let month = parse_digits(&s[5..], 2)?;
+    let day = parse_digits(&s[8..], 2)?;
+    NaiveDate::from_ymd_opt(year as i32, month, day)
+}
+
+/// Parses the `YYYY-MM-DD?HH:MM:SS` datetime at the start of `s`, followed by an
+/// optional fraction of up to nine digits. Returns the datetime, its separator `?`
+/// and the rest of `s`.
+#[inline]
+fn parse_datetime(s: &[u8]) -> Option<(NaiveDateTime, u8, &[u8])> {
+    if s.len() < 19 || s[13] != b':' || s[16] != b':' {
+        return None;
+    }
+    let date = parse_date(s)?;
+    let hour = parse_digits(&s[11..], 2)?;
+    let minute = parse_digits(&s[14..], 2)?;
+    let second = parse_digits(&s[17..], 2)?;
+
+    let mut rest = &s[19..];
+    let mut nano = 0;
+    if rest.first() == Some(&b'.') {
+        let digits = rest[1..].iter().take_while(|b| b.is_ascii_digit()).count();
+        if digits == 0 || digits > 9 {
+            return None;
+        }
+        nano = parse_digits(&rest[1..], digits)? * 10u32.pow(9 - digits as u32);
+        rest = &rest[1 + digits..];
+    }
+    let time = NaiveTime::from_hms_nano_opt(hour, minute, second, nano)?;
+    Some((NaiveDateTime::new(date, time), s[10], rest))
+}
+
+/// Parses a timestamp with a `T` or ` ` separator and a `Z` or `±HH:MM` offset as a
+/// nanosecond timestamp, like the RFC3339 formats of [`string_to_timestamp_nanos`].
+fn parse_timestamp_with_offset(s: &[u8]) -> Option<i64> {
+    let (datetime, separator, rest) = parse_datetime(s)?;
+    if separator != b'T' && separator != b' ' {
+        return None;
+    }
+    let offset = if rest == b"Z" {
+        0
+    } else {
+        if rest.len() != 6 || rest[3] != b':' {
+            return None;
+        }
+        let hours = parse_digits(&rest[1..], 2)?;
+        let minutes = parse_digits(&rest[4..], 2)?;
+        if hours > 23 || minutes > 59 {
+            return None;
+        }
+        let offset = (hours * 3600 + minutes * 60) as i64;
+        match rest[0] {
+            b'+' => offset,
+            b'-' => -offset,
+            _ => return None,
+        }
+    };
+    let utc = datetime.checked_sub_signed(chrono::Duration::seconds(offset))?;
+    Some(utc.timestamp_nanos())
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
@@ -274,6 +433,97 @@ mod tests {
         );
     }
 
+    #[test]
+    fn string_to_timestamp_fast_path() {
+        // the fast path agrees with chrono
+        for s in &[
+            "2020-09-08T13:42:29.190855Z",
+            "2020-09-08T13:42:29.1Z",
+            "2020-09-08T13:42:29.123456789+01:30",
+            "2020-09-08 13:42:29-05:00",
+            "1969-12-31T23:59:59.999Z",
+        ] {
+            let expected = DateTime::parse_from_rfc3339(&s.replace(' ', "T"))
+                .unwrap()
+                .timestamp_nanos();
+            assert_eq!(parse_timestamp_with_offset(s.as_bytes()), Some(expected));
+            assert_eq!(string_to_timestamp_nanos(s).unwrap(), expected);
+        }
+        // other shapes are left to chrono
+        for s in &[
+            "2020-09-08T13:42:29",
+            "2020-09-08T13:42:29.Z",
+            "2020-09-08T13:42:29.1234567890Z",
+            "2020-09-08T13:42:60Z",
+            "2020-9-08T13:42:29Z",
+            "2020-09-08T13:42:29+0100",
+        ] {
+            assert_eq!(parse_timestamp_with_offset(s.as_bytes()), None, "{}", s);
+        }
+    }
+
+    #[test]
+    fn string_to_date_and_datetime() {
+        for s in &["2020-09-08", "1969-12-31", "2000-2-2", "0001-01-01"] {
+            assert_eq!(string_to_date(s), Some(s.parse::<NaiveDate>().unwrap()));
+        }
+        for s in &[
+            "2020-02-30",
+            "2020-13-01",
+            "2020-01-01T00:00:00",
+            "2020",
+            "",
+        ] {
+            assert_eq!(string_to_date(s), None, "{}", s);
+        }
+
+        for s in &[
+            "2020-09-08T13:42:29",
+            "2020-09-08T13:42:29.190855",
+            "2020-09-08T13:42:29.123456789",
+            "2020-2-2T12:34:56",
+            "2016-12-31T23:59:60",
+        ] {
+            assert_eq!(
+                string_to_datetime(s),
+                Some(s.parse::<NaiveDateTime>().unwrap()),
+                "{}",
+                s
+            );
+        }
+        for s in &["2020-09-08 13:42:29", "2020-09-08T25:00:00", "2020-09-08"] {
+            assert_eq!(string_to_datetime(s), None, "{}", s);
+        }
+    }
+
+    #[test]
+    fn string_to_decimal_values() {
+        assert_eq!(string_to_decimal("123.45", 5, 2), Some(12345));
+        assert_eq!(string_to_decimal("-123.45", 5, 2), Some(-12345));
+        assert_eq!(string_to_decimal("+1.5", 5, 2), Some(150));
+        assert_eq!(string_to_decimal("7", 5, 2), Some(700));
+        assert_eq!(string_to_decimal(".5", 5, 2), Some(50));
+        assert_eq!(string_to_decimal("1.500", 5, 2), Some(150));
+        assert_eq!(string_to_decimal("0", 1, 0), Some(0));
+        assert_eq!(
+            string_to_decimal("-99999999999999999999999999999999999999", 38, 0),
+            Some(-99_999_999_999_999_999_999_999_999_999_999_999_999)
+        );
+
+        // more fractional digits than the scale
+        assert_eq!(string_to_decimal("1.555", 5, 2), None);
+        // more digits than the precision
+        assert_eq!(string_to_decimal("1234.5", 5, 2), None);
+        assert_eq!(
+            string_to_decimal("100000000000000000000000000000000000000", 38, 0),
+            None
+        );
+        // not numbers
+        for s in &["", "-", ".", "1.2.3", "1e5", " 1", "12a", "--1"] {
+            assert_eq!(string_to_decimal(s, 10, 2), None, "{}", s);
+        }
+    }
+
     // Parse a timestamp to timestamp int with a useful human readable error message
     fn parse_timestamp(s: &str) -> Result<i64> {
         let result = string_to_timestamp_nanos(s);
@@ -0,0 +1,592 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Defines the [BatchCoalescer], which re-batches a stream of record batches, such as
+//! the small batches left by a selective filter, into batches of a target size.
+
+use std::cmp;
+use std::collections::VecDeque;
+
+use crate::array::*;
+use crate::compute::kernels::concat::concat;
+use crate::compute::kernels::group_by::{
+    decode_dictionary, encode_dictionary, is_supported_key_type,
+};
+use crate::compute::SlicesIterator;
+use crate::datatypes::{DataType, IntervalUnit, SchemaRef};
+use crate::error::{ArrowError, Result};
+use crate::record_batch::RecordBatch;
+use crate::util::bit_util;
+
+/// A batch pushed to a [BatchCoalescer], with the ranges of its rows not copied yet
+#[derive(Debug)]
+struct PendingBatch {
+    batch: RecordBatch,
+    // `[start, end[` ranges of the rows to copy, in order
+    ranges: VecDeque<(usize, usize)>,
+    // estimated number of bytes of a row
+    row_bytes: usize,
+}
+
+/// Concatenates the rows of the record batches pushed to it into batches of
+/// `target_rows` rows, and optionally of at most about `target_bytes` bytes.
+///
+/// The pushed batches are kept until their rows are copied into an output batch, so
+/// that each row is copied once, by a single [MutableArrayData] per column of an
+/// output batch. [BatchCoalescer::push_filtered] copies the rows selected by a filter
+/// without building the filtered batch first.
+///
+/// # Example
+/// ```rust
+/// # use std::sync::Arc;
+/// # use arrow::array::{ArrayRef, BooleanArray, Int32Array};
+/// # use arrow::compute::BatchCoalescer;
+/// # use arrow::error::Result;
+/// # use arrow::record_batch::RecordBatch;
+/// # fn main() -> Result<()> {
+/// let batch = RecordBatch::try_from_iter(vec![(
+///     "a",
+///     Arc::new(Int32Array::from(vec![1, 2, 3, 4])) as ArrayRef,
+/// )])?;
+/// let filter = BooleanArray::from(vec![true, false, true, true]);
+///
+/// let mut coalescer = BatchCoalescer::new(batch.schema(), 5);
+/// coalescer.push(batch.clone())?;
+/// assert!(coalescer.next_batch().is_none());
+/// coalescer.push_filtered(batch, &filter)?;
+/// let output = coalescer.next_batch().unwrap();
+/// assert_eq!(output.num_rows(), 5);
+///
+/// // the remaining rows are emitted when the input ends
+/// coalescer.finish()?;
+/// let output = coalescer.next_batch().unwrap();
+/// assert_eq!(output.column(0).as_ref(), &Int32Array::from(vec![3, 4]));
+/// # Ok(())
+/// # }
+/// ```
+#[derive(Debug)]
+pub struct BatchCoalescer {
+    schema: SchemaRef,
+    target_rows: usize,
+    target_bytes: Option<usize>,
+    pending: VecDeque<PendingBatch>,
+    // number of rows and estimated number of bytes of `pending`
+    pending_rows: usize,
+    pending_bytes: usize,
+    completed: VecDeque<RecordBatch>,
+}
+
+impl BatchCoalescer {
+    /// Creates a new [BatchCoalescer] of batches of the schema `schema`, which emits
+    /// batches of `target_rows` rows.
+    /// # Panic
+    /// This function panics if `target_rows` is zero.
+    pub fn new(schema: SchemaRef, target_rows: usize) -> Self {
+        assert!(
+            target_rows > 0,
+            "The target number of rows must be positive"
+        );
+        Self {
+            schema,
+            target_rows,
+            target_bytes: None,
+            pending: VecDeque::new(),
+            pending_rows: 0,
+            pending_bytes: 0,
+            completed: VecDeque::new(),
+        }
+    }
+
+    /// Limits the emitted batches to about `target_bytes` bytes, estimated from the
+    /// size of the values of the pushed batches. A batch has at least one row.
+    pub fn with_target_bytes(mut self, target_bytes: usize) -> Self {
+        self.target_bytes = Some(target_bytes);
+        self
+    }
+
+    /// Returns the schema of the batches of this coalescer.
+    pub fn schema(&self) -> SchemaRef {
+        self.schema.clone()
+    }
+
+    /// Returns the number of rows pushed but not emitted yet.
+    pub fn buffered_rows(&self) -> usize {
+        self.pending_rows
+    }
+
+    /// Pushes the rows of `batch`.
+    /// # Error
+    /// Errors if `batch` does not have the schema of this coalescer.
+    pub fn push(&mut self, batch: RecordBatch) -> Result<()> {
+        let num_rows = batch.num_rows();
+        self.push_ranges(batch, VecDeque::from(vec![(0, num_rows)]))
+    }
+
+    /// Pushes the rows of `batch` for which `filter` is true, like pushing the result of
+    /// [filter_record_batch](crate::compute::filter_record_batch), but copying the rows
+    /// only once.
+    /// WARNING: the nulls of `filter` are ignored and the value on its slot is considered.
+    /// Therefore, it is considered undefined behavior to pass `filter` with null values.
+    /// # Error
+    /// Errors if `batch` does not have the schema of this coalescer, or if `filter`
+    /// does not have a value per row of `batch`.
+    pub fn push_filtered(
+        &mut self,
+        batch: RecordBatch,
+        filter: &BooleanArray,
+    ) -> Result<()> {
+        if filter.len() != batch.num_rows() {
+            return Err(ArrowError::InvalidArgumentError(format!(
+                "The filter has {} values, but the batch has {} rows",
+                filter.len(),
+                batch.num_rows()
+            )));
+        }
+        let ranges = SlicesIterator::new(filter).collect();
+        self.push_ranges(batch, ranges)
+    }
+
+    /// Emits the rows pushed but not emitted yet into batches of at most the target
+    /// size, at the end of the input.
+    pub fn finish(&mut self) -> Result<()> {
+        while self.pending_rows > 0 {
+            self.flush()?;
+        }
+        Ok(())
+    }
+
+    /// Returns the next batch emitted, if any.
+    pub fn next_batch(&mut self) -> Option<RecordBatch> {
+        self.completed.pop_front()
+    }
+
+    fn push_ranges(
+        &mut self,
+        batch: RecordBatch,
+        ranges: VecDeque<(usize, usize)>,
+    ) -> Result<()> {
+        if batch.schema() != self.schema {
+            return Err(ArrowError::InvalidArgumentError(format!(
+                "The batch has the schema {:?}, but the coalescer expects {:?}",
+                batch.schema(),
+                self.schema
+            )));
+        }
+        let rows: usize = ranges.iter().map(|(start, end)| end - start).sum();
+        if rows == 0 {
+            return Ok(());
+        }
+        let row_bytes = estimate_row_bytes(&batch);
+        self.pending_rows += rows;
+        self.pending_bytes += rows * row_bytes;
+        self.pending.push_back(PendingBatch {
+            batch,
+            ranges,
+            row_bytes,
+        });
+
+        while self.is_full() {
+            self.flush()?;
+        }
+        Ok(())
+    }
+
+    fn is_full(&self) -> bool {
+        let full_bytes = match self.target_bytes {
+            Some(target_bytes) => self.pending_bytes >= target_bytes,
+            None => false,
+        };
+        self.pending_rows > 0 && (self.pending_rows >= self.target_rows || full_bytes)
+    }
+
+    /// Copies the first pending rows into a batch of at most the target size.
+    fn flush(&mut self) -> Result<()> {
+        // the `(pending batch, start, end)` ranges to copy
+        let mut plan = vec![];
+        let mut rows = 0;
+        let mut bytes = 0;
+        'batches: for (index, pending) in self.pending.iter().enumerate() {
+            for &(start, end) in &pending.ranges {
+                let mut len = cmp::min(end - start, self.target_rows - rows);
+                if let Some(target_bytes) = self.target_bytes {
+                    let max_len = target_bytes.saturating_sub(bytes) / pending.row_bytes;
+                    // a batch has at least one row, whatever its size
+                    len = cmp::min(len, cmp::max(max_len, (rows == 0) as usize));
+                }
+                if len == 0 {
+                    break 'batches;
+                }
+                plan.push((index, start, start + len));
+                rows += len;
+                bytes += len * pending.row_bytes;
+                if start + len < end {
+                    break 'batches;
+                }
+            }
+        }
+
+        let first = &self.pending[0].batch;
+        let batch = if plan.len() == 1 && plan[0] == (0, 0, first.num_rows()) {
+            // the batch is emitted as is
+            first.clone()
+        } else {
+            let num_batches = plan[plan.len() - 1].0 + 1;
+            let columns = self
+                .schema
+                .fields()
+                .iter()
+                .enumerate()
+                .map(|(column, field)| {
+                    if let DataType::Dictionary(key_type, _) = field.data_type() {
+                        if num_batches > 1 && is_supported_key_type(field.data_type()) {
+                            // joining the dictionaries of the batches can overflow
+                            // the keys, so the values are encoded in a new dictionary
+                            let arrays = self
+                                .pending
+                                .iter()
+                                .take(num_batches)
+                                .map(|pending| pending.batch.column(column))
+                                .collect::<Vec<_>>();
+                            return merge_dictionaries(key_type, &arrays, &plan);
+                        }
+                    }
+                    let arrays = self
+                        .pending
+                        .iter()
+                        .take(num_batches)
+                        .map(|pending| pending.batch.column(column).data_ref())
+                        .collect::<Vec<_>>();
+                    let mut mutable = MutableArrayData::new(arrays, false, rows);
+                    for &(index, start, end) in &plan {
+                        mutable.extend(index, start, end);
+                    }
+                    Ok(make_array(mutable.freeze()))
+                })
+                .collect::<Result<_>>()?;
+            RecordBatch::try_new(self.schema.clone(), columns)?
+        };
+        self.completed.push_back(batch);
+
+        // the ranges of the plan are the first ranges of the pending batches
+        for &(_, _, end) in &plan {
+            let pending = self.pending.front_mut().unwrap();
+            let range = pending.ranges.front_mut().unwrap();
+            if end == range.1 {
+                pending.ranges.pop_front();
+            } else {
+                range.0 = end;
+            }
+            if pending.ranges.is_empty() {
+                self.pending.pop_front();
+            }
+        }
+        self.pending_rows -= rows;
+        self.pending_bytes -= bytes;
+        Ok(())
+    }
+}
+
+/// Estimates the number of bytes of a row of `batch`, which has rows.
+fn estimate_row_bytes(batch: &RecordBatch) -> usize {
+    let bytes: usize = batch
+        .columns()
+        .iter()
+        .map(|column| estimate_array_bytes(column.data_ref()))
+        .sum();
+    // a row has at least one byte, so that the target size bounds the rows
+    cmp::max(bit_util::ceil(bytes, batch.num_rows()), 1)
+}
+
+/// Copies the `(array, start, end)` ranges of the dictionary arrays `arrays` into a
+/// dictionary array with keys of type `key_type` and a dictionary of only the values
+/// of the ranges, instead of joining the dictionaries of `arrays`, which can overflow
+/// the keys.
+pub(crate) fn merge_dictionaries(
+    key_type: &DataType,
+    arrays: &[&ArrayRef],
+    ranges: &[(usize, usize, usize)],
+) -> Result<ArrayRef> {
+    let values = ranges
+        .iter()
+        .map(|&(index, start, end)| {
+            decode_dictionary(&arrays[index].slice(start, end - start))
+        })
+        .collect::<Result<Vec<_>>>()?;
+    let values = concat(&values.iter().map(|a| a.as_ref()).collect::<Vec<_>>())?;
+    encode_dictionary(key_type, &values)
+}
+
+/// Estimates the number of bytes of the values of `data`. Unlike the size of its
+/// buffers, this only counts the rows of `data` when it is a slice of a larger array.
+///
+/// The values of a dictionary array are not counted, only its keys.
+pub fn estimate_array_bytes(data: &ArrayData) -> usize {
+    let len = data.len();
+    let nulls = match data.null_buffer() {
+        Some(_) => bit_util::ceil(len, 8),
+        None => 0,
+    };
+    let values = match data.data_type() {
+        DataType::Boolean => bit_util::ceil(len, 8),
+        DataType::Utf8 | DataType::Binary => {
+            let offsets = data.buffer::<i32>(0);
+            (offsets[len] - offsets[0]) as usize + len * 4
+        }
+        DataType::LargeUtf8 | DataType::LargeBinary => {
+            let offsets = data.buffer::<i64>(0);
+            (offsets[len] - offsets[0]) as usize + len * 8
+        }
+        data_type => match value_width(data_type) {
+            Some(width) => len * width,
+            // the buffers of the other types can not be sliced
+            None => data.get_buffer_memory_size(),
+        },
+    };
+    nulls + values
+}
+
+/// Returns the number of bytes of a value of the type `data_type`, if it has a fixed
+/// width. The values of dictionaries are not counted, as they are shared by the rows.
+fn value_width(data_type: &DataType) -> Option<usize> {
+    Some(match data_type {
+        DataType::Int8 | DataType::UInt8 => 1,
+        DataType::Int16 | DataType::UInt16 | DataType::Float16 => 2,
+        DataType::Int32
+        | DataType::UInt32
+        | DataType::Float32
+        | DataType::Date32
+        | DataType::Time32(_)
+        | DataType::Interval(IntervalUnit::YearMonth) => 4,
+        DataType::Int64
+        | DataType::UInt64
+        | DataType::Float64
+        | DataType::Date64
+        | DataType::Time64(_)
+        | DataType::Timestamp(_, _)
+        | DataType::Duration(_)
+        | DataType::Interval(IntervalUnit::DayTime) => 8,
+        DataType::FixedSizeBinary(size) => *size as usize,
+        DataType::Dictionary(key_type, _) => return value_width(key_type),
+        _ => return None,
+    })
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use std::sync::Arc;
+
+    use crate::compute::{concat, filter_record_batch};
+    use crate::datatypes::Int8Type;
+
+    fn test_batch(offset: i32, len: i32) -> RecordBatch {
+        let ints: Int32Array = (offset..offset + len)
+            .map(|i| Some(i).filter(|i| i % 3 != 0))
+            .collect();
+        let strings: StringArray = (offset..offset + len)
+            .map(|i| Some(format!("value {}", i)))
+            .collect();
+        RecordBatch::try_from_iter(vec![
+            ("ints", Arc::new(ints) as ArrayRef),
+            ("strings", Arc::new(strings) as ArrayRef),
+        ])
+        .unwrap()
+    }
+
+    fn collect(coalescer: &mut BatchCoalescer) -> Vec<RecordBatch> {
+        std::iter::from_fn(|| coalescer.next_batch()).collect()
+    }
+
+    /// Asserts that `batches` have the rows of `expected`, in order.
+    fn assert_rows(batches: &[RecordBatch], expected: &[RecordBatch]) {
+        for column in 0..2 {
+            let concat_columns = |batches: &[RecordBatch]| {
+                let arrays = batches
+                    .iter()
+                    .map(|batch| batch.column(column).as_ref())
+                    .collect::<Vec<_>>();
+                concat(&arrays).unwrap()
+            };
+            assert_eq!(concat_columns(batches), concat_columns(expected));
+        }
+    }
+
+    #[test]
+    fn test_coalesce() -> Result<()> {
+        let batches = (0..10).map(|i| test_batch(i * 7, 7)).collect::<Vec<_>>();
+        let mut coalescer = BatchCoalescer::new(batches[0].schema(), 20);
+
+        let mut output = vec![];
+        for batch in &batches {
+            coalescer.push(batch.clone())?;
+            output.extend(collect(&mut coalescer));
+        }
+        assert_eq!(output.len(), 3);
+        assert_eq!(coalescer.buffered_rows(), 10);
+        coalescer.finish()?;
+        output.extend(collect(&mut coalescer));
+
+        let num_rows = output.iter().map(|b| b.num_rows()).collect::<Vec<_>>();
+        assert_eq!(num_rows, vec![20, 20, 20, 10]);
+        assert_rows(&output, &batches);
+        Ok(())
+    }
+
+    #[test]
+    fn test_coalesce_large_batch() -> Result<()> {
+        let batch = test_batch(0, 50);
+        let mut coalescer = BatchCoalescer::new(batch.schema(), 20);
+        coalescer.push(test_batch(0, 5))?;
+        coalescer.push(batch.clone())?;
+        coalescer.finish()?;
+        let output = collect(&mut coalescer);
+
+        let num_rows = output.iter().map(|b| b.num_rows()).collect::<Vec<_>>();
+        assert_eq!(num_rows, vec![20, 20, 15]);
+        assert_rows(&output, &[test_batch(0, 5), batch]);
+        Ok(())
+    }
+
+    #[test]
+    fn test_coalesce_batch_of_target_size() -> Result<()> {
+        let batch = test_batch(0, 20);
+        let mut coalescer = BatchCoalescer::new(batch.schema(), 20);
+        coalescer.push(batch.clone())?;
+
+        // the batch is not copied
+        let output = coalescer.next_batch().unwrap();
+        assert!(Arc::ptr_eq(output.column(1), batch.column(1)));
+        coalescer.finish()?;
+        assert!(coalescer.next_batch().is_none());
+        Ok(())
+    }
+
+    #[test]
+    fn test_coalesce_filtered() -> Result<()> {
+        let batches = (0..10).map(|i| test_batch(i * 64, 64)).collect::<Vec<_>>();
+        let filter: BooleanArray = (0..64).map(|i| Some(i % 5 == 0 || i > 60)).collect();
+        let mut coalescer = BatchCoalescer::new(batches[0].schema(), 50);
+        let mut expected = vec![];
+        for batch in &batches {
+            coalescer.push_filtered(batch.clone(), &filter)?;
+            expected.push(filter_record_batch(batch, &filter)?);
+        }
+        coalescer.finish()?;
+        let output = collect(&mut coalescer);
+
+        let num_rows = output.iter().map(|b| b.num_rows()).collect::<Vec<_>>();
+        assert_eq!(num_rows, vec![50, 50, 50, 10]);
+        assert_rows(&output, &expected);
+
+        let err =
+            coalescer.push_filtered(batches[0].clone(), &BooleanArray::from(vec![true]));
+        assert!(err.is_err());
+        Ok(())
+    }
+
+    #[test]
+    fn test_coalesce_target_bytes() -> Result<()> {
+        let values = Int64Array::from((0..100).collect::<Vec<_>>());
+        let batch =
+            RecordBatch::try_from_iter(vec![("a", Arc::new(values) as ArrayRef)])?;
+        let sliced =
+            RecordBatch::try_new(batch.schema(), vec![batch.column(0).slice(10, 30)])?;
+        let mut coalescer =
+            BatchCoalescer::new(batch.schema(), 1000).with_target_bytes(8 * 16);
+        coalescer.push(sliced)?;
+        coalescer.finish()?;
+        let output = collect(&mut coalescer);
+
+        // the rows outside of the slice do not count
+        let num_rows = output.iter().map(|b| b.num_rows()).collect::<Vec<_>>();
+        assert_eq!(num_rows, vec![16, 14]);
+        let column = output[1].column(0);
+        let column = column.as_any().downcast_ref::<Int64Array>().unwrap();
+        assert_eq!(column.value(0), 26);
+        Ok(())
+    }
+
+    #[test]
+    fn test_coalesce_dictionary() -> Result<()> {
+        // each batch has its own dictionary of 100 values, too many to join for Int8
+        let batches = (0..3)
+            .map(|i| {
+                let values = (0..100)
+                    .map(|j| Some(format!("{} {}", i, j)))
+                    .collect::<StringArray>();
+                let mut keys = PrimitiveBuilder::<Int8Type>::new(4);
+                for key in &[Some(i as i8), None, Some(99), Some(i as i8)] {
+                    keys.append_option(*key)?;
+                }
+                let column = keys.finish_dict(Arc::new(values));
+                RecordBatch::try_from_iter(vec![("a", Arc::new(column) as ArrayRef)])
+            })
+            .collect::<Result<Vec<_>>>()?;
+        let mut coalescer = BatchCoalescer::new(batches[0].schema(), 10);
+        let filter = BooleanArray::from(vec![true, true, true, false]);
+        for batch in &batches {
+            coalescer.push_filtered(batch.clone(), &filter)?;
+        }
+        coalescer.finish()?;
+        let output = collect(&mut coalescer);
+
+        let num_rows = output.iter().map(|b| b.num_rows()).collect::<Vec<_>>();
+        assert_eq!(num_rows, vec![9]);
+        let column = output[0].column(0);
+        assert_eq!(column.data_type(), batches[0].schema().field(0).data_type());
+        let column = column
+            .as_any()
+            .downcast_ref::<DictionaryArray<Int8Type>>()
+            .unwrap();
+        let values = column.values();
+        let values = values.as_any().downcast_ref::<StringArray>().unwrap();
+        assert_eq!(values.len(), 6);
+        let rows = column
+            .keys()
+            .iter()
+            .map(|k| k.map(|k| values.value(k as usize)))
+            .collect::<Vec<_>>();
+        assert_eq!(
+            rows,
+            vec![
+                Some("0 0"),
+                None,
+                Some("0 99"),
+                Some("1 1"),
+                None,
+                Some("1 99"),
+                Some("2 2"),
+                None,
+                Some("2 99"),
+            ]
+        );
+        Ok(())
+    }
+
+    #[test]
+    fn test_coalesce_wrong_schema() {
+        let batch = test_batch(0, 10);
+        let other = RecordBatch::try_from_iter(vec![(
+            "a",
+            Arc::new(Int32Array::from(vec![1])) as ArrayRef,
+        )])
+        .unwrap();
+        let mut coalescer = BatchCoalescer::new(batch.schema(), 10);
+        assert!(coalescer.push(other).is_err());
+    }
+}
@@ -23,7 +23,7 @@
 //! [here](https://doc.rust-lang.org/stable/core/arch/) for more information.
 
 use regex::Regex;
-use std::collections::HashMap;
+use std::collections::hash_map::{Entry, HashMap};
 
 use crate::array::*;
 use crate::buffer::{Buffer, MutableBuffer};
@@ -204,29 +204,144 @@ where
     compare_op_scalar_primitive!(left, right, op)
 }
 
-/// Perform SQL `left LIKE right` operation on [`StringArray`] / [`LargeStringArray`].
-///
-/// There are two wildcards supported with the LIKE operator:
-///
-/// 1. `%` - The percent sign represents zero, one, or multiple characters
-/// 2. `_` - The underscore represents a single character
-///
-/// For example:
-/// ```
-/// use arrow::array::{StringArray, BooleanArray};
-/// use arrow::compute::like_utf8;
-///
-/// let strings = StringArray::from(vec!["Arrow", "Arrow", "Arrow", "Ar"]);
-/// let patterns = StringArray::from(vec!["A%", "B%", "A.", "A."]);
+/// The shapes of `LIKE` patterns that are matched without a regular expression.
+#[derive(Debug, Clone)]
+enum LikeMatcher {
+    /// No wildcards
+    Equals(String),
+    /// A single trailing `%`
+    StartsWith(String),
+    /// A single leading `%`
+    EndsWith(String),
+    /// A leading and a trailing `%`
+    Contains(String),
+    /// Any other pattern
+    Regex(Regex),
+}
+
+/// A `LIKE` pattern compiled once to match many strings, for example the rows of all
+/// the batches a query filters with the same pattern, see [`like_utf8_pattern`].
 ///
-/// let result = like_utf8(&strings, &patterns).unwrap();
-/// assert_eq!(result, BooleanArray::from(vec![true, false, false, true]));
-/// ```
-pub fn like_utf8<OffsetSize: StringOffsetSizeTrait>(
+/// The patterns without wildcards, with a single `%` at the start, at the end or at
+/// both ends are matched by comparing or searching for their literal part, and the
+/// others with a regular expression in which characters other than the wildcards
+/// keep their meaning. So that both agree, the patterns whose literal part contains
+/// such characters, like `a.c`, are always matched with a regular expression.
+#[derive(Debug, Clone)]
+pub struct LikePattern {
+    matcher: LikeMatcher,
+}
+
+impl LikePattern {
+    /// Compiles the `LIKE` pattern `pattern`.
+    pub fn new(pattern: &str) -> Result<Self> {
+        let is_literal = |s: &str| !s.contains(|c| is_like_pattern(c) || is_meta(c));
+        let len = pattern.len();
+        let matcher = if is_literal(pattern) {
+            LikeMatcher::Equals(pattern.to_string())
+        } else if len >= 2
+            && pattern.starts_with('%')
+            && pattern.ends_with('%')
+            && is_literal(&pattern[1..len - 1])
+        {
+            LikeMatcher::Contains(pattern[1..len - 1].to_string())
+        } else if pattern.ends_with('%') && is_literal(&pattern[..len - 1]) {
+            LikeMatcher::StartsWith(pattern[..len - 1].to_string())
+        } else if pattern.starts_with('%') && is_literal(&pattern[1..]) {
+            LikeMatcher::EndsWith(pattern[1..].to_string())
+        } else {
+            let re_pattern = pattern.replace("%", ".*").replace("_", ".");
+            let re = Regex::new(&format!("^{}$", re_pattern)).map_err(|e| {
+                ArrowError::ComputeError(format!(
+                    "Unable to build regex from LIKE pattern: {}",
+                    e
+                ))
+            })?;
+            LikeMatcher::Regex(re)
+        };
+        Ok(Self { matcher })
+    }
+
+    /// Returns whether `haystack` matches this pattern.
+    #[inline]
+    pub fn is_match(&self, haystack: &str) -> bool {
+        match &self.matcher {
+            LikeMatcher::Equals(s) => haystack == s,
+            LikeMatcher::StartsWith(s) => haystack.starts_with(s.as_str()),
+            LikeMatcher::EndsWith(s) => haystack.ends_with(s.as_str()),
+            LikeMatcher::Contains(s) => haystack.contains(s.as_str()),
+            LikeMatcher::Regex(re) => re.is_match(haystack),
+        }
+    }
+
+    /// Returns the bitmap of the values of `array` which match this pattern, or which
+    /// do not if `negate`, choosing how to match once rather than for every value.
+    fn match_array<OffsetSize: StringOffsetSizeTrait>(
+        &self,
+        array: &GenericStringArray<OffsetSize>,
+        negate: bool,
+    ) -> Buffer {
+        let range = 0..array.len();
+        // the iterators have the length of `range`
+        let buffer = unsafe {
+            match &self.matcher {
+                LikeMatcher::Equals(s) => MutableBuffer::from_trusted_len_iter_bool(
+                    range.map(|i| (array.value(i) == s) != negate),
+                ),
+                LikeMatcher::StartsWith(s) => MutableBuffer::from_trusted_len_iter_bool(
+                    range.map(|i| array.value(i).starts_with(s.as_str()) != negate),
+                ),
+                LikeMatcher::EndsWith(s) => MutableBuffer::from_trusted_len_iter_bool(
+                    range.map(|i| array.value(i).ends_with(s.as_str()) != negate),
+                ),
+                LikeMatcher::Contains(s) => MutableBuffer::from_trusted_len_iter_bool(
+                    range.map(|i| array.value(i).contains(s.as_str()) != negate),
+                ),
+                LikeMatcher::Regex(re) => MutableBuffer::from_trusted_len_iter_bool(
+                    range.map(|i| re.is_match(array.value(i)) != negate),
+                ),
+            }
+        };
+        buffer.into()
+    }
+}
+
+fn is_like_pattern(c: char) -> bool {
+    c == '%' || c == '_'
+}
+
+/// Returns whether `c` has a meaning in a regular expression, like the characters
+/// escaped by [`regex::escape`].
+fn is_meta(c: char) -> bool {
+    matches!(
+        c,
+        '\\' | '.'
+            | '+'
+            | '*'
+            | '?'
+            | '('
+            | ')'
+            | '|'
+            | '['
+            | ']'
+            | '{'
+            | '}'
+            | '^'
+            | '$'
+            | '#'
+            | '&'
+            | '-'
+            | '~'
+    )
+}
+
+/// Matches each value of `left` with the `LIKE` pattern at the same index of `right`,
+/// compiling each distinct pattern once.
+fn like_utf8_impl<OffsetSize: StringOffsetSizeTrait>(
     left: &GenericStringArray<OffsetSize>,
     right: &GenericStringArray<OffsetSize>,
+    negate: bool,
 ) -> Result<BooleanArray> {
-    let mut map = HashMap::new();
     if left.len() != right.len() {
         return Err(ArrowError::ComputeError(
             "Cannot perform comparison operation on arrays of different length"
@@ -237,25 +352,17 @@ pub fn like_utf8<OffsetSize: StringOffsetSizeTrait>(
     let null_bit_buffer =
         combine_option_bitmap(left.data_ref(), right.data_ref(), left.len())?;
 
+    let mut patterns: HashMap<&str, LikePattern> = HashMap::new();
     let mut result = BooleanBufferBuilder::new(left.len());
     for i in 0..left.len() {
-        let haystack = left.value(i);
-        let pat = right.value(i);
-        let re = if let Some(ref regex) = map.get(pat) {
-            regex
-        } else {
-            let re_pattern = pat.replace("%", ".*").replace("_", ".");
-            let re = Regex::new(&format!("^{}$", re_pattern)).map_err(|e| {
-                ArrowError::ComputeError(format!(
-                    "Unable to build regex from LIKE pattern: {}",
-                    e
-                ))
-            })?;
-            map.insert(pat, re);
-            map.get(pat).unwrap()
+        let pattern = match patterns.entry(right.value(i)) {
+            Entry::Occupied(entry) => entry.into_mut(),
+            Entry::Vacant(entry) => {
+                let pattern = LikePattern::new(entry.key())?;
+                entry.insert(pattern)
+            }
         };
-
-        result.append(re.is_match(haystack));
+        result.append(pattern.is_match(left.value(i)) != negate);
     }
 
     let data = ArrayData::new(
@@ -270,74 +377,87 @@ pub fn like_utf8<OffsetSize: StringOffsetSizeTrait>(
     Ok(BooleanArray::from(data))
 }
 
-fn is_like_pattern(c: char) -> bool {
-    c == '%' || c == '_'
+fn like_utf8_pattern_impl<OffsetSize: StringOffsetSizeTrait>(
+    left: &GenericStringArray<OffsetSize>,
+    right: &LikePattern,
+    negate: bool,
+) -> BooleanArray {
+    let data = ArrayData::new(
+        DataType::Boolean,
+        left.len(),
+        None,
+        left.data()
+            .null_buffer()
+            .map(|buffer| buffer.bit_slice(left.offset(), left.len())),
+        0,
+        vec![right.match_array(left, negate)],
+        vec![],
+    );
+    BooleanArray::from(data)
+}
+
+/// Perform SQL `left LIKE right` operation on [`StringArray`] / [`LargeStringArray`].
+///
+/// There are two wildcards supported with the LIKE operator:
+///
+/// 1. `%` - The percent sign represents zero, one, or multiple characters
+/// 2. `_` - The underscore represents a single character
+///
+/// For example:
+/// ```
+/// use arrow::array::{StringArray, BooleanArray};
+/// use arrow::compute::like_utf8;
+///
+/// let strings = StringArray::from(vec!["Arrow", "Arrow", "Arrow", "Ar"]);
+/// let patterns = StringArray::from(vec!["A%", "B%", "A.", "A."]);
+///
+/// let result = like_utf8(&strings, &patterns).unwrap();
+/// assert_eq!(result, BooleanArray::from(vec![true, false, false, true]));
+/// ```
+///
+/// Each distinct pattern is compiled once, see [`LikePattern`].
+pub fn like_utf8<OffsetSize: StringOffsetSizeTrait>(
+    left: &GenericStringArray<OffsetSize>,
+    right: &GenericStringArray<OffsetSize>,
+) -> Result<BooleanArray> {
+    like_utf8_impl(left, right, false)
 }
 
 /// Perform SQL `left LIKE right` operation on [`StringArray`] /
 /// [`LargeStringArray`] and a scalar.
 ///
-/// See the documentation on [`like_utf8`] for more details.
+/// See the documentation on [`like_utf8`] for more details. To match many arrays with
+/// the same pattern, compile it once and use [`like_utf8_pattern`].
 pub fn like_utf8_scalar<OffsetSize: StringOffsetSizeTrait>(
     left: &GenericStringArray<OffsetSize>,
     right: &str,
 ) -> Result<BooleanArray> {
-    let null_bit_buffer = left.data().null_buffer().cloned();
-    let bytes = bit_util::ceil(left.len(), 8);
-    let mut bool_buf = MutableBuffer::from_len_zeroed(bytes);
-    let bool_slice = bool_buf.as_slice_mut();
-
-    if !right.contains(is_like_pattern) {
-        // fast path, can use equals
-        for i in 0..left.len() {
-            if left.value(i) == right {
-                bit_util::set_bit(bool_slice, i);
-            }
-        }
-    } else if right.ends_with('%') && !right[..right.len() - 1].contains(is_like_pattern)
-    {
-        // fast path, can use starts_with
-        let starts_with = &right[..right.len() - 1];
-        for i in 0..left.len() {
-            if left.value(i).starts_with(starts_with) {
-                bit_util::set_bit(bool_slice, i);
-            }
-        }
-    } else if right.starts_with('%') && !right[1..].contains(is_like_pattern) {
-        // fast path, can use ends_with
-        let ends_with = &right[1..];
-        for i in 0..left.len() {
-            if left.value(i).ends_with(ends_with) {
-                bit_util::set_bit(bool_slice, i);
-            }
-        }
-    } else {
-        let re_pattern = right.replace("%", ".*").replace("_", ".");
-        let re = Regex::new(&format!("^{}$", re_pattern)).map_err(|e| {
-            ArrowError::ComputeError(format!(
-                "Unable to build regex from LIKE pattern: {}",
-                e
-            ))
-        })?;
-
-        for i in 0..left.len() {
-            let haystack = left.value(i);
-            if re.is_match(haystack) {
-                bit_util::set_bit(bool_slice, i);
-            }
-        }
-    };
+    Ok(like_utf8_pattern_impl(
+        left,
+        &LikePattern::new(right)?,
+        false,
+    ))
+}
 
-    let data = ArrayData::new(
-        DataType::Boolean,
-        left.len(),
-        None,
-        null_bit_buffer,
-        0,
-        vec![bool_buf.into()],
-        vec![],
-    );
-    Ok(BooleanArray::from(data))
+/// Perform SQL `left LIKE right` operation on [`StringArray`] /
+/// [`LargeStringArray`] and a compiled pattern.
+///
+/// For example:
+/// ```
+/// use arrow::array::{StringArray, BooleanArray};
+/// use arrow::compute::{like_utf8_pattern, LikePattern};
+///
+/// let pattern = LikePattern::new("%row%").unwrap();
+/// for strings in vec![vec!["Arrow", "Parquet"], vec!["Arrows", "Rows"]] {
+///     let result = like_utf8_pattern(&StringArray::from(strings), &pattern);
+///     assert_eq!(result, BooleanArray::from(vec![true, false]));
+/// }
+/// ```
+pub fn like_utf8_pattern<OffsetSize: StringOffsetSizeTrait>(
+    left: &GenericStringArray<OffsetSize>,
+    right: &LikePattern,
+) -> BooleanArray {
+    like_utf8_pattern_impl(left, right, false)
 }
 
 /// Perform SQL `left NOT LIKE right` operation on [`StringArray`] /
@@ -348,48 +468,7 @@ pub fn nlike_utf8<OffsetSize: StringOffsetSizeTrait>(
     left: &GenericStringArray<OffsetSize>,
     right: &GenericStringArray<OffsetSize>,
 ) -> Result<BooleanArray> {
-    let mut map = HashMap::new();
-    if left.len() != right.len() {
-        return Err(ArrowError::ComputeError(
-            "Cannot perform comparison operation on arrays of different length"
-                .to_string(),
-        ));
-    }
-
-    let null_bit_buffer =
-        combine_option_bitmap(left.data_ref(), right.data_ref(), left.len())?;
-
-    let mut result = BooleanBufferBuilder::new(left.len());
-    for i in 0..left.len() {
-        let haystack = left.value(i);
-        let pat = right.value(i);
-        let re = if let Some(ref regex) = map.get(pat) {
-            regex
-        } else {
-            let re_pattern = pat.replace("%", ".*").replace("_", ".");
-            let re = Regex::new(&format!("^{}$", re_pattern)).map_err(|e| {
-                ArrowError::ComputeError(format!(
-                    "Unable to build regex from LIKE pattern: {}",
-                    e
-                ))
-            })?;
-            map.insert(pat, re);
-            map.get(pat).unwrap()
-        };
-
-        result.append(!re.is_match(haystack));
-    }
-
-    let data = ArrayData::new(
-        DataType::Boolean,
-        left.len(),
-        None,
-        null_bit_buffer,
-        0,
-        vec![result.finish()],
-        vec![],
-    );
-    Ok(BooleanArray::from(data))
+    like_utf8_impl(left, right, true)
 }
 
 /// Perform SQL `left NOT LIKE right` operation on [`StringArray`] /
@@ -400,49 +479,22 @@ pub fn nlike_utf8_scalar<OffsetSize: StringOffsetSizeTrait>(
     left: &GenericStringArray<OffsetSize>,
     right: &str,
 ) -> Result<BooleanArray> {
-    let null_bit_buffer = left.data().null_buffer().cloned();
-    let mut result = BooleanBufferBuilder::new(left.len());
-
-    if !right.contains(is_like_pattern) {
-        // fast path, can use equals
-        for i in 0..left.len() {
-            result.append(left.value(i) != right);
-        }
-    } else if right.ends_with('%') && !right[..right.len() - 1].contains(is_like_pattern)
-    {
-        // fast path, can use ends_with
-        for i in 0..left.len() {
-            result.append(!left.value(i).starts_with(&right[..right.len() - 1]));
-        }
-    } else if right.starts_with('%') && !right[1..].contains(is_like_pattern) {
-        // fast path, can use starts_with
-        for i in 0..left.len() {
-            result.append(!left.value(i).ends_with(&right[1..]));
-        }
-    } else {
-        let re_pattern = right.replace("%", ".*").replace("_", ".");
-        let re = Regex::new(&format!("^{}$", re_pattern)).map_err(|e| {
-            ArrowError::ComputeError(format!(
-                "Unable to build regex from LIKE pattern: {}",
-                e
-            ))
-        })?;
-        for i in 0..left.len() {
-            let haystack = left.value(i);
-            result.append(!re.is_match(haystack));
-        }
-    }
+    Ok(like_utf8_pattern_impl(
+        left,
+        &LikePattern::new(right)?,
+        true,
+    ))
+}
 
-    let data = ArrayData::new(
-        DataType::Boolean,
-        left.len(),
-        None,
-        null_bit_buffer,
-        0,
-        vec![result.finish()],
-        vec![],
-    );
-    Ok(BooleanArray::from(data))
+/// Perform SQL `left NOT LIKE right` operation on [`StringArray`] /
+/// [`LargeStringArray`] and a compiled pattern.
+///
+/// See the documentation on [`like_utf8_pattern`] for more details.
+pub fn nlike_utf8_pattern<OffsetSize: StringOffsetSizeTrait>(
+    left: &GenericStringArray<OffsetSize>,
+    right: &LikePattern,
+) -> BooleanArray {
+    like_utf8_pattern_impl(left, right, true)
 }
 
 /// Perform `left == right` operation on [`StringArray`] / [`LargeStringArray`].
@@ -1480,6 +1532,64 @@ mod tests {
         vec![false, true, false, false]
     );
 
+    test_utf8_scalar!(
+        test_utf8_array_like_scalar_contains,
+        vec!["arrow", "parrows", "arr", "row"],
+        "%rrow%",
+        like_utf8_scalar,
+        vec![true, true, false, false]
+    );
+
+    test_utf8_scalar!(
+        test_utf8_array_like_scalar_regex_chars,
+        vec!["a.c", "abc", "a.cd", "ac"],
+        "a.c%",
+        like_utf8_scalar,
+        vec![true, true, true, false]
+    );
+
+    #[test]
+    fn test_like_pattern() {
+        let strings = vec!["", "arrow", "parrow", "arrows", "ärröw", "a.c", "abc", "%"];
+        let patterns = vec![
+            "", "%", "%%", "arrow", "arrow%", "%arrow", "%rro%", "_rr%", "%r_w", "ä%",
+            "__", "a.c", "%.c", "a%c",
+        ];
+        let left = StringArray::from(strings.clone());
+        for pattern in patterns {
+            let compiled = LikePattern::new(pattern).unwrap();
+            let right = StringArray::from(vec![pattern; strings.len()]);
+            let expected = like_utf8(&left, &right).unwrap();
+            let negated = nlike_utf8(&left, &right).unwrap();
+            assert_eq!(like_utf8_scalar(&left, pattern).unwrap(), expected);
+            assert_eq!(like_utf8_pattern(&left, &compiled), expected);
+            assert_eq!(nlike_utf8_scalar(&left, pattern).unwrap(), negated);
+            assert_eq!(nlike_utf8_pattern(&left, &compiled), negated);
+            // all the patterns keep the meaning of a regular expression
+            let re_pattern = pattern.replace("%", ".*").replace("_", ".");
+            let re = Regex::new(&format!("^{}$", re_pattern)).unwrap();
+            for (i, string) in strings.iter().enumerate() {
+                assert_eq!(re.is_match(string), expected.value(i), "{}", pattern);
+                assert_eq!(compiled.is_match(string), expected.value(i), "{}", pattern);
+                assert_ne!(expected.value(i), negated.value(i));
+            }
+        }
+    }
+
+    #[test]
+    fn test_like_pattern_nulls() {
+        let left = StringArray::from(vec![Some("arrow"), None, Some("parquet")]);
+        let right = StringArray::from(vec![Some("%row"), Some("%"), None]);
+        let result = like_utf8(&left, &right).unwrap();
+        assert_eq!(result, BooleanArray::from(vec![Some(true), None, None]));
+
+        let pattern = LikePattern::new("%r%").unwrap();
+        let sliced = left.slice(1, 2);
+        let sliced = sliced.as_any().downcast_ref::<StringArray>().unwrap();
+        let result = nlike_utf8_pattern(sliced, &pattern);
+        assert_eq!(result, BooleanArray::from(vec![None, Some(false)]));
+    }
+
     test_utf8!(
         test_utf8_array_nlike,
         vec!["arrow", "arrow", "arrow", "arrow", "arrow", "arrows", "arrow"],
@@ -0,0 +1,1188 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Defines a hash aggregation kernel, which groups the rows of record batches by the
+//! values of some of their columns, and aggregates other columns for each group.
+//!
+//! ```
+//! # use std::sync::Arc;
+//! # use arrow::array::{Array, Float64Array, Int32Array, StringArray, UInt64Array};
+//! # use arrow::compute::kernels::group_by::{hash_aggregate, AggregateFunction};
+//! # use arrow::datatypes::{DataType, Field, Schema};
+//! # use arrow::record_batch::RecordBatch;
+//! let schema = Arc::new(Schema::new(vec![
+//!     Field::new("name", DataType::Utf8, false),
+//!     Field::new("value", DataType::Int32, true),
+//! ]));
+//! let batch = RecordBatch::try_new(
+//!     schema,
+//!     vec![
+//!         Arc::new(StringArray::from(vec!["a", "b", "a"])),
+//!         Arc::new(Int32Array::from(vec![Some(1), None, Some(5)])),
+//!     ],
+//! )
+//! .unwrap();
+//!
+//! let result = hash_aggregate(
+//!     &batch,
+//!     &[0],
+//!     &[(1, AggregateFunction::Count), (1, AggregateFunction::Mean)],
+//! )
+//! .unwrap();
+//! // groups are in the order of their first row
+//! assert_eq!(result.schema().field(2).name(), "MEAN(value)");
+//! assert_eq!(result.column(0).as_ref(), &StringArray::from(vec!["a", "b"]) as &dyn Array);
+//! assert_eq!(result.column(1).as_ref(), &UInt64Array::from(vec![2, 0]) as &dyn Array);
+//! assert_eq!(
+//!     result.column(2).as_ref(),
+//!     &Float64Array::from(vec![Some(3.0), None]) as &dyn Array
+//! );
+//! ```
+
+use std::collections::HashMap;
+use std::fmt;
+use std::hash::{BuildHasherDefault, Hasher};
+use std::sync::Arc;
+
+use num::ToPrimitive;
+
+use crate::array::*;
+use crate::compute::kernels::concat::concat;
+use crate::compute::kernels::take::take;
+use crate::datatypes::*;
+use crate::error::{ArrowError, Result};
+use crate::record_batch::RecordBatch;
+
+/// An aggregate function of a [`HashAggregator`].
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub enum AggregateFunction {
+    /// The number of non-null values, as a `UInt64` column
+    Count,
+    /// The sum of the values of a numeric column
+    Sum,
+    /// The minimum of the values of a numeric column
+    Min,
+    /// The maximum of the values of a numeric column
+    Max,
+    /// The mean of the values of a numeric column, as a `Float64` column
+    Mean,
+}
+
+impl fmt::Display for AggregateFunction {
+    fn fmt(&self, f: &mut fmt::Formatter) -> fmt::Result {
+        let name = match self {
+            AggregateFunction::Count => "COUNT",
+            AggregateFunction::Sum => "SUM",
+            AggregateFunction::Min => "MIN",
+            AggregateFunction::Max => "MAX",
+            AggregateFunction::Mean => "MEAN",
+        };
+        write!(f, "{}", name)
+    }
+}
+
+/// Groups the rows of `batch` by the columns `group_columns`, and computes the
+/// `aggregates` of each group, given as the index of the aggregated column and the
+/// aggregate function.
+///
+/// See [`HashAggregator`] for the columns of the returned record batch.
+pub fn hash_aggregate(
+    batch: &RecordBatch,
+    group_columns: &[usize],
+    aggregates: &[(usize, AggregateFunction)],
+) -> Result<RecordBatch> {
+    let mut aggregator = HashAggregator::try_new(
+        batch.schema().as_ref(),
+        group_columns.to_vec(),
+        aggregates.to_vec(),
+    )?;
+    aggregator.update(batch)?;
+    aggregator.finish()
+}
+
+/// Groups the rows of a sequence of record batches by the values of some of their
+/// columns, and aggregates other columns for each group.
+///
+/// The record batch returned by [`HashAggregator::finish`] contains a row for each
+/// group, in the order of their first row. Its columns are the group columns, followed
+/// by a column for each aggregate, named after its function and column, such as
+/// `SUM(price)`. Aggregates of groups without non-null values are null, except for
+/// `COUNT` which is 0.
+///
+/// Group columns can be of any primitive, boolean, string, binary or dictionary type.
+/// Rows with null values in the same group columns are in the same group, and
+/// floating point values are grouped by their bit pattern.
+pub struct HashAggregator {
+    group_columns: Vec<usize>,
+    aggregates: Vec<(usize, AggregateFunction)>,
+    /// The group id of each encoded group key
+    groups: HashMap<Box<[u8]>, u32, BuildHasherDefault<KeyHasher>>,
+    /// For each group column, the values of the first row of each group
+    group_values: Vec<Vec<ArrayRef>>,
+    accumulators: Vec<Box<dyn GroupAccumulator>>,
+    schema: SchemaRef,
+}
+
+impl HashAggregator {
+    /// Creates an aggregator of record batches with schema `input_schema`, grouped by
+    /// the columns `group_columns`.
+    ///
+    /// Returns an error if a group column or an aggregate function does not support
+    /// the type of its column.
+    pub fn try_new(
+        input_schema: &Schema,
+        group_columns: Vec<usize>,
+        aggregates: Vec<(usize, AggregateFunction)>,
+    ) -> Result<Self> {
+        let field = |i: usize| {
+            input_schema.fields().get(i).ok_or_else(|| {
+                ArrowError::InvalidArgumentError(format!(
+                    "Column index {} is out of bounds of {} columns",
+                    i,
+                    input_schema.fields().len()
+                ))
+            })
+        };
+
+        let mut fields = Vec::with_capacity(group_columns.len() + aggregates.len());
+        for i in &group_columns {
+            let field = field(*i)?;
+            if !is_supported_key_type(field.data_type()) {
+                return Err(ArrowError::InvalidArgumentError(format!(
+                    "Cannot group by column {} of type {:?}",
+                    field.name(),
+                    field.data_type()
+                )));
+            }
+            fields.push(field.clone());
+        }
+        let mut accumulators = Vec::with_capacity(aggregates.len());
+        for (i, function) in &aggregates {
+            let field = field(*i)?;
+            let accumulator = create_accumulator(*function, field.data_type())?;
+            fields.push(Field::new(
+                &format!("{}({})", function, field.name()),
+                accumulator.data_type(),
+                *function != AggregateFunction::Count,
+            ));
+            accumulators.push(accumulator);
+        }
+
+        Ok(Self {
+            group_values: vec![vec![]; group_columns.len()],
+            group_columns,
+            aggregates,
+            groups: HashMap::default(),
+            accumulators,
+            schema: Arc::new(Schema::new(fields)),
+        })
+    }
+
+    /// Returns the schema of the record batch returned by [`HashAggregator::finish`].
+    pub fn schema(&self) -> SchemaRef {
+        self.schema.clone()
+    }
+
+    /// Returns the number of groups so far
+    pub fn num_groups(&self) -> usize {
+        self.groups.len()
+    }
+
+    /// Adds the rows of `batch` to their groups.
+    pub fn update(&mut self, batch: &RecordBatch) -> Result<()> {
+        let keys = self
+            .group_columns
+            .iter()
+            .map(|i| batch.column(*i).clone())
+            .collect::<Vec<_>>();
+        let group_ids = self.group_ids(&keys, batch.num_rows())?;
+
+        let num_groups = self.groups.len();
+        for (accumulator, (i, _)) in self.accumulators.iter_mut().zip(&self.aggregates) {
+            accumulator.update(batch.column(*i).as_ref(), &group_ids, num_groups)?;
+        }
+        Ok(())
+    }
+
+    /// Returns the group id of each row of `keys`, assigning new ids to new groups.
+    fn group_ids(&mut self, keys: &[ArrayRef], num_rows: usize) -> Result<Vec<u32>> {
+        let row_keys = RowKeys::try_new(keys, num_rows)?;
+        let mut group_ids = Vec::with_capacity(num_rows);
+        let mut new_groups = vec![];
+        for i in 0..num_rows {
+            let key = row_keys.row(i);
+            let group_id = match self.groups.get(key) {
+                Some(group_id) => *group_id,
+                None => {
+                    let group_id = self.groups.len() as u32;
+                    self.groups.insert(key.into(), group_id);
+                    new_groups.push(i as u32);
+                    group_id
+                }
+            };
+            group_ids.push(group_id);
+        }
+
+        if !new_groups.is_empty() {
+            let indices = UInt32Array::from(new_groups);
+            for (values, key) in self.group_values.iter_mut().zip(keys) {
+                // keeping the dictionary of each batch would join them all in `finish`
+                let key = take(key.as_ref(), &indices, None)?;
+                values.push(decode_dictionary(&key)?);
+            }
+        }
+        Ok(group_ids)
+    }
+
+    /// Returns the values of the group columns and aggregates of each group.
+    pub fn finish(mut self) -> Result<RecordBatch> {
+        let mut columns = Vec::with_capacity(self.schema.fields().len());
+        for (values, field) in self.group_values.iter().zip(self.schema.fields()) {
+            let column = match values.len() {
+                0 => new_empty_array(field.data_type()),
+                1 => values[0].clone(),
+                _ => concat(&values.iter().map(|a| a.as_ref()).collect::<Vec<_>>())?,
+            };
+            let column = match field.data_type() {
+                DataType::Dictionary(key_type, _) if !values.is_empty() => {
+                    encode_dictionary(key_type, &column)?
+                }
+                _ => column,
+            };
+            columns.push(column);
+        }
+        for accumulator in self.accumulators.iter_mut() {
+            columns.push(accumulator.finish(self.groups.len())?);
+        }
+        RecordBatch::try_new(self.schema, columns)
+    }
+}
+
+/// A [`Hasher`] of encoded group keys, which reads them 8 bytes at a time.
+#[derive(Default)]
+struct KeyHasher {
+    hash: u64,
+}
+
+impl KeyHasher {
+    #[inline]
+    fn add(&mut self, word: u64) {
+        // the multiplier of FxHash
+        self.hash =
+            (self.hash.rotate_left(5) ^ word).wrapping_mul(0x51_7c_c1_b7_27_22_0a_95);
+    }
+}
+
+impl Hasher for KeyHasher {
+    #[inline]
+    fn write(&mut self, bytes: &[u8]) {
+        let mut chunks = bytes.chunks_exact(8);
+        for chunk in &mut chunks {
+            let mut word = [0; 8];
+            word.copy_from_slice(chunk);
+            self.add(u64::from_le_bytes(word));
+        }
+        let remainder = chunks.remainder();
+        if !remainder.is_empty() {
+            let mut word = [0; 8];
+            word[..remainder.len()].copy_from_slice(remainder);
+            self.add(u64::from_le_bytes(word));
+        }
+    }
+
+    #[inline]
+    fn write_usize(&mut self, i: usize) {
+        self.add(i as u64);
+    }
+
+    #[inline]
+    fn finish(&self) -> u64 {
+        self.hash
+    }
+}
+
+/// The key of each row of some columns, encoded so that rows are equal if and only if
+/// their encoded keys are equal.
+///
+/// The key of a row is the concatenation of the keys of its values. A null value is a
+/// 0 byte, and a valid value is a 1 byte followed by its bytes, prefixed with their
+/// length for variable length types.
+pub(crate) struct RowKeys {
+    data: Vec<u8>,
+    /// The offset of the key of each row in `data`, followed by the length of `data`
+    offsets: Vec<usize>,
+}
+
+impl RowKeys {
+    /// Encodes the keys of the `num_rows` rows of `columns`.
+    pub(crate) fn try_new(columns: &[ArrayRef], num_rows: usize) -> Result<Self> {
+        let mut columns = columns
+            .iter()
+            .map(|column| Self::try_new_column(column.as_ref()))
+            .collect::<Result<Vec<_>>>()?;
+        if columns.len() == 1 {
+            return Ok(columns.pop().unwrap());
+        }
+
+        let mut offsets = Vec::with_capacity(num_rows + 1);
+        offsets.push(0);
+        let mut len = 0;
+        for i in 0..num_rows {
+            len += columns.iter().map(|keys| keys.row(i).len()).sum::<usize>();
+            offsets.push(len);
+        }
+        let mut data = Vec::with_capacity(len);
+        for i in 0..num_rows {
+            for keys in &columns {
+                data.extend_from_slice(keys.row(i));
+            }
+        }
+        Ok(Self { data, offsets })
+    }
+
+    /// Encodes the keys of the values of `array`.
+    fn try_new_column(array: &Array) -> Result<Self> {
+        let mut keys = Self {
+            data: vec![],
+            offsets: Vec::with_capacity(array.len() + 1),
+        };
+        keys.offsets.push(0);
+        match array.data_type() {
+            DataType::Boolean => {
+                let array = array.as_any().downcast_ref::<BooleanArray>().unwrap();
+                keys.data.reserve(array.len() * 2);
+                keys.extend(array, |data, i| data.push(array.value(i) as u8));
+            }
+            DataType::Utf8 => {
+                let array = array.as_any().downcast_ref::<StringArray>().unwrap();
+                keys.extend(array, |data, i| push_bytes(data, array.value(i).as_bytes()));
+            }
+            DataType::LargeUtf8 => {
+                let array = array.as_any().downcast_ref::<LargeStringArray>().unwrap();
+                keys.extend(array, |data, i| push_bytes(data, array.value(i).as_bytes()));
+            }
+            DataType::Binary => {
+                let array = array.as_any().downcast_ref::<BinaryArray>().unwrap();
+                keys.extend(array, |data, i| push_bytes(data, array.value(i)));
+            }
+            DataType::LargeBinary => {
+                let array = array.as_any().downcast_ref::<LargeBinaryArray>().unwrap();
+                keys.extend(array, |data, i| push_bytes(data, array.value(i)));
+            }
+            DataType::Dictionary(key_type, _) => match key_type.as_ref() {
+                DataType::Int8 => keys.extend_dictionary::<Int8Type>(array)?,
+                DataType::Int16 => keys.extend_dictionary::<Int16Type>(array)?,
+                DataType::Int32 => keys.extend_dictionary::<Int32Type>(array)?,
+                DataType::Int64 => keys.extend_dictionary::<Int64Type>(array)?,
+                DataType::UInt8 => keys.extend_dictionary::<UInt8Type>(array)?,
+                DataType::UInt16 => keys.extend_dictionary::<UInt16Type>(array)?,
+                DataType::UInt32 => keys.extend_dictionary::<UInt32Type>(array)?,
+                DataType::UInt64 => keys.extend_dictionary::<UInt64Type>(array)?,
+                t => {
+                    return Err(ArrowError::InvalidArgumentError(format!(
+                        "Dictionary key type {:?} not supported",
+                        t
+                    )))
+                }
+            },
+            data_type => {
+                let width = fixed_width(data_type).ok_or_else(|| {
+                    ArrowError::InvalidArgumentError(format!(
+                        "Cannot group by values of type {:?}",
+                        data_type
+                    ))
+                })?;
+                // the values of all fixed width types are in their first buffer
+                let values =
+                    &array.data().buffers()[0].as_slice()[array.offset() * width..];
+                keys.data.reserve(array.len() * (width + 1));
+                keys.extend(array, |data, i| {
+                    data.extend_from_slice(&values[i * width..(i + 1) * width])
+                });
+            }
+        }
+        Ok(keys)
+    }
+
+    /// Appends the keys of the values of `array`, written by `push` for valid values.
+    #[inline]
+    fn extend<F: FnMut(&mut Vec<u8>, usize)>(&mut self, array: &Array, mut push: F) {
+        for i in 0..array.len() {
+            if array.is_valid(i) {
+                self.data.push(1);
+                push(&mut self.data, i);
+            } else {
+                self.data.push(0);
+            }
+            self.offsets.push(self.data.len());
+        }
+    }
+
+    /// Appends the keys of the values of a dictionary array, which are the keys of its
+    /// values.
+    fn extend_dictionary<K: ArrowDictionaryKeyType>(
+        &mut self,
+        array: &Array,
+    ) -> Result<()> {
+        let array = array.as_any().downcast_ref::<DictionaryArray<K>>().unwrap();
+        let values = Self::try_new_column(array.values().as_ref())?;
+        let keys = array.keys();
+        for i in 0..keys.len() {
+            if keys.is_valid(i) {
+                let key = keys.value(i).to_usize().filter(|key| *key < values.len());
+                let key = key.ok_or_else(|| {
+                    ArrowError::InvalidArgumentError(format!(
+                        "Dictionary key {:?} is out of bounds of {} values",
+                        keys.value(i),
+                        values.len()
+                    ))
+                })?;
+                // null values are encoded as null keys
+                self.data.extend_from_slice(values.row(key));
+            } else {
+                self.data.push(0);
+            }
+            self.offsets.push(self.data.len());
+        }
+        Ok(())
+    }
+
+    /// Returns the number of rows.
+    pub(crate) fn len(&self) -> usize {
+        self.offsets.len() - 1
+    }
+
+    /// Returns the encoded key of row `i`.
+    #[inline]
+    pub(crate) fn row(&self, i: usize) -> &[u8] {
+        &self.data[self.offsets[i]..self.offsets[i + 1]]
+    }
+}
+
+/// Returns the values of the dictionary array `array`, or `array` if it is not a
+/// dictionary array.
+pub(crate) fn decode_dictionary(array: &ArrayRef) -> Result<ArrayRef> {
+    fn decode<K>(array: &Array) -> Result<ArrayRef>
+    where
+        K: ArrowDictionaryKeyType + ArrowNumericType,
+    {
+        let array = array.as_any().downcast_ref::<DictionaryArray<K>>().unwrap();
+        take(array.values().as_ref(), array.keys(), None)
+    }
+
+    match array.data_type() {
+        DataType::Dictionary(key_type, _) => match key_type.as_ref() {
+            DataType::Int8 => decode::<Int8Type>(array.as_ref()),
+            DataType::Int16 => decode::<Int16Type>(array.as_ref()),
+            DataType::Int32 => decode::<Int32Type>(array.as_ref()),
+            DataType::Int64 => decode::<Int64Type>(array.as_ref()),
+            DataType::UInt8 => decode::<UInt8Type>(array.as_ref()),
+            DataType::UInt16 => decode::<UInt16Type>(array.as_ref()),
+            DataType::UInt32 => decode::<UInt32Type>(array.as_ref()),
+            DataType::UInt64 => decode::<UInt64Type>(array.as_ref()),
+            t => Err(ArrowError::InvalidArgumentError(format!(
+                "Dictionary key type {:?} not supported",
+                t
+            ))),
+        },
+        _ => Ok(array.clone()),
+    }
+}
+
+/// Encodes `values` as a dictionary array with keys of type `key_type`, whose
+/// dictionary holds each distinct value of `values` once.
+///
+/// Returns an error if the number of distinct values does not fit the key type.
+pub(crate) fn encode_dictionary(
+    key_type: &DataType,
+    values: &ArrayRef,
+) -> Result<ArrayRef> {
+    fn encode<K: ArrowDictionaryKeyType>(values: &ArrayRef) -> Result<ArrayRef> {
+        let row_keys = RowKeys::try_new_column(values.as_ref())?;
+        let mut distinct: HashMap<&[u8], K::Native, BuildHasherDefault<KeyHasher>> =
+            HashMap::default();
+        let mut distinct_rows = vec![];
+        let mut keys = PrimitiveBuilder::<K>::new(values.len());
+        for i in 0..values.len() {
+            if values.is_null(i) {
+                keys.append_null()?;
+                continue;
+            }
+            let key = match distinct.get(row_keys.row(i)) {
+                Some(key) => *key,
+                None => {
+                    let key = K::Native::from_usize(distinct_rows.len())
+                        .ok_or(ArrowError::DictionaryKeyOverflowError)?;
+                    distinct.insert(row_keys.row(i), key);
+                    distinct_rows.push(i as u32);
+                    key
+                }
+            };
+            keys.append_value(key)?;
+        }
+        let dictionary = take(values.as_ref(), &UInt32Array::from(distinct_rows), None)?;
+        Ok(Arc::new(keys.finish_dict(dictionary)))
+    }
+
+    match key_type {
+        DataType::Int8 => encode::<Int8Type>(values),
+        DataType::Int16 => encode::<Int16Type>(values),
+        DataType::Int32 => encode::<Int32Type>(values),
+        DataType::Int64 => encode::<Int64Type>(values),
+        DataType::UInt8 => encode::<UInt8Type>(values),
+        DataType::UInt16 => encode::<UInt16Type>(values),
+        DataType::UInt32 => encode::<UInt32Type>(values),
+        DataType::UInt64 => encode::<UInt64Type>(values),
+        t => Err(ArrowError::InvalidArgumentError(format!(
+            "Dictionary key type {:?} not supported",
+            t
+        ))),
+    }
+}
+
+/// Appends `bytes`, prefixed with their length.
+#[inline]
+fn push_bytes(data: &mut Vec<u8>, bytes: &[u8]) {
+    data.extend_from_slice(&(bytes.len() as u64).to_le_bytes());
+    data.extend_from_slice(bytes);
+}
+
+/// Returns the width in bytes of the values of a fixed width type other than boolean.
+pub(crate) fn fixed_width(data_type: &DataType) -> Option<usize> {
+    match data_type {
+        DataType::Int8 | DataType::UInt8 => Some(1),
+        DataType::Int16 | DataType::UInt16 | DataType::Float16 => Some(2),
+        DataType::Int32
+        | DataType::UInt32
+        | DataType::Float32
+        | DataType::Date32
+        | DataType::Time32(_)
+        | DataType::Interval(IntervalUnit::YearMonth) => Some(4),
+        DataType::Int64
+        | DataType::UInt64
+        | DataType::Float64
+        | DataType::Date64
+        | DataType::Time64(_)
+        | DataType::Timestamp(_, _)
+        | DataType::Duration(_)
+        | DataType::Interval(IntervalUnit::DayTime) => Some(8),
+        DataType::Decimal(_, _) => Some(16),
+        DataType::FixedSizeBinary(width) => Some(*width as usize),
+        _ => None,
+    }
+}
+
+/// Returns whether [`RowKeys`] can encode the values of `data_type`.
+pub(crate) fn is_supported_key_type(data_type: &DataType) -> bool {
+    match data_type {
+        DataType::Boolean
+        | DataType::Utf8
+        | DataType::LargeUtf8
+        | DataType::Binary
+        | DataType::LargeBinary => true,
+        DataType::Dictionary(key_type, value_type) => {
+            matches!(
+                key_type.as_ref(),
+                DataType::Int8
+                    | DataType::Int16
+                    | DataType::Int32
+                    | DataType::Int64
+                    | DataType::UInt8
+                    | DataType::UInt16
+                    | DataType::UInt32
+                    | DataType::UInt64
+            ) && is_supported_key_type(value_type)
+        }
+        data_type => fixed_width(data_type).is_some(),
+    }
+}
+
+/// Accumulates the values of a column for each group.
+trait GroupAccumulator {
+    /// Returns the type of the aggregated values.
+    fn data_type(&self) -> DataType;
+
+    /// Adds each of `values` to the group of the same index in `group_ids`, where
+    /// `num_groups` is the number of groups so far.
+    fn update(
+        &mut self,
+        values: &Array,
+        group_ids: &[u32],
+        num_groups: usize,
+    ) -> Result<()>;
+
+    /// Returns the aggregated values of the `num_groups` groups.
+    fn finish(&mut self, num_groups: usize) -> Result<ArrayRef>;
+}
+
+/// Creates the accumulator of `function` over values of type `data_type`.
+fn create_accumulator(
+    function: AggregateFunction,
+    data_type: &DataType,
+) -> Result<Box<dyn GroupAccumulator>> {
+    macro_rules! numeric_accumulator {
+        ($($data_type:ident => $arrow_type:ty),*) => {
+            match data_type {
+                $(DataType::$data_type => {
+                    let accumulator: Box<dyn GroupAccumulator> = match function {
+                        AggregateFunction::Count => Box::new(CountAccumulator::default()),
+                        AggregateFunction::Sum => Box::new(
+                            PrimitiveAccumulator::<$arrow_type, _>::new(|a, b| a + b),
+                        ),
+                        AggregateFunction::Min => Box::new(
+                            PrimitiveAccumulator::<$arrow_type, _>::new(|a, b| {
+                                if (is_nan(a) && !is_nan(b)) || a > b { b } else { a }
+                            }),
+                        ),
+                        AggregateFunction::Max => Box::new(
+                            PrimitiveAccumulator::<$arrow_type, _>::new(|a, b| {
+                                if (!is_nan(a) && is_nan(b)) || a < b { b } else { a }
+                            }),
+                        ),
+                        AggregateFunction::Mean => {
+                            Box::new(MeanAccumulator::<$arrow_type>::default())
+                        }
+                    };
+                    Ok(accumulator)
+                })*
+                _ if function == AggregateFunction::Count => {
+                    Ok(Box::new(CountAccumulator::default()) as Box<dyn GroupAccumulator>)
+                }
+                t => Err(ArrowError::InvalidArgumentError(format!(
+                    "Aggregate function {} not supported for type {:?}",
+                    function, t
+                ))),
+            }
+        };
+    }
+
+    numeric_accumulator!(
+        Int8 => Int8Type,
+        Int16 => Int16Type,
+        Int32 => Int32Type,
+        Int64 => Int64Type,
+        UInt8 => UInt8Type,
+        UInt16 => UInt16Type,
+        UInt32 => UInt32Type,
+        UInt64 => UInt64Type,
+        Float32 => Float32Type,
+        Float64 => Float64Type
+    )
+}
+
+#[inline]
+#[allow(clippy::eq_op)]
+fn is_nan<T: PartialOrd + Copy>(a: T) -> bool {
+    !(a == a)
+}
+
+/// Counts the non-null values of each group.
+#[derive(Default)]
+struct CountAccumulator {
+    counts: Vec<u64>,
+}
+
+impl GroupAccumulator for CountAccumulator {
+    fn data_type(&self) -> DataType {
+        DataType::UInt64
+    }
+
+    fn update(
+        &mut self,
+        values: &Array,
+        group_ids: &[u32],
+        num_groups: usize,
+    ) -> Result<()> {
+        self.counts.resize(num_groups, 0);
+        if values.null_count() == 0 {
+            for group_id in group_ids {
+                self.counts[*group_id as usize] += 1;
+            }
+        } else {
+            for (i, group_id) in group_ids.iter().enumerate() {
+                if values.is_valid(i) {
+                    self.counts[*group_id as usize] += 1;
+                }
+            }
+        }
+        Ok(())
+    }
+
+    fn finish(&mut self, num_groups: usize) -> Result<ArrayRef> {
+        self.counts.resize(num_groups, 0);
+        let counts = std::mem::replace(&mut self.counts, vec![]);
+        Ok(Arc::new(UInt64Array::from(counts)))
+    }
+}
+
+/// Combines the values of each group with a function, such as `+` for sums.
+struct PrimitiveAccumulator<T: ArrowPrimitiveType, F> {
+    values: Vec<T::Native>,
+    /// Whether each group has a non-null value
+    valid: Vec<bool>,
+    combine: F,
+}
+
+impl<T: ArrowPrimitiveType, F> PrimitiveAccumulator<T, F>
+where
+    F: Fn(T::Native, T::Native) -> T::Native,
+{
+    fn new(combine: F) -> Self {
+        Self {
+            values: vec![],
+            valid: vec![],
+            combine,
+        }
+    }
+
+    #[inline]
+    fn add(&mut self, group_id: u32, value: T::Native) {
+        let group_id = group_id as usize;
+        if self.valid[group_id] {
+            self.values[group_id] = (self.combine)(self.values[group_id], value);
+        } else {
+            self.values[group_id] = value;
+            self.valid[group_id] = true;
+        }
+    }
+}
+
+impl<T: ArrowPrimitiveType, F> GroupAccumulator for PrimitiveAccumulator<T, F>
+where
+    F: Fn(T::Native, T::Native) -> T::Native,
+{
+    fn data_type(&self) -> DataType {
+        T::DATA_TYPE
+    }
+
+    fn update(
+        &mut self,
+        values: &Array,
+        group_ids: &[u32],
+        num_groups: usize,
+    ) -> Result<()> {
+        self.values.resize(num_groups, T::Native::default());
+        self.valid.resize(num_groups, false);
+        let values = values.as_any().downcast_ref::<PrimitiveArray<T>>().unwrap();
+        if values.null_count() == 0 {
+            for (value, group_id) in values.values().iter().zip(group_ids) {
+                self.add(*group_id, *value);
+            }
+        } else {
+            for (value, group_id) in values.iter().zip(group_ids) {
+                if let Some(value) = value {
+                    self.add(*group_id, value);
+                }
+            }
+        }
+        Ok(())
+    }
+
+    fn finish(&mut self, num_groups: usize) -> Result<ArrayRef> {
+        self.values.resize(num_groups, T::Native::default());
+        self.valid.resize(num_groups, false);
+        let array = self
+            .values
+            .iter()
+            .zip(&self.valid)
+            .map(|(value, valid)| if *valid { Some(*value) } else { None })
+            .collect::<PrimitiveArray<T>>();
+        Ok(Arc::new(array))
+    }
+}
+
+/// Computes the mean of the values of each group.
+struct MeanAccumulator<T: ArrowPrimitiveType> {
+    sums: Vec<f64>,
+    counts: Vec<u64>,
+    phantom: std::marker::PhantomData<T>,
+}
+
+impl<T: ArrowPrimitiveType> Default for MeanAccumulator<T> {
+    fn default() -> Self {
+        Self {
+            sums: vec![],
+            counts: vec![],
+            phantom: std::marker::PhantomData,
+        }
+    }
+}
+
+impl<T: ArrowPrimitiveType> GroupAccumulator for MeanAccumulator<T>
+where
+    T::Native: ToPrimitive,
+{
+    fn data_type(&self) -> DataType {
+        DataType::Float64
+    }
+
+    fn update(
+        &mut self,
+        values: &Array,
+        group_ids: &[u32],
+        num_groups: usize,
+    ) -> Result<()> {
+        self.sums.resize(num_groups, 0.0);
+        self.counts.resize(num_groups, 0);
+        let values = values.as_any().downcast_ref::<PrimitiveArray<T>>().unwrap();
+        for (value, group_id) in values.iter().zip(group_ids) {
+            if let Some(value) = value {
+                let group_id = *group_id as usize;
+                self.sums[group_id] += value.to_f64().unwrap_or(f64::NAN);
+                self.counts[group_id] += 1;
+            }
+        }
+        Ok(())
+    }
+
+    fn finish(&mut self, num_groups: usize) -> Result<ArrayRef> {
+        self.sums.resize(num_groups, 0.0);
+        self.counts.resize(num_groups, 0);
+        let array = self
+            .sums
+            .iter()
+            .zip(&self.counts)
+            .map(|(sum, count)| {
+                if *count > 0 {
+                    Some(sum / *count as f64)
+                } else {
+                    None
+                }
+            })
+            .collect::<Float64Array>();
+        Ok(Arc::new(array))
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn batch(columns: Vec<ArrayRef>) -> RecordBatch {
+        let fields = columns
+            .iter()
+            .enumerate()
+            .map(|(i, column)| {
+                Field::new(&format!("c{}", i), column.data_type().clone(), true)
+            })
+            .collect();
+        RecordBatch::try_new(Arc::new(Schema::new(fields)), columns).unwrap()
+    }
+
+    #[test]
+    fn test_hash_aggregate_primitive() {
+        let batch = batch(vec![
+            Arc::new(Int32Array::from(vec![
+                Some(1),
+                Some(2),
+                None,
+                Some(1),
+                None,
+                Some(2),
+            ])),
+            Arc::new(Float64Array::from(vec![
+                Some(1.0),
+                Some(2.0),
+                Some(3.0),
+                None,
+                Some(5.0),
+                Some(f64::NAN),
+            ])),
+        ]);
+        let result = hash_aggregate(
+            &batch,
+            &[0],
+            &[
+                (1, AggregateFunction::Count),
+                (1, AggregateFunction::Sum),
+                (1, AggregateFunction::Min),
+                (1, AggregateFunction::Max),
+                (1, AggregateFunction::Mean),
+            ],
+        )
+        .unwrap();
+
+        let names = result
+            .schema()
+            .fields()
+            .iter()
+            .map(|f| f.name().clone())
+            .collect::<Vec<_>>();
+        assert_eq!(
+            names,
+            vec![
+                "c0",
+                "COUNT(c1)",
+                "SUM(c1)",
+                "MIN(c1)",
+                "MAX(c1)",
+                "MEAN(c1)"
+            ]
+        );
+        assert_eq!(
+            result.column(0).as_ref(),
+            &Int32Array::from(vec![Some(1), Some(2), None]) as &Array
+        );
+        assert_eq!(
+            result.column(1).as_ref(),
+            &UInt64Array::from(vec![1, 2, 2]) as &Array
+        );
+        let sum = as_primitive_array::<Float64Type>(result.column(2));
+        assert_eq!(sum.value(0), 1.0);
+        assert!(sum.value(1).is_nan());
+        assert_eq!(sum.value(2), 8.0);
+        // NaN is larger than any other value, as in `min` and `max`
+        let min = as_primitive_array::<Float64Type>(result.column(3));
+        assert_eq!((min.value(0), min.value(1), min.value(2)), (1.0, 2.0, 3.0));
+        let max = as_primitive_array::<Float64Type>(result.column(4));
+        assert_eq!(max.value(0), 1.0);
+        assert!(max.value(1).is_nan());
+        assert_eq!(max.value(2), 5.0);
+        let mean = as_primitive_array::<Float64Type>(result.column(5));
+        assert_eq!(mean.value(0), 1.0);
+        assert!(mean.value(1).is_nan());
+        assert_eq!(mean.value(2), 4.0);
+    }
+
+    #[test]
+    fn test_hash_aggregate_multiple_columns() {
+        let strings: DictionaryArray<Int8Type> =
+            vec![Some("a"), Some("b"), Some("a"), None, Some("a"), None]
+                .into_iter()
+                .collect();
+        let batch = batch(vec![
+            Arc::new(StringArray::from(vec!["x", "x", "x", "y", "y", "y"])),
+            Arc::new(strings),
+            Arc::new(BooleanArray::from(vec![
+                true, true, false, true, true, true,
+            ])),
+            Arc::new(UInt8Array::from(vec![1, 2, 3, 4, 5, 6])),
+        ]);
+        let result = hash_aggregate(
+            &batch,
+            &[0, 1, 2],
+            &[(3, AggregateFunction::Sum), (1, AggregateFunction::Count)],
+        )
+        .unwrap();
+
+        assert_eq!(result.num_rows(), 5);
+        assert_eq!(result.column(1).data_type(), batch.column(1).data_type());
+        assert_eq!(
+            result.column(0).as_ref(),
+            &StringArray::from(vec!["x", "x", "x", "y", "y"]) as &Array
+        );
+        assert_eq!(
+            result.column(2).as_ref(),
+            &BooleanArray::from(vec![true, true, false, true, true]) as &Array
+        );
+        assert_eq!(
+            result.column(3).as_ref(),
+            &UInt8Array::from(vec![1, 2, 3, 10, 5]) as &Array
+        );
+        assert_eq!(
+            result.column(4).as_ref(),
+            &UInt64Array::from(vec![1, 1, 1, 0, 1]) as &Array
+        );
+        let dictionary = as_dictionary_array::<Int8Type>(result.column(1));
+        let values = dictionary.values();
+        let values = as_string_array(&values);
+        let keys = dictionary.keys();
+        let strings = (0..5)
+            .map(|i| {
+                if keys.is_valid(i) {
+                    Some(values.value(keys.value(i) as usize))
+                } else {
+                    None
+                }
+            })
+            .collect::<Vec<_>>();
+        assert_eq!(
+            strings,
+            vec![Some("a"), Some("b"), Some("a"), None, Some("a")]
+        );
+    }
+
+    #[test]
+    fn test_hash_aggregator_batches() {
+        let schema = Schema::new(vec![
+            Field::new("key", DataType::LargeUtf8, true),
+            Field::new("value", DataType::Int64, false),
+        ]);
+        let mut aggregator = HashAggregator::try_new(
+            &schema,
+            vec![0],
+            vec![(1, AggregateFunction::Sum), (1, AggregateFunction::Max)],
+        )
+        .unwrap();
+        assert_eq!(aggregator.schema().fields().len(), 3);
+
+        let schema = Arc::new(schema);
+        for i in 0..10 {
+            // with a leading row which is sliced away, to check the offsets of columns
+            let keys = (-1..100)
+                .map(|j| match (i * 100 + j) % 7 {
+                    0 => None,
+                    k => Some(format!("key {}", k)),
+                })
+                .collect::<LargeStringArray>();
+            let values = (-1..100).map(|j| i * 100 + j).collect::<Vec<i64>>();
+            let batch = RecordBatch::try_new(
+                schema.clone(),
+                vec![keys.slice(1, 100), Int64Array::from(values).slice(1, 100)],
+            )
+            .unwrap();
+            aggregator.update(&batch).unwrap();
+        }
+        assert_eq!(aggregator.num_groups(), 7);
+
+        let result = aggregator.finish().unwrap();
+        let keys = as_largestring_array(result.column(0));
+        let sums = as_primitive_array::<Int64Type>(result.column(1));
+        let maxs = as_primitive_array::<Int64Type>(result.column(2));
+        for i in 0..7 {
+            let k = if keys.is_valid(i) {
+                keys.value(i)[4..].parse::<i64>().unwrap()
+            } else {
+                0
+            };
+            let values = (0..1000).filter(|v| v % 7 == k);
+            assert_eq!(sums.value(i), values.clone().sum::<i64>());
+            assert_eq!(maxs.value(i), values.max().unwrap());
+        }
+    }
+
+    #[test]
+    fn test_hash_aggregator_dictionary_batches() {
+        let data_type =
+            DataType::Dictionary(Box::new(DataType::Int8), Box::new(DataType::Utf8));
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("key", data_type, true),
+            Field::new("value", DataType::Int64, false),
+        ]));
+        let mut aggregator =
+            HashAggregator::try_new(&schema, vec![0], vec![(1, AggregateFunction::Sum)])
+                .unwrap();
+
+        // each batch has its own dictionary of 100 values, too many to join for Int8
+        for i in 0..3 {
+            let values = (0..100)
+                .map(|j| match j {
+                    98 => Some("a".to_string()),
+                    99 => None,
+                    j => Some(format!("{} {}", i, j)),
+                })
+                .collect::<StringArray>();
+            let mut keys = PrimitiveBuilder::<Int8Type>::new(5);
+            for key in &[Some(98), Some(99), Some(i as i8), Some(98), None] {
+                keys.append_option(*key).unwrap();
+            }
+            let keys = keys.finish_dict(Arc::new(values));
+            let batch = RecordBatch::try_new(
+                schema.clone(),
+                vec![
+                    Arc::new(keys),
+                    Arc::new(Int64Array::from(vec![1, 2, 4, 8, 16])),
+                ],
+            )
+            .unwrap();
+            aggregator.update(&batch).unwrap();
+        }
+        assert_eq!(aggregator.num_groups(), 5);
+
+        let result = aggregator.finish().unwrap();
+        assert_eq!(result.column(0).data_type(), schema.field(0).data_type());
+        let keys = result
+            .column(0)
+            .as_any()
+            .downcast_ref::<DictionaryArray<Int8Type>>()
+            .unwrap();
+        let values = keys.values();
+        let values = as_string_array(&values);
+        let keys = keys
+            .keys()
+            .iter()
+            .map(|k| k.map(|k| values.value(k as usize)))
+            .collect::<Vec<_>>();
+        assert_eq!(
+            keys,
+            vec![Some("a"), None, Some("0 0"), Some("1 1"), Some("2 2")]
+        );
+        assert_eq!(values.len(), 4);
+        assert_eq!(
+            result.column(1).as_ref(),
+            &Int64Array::from(vec![27, 54, 4, 4, 4]) as &Array
+        );
+    }
+
+    #[test]
+    fn test_hash_aggregate_empty() {
+        let batch = batch(vec![
+            Arc::new(Int32Array::from(Vec::<i32>::new())),
+            Arc::new(Int32Array::from(Vec::<i32>::new())),
+        ]);
+        let result =
+            hash_aggregate(&batch, &[0], &[(1, AggregateFunction::Mean)]).unwrap();
+        assert_eq!(result.num_rows(), 0);
+        assert_eq!(result.column(1).data_type(), &DataType::Float64);
+
+        // no group columns make a single group
+        let batch = batch_of_ints();
+        let result = hash_aggregate(&batch, &[], &[(0, AggregateFunction::Sum)]).unwrap();
+        assert_eq!(result.num_columns(), 1);
+        assert_eq!(
+            result.column(0).as_ref(),
+            &Int32Array::from(vec![6]) as &Array
+        );
+    }
+
+    fn batch_of_ints() -> RecordBatch {
+        batch(vec![Arc::new(Int32Array::from(vec![1, 2, 3]))])
+    }
+
+    #[test]
+    fn test_hash_aggregate_unsupported() {
+        let schema = Schema::new(vec![
+            Field::new("s", DataType::Utf8, false),
+            Field::new(
+                "l",
+                DataType::List(Box::new(Field::new("item", DataType::Int32, true))),
+                false,
+            ),
+        ]);
+        let err = HashAggregator::try_new(&schema, vec![1], vec![])
+            .err()
+            .unwrap();
+        assert!(err.to_string().starts_with(
+            "Invalid argument error: Cannot group by column l of type List"
+        ));
+        let err =
+            HashAggregator::try_new(&schema, vec![0], vec![(0, AggregateFunction::Sum)])
+                .err()
+                .unwrap();
+        assert_eq!(
+            err.to_string(),
+            "Invalid argument error: Aggregate function SUM not supported for type Utf8"
+        );
+        assert!(HashAggregator::try_new(&schema, vec![2], vec![]).is_err());
+        assert!(HashAggregator::try_new(
+            &schema,
+            vec![0],
+            vec![(1, AggregateFunction::Count)]
+        )
+        .is_ok());
+    }
+}
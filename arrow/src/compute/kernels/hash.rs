@@ -0,0 +1,439 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Defines kernels that hash the values of arrays, and the rows of sets of columns,
+//! to `UInt64Array`s.
+//!
+//! Equal values have equal hashes, and a dictionary array hashes like an array of its
+//! values. Floating point values are hashed by their bit pattern, so `0.0` and `-0.0`
+//! have different hashes. Hashes do not depend on the platform, but may change
+//! between versions of this crate.
+
+use crate::array::*;
+use crate::compute::kernels::group_by::fixed_width;
+use crate::datatypes::*;
+use crate::error::{ArrowError, Result};
+
+/// The hash of a row before hashing any of its values
+const SEED: u64 = 0x243f_6a88_85a3_08d3;
+/// The hash of a null value
+const NULL_HASH: u64 = 0x1319_8a2e_0370_7344;
+
+/// Combines the hash `h` with `value`.
+#[inline]
+fn combine(h: u64, value: u64) -> u64 {
+    let x = (h.rotate_left(23) ^ value).wrapping_mul(0x9e37_79b9_7f4a_7c15);
+    x ^ (x >> 29)
+}
+
+/// Returns `value`, to compute the hashes of values rather than update the hashes
+/// of rows.
+#[inline]
+fn value_only(_h: u64, value: u64) -> u64 {
+    value
+}
+
+/// Returns the hash of `bytes`, read 8 bytes at a time.
+#[inline]
+fn hash_bytes(bytes: &[u8]) -> u64 {
+    let mut h = combine(SEED, bytes.len() as u64);
+    let mut chunks = bytes.chunks_exact(8);
+    for chunk in &mut chunks {
+        let mut word = [0; 8];
+        word.copy_from_slice(chunk);
+        h = combine(h, u64::from_le_bytes(word));
+    }
+    let remainder = chunks.remainder();
+    if !remainder.is_empty() {
+        let mut word = [0; 8];
+        word[..remainder.len()].copy_from_slice(remainder);
+        h = combine(h, u64::from_le_bytes(word));
+    }
+    h
+}
+
+/// Returns the hash of each value of `array`.
+///
+/// ```
+/// # use arrow::array::{Array, Int32Array};
+/// # use arrow::compute::kernels::hash::hash;
+/// let hashes = hash(&Int32Array::from(vec![Some(1), None, Some(1)])).unwrap();
+/// assert_eq!(hashes.null_count(), 0);
+/// assert_eq!(hashes.value(0), hashes.value(2));
+/// assert_ne!(hashes.value(0), hashes.value(1));
+/// ```
+pub fn hash(array: &Array) -> Result<UInt64Array> {
+    let mut hashes = vec![SEED; array.len()];
+    update_hashes(array, &mut hashes, combine)?;
+    Ok(UInt64Array::from(hashes))
+}
+
+/// Returns the hash of each row of `columns`, which combines the hashes of its
+/// values in the order of `columns`.
+///
+/// Returns an error if `columns` is empty or its columns have different lengths.
+pub fn hash_columns(columns: &[ArrayRef]) -> Result<UInt64Array> {
+    let num_rows = match columns.first() {
+        Some(column) => column.len(),
+        None => {
+            return Err(ArrowError::InvalidArgumentError(
+                "Hashing rows requires at least one column".to_string(),
+            ))
+        }
+    };
+    let mut hashes = vec![SEED; num_rows];
+    for column in columns {
+        if column.len() != num_rows {
+            return Err(ArrowError::InvalidArgumentError(
+                "All columns of hashed rows must have the same length".to_string(),
+            ));
+        }
+        update_hashes(column.as_ref(), &mut hashes, combine)?;
+    }
+    Ok(UInt64Array::from(hashes))
+}
+
+/// Replaces each of `hashes` with `update` of it and the hash of the value of the
+/// same index of `array`.
+fn update_hashes<F>(array: &Array, hashes: &mut [u64], update: F) -> Result<()>
+where
+    F: Fn(u64, u64) -> u64 + Copy,
+{
+    match array.data_type() {
+        DataType::Null => hashes.iter_mut().for_each(|h| *h = update(*h, NULL_HASH)),
+        DataType::Boolean => {
+            let array = array.as_any().downcast_ref::<BooleanArray>().unwrap();
+            update_each(array, hashes, update, |i| array.value(i) as u64);
+        }
+        DataType::Utf8 => {
+            let array = array.as_any().downcast_ref::<StringArray>().unwrap();
+            update_each(array, hashes, update, |i| {
+                hash_bytes(array.value(i).as_bytes())
+            });
+        }
+        DataType::LargeUtf8 => {
+            let array = array.as_any().downcast_ref::<LargeStringArray>().unwrap();
+            update_each(array, hashes, update, |i| {
+                hash_bytes(array.value(i).as_bytes())
+            });
+        }
+        DataType::Binary => {
+            let array = array.as_any().downcast_ref::<BinaryArray>().unwrap();
+            update_each(array, hashes, update, |i| hash_bytes(array.value(i)));
+        }
+        DataType::LargeBinary => {
+            let array = array.as_any().downcast_ref::<LargeBinaryArray>().unwrap();
+            update_each(array, hashes, update, |i| hash_bytes(array.value(i)));
+        }
+        DataType::Dictionary(key_type, _) => match key_type.as_ref() {
+            DataType::Int8 => update_dictionary::<Int8Type, F>(array, hashes, update)?,
+            DataType::Int16 => update_dictionary::<Int16Type, F>(array, hashes, update)?,
+            DataType::Int32 => update_dictionary::<Int32Type, F>(array, hashes, update)?,
+            DataType::Int64 => update_dictionary::<Int64Type, F>(array, hashes, update)?,
+            DataType::UInt8 => update_dictionary::<UInt8Type, F>(array, hashes, update)?,
+            DataType::UInt16 => {
+                update_dictionary::<UInt16Type, F>(array, hashes, update)?
+            }
+            DataType::UInt32 => {
+                update_dictionary::<UInt32Type, F>(array, hashes, update)?
+            }
+            DataType::UInt64 => {
+                update_dictionary::<UInt64Type, F>(array, hashes, update)?
+            }
+            t => {
+                return Err(ArrowError::InvalidArgumentError(format!(
+                    "Dictionary key type {:?} not supported",
+                    t
+                )))
+            }
+        },
+        DataType::List(_) => {
+            let array = array.as_any().downcast_ref::<ListArray>().unwrap();
+            update_list(array, array.value_offsets(), hashes, update)?;
+        }
+        DataType::LargeList(_) => {
+            let array = array.as_any().downcast_ref::<LargeListArray>().unwrap();
+            update_list(array, array.value_offsets(), hashes, update)?;
+        }
+        DataType::FixedSizeList(_, length) => {
+            let array = array.as_any().downcast_ref::<FixedSizeListArray>().unwrap();
+            let offsets = (0..=array.len())
+                .map(|i| (array.data().offset() + i) * *length as usize)
+                .collect::<Vec<_>>();
+            update_list(array, &offsets, hashes, update)?;
+        }
+        DataType::Struct(_) => {
+            let array = array.as_any().downcast_ref::<StructArray>().unwrap();
+            // the children of a struct array are sliced like the struct array
+            let mut child_hashes = vec![SEED; array.len()];
+            for column in array.columns() {
+                update_hashes(column.as_ref(), &mut child_hashes, combine)?;
+            }
+            update_each(array, hashes, update, |i| child_hashes[i]);
+        }
+        data_type => {
+            let width = fixed_width(data_type).ok_or_else(|| {
+                ArrowError::InvalidArgumentError(format!(
+                    "Hashing values of type {:?} not supported",
+                    data_type
+                ))
+            })?;
+            // the values of all fixed width types are in their first buffer
+            let values = &array.data().buffers()[0].as_slice()
+                [array.offset() * width..(array.offset() + array.len()) * width];
+            macro_rules! update_words {
+                ($native:ty) => {
+                    update_each(array, hashes, update, |i| {
+                        let mut word = [0; std::mem::size_of::<$native>()];
+                        word.copy_from_slice(&values[i * width..(i + 1) * width]);
+                        <$native>::from_le_bytes(word) as u64
+                    })
+                };
+            }
+            match width {
+                1 => update_words!(u8),
+                2 => update_words!(u16),
+                4 => update_words!(u32),
+                8 => update_words!(u64),
+                _ => update_each(array, hashes, update, |i| {
+                    hash_bytes(&values[i * width..(i + 1) * width])
+                }),
+            }
+        }
+    }
+    Ok(())
+}
+
+/// Updates each of `hashes` with the hash of the value of the same index of `array`,
+/// given by `value_hash` for valid values.
+#[inline]
+fn update_each<F, V>(array: &Array, hashes: &mut [u64], update: F, value_hash: V)
+where
+    F: Fn(u64, u64) -> u64,
+    V: Fn(usize) -> u64,
+{
+    if array.null_count() == 0 {
+        for (i, h) in hashes.iter_mut().enumerate() {
+            *h = update(*h, value_hash(i));
+        }
+    } else {
+        for (i, h) in hashes.iter_mut().enumerate() {
+            let value = if array.is_valid(i) {
+                value_hash(i)
+            } else {
+                NULL_HASH
+            };
+            *h = update(*h, value);
+        }
+    }
+}
+
+/// Updates `hashes` with the values of a dictionary array, which hash like its
+/// values.
+fn update_dictionary<K, F>(array: &Array, hashes: &mut [u64], update: F) -> Result<()>
+where
+    K: ArrowDictionaryKeyType,
+    F: Fn(u64, u64) -> u64 + Copy,
+{
+    let array = array.as_any().downcast_ref::<DictionaryArray<K>>().unwrap();
+    let values = array.values();
+    let mut value_hashes = vec![0; values.len()];
+    update_hashes(values.as_ref(), &mut value_hashes, value_only)?;
+
+    let keys = array.keys();
+    for (i, h) in hashes.iter_mut().enumerate() {
+        let value = if keys.is_valid(i) {
+            let key = keys.value(i).to_usize();
+            match key.and_then(|key| value_hashes.get(key)) {
+                Some(value) => *value,
+                None => {
+                    return Err(ArrowError::InvalidArgumentError(format!(
+                        "Dictionary key {:?} is out of bounds of {} values",
+                        keys.value(i),
+                        value_hashes.len()
+                    )))
+                }
+            }
+        } else {
+            NULL_HASH
+        };
+        *h = update(*h, value);
+    }
+    Ok(())
+}
+
+/// Updates `hashes` with the values of a list array, whose list `i` is the rows from
+/// `offsets[i]` to `offsets[i + 1]` of its child array.
+fn update_list<O, L, F>(
+    array: &L,
+    offsets: &[O],
+    hashes: &mut [u64],
+    update: F,
+) -> Result<()>
+where
+    O: ArrowNativeType,
+    L: ListLike,
+    F: Fn(u64, u64) -> u64,
+{
+    let values = array.child();
+    let mut value_hashes = vec![SEED; values.len()];
+    update_hashes(values.as_ref(), &mut value_hashes, combine)?;
+    update_each(array, hashes, update, |i| {
+        let start = offsets[i].to_usize().unwrap();
+        let end = offsets[i + 1].to_usize().unwrap();
+        value_hashes[start..end]
+            .iter()
+            .fold(combine(SEED, (end - start) as u64), |h, value| {
+                combine(h, *value)
+            })
+    });
+    Ok(())
+}
+
+/// A list array, whose values are the rows of a child array.
+trait ListLike: Array {
+    fn child(&self) -> ArrayRef;
+}
+
+impl<O: OffsetSizeTrait> ListLike for GenericListArray<O> {
+    fn child(&self) -> ArrayRef {
+        self.values()
+    }
+}
+
+impl ListLike for FixedSizeListArray {
+    fn child(&self) -> ArrayRef {
+        self.values()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use std::sync::Arc;
+
+    use crate::buffer::Buffer;
+
+    fn values(array: &Array) -> Vec<u64> {
+        hash(array).unwrap().values().to_vec()
+    }
+
+    #[test]
+    fn test_hash_primitive() {
+        let hashes = values(&Int32Array::from(vec![
+            Some(1),
+            Some(2),
+            None,
+            Some(1),
+            None,
+        ]));
+        assert_eq!(hashes[0], hashes[3]);
+        assert_eq!(hashes[2], hashes[4]);
+        assert_ne!(hashes[0], hashes[1]);
+        assert_ne!(hashes[0], hashes[2]);
+
+        // hashes depend on values, not on their offsets
+        let sliced = Int32Array::from(vec![7, 2, 1]).slice(1, 2);
+        assert_eq!(values(sliced.as_ref()), vec![hashes[1], hashes[0]]);
+
+        let floats = values(&Float64Array::from(vec![0.0, -0.0, 1.5, 1.5]));
+        assert_ne!(floats[0], floats[1]);
+        assert_eq!(floats[2], floats[3]);
+
+        let booleans = values(&BooleanArray::from(vec![true, false, true]));
+        assert_eq!(booleans[0], booleans[2]);
+        assert_ne!(booleans[0], booleans[1]);
+    }
+
+    #[test]
+    fn test_hash_strings_and_dictionary() {
+        let strings = StringArray::from(vec![Some("a"), Some("bc"), None, Some("a")]);
+        let hashes = values(&strings);
+        assert_eq!(hashes[0], hashes[3]);
+        assert_ne!(hashes[0], hashes[1]);
+
+        let large = LargeStringArray::from(vec![Some("a"), Some("bc"), None, Some("a")]);
+        assert_eq!(values(&large), hashes);
+
+        let dictionary: DictionaryArray<Int8Type> =
+            vec![Some("bc"), Some("a"), None, Some("a"), Some("bc")]
+                .into_iter()
+                .collect();
+        assert_eq!(
+            values(&dictionary),
+            vec![hashes[1], hashes[0], hashes[2], hashes[0], hashes[1]]
+        );
+        let sliced = dictionary.slice(1, 3);
+        assert_eq!(
+            values(sliced.as_ref()),
+            vec![hashes[0], hashes[2], hashes[0]]
+        );
+    }
+
+    #[test]
+    fn test_hash_nested() {
+        let data = ArrayData::builder(DataType::List(Box::new(Field::new(
+            "item",
+            DataType::Int32,
+            true,
+        ))))
+        .len(4)
+        .add_buffer(Buffer::from_slice_ref(&[0_i32, 2, 3, 3, 5]))
+        .add_child_data(Int32Array::from(vec![1, 2, 3, 1, 2]).data().clone())
+        .null_bit_buffer(Buffer::from([0b1011_u8]))
+        .build();
+        let lists = ListArray::from(data);
+        let hashes = values(&lists);
+        // [1, 2], [3], null, [1, 2]
+        assert_eq!(hashes[0], hashes[3]);
+        assert_ne!(hashes[0], hashes[1]);
+        assert_eq!(hashes[2], values(&Int32Array::from(vec![None]))[0]);
+        assert_eq!(values(lists.slice(3, 1).as_ref()), vec![hashes[0]]);
+
+        let strings: ArrayRef = Arc::new(StringArray::from(vec!["a", "b", "a"]));
+        let ints: ArrayRef = Arc::new(Int64Array::from(vec![1, 2, 1]));
+        let structs = StructArray::from(vec![
+            (Field::new("s", DataType::Utf8, false), strings.clone()),
+            (Field::new("i", DataType::Int64, false), ints.clone()),
+        ]);
+        let hashes = values(&structs);
+        assert_eq!(hashes[0], hashes[2]);
+        assert_ne!(hashes[0], hashes[1]);
+        assert_eq!(values(structs.slice(2, 1).as_ref()), vec![hashes[0]]);
+    }
+
+    #[test]
+    fn test_hash_columns() {
+        let strings: ArrayRef = Arc::new(StringArray::from(vec!["a", "b", "a", "a"]));
+        let ints: ArrayRef = Arc::new(Int64Array::from(vec![1, 1, 1, 2]));
+        let hashes = hash_columns(&[strings.clone(), ints.clone()])
+            .unwrap()
+            .values()
+            .to_vec();
+        assert_eq!(hashes[0], hashes[2]);
+        assert_ne!(hashes[0], hashes[1]);
+        assert_ne!(hashes[0], hashes[3]);
+        // the order of the columns matters
+        let swapped = hash_columns(&[ints, strings.clone()]).unwrap();
+        assert_ne!(swapped.value(0), hashes[0]);
+
+        let short: ArrayRef = Arc::new(Int64Array::from(vec![1]));
+        assert!(hash_columns(&[strings, short]).is_err());
+        assert!(hash_columns(&[]).is_err());
+    }
+}
@@ -0,0 +1,460 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Defines hash join kernels, which find the pairs of rows of two sets of key columns
+//! with equal keys. The kernels return the indices of the rows of each side, to
+//! [`take`](crate::compute::kernels::take::take) the columns of the joined rows.
+//!
+//! ```
+//! # use std::sync::Arc;
+//! # use arrow::array::{Array, ArrayRef, Int32Array, StringArray};
+//! # use arrow::compute::kernels::join::{hash_join_indices, JoinType};
+//! # use arrow::compute::kernels::take::take;
+//! let orders: ArrayRef = Arc::new(Int32Array::from(vec![2, 1, 3, 2]));
+//! let customers: ArrayRef = Arc::new(Int32Array::from(vec![1, 2]));
+//! let names = StringArray::from(vec!["alice", "bob"]);
+//!
+//! let (left, right) = hash_join_indices(&[orders], &[customers], JoinType::Left).unwrap();
+//! assert_eq!(left, arrow::array::UInt32Array::from(vec![0, 1, 2, 3]));
+//!
+//! let names = take(&names, &right, None).unwrap();
+//! assert_eq!(
+//!     names.as_ref(),
+//!     &StringArray::from(vec![Some("bob"), Some("alice"), None, Some("bob")]) as &dyn Array
+//! );
+//! ```
+
+use std::collections::HashMap;
+use std::hash::{BuildHasherDefault, Hasher};
+
+use crate::array::*;
+use crate::compute::kernels::group_by::{is_supported_key_type, RowKeys};
+use crate::compute::kernels::hash::hash_columns;
+use crate::datatypes::*;
+use crate::error::{ArrowError, Result};
+
+/// The rows returned by a join of a left and a right side.
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub enum JoinType {
+    /// Each pair of left and right rows with equal keys
+    Inner,
+    /// Each pair of left and right rows with equal keys, and each left row without
+    /// an equal right row, paired with a null right row
+    Left,
+    /// Each left row with an equal right row
+    LeftSemi,
+    /// Each left row without an equal right row
+    LeftAnti,
+}
+
+/// Marks the end of a chain of rows in [`JoinHashTable`].
+const END_OF_CHAIN: u32 = std::u32::MAX;
+
+/// A [`Hasher`] of the hashes of rows by [`hash_columns`], which are already uniform.
+#[derive(Default)]
+struct IdentityHasher {
+    hash: u64,
+}
+
+impl Hasher for IdentityHasher {
+    fn write(&mut self, _bytes: &[u8]) {
+        unreachable!("IdentityHasher only hashes u64")
+    }
+
+    #[inline]
+    fn write_u64(&mut self, i: u64) {
+        self.hash = i;
+    }
+
+    #[inline]
+    fn finish(&self) -> u64 {
+        self.hash
+    }
+}
+
+/// A hash table of the rows of the key columns of the build side of a hash join,
+/// which is probed with the key columns of the other side.
+///
+/// Rows with a null value in their key columns are never equal to any row, as in a
+/// SQL join.
+pub struct JoinHashTable {
+    keys: RowKeys,
+    /// The first row of each hash
+    heads: HashMap<u64, u32, BuildHasherDefault<IdentityHasher>>,
+    /// The next row of the same hash as each row, or [`END_OF_CHAIN`]
+    next: Vec<u32>,
+    data_types: Vec<DataType>,
+}
+
+impl JoinHashTable {
+    /// Creates a hash table of the rows of `keys`.
+    ///
+    /// Returns an error if `keys` is empty, its columns have different lengths or
+    /// unsupported types, or it has more than `u32::MAX - 1` rows.
+    pub fn try_new(keys: &[ArrayRef]) -> Result<Self> {
+        let num_rows = check_keys(keys)?;
+        if num_rows >= END_OF_CHAIN as usize {
+            return Err(ArrowError::InvalidArgumentError(format!(
+                "Cannot build a hash table of {} rows",
+                num_rows
+            )));
+        }
+        let row_keys = RowKeys::try_new(keys, num_rows)?;
+        let hashes = hash_columns(keys)?;
+        let hashes = hashes.values();
+        let nulls = null_rows(keys, num_rows);
+
+        let mut heads =
+            HashMap::with_capacity_and_hasher(num_rows, BuildHasherDefault::default());
+        let mut next = vec![END_OF_CHAIN; num_rows];
+        // inserts rows in reverse, so that each chain is in the order of its rows
+        for i in (0..num_rows).rev() {
+            if nulls[i] {
+                continue;
+            }
+            let head = heads.entry(hashes[i]).or_insert(END_OF_CHAIN);
+            next[i] = *head;
+            *head = i as u32;
+        }
+
+        Ok(Self {
+            keys: row_keys,
+            heads,
+            next,
+            data_types: keys.iter().map(|key| key.data_type().clone()).collect(),
+        })
+    }
+
+    /// Returns the number of rows of the hash table.
+    pub fn num_rows(&self) -> usize {
+        self.next.len()
+    }
+
+    /// Returns the indices of the pairs of rows of `keys`, the left side, and of this
+    /// hash table, the right side, that `join_type` returns.
+    ///
+    /// Pairs are in the order of their left rows, then of their right rows. The right
+    /// index of a left row without an equal right row in a [`JoinType::Left`] join is
+    /// null, as are all the right indices of [`JoinType::LeftSemi`] and
+    /// [`JoinType::LeftAnti`] joins.
+    pub fn probe(
+        &self,
+        keys: &[ArrayRef],
+        join_type: JoinType,
+    ) -> Result<(UInt32Array, UInt32Array)> {
+        let num_rows = check_keys(keys)?;
+        let data_types = keys.iter().map(|key| key.data_type());
+        if !data_types.clone().eq(self.data_types.iter()) {
+            return Err(ArrowError::InvalidArgumentError(format!(
+                "Cannot join keys of types {:?} with keys of types {:?}",
+                data_types.collect::<Vec<_>>(),
+                self.data_types
+            )));
+        }
+        let row_keys = RowKeys::try_new(keys, num_rows)?;
+        let hashes = hash_columns(keys)?;
+        let nulls = null_rows(keys, num_rows);
+
+        let mut left = Vec::with_capacity(num_rows);
+        let mut right = Vec::with_capacity(num_rows);
+        for (i, hash) in hashes.values().iter().enumerate() {
+            let key = row_keys.row(i);
+            let mut j = match self.heads.get(hash) {
+                Some(head) if !nulls[i] => *head,
+                _ => END_OF_CHAIN,
+            };
+            let mut matched = false;
+            while j != END_OF_CHAIN {
+                if self.keys.row(j as usize) == key {
+                    matched = true;
+                    match join_type {
+                        JoinType::Inner | JoinType::Left => {
+                            left.push(i as u32);
+                            right.push(Some(j));
+                        }
+                        JoinType::LeftSemi | JoinType::LeftAnti => break,
+                    }
+                }
+                j = self.next[j as usize];
+            }
+            match join_type {
+                JoinType::Left | JoinType::LeftAnti if !matched => {
+                    left.push(i as u32);
+                    right.push(None);
+                }
+                JoinType::LeftSemi if matched => {
+                    left.push(i as u32);
+                    right.push(None);
+                }
+                _ => {}
+            }
+        }
+        Ok((UInt32Array::from(left), UInt32Array::from(right)))
+    }
+}
+
+/// Returns the indices of the pairs of rows of `left` and `right`, two sets of key
+/// columns, that `join_type` returns, by probing a hash table of `right`.
+///
+/// See [`JoinHashTable::probe`] for the order of the pairs.
+pub fn hash_join_indices(
+    left: &[ArrayRef],
+    right: &[ArrayRef],
+    join_type: JoinType,
+) -> Result<(UInt32Array, UInt32Array)> {
+    JoinHashTable::try_new(right)?.probe(left, join_type)
+}
+
+/// Returns the number of rows of the key columns `keys`.
+fn check_keys(keys: &[ArrayRef]) -> Result<usize> {
+    let num_rows = match keys.first() {
+        Some(key) => key.len(),
+        None => {
+            return Err(ArrowError::InvalidArgumentError(
+                "A hash join requires at least one key column".to_string(),
+            ))
+        }
+    };
+    for key in keys {
+        if key.len() != num_rows {
+            return Err(ArrowError::InvalidArgumentError(
+                "All key columns of a hash join must have the same length".to_string(),
+            ));
+        }
+        if !is_supported_key_type(key.data_type()) {
+            return Err(ArrowError::InvalidArgumentError(format!(
+                "Cannot join keys of type {:?}",
+                key.data_type()
+            )));
+        }
+    }
+    Ok(num_rows)
+}
+
+/// Returns whether each row of the key columns `keys` has a null key. A key of a
+/// dictionary array is null if either its dictionary key or its value is null.
+fn null_rows(keys: &[ArrayRef], num_rows: usize) -> Vec<bool> {
+    fn dictionary_nulls<K: ArrowDictionaryKeyType>(array: &Array, nulls: &mut [bool]) {
+        let array = array.as_any().downcast_ref::<DictionaryArray<K>>().unwrap();
+        let values = array.values();
+        for (null, key) in nulls.iter_mut().zip(array.keys().iter()) {
+            *null |= match key {
+                Some(key) => values.is_null(key.to_usize().unwrap()),
+                None => true,
+            };
+        }
+    }
+
+    let mut nulls = vec![false; num_rows];
+    for key in keys {
+        match key.data_type() {
+            DataType::Dictionary(key_type, _) => match key_type.as_ref() {
+                DataType::Int8 => dictionary_nulls::<Int8Type>(key.as_ref(), &mut nulls),
+                DataType::Int16 => {
+                    dictionary_nulls::<Int16Type>(key.as_ref(), &mut nulls)
+                }
+                DataType::Int32 => {
+                    dictionary_nulls::<Int32Type>(key.as_ref(), &mut nulls)
+                }
+                DataType::Int64 => {
+                    dictionary_nulls::<Int64Type>(key.as_ref(), &mut nulls)
+                }
+                DataType::UInt8 => {
+                    dictionary_nulls::<UInt8Type>(key.as_ref(), &mut nulls)
+                }
+                DataType::UInt16 => {
+                    dictionary_nulls::<UInt16Type>(key.as_ref(), &mut nulls)
+                }
+                DataType::UInt32 => {
+                    dictionary_nulls::<UInt32Type>(key.as_ref(), &mut nulls)
+                }
+                DataType::UInt64 => {
+                    dictionary_nulls::<UInt64Type>(key.as_ref(), &mut nulls)
+                }
+                _ => unreachable!("checked by check_keys"),
+            },
+            _ if key.null_count() > 0 => {
+                for (i, null) in nulls.iter_mut().enumerate() {
+                    *null |= key.is_null(i);
+                }
+            }
+            _ => {}
+        }
+    }
+    nulls
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use std::sync::Arc;
+
+    use crate::compute::kernels::take::take;
+
+    fn indices(
+        left: &[ArrayRef],
+        right: &[ArrayRef],
+        join_type: JoinType,
+    ) -> (Vec<Option<u32>>, Vec<Option<u32>>) {
+        let (left, right) = hash_join_indices(left, right, join_type).unwrap();
+        (left.iter().collect(), right.iter().collect())
+    }
+
+    #[test]
+    fn test_hash_join_primitive() {
+        let left: ArrayRef = Arc::new(Int64Array::from(vec![
+            Some(1),
+            Some(2),
+            None,
+            Some(4),
+            Some(2),
+        ]));
+        let right: ArrayRef = Arc::new(Int64Array::from(vec![
+            Some(2),
+            None,
+            Some(1),
+            Some(2),
+            Some(5),
+        ]));
+        let left = [left];
+        let right = [right];
+
+        assert_eq!(
+            indices(&left, &right, JoinType::Inner),
+            (
+                vec![Some(0), Some(1), Some(1), Some(4), Some(4)],
+                vec![Some(2), Some(0), Some(3), Some(0), Some(3)]
+            )
+        );
+        assert_eq!(
+            indices(&left, &right, JoinType::Left),
+            (
+                vec![
+                    Some(0),
+                    Some(1),
+                    Some(1),
+                    Some(2),
+                    Some(3),
+                    Some(4),
+                    Some(4)
+                ],
+                vec![Some(2), Some(0), Some(3), None, None, Some(0), Some(3)]
+            )
+        );
+        assert_eq!(
+            indices(&left, &right, JoinType::LeftSemi),
+            (vec![Some(0), Some(1), Some(4)], vec![None, None, None])
+        );
+        assert_eq!(
+            indices(&left, &right, JoinType::LeftAnti),
+            (vec![Some(2), Some(3)], vec![None, None])
+        );
+    }
+
+    #[test]
+    fn test_hash_join_multiple_columns() {
+        let strings: DictionaryArray<Int16Type> =
+            vec![Some("a"), Some("b"), Some("a"), None]
+                .into_iter()
+                .collect();
+        let right: Vec<ArrayRef> = vec![
+            Arc::new(StringArray::from(vec!["x", "x", "y", "y"])),
+            Arc::new(strings),
+        ];
+        let strings: DictionaryArray<Int16Type> =
+            vec![Some("b"), Some("a"), None, Some("a")]
+                .into_iter()
+                .collect();
+        let left: Vec<ArrayRef> = vec![
+            StringArray::from(vec!["x", "y", "y", "x"]).slice(0, 4),
+            Arc::new(strings),
+        ];
+
+        let table = JoinHashTable::try_new(&right).unwrap();
+        assert_eq!(table.num_rows(), 4);
+        let (left_indices, right_indices) = table.probe(&left, JoinType::Inner).unwrap();
+        assert_eq!(left_indices, UInt32Array::from(vec![0, 1, 3]));
+        assert_eq!(right_indices, UInt32Array::from(vec![1, 2, 0]));
+
+        let values = take(right[0].as_ref(), &right_indices, None).unwrap();
+        assert_eq!(
+            values.as_ref(),
+            &StringArray::from(vec!["x", "y", "x"]) as &dyn Array
+        );
+    }
+
+    #[test]
+    fn test_hash_join_dictionary_null_values() {
+        // keys 1 and 3 are valid, but their values are null
+        let values: ArrayRef = Arc::new(StringArray::from(vec![Some("a"), None]));
+        let mut keys = PrimitiveBuilder::<Int8Type>::new(4);
+        for key in &[Some(0), Some(1), None, Some(1)] {
+            keys.append_option(*key).unwrap();
+        }
+        let right: ArrayRef = Arc::new(keys.finish_dict(values.clone()));
+        let mut keys = PrimitiveBuilder::<Int8Type>::new(3);
+        for key in &[Some(1), Some(0), None] {
+            keys.append_option(*key).unwrap();
+        }
+        let left: ArrayRef = Arc::new(keys.finish_dict(values));
+
+        assert_eq!(
+            indices(&[left.clone()], &[right.clone()], JoinType::Inner),
+            (vec![Some(1)], vec![Some(0)])
+        );
+        assert_eq!(
+            indices(&[right.clone()], &[right], JoinType::Inner),
+            (vec![Some(0)], vec![Some(0)])
+        );
+        assert_eq!(
+            indices(&[left.clone()], &[left], JoinType::LeftAnti),
+            (vec![Some(0), Some(2)], vec![None, None])
+        );
+    }
+
+    #[test]
+    fn test_hash_join_sliced() {
+        let left = Int32Array::from(vec![9, 1, 2, 3]).slice(1, 3);
+        let right = Int32Array::from(vec![3, 1, 7]).slice(1, 2);
+        assert_eq!(
+            indices(&[left], &[right], JoinType::Left),
+            (vec![Some(0), Some(1), Some(2)], vec![Some(0), None, None])
+        );
+    }
+
+    #[test]
+    fn test_hash_join_invalid() {
+        let int32: ArrayRef = Arc::new(Int32Array::from(vec![1, 2]));
+        let int64: ArrayRef = Arc::new(Int64Array::from(vec![1, 2]));
+        let short: ArrayRef = Arc::new(Int32Array::from(vec![1]));
+
+        let err = hash_join_indices(&[int32.clone()], &[int64], JoinType::Inner)
+            .unwrap_err()
+            .to_string();
+        assert_eq!(
+            err,
+            "Invalid argument error: Cannot join keys of types [Int32] with keys of types [Int64]"
+        );
+        let err = hash_join_indices(&[], &[], JoinType::Inner).unwrap_err();
+        assert_eq!(
+            err.to_string(),
+            "Invalid argument error: A hash join requires at least one key column"
+        );
+        assert!(JoinHashTable::try_new(&[int32, short]).is_err());
+    }
+}
@@ -0,0 +1,596 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Defines a k-way merge of sorted streams of record batches, such as the sorted runs
+//! of an external sort.
+
+use crate::array::{make_array, ArrayRef, MutableArrayData};
+use crate::compute::kernels::coalesce::merge_dictionaries;
+use crate::compute::kernels::group_by::is_supported_key_type;
+use crate::compute::kernels::row::{RowConverter, Rows, SortField};
+use crate::compute::kernels::sort::SortOptions;
+use crate::datatypes::{DataType, SchemaRef};
+use crate::error::{ArrowError, Result};
+use crate::record_batch::{RecordBatch, RecordBatchReader};
+
+/// A column by which the streams of a [`SortMergeReader`] are sorted.
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub struct MergeColumn {
+    /// The index of the column
+    pub index: usize,
+    /// The sort options of the column, or the default options if `None`
+    pub options: Option<SortOptions>,
+}
+
+/// The current batch of a stream, and the position of its next row.
+struct Cursor {
+    batch: RecordBatch,
+    rows: Rows,
+    offset: usize,
+    /// The index of `batch` in the sources of the batch being merged, if any of its
+    /// rows are in it
+    source: Option<usize>,
+}
+
+impl Cursor {
+    #[inline]
+    fn row(&self) -> &[u8] {
+        self.rows.row(self.offset)
+    }
+}
+
+/// Merges streams of record batches, each sorted by the same columns, into a single
+/// sorted stream of record batches of at most `batch_size` rows.
+///
+/// The merge keeps one batch of each stream in memory, and compares rows in the row
+/// format of [`RowConverter`], so the types of the sort columns must be supported by
+/// it. Equal rows of different streams are returned in the order of their streams.
+pub struct SortMergeReader {
+    schema: SchemaRef,
+    streams: Vec<Box<dyn RecordBatchReader>>,
+    sort_columns: Vec<usize>,
+    converter: RowConverter,
+    batch_size: usize,
+    /// The current batch of each stream, `None` once the stream is exhausted
+    cursors: Vec<Option<Cursor>>,
+    /// A binary min-heap of the streams with a current batch, by their next row
+    heap: Vec<usize>,
+    initialized: bool,
+    finished: bool,
+}
+
+impl SortMergeReader {
+    /// Creates a reader of the merge of `streams`, which have the same schema and are
+    /// sorted by `sort_columns`.
+    ///
+    /// Returns an error if `streams` is empty, the streams have different schemas,
+    /// or the row format does not support the type of a sort column.
+    pub fn try_new(
+        streams: Vec<Box<dyn RecordBatchReader>>,
+        sort_columns: Vec<MergeColumn>,
+        batch_size: usize,
+    ) -> Result<Self> {
+        let schema = match streams.first() {
+            Some(stream) => stream.schema(),
+            None => {
+                return Err(ArrowError::InvalidArgumentError(
+                    "Merge requires at least one stream".to_string(),
+                ))
+            }
+        };
+        if streams.iter().any(|stream| stream.schema() != schema) {
+            return Err(ArrowError::InvalidArgumentError(
+                "All merged streams must have the same schema".to_string(),
+            ));
+        }
+        if sort_columns.is_empty() {
+            return Err(ArrowError::InvalidArgumentError(
+                "Merge requires at least one sort column".to_string(),
+            ));
+        }
+        if batch_size == 0 {
+            return Err(ArrowError::InvalidArgumentError(
+                "Merge batch size must be positive".to_string(),
+            ));
+        }
+        let fields = sort_columns
+            .iter()
+            .map(|column| {
+                let field = schema.fields().get(column.index).ok_or_else(|| {
+                    ArrowError::InvalidArgumentError(format!(
+                        "Sort column {} is out of bounds of {} columns",
+                        column.index,
+                        schema.fields().len()
+                    ))
+                })?;
+                Ok(SortField::new(
+                    field.data_type().clone(),
+                    column.options.unwrap_or_default(),
+                ))
+            })
+            .collect::<Result<Vec<_>>>()?;
+
+        Ok(Self {
+            schema,
+            cursors: streams.iter().map(|_| None).collect(),
+            streams,
+            sort_columns: sort_columns.iter().map(|column| column.index).collect(),
+            converter: RowConverter::try_new(fields)?,
+            batch_size,
+            heap: vec![],
+            initialized: false,
+            finished: false,
+        })
+    }
+
+    /// Reads the next non-empty batch of stream `i` to its cursor, or removes its
+    /// cursor if the stream is exhausted.
+    fn advance_stream(&mut self, i: usize) -> Result<()> {
+        self.cursors[i] = None;
+        for batch in &mut self.streams[i] {
+            let batch = batch?;
+            if batch.num_rows() == 0 {
+                continue;
+            }
+            let columns = self
+                .sort_columns
+                .iter()
+                .map(|column| batch.column(*column).clone())
+                .collect::<Vec<_>>();
+            let rows = self.converter.convert_columns(&columns)?;
+            self.cursors[i] = Some(Cursor {
+                batch,
+                rows,
+                offset: 0,
+                source: None,
+            });
+            break;
+        }
+        Ok(())
+    }
+
+    /// Returns whether the next row of stream `a` is before the next row of stream
+    /// `b`.
+    #[inline]
+    fn is_less(&self, a: usize, b: usize) -> bool {
+        let (row_a, row_b) = match (&self.cursors[a], &self.cursors[b]) {
+            (Some(a), Some(b)) => (a.row(), b.row()),
+            _ => unreachable!("streams in the heap have a cursor"),
+        };
+        row_a < row_b || (row_a == row_b && a < b)
+    }
+
+    /// Moves the stream at `position` of the heap down to its place.
+    fn sift_down(&mut self, mut position: usize) {
+        loop {
+            let left = 2 * position + 1;
+            if left >= self.heap.len() {
+                return;
+            }
+            let right = left + 1;
+            let child = if right < self.heap.len()
+                && self.is_less(self.heap[right], self.heap[left])
+            {
+                right
+            } else {
+                left
+            };
+            if !self.is_less(self.heap[child], self.heap[position]) {
+                return;
+            }
+            self.heap.swap(child, position);
+            position = child;
+        }
+    }
+
+    fn initialize(&mut self) -> Result<()> {
+        for i in 0..self.streams.len() {
+            self.advance_stream(i)?;
+            if self.cursors[i].is_some() {
+                self.heap.push(i);
+            }
+        }
+        for position in (0..self.heap.len() / 2).rev() {
+            self.sift_down(position);
+        }
+        Ok(())
+    }
+
+    /// Merges the next rows of the streams to a batch.
+    fn merge_batch(&mut self) -> Result<Option<RecordBatch>> {
+        if !self.initialized {
+            self.initialized = true;
+            self.initialize()?;
+        }
+
+        // the batches of the merged rows, and the runs of consecutive rows of each
+        // batch as (index of the batch, start, end)
+        let mut sources = vec![];
+        let mut runs: Vec<(usize, usize, usize)> = vec![];
+        let mut num_rows = 0;
+        while num_rows < self.batch_size && !self.heap.is_empty() {
+            let i = self.heap[0];
+            let cursor = self.cursors[i].as_mut().unwrap();
+            let source = match cursor.source {
+                Some(source) => source,
+                None => {
+                    sources.push(cursor.batch.clone());
+                    cursor.source = Some(sources.len() - 1);
+                    sources.len() - 1
+                }
+            };
+            match runs.last_mut() {
+                Some((last, _, end)) if *last == source && *end == cursor.offset => {
+                    *end += 1
+                }
+                _ => runs.push((source, cursor.offset, cursor.offset + 1)),
+            }
+            cursor.offset += 1;
+            num_rows += 1;
+
+            if cursor.offset == cursor.batch.num_rows() {
+                self.advance_stream(i)?;
+                if self.cursors[i].is_none() {
+                    let last = self.heap.pop().unwrap();
+                    if !self.heap.is_empty() {
+                        self.heap[0] = last;
+                    }
+                }
+            }
+            self.sift_down(0);
+        }
+        for cursor in self.cursors.iter_mut().flatten() {
+            cursor.source = None;
+        }
+
+        if num_rows == 0 {
+            return Ok(None);
+        }
+        let columns = self
+            .schema
+            .fields()
+            .iter()
+            .enumerate()
+            .map(|(column, field)| {
+                if let DataType::Dictionary(key_type, _) = field.data_type() {
+                    if sources.len() > 1 && is_supported_key_type(field.data_type()) {
+                        let arrays = sources
+                            .iter()
+                            .map(|batch| batch.column(column))
+                            .collect::<Vec<_>>();
+                        return merge_dictionaries(key_type, &arrays, &runs);
+                    }
+                }
+                let arrays = sources
+                    .iter()
+                    .map(|batch| batch.column(column).data())
+                    .collect::<Vec<_>>();
+                let mut data = MutableArrayData::new(arrays, false, num_rows);
+                for (source, start, end) in &runs {
+                    data.extend(*source, *start, *end);
+                }
+                Ok(make_array(data.freeze()))
+            })
+            .collect::<Result<Vec<ArrayRef>>>()?;
+        RecordBatch::try_new(self.schema.clone(), columns).map(Some)
+    }
+}
+
+impl Iterator for SortMergeReader {
+    type Item = Result<RecordBatch>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        if self.finished {
+            return None;
+        }
+        match self.merge_batch() {
+            Ok(Some(batch)) => Some(Ok(batch)),
+            Ok(None) => {
+                self.finished = true;
+                None
+            }
+            Err(e) => {
+                self.finished = true;
+                Some(Err(e))
+            }
+        }
+    }
+}
+
+impl RecordBatchReader for SortMergeReader {
+    fn schema(&self) -> SchemaRef {
+        self.schema.clone()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use std::sync::Arc;
+
+    use rand::{Rng, SeedableRng};
+
+    use crate::array::{
+        Array, DictionaryArray, Int32Array, PrimitiveBuilder, StringArray, UInt32Array,
+    };
+    use crate::compute::kernels::concat::concat;
+    use crate::compute::kernels::sort::{lexsort_to_indices, SortColumn};
+    use crate::compute::kernels::take::take;
+    use crate::datatypes::{Field, Int8Type, Schema};
+
+    struct VecReader {
+        schema: SchemaRef,
+        batches: std::vec::IntoIter<Result<RecordBatch>>,
+    }
+
+    impl Iterator for VecReader {
+        type Item = Result<RecordBatch>;
+
+        fn next(&mut self) -> Option<Self::Item> {
+            self.batches.next()
+        }
+    }
+
+    impl RecordBatchReader for VecReader {
+        fn schema(&self) -> SchemaRef {
+            self.schema.clone()
+        }
+    }
+
+    fn reader(
+        schema: &SchemaRef,
+        batches: Vec<Result<RecordBatch>>,
+    ) -> Box<dyn RecordBatchReader> {
+        Box::new(VecReader {
+            schema: schema.clone(),
+            batches: batches.into_iter(),
+        })
+    }
+
+    fn schema() -> SchemaRef {
+        Arc::new(Schema::new(vec![
+            Field::new("key", DataType::Int32, true),
+            Field::new("name", DataType::Utf8, true),
+            Field::new("id", DataType::UInt32, false),
+        ]))
+    }
+
+    fn sort_columns() -> Vec<MergeColumn> {
+        vec![
+            MergeColumn {
+                index: 0,
+                options: Some(SortOptions {
+                    descending: true,
+                    nulls_first: false,
+                }),
+            },
+            MergeColumn {
+                index: 1,
+                options: None,
+            },
+        ]
+    }
+
+    /// Returns `batch` sorted by `sort_columns`
+    fn sort_batch(batch: &RecordBatch) -> RecordBatch {
+        let columns = sort_columns()
+            .iter()
+            .map(|column| SortColumn {
+                values: batch.column(column.index).clone(),
+                options: column.options,
+            })
+            .collect::<Vec<_>>();
+        let indices = lexsort_to_indices(&columns, None).unwrap();
+        let columns = batch
+            .columns()
+            .iter()
+            .map(|column| take(column.as_ref(), &indices, None).unwrap())
+            .collect();
+        RecordBatch::try_new(batch.schema(), columns).unwrap()
+    }
+
+    fn concat_batches(batches: &[RecordBatch]) -> RecordBatch {
+        let schema = batches[0].schema();
+        let columns = (0..schema.fields().len())
+            .map(|i| {
+                let arrays = batches
+                    .iter()
+                    .map(|batch| batch.column(i).as_ref())
+                    .collect::<Vec<_>>();
+                concat(&arrays).unwrap()
+            })
+            .collect();
+        RecordBatch::try_new(schema, columns).unwrap()
+    }
+
+    #[test]
+    fn test_merge_sorted_streams() {
+        let schema = schema();
+        let mut rng = rand::rngs::StdRng::seed_from_u64(7);
+        let mut id = 0;
+        let mut runs = vec![];
+        let mut readers = vec![];
+        for _ in 0..5 {
+            // each stream is a sorted run, split into batches of random sizes
+            let len = rng.gen_range(0, 300);
+            let keys = (0..len)
+                .map(|_| Some(rng.gen_range(0, 20)).filter(|k| *k != 0))
+                .collect::<Int32Array>();
+            let names = (0..len)
+                .map(|_| Some(["a", "b", "c"][rng.gen_range(0, 3)]))
+                .collect::<StringArray>();
+            let ids = UInt32Array::from((id..id + len).collect::<Vec<_>>());
+            id += len;
+            let run = RecordBatch::try_new(
+                schema.clone(),
+                vec![Arc::new(keys), Arc::new(names), Arc::new(ids)],
+            )
+            .unwrap();
+            let run = sort_batch(&run);
+
+            let mut batches = vec![];
+            let mut offset = 0;
+            while offset < run.num_rows() {
+                let batch_len = rng.gen_range(0, 50).min(run.num_rows() - offset);
+                let columns = run
+                    .columns()
+                    .iter()
+                    .map(|column| column.slice(offset, batch_len))
+                    .collect();
+                batches.push(Ok(RecordBatch::try_new(schema.clone(), columns).unwrap()));
+                offset += batch_len;
+            }
+            readers.push(reader(&schema, batches));
+            runs.push(run);
+        }
+
+        let merged = SortMergeReader::try_new(readers, sort_columns(), 64)
+            .unwrap()
+            .collect::<Result<Vec<_>>>()
+            .unwrap();
+        assert!(merged[..merged.len() - 1]
+            .iter()
+            .all(|batch| batch.num_rows() == 64));
+        assert!(merged[merged.len() - 1].num_rows() <= 64);
+
+        // equal rows are in the order of their streams, as in a stable sort
+        let merged = concat_batches(&merged);
+        let expected = sort_batch(&concat_batches(&runs));
+        assert_eq!(merged.num_rows(), id as usize);
+        for i in 0..merged.num_columns() {
+            assert_eq!(merged.column(i).as_ref(), expected.column(i).as_ref());
+        }
+    }
+
+    #[test]
+    fn test_merge_dictionary_streams() {
+        let data_type =
+            DataType::Dictionary(Box::new(DataType::Int8), Box::new(DataType::Utf8));
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("key", DataType::Int32, false),
+            Field::new("name", data_type, true),
+        ]));
+        // each stream has its own dictionary of 100 values, too many to join for Int8
+        let readers = (0..2)
+            .map(|i| {
+                let values = (0..100)
+                    .map(|j| Some(format!("{} {}", i, j)))
+                    .collect::<StringArray>();
+                let mut names = PrimitiveBuilder::<Int8Type>::new(3);
+                for key in &[Some(i as i8), None, Some(99)] {
+                    names.append_option(*key).unwrap();
+                }
+                let names = names.finish_dict(Arc::new(values));
+                let keys = Int32Array::from(vec![i, i + 2, i + 4]);
+                let batch = RecordBatch::try_new(
+                    schema.clone(),
+                    vec![Arc::new(keys), Arc::new(names)],
+                );
+                reader(&schema, vec![batch])
+            })
+            .collect();
+        let sort_columns = vec![MergeColumn {
+            index: 0,
+            options: None,
+        }];
+
+        let merged = SortMergeReader::try_new(readers, sort_columns, 64)
+            .unwrap()
+            .collect::<Result<Vec<_>>>()
+            .unwrap();
+        assert_eq!(merged.len(), 1);
+        let names = merged[0].column(1);
+        assert_eq!(names.data_type(), schema.field(1).data_type());
+        let names = names
+            .as_any()
+            .downcast_ref::<DictionaryArray<Int8Type>>()
+            .unwrap();
+        let values = names.values();
+        let values = values.as_any().downcast_ref::<StringArray>().unwrap();
+        assert_eq!(values.len(), 4);
+        let names = names
+            .keys()
+            .iter()
+            .map(|k| k.map(|k| values.value(k as usize)))
+            .collect::<Vec<_>>();
+        assert_eq!(
+            names,
+            vec![
+                Some("0 0"),
+                Some("1 1"),
+                None,
+                None,
+                Some("0 99"),
+                Some("1 99")
+            ]
+        );
+    }
+
+    #[test]
+    fn test_merge_empty_and_failing_streams() {
+        let schema = schema();
+        let batch = RecordBatch::try_new(
+            schema.clone(),
+            vec![
+                Arc::new(Int32Array::from(vec![Some(2), Some(1), None])),
+                Arc::new(StringArray::from(vec!["a", "a", "a"])),
+                Arc::new(UInt32Array::from(vec![0, 1, 2])),
+            ],
+        )
+        .unwrap();
+        let empty = RecordBatch::new_empty(schema.clone());
+
+        let readers = vec![
+            reader(&schema, vec![]),
+            reader(
+                &schema,
+                vec![Ok(empty.clone()), Ok(batch.clone()), Ok(empty)],
+            ),
+        ];
+        let merged = SortMergeReader::try_new(readers, sort_columns(), 2)
+            .unwrap()
+            .collect::<Result<Vec<_>>>()
+            .unwrap();
+        assert_eq!(merged.len(), 2);
+        assert_eq!(
+            concat_batches(&merged).column(2).as_ref(),
+            batch.column(2).as_ref()
+        );
+
+        let error = ArrowError::ComputeError("spill file is corrupt".to_string());
+        let readers = vec![
+            reader(&schema, vec![Ok(batch.clone())]),
+            reader(&schema, vec![Ok(batch), Err(error)]),
+        ];
+        let mut merge = SortMergeReader::try_new(readers, sort_columns(), 4).unwrap();
+        assert_eq!(merge.next().unwrap().unwrap().num_rows(), 4);
+        assert_eq!(
+            merge.next().unwrap().unwrap_err().to_string(),
+            "Compute error: spill file is corrupt"
+        );
+        assert!(merge.next().is_none());
+
+        assert!(SortMergeReader::try_new(vec![], sort_columns(), 4).is_err());
+        let readers = vec![reader(&schema, vec![])];
+        let columns = vec![MergeColumn {
+            index: 3,
+            options: None,
+        }];
+        assert!(SortMergeReader::try_new(readers, columns, 4).is_err());
+    }
+}
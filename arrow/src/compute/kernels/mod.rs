@@ -23,12 +23,18 @@ pub mod arity;
 pub mod boolean;
 pub mod cast;
 pub mod cast_utils;
+pub mod coalesce;
 pub mod comparison;
 pub mod concat;
 pub mod filter;
+pub mod group_by;
+pub mod hash;
+pub mod join;
 pub mod length;
 pub mod limit;
+pub mod merge;
 pub mod regexp;
+pub mod row;
 pub mod sort;
 pub mod substring;
 pub mod take;
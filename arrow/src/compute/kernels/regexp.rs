@@ -23,80 +23,73 @@ use crate::array::{
     StringOffsetSizeTrait,
 };
 use crate::error::{ArrowError, Result};
-use std::collections::HashMap;
-
+use std::collections::hash_map::{Entry, HashMap};
+use std::iter;
 use std::sync::Arc;
 
-use regex::Regex;
+use regex::{CaptureLocations, Regex};
 
 /// Extract all groups matched by a regular expression for a given String array.
+///
+/// Each distinct pattern and flags are compiled once, and the groups are found
+/// without allocating for each value.
 pub fn regexp_match<OffsetSize: StringOffsetSizeTrait>(
     array: &GenericStringArray<OffsetSize>,
     regex_array: &GenericStringArray<OffsetSize>,
     flags_array: Option<&GenericStringArray<OffsetSize>>,
 ) -> Result<ArrayRef> {
-    let mut patterns: HashMap<String, Regex> = HashMap::new();
+    let mut patterns: HashMap<(&str, Option<&str>), (Regex, CaptureLocations)> =
+        HashMap::new();
     let builder: GenericStringBuilder<OffsetSize> = GenericStringBuilder::new(0);
     let mut list_builder = ListBuilder::new(builder);
 
-    let complete_pattern = match flags_array {
-        Some(flags) => Box::new(regex_array.iter().zip(flags.iter()).map(
-            |(pattern, flags)| {
-                pattern.map(|pattern| match flags {
-                    Some(value) => format!("(?{}){}", value, pattern),
-                    None => pattern.to_string(),
-                })
-            },
-        )) as Box<dyn Iterator<Item = Option<String>>>,
-        None => Box::new(
-            regex_array
-                .iter()
-                .map(|pattern| pattern.map(|pattern| pattern.to_string())),
-        ),
+    let flags_iter = match flags_array {
+        Some(flags) => Box::new(flags.iter()) as Box<dyn Iterator<Item = Option<&str>>>,
+        None => Box::new(iter::repeat(None)),
     };
-    array
-        .iter()
-        .zip(complete_pattern)
-        .map(|(value, pattern)| {
-            match (value, pattern) {
-                // Required for Postgres compatibility:
-                // SELECT regexp_match('foobarbequebaz', ''); = {""}
-                (Some(_), Some(pattern)) if pattern == *"" => {
-                    list_builder.values().append_value("")?;
-                    list_builder.append(true)?;
-                }
-                (Some(value), Some(pattern)) => {
-                    let existing_pattern = patterns.get(&pattern);
-                    let re = match existing_pattern {
-                        Some(re) => re.clone(),
-                        None => {
-                            let re = Regex::new(pattern.as_str()).map_err(|e| {
-                                ArrowError::ComputeError(format!(
-                                    "Regular expression did not compile: {:?}",
-                                    e
-                                ))
-                            })?;
-                            patterns.insert(pattern, re.clone());
-                            re
-                        }
-                    };
-                    match re.captures(value) {
-                        Some(caps) => {
-                            for m in caps.iter().skip(1) {
-                                if let Some(v) = m {
-                                    list_builder.values().append_value(v.as_str())?;
-                                }
+    for ((value, pattern), flags) in array.iter().zip(regex_array.iter()).zip(flags_iter)
+    {
+        match (value, pattern) {
+            // Required for Postgres compatibility:
+            // SELECT regexp_match('foobarbequebaz', ''); = {""}
+            (Some(_), Some("")) if flags.is_none() => {
+                list_builder.values().append_value("")?;
+                list_builder.append(true)?;
+            }
+            (Some(value), Some(pattern)) => {
+                let (re, locations) = match patterns.entry((pattern, flags)) {
+                    Entry::Occupied(entry) => entry.into_mut(),
+                    Entry::Vacant(entry) => {
+                        let re = match flags {
+                            Some(flags) => {
+                                Regex::new(&format!("(?{}){}", flags, pattern))
                             }
-                            list_builder.append(true)?
+                            None => Regex::new(pattern),
+                        }
+                        .map_err(|e| {
+                            ArrowError::ComputeError(format!(
+                                "Regular expression did not compile: {:?}",
+                                e
+                            ))
+                        })?;
+                        let locations = re.capture_locations();
+                        entry.insert((re, locations))
+                    }
+                };
+                if re.captures_read(locations, value).is_some() {
+                    for group in 1..locations.len() {
+                        if let Some((start, end)) = locations.get(group) {
+                            list_builder.values().append_value(&value[start..end])?;
                         }
-                        None => list_builder.append(false)?,
                     }
+                    list_builder.append(true)?;
+                } else {
+                    list_builder.append(false)?;
                 }
-                _ => list_builder.append(false)?,
             }
-            Ok(())
-        })
-        .collect::<Result<Vec<()>>>()?;
+            _ => list_builder.append(false)?,
+        }
+    }
     Ok(Arc::new(list_builder.finish()))
 }
 
@@ -157,4 +150,27 @@ mod tests {
         assert_eq!(&expected, result);
         Ok(())
     }
+
+    #[test]
+    fn match_distinct_patterns() -> Result<()> {
+        let array = StringArray::from(vec!["ab", "xy", "ab", "AB"]);
+        let pattern = StringArray::from(vec!["(a)(c)?", "(x)", "(a)(c)?", "(a)(c)?"]);
+        let flags = StringArray::from(vec![None, None, None, Some("i")]);
+        let actual = regexp_match(&array, &pattern, Some(&flags))?;
+        let elem_builder: GenericStringBuilder<i32> = GenericStringBuilder::new(0);
+        let mut expected_builder = ListBuilder::new(elem_builder);
+        // the unmatched optional group is skipped
+        expected_builder.values().append_value("a")?;
+        expected_builder.append(true)?;
+        expected_builder.values().append_value("x")?;
+        expected_builder.append(true)?;
+        expected_builder.values().append_value("a")?;
+        expected_builder.append(true)?;
+        expected_builder.values().append_value("A")?;
+        expected_builder.append(true)?;
+        let expected = expected_builder.finish();
+        let result = actual.as_any().downcast_ref::<ListArray>().unwrap();
+        assert_eq!(&expected, result);
+        Ok(())
+    }
 }
@@ -0,0 +1,1095 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Defines a row format, which encodes the rows of a set of columns to bytes that
+//! compare in the order of the rows, so that sorting, merging and comparing rows of
+//! several columns is comparing bytes.
+//!
+//! ```
+//! # use std::sync::Arc;
+//! # use arrow::array::{Array, ArrayRef, Int32Array, StringArray};
+//! # use arrow::compute::kernels::row::{RowConverter, SortField};
+//! # use arrow::compute::kernels::sort::SortOptions;
+//! # use arrow::datatypes::DataType;
+//! let converter = RowConverter::try_new(vec![
+//!     SortField::new(DataType::Utf8, SortOptions::default()),
+//!     SortField::new(
+//!         DataType::Int32,
+//!         SortOptions {
+//!             descending: true,
+//!             nulls_first: false,
+//!         },
+//!     ),
+//! ])
+//! .unwrap();
+//! let columns: Vec<ArrayRef> = vec![
+//!     Arc::new(StringArray::from(vec![Some("b"), Some("a"), None, Some("a")])),
+//!     Arc::new(Int32Array::from(vec![Some(1), Some(2), Some(3), None])),
+//! ];
+//! let rows = converter.convert_columns(&columns).unwrap();
+//! assert!(rows.row(2) < rows.row(1));
+//! assert!(rows.row(1) < rows.row(3));
+//! assert!(rows.row(3) < rows.row(0));
+//!
+//! let decoded = converter.convert_rows(rows.iter()).unwrap();
+//! assert_eq!(decoded[0].as_ref(), columns[0].as_ref());
+//! assert_eq!(decoded[1].as_ref(), columns[1].as_ref());
+//! ```
+//!
+//! # Format
+//!
+//! The row of a set of columns is the concatenation of the encodings of its values.
+//! Each value starts with a byte which is `0` for a null value if nulls are first,
+//! `0xFF` for a null value if nulls are last, and otherwise depends on the type.
+//!
+//! * A value of a fixed width type is the byte `1` followed by its big endian bytes,
+//!   with the sign bit of signed integers flipped, and floating point values mapped
+//!   to integers in their IEEE 754 total order. A null value is followed by as many
+//!   `0` bytes.
+//! * An empty string or binary value is the byte `1`, and any other is the byte `2`
+//!   followed by blocks of 32 bytes, the last one padded with `0` bytes. Each block
+//!   is followed by `0xFF` if another block follows it, and otherwise by the number
+//!   of bytes of the value in the block.
+//! * A dictionary value is the value it refers to.
+//!
+//! The bytes of a value in descending order are inverted, except for the first byte
+//! of a null value.
+
+use std::sync::Arc;
+
+use crate::array::*;
+use crate::buffer::Buffer;
+use crate::compute::kernels::cast::cast;
+use crate::compute::kernels::sort::SortOptions;
+use crate::datatypes::*;
+use crate::error::{ArrowError, Result};
+
+/// The first byte of a valid value of a fixed width type
+const VALID: u8 = 1;
+/// The first byte of an empty string or binary value
+const EMPTY: u8 = 1;
+/// The first byte of a non-empty string or binary value
+const NON_EMPTY: u8 = 2;
+/// The size of a block of a string or binary value
+const BLOCK_SIZE: usize = 32;
+/// The byte following a block of a string or binary value that is not the last block
+const BLOCK_CONTINUATION: u8 = 0xFF;
+
+/// The type and sort options of a column of rows.
+#[derive(Debug, Clone, PartialEq)]
+pub struct SortField {
+    pub data_type: DataType,
+    pub options: SortOptions,
+}
+
+impl SortField {
+    pub fn new(data_type: DataType, options: SortOptions) -> Self {
+        Self { data_type, options }
+    }
+}
+
+/// Converts columns to [`Rows`] in the row format, and back.
+#[derive(Debug, Clone)]
+pub struct RowConverter {
+    fields: Vec<SortField>,
+}
+
+impl RowConverter {
+    /// Creates a converter of columns of the types and sort options of `fields`.
+    ///
+    /// Returns an error if the row format does not support the type of a field.
+    pub fn try_new(fields: Vec<SortField>) -> Result<Self> {
+        if let Some(field) = fields.iter().find(|f| !Self::supports(&f.data_type)) {
+            return Err(ArrowError::InvalidArgumentError(format!(
+                "Row format does not support type {:?}",
+                field.data_type
+            )));
+        }
+        Ok(Self { fields })
+    }
+
+    /// Returns whether the row format supports columns of type `data_type`.
+    ///
+    /// Supported types are the primitive types other than intervals and `Float16`,
+    /// booleans, decimals, strings, binary values, and dictionaries of integers and
+    /// strings.
+    pub fn supports(data_type: &DataType) -> bool {
+        match data_type {
+            DataType::Boolean
+            | DataType::Decimal(_, _)
+            | DataType::Utf8
+            | DataType::LargeUtf8
+            | DataType::Binary
+            | DataType::LargeBinary => true,
+            DataType::Dictionary(key_type, value_type) => {
+                is_integer(key_type)
+                    && (is_integer(value_type) || value_type.as_ref() == &DataType::Utf8)
+            }
+            data_type => native_width(data_type).is_some(),
+        }
+    }
+
+    /// Returns the fields of the rows of this converter.
+    pub fn fields(&self) -> &[SortField] {
+        &self.fields
+    }
+
+    /// Returns the rows of `columns`, which are of the types of the fields of this
+    /// converter, in order.
+    pub fn convert_columns(&self, columns: &[ArrayRef]) -> Result<Rows> {
+        if columns.len() != self.fields.len() {
+            return Err(ArrowError::InvalidArgumentError(format!(
+                "Expected {} columns to convert to rows, got {}",
+                self.fields.len(),
+                columns.len()
+            )));
+        }
+        let num_rows = columns.first().map(|c| c.len()).unwrap_or(0);
+        let columns = columns
+            .iter()
+            .zip(&self.fields)
+            .map(|(column, field)| {
+                if column.data_type() != &field.data_type {
+                    return Err(ArrowError::InvalidArgumentError(format!(
+                        "Expected a column of type {:?} to convert to rows, got {:?}",
+                        field.data_type,
+                        column.data_type()
+                    )));
+                }
+                if column.len() != num_rows {
+                    return Err(ArrowError::InvalidArgumentError(
+                        "All columns converted to rows must have the same length"
+                            .to_string(),
+                    ));
+                }
+                Column::try_new(column.as_ref(), field)
+            })
+            .collect::<Result<Vec<_>>>()?;
+
+        let mut lengths = vec![0; num_rows];
+        for column in &columns {
+            column.add_lengths(&mut lengths);
+        }
+        let mut offsets = Vec::with_capacity(num_rows + 1);
+        offsets.push(0);
+        let mut total = 0;
+        for length in &lengths {
+            total += length;
+            offsets.push(total);
+        }
+
+        let mut data = vec![0; total];
+        // the offset of the next value of each row in data
+        let mut cursors = offsets[..num_rows].to_vec();
+        for column in &columns {
+            column.encode(&mut data, &mut cursors);
+        }
+        Ok(Rows { data, offsets })
+    }
+
+    /// Returns the columns of `rows`, which were converted by a converter of the same
+    /// fields as this converter.
+    ///
+    /// Returns an error if the rows are not valid rows of the fields of this
+    /// converter.
+    pub fn convert_rows<'a, I>(&self, rows: I) -> Result<Vec<ArrayRef>>
+    where
+        I: IntoIterator<Item = &'a [u8]>,
+    {
+        // the remaining bytes of each row, from which each column consumes its value
+        let mut rows = rows.into_iter().collect::<Vec<_>>();
+        let columns = self
+            .fields
+            .iter()
+            .map(|field| decode_column(&mut rows, field))
+            .collect::<Result<Vec<_>>>()?;
+        if rows.iter().any(|row| !row.is_empty()) {
+            return Err(ArrowError::InvalidArgumentError(
+                "Row has bytes after its last value".to_string(),
+            ));
+        }
+        Ok(columns)
+    }
+}
+
+/// Rows in the row format, which compare like the rows of the columns they were
+/// converted from.
+#[derive(Debug, Clone)]
+pub struct Rows {
+    data: Vec<u8>,
+    /// The offset of each row in `data`, followed by the length of `data`
+    offsets: Vec<usize>,
+}
+
+impl Rows {
+    /// Returns the number of rows.
+    pub fn num_rows(&self) -> usize {
+        self.offsets.len() - 1
+    }
+
+    /// Returns the bytes of row `i`.
+    #[inline]
+    pub fn row(&self, i: usize) -> &[u8] {
+        &self.data[self.offsets[i]..self.offsets[i + 1]]
+    }
+
+    /// Returns an iterator over the bytes of each row.
+    pub fn iter(&self) -> impl Iterator<Item = &[u8]> + '_ {
+        (0..self.num_rows()).map(move |i| self.row(i))
+    }
+
+    /// Returns the size of the rows in bytes.
+    pub fn size(&self) -> usize {
+        self.data.len() + self.offsets.len() * std::mem::size_of::<usize>()
+    }
+}
+
+/// A value of a fixed width type, encoded to bytes in its order.
+trait RowEncode: Copy + Default {
+    /// The number of bytes of an encoded value
+    const WIDTH: usize;
+
+    /// Writes this value to `out`, of length `WIDTH`.
+    fn encode(self, out: &mut [u8]);
+
+    /// Reads a value from `bytes`, of length `WIDTH`.
+    fn decode(bytes: &[u8]) -> Self;
+}
+
+macro_rules! unsigned_row_encode {
+    ($($native:ty),*) => {
+        $(impl RowEncode for $native {
+            const WIDTH: usize = std::mem::size_of::<$native>();
+
+            #[inline]
+            fn encode(self, out: &mut [u8]) {
+                out.copy_from_slice(&self.to_be_bytes());
+            }
+
+            #[inline]
+            fn decode(bytes: &[u8]) -> Self {
+                let mut value = [0; std::mem::size_of::<$native>()];
+                value.copy_from_slice(bytes);
+                <$native>::from_be_bytes(value)
+            }
+        })*
+    };
+}
+
+macro_rules! signed_row_encode {
+    ($($native:ty => $unsigned:ty),*) => {
+        $(impl RowEncode for $native {
+            const WIDTH: usize = std::mem::size_of::<$native>();
+
+            #[inline]
+            fn encode(self, out: &mut [u8]) {
+                let sign = 1 << (Self::WIDTH * 8 - 1);
+                ((self as $unsigned) ^ sign).encode(out);
+            }
+
+            #[inline]
+            fn decode(bytes: &[u8]) -> Self {
+                let sign = 1 << (Self::WIDTH * 8 - 1);
+                (<$unsigned>::decode(bytes) ^ sign) as $native
+            }
+        })*
+    };
+}
+
+macro_rules! float_row_encode {
+    ($($native:ty => $signed:ty, $unsigned:ty),*) => {
+        $(impl RowEncode for $native {
+            const WIDTH: usize = std::mem::size_of::<$native>();
+
+            #[inline]
+            fn encode(self, out: &mut [u8]) {
+                // the IEEE 754 total order, as in the sort of floating point values
+                let bits = self.to_bits() as $signed;
+                let shift = Self::WIDTH * 8 - 1;
+                (bits ^ ((((bits >> shift) as $unsigned) >> 1) as $signed)).encode(out);
+            }
+
+            #[inline]
+            fn decode(bytes: &[u8]) -> Self {
+                let bits = <$signed>::decode(bytes);
+                let shift = Self::WIDTH * 8 - 1;
+                let bits = bits ^ ((((bits >> shift) as $unsigned) >> 1) as $signed);
+                <$native>::from_bits(bits as $unsigned)
+            }
+        })*
+    };
+}
+
+unsigned_row_encode!(u8, u16, u32, u64, u128);
+signed_row_encode!(i8 => u8, i16 => u16, i32 => u32, i64 => u64, i128 => u128);
+float_row_encode!(f32 => i32, u32, f64 => i64, u64);
+
+/// Calls `$f::<native>($args)` with the native type of the primitive type
+/// `$data_type`, or evaluates `$other` if it is not a supported primitive type.
+macro_rules! with_native_type {
+    ($data_type:expr, $f:ident($($args:expr),*), $other:expr) => {
+        match $data_type {
+            DataType::Int8 => $f::<i8>($($args),*),
+            DataType::Int16 => $f::<i16>($($args),*),
+            DataType::Int32 | DataType::Date32 | DataType::Time32(_) => {
+                $f::<i32>($($args),*)
+            }
+            DataType::Int64
+            | DataType::Date64
+            | DataType::Time64(_)
+            | DataType::Timestamp(_, _)
+            | DataType::Duration(_) => $f::<i64>($($args),*),
+            DataType::UInt8 => $f::<u8>($($args),*),
+            DataType::UInt16 => $f::<u16>($($args),*),
+            DataType::UInt32 => $f::<u32>($($args),*),
+            DataType::UInt64 => $f::<u64>($($args),*),
+            DataType::Float32 => $f::<f32>($($args),*),
+            DataType::Float64 => $f::<f64>($($args),*),
+            _ => $other,
+        }
+    };
+}
+
+/// Returns whether `data_type` is an integer type.
+fn is_integer(data_type: &DataType) -> bool {
+    matches!(
+        data_type,
+        DataType::Int8
+            | DataType::Int16
+            | DataType::Int32
+            | DataType::Int64
+            | DataType::UInt8
+            | DataType::UInt16
+            | DataType::UInt32
+            | DataType::UInt64
+    )
+}
+
+/// Returns the width of the native type of a supported primitive type.
+fn native_width(data_type: &DataType) -> Option<usize> {
+    fn width<T: RowEncode>() -> Option<usize> {
+        Some(T::WIDTH)
+    }
+    with_native_type!(data_type, width(), None)
+}
+
+/// Returns the first byte of a null value.
+#[inline]
+fn null_sentinel(options: &SortOptions) -> u8 {
+    if options.nulls_first {
+        0
+    } else {
+        0xFF
+    }
+}
+
+/// Returns the number of bytes of a string or binary value of `len` bytes.
+#[inline]
+fn bytes_encoded_len(len: usize) -> usize {
+    if len == 0 {
+        1
+    } else {
+        1 + (len + BLOCK_SIZE - 1) / BLOCK_SIZE * (BLOCK_SIZE + 1)
+    }
+}
+
+/// A column being converted to rows.
+enum Column<'a> {
+    Array {
+        array: &'a Array,
+        options: SortOptions,
+    },
+    /// A dictionary array, as the encoded values of its dictionary
+    Dictionary {
+        values: Rows,
+        /// The index in `values` of the value of each row, if any
+        keys: Vec<Option<usize>>,
+        /// The encoding of a null value
+        null: Vec<u8>,
+    },
+}
+
+impl<'a> Column<'a> {
+    fn try_new(array: &'a Array, field: &SortField) -> Result<Self> {
+        match &field.data_type {
+            DataType::Dictionary(key_type, value_type) => {
+                let (keys, values) = match key_type.as_ref() {
+                    DataType::Int8 => dictionary_keys::<Int8Type>(array)?,
+                    DataType::Int16 => dictionary_keys::<Int16Type>(array)?,
+                    DataType::Int32 => dictionary_keys::<Int32Type>(array)?,
+                    DataType::Int64 => dictionary_keys::<Int64Type>(array)?,
+                    DataType::UInt8 => dictionary_keys::<UInt8Type>(array)?,
+                    DataType::UInt16 => dictionary_keys::<UInt16Type>(array)?,
+                    DataType::UInt32 => dictionary_keys::<UInt32Type>(array)?,
+                    DataType::UInt64 => dictionary_keys::<UInt64Type>(array)?,
+                    t => {
+                        return Err(ArrowError::InvalidArgumentError(format!(
+                            "Dictionary key type {:?} not supported",
+                            t
+                        )))
+                    }
+                };
+                let value_field =
+                    SortField::new(value_type.as_ref().clone(), field.options);
+                let values = RowConverter::try_new(vec![value_field])?
+                    .convert_columns(&[values])?;
+                let mut null = vec![0; 1 + native_width(value_type).unwrap_or(0)];
+                null[0] = null_sentinel(&field.options);
+                Ok(Column::Dictionary { values, keys, null })
+            }
+            _ => Ok(Column::Array {
+                array,
+                options: field.options,
+            }),
+        }
+    }
+
+    /// Adds the number of bytes of each value of this column to `lengths`.
+    fn add_lengths(&self, lengths: &mut [usize]) {
+        match self {
+            Column::Array { array, .. } => {
+                macro_rules! add_bytes_lengths {
+                    ($array_type:ty) => {{
+                        let array = array.as_any().downcast_ref::<$array_type>().unwrap();
+                        for (i, length) in lengths.iter_mut().enumerate() {
+                            *length += if array.is_valid(i) {
+                                bytes_encoded_len(array.value_length(i) as usize)
+                            } else {
+                                1
+                            };
+                        }
+                    }};
+                }
+                let width = match array.data_type() {
+                    DataType::Boolean => 1,
+                    DataType::Decimal(_, _) => i128::WIDTH,
+                    DataType::Utf8 => return add_bytes_lengths!(StringArray),
+                    DataType::LargeUtf8 => return add_bytes_lengths!(LargeStringArray),
+                    DataType::Binary => return add_bytes_lengths!(BinaryArray),
+                    DataType::LargeBinary => return add_bytes_lengths!(LargeBinaryArray),
+                    data_type => native_width(data_type).unwrap(),
+                };
+                lengths.iter_mut().for_each(|length| *length += 1 + width);
+            }
+            Column::Dictionary { values, keys, null } => {
+                for (length, key) in lengths.iter_mut().zip(keys) {
+                    *length += match key {
+                        Some(key) => values.row(*key).len(),
+                        None => null.len(),
+                    };
+                }
+            }
+        }
+    }
+
+    /// Writes each value of this column to `data` at the offset of its row in
+    /// `cursors`, and advances the offsets past the values.
+    fn encode(&self, data: &mut [u8], cursors: &mut [usize]) {
+        match self {
+            Column::Array { array, options } => {
+                let array = *array;
+                macro_rules! encode_bytes_array {
+                    ($array_type:ty) => {{
+                        let array = array.as_any().downcast_ref::<$array_type>().unwrap();
+                        encode_bytes(array, options, data, cursors, |i| {
+                            AsRef::<[u8]>::as_ref(array.value(i))
+                        })
+                    }};
+                }
+                match array.data_type() {
+                    DataType::Boolean => {
+                        let array =
+                            array.as_any().downcast_ref::<BooleanArray>().unwrap();
+                        encode_fixed(array, options, data, cursors, |i| {
+                            array.value(i) as u8
+                        })
+                    }
+                    DataType::Decimal(_, _) => {
+                        let array =
+                            array.as_any().downcast_ref::<DecimalArray>().unwrap();
+                        encode_fixed(array, options, data, cursors, |i| array.value(i))
+                    }
+                    DataType::Utf8 => encode_bytes_array!(StringArray),
+                    DataType::LargeUtf8 => encode_bytes_array!(LargeStringArray),
+                    DataType::Binary => encode_bytes_array!(BinaryArray),
+                    DataType::LargeBinary => encode_bytes_array!(LargeBinaryArray),
+                    data_type => with_native_type!(
+                        data_type,
+                        encode_primitive(array, options, data, cursors),
+                        unreachable!("Unsupported type {:?}", data_type)
+                    ),
+                }
+            }
+            Column::Dictionary { values, keys, null } => {
+                for (cursor, key) in cursors.iter_mut().zip(keys) {
+                    let value = match key {
+                        Some(key) => values.row(*key),
+                        None => null.as_slice(),
+                    };
+                    data[*cursor..*cursor + value.len()].copy_from_slice(value);
+                    *cursor += value.len();
+                }
+            }
+        }
+    }
+}
+
+/// Returns the index of the value of each row of a dictionary array, and its values.
+fn dictionary_keys<K: ArrowDictionaryKeyType>(
+    array: &Array,
+) -> Result<(Vec<Option<usize>>, ArrayRef)> {
+    let array = array.as_any().downcast_ref::<DictionaryArray<K>>().unwrap();
+    let values = array.values();
+    let keys = array
+        .keys()
+        .iter()
+        .map(|key| match key {
+            Some(key) => match key.to_usize() {
+                Some(key) if key < values.len() => Ok(Some(key)),
+                _ => Err(ArrowError::InvalidArgumentError(format!(
+                    "Dictionary key {:?} is out of bounds of {} values",
+                    key,
+                    values.len()
+                ))),
+            },
+            None => Ok(None),
+        })
+        .collect::<Result<Vec<_>>>()?;
+    Ok((keys, values))
+}
+
+/// Writes the values of a primitive array with native type `T`.
+fn encode_primitive<T>(
+    array: &Array,
+    options: &SortOptions,
+    data: &mut [u8],
+    cursors: &mut [usize],
+) where
+    T: RowEncode + ArrowNativeType + num::Num,
+{
+    // Soundness: the data type of the array has native type T
+    let values = unsafe { array.data().buffers()[0].typed_data::<T>() };
+    let values = &values[array.offset()..array.offset() + array.len()];
+    encode_fixed(array, options, data, cursors, |i| values[i]);
+}
+
+/// Writes the values of a fixed width array, given by `value` for valid values.
+#[inline]
+fn encode_fixed<T, F>(
+    array: &Array,
+    options: &SortOptions,
+    data: &mut [u8],
+    cursors: &mut [usize],
+    value: F,
+) where
+    T: RowEncode,
+    F: Fn(usize) -> T,
+{
+    for (i, cursor) in cursors.iter_mut().enumerate() {
+        let out = &mut data[*cursor..*cursor + 1 + T::WIDTH];
+        // the bytes of a null value are already 0
+        if array.is_valid(i) {
+            out[0] = VALID;
+            value(i).encode(&mut out[1..]);
+            if options.descending {
+                out[1..].iter_mut().for_each(|b| *b = !*b);
+            }
+        } else {
+            out[0] = null_sentinel(options);
+        }
+        *cursor += 1 + T::WIDTH;
+    }
+}
+
+/// Writes the values of a string or binary array, given by `value` for valid values.
+#[inline]
+fn encode_bytes<'a, F>(
+    array: &Array,
+    options: &SortOptions,
+    data: &mut [u8],
+    cursors: &mut [usize],
+    value: F,
+) where
+    F: Fn(usize) -> &'a [u8],
+{
+    for (i, cursor) in cursors.iter_mut().enumerate() {
+        if !array.is_valid(i) {
+            data[*cursor] = null_sentinel(options);
+            *cursor += 1;
+            continue;
+        }
+        let value = value(i);
+        let len = bytes_encoded_len(value.len());
+        let out = &mut data[*cursor..*cursor + len];
+        if value.is_empty() {
+            out[0] = EMPTY;
+        } else {
+            out[0] = NON_EMPTY;
+            let num_blocks = (len - 1) / (BLOCK_SIZE + 1);
+            let blocks = out[1..].chunks_exact_mut(BLOCK_SIZE + 1);
+            for (j, (block, chunk)) in blocks.zip(value.chunks(BLOCK_SIZE)).enumerate() {
+                block[..chunk.len()].copy_from_slice(chunk);
+                block[BLOCK_SIZE] = if j + 1 < num_blocks {
+                    BLOCK_CONTINUATION
+                } else {
+                    chunk.len() as u8
+                };
+            }
+        }
+        if options.descending {
+            out.iter_mut().for_each(|b| *b = !*b);
+        }
+        *cursor += len;
+    }
+}
+
+/// Returns the first `len` bytes of `row`, and advances it past them.
+#[inline]
+fn split_row<'a>(row: &mut &'a [u8], len: usize) -> Result<&'a [u8]> {
+    if row.len() < len {
+        return Err(ArrowError::InvalidArgumentError(
+            "Row is shorter than its values".to_string(),
+        ));
+    }
+    let (value, rest) = row.split_at(len);
+    *row = rest;
+    Ok(value)
+}
+
+/// Decodes the values of a column from the start of each of `rows`, and advances the
+/// rows past them.
+fn decode_column(rows: &mut [&[u8]], field: &SortField) -> Result<ArrayRef> {
+    let options = &field.options;
+    macro_rules! decode_bytes_array {
+        ($builder:ty, $append:expr) => {{
+            let mut builder = <$builder>::new(rows.len());
+            let mut value = vec![];
+            for row in rows.iter_mut() {
+                if decode_bytes(row, options, &mut value)? {
+                    $append(&mut builder, value.as_slice())?;
+                } else {
+                    builder.append_null()?;
+                }
+            }
+            Arc::new(builder.finish()) as ArrayRef
+        }};
+    }
+    macro_rules! decode_string_array {
+        ($builder:ty) => {
+            decode_bytes_array!($builder, |builder: &mut $builder, value: &[u8]| {
+                let value = std::str::from_utf8(value).map_err(|e| {
+                    ArrowError::InvalidArgumentError(format!(
+                        "Row has an invalid UTF-8 value: {}",
+                        e
+                    ))
+                })?;
+                builder.append_value(value)
+            })
+        };
+    }
+
+    let array = match &field.data_type {
+        DataType::Boolean => {
+            let (values, valid) = decode_fixed::<u8>(rows, options)?;
+            let array = values
+                .iter()
+                .zip(valid)
+                .map(|(value, valid)| if valid { Some(*value != 0) } else { None })
+                .collect::<BooleanArray>();
+            Arc::new(array) as ArrayRef
+        }
+        DataType::Decimal(precision, scale) => {
+            let (values, nulls) = decode_fixed::<i128>(rows, options)?;
+            let mut builder = DecimalBuilder::new(values.len(), *precision, *scale);
+            for (value, valid) in values.into_iter().zip(nulls) {
+                if valid {
+                    builder.append_value(value)?;
+                } else {
+                    builder.append_null()?;
+                }
+            }
+            Arc::new(builder.finish()) as ArrayRef
+        }
+        DataType::Utf8 => decode_string_array!(StringBuilder),
+        DataType::LargeUtf8 => decode_string_array!(LargeStringBuilder),
+        DataType::Binary => {
+            decode_bytes_array!(
+                BinaryBuilder,
+                |builder: &mut BinaryBuilder, value: &[u8]| {
+                    builder.append_value(value)
+                }
+            )
+        }
+        DataType::LargeBinary => {
+            decode_bytes_array!(
+                LargeBinaryBuilder,
+                |builder: &mut LargeBinaryBuilder, value: &[u8]| {
+                    builder.append_value(value)
+                }
+            )
+        }
+        DataType::Dictionary(_, value_type) => {
+            let value_field = SortField::new(value_type.as_ref().clone(), *options);
+            let values = decode_column(rows, &value_field)?;
+            cast(&values, &field.data_type)?
+        }
+        data_type => with_native_type!(
+            data_type,
+            decode_primitive(rows, field),
+            Err(ArrowError::InvalidArgumentError(format!(
+                "Row format does not support type {:?}",
+                data_type
+            )))
+        )?,
+    };
+    Ok(array)
+}
+
+/// Decodes the values of a fixed width column, returning default values for nulls,
+/// and whether each value is valid.
+fn decode_fixed<T: RowEncode>(
+    rows: &mut [&[u8]],
+    options: &SortOptions,
+) -> Result<(Vec<T>, Vec<bool>)> {
+    let mut values = Vec::with_capacity(rows.len());
+    let mut valid = Vec::with_capacity(rows.len());
+    let mut bytes = [0; 16];
+    let bytes = &mut bytes[..T::WIDTH];
+    for row in rows.iter_mut() {
+        let value = split_row(row, 1 + T::WIDTH)?;
+        if value[0] == VALID {
+            bytes.copy_from_slice(&value[1..]);
+            if options.descending {
+                bytes.iter_mut().for_each(|b| *b = !*b);
+            }
+            values.push(T::decode(bytes));
+            valid.push(true);
+        } else if value[0] == null_sentinel(options) {
+            values.push(T::default());
+            valid.push(false);
+        } else {
+            return Err(ArrowError::InvalidArgumentError(format!(
+                "Row has an invalid value marker {}",
+                value[0]
+            )));
+        }
+    }
+    Ok((values, valid))
+}
+
+/// Decodes the values of a primitive column with native type `T`.
+fn decode_primitive<T>(rows: &mut [&[u8]], field: &SortField) -> Result<ArrayRef>
+where
+    T: RowEncode + ArrowNativeType,
+{
+    let (values, valid) = decode_fixed::<T>(rows, &field.options)?;
+    let null_count = valid.iter().filter(|valid| !**valid).count();
+    let null_buffer = if null_count > 0 {
+        let mut builder = BooleanBufferBuilder::new(valid.len());
+        valid.iter().for_each(|valid| builder.append(*valid));
+        Some(builder.finish())
+    } else {
+        None
+    };
+    let data = ArrayData::new(
+        field.data_type.clone(),
+        values.len(),
+        Some(null_count),
+        null_buffer,
+        0,
+        vec![Buffer::from_slice_ref(&values)],
+        vec![],
+    );
+    Ok(make_array(data))
+}
+
+/// Decodes a string or binary value from the start of `row` to `value`, and advances
+/// the row past it. Returns whether the value is valid.
+fn decode_bytes(
+    row: &mut &[u8],
+    options: &SortOptions,
+    value: &mut Vec<u8>,
+) -> Result<bool> {
+    value.clear();
+    let invert = |b: u8| if options.descending { !b } else { b };
+    let sentinel = split_row(row, 1)?[0];
+    if sentinel == null_sentinel(options) {
+        return Ok(false);
+    }
+    match invert(sentinel) {
+        EMPTY => return Ok(true),
+        NON_EMPTY => {}
+        sentinel => {
+            return Err(ArrowError::InvalidArgumentError(format!(
+                "Row has an invalid value marker {}",
+                sentinel
+            )))
+        }
+    }
+    loop {
+        let block = split_row(row, BLOCK_SIZE + 1)?;
+        let len = match invert(block[BLOCK_SIZE]) {
+            BLOCK_CONTINUATION => BLOCK_SIZE,
+            len if len >= 1 && len as usize <= BLOCK_SIZE => len as usize,
+            len => {
+                return Err(ArrowError::InvalidArgumentError(format!(
+                    "Row has an invalid block length {}",
+                    len
+                )))
+            }
+        };
+        value.extend(block[..len].iter().map(|b| invert(*b)));
+        if invert(block[BLOCK_SIZE]) != BLOCK_CONTINUATION {
+            return Ok(true);
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use std::cmp::Ordering;
+
+    use rand::{Rng, SeedableRng};
+
+    fn options(descending: bool, nulls_first: bool) -> SortOptions {
+        SortOptions {
+            descending,
+            nulls_first,
+        }
+    }
+
+    /// Checks that the rows of `column` compare like its values, for all sort options,
+    /// and that they convert back to `column`.
+    fn check_column(column: ArrayRef) {
+        let comparator = build_compare(column.as_ref(), column.as_ref()).unwrap();
+        check_column_with(column.clone(), comparator)
+    }
+
+    /// Checks that the rows of `column` compare like `comparator` compares the indices
+    /// of its valid values, for all sort options, and that they convert back to `column`.
+    fn check_column_with<F>(column: ArrayRef, comparator: F)
+    where
+        F: Fn(usize, usize) -> Ordering,
+    {
+        for descending in &[false, true] {
+            for nulls_first in &[false, true] {
+                let options = options(*descending, *nulls_first);
+                let field = SortField::new(column.data_type().clone(), options);
+                let converter = RowConverter::try_new(vec![field]).unwrap();
+                let rows = converter.convert_columns(&[column.clone()]).unwrap();
+                assert_eq!(rows.num_rows(), column.len());
+
+                for i in 0..column.len() {
+                    for j in 0..column.len() {
+                        let expected = match (column.is_valid(i), column.is_valid(j)) {
+                            (true, true) if *descending => comparator(i, j).reverse(),
+                            (true, true) => comparator(i, j),
+                            (false, false) => Ordering::Equal,
+                            (false, true) if *nulls_first => Ordering::Less,
+                            (false, true) => Ordering::Greater,
+                            (true, false) if *nulls_first => Ordering::Greater,
+                            (true, false) => Ordering::Less,
+                        };
+                        assert_eq!(
+                            rows.row(i).cmp(rows.row(j)),
+                            expected,
+                            "rows {} and {} of {:?} with {:?}",
+                            i,
+                            j,
+                            column,
+                            options
+                        );
+                    }
+                }
+
+                let decoded = converter.convert_rows(rows.iter()).unwrap();
+                assert_eq!(decoded[0].as_ref(), column.as_ref());
+            }
+        }
+    }
+
+    #[test]
+    fn test_row_primitive() {
+        check_column(Arc::new(Int32Array::from(vec![
+            Some(5),
+            None,
+            Some(-3),
+            Some(0),
+            Some(std::i32::MIN),
+            Some(std::i32::MAX),
+            Some(-3),
+        ])));
+        check_column(Arc::new(UInt8Array::from(vec![
+            Some(5),
+            None,
+            Some(0),
+            Some(255),
+        ])));
+        check_column(Arc::new(Float64Array::from(vec![
+            Some(1.5),
+            None,
+            Some(-2.0),
+            Some(0.0),
+            Some(std::f64::INFINITY),
+            Some(std::f64::NEG_INFINITY),
+            Some(-1e-300),
+        ])));
+        check_column(Arc::new(TimestampMillisecondArray::from_opt_vec(
+            vec![Some(1), None, Some(-1)],
+            Some("UTC".to_string()),
+        )));
+        check_column(Arc::new(BooleanArray::from(vec![
+            Some(true),
+            None,
+            Some(false),
+            Some(true),
+        ])));
+        // a sliced array
+        check_column(Int64Array::from(vec![1, 3, 2, 5]).slice(1, 3));
+    }
+
+    #[test]
+    fn test_row_float_total_order() {
+        let values = Float32Array::from(vec![std::f32::NAN, 0.0, -0.0, 1.0]);
+        let converter = RowConverter::try_new(vec![SortField::new(
+            DataType::Float32,
+            Default::default(),
+        )])
+        .unwrap();
+        let rows = converter
+            .convert_columns(&[Arc::new(values) as ArrayRef])
+            .unwrap();
+        assert!(rows.row(2) < rows.row(1));
+        assert!(rows.row(1) < rows.row(3));
+        assert!(rows.row(3) < rows.row(0));
+
+        let decoded = converter.convert_rows(rows.iter()).unwrap();
+        let decoded = as_primitive_array::<Float32Type>(&decoded[0]);
+        assert!(decoded.value(0).is_nan());
+        assert!(decoded.value(2).is_sign_negative());
+    }
+
+    #[test]
+    fn test_row_strings() {
+        let long = "a".repeat(BLOCK_SIZE);
+        let values = vec![
+            Some("b"),
+            None,
+            Some(""),
+            Some("a"),
+            Some("a\0"),
+            Some("ab"),
+            Some(long.as_str()),
+            Some(&long[1..]),
+        ];
+        let longer = format!("{}a", long);
+        let mut values = values;
+        values.push(Some(longer.as_str()));
+        check_column(Arc::new(StringArray::from(values.clone())));
+        check_column(Arc::new(LargeStringArray::from(values.clone())));
+        let binary = values
+            .iter()
+            .map(|v| v.map(|v| v.as_bytes()))
+            .collect::<Vec<_>>();
+        let array = BinaryArray::from(binary.clone());
+        check_column_with(Arc::new(array), |i, j| binary[i].cmp(&binary[j]));
+    }
+
+    fn decimal_values(decimals: &DecimalArray) -> Vec<i128> {
+        (0..decimals.len()).map(|i| decimals.value(i)).collect()
+    }
+
+    #[test]
+    fn test_row_decimal_and_dictionary() {
+        let mut builder = DecimalBuilder::new(4, 20, 2);
+        builder.append_value(-12345).unwrap();
+        builder.append_null().unwrap();
+        builder.append_value(100).unwrap();
+        builder.append_value(std::i128::MIN).unwrap();
+        let decimals = builder.finish();
+        let values = decimal_values(&decimals);
+        check_column_with(Arc::new(decimals), |i, j| values[i].cmp(&values[j]));
+
+        let dictionary: DictionaryArray<Int16Type> =
+            vec![Some("b"), None, Some("a"), Some("b"), Some("c")]
+                .into_iter()
+                .collect();
+        check_column(Arc::new(dictionary));
+    }
+
+    #[test]
+    fn test_row_multiple_columns() {
+        let mut rng = rand::rngs::StdRng::seed_from_u64(42);
+        let ints = (0..200)
+            .map(|_| Some(rng.gen_range(0, 5)).filter(|v| *v != 4))
+            .collect::<Int32Array>();
+        let strings = (0..200)
+            .map(|_| Some(["x", "y", "xy", ""][rng.gen_range(0, 4)]))
+            .collect::<StringArray>();
+        let columns: Vec<ArrayRef> = vec![Arc::new(ints), Arc::new(strings)];
+        let fields = vec![
+            SortField::new(DataType::Int32, options(true, false)),
+            SortField::new(DataType::Utf8, options(false, true)),
+        ];
+        let converter = RowConverter::try_new(fields).unwrap();
+        let rows = converter.convert_columns(&columns).unwrap();
+
+        let comparators = columns
+            .iter()
+            .map(|c| build_compare(c.as_ref(), c.as_ref()).unwrap())
+            .collect::<Vec<_>>();
+        for i in 0..200 {
+            for j in 0..200 {
+                let ints = match (columns[0].is_valid(i), columns[0].is_valid(j)) {
+                    (true, true) => comparators[0](i, j).reverse(),
+                    // nulls last
+                    (a, b) => b.cmp(&a),
+                };
+                let expected = ints.then_with(|| comparators[1](i, j));
+                assert_eq!(rows.row(i).cmp(rows.row(j)), expected);
+            }
+        }
+
+        let decoded = converter.convert_rows(rows.iter()).unwrap();
+        assert_eq!(decoded, columns);
+    }
+
+    #[test]
+    fn test_row_invalid() {
+        let err = RowConverter::try_new(vec![SortField::new(
+            DataType::Interval(IntervalUnit::DayTime),
+            Default::default(),
+        )])
+        .unwrap_err();
+        assert_eq!(
+            err.to_string(),
+            "Invalid argument error: Row format does not support type Interval(DayTime)"
+        );
+
+        let converter = RowConverter::try_new(vec![SortField::new(
+            DataType::Int64,
+            Default::default(),
+        )])
+        .unwrap();
+        let column: ArrayRef = Arc::new(Int32Array::from(vec![1]));
+        assert!(converter.convert_columns(&[column]).is_err());
+        assert!(converter.convert_rows(vec![&[1_u8, 2, 3][..]]).is_err());
+        assert!(converter.convert_rows(vec![&[0_u8; 10][..]]).is_err());
+    }
+}
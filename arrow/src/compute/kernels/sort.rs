@@ -18,9 +18,12 @@
 //! Defines sort kernel for `ArrayRef`
 
 use std::cmp::Ordering;
+use std::sync::Arc;
+use std::thread;
 
 use crate::array::*;
 use crate::buffer::MutableBuffer;
+use crate::compute::kernels::row::{RowConverter, Rows, SortField};
 use crate::compute::take;
 use crate::datatypes::*;
 use crate::error::{ArrowError, Result};
@@ -785,6 +788,12 @@ pub fn lexsort(columns: &[SortColumn], limit: Option<usize>) -> Result<Vec<Array
 
 /// Sort elements lexicographically from a list of `ArrayRef` into an unsigned integer
 /// (`UInt32Array`) of indices.
+///
+/// If the row format supports the types of all columns, see
+/// [`RowConverter::supports`], the columns are converted to rows which are compared
+/// as bytes, and floating point values are compared in their IEEE 754 total order,
+/// as in [`sort_to_indices`]. Otherwise each comparison compares the columns one
+/// after the other.
 pub fn lexsort_to_indices(
     columns: &[SortColumn],
     limit: Option<usize>,
@@ -807,6 +816,44 @@ pub fn lexsort_to_indices(
         ));
     };
 
+    let mut value_indices = (0..row_count).collect::<Vec<usize>>();
+    let mut len = value_indices.len();
+
+    if let Some(limit) = limit {
+        len = limit.min(len);
+    }
+
+    if columns
+        .iter()
+        .all(|column| RowConverter::supports(column.values.data_type()))
+    {
+        // compares the rows of all columns at once, breaking ties by index for a
+        // stable sort with a limit
+        let fields = columns
+            .iter()
+            .map(|column| {
+                SortField::new(
+                    column.values.data_type().clone(),
+                    column.options.unwrap_or_default(),
+                )
+            })
+            .collect();
+        let values = columns
+            .iter()
+            .map(|column| column.values.clone())
+            .collect::<Vec<_>>();
+        let rows = RowConverter::try_new(fields)?.convert_columns(&values)?;
+        sort_by(&mut value_indices, len, |a, b| {
+            rows.row(*a).cmp(rows.row(*b)).then(a.cmp(b))
+        });
+        return Ok(UInt32Array::from(
+            (&value_indices)[0..len]
+                .iter()
+                .map(|i| *i as u32)
+                .collect::<Vec<u32>>(),
+        ));
+    }
+
     // map to data and DynComparator
     let flat_columns = columns
         .iter()
@@ -863,12 +910,6 @@ pub fn lexsort_to_indices(
         Ordering::Equal
     };
 
-    let mut value_indices = (0..row_count).collect::<Vec<usize>>();
-    let mut len = value_indices.len();
-
-    if let Some(limit) = limit {
-        len = limit.min(len);
-    }
     sort_by(&mut value_indices, len, lex_comparator);
 
     Ok(UInt32Array::from(
@@ -879,6 +920,269 @@ pub fn lexsort_to_indices(
     ))
 }
 
+/// The minimum number of rows sorted by each thread of [`sort_to_indices_parallel`]
+/// and [`lexsort_to_indices_parallel`], below which fewer threads are used.
+const MIN_PARALLEL_SORT_CHUNK_LEN: usize = 1 << 14;
+
+/// Sort the `ArrayRef` into an unsigned integer (`UInt32Array`) of indices using up
+/// to `num_threads` threads.
+///
+/// The array is split into one chunk per thread, each thread sorts its chunk and the
+/// sorted chunks are then merged pairwise, also in parallel. The indices are the same
+/// as those of a stable [`sort_to_indices`] without a limit, whose first `limit`
+/// indices are returned if `limit` is specified.
+///
+/// Arrays which are too small to be split, or whose type is not supported by the
+/// row format, see [`RowConverter::supports`], are sorted by a single thread.
+pub fn sort_to_indices_parallel(
+    values: &ArrayRef,
+    options: Option<SortOptions>,
+    limit: Option<usize>,
+    num_threads: usize,
+) -> Result<UInt32Array> {
+    let options = options.unwrap_or_default();
+    let num_threads = parallel_sort_threads(values.len(), num_threads);
+    if num_threads <= 1 || !supports_parallel_sort(values.data_type()) {
+        let indices = sort_to_indices(values, Some(options), None)?;
+        return Ok(match limit {
+            Some(limit) if limit < indices.len() => {
+                UInt32Array::from(indices.values()[0..limit].to_vec())
+            }
+            _ => indices,
+        });
+    }
+
+    // sort_to_indices orders equal values by index, except for nulls in descending
+    // order, which it orders by descending index
+    let tie_column = if options.descending && values.null_count() > 0 {
+        Some(values.clone())
+    } else {
+        None
+    };
+    let fields = vec![SortField::new(values.data_type().clone(), options)];
+    parallel_sort(vec![values.clone()], fields, tie_column, limit, num_threads)
+}
+
+/// Sort elements lexicographically from a list of `ArrayRef` into an unsigned integer
+/// (`UInt32Array`) of indices using up to `num_threads` threads.
+///
+/// The indices are the same as those of [`lexsort_to_indices`], and the columns are
+/// split and merged as in [`sort_to_indices_parallel`].
+pub fn lexsort_to_indices_parallel(
+    columns: &[SortColumn],
+    limit: Option<usize>,
+    num_threads: usize,
+) -> Result<UInt32Array> {
+    if columns.len() == 1 {
+        let column = &columns[0];
+        return sort_to_indices_parallel(
+            &column.values,
+            column.options,
+            limit,
+            num_threads,
+        );
+    }
+    let row_count = columns
+        .first()
+        .map(|column| column.values.len())
+        .unwrap_or(0);
+    let num_threads = parallel_sort_threads(row_count, num_threads);
+    if num_threads <= 1
+        || columns.iter().any(|column| {
+            column.values.len() != row_count
+                || !RowConverter::supports(column.values.data_type())
+        })
+    {
+        return lexsort_to_indices(columns, limit);
+    }
+
+    let fields = columns
+        .iter()
+        .map(|column| {
+            SortField::new(
+                column.values.data_type().clone(),
+                column.options.unwrap_or_default(),
+            )
+        })
+        .collect();
+    let values = columns
+        .iter()
+        .map(|column| column.values.clone())
+        .collect::<Vec<_>>();
+    parallel_sort(values, fields, None, limit, num_threads)
+}
+
+/// Returns the number of threads sorting `num_rows` rows, at most `num_threads`.
+fn parallel_sort_threads(num_rows: usize, num_threads: usize) -> usize {
+    num_threads.min(num_rows / MIN_PARALLEL_SORT_CHUNK_LEN)
+}
+
+/// Returns whether both [`sort_to_indices`] and the row format support `data_type`.
+fn supports_parallel_sort(data_type: &DataType) -> bool {
+    match data_type {
+        DataType::Boolean
+        | DataType::Int8
+        | DataType::Int16
+        | DataType::Int32
+        | DataType::Int64
+        | DataType::UInt8
+        | DataType::UInt16
+        | DataType::UInt32
+        | DataType::UInt64
+        | DataType::Float32
+        | DataType::Float64
+        | DataType::Date32
+        | DataType::Date64
+        | DataType::Time32(_)
+        | DataType::Time64(_)
+        | DataType::Timestamp(_, _)
+        | DataType::Interval(_)
+        | DataType::Duration(_)
+        | DataType::Utf8
+        | DataType::LargeUtf8 => RowConverter::supports(data_type),
+        DataType::Dictionary(_, value_type) => {
+            value_type.as_ref() == &DataType::Utf8 && RowConverter::supports(data_type)
+        }
+        _ => false,
+    }
+}
+
+/// Orders the indices `a` and `b` of equal rows, by descending index if
+/// `tie_column` is set and null at `a`, and by ascending index otherwise.
+#[inline]
+fn cmp_ties(tie_column: Option<&ArrayRef>, a: u32, b: u32) -> Ordering {
+    match tie_column {
+        Some(column) if column.is_null(a as usize) => b.cmp(&a),
+        _ => a.cmp(&b),
+    }
+}
+
+/// The rows of the chunks of the sorted columns, each of `chunk_len` rows except
+/// for the last.
+struct ChunkedRows {
+    chunks: Vec<Rows>,
+    chunk_len: usize,
+    tie_column: Option<ArrayRef>,
+}
+
+impl ChunkedRows {
+    #[inline]
+    fn row(&self, i: u32) -> &[u8] {
+        let i = i as usize;
+        self.chunks[i / self.chunk_len].row(i % self.chunk_len)
+    }
+
+    #[inline]
+    fn cmp(&self, a: u32, b: u32) -> Ordering {
+        self.row(a)
+            .cmp(self.row(b))
+            .then_with(|| cmp_ties(self.tie_column.as_ref(), a, b))
+    }
+
+    /// Merges the sorted indices `left` and `right` into the first `limit` sorted
+    /// indices.
+    fn merge(&self, left: &[u32], right: &[u32], limit: usize) -> Vec<u32> {
+        let len = limit.min(left.len() + right.len());
+        let mut merged = Vec::with_capacity(len);
+        let (mut l, mut r) = (0, 0);
+        while merged.len() < len {
+            if r == right.len()
+                || (l < left.len() && self.cmp(left[l], right[r]) == Ordering::Less)
+            {
+                merged.push(left[l]);
+                l += 1;
+            } else {
+                merged.push(right[r]);
+                r += 1;
+            }
+        }
+        merged
+    }
+}
+
+/// Joins the sort threads of `handles`, returning the result of each thread.
+fn join_sort_threads<T>(handles: Vec<thread::JoinHandle<Result<T>>>) -> Result<Vec<T>> {
+    handles
+        .into_iter()
+        .map(|handle| {
+            handle.join().unwrap_or_else(|_| {
+                Err(ArrowError::ComputeError(
+                    "A sort thread panicked".to_string(),
+                ))
+            })
+        })
+        .collect()
+}
+
+/// Sorts the rows of `columns` in `num_threads` chunks on as many threads, then
+/// merges the sorted chunks pairwise until a single run of indices is left.
+fn parallel_sort(
+    columns: Vec<ArrayRef>,
+    fields: Vec<SortField>,
+    tie_column: Option<ArrayRef>,
+    limit: Option<usize>,
+    num_threads: usize,
+) -> Result<UInt32Array> {
+    let num_rows = columns[0].len();
+    let len = limit.map(|limit| limit.min(num_rows)).unwrap_or(num_rows);
+    let chunk_len = (num_rows + num_threads - 1) / num_threads;
+
+    let handles = (0..num_rows)
+        .step_by(chunk_len)
+        .map(|offset| {
+            let length = chunk_len.min(num_rows - offset);
+            let chunk = columns
+                .iter()
+                .map(|column| column.slice(offset, length))
+                .collect::<Vec<_>>();
+            let fields = fields.clone();
+            let tie_column = tie_column.clone();
+            thread::spawn(move || -> Result<(Rows, Vec<u32>)> {
+                let rows = RowConverter::try_new(fields)?.convert_columns(&chunk)?;
+                let offset = offset as u32;
+                let chunk_limit = len.min(length);
+                let mut indices = (0..length as u32).collect::<Vec<u32>>();
+                sort_by(&mut indices, chunk_limit, |a, b| {
+                    rows.row(*a as usize)
+                        .cmp(rows.row(*b as usize))
+                        .then_with(|| {
+                            cmp_ties(tie_column.as_ref(), offset + *a, offset + *b)
+                        })
+                });
+                indices.truncate(chunk_limit);
+                indices.iter_mut().for_each(|i| *i += offset);
+                Ok((rows, indices))
+            })
+        })
+        .collect::<Vec<_>>();
+
+    let (chunks, mut runs): (Vec<Rows>, Vec<Vec<u32>>) =
+        join_sort_threads(handles)?.into_iter().unzip();
+    let rows = Arc::new(ChunkedRows {
+        chunks,
+        chunk_len,
+        tie_column,
+    });
+
+    while runs.len() > 1 {
+        let mut pending = runs.into_iter();
+        let mut handles = vec![];
+        while let Some(left) = pending.next() {
+            let rows = rows.clone();
+            let right = pending.next();
+            handles.push(thread::spawn(move || -> Result<Vec<u32>> {
+                Ok(match right {
+                    Some(right) => rows.merge(&left, &right, len),
+                    None => left,
+                })
+            }));
+        }
+        runs = join_sort_threads(handles)?;
+    }
+
+    Ok(UInt32Array::from(runs.pop().unwrap_or_default()))
+}
+
 /// It's unstable_sort, may not preserve the order of equal elements
 pub fn partial_sort<T, F>(v: &mut [T], limit: usize, mut is_less: F)
 where
@@ -2258,4 +2562,90 @@ mod tests {
         partial_sort(&mut before, last, |a, b| a.cmp(b));
         assert_eq!(&d[0..last], &before[0..last]);
     }
+
+    fn test_sort_to_indices_parallel_array(array: ArrayRef) {
+        for descending in [false, true].iter() {
+            for nulls_first in [false, true].iter() {
+                let options = Some(SortOptions {
+                    descending: *descending,
+                    nulls_first: *nulls_first,
+                });
+                let expected = sort_to_indices(&array, options, None).unwrap();
+                let actual = sort_to_indices_parallel(&array, options, None, 4).unwrap();
+                assert_eq!(actual, expected);
+
+                let limit = 1000.min(array.len());
+                let actual =
+                    sort_to_indices_parallel(&array, options, Some(limit), 4).unwrap();
+                assert_eq!(actual.values(), &expected.values()[0..limit]);
+            }
+        }
+    }
+
+    /// Returns `len` values chosen from `values`, of which about a tenth are null
+    fn random_nullable<T: Copy>(
+        rng: &mut StdRng,
+        len: usize,
+        values: &[T],
+    ) -> Vec<Option<T>> {
+        (0..len)
+            .map(|_| {
+                let value = values[rng.gen_range(0, values.len())];
+                Some(value).filter(|_| rng.gen_bool(0.9))
+            })
+            .collect()
+    }
+
+    #[test]
+    fn test_sort_to_indices_parallel() {
+        let len = 4 * MIN_PARALLEL_SORT_CHUNK_LEN + 123;
+        let mut rng = StdRng::seed_from_u64(42);
+
+        let ints = (-100..100).collect::<Vec<i32>>();
+        let array = Int32Array::from(random_nullable(&mut rng, len, &ints));
+        test_sort_to_indices_parallel_array(Arc::new(array));
+
+        let floats = [0.0, -0.0, 1.5, -1.5, std::f64::NAN, std::f64::INFINITY];
+        let array = Float64Array::from(random_nullable(&mut rng, len, &floats));
+        test_sort_to_indices_parallel_array(Arc::new(array));
+
+        let strings = ["", "a", "ab", "b", "hello world"];
+        let array = random_nullable(&mut rng, len, &strings);
+        test_sort_to_indices_parallel_array(Arc::new(StringArray::from(array.clone())));
+        test_sort_to_indices_parallel_array(Arc::new(
+            array.into_iter().collect::<DictionaryArray<Int16Type>>(),
+        ));
+
+        // too short to be split
+        let array = Int32Array::from(vec![Some(2), None, Some(1), Some(2), None]);
+        test_sort_to_indices_parallel_array(Arc::new(array));
+    }
+
+    #[test]
+    fn test_lexsort_to_indices_parallel() {
+        let len = 3 * MIN_PARALLEL_SORT_CHUNK_LEN + 7;
+        let mut rng = StdRng::seed_from_u64(42);
+        let ints = Int64Array::from(random_nullable(&mut rng, len, &[0i64, 1, 2, 3, 4]));
+        let strings = StringArray::from(random_nullable(&mut rng, len, &["x", "y", "z"]));
+        let columns = vec![
+            SortColumn {
+                values: Arc::new(ints),
+                options: Some(SortOptions {
+                    descending: true,
+                    nulls_first: false,
+                }),
+            },
+            SortColumn {
+                values: Arc::new(strings),
+                options: None,
+            },
+        ];
+
+        let expected = lexsort_to_indices(&columns, None).unwrap();
+        let actual = lexsort_to_indices_parallel(&columns, None, 8).unwrap();
+        assert_eq!(actual, expected);
+
+        let actual = lexsort_to_indices_parallel(&columns, Some(100), 8).unwrap();
+        assert_eq!(actual.values(), &expected.values()[0..100]);
+    }
 }
@@ -25,9 +25,13 @@ pub use self::kernels::aggregate::*;
 pub use self::kernels::arithmetic::*;
 pub use self::kernels::boolean::*;
 pub use self::kernels::cast::*;
+pub use self::kernels::coalesce::*;
 pub use self::kernels::comparison::*;
 pub use self::kernels::concat::*;
 pub use self::kernels::filter::*;
+pub use self::kernels::group_by::*;
+pub use self::kernels::hash::*;
+pub use self::kernels::join::*;
 pub use self::kernels::limit::*;
 pub use self::kernels::regexp::*;
 pub use self::kernels::sort::*;
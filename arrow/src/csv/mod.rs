@@ -21,6 +21,7 @@ pub mod reader;
 pub mod writer;
 
 pub use self::reader::infer_schema_from_files;
+pub use self::reader::ParallelReader;
 pub use self::reader::Reader;
 pub use self::reader::ReaderBuilder;
 pub use self::writer::Writer;
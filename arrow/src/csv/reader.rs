@@ -43,17 +43,19 @@
 use core::cmp::min;
 use lazy_static::lazy_static;
 use regex::{Regex, RegexBuilder};
-use std::collections::HashSet;
+use std::collections::{HashSet, VecDeque};
 use std::fmt;
 use std::fs::File;
 use std::io::{Read, Seek, SeekFrom};
-use std::sync::Arc;
+use std::sync::{mpsc, Arc, Mutex};
+use std::thread;
 
 use csv as csv_crate;
 
 use crate::array::{
     ArrayRef, BooleanArray, DictionaryArray, PrimitiveArray, StringArray,
 };
+use crate::compute::kernels::cast_utils::{string_to_date, string_to_datetime};
 use crate::datatypes::*;
 use crate::error::{ArrowError, Result};
 use crate::record_batch::RecordBatch;
@@ -412,6 +414,315 @@ impl<R: Read> Iterator for Reader<R> {
     }
 }
 
+/// The number of bytes a [`ParallelReader`] reads from its input at a time.
+const PARALLEL_READ_SIZE: usize = 1 << 20;
+
+/// A job run by the worker threads of a [`ParallelReader`].
+type Job = Box<dyn FnOnce() + Send>;
+
+/// CSV file reader which parses batches of records on multiple threads.
+///
+/// The input is read on the calling thread and split after every `batch_size`
+/// lines. Each range of lines is parsed into a [`RecordBatch`] by one of the worker
+/// threads, while the following ranges are read and parsed by the others, and the
+/// record batches are returned in the order of the input.
+///
+/// As the input is split at line boundaries, values must not contain newlines, even
+/// if quoted. Create it with [`ReaderBuilder::build_parallel`].
+pub struct ParallelReader<R: Read> {
+    /// Explicit schema for the CSV file
+    schema: SchemaRef,
+    /// Optional projection for which columns to load (zero-based column indices)
+    projection: Option<Arc<Vec<usize>>>,
+    /// File reader
+    reader: R,
+    /// Column delimiter
+    delimiter: u8,
+    /// Number of lines per batch
+    batch_size: usize,
+    /// Whether the header line has yet to be skipped
+    skip_header: bool,
+    /// Bytes read from `reader`, of which those from `offset` are not parsed yet
+    buffer: Vec<u8>,
+    offset: usize,
+    /// Whether `reader` has been read until its end, or failed
+    exhausted: bool,
+    /// The error of `reader`, if any
+    error: Option<ArrowError>,
+    /// Current line number
+    line_number: usize,
+    /// The results of the batches being parsed, in order
+    pending: VecDeque<mpsc::Receiver<Result<RecordBatch>>>,
+    /// The maximum number of batches being parsed at any time
+    max_pending: usize,
+    /// Sends jobs to the workers, until dropped
+    jobs: Option<mpsc::Sender<Job>>,
+    workers: Vec<thread::JoinHandle<()>>,
+}
+
+impl<R> fmt::Debug for ParallelReader<R>
+where
+    R: Read,
+{
+    fn fmt(&self, f: &mut fmt::Formatter<'_>) -> fmt::Result {
+        f.debug_struct("ParallelReader")
+            .field("schema", &self.schema)
+            .field("projection", &self.projection)
+            .field("line_number", &self.line_number)
+            .field("num_threads", &self.workers.len())
+            .finish()
+    }
+}
+
+impl<R: Read> ParallelReader<R> {
+    /// Create a new ParallelReader from any value that implements the `Read` trait,
+    /// parsing records on `num_threads` worker threads.
+    pub fn new(
+        reader: R,
+        schema: SchemaRef,
+        has_header: bool,
+        delimiter: Option<u8>,
+        batch_size: usize,
+        projection: Option<Vec<usize>>,
+        num_threads: usize,
+    ) -> Self {
+        let num_threads = num_threads.max(1);
+        let (jobs, receiver) = mpsc::channel::<Job>();
+        let receiver = Arc::new(Mutex::new(receiver));
+        let workers = (0..num_threads)
+            .map(|_| {
+                let receiver = receiver.clone();
+                thread::spawn(move || loop {
+                    let job = receiver.lock().unwrap().recv();
+                    match job {
+                        Ok(job) => job(),
+                        // the reader was dropped
+                        Err(_) => break,
+                    }
+                })
+            })
+            .collect();
+
+        Self {
+            schema,
+            projection: projection.map(Arc::new),
+            reader,
+            delimiter: delimiter.unwrap_or(b','),
+            batch_size: batch_size.max(1),
+            skip_header: has_header,
+            buffer: Vec::new(),
+            offset: 0,
+            exhausted: false,
+            error: None,
+            line_number: if has_header { 1 } else { 0 },
+            pending: VecDeque::new(),
+            max_pending: 2 * num_threads,
+            jobs: Some(jobs),
+            workers,
+        }
+    }
+
+    /// Returns the schema of the reader, useful for getting the schema without reading
+    /// record batches
+    pub fn schema(&self) -> SchemaRef {
+        match &self.projection {
+            Some(projection) => {
+                let fields = self.schema.fields();
+                let projected_fields: Vec<Field> =
+                    projection.iter().map(|i| fields[*i].clone()).collect();
+
+                Arc::new(Schema::new(projected_fields))
+            }
+            None => self.schema.clone(),
+        }
+    }
+
+    /// Returns the next `num_lines` lines of the input and their number, which is
+    /// smaller only at the end of the input, or `None` if there are no lines left.
+    ///
+    /// Blank lines are returned with the other lines but not counted, as they have no
+    /// records, so that batches have the rows of those of [`Reader`].
+    fn next_lines(&mut self, num_lines: usize) -> Result<Option<(Vec<u8>, usize)>> {
+        let mut lines = 0;
+        // the start of the current line, and the end of the bytes searched for its end
+        let mut start = self.offset;
+        let mut end = self.offset;
+        loop {
+            while let Some(pos) =
+                self.buffer[end..].iter().position(|byte| *byte == b'\n')
+            {
+                end += pos + 1;
+                if !is_blank_line(&self.buffer[start..end - 1]) {
+                    lines += 1;
+                }
+                start = end;
+                if lines == num_lines {
+                    let data = self.buffer[self.offset..end].to_vec();
+                    self.offset = end;
+                    return Ok(Some((data, lines)));
+                }
+            }
+            end = self.buffer.len();
+
+            if self.exhausted {
+                if self.offset == end {
+                    return Ok(None);
+                }
+                // the last line may not end with a newline
+                if !is_blank_line(&self.buffer[start..]) {
+                    lines += 1;
+                }
+                let data = self.buffer[self.offset..].to_vec();
+                self.offset = end;
+                return Ok(Some((data, lines)));
+            }
+
+            // drop the lines already returned before reading more
+            self.buffer.drain(..self.offset);
+            start -= self.offset;
+            end -= self.offset;
+            self.offset = 0;
+
+            let len = self.buffer.len();
+            self.buffer.resize(len + PARALLEL_READ_SIZE, 0);
+            let read = loop {
+                match self.reader.read(&mut self.buffer[len..]) {
+                    Err(e) if e.kind() == std::io::ErrorKind::Interrupted => continue,
+                    read => break read,
+                }
+            };
+            match read {
+                Ok(read) => {
+                    self.buffer.truncate(len + read);
+                    self.exhausted = read == 0;
+                }
+                Err(e) => {
+                    self.buffer.truncate(len);
+                    self.exhausted = true;
+                    return Err(e.into());
+                }
+            }
+        }
+    }
+
+    /// Sends the next batches of lines to the workers, until `max_pending` batches
+    /// are being parsed or the input is exhausted.
+    fn fill(&mut self) {
+        while self.pending.len() < self.max_pending && self.error.is_none() {
+            if self.skip_header {
+                self.skip_header = false;
+                if let Err(e) = self.next_lines(1) {
+                    self.error = Some(e);
+                    break;
+                }
+            }
+            let (data, lines) = match self.next_lines(self.batch_size) {
+                Ok(Some(next)) => next,
+                Ok(None) => break,
+                Err(e) => {
+                    self.error = Some(e);
+                    break;
+                }
+            };
+
+            let schema = self.schema.clone();
+            let projection = self.projection.clone();
+            let delimiter = self.delimiter;
+            let line_number = self.line_number;
+            let (sender, receiver) = mpsc::channel();
+            let job: Job = Box::new(move || {
+                let result = parse_lines(
+                    &data,
+                    &schema,
+                    projection.as_deref(),
+                    delimiter,
+                    line_number,
+                );
+                // the reader may have been dropped
+                let _ = sender.send(result);
+            });
+            self.jobs.as_ref().unwrap().send(job).unwrap();
+            self.pending.push_back(receiver);
+            self.line_number += lines;
+        }
+    }
+}
+
+/// Returns whether `line`, without its newline, is blank, which the csv crate skips.
+fn is_blank_line(line: &[u8]) -> bool {
+    line.is_empty() || line == b"\r"
+}
+
+/// Parses the records of `data`, whose first line is `line_number`, into a
+/// [`RecordBatch`].
+fn parse_lines(
+    data: &[u8],
+    schema: &Schema,
+    projection: Option<&Vec<usize>>,
+    delimiter: u8,
+    line_number: usize,
+) -> Result<RecordBatch> {
+    let mut reader = csv_crate::ReaderBuilder::new()
+        .has_headers(false)
+        .delimiter(delimiter)
+        .from_reader(data);
+    let rows = reader
+        .records()
+        .enumerate()
+        .map(|(i, record)| {
+            record.map_err(|e| {
+                ArrowError::ParseError(format!(
+                    "Error parsing line {}: {:?}",
+                    line_number + i,
+                    e
+                ))
+            })
+        })
+        .collect::<Result<Vec<StringRecord>>>()?;
+
+    parse(
+        &rows,
+        schema.fields(),
+        Some(schema.metadata.clone()),
+        &projection.cloned(),
+        line_number,
+    )
+}
+
+impl<R: Read> Iterator for ParallelReader<R> {
+    type Item = Result<RecordBatch>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        loop {
+            self.fill();
+            let receiver = match self.pending.pop_front() {
+                Some(receiver) => receiver,
+                None => return self.error.take().map(Err),
+            };
+            match receiver.recv() {
+                // lines without records, such as blank lines
+                Ok(Ok(batch)) if batch.num_rows() == 0 => continue,
+                Ok(result) => return Some(result),
+                Err(_) => {
+                    return Some(Err(ArrowError::ParseError(
+                        "A CSV parsing thread panicked".to_string(),
+                    )))
+                }
+            }
+        }
+    }
+}
+
+impl<R: Read> Drop for ParallelReader<R> {
+    fn drop(&mut self) {
+        // stops the workers once they have run the pending jobs
+        self.jobs.take();
+        for worker in self.workers.drain(..) {
+            let _ = worker.join();
+        }
+    }
+}
+
 /// parses a slice of [csv_crate::StringRecord] into a [array::record_batch::RecordBatch].
 fn parse(
     rows: &[StringRecord],
@@ -590,7 +901,7 @@ impl Parser for Date32Type {
 
         match Self::DATA_TYPE {
             DataType::Date32 => {
-                let date = string.parse::<chrono::NaiveDate>().ok()?;
+                let date = string_to_date(string)?;
                 Self::Native::from_i32(date.num_days_from_ce() - EPOCH_DAYS_FROM_CE)
             }
             _ => None,
@@ -602,7 +913,7 @@ impl Parser for Date64Type {
     fn parse(string: &str) -> Option<i64> {
         match Self::DATA_TYPE {
             DataType::Date64 => {
-                let date_time = string.parse::<chrono::NaiveDateTime>().ok()?;
+                let date_time = string_to_datetime(string)?;
                 Self::Native::from_i64(date_time.timestamp_millis())
             }
             _ => None,
@@ -614,7 +925,7 @@ impl Parser for TimestampNanosecondType {
     fn parse(string: &str) -> Option<i64> {
         match Self::DATA_TYPE {
             DataType::Timestamp(TimeUnit::Nanosecond, None) => {
-                let date_time = string.parse::<chrono::NaiveDateTime>().ok()?;
+                let date_time = string_to_datetime(string)?;
                 Self::Native::from_i64(date_time.timestamp_nanos())
             }
             _ => None,
@@ -626,7 +937,7 @@ impl Parser for TimestampMicrosecondType {
     fn parse(string: &str) -> Option<i64> {
         match Self::DATA_TYPE {
             DataType::Timestamp(TimeUnit::Microsecond, None) => {
-                let date_time = string.parse::<chrono::NaiveDateTime>().ok()?;
+                let date_time = string_to_datetime(string)?;
                 Self::Native::from_i64(date_time.timestamp_nanos() / 1000)
             }
             _ => None,
@@ -852,6 +1163,40 @@ impl ReaderBuilder {
             self.projection.clone(),
         ))
     }
+
+    /// Create a new `ParallelReader` from the `ReaderBuilder`, which parses the
+    /// records on `num_threads` worker threads.
+    ///
+    /// Values of the input must not contain newlines, see [`ParallelReader`].
+    pub fn build_parallel<R: Read + Seek>(
+        self,
+        mut reader: R,
+        num_threads: usize,
+    ) -> Result<ParallelReader<R>> {
+        let delimiter = self.delimiter.unwrap_or(b',');
+        let schema = match self.schema {
+            Some(schema) => schema,
+            None => {
+                let (inferred_schema, _) = infer_file_schema(
+                    &mut reader,
+                    delimiter,
+                    self.max_records,
+                    self.has_header,
+                )?;
+
+                Arc::new(inferred_schema)
+            }
+        };
+        Ok(ParallelReader::new(
+            reader,
+            schema,
+            self.has_header,
+            self.delimiter,
+            self.batch_size,
+            self.projection,
+            num_threads,
+        ))
+    }
 }
 
 #[cfg(test)]
@@ -1041,6 +1386,99 @@ mod tests {
         assert_eq!("Aberdeen, Aberdeen City, UK", city.value(13));
     }
 
+    #[test]
+    fn test_csv_parallel() {
+        let read = |builder: ReaderBuilder, num_threads: Option<usize>| {
+            let file = File::open("test/data/uk_cities_with_headers.csv").unwrap();
+            let builder = builder.has_header(true).infer_schema(None);
+            let batches = match num_threads {
+                Some(num_threads) => builder
+                    .build_parallel(file, num_threads)
+                    .unwrap()
+                    .collect::<Result<Vec<_>>>(),
+                None => builder.build(file).unwrap().collect::<Result<Vec<_>>>(),
+            };
+            batches.unwrap()
+        };
+
+        for batch_size in [1, 5, 37, 1024].iter() {
+            let builder = || ReaderBuilder::new().with_batch_size(*batch_size);
+            let expected = read(builder(), None);
+            for num_threads in [1, 3].iter() {
+                let batches = read(builder(), Some(*num_threads));
+                assert_eq!(batches.len(), expected.len());
+                for (batch, expected) in batches.iter().zip(expected.iter()) {
+                    assert_eq!(batch.schema(), expected.schema());
+                    assert_eq!(batch.columns(), expected.columns());
+                }
+            }
+        }
+
+        let batches = read(ReaderBuilder::new().with_projection(vec![2, 0]), Some(2));
+        assert_eq!(batches[0].num_rows(), 37);
+        assert_eq!(batches[0].schema().field(0).name(), "lng");
+    }
+
+    #[test]
+    fn test_csv_parallel_blank_lines_and_errors() {
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("a", DataType::Int32, true),
+            Field::new("b", DataType::Utf8, true),
+        ]));
+        let data = "1,x\n2,y\n\n3,z\r\n4,w";
+        let reader = ParallelReader::new(
+            Cursor::new(data),
+            schema.clone(),
+            false,
+            None,
+            2,
+            None,
+            2,
+        );
+        let batches = reader.collect::<Result<Vec<_>>>().unwrap();
+        let values = batches
+            .iter()
+            .flat_map(|batch| {
+                let a = batch
+                    .column(0)
+                    .as_any()
+                    .downcast_ref::<Int32Array>()
+                    .unwrap();
+                a.iter().collect::<Vec<_>>()
+            })
+            .collect::<Vec<_>>();
+        assert_eq!(values, vec![Some(1), Some(2), Some(3), Some(4)]);
+
+        let data = "1,x\n2,y\nthree,z\n4,w\n";
+        let mut reader =
+            ParallelReader::new(Cursor::new(data), schema, false, None, 2, None, 2);
+        assert_eq!(reader.next().unwrap().unwrap().num_rows(), 2);
+        let err = reader.next().unwrap().unwrap_err();
+        assert!(err.to_string().contains("line 2"), "{}", err);
+    }
+
+    #[test]
+    fn test_csv_parallel_blank_lines_batch_size() {
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("a", DataType::Int32, true),
+            Field::new("b", DataType::Utf8, true),
+        ]));
+        let data = "a,b\n\n1,x\n\n2,y\n\r\n\n3,z\n4,w\n\n5,v\n\n";
+        let num_rows = |batches: Vec<RecordBatch>| {
+            batches.iter().map(|b| b.num_rows()).collect::<Vec<_>>()
+        };
+
+        let reader =
+            Reader::new(Cursor::new(data), schema.clone(), true, None, 2, None, None);
+        let expected = num_rows(reader.collect::<Result<Vec<_>>>().unwrap());
+        assert_eq!(expected, vec![2, 2, 1]);
+
+        let reader =
+            ParallelReader::new(Cursor::new(data), schema, true, None, 2, None, 2);
+        let batches = reader.collect::<Result<Vec<_>>>().unwrap();
+        assert_eq!(num_rows(batches), expected);
+    }
+
     #[test]
     fn test_csv_with_projection() {
         let schema = Schema::new(vec![
@@ -15,7 +15,8 @@
 // specific language governing permissions and limitations
 // under the License.
 
-//! Contains declarations to bind to the [C Data Interface](https://arrow.apache.org/docs/format/CDataInterface.html).
+//! Contains declarations to bind to the [C Data Interface](https://arrow.apache.org/docs/format/CDataInterface.html)
+//! and to the [C Stream Interface](https://arrow.apache.org/docs/format/CStreamInterface.html).
 //!
 //! Generally, this module is divided in two main interfaces:
 //! One interface maps C ABI to native Rust types, i.e. convert c-pointers, c_char, to native rust.
@@ -55,6 +56,45 @@
 //! Ok(())
 //! }
 //! ```
+//!
+//! A record batch is exchanged as a struct array of its columns, and a stream of
+//! record batches, such as a [RecordBatchReader], through a [FFI_ArrowArrayStream]:
+//! its schema is exported once and its batches are produced on demand, without
+//! copying their buffers.
+//!
+//! ```rust
+//! # use std::sync::Arc;
+//! # use arrow::array::{ArrayRef, Int32Array, StringArray};
+//! # use arrow::error::Result;
+//! # use arrow::ffi::{ArrowArrayStreamReader, FFI_ArrowArrayStream};
+//! # use arrow::record_batch::{RecordBatch, RecordBatchReader};
+//! # fn main() -> Result<()> {
+//! let batch = RecordBatch::try_from_iter(vec![
+//!     ("a", Arc::new(Int32Array::from(vec![1, 2, 3])) as ArrayRef),
+//!     ("b", Arc::new(StringArray::from(vec!["x", "y", "z"])) as ArrayRef),
+//! ])?;
+//! # struct Batches(Option<RecordBatch>);
+//! # impl Iterator for Batches {
+//! #     type Item = Result<RecordBatch>;
+//! #     fn next(&mut self) -> Option<Self::Item> { self.0.take().map(Ok) }
+//! # }
+//! # impl RecordBatchReader for Batches {
+//! #     fn schema(&self) -> arrow::datatypes::SchemaRef { self.0.as_ref().unwrap().schema() }
+//! # }
+//! // any `RecordBatchReader`, such as a CSV or an IPC reader
+//! let reader = Batches(Some(batch.clone()));
+//!
+//! // export it
+//! let stream = FFI_ArrowArrayStream::new(Box::new(reader));
+//!
+//! // (simulate consumer) import it
+//! let reader = ArrowArrayStreamReader::try_new(stream)?;
+//! assert_eq!(reader.schema(), batch.schema());
+//! let batches = reader.collect::<Result<Vec<_>>>()?;
+//! assert_eq!(batches[0].column(1), batch.column(1));
+//! # Ok(())
+//! # }
+//! ```
 
 /*
 # Design:
@@ -74,6 +114,14 @@ Each ABI-compatible `struct` knowns how to `drop` itself, calling `release`.
 
 To import an array, unsafely create an `ArrowArray` from two pointers using [ArrowArray::try_from_raw].
 To export an array, create an `ArrowArray` using [ArrowArray::try_new].
+
+The release callback of an exported struct also releases its children. An imported
+array moves its children out of it, as the C Data Interface allows, so that each child
+is released independently, when no buffer uses it anymore.
+
+An exported `FFI_ArrowArrayStream` owns its `RecordBatchReader`, and moves each batch
+into the struct array given by the consumer. `ArrowArrayStreamReader` imports the
+schema of a stream once and reuses it to import each of its batches.
 */
 
 use std::{
@@ -81,16 +129,17 @@ use std::{
     ffi::CStr,
     ffi::CString,
     iter,
-    mem::{size_of, ManuallyDrop},
-    os::raw::c_char,
+    mem::size_of,
+    os::raw::{c_char, c_int, c_void},
     ptr::{self, NonNull},
     sync::Arc,
 };
 
-use crate::array::ArrayData;
+use crate::array::{Array, ArrayData, StructArray};
 use crate::buffer::Buffer;
-use crate::datatypes::{DataType, Field, TimeUnit};
+use crate::datatypes::{DataType, Field, Schema, SchemaRef, TimeUnit};
 use crate::error::{ArrowError, Result};
+use crate::record_batch::{RecordBatch, RecordBatchReader};
 use crate::util::bit_util;
 
 /// ABI-compatible struct for `ArrowSchema` from C Data Interface
@@ -112,10 +161,19 @@ pub struct FFI_ArrowSchema {
 
 // callback used to drop [FFI_ArrowSchema] when it is exported.
 unsafe extern "C" fn release_schema(schema: *mut FFI_ArrowSchema) {
+    if schema.is_null() {
+        return;
+    }
     let schema = &mut *schema;
 
     // take ownership back to release it.
-    CString::from_raw(schema.format as *mut std::os::raw::c_char);
+    drop(CString::from_raw(schema.format as *mut c_char));
+    drop(CString::from_raw(schema.name as *mut c_char));
+    let private_data = Box::from_raw(schema.private_data as *mut SchemaPrivateData);
+    for child in private_data.children.iter() {
+        // dropping a child releases it, unless a consumer moved it out
+        drop(Box::from_raw(*child));
+    }
 
     schema.release = None;
 }
@@ -124,25 +182,58 @@ struct SchemaPrivateData {
     children: Box<[*mut FFI_ArrowSchema]>,
 }
 
+/// flag of [FFI_ArrowSchema] set when the field is nullable
+const NULLABLE_FLAG: i64 = 2;
+
 impl FFI_ArrowSchema {
+    /// create a new [FFI_ArrowSchema] of the field `name`, of type `data_type`,
+    /// including the schemas of its children.
+    fn try_new(name: &str, data_type: &DataType, nullable: bool) -> Result<Self> {
+        let format = from_datatype(data_type)?;
+        let children = match data_type {
+            DataType::List(field) | DataType::LargeList(field) => {
+                vec![Self::try_from_field(field)?]
+            }
+            DataType::Struct(fields) => fields
+                .iter()
+                .map(Self::try_from_field)
+                .collect::<Result<_>>()?,
+            _ => vec![],
+        };
+        let name = CString::new(name).map_err(|_| {
+            ArrowError::CDataInterface(format!(
+                "The field name \"{}\" contains a nul character",
+                name
+            ))
+        })?;
+        Ok(Self::new(&format, name, children, nullable))
+    }
+
+    fn try_from_field(field: &Field) -> Result<Self> {
+        Self::try_new(field.name(), field.data_type(), field.is_nullable())
+    }
+
     /// create a new [FFI_ArrowSchema] from a format.
     fn new(
         format: &str,
-        children: Vec<*mut FFI_ArrowSchema>,
+        name: CString,
+        children: Vec<FFI_ArrowSchema>,
         nullable: bool,
     ) -> FFI_ArrowSchema {
-        let children = children.into_boxed_slice();
+        let children = children
+            .into_iter()
+            .map(|child| Box::into_raw(Box::new(child)))
+            .collect::<Box<[_]>>();
         let n_children = children.len() as i64;
         let children_ptr = children.as_ptr() as *mut *mut FFI_ArrowSchema;
 
-        let flags = if nullable { 2 } else { 0 };
+        let flags = if nullable { NULLABLE_FLAG } else { 0 };
 
         let private_data = Box::new(SchemaPrivateData { children });
         // <https://arrow.apache.org/docs/format/CDataInterface.html#c.ArrowSchema>
         FFI_ArrowSchema {
             format: CString::new(format).unwrap().into_raw(),
-            // For child data a non null string is expected and is called item
-            name: CString::new("item").unwrap().into_raw(),
+            name: name.into_raw(),
             metadata: std::ptr::null_mut(),
             flags,
             n_children,
@@ -174,6 +265,29 @@ impl FFI_ArrowSchema {
             .to_str()
             .expect("The external API has a non-utf8 as format")
     }
+
+    /// returns the name of this schema, which is empty if it has none.
+    pub fn name(&self) -> &str {
+        if self.name.is_null() {
+            return "";
+        }
+        unsafe { CStr::from_ptr(self.name) }
+            .to_str()
+            .expect("The external API has a non-utf8 as name")
+    }
+
+    /// whether the field of this schema is nullable.
+    pub fn nullable(&self) -> bool {
+        self.flags & NULLABLE_FLAG != 0
+    }
+
+    /// returns the schema of the child `i`.
+    /// # Panic
+    /// This function panics if `i` is larger or equal to `n_children`.
+    fn child(&self, i: usize) -> &FFI_ArrowSchema {
+        assert!(i < self.n_children as usize);
+        unsafe { &**self.children.add(i) }
+    }
 }
 
 impl Drop for FFI_ArrowSchema {
@@ -217,41 +331,13 @@ fn to_datatype(
         "ttu" => DataType::Time64(TimeUnit::Microsecond),
         "ttn" => DataType::Time64(TimeUnit::Nanosecond),
 
-        // Note: The datatype null will only be created when called from ArrowArray::buffer_len
-        // at that point the child data is not yet known, but it is also not required to determine
-        // the buffer length of the list arrays.
-        "+l" => {
-            let nullable = schema.flags == 2;
-            // Safety
-            // Should be set as this is expected from the C FFI definition
-            debug_assert!(!schema.name.is_null());
-            let name = unsafe { CString::from_raw(schema.name as *mut c_char) }
-                .into_string()
-                .unwrap();
-            // prevent a double free
-            let name = ManuallyDrop::new(name);
-            DataType::List(Box::new(Field::new(
-                &name,
-                child_type.unwrap_or(DataType::Null),
-                nullable,
-            )))
-        }
-        "+L" => {
-            let nullable = schema.flags == 2;
-            // Safety
-            // Should be set as this is expected from the C FFI definition
-            debug_assert!(!schema.name.is_null());
-            let name = unsafe { CString::from_raw(schema.name as *mut c_char) }
-                .into_string()
-                .unwrap();
-            // prevent a double free
-            let name = ManuallyDrop::new(name);
-            DataType::LargeList(Box::new(Field::new(
-                &name,
-                child_type.unwrap_or(DataType::Null),
-                nullable,
-            )))
-        }
+        "+l" => DataType::List(Box::new(list_field(child_type, schema)?)),
+        "+L" => DataType::LargeList(Box::new(list_field(child_type, schema)?)),
+        "+s" => DataType::Struct(
+            (0..schema.n_children as usize)
+                .map(|i| to_field(schema.child(i)))
+                .collect::<Result<_>>()?,
+        ),
         dt => {
             return Err(ArrowError::CDataInterface(format!(
                 "The datatype \"{}\" is not supported in the Rust implementation",
@@ -261,6 +347,29 @@ fn to_datatype(
     })
 }
 
+/// maps the schema of a field to a [Field](arrow::datatypes::Field).
+fn to_field(schema: &FFI_ArrowSchema) -> Result<Field> {
+    let data_type = to_datatype(schema.format(), None, schema)?;
+    Ok(Field::new(schema.name(), data_type, schema.nullable()))
+}
+
+/// maps the child of the schema of a list to the field of its values, which has the
+/// type `child_type` when it is known from the child data.
+fn list_field(child_type: Option<DataType>, schema: &FFI_ArrowSchema) -> Result<Field> {
+    if schema.n_children != 1 {
+        return Err(ArrowError::CDataInterface(format!(
+            "A list is expected to have one child, but it has {}",
+            schema.n_children
+        )));
+    }
+    let child = schema.child(0);
+    let data_type = match child_type {
+        Some(data_type) => data_type,
+        None => to_datatype(child.format(), None, child)?,
+    };
+    Ok(Field::new(child.name(), data_type, child.nullable()))
+}
+
 /// the inverse of [to_datatype]
 fn from_datatype(datatype: &DataType) -> Result<String> {
     Ok(match datatype {
@@ -289,6 +398,7 @@ fn from_datatype(datatype: &DataType) -> Result<String> {
         DataType::Time64(TimeUnit::Nanosecond) => "ttn",
         DataType::List(_) => "+l",
         DataType::LargeList(_) => "+L",
+        DataType::Struct(_) => "+s",
         z => {
             return Err(ArrowError::CDataInterface(format!(
                 "The datatype \"{:?}\" is still not supported in Rust implementation",
@@ -393,7 +503,11 @@ unsafe extern "C" fn release_array(array: *mut FFI_ArrowArray) {
     }
     let array = &mut *array;
     // take ownership of `private_data`, therefore dropping it
-    Box::from_raw(array.private_data as *mut PrivateData);
+    let private_data = Box::from_raw(array.private_data as *mut PrivateData);
+    for child in private_data.children.iter() {
+        // dropping a child releases it, unless a consumer moved it out
+        drop(Arc::from_raw(*child));
+    }
 
     array.release = None;
 }
@@ -493,18 +607,23 @@ unsafe fn create_buffer(
     NonNull::new(ptr as *mut u8).map(|ptr| Buffer::from_unowned(ptr, len, array))
 }
 
+/// moves the children out of `array`, whose parent then does not release them.
+/// # Safety
+/// This function assumes that `array` and `schema` agree with the C data interface.
 unsafe fn create_child_arrays(
     array: Arc<FFI_ArrowArray>,
     schema: Arc<FFI_ArrowSchema>,
 ) -> Result<Vec<ArrayData>> {
     (0..array.n_children as usize)
         .map(|i| {
-            let arr_ptr = *array.children.add(i);
-            let schema_ptr = *schema.children.add(i);
-            let arrow_arr = ArrowArray::try_from_raw(
-                arr_ptr as *const FFI_ArrowArray,
-                schema_ptr as *const FFI_ArrowSchema,
-            )?;
+            let child = ptr::replace(*array.children.add(i), FFI_ArrowArray::empty());
+            // the schema of the parent keeps its children, which are exported again
+            let child_schema =
+                FFI_ArrowSchema::try_from_field(&to_field(schema.child(i))?)?;
+            let arrow_arr = ArrowArray {
+                array: Arc::new(child),
+                schema: Arc::new(child_schema),
+            };
             ArrayData::try_from(arrow_arr)
         })
         .collect()
@@ -547,6 +666,8 @@ pub struct ArrowArray {
 
 impl ArrowArray {
     /// creates a new `ArrowArray`. This is used to export to the C Data Interface.
+    /// The schemas of the children are those of the fields of `data_type`, and
+    /// `nullable` only applies to this array.
     /// # Safety
     /// See safety of [ArrowArray]
     #[allow(clippy::too_many_arguments)]
@@ -560,23 +681,19 @@ impl ArrowArray {
         child_data: Vec<ArrowArray>,
         nullable: bool,
     ) -> Result<Self> {
-        let format = from_datatype(data_type)?;
+        // For child data a non null string is expected and is called item
+        let schema = Arc::new(FFI_ArrowSchema::try_new("item", data_type, nullable)?);
         // * insert the null buffer at the start
         // * make all others `Option<Buffer>`.
         let new_buffers = iter::once(null_buffer)
             .chain(buffers.iter().map(|b| Some(b.clone())))
             .collect::<Vec<_>>();
 
-        let mut ffi_arrow_arrays = Vec::with_capacity(child_data.len());
-        let mut ffi_arrow_schemas = Vec::with_capacity(child_data.len());
+        let ffi_arrow_arrays = child_data
+            .into_iter()
+            .map(|arrow_arr| Arc::into_raw(arrow_arr.array) as *mut FFI_ArrowArray)
+            .collect();
 
-        child_data.into_iter().for_each(|arrow_arr| {
-            let (arr, schema) = ArrowArray::into_raw(arrow_arr);
-            ffi_arrow_arrays.push(arr as *mut FFI_ArrowArray);
-            ffi_arrow_schemas.push(schema as *mut FFI_ArrowSchema);
-        });
-
-        let schema = Arc::new(FFI_ArrowSchema::new(&format, ffi_arrow_schemas, nullable));
         let array = Arc::new(FFI_ArrowArray::new(
             len as i64,
             null_count as i64,
@@ -624,12 +741,19 @@ impl ArrowArray {
         (Arc::into_raw(this.array), Arc::into_raw(this.schema))
     }
 
+    /// returns the exported [FFI_ArrowArray], to move it to a consumer.
+    /// # Panic
+    /// This function panics if the [FFI_ArrowArray] is shared, i.e. if it was imported.
+    fn into_ffi_array(self) -> FFI_ArrowArray {
+        Arc::try_unwrap(self.array).expect("An exported array is not shared")
+    }
+
     /// returns the null bit buffer.
     /// Rust implementation uses a buffer that is not part of the array of buffers.
     /// The C Data interface's null buffer is part of the array of buffers.
     pub fn null_bit_buffer(&self) -> Option<Buffer> {
         // similar to `self.buffer_len(0)`, but without `Result`.
-        let buffer_len = bit_util::ceil(self.array.length as usize, 8);
+        let buffer_len = bit_util::ceil(self.len() + self.offset(), 8);
 
         unsafe { create_buffer(self.array.clone(), 0, buffer_len) }
     }
@@ -649,10 +773,10 @@ impl ArrowArray {
             | (DataType::LargeBinary, 1)
             | (DataType::List(_), 1)
             | (DataType::LargeList(_), 1) => {
-                // the len of the offset buffer (buffer 1) equals length + 1
+                // the len of the offset buffer (buffer 1) equals offset + length + 1
                 let bits = bit_width(data_type, i)?;
                 debug_assert_eq!(bits % 8, 0);
-                (self.array.length as usize + 1) * (bits / 8)
+                (self.offset() + self.len() + 1) * (bits / 8)
             }
             (DataType::Utf8, 2) | (DataType::Binary, 2) | (DataType::List(_), 2) => {
                 // the len of the data buffer (buffer 2) equals the last value of the offset buffer (buffer 1)
@@ -683,7 +807,7 @@ impl ArrowArray {
             // buffer len of primitive types
             _ => {
                 let bits = bit_width(data_type, i)?;
-                bit_util::ceil(self.array.length as usize * bits, 8)
+                bit_util::ceil((self.offset() + self.len()) * bits, 8)
             }
         })
     }
@@ -709,8 +833,15 @@ impl ArrowArray {
             .collect()
     }
 
-    /// returns the child data of this array
-    pub fn children(&self) -> Result<Vec<ArrayData>> {
+    /// returns the child data of this array. The children are moved out of this array,
+    /// so that they are released independently of it, which is why this consumes it.
+    pub fn children(self) -> Result<Vec<ArrayData>> {
+        self.move_children()
+    }
+
+    /// moves the children out of this array, which must be done only once, such as by
+    /// [ArrowArray::children] or the conversion into [ArrayData].
+    pub(crate) fn move_children(&self) -> Result<Vec<ArrayData>> {
         unsafe { create_child_arrays(self.array.clone(), self.schema.clone()) }
     }
 
@@ -740,16 +871,303 @@ impl ArrowArray {
     }
 }
 
+/// ABI-compatible struct for `ArrowArrayStream` from C Stream Interface
+/// See <https://arrow.apache.org/docs/format/CStreamInterface.html#structure-definitions>
+#[repr(C)]
+#[derive(Debug)]
+pub struct FFI_ArrowArrayStream {
+    get_schema: Option<
+        unsafe extern "C" fn(
+            arg1: *mut FFI_ArrowArrayStream,
+            out: *mut FFI_ArrowSchema,
+        ) -> c_int,
+    >,
+    get_next: Option<
+        unsafe extern "C" fn(
+            arg1: *mut FFI_ArrowArrayStream,
+            out: *mut FFI_ArrowArray,
+        ) -> c_int,
+    >,
+    get_last_error:
+        Option<unsafe extern "C" fn(arg1: *mut FFI_ArrowArrayStream) -> *const c_char>,
+    release: Option<unsafe extern "C" fn(arg1: *mut FFI_ArrowArrayStream)>,
+    private_data: *mut c_void,
+}
+
+// error codes returned by the callbacks of [FFI_ArrowArrayStream], which are `errno`
+// values, as in the C Stream Interface
+const EIO: c_int = 5;
+const ENOMEM: c_int = 12;
+const EINVAL: c_int = 22;
+
+struct StreamPrivateData {
+    reader: Box<dyn RecordBatchReader + Send>,
+    last_error: Option<CString>,
+}
+
+impl StreamPrivateData {
+    /// keeps the message of `error` for `get_last_error`, and returns its error code.
+    fn set_error(&mut self, error: ArrowError) -> c_int {
+        let code = match error {
+            ArrowError::IoError(_) => EIO,
+            ArrowError::MemoryError(_) => ENOMEM,
+            _ => EINVAL,
+        };
+        self.last_error = CString::new(error.to_string()).ok();
+        code
+    }
+}
+
+// callback used to get the schema of an exported [FFI_ArrowArrayStream], which is the
+// schema of a struct array of its columns.
+unsafe extern "C" fn get_stream_schema(
+    stream: *mut FFI_ArrowArrayStream,
+    out: *mut FFI_ArrowSchema,
+) -> c_int {
+    let private_data = &mut *((*stream).private_data as *mut StreamPrivateData);
+    let schema = private_data.reader.schema();
+    let data_type = DataType::Struct(schema.fields().clone());
+    match FFI_ArrowSchema::try_new("", &data_type, false) {
+        Ok(schema) => {
+            // `out` is not initialized: it must not be dropped
+            ptr::write(out, schema);
+            0
+        }
+        Err(error) => private_data.set_error(error),
+    }
+}
+
+// callback used to get the next batch of an exported [FFI_ArrowArrayStream], as a
+// struct array of its columns, or a released array at the end of the stream.
+unsafe extern "C" fn get_stream_next(
+    stream: *mut FFI_ArrowArrayStream,
+    out: *mut FFI_ArrowArray,
+) -> c_int {
+    let private_data = &mut *((*stream).private_data as *mut StreamPrivateData);
+    let array = match private_data.reader.next() {
+        None => Ok(FFI_ArrowArray::empty()),
+        Some(batch) => batch.and_then(|batch| {
+            let data = StructArray::from(batch).data().clone();
+            ArrowArray::try_from(data).map(ArrowArray::into_ffi_array)
+        }),
+    };
+    match array {
+        Ok(array) => {
+            // `out` is not initialized: it must not be dropped
+            ptr::write(out, array);
+            0
+        }
+        Err(error) => private_data.set_error(error),
+    }
+}
+
+// callback used to get the message of the last error of an exported
+// [FFI_ArrowArrayStream]
+unsafe extern "C" fn get_stream_last_error(
+    stream: *mut FFI_ArrowArrayStream,
+) -> *const c_char {
+    let private_data = &*((*stream).private_data as *const StreamPrivateData);
+    match &private_data.last_error {
+        Some(message) => message.as_ptr(),
+        None => ptr::null(),
+    }
+}
+
+// callback used to drop [FFI_ArrowArrayStream] when it is exported
+unsafe extern "C" fn release_stream(stream: *mut FFI_ArrowArrayStream) {
+    if stream.is_null() {
+        return;
+    }
+    let stream = &mut *stream;
+    // take ownership of `private_data`, therefore dropping the reader
+    drop(Box::from_raw(stream.private_data as *mut StreamPrivateData));
+
+    stream.release = None;
+}
+
+impl FFI_ArrowArrayStream {
+    /// creates a new [FFI_ArrowArrayStream] of the batches of `reader`. This is used to
+    /// export a stream to the C Stream Interface. Its consumer reads the batches, in
+    /// the thread of its choice, and releases the stream, which drops `reader`.
+    pub fn new(reader: Box<dyn RecordBatchReader + Send>) -> Self {
+        let private_data = Box::new(StreamPrivateData {
+            reader,
+            last_error: None,
+        });
+        Self {
+            get_schema: Some(get_stream_schema),
+            get_next: Some(get_stream_next),
+            get_last_error: Some(get_stream_last_error),
+            release: Some(release_stream),
+            private_data: Box::into_raw(private_data) as *mut c_void,
+        }
+    }
+
+    /// creates an empty [FFI_ArrowArrayStream], which can be used to import a stream
+    /// into.
+    pub fn empty() -> Self {
+        Self {
+            get_schema: None,
+            get_next: None,
+            get_last_error: None,
+            release: None,
+            private_data: ptr::null_mut(),
+        }
+    }
+}
+
+impl Drop for FFI_ArrowArrayStream {
+    fn drop(&mut self) {
+        match self.release {
+            None => (),
+            Some(release) => unsafe { release(self) },
+        };
+    }
+}
+
+/// exports the batches of `reader` to the C Stream Interface, into the stream `out`
+/// allocated by the consumer.
+/// # Safety
+/// `out` must be valid for writes, and whatever it holds is overwritten without being
+/// released.
+pub unsafe fn export_reader_into_raw(
+    reader: Box<dyn RecordBatchReader + Send>,
+    out: *mut FFI_ArrowArrayStream,
+) {
+    ptr::write(out, FFI_ArrowArrayStream::new(reader))
+}
+
+/// A [RecordBatchReader] of the batches of a stream imported from the C Stream
+/// Interface. The batches share the buffers exported by the producer, and the stream
+/// is released when this reader is dropped.
+#[derive(Debug)]
+pub struct ArrowArrayStreamReader {
+    stream: FFI_ArrowArrayStream,
+    // the schema of the struct arrays of the stream, used to import each of them
+    ffi_schema: Arc<FFI_ArrowSchema>,
+    schema: SchemaRef,
+}
+
+impl ArrowArrayStreamReader {
+    /// creates a new [ArrowArrayStreamReader] of the batches of `stream`, importing
+    /// its schema. Used to import from the C Stream Interface.
+    /// # Error
+    /// Errors if `stream` is released, or if its schema is not a struct of supported
+    /// data types.
+    pub fn try_new(mut stream: FFI_ArrowArrayStream) -> Result<Self> {
+        let get_schema = match (stream.release, stream.get_schema) {
+            (Some(_), Some(get_schema)) => get_schema,
+            _ => {
+                return Err(ArrowError::CDataInterface(
+                    "The stream to import is released".to_string(),
+                ))
+            }
+        };
+        let mut ffi_schema = FFI_ArrowSchema::empty();
+        let code = unsafe { get_schema(&mut stream, &mut ffi_schema) };
+        if code != 0 {
+            return Err(Self::stream_error(&mut stream, code));
+        }
+        if ffi_schema.release.is_none() {
+            return Err(ArrowError::CDataInterface(
+                "The stream returned a released schema".to_string(),
+            ));
+        }
+        let fields = match to_datatype(ffi_schema.format(), None, &ffi_schema)? {
+            DataType::Struct(fields) => fields,
+            data_type => {
+                return Err(ArrowError::CDataInterface(format!(
+                    "The schema of a stream is expected to be a struct, but it is {:?}",
+                    data_type
+                )))
+            }
+        };
+        Ok(Self {
+            stream,
+            ffi_schema: Arc::new(ffi_schema),
+            schema: Arc::new(Schema::new(fields)),
+        })
+    }
+
+    /// creates a new [ArrowArrayStreamReader] from a pointer to a stream, which is moved
+    /// into the reader and marked as released. Used to import from the C Stream
+    /// Interface.
+    /// # Safety
+    /// `stream` must point to a valid [FFI_ArrowArrayStream].
+    /// # Error
+    /// Errors if the pointer is null, or in the cases of [ArrowArrayStreamReader::try_new].
+    pub unsafe fn from_raw(stream: *mut FFI_ArrowArrayStream) -> Result<Self> {
+        if stream.is_null() {
+            return Err(ArrowError::MemoryError(
+                "The pointer passed to `from_raw` is null".to_string(),
+            ));
+        }
+        Self::try_new(ptr::replace(stream, FFI_ArrowArrayStream::empty()))
+    }
+
+    /// returns the error of the last call to `stream`, which returned `code`.
+    fn stream_error(stream: &mut FFI_ArrowArrayStream, code: c_int) -> ArrowError {
+        let message = match stream.get_last_error {
+            Some(get_last_error) => unsafe { get_last_error(stream) },
+            None => ptr::null(),
+        };
+        let message = if message.is_null() {
+            "no message".to_string()
+        } else {
+            unsafe { CStr::from_ptr(message) }
+                .to_string_lossy()
+                .into_owned()
+        };
+        ArrowError::CDataInterface(format!(
+            "The stream returned the error code {}: {}",
+            code, message
+        ))
+    }
+}
+
+impl Iterator for ArrowArrayStreamReader {
+    type Item = Result<RecordBatch>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        let get_next = self.stream.get_next?;
+        let mut array = FFI_ArrowArray::empty();
+        let code = unsafe { get_next(&mut self.stream, &mut array) };
+        if code != 0 {
+            return Some(Err(Self::stream_error(&mut self.stream, code)));
+        }
+        // the end of the stream is marked by a released array
+        if array.release.is_none() {
+            return None;
+        }
+
+        let array = ArrowArray {
+            array: Arc::new(array),
+            schema: self.ffi_schema.clone(),
+        };
+        Some(
+            ArrayData::try_from(array)
+                .map(|data| RecordBatch::from(&StructArray::from(data))),
+        )
+    }
+}
+
+impl RecordBatchReader for ArrowArrayStreamReader {
+    fn schema(&self) -> SchemaRef {
+        self.schema.clone()
+    }
+}
+
 #[cfg(test)]
 mod tests {
     use super::*;
     use crate::array::{
-        make_array, Array, ArrayData, BinaryOffsetSizeTrait, BooleanArray,
-        GenericBinaryArray, GenericListArray, GenericStringArray, Int32Array,
-        OffsetSizeTrait, StringOffsetSizeTrait, Time32MillisecondArray,
+        make_array, make_array_from_raw, Array, ArrayData, ArrayRef,
+        BinaryOffsetSizeTrait, BooleanArray, GenericBinaryArray, GenericListArray,
+        GenericStringArray, Int32Array, ListArray, OffsetSizeTrait, StringArray,
+        StringOffsetSizeTrait, Time32MillisecondArray,
     };
     use crate::compute::kernels;
-    use crate::datatypes::Field;
+    use crate::datatypes::{Field, Int32Type};
     use std::convert::TryFrom;
     use std::iter::FromIterator;
 
@@ -878,6 +1296,31 @@ mod tests {
         Ok(())
     }
 
+    #[test]
+    fn test_children() -> Result<()> {
+        let value_data = ArrayData::builder(DataType::Int32)
+            .len(3)
+            .add_buffer(Buffer::from_slice_ref(&[4, 5, 6]))
+            .build();
+        let list_data_type =
+            DataType::List(Box::new(Field::new("item", DataType::Int32, false)));
+        let list_data = ArrayData::builder(list_data_type)
+            .len(2)
+            .add_buffer(Buffer::from_slice_ref(&[0, 1, 3]))
+            .add_child_data(value_data)
+            .build();
+
+        // the children are moved out of the exported array, which is consumed
+        let children = ArrowArray::try_from(list_data)?.children()?;
+        assert_eq!(children.len(), 1);
+        let values = make_array(children[0].clone());
+        assert_eq!(
+            values.as_any().downcast_ref::<Int32Array>().unwrap(),
+            &Int32Array::from(vec![4, 5, 6])
+        );
+        Ok(())
+    }
+
     #[test]
     fn test_list() -> Result<()> {
         test_generic_list::<i32>()
@@ -994,4 +1437,173 @@ mod tests {
         // (drop/release)
         Ok(())
     }
+
+    #[test]
+    fn test_sliced() -> Result<()> {
+        let array = Int32Array::from(vec![Some(1), None, Some(3), Some(4)]);
+        let strings = StringArray::from(vec![Some("a"), Some("bb"), None, Some("dddd")]);
+
+        for array in &[array.slice(1, 3), strings.slice(1, 3)] {
+            // export it
+            let exported = ArrowArray::try_from(array.data().clone())?;
+
+            // (simulate consumer) import it
+            let imported = make_array(ArrayData::try_from(exported)?);
+
+            // verify
+            assert_eq!(imported.offset(), 1);
+            assert_eq!(&imported, array);
+        }
+        Ok(())
+    }
+
+    #[test]
+    fn test_struct() -> Result<()> {
+        let ints = Int32Array::from(vec![Some(1), None, Some(3)]);
+        let lists = ListArray::from_iter_primitive::<Int32Type, _, _>(vec![
+            Some(vec![Some(1), None]),
+            None,
+            Some(vec![]),
+        ]);
+        let array = StructArray::from(vec![
+            (
+                Field::new("ints", DataType::Int32, true),
+                Arc::new(ints) as ArrayRef,
+            ),
+            (
+                Field::new("lists", lists.data_type().clone(), false),
+                Arc::new(lists) as ArrayRef,
+            ),
+            (
+                Field::new("strings", DataType::Utf8, false),
+                Arc::new(StringArray::from(vec!["a", "bb", "ccc"])) as ArrayRef,
+            ),
+        ]);
+
+        // export it
+        let exported = ArrowArray::try_from(array.data().clone())?;
+        let (ffi_array, ffi_schema) = ArrowArray::into_raw(exported);
+
+        // (simulate consumer) import it
+        let imported_array = unsafe { make_array_from_raw(ffi_array, ffi_schema) }?;
+
+        // verify the names and nullability of the fields, and the values
+        assert_eq!(imported_array.data_type(), array.data_type());
+        let imported = imported_array
+            .as_any()
+            .downcast_ref::<StructArray>()
+            .unwrap();
+        assert_eq!(imported.column_names(), vec!["ints", "lists", "strings"]);
+        for (imported, expected) in imported.columns().iter().zip(array.columns()) {
+            assert_eq!(*imported, expected);
+        }
+
+        // the children are used after the import of their parent is released
+        let column = imported.column(2).clone();
+        drop(imported_array);
+        assert_eq!(
+            column
+                .as_any()
+                .downcast_ref::<StringArray>()
+                .unwrap()
+                .value(2),
+            "ccc"
+        );
+        Ok(())
+    }
+
+    /// A [RecordBatchReader] of `batches`.
+    struct TestReader {
+        schema: SchemaRef,
+        batches: std::vec::IntoIter<Result<RecordBatch>>,
+    }
+
+    impl Iterator for TestReader {
+        type Item = Result<RecordBatch>;
+
+        fn next(&mut self) -> Option<Self::Item> {
+            self.batches.next()
+        }
+    }
+
+    impl RecordBatchReader for TestReader {
+        fn schema(&self) -> SchemaRef {
+            self.schema.clone()
+        }
+    }
+
+    fn test_batch(offset: i32) -> RecordBatch {
+        let ints = Int32Array::from_iter((offset..offset + 5).map(Some));
+        let strings: StringArray = (offset..offset + 5)
+            .map(|i| Some(i.to_string()).filter(|_| i % 2 == 0))
+            .collect();
+        RecordBatch::try_from_iter(vec![
+            ("ints", Arc::new(ints) as ArrayRef),
+            ("strings", Arc::new(strings) as ArrayRef),
+        ])
+        .unwrap()
+    }
+
+    #[test]
+    fn test_stream_round_trip() -> Result<()> {
+        let batch = test_batch(5);
+        let sliced = batch.columns().iter().map(|c| c.slice(1, 3)).collect();
+        let batches = vec![
+            test_batch(0),
+            RecordBatch::try_new(batch.schema(), sliced).unwrap(),
+        ];
+        let reader = TestReader {
+            schema: batches[0].schema(),
+            batches: batches
+                .clone()
+                .into_iter()
+                .map(Ok)
+                .collect::<Vec<_>>()
+                .into_iter(),
+        };
+
+        // export it, into a stream allocated by the consumer
+        let mut stream = FFI_ArrowArrayStream::empty();
+        unsafe { export_reader_into_raw(Box::new(reader), &mut stream) };
+
+        // (simulate consumer) import it
+        let reader = unsafe { ArrowArrayStreamReader::from_raw(&mut stream) }?;
+        assert!(stream.release.is_none());
+        assert_eq!(reader.schema(), batches[0].schema());
+        let imported = reader.collect::<Result<Vec<_>>>()?;
+
+        // verify, after the stream is released
+        assert_eq!(imported.len(), 2);
+        for (imported, expected) in imported.iter().zip(&batches) {
+            assert_eq!(imported.schema(), expected.schema());
+            assert_eq!(imported.columns(), expected.columns());
+        }
+        Ok(())
+    }
+
+    #[test]
+    fn test_stream_error() -> Result<()> {
+        let batch = test_batch(0);
+        let reader = TestReader {
+            schema: batch.schema(),
+            batches: vec![
+                Ok(batch),
+                Err(ArrowError::IoError("connection lost".to_string())),
+            ]
+            .into_iter(),
+        };
+        let mut reader =
+            ArrowArrayStreamReader::try_new(FFI_ArrowArrayStream::new(Box::new(reader)))?;
+
+        assert!(reader.next().unwrap().is_ok());
+        let err = reader.next().unwrap().unwrap_err();
+        assert!(err.to_string().contains("error code 5"));
+        assert!(err.to_string().contains("connection lost"));
+        assert!(reader.next().is_none());
+
+        // a released stream cannot be imported
+        let err = ArrowArrayStreamReader::try_new(FFI_ArrowArrayStream::empty());
+        assert!(err.is_err());
+        Ok(())
+    }
 }
@@ -0,0 +1,287 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Compression of the body buffers of IPC record batches and dictionary batches.
+//!
+//! Each compressed buffer starts with its uncompressed length as a little endian
+//! 64-bit integer, followed by the buffer compressed by the codec of the batch. A
+//! length of -1 marks a buffer that did not compress, and is stored as is. Empty
+//! buffers are stored without a length.
+//!
+//! The codecs are only available with the `ipc_compression` feature.
+
+use std::convert::TryFrom;
+
+use crate::buffer::Buffer;
+use crate::error::{ArrowError, Result};
+use crate::ipc;
+
+/// Length of the uncompressed length that prefixes each compressed buffer
+const LENGTH_PREFIX_SIZE: usize = 8;
+/// Uncompressed length marking a buffer that is stored uncompressed
+const LENGTH_NO_COMPRESSION: i64 = -1;
+/// Largest capacity reserved up front for a decompressed buffer, as its length prefix
+/// is not trusted
+const MAX_RESERVED_LENGTH: usize = 64 * 1024 * 1024;
+
+/// The codec used to compress the buffers of an IPC batch.
+#[derive(Debug, Clone, Copy, PartialEq)]
+pub(crate) enum CompressionCodec {
+    Lz4Frame,
+    Zstd,
+}
+
+impl TryFrom<ipc::CompressionType> for CompressionCodec {
+    type Error = ArrowError;
+
+    fn try_from(compression_type: ipc::CompressionType) -> Result<Self> {
+        match compression_type {
+            ipc::CompressionType::LZ4_FRAME => Ok(CompressionCodec::Lz4Frame),
+            ipc::CompressionType::ZSTD => Ok(CompressionCodec::Zstd),
+            other => Err(ArrowError::InvalidArgumentError(format!(
+                "Unsupported IPC compression type {:?}",
+                other
+            ))),
+        }
+    }
+}
+
+impl From<CompressionCodec> for ipc::CompressionType {
+    fn from(codec: CompressionCodec) -> Self {
+        match codec {
+            CompressionCodec::Lz4Frame => ipc::CompressionType::LZ4_FRAME,
+            CompressionCodec::Zstd => ipc::CompressionType::ZSTD,
+        }
+    }
+}
+
+impl CompressionCodec {
+    /// Returns the codec of an IPC batch with `compression`, or `None` if its
+    /// buffers are not compressed.
+    pub(crate) fn from_batch(
+        compression: Option<ipc::BodyCompression>,
+    ) -> Result<Option<Self>> {
+        match compression {
+            None => Ok(None),
+            Some(compression) => {
+                if compression.method() != ipc::BodyCompressionMethod::BUFFER {
+                    return Err(ArrowError::InvalidArgumentError(format!(
+                        "Unsupported IPC body compression method {:?}",
+                        compression.method()
+                    )));
+                }
+                Self::try_from(compression.codec()).map(Some)
+            }
+        }
+    }
+
+    /// Appends `input`, prefixed with its length, to `output`, and returns the number
+    /// of bytes appended.
+    pub(crate) fn compress_to_vec(
+        &self,
+        input: &[u8],
+        output: &mut Vec<u8>,
+    ) -> Result<usize> {
+        if input.is_empty() {
+            return Ok(0);
+        }
+        let start = output.len();
+        output.extend_from_slice(&(input.len() as i64).to_le_bytes());
+        self.compress(input, output)?;
+        if output.len() - start - LENGTH_PREFIX_SIZE >= input.len() {
+            // stores the buffer as is, as it did not compress
+            output.truncate(start);
+            output.extend_from_slice(&LENGTH_NO_COMPRESSION.to_le_bytes());
+            output.extend_from_slice(input);
+        }
+        Ok(output.len() - start)
+    }
+
+    /// Decompresses a buffer written by [`CompressionCodec::compress_to_vec`].
+    pub(crate) fn decompress_to_buffer(&self, input: &[u8]) -> Result<Buffer> {
+        if input.is_empty() {
+            return Ok(Buffer::from(input));
+        }
+        if input.len() < LENGTH_PREFIX_SIZE {
+            return Err(ArrowError::IoError(format!(
+                "Compressed IPC buffer of {} bytes is shorter than its length prefix",
+                input.len()
+            )));
+        }
+        let mut length = [0; LENGTH_PREFIX_SIZE];
+        length.copy_from_slice(&input[..LENGTH_PREFIX_SIZE]);
+        let length = i64::from_le_bytes(length);
+        let input = &input[LENGTH_PREFIX_SIZE..];
+        if length == LENGTH_NO_COMPRESSION {
+            return Ok(Buffer::from(input));
+        }
+        if length < LENGTH_NO_COMPRESSION || length > isize::MAX as i64 {
+            return Err(ArrowError::IoError(format!(
+                "Invalid uncompressed length {} of compressed IPC buffer",
+                length
+            )));
+        }
+
+        let mut output = Vec::with_capacity((length as usize).min(MAX_RESERVED_LENGTH));
+        // reads one byte past the expected length, so that longer buffers are detected
+        // without decompressing all of them
+        self.decompress(input, length as u64 + 1, &mut output)?;
+        if output.len() as i64 != length {
+            return Err(ArrowError::IoError(format!(
+                "Expected {} bytes of decompressed IPC buffer, got {}",
+                length,
+                output.len()
+            )));
+        }
+        Ok(Buffer::from(output))
+    }
+
+    #[cfg(any(feature = "ipc_compression", test))]
+    fn compress(&self, input: &[u8], output: &mut Vec<u8>) -> Result<()> {
+        use std::io::Write;
+
+        match self {
+            CompressionCodec::Lz4Frame => {
+                let mut encoder = lz4::EncoderBuilder::new().build(output)?;
+                encoder.write_all(input)?;
+                encoder.finish().1?;
+            }
+            CompressionCodec::Zstd => {
+                let mut encoder = zstd::Encoder::new(output, 0)?;
+                encoder.write_all(input)?;
+                encoder.finish()?;
+            }
+        }
+        Ok(())
+    }
+
+    #[cfg(any(feature = "ipc_compression", test))]
+    fn decompress(&self, input: &[u8], limit: u64, output: &mut Vec<u8>) -> Result<()> {
+        use std::io::Read;
+
+        match self {
+            CompressionCodec::Lz4Frame => {
+                lz4::Decoder::new(input)?.take(limit).read_to_end(output)?;
+            }
+            CompressionCodec::Zstd => {
+                zstd::Decoder::new(input)?.take(limit).read_to_end(output)?;
+            }
+        }
+        Ok(())
+    }
+
+    #[cfg(not(any(feature = "ipc_compression", test)))]
+    fn compress(&self, _input: &[u8], _output: &mut Vec<u8>) -> Result<()> {
+        Err(ArrowError::InvalidArgumentError(format!(
+            "Compressing IPC buffers with {:?} requires the ipc_compression feature",
+            self
+        )))
+    }
+
+    #[cfg(not(any(feature = "ipc_compression", test)))]
+    fn decompress(
+        &self,
+        _input: &[u8],
+        _limit: u64,
+        _output: &mut Vec<u8>,
+    ) -> Result<()> {
+        Err(ArrowError::InvalidArgumentError(format!(
+            "Decompressing IPC buffers with {:?} requires the ipc_compression feature",
+            self
+        )))
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    #[test]
+    fn test_compression_roundtrip() {
+        let values = (0..1000_u32)
+            .flat_map(|i| (i % 10).to_le_bytes().to_vec())
+            .collect::<Vec<_>>();
+        for codec in &[CompressionCodec::Lz4Frame, CompressionCodec::Zstd] {
+            let mut output = vec![1, 2, 3];
+            let len = codec.compress_to_vec(&values, &mut output).unwrap();
+            assert_eq!(len, output.len() - 3);
+            assert!(len < values.len() / 2, "{:?} compressed to {}", codec, len);
+            assert_eq!(
+                &output[3..3 + LENGTH_PREFIX_SIZE],
+                &(values.len() as i64).to_le_bytes()
+            );
+
+            let buffer = codec.decompress_to_buffer(&output[3..]).unwrap();
+            assert_eq!(buffer.as_slice(), values.as_slice());
+        }
+    }
+
+    #[test]
+    fn test_compression_incompressible() {
+        let values = [7_u8, 42, 1];
+        for codec in &[CompressionCodec::Lz4Frame, CompressionCodec::Zstd] {
+            let mut output = vec![];
+            let len = codec.compress_to_vec(&values, &mut output).unwrap();
+            assert_eq!(len, LENGTH_PREFIX_SIZE + values.len());
+            assert_eq!(&output[..LENGTH_PREFIX_SIZE], &(-1_i64).to_le_bytes());
+            let buffer = codec.decompress_to_buffer(&output).unwrap();
+            assert_eq!(buffer.as_slice(), &values);
+
+            assert_eq!(codec.compress_to_vec(&[], &mut output).unwrap(), 0);
+            assert_eq!(codec.decompress_to_buffer(&[]).unwrap().len(), 0);
+        }
+    }
+
+    #[test]
+    fn test_decompress_wrong_length() {
+        let codec = CompressionCodec::Zstd;
+        let mut output = vec![];
+        codec.compress_to_vec(&[0; 100], &mut output).unwrap();
+        output[..LENGTH_PREFIX_SIZE].copy_from_slice(&99_i64.to_le_bytes());
+        assert_eq!(
+            codec.decompress_to_buffer(&output).unwrap_err().to_string(),
+            "Io error: Expected 99 bytes of decompressed IPC buffer, got 100"
+        );
+    }
+
+    #[test]
+    fn test_decompress_corrupt_length() {
+        for codec in &[CompressionCodec::Lz4Frame, CompressionCodec::Zstd] {
+            let mut output = vec![];
+            codec.compress_to_vec(&[0; 100], &mut output).unwrap();
+
+            output[..LENGTH_PREFIX_SIZE].copy_from_slice(&(-2_i64).to_le_bytes());
+            assert_eq!(
+                codec.decompress_to_buffer(&output).unwrap_err().to_string(),
+                "Io error: Invalid uncompressed length -2 of compressed IPC buffer"
+            );
+
+            output[..LENGTH_PREFIX_SIZE].copy_from_slice(&i64::MIN.to_le_bytes());
+            assert!(codec.decompress_to_buffer(&output).is_err());
+
+            // does not reserve the memory of the prefix
+            output[..LENGTH_PREFIX_SIZE].copy_from_slice(&i64::MAX.to_le_bytes());
+            assert!(codec.decompress_to_buffer(&output).is_err());
+
+            output[..LENGTH_PREFIX_SIZE].copy_from_slice(&1_i64.to_le_bytes());
+            assert_eq!(
+                codec.decompress_to_buffer(&output).unwrap_err().to_string(),
+                "Io error: Expected 1 bytes of decompressed IPC buffer, got 2"
+            );
+        }
+    }
+}
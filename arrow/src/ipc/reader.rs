@@ -30,17 +30,47 @@ use crate::compute::cast;
 use crate::datatypes::{DataType, Field, IntervalUnit, Schema, SchemaRef};
 use crate::error::{ArrowError, Result};
 use crate::ipc;
+use crate::ipc::compression::CompressionCodec;
 use crate::record_batch::{RecordBatch, RecordBatchReader};
 
 use ipc::CONTINUATION_MARKER;
 use DataType::*;
 
-/// Read a buffer based on offset and length
-fn read_buffer(buf: &ipc::Buffer, a_data: &[u8]) -> Buffer {
+/// The body of an IPC message, which the buffers of its arrays are read from
+#[derive(Clone, Copy)]
+enum MessageBody<'a> {
+    /// A body whose buffers are copied
+    Slice(&'a [u8]),
+    /// A body whose buffers share its memory region, if they are aligned
+    Buffer(&'a Buffer),
+}
+
+impl<'a> MessageBody<'a> {
+    fn as_slice(&self) -> &'a [u8] {
+        match *self {
+            MessageBody::Slice(slice) => slice,
+            MessageBody::Buffer(buffer) => buffer.as_slice(),
+        }
+    }
+}
+
+/// Read a buffer based on offset and length, decompressing it with `compression_codec`
+fn read_buffer(
+    buf: &ipc::Buffer,
+    a_data: MessageBody,
+    compression_codec: Option<CompressionCodec>,
+) -> Result<Buffer> {
     let start_offset = buf.offset() as usize;
     let end_offset = start_offset + buf.length() as usize;
-    let buf_data = &a_data[start_offset..end_offset];
-    Buffer::from(&buf_data)
+    let buf_data = &a_data.as_slice()[start_offset..end_offset];
+    match (compression_codec, a_data) {
+        (Some(codec), _) => codec.decompress_to_buffer(buf_data),
+        // arrays require their values to be aligned to their type
+        (None, MessageBody::Buffer(buffer)) if buf_data.as_ptr().align_offset(8) == 0 => {
+            Ok(buffer.slice_with_length(start_offset, buf_data.len()))
+        }
+        (None, _) => Ok(Buffer::from(&buf_data)),
+    }
 }
 
 /// Coordinates reading arrays based on data types.
@@ -55,8 +85,7 @@ fn read_buffer(buf: &ipc::Buffer, a_data: &[u8]) -> Buffer {
 fn create_array(
     nodes: &[ipc::FieldNode],
     data_type: &DataType,
-    data: &[u8],
-    buffers: &[ipc::Buffer],
+    buffers: &[Buffer],
     dictionaries: &[Option<ArrayRef>],
     mut node_index: usize,
     mut buffer_index: usize,
@@ -67,10 +96,7 @@ fn create_array(
             let array = create_primitive_array(
                 &nodes[node_index],
                 data_type,
-                buffers[buffer_index..buffer_index + 3]
-                    .iter()
-                    .map(|buf| read_buffer(buf, data))
-                    .collect(),
+                buffers[buffer_index..buffer_index + 3].to_vec(),
             );
             node_index += 1;
             buffer_index += 3;
@@ -80,10 +106,7 @@ fn create_array(
             let array = create_primitive_array(
                 &nodes[node_index],
                 data_type,
-                buffers[buffer_index..buffer_index + 2]
-                    .iter()
-                    .map(|buf| read_buffer(buf, data))
-                    .collect(),
+                buffers[buffer_index..buffer_index + 2].to_vec(),
             );
             node_index += 1;
             buffer_index += 2;
@@ -91,16 +114,13 @@ fn create_array(
         }
         List(ref list_field) | LargeList(ref list_field) => {
             let list_node = &nodes[node_index];
-            let list_buffers: Vec<Buffer> = buffers[buffer_index..buffer_index + 2]
-                .iter()
-                .map(|buf| read_buffer(buf, data))
-                .collect();
+            let list_buffers: Vec<Buffer> =
+                buffers[buffer_index..buffer_index + 2].to_vec();
             node_index += 1;
             buffer_index += 2;
             let triple = create_array(
                 nodes,
                 list_field.data_type(),
-                data,
                 buffers,
                 dictionaries,
                 node_index,
@@ -113,16 +133,12 @@ fn create_array(
         }
         FixedSizeList(ref list_field, _) => {
             let list_node = &nodes[node_index];
-            let list_buffers: Vec<Buffer> = buffers[buffer_index..=buffer_index]
-                .iter()
-                .map(|buf| read_buffer(buf, data))
-                .collect();
+            let list_buffers: Vec<Buffer> = buffers[buffer_index..=buffer_index].to_vec();
             node_index += 1;
             buffer_index += 1;
             let triple = create_array(
                 nodes,
                 list_field.data_type(),
-                data,
                 buffers,
                 dictionaries,
                 node_index,
@@ -135,7 +151,7 @@ fn create_array(
         }
         Struct(struct_fields) => {
             let struct_node = &nodes[node_index];
-            let null_buffer: Buffer = read_buffer(&buffers[buffer_index], data);
+            let null_buffer: Buffer = buffers[buffer_index].clone();
             node_index += 1;
             buffer_index += 1;
 
@@ -147,7 +163,6 @@ fn create_array(
                 let triple = create_array(
                     nodes,
                     struct_field.data_type(),
-                    data,
                     buffers,
                     dictionaries,
                     node_index,
@@ -169,10 +184,8 @@ fn create_array(
         // Create dictionary array from RecordBatch
         Dictionary(_, _) => {
             let index_node = &nodes[node_index];
-            let index_buffers: Vec<Buffer> = buffers[buffer_index..buffer_index + 2]
-                .iter()
-                .map(|buf| read_buffer(buf, data))
-                .collect();
+            let index_buffers: Vec<Buffer> =
+                buffers[buffer_index..buffer_index + 2].to_vec();
             let value_array = dictionaries[node_index].clone().unwrap();
             node_index += 1;
             buffer_index += 2;
@@ -198,10 +211,7 @@ fn create_array(
             let array = create_primitive_array(
                 &nodes[node_index],
                 data_type,
-                buffers[buffer_index..buffer_index + 2]
-                    .iter()
-                    .map(|buf| read_buffer(buf, data))
-                    .collect(),
+                buffers[buffer_index..buffer_index + 2].to_vec(),
             );
             node_index += 1;
             buffer_index += 2;
@@ -412,6 +422,27 @@ pub fn read_record_batch(
     batch: ipc::RecordBatch,
     schema: SchemaRef,
     dictionaries: &[Option<ArrayRef>],
+) -> Result<RecordBatch> {
+    read_record_batch_from_body(MessageBody::Slice(buf), batch, schema, dictionaries)
+}
+
+/// Creates a record batch from the message body `buf` using the `ipc::RecordBatch`
+/// indexes and the `Schema`, like [`read_record_batch`], but sharing the memory of
+/// `buf` for the uncompressed and aligned buffers of the arrays instead of copying them
+pub fn read_record_batch_from_buffer(
+    buf: &Buffer,
+    batch: ipc::RecordBatch,
+    schema: SchemaRef,
+    dictionaries: &[Option<ArrayRef>],
+) -> Result<RecordBatch> {
+    read_record_batch_from_body(MessageBody::Buffer(buf), batch, schema, dictionaries)
+}
+
+fn read_record_batch_from_body(
+    buf: MessageBody,
+    batch: ipc::RecordBatch,
+    schema: SchemaRef,
+    dictionaries: &[Option<ArrayRef>],
 ) -> Result<RecordBatch> {
     let buffers = batch.buffers().ok_or_else(|| {
         ArrowError::IoError("Unable to get buffers from IPC RecordBatch".to_string())
@@ -419,6 +450,11 @@ pub fn read_record_batch(
     let field_nodes = batch.nodes().ok_or_else(|| {
         ArrowError::IoError("Unable to get field nodes from IPC RecordBatch".to_string())
     })?;
+    let compression_codec = CompressionCodec::from_batch(batch.compression())?;
+    let buffers = buffers
+        .iter()
+        .map(|buffer| read_buffer(buffer, buf, compression_codec))
+        .collect::<Result<Vec<_>>>()?;
     // keep track of buffer and node index, the functions that create arrays mutate these
     let mut buffer_index = 0;
     let mut node_index = 0;
@@ -429,8 +465,7 @@ pub fn read_record_batch(
         let triple = create_array(
             field_nodes,
             field.data_type(),
-            &buf,
-            buffers,
+            &buffers,
             dictionaries,
             node_index,
             buffer_index,
@@ -450,6 +485,37 @@ pub fn read_dictionary(
     batch: ipc::DictionaryBatch,
     schema: &Schema,
     dictionaries_by_field: &mut [Option<ArrayRef>],
+) -> Result<()> {
+    read_dictionary_from_body(
+        MessageBody::Slice(buf),
+        batch,
+        schema,
+        dictionaries_by_field,
+    )
+}
+
+/// Read the dictionary from the message body `buf` and provided metadata, like
+/// [`read_dictionary`], but sharing the memory of `buf` for the uncompressed and
+/// aligned buffers of the dictionary instead of copying them
+pub fn read_dictionary_from_buffer(
+    buf: &Buffer,
+    batch: ipc::DictionaryBatch,
+    schema: &Schema,
+    dictionaries_by_field: &mut [Option<ArrayRef>],
+) -> Result<()> {
+    read_dictionary_from_body(
+        MessageBody::Buffer(buf),
+        batch,
+        schema,
+        dictionaries_by_field,
+    )
+}
+
+fn read_dictionary_from_body(
+    buf: MessageBody,
+    batch: ipc::DictionaryBatch,
+    schema: &Schema,
+    dictionaries_by_field: &mut [Option<ArrayRef>],
 ) -> Result<()> {
     if batch.isDelta() {
         return Err(ArrowError::IoError(
@@ -474,8 +540,8 @@ pub fn read_dictionary(
                 metadata: HashMap::new(),
             };
             // Read a single column
-            let record_batch = read_record_batch(
-                &buf,
+            let record_batch = read_record_batch_from_body(
+                buf,
                 batch.data().unwrap(),
                 Arc::new(schema),
                 &dictionaries_by_field,
@@ -741,6 +807,243 @@ impl<R: Read + Seek> RecordBatchReader for FileReader<R> {
     }
 }
 
+/// Arrow File reader over a [`Buffer`] holding a whole Arrow file, such as a memory
+/// mapped file wrapped with [`Buffer::from_custom_allocation`].
+///
+/// Unlike [`FileReader`], the buffers of the arrays it reads share the memory region of
+/// the file rather than copying it, except for compressed buffers and buffers that are
+/// not aligned to 8 bytes. Reading a record batch then only touches the metadata of its
+/// arrays.
+pub struct BufferFileReader {
+    /// The Arrow file
+    data: Buffer,
+
+    /// The schema that is read from the file footer
+    schema: SchemaRef,
+
+    /// The blocks of the record batches in the file
+    blocks: Vec<ipc::Block>,
+
+    /// A counter to keep track of the current block that should be read
+    current_block: usize,
+
+    /// Optional dictionaries for each schema field.
+    dictionaries_by_field: Vec<Option<ArrayRef>>,
+
+    /// Metadata version
+    metadata_version: ipc::MetadataVersion,
+}
+
+impl BufferFileReader {
+    /// Try to create a new reader of the Arrow file in `data`
+    ///
+    /// Returns errors if the file does not meet the Arrow Format header and footer
+    /// requirements
+    pub fn try_new(data: Buffer) -> Result<Self> {
+        let bytes = data.as_slice();
+        let magic_len = super::ARROW_MAGIC.len();
+        if bytes.len() < magic_len || bytes[..magic_len] != super::ARROW_MAGIC {
+            return Err(ArrowError::IoError(
+                "Arrow file does not contain correct header".to_string(),
+            ));
+        }
+        let footer_end = bytes.len().saturating_sub(magic_len + 4);
+        if footer_end < magic_len || bytes[footer_end + 4..] != super::ARROW_MAGIC {
+            return Err(ArrowError::IoError(
+                "Arrow file does not contain correct footer".to_string(),
+            ));
+        }
+        // read footer length
+        let mut footer_size: [u8; 4] = [0; 4];
+        footer_size.copy_from_slice(&bytes[footer_end..footer_end + 4]);
+        let footer_len = i32::from_le_bytes(footer_size) as usize;
+        if footer_len > footer_end {
+            return Err(ArrowError::IoError(format!(
+                "Arrow file footer of {} bytes is larger than the file",
+                footer_len
+            )));
+        }
+
+        let footer = ipc::root_as_footer(&bytes[footer_end - footer_len..footer_end])
+            .map_err(|err| {
+                ArrowError::IoError(format!("Unable to get root as footer: {:?}", err))
+            })?;
+
+        let blocks = footer.recordBatches().ok_or_else(|| {
+            ArrowError::IoError(
+                "Unable to get record batches from IPC Footer".to_string(),
+            )
+        })?;
+
+        let ipc_schema = footer.schema().unwrap();
+        let schema = ipc::convert::fb_to_schema(ipc_schema);
+
+        // Create an array of optional dictionary value arrays, one per field.
+        let mut dictionaries_by_field = vec![None; schema.fields().len()];
+        for block in footer.dictionaries().unwrap() {
+            let (message, body) = read_block(&data, block)?;
+            match message.header_type() {
+                ipc::MessageHeader::DictionaryBatch => {
+                    let batch = message.header_as_dictionary_batch().unwrap();
+                    read_dictionary_from_body(
+                        MessageBody::Buffer(&body),
+                        batch,
+                        &schema,
+                        &mut dictionaries_by_field,
+                    )?;
+                }
+                t => {
+                    return Err(ArrowError::IoError(format!(
+                        "Expecting DictionaryBatch in dictionary blocks, found {:?}.",
+                        t
+                    )));
+                }
+            };
+        }
+
+        let blocks = blocks.to_vec();
+        let metadata_version = footer.version();
+        Ok(Self {
+            data,
+            schema: Arc::new(schema),
+            blocks,
+            current_block: 0,
+            dictionaries_by_field,
+            metadata_version,
+        })
+    }
+
+    /// Return the number of batches in the file
+    pub fn num_batches(&self) -> usize {
+        self.blocks.len()
+    }
+
+    /// Return the schema of the file
+    pub fn schema(&self) -> SchemaRef {
+        self.schema.clone()
+    }
+
+    /// Read a specific record batch
+    ///
+    /// Sets the current block to the index, allowing random reads
+    pub fn set_index(&mut self, index: usize) -> Result<()> {
+        if index >= self.blocks.len() {
+            Err(ArrowError::IoError(format!(
+                "Cannot set batch to index {} from {} total batches",
+                index,
+                self.blocks.len()
+            )))
+        } else {
+            self.current_block = index;
+            Ok(())
+        }
+    }
+
+    fn maybe_next(&mut self) -> Result<Option<RecordBatch>> {
+        let block = &self.blocks[self.current_block];
+        self.current_block += 1;
+
+        let (message, body) = read_block(&self.data, block)?;
+
+        // some old test data's footer metadata is not set, so we account for that
+        if self.metadata_version != ipc::MetadataVersion::V1
+            && message.version() != self.metadata_version
+        {
+            return Err(ArrowError::IoError(
+                "Could not read IPC message as metadata versions mismatch".to_string(),
+            ));
+        }
+
+        match message.header_type() {
+            ipc::MessageHeader::Schema => Err(ArrowError::IoError(
+                "Not expecting a schema when messages are read".to_string(),
+            )),
+            ipc::MessageHeader::RecordBatch => {
+                let batch = message.header_as_record_batch().ok_or_else(|| {
+                    ArrowError::IoError(
+                        "Unable to read IPC message as record batch".to_string(),
+                    )
+                })?;
+                read_record_batch_from_body(
+                    MessageBody::Buffer(&body),
+                    batch,
+                    self.schema(),
+                    &self.dictionaries_by_field,
+                )
+                .map(Some)
+            }
+            ipc::MessageHeader::NONE => Ok(None),
+            t => Err(ArrowError::IoError(format!(
+                "Reading types other than record batches not yet supported, unable to read {:?}",
+                t
+            ))),
+        }
+    }
+}
+
+/// Returns the message of `block` in the Arrow file `data`, and the buffer of its body
+fn read_block<'a>(
+    data: &'a Buffer,
+    block: &ipc::Block,
+) -> Result<(ipc::Message<'a>, Buffer)> {
+    let out_of_bounds = || {
+        ArrowError::IoError(format!(
+            "Block at offset {} is out of bounds of the Arrow file",
+            block.offset()
+        ))
+    };
+    let bytes = data.as_slice();
+    let mut start = block.offset() as usize;
+    let meta_end = start
+        .checked_add(block.metaDataLength() as usize)
+        .filter(|end| *end <= bytes.len() && start + 4 <= *end)
+        .ok_or_else(out_of_bounds)?;
+    if bytes[start..start + 4] == CONTINUATION_MARKER {
+        // continuation marker encountered, read message next
+        start += 4;
+    }
+    if start + 4 > meta_end {
+        return Err(out_of_bounds());
+    }
+    let mut meta_size: [u8; 4] = [0; 4];
+    meta_size.copy_from_slice(&bytes[start..start + 4]);
+    let meta_len = i32::from_le_bytes(meta_size) as usize;
+    let meta_start = start + 4;
+    if meta_start + meta_len > meta_end {
+        return Err(out_of_bounds());
+    }
+
+    let message = ipc::root_as_message(&bytes[meta_start..meta_start + meta_len])
+        .map_err(|err| {
+            ArrowError::IoError(format!("Unable to get root as message: {:?}", err))
+        })?;
+
+    let body_len = block.bodyLength() as usize;
+    if meta_end + body_len > bytes.len() {
+        return Err(out_of_bounds());
+    }
+    Ok((message, data.slice_with_length(meta_end, body_len)))
+}
+
+impl Iterator for BufferFileReader {
+    type Item = Result<RecordBatch>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        // get current block
+        if self.current_block < self.blocks.len() {
+            self.maybe_next().transpose()
+        } else {
+            None
+        }
+    }
+}
+
+impl RecordBatchReader for BufferFileReader {
+    fn schema(&self) -> SchemaRef {
+        self.schema.clone()
+    }
+}
+
 /// Arrow Stream reader
 pub struct StreamReader<R: Read> {
     /// Buffered stream reader
@@ -1142,6 +1445,111 @@ mod tests {
         })
     }
 
+    #[test]
+    fn read_generated_files_100_from_buffer() {
+        let testdata = crate::util::test_util::arrow_test_data();
+        let version = "1.0.0-littleendian";
+        let paths = vec![
+            "generated_interval",
+            "generated_datetime",
+            "generated_dictionary",
+            "generated_nested",
+            "generated_null_trivial",
+            "generated_null",
+            "generated_primitive_no_batches",
+            "generated_primitive_zerolength",
+            "generated_primitive",
+        ];
+        paths.iter().for_each(|path| {
+            let data = std::fs::read(format!(
+                "{}/arrow-ipc-stream/integration/{}/{}.arrow_file",
+                testdata, version, path
+            ))
+            .unwrap();
+
+            let mut reader = BufferFileReader::try_new(Buffer::from(data)).unwrap();
+
+            // read expected JSON output
+            let arrow_json = read_gzip_json(version, path);
+            assert!(arrow_json.equals_reader(&mut reader));
+        });
+    }
+
+    #[test]
+    fn test_buffer_file_reader_zero_copy() {
+        use crate::datatypes::Int8Type;
+        use crate::ipc::writer::FileWriter;
+
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("ints", DataType::Int64, true),
+            Field::new_dict(
+                "dict",
+                DataType::Dictionary(Box::new(DataType::Int8), Box::new(DataType::Utf8)),
+                false,
+                1,
+                false,
+            ),
+        ]));
+        let batches = (0..3)
+            .map(|i| {
+                let ints = (0..100)
+                    .map(|j| if j % 3 == 0 { None } else { Some(i * 100 + j) })
+                    .collect::<Int64Array>();
+                let dict = (0..100)
+                    .map(|j| ["a", "b", "c"][j % 3])
+                    .collect::<DictionaryArray<Int8Type>>();
+                RecordBatch::try_new(schema.clone(), vec![Arc::new(ints), Arc::new(dict)])
+                    .unwrap()
+            })
+            .collect::<Vec<_>>();
+        let mut bytes = vec![];
+        {
+            let mut writer = FileWriter::try_new(&mut bytes, &schema).unwrap();
+            for batch in &batches {
+                writer.write(batch).unwrap();
+            }
+            writer.finish().unwrap();
+        }
+        let data = Buffer::from(bytes);
+        let file_range = data.as_ptr() as usize..data.as_ptr() as usize + data.len();
+
+        let mut reader = BufferFileReader::try_new(data).unwrap();
+        assert_eq!(reader.num_batches(), 3);
+        assert_eq!(reader.schema(), schema);
+        reader.set_index(2).unwrap();
+        let read_batch = reader.next().unwrap().unwrap();
+        assert!(reader.next().is_none());
+        reader.set_index(0).unwrap();
+        let read_batches = reader.collect::<Result<Vec<_>>>().unwrap();
+        assert_eq!(read_batches.len(), 3);
+
+        for (read_batch, batch) in std::iter::once(&read_batch)
+            .chain(read_batches.iter())
+            .zip(std::iter::once(&batches[2]).chain(batches.iter()))
+        {
+            for i in 0..batch.num_columns() {
+                let column = read_batch.column(i);
+                assert_eq!(column.as_ref(), batch.column(i).as_ref());
+                // the buffers of the arrays and dictionaries reference the file
+                let data = column.data();
+                let values = &data.buffers()[0];
+                assert!(file_range.contains(&(values.as_ptr() as usize)));
+                assert_eq!(values.capacity(), 0);
+                if let Some(child_data) = data.child_data().first() {
+                    let offsets = &child_data.buffers()[0];
+                    assert!(file_range.contains(&(offsets.as_ptr() as usize)));
+                }
+            }
+        }
+        assert_eq!(
+            BufferFileReader::try_new(Buffer::from(&[0; 10]))
+                .err()
+                .unwrap()
+                .to_string(),
+            "Io error: Arrow file does not contain correct header"
+        );
+    }
+
     /// Read gzipped JSON file
     fn read_gzip_json(version: &str, path: &str) -> ArrowJson {
         let testdata = crate::util::test_util::arrow_test_data();
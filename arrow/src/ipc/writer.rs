@@ -21,15 +21,17 @@
 //! however the `FileWriter` expects a reader that supports `Seek`ing
 
 use std::collections::HashMap;
+use std::convert::TryFrom;
 use std::io::{BufWriter, Write};
 
-use flatbuffers::FlatBufferBuilder;
+use flatbuffers::{FlatBufferBuilder, WIPOffset};
 
 use crate::array::{ArrayData, ArrayRef};
 use crate::buffer::{Buffer, MutableBuffer};
 use crate::datatypes::*;
 use crate::error::{ArrowError, Result};
 use crate::ipc;
+use crate::ipc::compression::CompressionCodec;
 use crate::record_batch::RecordBatch;
 use crate::util::bit_util;
 
@@ -52,6 +54,10 @@ pub struct IpcWriteOptions {
     /// version 2.0.0: V4, with legacy format enabled
     /// version 4.0.0: V5
     metadata_version: ipc::MetadataVersion,
+    /// The codec used to compress the buffers of record batches and dictionary
+    /// batches, if any. Requires metadata version V5 and the `ipc_compression`
+    /// feature.
+    batch_compression_type: Option<ipc::CompressionType>,
 }
 
 impl IpcWriteOptions {
@@ -76,6 +82,7 @@ impl IpcWriteOptions {
                 alignment,
                 write_legacy_ipc_format,
                 metadata_version,
+                batch_compression_type: None,
             }),
             ipc::MetadataVersion::V5 => {
                 if write_legacy_ipc_format {
@@ -88,12 +95,41 @@ impl IpcWriteOptions {
                         alignment,
                         write_legacy_ipc_format,
                         metadata_version,
+                        batch_compression_type: None,
                     })
                 }
             }
             z => panic!("Unsupported ipc::MetadataVersion {:?}", z),
         }
     }
+
+    /// Try set the codec used to compress the buffers of record batches and
+    /// dictionary batches, or write them uncompressed if `None`
+    ///
+    /// Returns errors if the metadata version is lower than V5, or if the codec is
+    /// not supported
+    pub fn try_with_compression(
+        mut self,
+        batch_compression_type: Option<ipc::CompressionType>,
+    ) -> Result<Self> {
+        if let Some(compression_type) = batch_compression_type {
+            if self.metadata_version < ipc::MetadataVersion::V5 {
+                return Err(ArrowError::InvalidArgumentError(
+                    "Compression only supported on metadata version 5 and above"
+                        .to_string(),
+                ));
+            }
+            CompressionCodec::try_from(compression_type)?;
+        }
+        self.batch_compression_type = batch_compression_type;
+        Ok(self)
+    }
+
+    /// Returns the codec used to compress the buffers of batches, if any
+    fn compression_codec(&self) -> Option<CompressionCodec> {
+        self.batch_compression_type
+            .map(|compression_type| CompressionCodec::try_from(compression_type).unwrap())
+    }
 }
 
 impl Default for IpcWriteOptions {
@@ -102,6 +138,7 @@ impl Default for IpcWriteOptions {
             alignment: 8,
             write_legacy_ipc_format: false,
             metadata_version: ipc::MetadataVersion::V5,
+            batch_compression_type: None,
         }
     }
 }
@@ -164,12 +201,12 @@ impl IpcDataGenerator {
                         dict_id,
                         dict_values,
                         write_options,
-                    ));
+                    )?);
                 }
             }
         }
 
-        let encoded_message = self.record_batch_to_bytes(batch, write_options);
+        let encoded_message = self.record_batch_to_bytes(batch, write_options)?;
 
         Ok((encoded_dictionaries, encoded_message))
     }
@@ -180,13 +217,14 @@ impl IpcDataGenerator {
         &self,
         batch: &RecordBatch,
         write_options: &IpcWriteOptions,
-    ) -> EncodedData {
+    ) -> Result<EncodedData> {
         let mut fbb = FlatBufferBuilder::new();
 
         let mut nodes: Vec<ipc::FieldNode> = vec![];
         let mut buffers: Vec<ipc::Buffer> = vec![];
         let mut arrow_data: Vec<u8> = vec![];
         let mut offset = 0;
+        let compression_codec = write_options.compression_codec();
         for array in batch.columns() {
             let array_data = array.data();
             offset = write_array_data(
@@ -197,18 +235,24 @@ impl IpcDataGenerator {
                 offset,
                 array.len(),
                 array.null_count(),
-            );
+                compression_codec,
+            )?;
         }
 
         // write data
         let buffers = fbb.create_vector(&buffers);
         let nodes = fbb.create_vector(&nodes);
+        let compression =
+            compression_codec.map(|codec| body_compression(&mut fbb, codec));
 
         let root = {
             let mut batch_builder = ipc::RecordBatchBuilder::new(&mut fbb);
             batch_builder.add_length(batch.num_rows() as i64);
             batch_builder.add_nodes(nodes);
             batch_builder.add_buffers(buffers);
+            if let Some(compression) = compression {
+                batch_builder.add_compression(compression);
+            }
             let b = batch_builder.finish();
             b.as_union_value()
         };
@@ -222,10 +266,10 @@ impl IpcDataGenerator {
         fbb.finish(root, None);
         let finished_data = fbb.finished_data();
 
-        EncodedData {
+        Ok(EncodedData {
             ipc_message: finished_data.to_vec(),
             arrow_data,
-        }
+        })
     }
 
     /// Write dictionary values into two sets of bytes, one for the header (ipc::Message) and the
@@ -235,12 +279,13 @@ impl IpcDataGenerator {
         dict_id: i64,
         array_data: &ArrayData,
         write_options: &IpcWriteOptions,
-    ) -> EncodedData {
+    ) -> Result<EncodedData> {
         let mut fbb = FlatBufferBuilder::new();
 
         let mut nodes: Vec<ipc::FieldNode> = vec![];
         let mut buffers: Vec<ipc::Buffer> = vec![];
         let mut arrow_data: Vec<u8> = vec![];
+        let compression_codec = write_options.compression_codec();
 
         write_array_data(
             &array_data,
@@ -250,17 +295,23 @@ impl IpcDataGenerator {
             0,
             array_data.len(),
             array_data.null_count(),
-        );
+            compression_codec,
+        )?;
 
         // write data
         let buffers = fbb.create_vector(&buffers);
         let nodes = fbb.create_vector(&nodes);
+        let compression =
+            compression_codec.map(|codec| body_compression(&mut fbb, codec));
 
         let root = {
             let mut batch_builder = ipc::RecordBatchBuilder::new(&mut fbb);
             batch_builder.add_length(array_data.len() as i64);
             batch_builder.add_nodes(nodes);
             batch_builder.add_buffers(buffers);
+            if let Some(compression) = compression {
+                batch_builder.add_compression(compression);
+            }
             batch_builder.finish()
         };
 
@@ -283,16 +334,17 @@ impl IpcDataGenerator {
         fbb.finish(root, None);
         let finished_data = fbb.finished_data();
 
-        EncodedData {
+        Ok(EncodedData {
             ipc_message: finished_data.to_vec(),
             arrow_data,
-        }
+        })
     }
 }
 
 /// Keeps track of dictionaries that have been written, to avoid emitting the same dictionary
 /// multiple times. Can optionally error if an update to an existing dictionary is attempted, which
 /// isn't allowed in the `FileWriter`.
+#[derive(Debug)]
 pub struct DictionaryTracker {
     written: HashMap<i64, ArrayRef>,
     error_on_replacement: bool,
@@ -701,7 +753,19 @@ fn write_continuation<W: Write>(
     Ok(written)
 }
 
+/// Returns the `BodyCompression` of a batch whose buffers are compressed by `codec`
+fn body_compression<'a>(
+    fbb: &mut FlatBufferBuilder<'a>,
+    codec: CompressionCodec,
+) -> WIPOffset<ipc::BodyCompression<'a>> {
+    let mut builder = ipc::BodyCompressionBuilder::new(fbb);
+    builder.add_method(ipc::BodyCompressionMethod::BUFFER);
+    builder.add_codec(codec.into());
+    builder.finish()
+}
+
 /// Write array data to a vector of bytes
+#[allow(clippy::too_many_arguments)]
 fn write_array_data(
     array_data: &ArrayData,
     mut buffers: &mut Vec<ipc::Buffer>,
@@ -710,7 +774,8 @@ fn write_array_data(
     offset: i64,
     num_rows: usize,
     null_count: usize,
-) -> i64 {
+    compression_codec: Option<CompressionCodec>,
+) -> Result<i64> {
     let mut offset = offset;
     nodes.push(ipc::FieldNode::new(num_rows as i64, null_count as i64));
     // NullArray does not have any buffers, thus the null buffer is not generated
@@ -727,16 +792,28 @@ fn write_array_data(
             Some(buffer) => buffer.clone(),
         };
 
-        offset = write_buffer(&null_buffer, &mut buffers, &mut arrow_data, offset);
+        offset = write_buffer(
+            &null_buffer,
+            &mut buffers,
+            &mut arrow_data,
+            offset,
+            compression_codec,
+        )?;
     }
 
-    array_data.buffers().iter().for_each(|buffer| {
-        offset = write_buffer(buffer, &mut buffers, &mut arrow_data, offset);
-    });
+    for buffer in array_data.buffers() {
+        offset = write_buffer(
+            buffer,
+            &mut buffers,
+            &mut arrow_data,
+            offset,
+            compression_codec,
+        )?;
+    }
 
     if !matches!(array_data.data_type(), DataType::Dictionary(_, _)) {
         // recursively write out nested structures
-        array_data.child_data().iter().for_each(|data_ref| {
+        for data_ref in array_data.child_data() {
             // write the nested data (e.g list data)
             offset = write_array_data(
                 data_ref,
@@ -746,28 +823,41 @@ fn write_array_data(
                 offset,
                 data_ref.len(),
                 data_ref.null_count(),
-            );
-        });
+                compression_codec,
+            )?;
+        }
     }
 
-    offset
+    Ok(offset)
 }
 
 /// Write a buffer to a vector of bytes, and add its ipc::Buffer to a vector
+///
+/// Compressed buffers are recorded with their exact length, as the padding is not
+/// part of the compressed data.
 fn write_buffer(
     buffer: &Buffer,
     buffers: &mut Vec<ipc::Buffer>,
     arrow_data: &mut Vec<u8>,
     offset: i64,
-) -> i64 {
-    let len = buffer.len();
+    compression_codec: Option<CompressionCodec>,
+) -> Result<i64> {
+    let (len, buffer_len) = match compression_codec {
+        None => {
+            arrow_data.extend_from_slice(buffer.as_slice());
+            (buffer.len(), None)
+        }
+        Some(codec) => {
+            let len = codec.compress_to_vec(buffer.as_slice(), arrow_data)?;
+            (len, Some(len as i64))
+        }
+    };
     let pad_len = pad_to_8(len as u32);
     let total_len: i64 = (len + pad_len) as i64;
     // assert_eq!(len % 8, 0, "Buffer width not a multiple of 8 bytes");
-    buffers.push(ipc::Buffer::new(offset, total_len));
-    arrow_data.extend_from_slice(buffer.as_slice());
+    buffers.push(ipc::Buffer::new(offset, buffer_len.unwrap_or(total_len)));
     arrow_data.extend_from_slice(&vec![0u8; pad_len][..]);
-    offset + total_len
+    Ok(offset + total_len)
 }
 
 /// Calculate an 8-byte boundary and return the number of bytes needed to pad to 8 bytes
@@ -1157,4 +1247,125 @@ mod tests {
         let arrow_json: ArrowJson = serde_json::from_str(&s).unwrap();
         arrow_json
     }
+
+    fn write_compressed_batches(
+        batches: &[RecordBatch],
+        compression_type: Option<ipc::CompressionType>,
+        stream: bool,
+    ) -> Vec<u8> {
+        let schema = batches[0].schema();
+        let options = IpcWriteOptions::default()
+            .try_with_compression(compression_type)
+            .unwrap();
+        let mut bytes = vec![];
+        if stream {
+            let mut writer =
+                StreamWriter::try_new_with_options(&mut bytes, &schema, options).unwrap();
+            for batch in batches {
+                writer.write(batch).unwrap();
+            }
+            writer.finish().unwrap();
+        } else {
+            let mut writer =
+                FileWriter::try_new_with_options(&mut bytes, &schema, options).unwrap();
+            for batch in batches {
+                writer.write(batch).unwrap();
+            }
+            writer.finish().unwrap();
+        }
+        bytes
+    }
+
+    #[test]
+    fn test_write_compressed_roundtrip() {
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("ints", DataType::Int32, true),
+            Field::new("strings", DataType::Utf8, false),
+            Field::new_dict(
+                "dict",
+                DataType::Dictionary(Box::new(DataType::Int8), Box::new(DataType::Utf8)),
+                false,
+                1,
+                false,
+            ),
+        ]));
+        let batches = (0..3)
+            .map(|i| {
+                let ints = (0..1000)
+                    .map(|j| if j % 7 == 0 { None } else { Some(j % 10 + i) })
+                    .collect::<Int32Array>();
+                let strings = (0..1000)
+                    .map(|j| format!("value {}", j % 5))
+                    .collect::<Vec<_>>();
+                let strings = StringArray::from(
+                    strings.iter().map(|s| s.as_str()).collect::<Vec<_>>(),
+                );
+                let dict = (0..1000)
+                    .map(|j| ["a", "b", "c"][j % 3])
+                    .collect::<DictionaryArray<Int8Type>>();
+                RecordBatch::try_new(
+                    schema.clone(),
+                    vec![Arc::new(ints), Arc::new(strings), Arc::new(dict)],
+                )
+                .unwrap()
+            })
+            .collect::<Vec<_>>();
+
+        for stream in &[false, true] {
+            let uncompressed = write_compressed_batches(&batches, None, *stream);
+            for compression_type in
+                &[ipc::CompressionType::LZ4_FRAME, ipc::CompressionType::ZSTD]
+            {
+                let bytes =
+                    write_compressed_batches(&batches, Some(*compression_type), *stream);
+                assert!(
+                    bytes.len() * 2 < uncompressed.len(),
+                    "{:?} compressed {} bytes to {}",
+                    compression_type,
+                    uncompressed.len(),
+                    bytes.len()
+                );
+
+                let read_batches: Vec<RecordBatch> = if *stream {
+                    StreamReader::try_new(std::io::Cursor::new(bytes))
+                        .unwrap()
+                        .collect::<Result<_>>()
+                        .unwrap()
+                } else {
+                    FileReader::try_new(std::io::Cursor::new(bytes))
+                        .unwrap()
+                        .collect::<Result<_>>()
+                        .unwrap()
+                };
+                assert_eq!(read_batches.len(), batches.len());
+                for (read_batch, batch) in read_batches.iter().zip(batches.iter()) {
+                    assert_eq!(read_batch.schema(), batch.schema());
+                    for i in 0..batch.num_columns() {
+                        assert_eq!(
+                            read_batch.column(i).as_ref(),
+                            batch.column(i).as_ref()
+                        );
+                    }
+                }
+            }
+        }
+    }
+
+    #[test]
+    fn test_write_compressed_options() {
+        let options = IpcWriteOptions::try_new(8, false, MetadataVersion::V4)
+            .unwrap()
+            .try_with_compression(Some(ipc::CompressionType::ZSTD));
+        assert_eq!(
+            options.unwrap_err().to_string(),
+            "Invalid argument error: Compression only supported on metadata version 5 and above"
+        );
+
+        let options = IpcWriteOptions::default()
+            .try_with_compression(Some(ipc::CompressionType(5)));
+        assert_eq!(
+            options.unwrap_err().to_string(),
+            "Invalid argument error: Unsupported IPC compression type <UNKNOWN 5>"
+        );
+    }
 }
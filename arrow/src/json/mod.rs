@@ -20,6 +20,7 @@
 //! [`reader`] and [`writer`] for usage examples.
 
 pub mod reader;
+mod tape;
 pub mod writer;
 
 pub use self::reader::Reader;
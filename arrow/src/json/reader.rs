@@ -50,6 +50,7 @@ use indexmap::map::IndexMap as HashMap;
 use indexmap::set::IndexSet as HashSet;
 use serde_json::{map::Map as JsonMap, Value};
 
+use super::tape::TapeDecoder;
 use crate::buffer::MutableBuffer;
 use crate::datatypes::*;
 use crate::error::{ArrowError, Result};
@@ -1409,11 +1410,17 @@ fn flatten_json_string_values(values: &[Value]) -> Vec<Option<String>> {
         .collect::<Vec<Option<_>>>()
 }
 /// JSON file reader
+///
+/// If all the projected fields of the schema are of scalar types, such as numbers,
+/// booleans, strings and temporal types, records are decoded straight into the
+/// arrays, without parsing them into `serde_json::Value`s first.
 #[derive(Debug)]
 pub struct Reader<R: Read> {
     reader: BufReader<R>,
     /// JSON value decoder
     decoder: Decoder,
+    /// Decoder for schemas of scalar fields, used instead of `decoder` if set
+    tape: Option<TapeDecoder>,
 }
 
 impl<R: Read> Reader<R> {
@@ -1439,9 +1446,11 @@ impl<R: Read> Reader<R> {
         batch_size: usize,
         projection: Option<Vec<String>>,
     ) -> Self {
+        let tape = TapeDecoder::try_new(&schema, batch_size, projection.as_deref());
         Self {
             reader,
             decoder: Decoder::new(schema, batch_size, projection),
+            tape,
         }
     }
 
@@ -1454,8 +1463,12 @@ impl<R: Read> Reader<R> {
     /// Read the next batch of records
     #[allow(clippy::should_implement_trait)]
     pub fn next(&mut self) -> Result<Option<RecordBatch>> {
-        self.decoder
-            .next_batch(&mut ValueIter::new(&mut self.reader, None))
+        match &mut self.tape {
+            Some(tape) => tape.next_batch(&mut self.reader),
+            None => self
+                .decoder
+                .next_batch(&mut ValueIter::new(&mut self.reader, None)),
+        }
     }
 }
 
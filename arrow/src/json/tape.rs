@@ -0,0 +1,765 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Decodes line-delimited JSON straight into array builders.
+//!
+//! [`Decoder`](super::reader::Decoder) parses every record into a
+//! [`serde_json::Value`] before converting the records to columns. For schemas whose
+//! projected fields are all scalars, [`TapeDecoder`] instead scans each line once,
+//! recording the position of the value of every projected field, and appends those
+//! values to the builders of their columns. Values of other fields are validated and
+//! skipped without being allocated.
+
+use std::fmt;
+use std::io::{BufRead, BufReader, Read};
+use std::sync::Arc;
+
+use indexmap::map::IndexMap as HashMap;
+
+use crate::array::*;
+use crate::datatypes::*;
+use crate::error::{ArrowError, Result};
+use crate::record_batch::RecordBatch;
+
+/// Appends the JSON values of a field to the builder of its column.
+trait ColumnDecoder: fmt::Debug + Send {
+    /// Appends `value`, the JSON text of a valid JSON value, or a null if the field
+    /// is missing. `scratch` is a buffer to unescape strings into.
+    fn append(&mut self, value: Option<&str>, scratch: &mut String) -> Result<()>;
+
+    /// Builds the array of the values appended since the last call.
+    fn finish(&mut self) -> ArrayRef;
+}
+
+#[derive(Debug)]
+struct NullDecoder {
+    len: usize,
+}
+
+impl ColumnDecoder for NullDecoder {
+    fn append(&mut self, _value: Option<&str>, _scratch: &mut String) -> Result<()> {
+        self.len += 1;
+        Ok(())
+    }
+
+    fn finish(&mut self) -> ArrayRef {
+        let len = std::mem::replace(&mut self.len, 0);
+        Arc::new(NullArray::new(len))
+    }
+}
+
+#[derive(Debug)]
+struct BooleanDecoder {
+    builder: BooleanBuilder,
+}
+
+impl ColumnDecoder for BooleanDecoder {
+    fn append(&mut self, value: Option<&str>, _scratch: &mut String) -> Result<()> {
+        match value {
+            Some("true") => self.builder.append_value(true),
+            Some("false") => self.builder.append_value(false),
+            _ => self.builder.append_null(),
+        }
+    }
+
+    fn finish(&mut self) -> ArrayRef {
+        Arc::new(self.builder.finish())
+    }
+}
+
+#[derive(Debug)]
+struct PrimitiveDecoder<T: ArrowPrimitiveType> {
+    builder: PrimitiveBuilder<T>,
+}
+
+impl<T> ColumnDecoder for PrimitiveDecoder<T>
+where
+    T: ArrowNumericType,
+    T::Native: num::NumCast,
+{
+    fn append(&mut self, value: Option<&str>, _scratch: &mut String) -> Result<()> {
+        match value.and_then(parse_number::<T::Native>) {
+            Some(v) => self.builder.append_value(v),
+            None => self.builder.append_null(),
+        }
+    }
+
+    fn finish(&mut self) -> ArrayRef {
+        Arc::new(self.builder.finish())
+    }
+}
+
+#[derive(Debug)]
+struct StringDecoder {
+    builder: StringBuilder,
+}
+
+impl ColumnDecoder for StringDecoder {
+    fn append(&mut self, value: Option<&str>, scratch: &mut String) -> Result<()> {
+        match value {
+            Some(value) if value.starts_with('"') => {
+                let content = &value[1..value.len() - 1];
+                if content.contains('\\') {
+                    unescape(content, scratch);
+                    self.builder.append_value(scratch.as_str())
+                } else {
+                    self.builder.append_value(content)
+                }
+            }
+            _ => self.builder.append_null(),
+        }
+    }
+
+    fn finish(&mut self) -> ArrayRef {
+        Arc::new(self.builder.finish())
+    }
+}
+
+/// Parses the JSON number `value` as `N`, returning `None` if `value` is not a
+/// number or does not fit `N`.
+///
+/// Like [`Decoder`](super::reader::Decoder), fractional numbers are truncated
+/// towards zero for integer types, but integers are parsed without going through
+/// `f64` and so keep their precision.
+fn parse_number<N: num::NumCast>(value: &str) -> Option<N> {
+    let first = *value.as_bytes().first()?;
+    if first != b'-' && !first.is_ascii_digit() {
+        return None;
+    }
+    if !value.contains(|c: char| c == '.' || c == 'e' || c == 'E') {
+        if let Ok(v) = value.parse::<i64>() {
+            return num::cast(v);
+        }
+        if let Ok(v) = value.parse::<u64>() {
+            return num::cast(v);
+        }
+    }
+    value.parse::<f64>().ok().and_then(num::cast)
+}
+
+/// Returns a [`ColumnDecoder`] for `data_type` with room for `capacity` values, if
+/// `data_type` is a scalar type that [`TapeDecoder`] supports.
+fn column_decoder(
+    data_type: &DataType,
+    capacity: usize,
+) -> Option<Box<dyn ColumnDecoder>> {
+    macro_rules! primitive {
+        ($t:ty) => {
+            Box::new(PrimitiveDecoder::<$t> {
+                builder: PrimitiveBuilder::new(capacity),
+            })
+        };
+    }
+
+    let decoder: Box<dyn ColumnDecoder> = match data_type {
+        DataType::Null => Box::new(NullDecoder { len: 0 }),
+        DataType::Boolean => Box::new(BooleanDecoder {
+            builder: BooleanBuilder::new(capacity),
+        }),
+        DataType::Utf8 => Box::new(StringDecoder {
+            builder: StringBuilder::new(capacity),
+        }),
+        DataType::Int8 => primitive!(Int8Type),
+        DataType::Int16 => primitive!(Int16Type),
+        DataType::Int32 => primitive!(Int32Type),
+        DataType::Int64 => primitive!(Int64Type),
+        DataType::UInt8 => primitive!(UInt8Type),
+        DataType::UInt16 => primitive!(UInt16Type),
+        DataType::UInt32 => primitive!(UInt32Type),
+        DataType::UInt64 => primitive!(UInt64Type),
+        DataType::Float32 => primitive!(Float32Type),
+        DataType::Float64 => primitive!(Float64Type),
+        DataType::Timestamp(TimeUnit::Second, _) => primitive!(TimestampSecondType),
+        DataType::Timestamp(TimeUnit::Millisecond, _) => {
+            primitive!(TimestampMillisecondType)
+        }
+        DataType::Timestamp(TimeUnit::Microsecond, _) => {
+            primitive!(TimestampMicrosecondType)
+        }
+        DataType::Timestamp(TimeUnit::Nanosecond, _) => {
+            primitive!(TimestampNanosecondType)
+        }
+        DataType::Date32 => primitive!(Date32Type),
+        DataType::Date64 => primitive!(Date64Type),
+        DataType::Time32(TimeUnit::Second) => primitive!(Time32SecondType),
+        DataType::Time32(TimeUnit::Millisecond) => primitive!(Time32MillisecondType),
+        DataType::Time64(TimeUnit::Microsecond) => primitive!(Time64MicrosecondType),
+        DataType::Time64(TimeUnit::Nanosecond) => primitive!(Time64NanosecondType),
+        _ => return None,
+    };
+    Some(decoder)
+}
+
+/// Decodes line-delimited JSON records into [`RecordBatch`]es of scalar columns,
+/// without building a [`serde_json::Value`] for each record.
+///
+/// The values of the projected fields are interpreted like
+/// [`Decoder`](super::reader::Decoder) does: values of the wrong JSON type are
+/// decoded as nulls, and when a record repeats a key, its last value is used.
+#[derive(Debug)]
+pub(crate) struct TapeDecoder {
+    /// The projected schema of the batches
+    schema: SchemaRef,
+    /// Batch size (number of records to load each time)
+    batch_size: usize,
+    /// The index of the column of each projected field
+    columns_by_name: HashMap<String, usize>,
+    columns: Vec<Box<dyn ColumnDecoder>>,
+    /// The start and end of the value of each column in the current line
+    values: Vec<Option<(usize, usize)>>,
+    /// The closing brackets of the containers of the value being skipped
+    stack: Vec<u8>,
+    // reuse line buffer to avoid allocation on each record
+    line_buf: String,
+    scratch: String,
+}
+
+impl TapeDecoder {
+    /// Creates a decoder for the fields of `schema` in `projection`, or for all of
+    /// them if `projection` is `None` or empty. Returns `None` if any of these fields
+    /// is not of a scalar type, in which case [`Decoder`](super::reader::Decoder)
+    /// should be used.
+    pub(crate) fn try_new(
+        schema: &Schema,
+        batch_size: usize,
+        projection: Option<&[String]>,
+    ) -> Option<Self> {
+        let fields: Vec<Field> = schema
+            .fields()
+            .iter()
+            .filter(|field| match projection {
+                Some(projection) if !projection.is_empty() => {
+                    projection.contains(field.name())
+                }
+                _ => true,
+            })
+            .cloned()
+            .collect();
+        let columns = fields
+            .iter()
+            .map(|field| column_decoder(field.data_type(), batch_size))
+            .collect::<Option<Vec<_>>>()?;
+        let columns_by_name = fields
+            .iter()
+            .enumerate()
+            .map(|(i, field)| (field.name().clone(), i))
+            .collect();
+
+        Some(Self {
+            schema: Arc::new(Schema::new(fields)),
+            batch_size,
+            columns_by_name,
+            values: vec![None; columns.len()],
+            columns,
+            stack: Vec::new(),
+            line_buf: String::new(),
+            scratch: String::new(),
+        })
+    }
+
+    /// Read the next batch of records from `reader`
+    pub(crate) fn next_batch<R: Read>(
+        &mut self,
+        reader: &mut BufReader<R>,
+    ) -> Result<Option<RecordBatch>> {
+        let mut rows = 0;
+        while rows < self.batch_size {
+            self.line_buf.truncate(0);
+            match reader.read_line(&mut self.line_buf) {
+                // read_line returns 0 when stream reached EOF
+                Ok(0) => break,
+                Ok(_) => {}
+                Err(e) => {
+                    self.discard();
+                    return Err(ArrowError::JsonError(format!(
+                        "Failed to read JSON record: {}",
+                        e
+                    )));
+                }
+            }
+            if self.line_buf.trim().is_empty() {
+                // ignore empty lines
+                continue;
+            }
+            if let Err(e) = self.decode_line() {
+                self.discard();
+                return Err(e);
+            }
+            rows += 1;
+        }
+        if rows == 0 {
+            // reached end of file
+            return Ok(None);
+        }
+
+        let arrays = self.columns.iter_mut().map(|c| c.finish()).collect();
+        RecordBatch::try_new(self.schema.clone(), arrays).map(Some)
+    }
+
+    /// Drops the values appended to the builders for the current batch.
+    fn discard(&mut self) {
+        self.columns.iter_mut().for_each(|c| {
+            c.finish();
+        });
+    }
+
+    /// Appends the record in `line_buf` to the builders.
+    fn decode_line(&mut self) -> Result<()> {
+        let line = self.line_buf.as_str();
+        let bytes = line.as_bytes();
+        self.values.iter_mut().for_each(|v| *v = None);
+
+        let mut pos = skip_whitespace(bytes, 0);
+        if bytes.get(pos) != Some(&b'{') {
+            let end = skip_value(&mut self.stack, bytes, pos)?;
+            return Err(ArrowError::JsonError(format!(
+                "Row needs to be of type object, got: {}",
+                &line[pos..end]
+            )));
+        }
+        pos = skip_whitespace(bytes, pos + 1);
+        if bytes.get(pos) == Some(&b'}') {
+            pos += 1;
+        } else {
+            loop {
+                if bytes.get(pos) != Some(&b'"') {
+                    return Err(syntax_error("expected `\"`", pos));
+                }
+                let (end, escaped) = skip_string(bytes, pos)?;
+                let key = &line[pos + 1..end - 1];
+                let column = if escaped {
+                    unescape(key, &mut self.scratch);
+                    self.columns_by_name.get(self.scratch.as_str()).copied()
+                } else {
+                    self.columns_by_name.get(key).copied()
+                };
+
+                pos = skip_whitespace(bytes, end);
+                if bytes.get(pos) != Some(&b':') {
+                    return Err(syntax_error("expected `:`", pos));
+                }
+                pos = skip_whitespace(bytes, pos + 1);
+                let end = skip_value(&mut self.stack, bytes, pos)?;
+                if let Some(column) = column {
+                    self.values[column] = Some((pos, end));
+                }
+
+                pos = skip_whitespace(bytes, end);
+                match bytes.get(pos) {
+                    Some(b',') => pos = skip_whitespace(bytes, pos + 1),
+                    Some(b'}') => {
+                        pos += 1;
+                        break;
+                    }
+                    _ => return Err(syntax_error("expected `,` or `}`", pos)),
+                }
+            }
+        }
+        if skip_whitespace(bytes, pos) != bytes.len() {
+            return Err(syntax_error("trailing characters", pos));
+        }
+
+        for (column, value) in self.columns.iter_mut().zip(&self.values) {
+            let value = value.map(|(start, end)| &line[start..end]);
+            column.append(value, &mut self.scratch)?;
+        }
+        Ok(())
+    }
+}
+
+fn syntax_error(msg: &str, pos: usize) -> ArrowError {
+    ArrowError::JsonError(format!("Not valid JSON: {} at column {}", msg, pos + 1))
+}
+
+fn skip_whitespace(bytes: &[u8], mut pos: usize) -> usize {
+    while let Some(b' ') | Some(b'\t') | Some(b'\n') | Some(b'\r') = bytes.get(pos) {
+        pos += 1;
+    }
+    pos
+}
+
+/// Validates the JSON value starting at `pos` and returns the position after it.
+///
+/// Arrays and objects are scanned iteratively, with `stack` holding the closing
+/// bracket of each container entered, and are not allocated.
+fn skip_value(stack: &mut Vec<u8>, bytes: &[u8], mut pos: usize) -> Result<usize> {
+    stack.clear();
+    loop {
+        // scan a value, or enter a non-empty container
+        match bytes.get(pos) {
+            Some(b'{') => {
+                pos = skip_whitespace(bytes, pos + 1);
+                if bytes.get(pos) == Some(&b'}') {
+                    pos += 1;
+                } else {
+                    stack.push(b'}');
+                    pos = skip_key(bytes, pos)?;
+                    continue;
+                }
+            }
+            Some(b'[') => {
+                pos = skip_whitespace(bytes, pos + 1);
+                if bytes.get(pos) == Some(&b']') {
+                    pos += 1;
+                } else {
+                    stack.push(b']');
+                    continue;
+                }
+            }
+            Some(b'"') => pos = skip_string(bytes, pos)?.0,
+            Some(b't') => pos = skip_literal(bytes, pos, b"true")?,
+            Some(b'f') => pos = skip_literal(bytes, pos, b"false")?,
+            Some(b'n') => pos = skip_literal(bytes, pos, b"null")?,
+            Some(b'-') | Some(b'0'..=b'9') => pos = skip_number(bytes, pos)?,
+            _ => return Err(syntax_error("expected value", pos)),
+        }
+
+        // leave the containers that end after the value
+        loop {
+            let close = match stack.last() {
+                Some(close) => *close,
+                None => return Ok(pos),
+            };
+            pos = skip_whitespace(bytes, pos);
+            match bytes.get(pos) {
+                Some(b',') => {
+                    pos = skip_whitespace(bytes, pos + 1);
+                    if close == b'}' {
+                        pos = skip_key(bytes, pos)?;
+                    }
+                    break;
+                }
+                Some(c) if *c == close => {
+                    stack.pop();
+                    pos += 1;
+                }
+                _ => return Err(syntax_error("expected `,` or closing bracket", pos)),
+            }
+        }
+    }
+}
+
+/// Validates the object key and `:` starting at `pos` and returns the position of
+/// the value after them.
+fn skip_key(bytes: &[u8], pos: usize) -> Result<usize> {
+    if bytes.get(pos) != Some(&b'"') {
+        return Err(syntax_error("expected `\"`", pos));
+    }
+    let pos = skip_whitespace(bytes, skip_string(bytes, pos)?.0);
+    if bytes.get(pos) != Some(&b':') {
+        return Err(syntax_error("expected `:`", pos));
+    }
+    Ok(skip_whitespace(bytes, pos + 1))
+}
+
+/// Validates the string starting with the `"` at `pos` and returns the position
+/// after its closing `"`, and whether it contains escape sequences.
+fn skip_string(bytes: &[u8], mut pos: usize) -> Result<(usize, bool)> {
+    let mut escaped = false;
+    pos += 1;
+    loop {
+        match bytes.get(pos) {
+            Some(b'"') => return Ok((pos + 1, escaped)),
+            Some(b'\\') => {
+                escaped = true;
+                match bytes.get(pos + 1) {
+                    Some(b'"') | Some(b'\\') | Some(b'/') | Some(b'b') | Some(b'f')
+                    | Some(b'n') | Some(b'r') | Some(b't') => pos += 2,
+                    Some(b'u') => match hex_escape(bytes, pos) {
+                        Some(0xD800..=0xDBFF) => match hex_escape(bytes, pos + 6) {
+                            Some(0xDC00..=0xDFFF) => pos += 12,
+                            _ => {
+                                return Err(syntax_error(
+                                    "lone leading surrogate in hex escape",
+                                    pos,
+                                ))
+                            }
+                        },
+                        Some(0xDC00..=0xDFFF) => {
+                            return Err(syntax_error(
+                                "lone trailing surrogate in hex escape",
+                                pos,
+                            ))
+                        }
+                        Some(_) => pos += 6,
+                        None => return Err(syntax_error("invalid escape", pos)),
+                    },
+                    _ => return Err(syntax_error("invalid escape", pos)),
+                }
+            }
+            Some(b) if *b < 0x20 => {
+                return Err(syntax_error("control character in string", pos))
+            }
+            Some(_) => pos += 1,
+            None => return Err(syntax_error("EOF while parsing a string", pos)),
+        }
+    }
+}
+
+/// Returns the code unit of the `\uXXXX` escape at `pos`, if any.
+fn hex_escape(bytes: &[u8], pos: usize) -> Option<u32> {
+    let escape = bytes.get(pos..pos + 6)?;
+    if &escape[..2] != b"\\u" || !escape[2..].iter().all(|b| b.is_ascii_hexdigit()) {
+        return None;
+    }
+    // hex digits are ASCII
+    let hex = std::str::from_utf8(&escape[2..]).unwrap();
+    u32::from_str_radix(hex, 16).ok()
+}
+
+fn skip_literal(bytes: &[u8], pos: usize, literal: &[u8]) -> Result<usize> {
+    let end = pos + literal.len();
+    if bytes.get(pos..end) == Some(literal) {
+        Ok(end)
+    } else {
+        Err(syntax_error("expected value", pos))
+    }
+}
+
+fn skip_number(bytes: &[u8], mut pos: usize) -> Result<usize> {
+    fn skip_digits(bytes: &[u8], mut pos: usize) -> Result<usize> {
+        let start = pos;
+        while let Some(b'0'..=b'9') = bytes.get(pos) {
+            pos += 1;
+        }
+        if pos == start {
+            return Err(syntax_error("invalid number", pos));
+        }
+        Ok(pos)
+    }
+
+    if bytes.get(pos) == Some(&b'-') {
+        pos += 1;
+    }
+    pos = match bytes.get(pos) {
+        Some(b'0') => pos + 1,
+        _ => skip_digits(bytes, pos)?,
+    };
+    if bytes.get(pos) == Some(&b'.') {
+        pos = skip_digits(bytes, pos + 1)?;
+    }
+    if let Some(b'e') | Some(b'E') = bytes.get(pos) {
+        pos += 1;
+        if let Some(b'+') | Some(b'-') = bytes.get(pos) {
+            pos += 1;
+        }
+        pos = skip_digits(bytes, pos)?;
+    }
+    Ok(pos)
+}
+
+/// Writes the content of the JSON string `escaped`, validated by [`skip_string`],
+/// to `out`.
+fn unescape(escaped: &str, out: &mut String) {
+    let bytes = escaped.as_bytes();
+    out.clear();
+    let mut rest = 0;
+    while let Some(i) = escaped[rest..].find('\\') {
+        let i = rest + i;
+        out.push_str(&escaped[rest..i]);
+        let (c, len) = match bytes[i + 1] {
+            b'"' => ('"', 2),
+            b'\\' => ('\\', 2),
+            b'/' => ('/', 2),
+            b'b' => ('\x08', 2),
+            b'f' => ('\x0c', 2),
+            b'n' => ('\n', 2),
+            b'r' => ('\r', 2),
+            b't' => ('\t', 2),
+            // `u`, followed by a trailing surrogate if this is a leading one
+            _ => {
+                let high = hex_escape(bytes, i).unwrap();
+                let (code, len) = if (0xD800..0xDC00).contains(&high) {
+                    let low = hex_escape(bytes, i + 6).unwrap();
+                    (0x10000 + ((high - 0xD800) << 10) + (low - 0xDC00), 12)
+                } else {
+                    (high, 6)
+                };
+                (std::char::from_u32(code).unwrap(), len)
+            }
+        };
+        out.push(c);
+        rest = i + len;
+    }
+    out.push_str(&escaped[rest..]);
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use std::fs::File;
+    use std::io::Cursor;
+
+    use crate::json::reader::{Decoder, ValueIter};
+
+    /// Decodes `json` with both a [`TapeDecoder`] and a [`Decoder`], checks that
+    /// they agree and returns the batches.
+    fn decode_both(
+        json: &str,
+        schema: Schema,
+        batch_size: usize,
+        projection: Option<Vec<String>>,
+    ) -> Vec<RecordBatch> {
+        let mut tape =
+            TapeDecoder::try_new(&schema, batch_size, projection.as_deref()).unwrap();
+        let decoder = Decoder::new(Arc::new(schema), batch_size, projection);
+
+        let mut tape_reader = BufReader::new(Cursor::new(json.as_bytes()));
+        let mut value_reader = BufReader::new(Cursor::new(json.as_bytes()));
+        let mut batches = vec![];
+        loop {
+            let batch = tape.next_batch(&mut tape_reader).unwrap();
+            let expected = decoder
+                .next_batch(&mut ValueIter::new(&mut value_reader, None))
+                .unwrap();
+            match (batch, expected) {
+                (Some(batch), Some(expected)) => {
+                    assert_eq!(batch.schema(), expected.schema());
+                    assert_eq!(batch.columns(), expected.columns());
+                    batches.push(batch);
+                }
+                (None, None) => return batches,
+                (batch, expected) => panic!("{:?} != {:?}", batch, expected),
+            }
+        }
+    }
+
+    #[test]
+    fn test_tape_files() {
+        for path in &["test/data/basic.json", "test/data/basic_nulls.json"] {
+            let mut reader = BufReader::new(File::open(path).unwrap());
+            let schema =
+                crate::json::reader::infer_json_schema(&mut reader, None).unwrap();
+            let json = std::fs::read_to_string(path).unwrap();
+            for batch_size in &[1, 5, 1024] {
+                decode_both(&json, schema.clone(), *batch_size, None);
+                decode_both(
+                    &json,
+                    schema.clone(),
+                    *batch_size,
+                    Some(vec!["a".to_string(), "d".to_string()]),
+                );
+            }
+        }
+    }
+
+    #[test]
+    fn test_tape_types() {
+        let schema = Schema::new(vec![
+            Field::new("n", DataType::Null, true),
+            Field::new("b", DataType::Boolean, true),
+            Field::new("i8", DataType::Int8, true),
+            Field::new("u32", DataType::UInt32, true),
+            Field::new("f32", DataType::Float32, true),
+            Field::new("s", DataType::Utf8, true),
+            Field::new("ts", DataType::Timestamp(TimeUnit::Millisecond, None), true),
+            Field::new("d", DataType::Date32, true),
+        ]);
+        let json = r#"
+            {"n": null, "b": true, "i8": 1, "u32": 5.0, "f32": 1.5, "s": "a", "ts": 1, "d": 2}
+            {"b": "true", "i8": 300, "u32": -1, "f32": "1.5", "s": 1, "ts": 1.2e3}
+            {"n": 1, "b": false, "i8": -2.7, "u32": 3e2, "f32": 0, "s": null, "d": null}
+
+            {"b": [true], "i8": {"a": 1}, "u32": false, "s": "\"\\\/\b\f\n\r\t\u00e9\ud83d\ude00"}
+            {"s": "a", "s": "b", "unknown": {"x": [1, {"y": "\u0000"}, []], "z": {}}}
+            {}
+        "#;
+        let batches = decode_both(json, schema, 4, None);
+        assert_eq!(batches.len(), 2);
+
+        let strings = batches[1].column(5);
+        let strings = strings.as_any().downcast_ref::<StringArray>().unwrap();
+        assert_eq!(strings.value(0), "\"\\/\u{8}\u{c}\n\r\té😀");
+        assert_eq!(strings.value(1), "b");
+        assert!(strings.is_null(2));
+    }
+
+    #[test]
+    fn test_tape_precision() {
+        let schema = Schema::new(vec![
+            Field::new("i", DataType::Int64, true),
+            Field::new("u", DataType::UInt64, true),
+        ]);
+        let json = "{\"i\": 9007199254740993, \"u\": 18446744073709551615}\n";
+        let mut tape = TapeDecoder::try_new(&schema, 1024, None).unwrap();
+        let batch = tape
+            .next_batch(&mut BufReader::new(Cursor::new(json)))
+            .unwrap()
+            .unwrap();
+        let i = batch
+            .column(0)
+            .as_any()
+            .downcast_ref::<Int64Array>()
+            .unwrap();
+        assert_eq!(i.value(0), 9007199254740993);
+        let u = batch
+            .column(1)
+            .as_any()
+            .downcast_ref::<UInt64Array>()
+            .unwrap();
+        assert_eq!(u.value(0), std::u64::MAX);
+    }
+
+    #[test]
+    fn test_tape_unsupported_types() {
+        let schema = Schema::new(vec![
+            Field::new("a", DataType::Int64, true),
+            Field::new(
+                "b",
+                DataType::List(Box::new(Field::new("item", DataType::Int64, true))),
+                true,
+            ),
+        ]);
+        assert!(TapeDecoder::try_new(&schema, 1024, None).is_none());
+        let projection = vec!["a".to_string()];
+        assert!(TapeDecoder::try_new(&schema, 1024, Some(&projection)).is_some());
+    }
+
+    #[test]
+    fn test_tape_invalid() {
+        let schema = Schema::new(vec![Field::new("a", DataType::Int64, true)]);
+        let invalid = [
+            "[1]",
+            "{\"a\": 1",
+            "{\"a\": 1,}",
+            "{\"a\" 1}",
+            "{\"a\": 01}",
+            "{\"a\": 1.}",
+            "{\"a\": tru}",
+            "{\"a\": 1} 2",
+            "{\"b\": [1, 2}",
+            "{\"b\": {\"c\" 1}}",
+            "{\"b\": \"\\x\"}",
+            "{\"b\": \"\\ud83d\"}",
+            "{\"b\": \"\\udc00\"}",
+            "{\"b\": \"abc}",
+        ];
+        for json in &invalid {
+            let mut tape = TapeDecoder::try_new(&schema, 1024, None).unwrap();
+            let mut reader = BufReader::new(Cursor::new(json.as_bytes()));
+            assert!(tape.next_batch(&mut reader).is_err(), "{}", json);
+        }
+
+        let mut tape = TapeDecoder::try_new(&schema, 1024, None).unwrap();
+        let mut reader = BufReader::new(Cursor::new("[1]\n"));
+        assert_eq!(
+            tape.next_batch(&mut reader).unwrap_err().to_string(),
+            "Json error: Row needs to be of type object, got: [1]"
+        );
+    }
+}
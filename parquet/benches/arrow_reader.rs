@@ -0,0 +1,317 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Benchmarks reading parquet files written in memory, through
+//! [`ParquetFileArrowReader`] and through the typed column readers, for columns of
+//! different types, encodings, null densities and nesting.
+
+#[macro_use]
+extern crate criterion;
+use criterion::{BenchmarkId, Criterion, Throughput};
+
+extern crate arrow;
+extern crate parquet;
+
+use std::sync::Arc;
+
+use arrow::datatypes::*;
+use arrow::{record_batch::RecordBatch, util::data_gen::*};
+use parquet::{
+    arrow::{ArrowReader, ArrowWriter, ParquetFileArrowReader},
+    basic::Encoding,
+    column::reader::get_typed_column_reader,
+    data_type::{ByteArrayType, DataType as ParquetType, Int32Type},
+    errors::Result,
+    file::{
+        properties::WriterProperties,
+        reader::{FileReader, SerializedFileReader},
+        serialized_reader::SliceableCursor,
+        writer::InMemoryWriteableCursor,
+    },
+};
+
+const NUM_ROWS: usize = 64 * 1024;
+
+fn create_batch(fields: Vec<Field>, null_density: f32) -> RecordBatch {
+    let schema = Arc::new(Schema::new(fields));
+    create_random_batch(schema, NUM_ROWS, null_density, 0.5).unwrap()
+}
+
+/// Writes `batch` to a parquet file in memory with the properties `props`, in row
+/// groups of `NUM_ROWS / 2` rows.
+fn write_file(batch: &RecordBatch, props: WriterProperties) -> Vec<u8> {
+    let cursor = InMemoryWriteableCursor::default();
+    let mut writer =
+        ArrowWriter::try_new(cursor.clone(), batch.schema(), Some(props)).unwrap();
+    // the writer never splits a batch into row groups, so each half is written on its own
+    let half = batch.num_rows() / 2;
+    for (offset, len) in vec![(0, half), (half, batch.num_rows() - half)] {
+        let columns = batch
+            .columns()
+            .iter()
+            .map(|column| column.slice(offset, len))
+            .collect();
+        let half = RecordBatch::try_new(batch.schema(), columns).unwrap();
+        writer.write(&half).unwrap();
+    }
+    writer.close().unwrap();
+    cursor.data()
+}
+
+fn plain_props(encoding: Encoding) -> WriterProperties {
+    WriterProperties::builder()
+        .set_dictionary_enabled(false)
+        .set_encoding(encoding)
+        .set_max_row_group_size(NUM_ROWS / 2)
+        .build()
+}
+
+fn dictionary_props() -> WriterProperties {
+    WriterProperties::builder()
+        .set_dictionary_enabled(true)
+        .set_max_row_group_size(NUM_ROWS / 2)
+        .build()
+}
+
+/// Reads all the batches of the columns `projection` (all of them if `None`) of the
+/// file `data`, and returns the number of rows read.
+fn read_file(
+    data: &[u8],
+    projection: Option<&[usize]>,
+    batch_size: usize,
+) -> Result<usize> {
+    let file_reader = SerializedFileReader::new(SliceableCursor::new(data.to_vec()))?;
+    let mut arrow_reader = ParquetFileArrowReader::new(Arc::new(file_reader));
+    let record_reader = match projection {
+        Some(projection) => arrow_reader
+            .get_record_reader_by_columns(projection.iter().cloned(), batch_size)?,
+        None => arrow_reader.get_record_reader(batch_size)?,
+    };
+    let mut num_rows = 0;
+    for batch in record_reader {
+        num_rows += batch?.num_rows();
+    }
+    Ok(num_rows)
+}
+
+/// Reads all the values and definition levels of the first column of the file `data`,
+/// of the physical type `T`, with the typed column reader, and returns the number of
+/// levels read.
+fn read_column<T: ParquetType>(data: &[u8], batch_size: usize) -> Result<usize> {
+    let file_reader = SerializedFileReader::new(SliceableCursor::new(data.to_vec()))?;
+    let mut def_levels = vec![0; batch_size];
+    let mut values = vec![T::T::default(); batch_size];
+    let mut num_levels = 0;
+    for i in 0..file_reader.num_row_groups() {
+        let row_group = file_reader.get_row_group(i)?;
+        let mut column_reader =
+            get_typed_column_reader::<T>(row_group.get_column_reader(0)?);
+        loop {
+            let (_, levels_read) = column_reader.read_batch(
+                batch_size,
+                Some(&mut def_levels[..]),
+                None,
+                &mut values,
+            )?;
+            if levels_read == 0 {
+                break;
+            }
+            num_levels += levels_read;
+        }
+    }
+    Ok(num_levels)
+}
+
+/// Benchmarks reading files of a single column of each type, written with the
+/// encodings that apply to it, at different null densities.
+fn bench_encodings(c: &mut Criterion) {
+    let cases: Vec<(&str, DataType, Vec<(&str, WriterProperties)>)> = vec![
+        (
+            "int32",
+            DataType::Int32,
+            vec![
+                ("plain", plain_props(Encoding::PLAIN)),
+                ("dictionary", dictionary_props()),
+                ("delta", plain_props(Encoding::DELTA_BINARY_PACKED)),
+            ],
+        ),
+        (
+            "int64",
+            DataType::Int64,
+            vec![
+                ("plain", plain_props(Encoding::PLAIN)),
+                ("dictionary", dictionary_props()),
+                ("delta", plain_props(Encoding::DELTA_BINARY_PACKED)),
+            ],
+        ),
+        (
+            "float64",
+            DataType::Float64,
+            vec![
+                ("plain", plain_props(Encoding::PLAIN)),
+                ("dictionary", dictionary_props()),
+            ],
+        ),
+        (
+            "boolean",
+            DataType::Boolean,
+            vec![
+                ("plain", plain_props(Encoding::PLAIN)),
+                ("rle", plain_props(Encoding::RLE)),
+            ],
+        ),
+        (
+            "utf8",
+            DataType::Utf8,
+            vec![
+                ("plain", plain_props(Encoding::PLAIN)),
+                ("dictionary", dictionary_props()),
+                (
+                    "delta_length",
+                    plain_props(Encoding::DELTA_LENGTH_BYTE_ARRAY),
+                ),
+                ("delta", plain_props(Encoding::DELTA_BYTE_ARRAY)),
+            ],
+        ),
+    ];
+
+    for (type_name, data_type, encodings) in cases {
+        let mut group = c.benchmark_group(format!("read {}", type_name));
+        group.throughput(Throughput::Elements(NUM_ROWS as u64));
+        for &null_density in &[0.0, 0.5] {
+            let batch = create_batch(
+                vec![Field::new("col", data_type.clone(), true)],
+                null_density,
+            );
+            for (encoding, props) in &encodings {
+                let data = write_file(&batch, props.clone());
+                group.bench_function(
+                    BenchmarkId::new(*encoding, format!("{} nulls", null_density)),
+                    |b| b.iter(|| read_file(&data, None, 8192).unwrap()),
+                );
+            }
+        }
+        group.finish();
+    }
+}
+
+/// Benchmarks reading files of lists and structs.
+fn bench_nested(c: &mut Criterion) {
+    let cases = vec![
+        (
+            "list<int32>",
+            DataType::List(Box::new(Field::new("item", DataType::Int32, true))),
+        ),
+        (
+            "list<utf8>",
+            DataType::List(Box::new(Field::new("item", DataType::Utf8, true))),
+        ),
+        (
+            "struct<int32, utf8>",
+            DataType::Struct(vec![
+                Field::new("a", DataType::Int32, true),
+                Field::new("b", DataType::Utf8, true),
+            ]),
+        ),
+    ];
+
+    let mut group = c.benchmark_group("read nested");
+    group.throughput(Throughput::Elements(NUM_ROWS as u64));
+    for (type_name, data_type) in cases {
+        for &null_density in &[0.0, 0.5] {
+            let batch = create_batch(
+                vec![Field::new("col", data_type.clone(), true)],
+                null_density,
+            );
+            let data = write_file(&batch, dictionary_props());
+            group.bench_function(
+                BenchmarkId::new(type_name, format!("{} nulls", null_density)),
+                |b| b.iter(|| read_file(&data, None, 8192).unwrap()),
+            );
+        }
+    }
+    group.finish();
+}
+
+/// Benchmarks scanning all the columns or a projection of a file of many columns, with
+/// different batch sizes.
+fn bench_scan(c: &mut Criterion) {
+    let fields = vec![
+        Field::new("_1", DataType::Int8, true),
+        Field::new("_2", DataType::Int16, true),
+        Field::new("_3", DataType::Int32, true),
+        Field::new("_4", DataType::Int64, true),
+        Field::new("_5", DataType::UInt32, true),
+        Field::new("_6", DataType::Float32, true),
+        Field::new("_7", DataType::Float64, true),
+        Field::new("_8", DataType::Date32, true),
+        Field::new("_9", DataType::Timestamp(TimeUnit::Microsecond, None), true),
+        Field::new("_10", DataType::Utf8, true),
+        Field::new("_11", DataType::Boolean, true),
+    ];
+    let batch = create_batch(fields, 0.25);
+    let data = write_file(&batch, dictionary_props());
+
+    let mut group = c.benchmark_group("scan file");
+    group.throughput(Throughput::Elements(NUM_ROWS as u64));
+    for &batch_size in &[1024, 8192, 65536] {
+        group.bench_function(BenchmarkId::new("all columns", batch_size), |b| {
+            b.iter(|| read_file(&data, None, batch_size).unwrap())
+        });
+        group.bench_function(BenchmarkId::new("2 of 11 columns", batch_size), |b| {
+            b.iter(|| read_file(&data, Some(&[2, 9]), batch_size).unwrap())
+        });
+    }
+    group.finish();
+}
+
+/// Benchmarks reading the values and levels of a column with the typed column readers,
+/// without building arrays.
+fn bench_column_reader(c: &mut Criterion) {
+    let mut group = c.benchmark_group("column reader");
+    group.throughput(Throughput::Elements(NUM_ROWS as u64));
+    for &null_density in &[0.0, 0.5] {
+        let int32_batch =
+            create_batch(vec![Field::new("col", DataType::Int32, true)], null_density);
+        let utf8_batch =
+            create_batch(vec![Field::new("col", DataType::Utf8, true)], null_density);
+        for (encoding, props) in vec![
+            ("plain", plain_props(Encoding::PLAIN)),
+            ("dictionary", dictionary_props()),
+        ] {
+            let parameter = format!("{} {} nulls", encoding, null_density);
+            let data = write_file(&int32_batch, props.clone());
+            group.bench_function(BenchmarkId::new("int32", &parameter), |b| {
+                b.iter(|| read_column::<Int32Type>(&data, 1024).unwrap())
+            });
+            let data = write_file(&utf8_batch, props);
+            group.bench_function(BenchmarkId::new("byte array", &parameter), |b| {
+                b.iter(|| read_column::<ByteArrayType>(&data, 1024).unwrap())
+            });
+        }
+    }
+    group.finish();
+}
+
+criterion_group!(
+    benches,
+    bench_encodings,
+    bench_nested,
+    bench_scan,
+    bench_column_reader
+);
+criterion_main!(benches);
@@ -0,0 +1,256 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Benchmarks the decoders of each encoding on the values of a page, and the
+//! decompression of the compression codecs.
+
+#[macro_use]
+extern crate criterion;
+use criterion::{BenchmarkGroup, BenchmarkId, Criterion, Throughput};
+
+extern crate parquet;
+
+use std::sync::Arc;
+
+use criterion::measurement::WallTime;
+use rand::{rngs::StdRng, Rng, SeedableRng};
+
+use parquet::{
+    basic::{Compression, Encoding, Type as PhysicalType},
+    compression::{create_codec, Codec},
+    data_type::{BoolType, ByteArray, ByteArrayType, DataType, Int32Type, Int64Type},
+    decoding::{get_decoder, Decoder, DictDecoder, PlainDecoder},
+    encoding::{get_encoder, DictEncoder, Encoder},
+    memory::{ByteBufferPtr, MemTracker},
+    schema::types::{ColumnDescPtr, ColumnDescriptor, ColumnPath, Type as SchemaType},
+};
+
+const NUM_VALUES: usize = 64 * 1024;
+
+fn column_desc(physical_type: PhysicalType) -> ColumnDescPtr {
+    let primitive_type = SchemaType::primitive_type_builder("col", physical_type)
+        .build()
+        .unwrap();
+    Arc::new(ColumnDescriptor::new(
+        Arc::new(primitive_type),
+        0,
+        0,
+        ColumnPath::new(vec![]),
+    ))
+}
+
+/// A page of values encoded with an encoding, and its dictionary page and number of
+/// dictionary values for dictionary encodings.
+struct EncodedPage {
+    encoding: Encoding,
+    dictionary: Option<(ByteBufferPtr, usize)>,
+    data: ByteBufferPtr,
+}
+
+fn encode<T: DataType>(
+    desc: &ColumnDescPtr,
+    encoding: Encoding,
+    values: &[T::T],
+) -> EncodedPage {
+    let mem_tracker = Arc::new(MemTracker::new());
+    match encoding {
+        Encoding::RLE_DICTIONARY => {
+            let mut encoder = DictEncoder::<T>::new(desc.clone(), mem_tracker);
+            encoder.put(values).unwrap();
+            let dictionary = encoder.write_dict().unwrap();
+            EncodedPage {
+                encoding,
+                dictionary: Some((dictionary, encoder.num_entries())),
+                data: encoder.write_indices().unwrap(),
+            }
+        }
+        _ => {
+            let mut encoder =
+                get_encoder::<T>(desc.clone(), encoding, mem_tracker).unwrap();
+            encoder.put(values).unwrap();
+            EncodedPage {
+                encoding,
+                dictionary: None,
+                data: encoder.flush_buffer().unwrap(),
+            }
+        }
+    }
+}
+
+/// Decodes all the values of `page`, `buffer.len()` values at a time.
+fn decode<T: DataType>(
+    desc: &ColumnDescPtr,
+    page: &EncodedPage,
+    buffer: &mut [T::T],
+) -> usize {
+    let mut decoder: Box<dyn Decoder<T>> = match &page.dictionary {
+        Some((dictionary, num_entries)) => {
+            let mut dictionary_decoder = PlainDecoder::<T>::new(desc.type_length());
+            dictionary_decoder
+                .set_data(dictionary.all(), *num_entries)
+                .unwrap();
+            let mut decoder = DictDecoder::<T>::new();
+            decoder.set_dict(Box::new(dictionary_decoder)).unwrap();
+            Box::new(decoder)
+        }
+        None => get_decoder::<T>(desc.clone(), page.encoding).unwrap(),
+    };
+    decoder.set_data(page.data.all(), NUM_VALUES).unwrap();
+
+    let mut num_values = 0;
+    loop {
+        let values_read = decoder.get(buffer).unwrap();
+        if values_read == 0 {
+            return num_values;
+        }
+        num_values += values_read;
+    }
+}
+
+fn bench_encodings<T: DataType>(
+    group: &mut BenchmarkGroup<WallTime>,
+    physical_type: PhysicalType,
+    values: &[T::T],
+    encodings: &[(&str, Encoding)],
+) {
+    let desc = column_desc(physical_type);
+    for (name, encoding) in encodings {
+        let page = encode::<T>(&desc, *encoding, values);
+        for &batch_size in &[1024, 8192] {
+            let mut buffer = vec![T::T::default(); batch_size];
+            group.bench_function(BenchmarkId::new(*name, batch_size), |b| {
+                b.iter(|| decode::<T>(&desc, &page, &mut buffer))
+            });
+        }
+    }
+}
+
+fn random_strings(rng: &mut StdRng, num_distinct: usize) -> Vec<ByteArray> {
+    let distinct: Vec<Vec<u8>> = (0..num_distinct)
+        .map(|_| {
+            let len = rng.gen_range(4..32);
+            (0..len).map(|_| rng.gen_range(b'a'..=b'z')).collect()
+        })
+        .collect();
+    (0..NUM_VALUES)
+        .map(|_| ByteArray::from(distinct[rng.gen_range(0..num_distinct)].clone()))
+        .collect()
+}
+
+fn bench_decoders(c: &mut Criterion) {
+    let mut rng = StdRng::seed_from_u64(42);
+
+    let mut group = c.benchmark_group("decode int32");
+    group.throughput(Throughput::Elements(NUM_VALUES as u64));
+    let values: Vec<i32> = (0..NUM_VALUES).map(|_| rng.gen_range(0..1000)).collect();
+    bench_encodings::<Int32Type>(
+        &mut group,
+        PhysicalType::INT32,
+        &values,
+        &[
+            ("plain", Encoding::PLAIN),
+            ("dictionary", Encoding::RLE_DICTIONARY),
+            ("delta", Encoding::DELTA_BINARY_PACKED),
+        ],
+    );
+    // increasing values, which delta encoding is intended for
+    let values: Vec<i32> = (0..NUM_VALUES as i32).map(|i| i * 3).collect();
+    bench_encodings::<Int32Type>(
+        &mut group,
+        PhysicalType::INT32,
+        &values,
+        &[("delta sorted", Encoding::DELTA_BINARY_PACKED)],
+    );
+    group.finish();
+
+    let mut group = c.benchmark_group("decode int64");
+    group.throughput(Throughput::Elements(NUM_VALUES as u64));
+    let values: Vec<i64> = (0..NUM_VALUES).map(|_| rng.gen_range(0..1000)).collect();
+    bench_encodings::<Int64Type>(
+        &mut group,
+        PhysicalType::INT64,
+        &values,
+        &[
+            ("plain", Encoding::PLAIN),
+            ("dictionary", Encoding::RLE_DICTIONARY),
+            ("delta", Encoding::DELTA_BINARY_PACKED),
+        ],
+    );
+    group.finish();
+
+    let mut group = c.benchmark_group("decode boolean");
+    group.throughput(Throughput::Elements(NUM_VALUES as u64));
+    let values: Vec<bool> = (0..NUM_VALUES).map(|_| rng.gen_bool(0.5)).collect();
+    bench_encodings::<BoolType>(
+        &mut group,
+        PhysicalType::BOOLEAN,
+        &values,
+        &[("plain", Encoding::PLAIN), ("rle", Encoding::RLE)],
+    );
+    group.finish();
+
+    let mut group = c.benchmark_group("decode byte array");
+    group.throughput(Throughput::Elements(NUM_VALUES as u64));
+    let values = random_strings(&mut rng, 1000);
+    bench_encodings::<ByteArrayType>(
+        &mut group,
+        PhysicalType::BYTE_ARRAY,
+        &values,
+        &[
+            ("plain", Encoding::PLAIN),
+            ("dictionary", Encoding::RLE_DICTIONARY),
+            ("delta_length", Encoding::DELTA_LENGTH_BYTE_ARRAY),
+            ("delta", Encoding::DELTA_BYTE_ARRAY),
+        ],
+    );
+    group.finish();
+}
+
+/// Benchmarks decompressing a page of plain encoded integers of a small range, which
+/// compress like typical column data, with each codec.
+fn bench_codecs(c: &mut Criterion) {
+    let mut rng = StdRng::seed_from_u64(42);
+    let desc = column_desc(PhysicalType::INT32);
+    let values: Vec<i32> = (0..NUM_VALUES).map(|_| rng.gen_range(0..1000)).collect();
+    let page = encode::<Int32Type>(&desc, Encoding::PLAIN, &values);
+    let data = page.data.data();
+
+    let mut group = c.benchmark_group("decompress");
+    group.throughput(Throughput::Bytes(data.len() as u64));
+    for &codec_type in &[
+        Compression::SNAPPY,
+        Compression::GZIP,
+        Compression::BROTLI,
+        Compression::LZ4,
+        Compression::ZSTD,
+    ] {
+        let mut codec = create_codec(codec_type).unwrap().unwrap();
+        let mut compressed = vec![];
+        codec.compress(data, &mut compressed).unwrap();
+        let mut decompressed = Vec::with_capacity(data.len());
+        group.bench_function(format!("{}", codec_type), |b| {
+            b.iter(|| {
+                decompressed.clear();
+                codec.decompress(&compressed, &mut decompressed).unwrap()
+            })
+        });
+    }
+    group.finish();
+}
+
+criterion_group!(benches, bench_decoders, bench_codecs);
+criterion_main!(benches);
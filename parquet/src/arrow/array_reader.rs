@@ -23,16 +23,18 @@ use std::result::Result::Ok;
 use std::sync::Arc;
 use std::vec::Vec;
 
+use arrow::alloc::MemoryPool;
 use arrow::array::{
     new_empty_array, Array, ArrayData, ArrayDataBuilder, ArrayRef, BinaryArray,
     BinaryBuilder, BooleanArray, BooleanBufferBuilder, BooleanBuilder, DecimalBuilder,
-    FixedSizeBinaryArray, FixedSizeBinaryBuilder, GenericListArray, Int16BufferBuilder,
-    Int32Array, Int64Array, OffsetSizeTrait, PrimitiveArray, PrimitiveBuilder,
-    StringArray, StringBuilder, StructArray,
+    DictionaryArray, FixedSizeBinaryArray, FixedSizeBinaryBuilder, GenericListArray,
+    Int16BufferBuilder, Int32Array, Int64Array, OffsetSizeTrait, PrimitiveArray,
+    PrimitiveBuilder, StringArray, StringBuilder, StructArray, UInt32Array,
 };
 use arrow::buffer::{Buffer, MutableBuffer};
 use arrow::datatypes::{
-    ArrowPrimitiveType, BooleanType as ArrowBooleanType, DataType as ArrowType,
+    ArrowDictionaryKeyType, ArrowNativeType, ArrowPrimitiveType,
+    BooleanType as ArrowBooleanType, DataType as ArrowType,
     Date32Type as ArrowDate32Type, Date64Type as ArrowDate64Type,
     DurationMicrosecondType as ArrowDurationMicrosecondType,
     DurationMillisecondType as ArrowDurationMillisecondType,
@@ -68,8 +70,8 @@ use crate::basic::{ConvertedType, Repetition, Type as PhysicalType};
 use crate::column::page::PageIterator;
 use crate::column::reader::ColumnReaderImpl;
 use crate::data_type::{
-    BoolType, ByteArrayType, DataType, DoubleType, FixedLenByteArrayType, FloatType,
-    Int32Type, Int64Type, Int96Type,
+    BoolType, ByteArray, ByteArrayType, DataType, DoubleType, FixedLenByteArrayType,
+    FloatType, Int32Type, Int64Type, Int96Type,
 };
 use crate::errors::{ParquetError, ParquetError::ArrowError, Result};
 use crate::file::reader::{FilePageIterator, FileReader};
@@ -89,6 +91,14 @@ pub trait ArrayReader {
     /// Reads at most `batch_size` records into an arrow array and return it.
     fn next_batch(&mut self, batch_size: usize) -> Result<ArrayRef>;
 
+    /// Skips at most `num_records` records and returns the number of records skipped.
+    ///
+    /// By default, the records are read and discarded. Readers that can skip records
+    /// without decoding them all override this.
+    fn skip_records(&mut self, num_records: usize) -> Result<usize> {
+        Ok(self.next_batch(num_records)?.len())
+    }
+
     /// Returns the definition levels of data from last call of `next_batch`.
     /// The result is used by parent array reader to calculate its own definition
     /// levels and repetition levels, so that its parent can calculate null bitmap.
@@ -206,9 +216,21 @@ pub struct PrimitiveArrayReader<T: DataType> {
 impl<T: DataType> PrimitiveArrayReader<T> {
     /// Construct primitive array reader.
     pub fn new(
+        pages: Box<dyn PageIterator>,
+        column_desc: ColumnDescPtr,
+        arrow_type: Option<ArrowType>,
+    ) -> Result<Self> {
+        Self::new_with_pool(pages, column_desc, arrow_type, None)
+    }
+
+    /// Construct primitive array reader which decodes into buffers allocated from
+    /// `pool`, if any. The arrays read keep those buffers, unless they are cast to a
+    /// different arrow type.
+    pub fn new_with_pool(
         mut pages: Box<dyn PageIterator>,
         column_desc: ColumnDescPtr,
         arrow_type: Option<ArrowType>,
+        pool: Option<Arc<dyn MemoryPool>>,
     ) -> Result<Self> {
         // Check if Arrow type is specified, else create it from Parquet type
         let data_type = match arrow_type {
@@ -218,7 +240,8 @@ impl<T: DataType> PrimitiveArrayReader<T> {
                 .clone(),
         };
 
-        let mut record_reader = RecordReader::<T>::new(column_desc.clone());
+        let mut record_reader =
+            RecordReader::<T>::try_new_with_pool(column_desc.clone(), pool)?;
         if let Some(page_reader) = pages.next() {
             record_reader.set_page_reader(page_reader?)?;
         }
@@ -289,7 +312,12 @@ impl<T: DataType> ArrayReader for PrimitiveArrayReader<T> {
         let mut record_data = self.record_reader.consume_record_data()?;
 
         if T::get_physical_type() == PhysicalType::BOOLEAN {
-            let mut boolean_buffer = BooleanBufferBuilder::new(record_data.len());
+            let mut boolean_buffer = match self.record_reader.pool() {
+                Some(pool) => {
+                    BooleanBufferBuilder::try_new_in(record_data.len(), pool.clone())?
+                }
+                None => BooleanBufferBuilder::new(record_data.len()),
+            };
 
             for e in record_data.as_slice() {
                 boolean_buffer.append(*e > 0);
@@ -390,6 +418,32 @@ impl<T: DataType> ArrayReader for PrimitiveArrayReader<T> {
         Ok(array)
     }
 
+    /// Skips at most `num_records` records, without decoding those of pages that
+    /// are skipped entirely if the column is not repeated.
+    fn skip_records(&mut self, num_records: usize) -> Result<usize> {
+        if self.column_desc.max_rep_level() > 0 {
+            return Ok(self.next_batch(num_records)?.len());
+        }
+
+        let mut records_skipped = 0usize;
+        while records_skipped < num_records {
+            let records_to_skip = num_records - records_skipped;
+            let records_skipped_once =
+                self.record_reader.skip_records(records_to_skip)?;
+            records_skipped += records_skipped_once;
+
+            // Record reader exhausted
+            if records_skipped_once < records_to_skip {
+                if let Some(page_reader) = self.pages.next() {
+                    self.record_reader.set_page_reader(page_reader?)?;
+                } else {
+                    break;
+                }
+            }
+        }
+        Ok(records_skipped)
+    }
+
     fn get_def_levels(&self) -> Option<&[i16]> {
         self.def_levels_buffer
             .as_ref()
@@ -538,6 +592,35 @@ where
         Ok(array)
     }
 
+    /// Skips at most `num_records` records, without decoding those of pages that
+    /// are skipped entirely if the column is not repeated.
+    fn skip_records(&mut self, num_records: usize) -> Result<usize> {
+        if self.column_desc.max_rep_level() > 0 {
+            return Ok(self.next_batch(num_records)?.len());
+        }
+
+        // Try to initialize column reader
+        if self.column_reader.is_none() {
+            self.next_column_reader()?;
+        }
+
+        let mut num_skipped = 0;
+        while self.column_reader.is_some() && num_skipped < num_records {
+            let num_to_skip = num_records - num_skipped;
+            let skipped = self
+                .column_reader
+                .as_mut()
+                .unwrap()
+                .skip_records(num_to_skip)?;
+            num_skipped += skipped;
+            // current page exhausted && page iterator exhausted
+            if skipped < num_to_skip && !self.next_column_reader()? {
+                break;
+            }
+        }
+        Ok(num_skipped)
+    }
+
     fn get_def_levels(&self) -> Option<&[i16]> {
         self.def_levels_buffer.as_deref()
     }
@@ -590,6 +673,362 @@ where
     }
 }
 
+/// Reads a `BYTE_ARRAY` column into Arrow dictionary arrays, keeping the Parquet
+/// dictionary encoding rather than looking up and re-hashing each value.
+///
+/// The dictionary page of a column chunk, converted by `C`, becomes the values of
+/// the dictionary arrays, and the indices of its dictionary encoded data pages their
+/// keys. A batch that spans column chunks, or includes pages that are not dictionary
+/// encoded, e.g. once a writer fell back to plain encoding, is decoded into values
+/// and cast to a dictionary array instead.
+pub struct ByteArrayDictionaryArrayReader<K, C>
+where
+    K: ArrowDictionaryKeyType,
+    C: Converter<Vec<Option<ByteArray>>, ArrayRef> + 'static,
+{
+    data_type: ArrowType,
+    pages: Box<dyn PageIterator>,
+    def_levels_buffer: Option<Vec<i16>>,
+    rep_levels_buffer: Option<Vec<i16>>,
+    column_desc: ColumnDescPtr,
+    column_reader: Option<ColumnReaderImpl<ByteArrayType>>,
+    /// Dictionary of the column chunk of `column_reader`, once read
+    dictionary: Option<ArrayRef>,
+    converter: C,
+    _key_marker: PhantomData<K>,
+}
+
+/// Values read by a [`ByteArrayDictionaryArrayReader`] from consecutive pages.
+enum DictionarySegment {
+    /// Dictionary encoded values, with their keys into `dictionary`
+    Keys {
+        dictionary: ArrayRef,
+        keys: Vec<Option<i32>>,
+    },
+    /// Values that are not dictionary encoded
+    Values(ArrayRef),
+}
+
+impl<K, C> ByteArrayDictionaryArrayReader<K, C>
+where
+    K: ArrowDictionaryKeyType,
+    C: Converter<Vec<Option<ByteArray>>, ArrayRef> + 'static,
+{
+    /// Construct byte array dictionary array reader.
+    pub fn new(
+        pages: Box<dyn PageIterator>,
+        column_desc: ColumnDescPtr,
+        converter: C,
+        data_type: ArrowType,
+    ) -> Self {
+        Self {
+            data_type,
+            pages,
+            def_levels_buffer: None,
+            rep_levels_buffer: None,
+            column_desc,
+            column_reader: None,
+            dictionary: None,
+            converter,
+            _key_marker: PhantomData,
+        }
+    }
+
+    fn next_column_reader(&mut self) -> Result<bool> {
+        self.dictionary = None;
+        Ok(match self.pages.next() {
+            Some(page) => {
+                self.column_reader = Some(ColumnReaderImpl::<ByteArrayType>::new(
+                    self.column_desc.clone(),
+                    page?,
+                ));
+                true
+            }
+            None => false,
+        })
+    }
+
+    /// Returns the dictionary of the current column chunk if its next values are
+    /// dictionary encoded, and its keys fit `K`.
+    fn current_dictionary(&mut self) -> Result<Option<ArrayRef>> {
+        let column_reader = self.column_reader.as_mut().unwrap();
+        if column_reader.is_dictionary_encoded()? != Some(true) {
+            return Ok(None);
+        }
+        if self.dictionary.is_none() {
+            let converter = &self.converter;
+            self.dictionary = column_reader
+                .dictionary()
+                .map(|values| {
+                    converter.convert(values.iter().cloned().map(Some).collect())
+                })
+                .transpose()?;
+        }
+        Ok(self.dictionary.clone().filter(|dictionary| {
+            dictionary.is_empty() || K::Native::from_usize(dictionary.len() - 1).is_some()
+        }))
+    }
+
+    /// Returns the values read, with a `None` for each definition level below the
+    /// maximum.
+    fn with_nulls<V>(
+        &self,
+        values: Vec<V>,
+        def_levels: Option<&[i16]>,
+    ) -> Vec<Option<V>> {
+        match def_levels {
+            Some(def_levels) => {
+                let max_def_level = self.column_desc.max_def_level();
+                let mut values = values.into_iter();
+                def_levels
+                    .iter()
+                    .map(|def_level| {
+                        if *def_level == max_def_level {
+                            values.next()
+                        } else {
+                            None
+                        }
+                    })
+                    .collect()
+            }
+            None => values.into_iter().map(Some).collect(),
+        }
+    }
+
+    /// Builds the array of a batch of `segments`.
+    fn build_array(&self, segments: Vec<DictionarySegment>) -> Result<ArrayRef> {
+        // The keys of a single dictionary are used as they are
+        let dictionary = match segments.first() {
+            Some(DictionarySegment::Keys { dictionary, .. }) => Some(dictionary.clone()),
+            _ => None,
+        };
+        let dictionary = dictionary.filter(|dictionary| {
+            segments.iter().all(|segment| match segment {
+                DictionarySegment::Keys {
+                    dictionary: segment_dictionary,
+                    ..
+                } => Arc::ptr_eq(dictionary, segment_dictionary),
+                DictionarySegment::Values(_) => false,
+            })
+        });
+        if let Some(dictionary) = dictionary {
+            let keys = segments
+                .iter()
+                .flat_map(|segment| match segment {
+                    DictionarySegment::Keys { keys, .. } => keys.iter(),
+                    DictionarySegment::Values(_) => unreachable!(),
+                })
+                .map(|key| key.map(|key| K::Native::from_usize(key as usize).unwrap()))
+                .collect::<PrimitiveArray<K>>();
+
+            let mut array_data = ArrayDataBuilder::new(self.data_type.clone())
+                .len(keys.len())
+                .add_buffer(keys.data().buffers()[0].clone())
+                .add_child_data(dictionary.data().clone());
+            if let Some(null_buffer) = keys.data().null_buffer() {
+                array_data = array_data.null_bit_buffer(null_buffer.clone());
+            }
+            return Ok(Arc::new(DictionaryArray::<K>::from(array_data.build())));
+        }
+
+        // Otherwise, the values are cast to a dictionary array
+        let arrays = segments
+            .into_iter()
+            .map(|segment| match segment {
+                DictionarySegment::Keys { dictionary, keys } => {
+                    let indices = keys
+                        .iter()
+                        .map(|key| key.map(|key| key as u32))
+                        .collect::<UInt32Array>();
+                    Ok(arrow::compute::take(dictionary.as_ref(), &indices, None)?)
+                }
+                DictionarySegment::Values(values) => Ok(values),
+            })
+            .collect::<Result<Vec<_>>>()?;
+        let values = match arrays.len() {
+            0 => self.converter.convert(Vec::new())?,
+            1 => arrays[0].clone(),
+            _ => arrow::compute::concat(
+                &arrays
+                    .iter()
+                    .map(|array| array.as_ref())
+                    .collect::<Vec<_>>(),
+            )?,
+        };
+        Ok(arrow::compute::cast(&values, &self.data_type)?)
+    }
+}
+
+impl<K, C> ArrayReader for ByteArrayDictionaryArrayReader<K, C>
+where
+    K: ArrowDictionaryKeyType,
+    C: Converter<Vec<Option<ByteArray>>, ArrayRef> + 'static,
+{
+    fn as_any(&self) -> &dyn Any {
+        self
+    }
+
+    fn get_data_type(&self) -> &ArrowType {
+        &self.data_type
+    }
+
+    fn next_batch(&mut self, batch_size: usize) -> Result<ArrayRef> {
+        // Try to initialize column reader
+        if self.column_reader.is_none() {
+            self.next_column_reader()?;
+        }
+
+        let mut def_levels_buffer = if self.column_desc.max_def_level() > 0 {
+            Some(vec![0; batch_size])
+        } else {
+            None
+        };
+        let mut rep_levels_buffer = if self.column_desc.max_rep_level() > 0 {
+            Some(vec![0; batch_size])
+        } else {
+            None
+        };
+
+        let mut segments = Vec::new();
+        let mut num_read = 0;
+        while self.column_reader.is_some() && num_read < batch_size {
+            // current page exhausted
+            if self
+                .column_reader
+                .as_mut()
+                .unwrap()
+                .is_dictionary_encoded()?
+                .is_none()
+            {
+                if self.next_column_reader()? {
+                    continue;
+                } else {
+                    break;
+                }
+            }
+
+            let num_to_read = batch_size - num_read;
+            let dictionary = self.current_dictionary()?;
+            let cur_def_levels_buf =
+                def_levels_buffer.as_mut().map(|b| &mut b[num_read..]);
+            let cur_rep_levels_buf =
+                rep_levels_buffer.as_mut().map(|b| &mut b[num_read..]);
+            let column_reader = self.column_reader.as_mut().unwrap();
+
+            let values_read = match dictionary {
+                Some(dictionary) => {
+                    let mut keys = vec![0; num_to_read];
+                    let (keys_read, levels_read) = column_reader.read_batch_keys(
+                        num_to_read,
+                        cur_def_levels_buf,
+                        cur_rep_levels_buf,
+                        &mut keys,
+                    )?;
+                    keys.truncate(keys_read);
+                    if let Some(key) = keys
+                        .iter()
+                        .find(|key| **key < 0 || **key as usize >= dictionary.len())
+                    {
+                        return Err(general_err!(
+                            "Dictionary key {} out of bounds of a dictionary of {} values",
+                            key,
+                            dictionary.len()
+                        ));
+                    }
+
+                    let values_read = max(keys_read, levels_read);
+                    let def_levels = def_levels_buffer
+                        .as_ref()
+                        .map(|b| &b[num_read..num_read + values_read]);
+                    let keys = self.with_nulls(keys, def_levels);
+                    segments.push(DictionarySegment::Keys { dictionary, keys });
+                    values_read
+                }
+                None => {
+                    let mut values = vec![ByteArray::default(); num_to_read];
+                    let (data_read, levels_read) = column_reader.read_batch(
+                        num_to_read,
+                        cur_def_levels_buf,
+                        cur_rep_levels_buf,
+                        &mut values,
+                    )?;
+                    values.truncate(data_read);
+
+                    let values_read = max(data_read, levels_read);
+                    let def_levels = def_levels_buffer
+                        .as_ref()
+                        .map(|b| &b[num_read..num_read + values_read]);
+                    let values = self.with_nulls(values, def_levels);
+                    segments
+                        .push(DictionarySegment::Values(self.converter.convert(values)?));
+                    values_read
+                }
+            };
+            num_read += values_read;
+        }
+
+        def_levels_buffer
+            .iter_mut()
+            .for_each(|buf| buf.truncate(num_read));
+        rep_levels_buffer
+            .iter_mut()
+            .for_each(|buf| buf.truncate(num_read));
+        self.def_levels_buffer = def_levels_buffer;
+        self.rep_levels_buffer = rep_levels_buffer;
+
+        self.build_array(segments)
+    }
+
+    fn get_def_levels(&self) -> Option<&[i16]> {
+        self.def_levels_buffer.as_deref()
+    }
+
+    fn get_rep_levels(&self) -> Option<&[i16]> {
+        self.rep_levels_buffer.as_deref()
+    }
+}
+
+/// Creates a [`ByteArrayDictionaryArrayReader`] of dictionary arrays of `data_type`,
+/// with keys of `key_type` and values converted by `converter`.
+fn build_byte_array_dictionary_reader<C>(
+    key_type: &ArrowType,
+    page_iterator: Box<dyn PageIterator>,
+    column_desc: ColumnDescPtr,
+    converter: C,
+    data_type: ArrowType,
+) -> Result<Box<dyn ArrayReader>>
+where
+    C: Converter<Vec<Option<ByteArray>>, ArrayRef> + 'static,
+{
+    macro_rules! reader {
+        ($key_type:ty) => {
+            Ok(Box::new(
+                ByteArrayDictionaryArrayReader::<$key_type, C>::new(
+                    page_iterator,
+                    column_desc,
+                    converter,
+                    data_type,
+                ),
+            ))
+        };
+    }
+
+    match key_type {
+        ArrowType::Int8 => reader!(ArrowInt8Type),
+        ArrowType::Int16 => reader!(ArrowInt16Type),
+        ArrowType::Int32 => reader!(ArrowInt32Type),
+        ArrowType::Int64 => reader!(ArrowInt64Type),
+        ArrowType::UInt8 => reader!(ArrowUInt8Type),
+        ArrowType::UInt16 => reader!(ArrowUInt16Type),
+        ArrowType::UInt32 => reader!(ArrowUInt32Type),
+        ArrowType::UInt64 => reader!(ArrowUInt64Type),
+        t => Err(ArrowError(format!(
+            "Unsupported dictionary key type {:?}",
+            t
+        ))),
+    }
+}
+
 /// Implementation of list array reader.
 pub struct ListArrayReader<OffsetSize: OffsetSizeTrait> {
     item_reader: Box<dyn ArrayReader>,
@@ -1066,6 +1505,26 @@ impl ArrayReader for StructArrayReader {
         Ok(Arc::new(StructArray::from(array_data)))
     }
 
+    /// Skips at most `num_records` records of all children.
+    fn skip_records(&mut self, num_records: usize) -> Result<usize> {
+        let children_skipped = self
+            .children
+            .iter_mut()
+            .map(|reader| reader.skip_records(num_records))
+            .collect::<Result<Vec<_>>>()?;
+
+        let num_skipped = children_skipped.first().cloned().unwrap_or(0);
+        if children_skipped
+            .iter()
+            .any(|skipped| *skipped != num_skipped)
+        {
+            return Err(general_err!(
+                "Not all children skipped the same number of records!"
+            ));
+        }
+        Ok(num_skipped)
+    }
+
     fn get_def_levels(&self) -> Option<&[i16]> {
         self.def_level_buffer
             .as_ref()
@@ -1086,6 +1545,27 @@ pub fn build_array_reader<T>(
     column_indices: T,
     file_reader: Arc<dyn FileReader>,
 ) -> Result<Box<dyn ArrayReader>>
+where
+    T: IntoIterator<Item = usize>,
+{
+    build_array_reader_with_pool(
+        parquet_schema,
+        arrow_schema,
+        column_indices,
+        file_reader,
+        None,
+    )
+}
+
+/// Create array reader from parquet schema, column indices, and parquet file reader,
+/// whose primitive columns are decoded into buffers allocated from `pool`, if any.
+pub fn build_array_reader_with_pool<T>(
+    parquet_schema: SchemaDescPtr,
+    arrow_schema: Schema,
+    column_indices: T,
+    file_reader: Arc<dyn FileReader>,
+    pool: Option<Arc<dyn MemoryPool>>,
+) -> Result<Box<dyn ArrayReader>>
 where
     T: IntoIterator<Item = usize>,
 {
@@ -1127,6 +1607,7 @@ where
         Arc::new(arrow_schema),
         Arc::new(leaves),
         file_reader,
+        pool,
     )
     .build_array_reader()
 }
@@ -1139,6 +1620,8 @@ struct ArrayReaderBuilder {
     // Value: column index in schema
     columns_included: Arc<HashMap<*const Type, usize>>,
     file_reader: Arc<dyn FileReader>,
+    // allocates the buffers of primitive array readers, if any
+    pool: Option<Arc<dyn MemoryPool>>,
 }
 
 /// Used in type visitor.
@@ -1353,12 +1836,14 @@ impl<'a> ArrayReaderBuilder {
         arrow_schema: Arc<Schema>,
         columns_included: Arc<HashMap<*const Type, usize>>,
         file_reader: Arc<dyn FileReader>,
+        pool: Option<Arc<dyn MemoryPool>>,
     ) -> Self {
         Self {
             root_schema,
             arrow_schema,
             columns_included,
             file_reader,
+            pool,
         }
     }
 
@@ -1403,11 +1888,14 @@ impl<'a> ArrayReaderBuilder {
         };
 
         match cur_type.get_physical_type() {
-            PhysicalType::BOOLEAN => Ok(Box::new(PrimitiveArrayReader::<BoolType>::new(
-                page_iterator,
-                column_desc,
-                arrow_type,
-            )?)),
+            PhysicalType::BOOLEAN => {
+                Ok(Box::new(PrimitiveArrayReader::<BoolType>::new_with_pool(
+                    page_iterator,
+                    column_desc,
+                    arrow_type,
+                    self.pool.clone(),
+                )?))
+            }
             PhysicalType::INT32 => {
                 if let Some(ArrowType::Null) = arrow_type {
                     Ok(Box::new(NullArrayReader::<Int32Type>::new(
@@ -1415,18 +1903,22 @@ impl<'a> ArrayReaderBuilder {
                         column_desc,
                     )?))
                 } else {
-                    Ok(Box::new(PrimitiveArrayReader::<Int32Type>::new(
+                    Ok(Box::new(PrimitiveArrayReader::<Int32Type>::new_with_pool(
                         page_iterator,
                         column_desc,
                         arrow_type,
+                        self.pool.clone(),
                     )?))
                 }
             }
-            PhysicalType::INT64 => Ok(Box::new(PrimitiveArrayReader::<Int64Type>::new(
-                page_iterator,
-                column_desc,
-                arrow_type,
-            )?)),
+            PhysicalType::INT64 => {
+                Ok(Box::new(PrimitiveArrayReader::<Int64Type>::new_with_pool(
+                    page_iterator,
+                    column_desc,
+                    arrow_type,
+                    self.pool.clone(),
+                )?))
+            }
             PhysicalType::INT96 => {
                 // get the optional timezone information from arrow type
                 let timezone = arrow_type
@@ -1450,19 +1942,69 @@ impl<'a> ArrayReaderBuilder {
                     arrow_type,
                 )?))
             }
-            PhysicalType::FLOAT => Ok(Box::new(PrimitiveArrayReader::<FloatType>::new(
-                page_iterator,
-                column_desc,
-                arrow_type,
-            )?)),
+            PhysicalType::FLOAT => {
+                Ok(Box::new(PrimitiveArrayReader::<FloatType>::new_with_pool(
+                    page_iterator,
+                    column_desc,
+                    arrow_type,
+                    self.pool.clone(),
+                )?))
+            }
             PhysicalType::DOUBLE => {
-                Ok(Box::new(PrimitiveArrayReader::<DoubleType>::new(
+                Ok(Box::new(PrimitiveArrayReader::<DoubleType>::new_with_pool(
                     page_iterator,
                     column_desc,
                     arrow_type,
+                    self.pool.clone(),
                 )?))
             }
             PhysicalType::BYTE_ARRAY => {
+                if let Some(ArrowType::Dictionary(ref key_type, ref value_type)) =
+                    arrow_type
+                {
+                    let data_type = arrow_type.clone().unwrap();
+                    match value_type.as_ref() {
+                        ArrowType::Utf8 => {
+                            return build_byte_array_dictionary_reader(
+                                key_type,
+                                page_iterator,
+                                column_desc,
+                                Utf8Converter::new(Utf8ArrayConverter {}),
+                                data_type,
+                            )
+                        }
+                        ArrowType::LargeUtf8 => {
+                            return build_byte_array_dictionary_reader(
+                                key_type,
+                                page_iterator,
+                                column_desc,
+                                LargeUtf8Converter::new(LargeUtf8ArrayConverter {}),
+                                data_type,
+                            )
+                        }
+                        ArrowType::Binary => {
+                            return build_byte_array_dictionary_reader(
+                                key_type,
+                                page_iterator,
+                                column_desc,
+                                BinaryConverter::new(BinaryArrayConverter {}),
+                                data_type,
+                            )
+                        }
+                        ArrowType::LargeBinary => {
+                            return build_byte_array_dictionary_reader(
+                                key_type,
+                                page_iterator,
+                                column_desc,
+                                LargeBinaryConverter::new(LargeBinaryArrayConverter {}),
+                                data_type,
+                            )
+                        }
+                        // Other values are read and cast to dictionary arrays
+                        _ => {}
+                    }
+                }
+
                 if cur_type.get_basic_info().converted_type() == ConvertedType::UTF8 {
                     if let Some(ArrowType::LargeUtf8) = arrow_type {
                         let converter =
@@ -17,18 +17,26 @@
 
 //! Contains reader which reads parquet data into arrow array.
 
-use crate::arrow::array_reader::{build_array_reader, ArrayReader, StructArrayReader};
+use crate::arrow::array_reader::{
+    build_array_reader_with_pool, ArrayReader, StructArrayReader,
+};
 use crate::arrow::schema::parquet_to_arrow_schema;
 use crate::arrow::schema::{
     parquet_to_arrow_schema_by_columns, parquet_to_arrow_schema_by_root_columns,
 };
 use crate::errors::{ParquetError, Result};
 use crate::file::metadata::ParquetMetaData;
-use crate::file::reader::FileReader;
+use crate::file::predicate::Predicate;
+use crate::file::reader::{FileReader, RowGroupReader};
+use crate::record::reader::RowIter;
+use crate::schema::types::{SchemaDescriptor, Type as SchemaType};
+use arrow::alloc::MemoryPool;
+use arrow::array::{make_array, Array, ArrayRef, BooleanArray, StructArray};
+use arrow::compute::{build_filter, concat};
 use arrow::datatypes::{DataType as ArrowType, Schema, SchemaRef};
-use arrow::error::Result as ArrowResult;
+use arrow::error::{ArrowError, Result as ArrowResult};
 use arrow::record_batch::{RecordBatch, RecordBatchReader};
-use arrow::{array::StructArray, error::ArrowError};
+use std::collections::{BTreeMap, BTreeSet, HashMap};
 use std::sync::Arc;
 
 /// Arrow reader api.
@@ -78,6 +86,8 @@ pub trait ArrowReader {
 
 pub struct ParquetFileArrowReader {
     file_reader: Arc<dyn FileReader>,
+    // allocates the buffers the columns are decoded into, if any
+    pool: Option<Arc<dyn MemoryPool>>,
 }
 
 impl ArrowReader for ParquetFileArrowReader {
@@ -137,7 +147,7 @@ impl ArrowReader for ParquetFileArrowReader {
     where
         T: IntoIterator<Item = usize>,
     {
-        let array_reader = build_array_reader(
+        let array_reader = build_array_reader_with_pool(
             self.file_reader
                 .metadata()
                 .file_metadata()
@@ -145,6 +155,7 @@ impl ArrowReader for ParquetFileArrowReader {
             self.get_schema()?,
             column_indices,
             self.file_reader.clone(),
+            self.pool.clone(),
         )?;
 
         ParquetRecordBatchReader::try_new(batch_size, array_reader)
@@ -153,25 +164,255 @@ impl ArrowReader for ParquetFileArrowReader {
 
 impl ParquetFileArrowReader {
     pub fn new(file_reader: Arc<dyn FileReader>) -> Self {
-        Self { file_reader }
+        Self {
+            file_reader,
+            pool: None,
+        }
+    }
+
+    /// Decodes the columns of the record readers returned afterwards into buffers
+    /// allocated from `pool`, which then accounts for the memory of the arrays read
+    /// until they are dropped, and limits it if the pool has a limit.
+    ///
+    /// Currently only the buffers of primitive columns are allocated from `pool`.
+    pub fn with_memory_pool(mut self, pool: Arc<dyn MemoryPool>) -> Self {
+        self.pool = Some(pool);
+        self
     }
 
     // Expose the reader metadata
     pub fn get_metadata(&mut self) -> ParquetMetaData {
         self.file_reader.metadata().clone()
     }
+
+    /// Skips the row groups whose column statistics prove that none of their rows
+    /// satisfy `predicate`, and returns the number of row groups skipped.
+    ///
+    /// Rows of the remaining row groups are not filtered: record readers returned
+    /// afterwards may still contain rows that do not satisfy `predicate`.
+    pub fn prune_row_groups(&mut self, predicate: &Predicate) -> Result<usize> {
+        let metadata = self.file_reader.metadata();
+        let mut row_groups = Vec::with_capacity(metadata.num_row_groups());
+        for (i, row_group_metadata) in metadata.row_groups().iter().enumerate() {
+            if predicate.can_match(row_group_metadata)? {
+                row_groups.push(i);
+            }
+        }
+
+        let num_pruned = metadata.num_row_groups() - row_groups.len();
+        if num_pruned > 0 {
+            self.file_reader = Arc::new(RowGroupSubsetReader::new(
+                self.file_reader.clone(),
+                row_groups,
+            ));
+        }
+        Ok(num_pruned)
+    }
+
+    /// Returns a record batch reader whose record batches contain the columns
+    /// identified by `column_indices`, of only the rows that `filter` selects.
+    ///
+    /// The columns of `filter` are read first, `batch_size` rows at a time, and the
+    /// predicate is evaluated on them. The other columns are then read for the
+    /// selected rows only, skipping the others mostly without decoding them. Record
+    /// batches can therefore contain fewer than `batch_size` rows.
+    ///
+    /// Projected root columns whose projected leaves are all read by `filter` are
+    /// taken from its record batches rather than read twice.
+    pub fn get_record_reader_by_columns_with_filter<T>(
+        &mut self,
+        column_indices: T,
+        batch_size: usize,
+        filter: RowFilter,
+    ) -> Result<ParquetRecordBatchReader>
+    where
+        T: IntoIterator<Item = usize>,
+    {
+        let schema_descr = self
+            .file_reader
+            .metadata()
+            .file_metadata()
+            .schema_descr_ptr();
+        let arrow_schema = self.get_schema()?;
+        let column_indices = column_indices.into_iter().collect::<Vec<_>>();
+        let projected_roots = leaves_by_root(&schema_descr, &column_indices);
+        let filter_roots = leaves_by_root(&schema_descr, &filter.column_indices);
+        if projected_roots.is_empty() {
+            return Err(general_err!("Can't build array reader without columns!"));
+        }
+
+        let filter_columns = filter_roots
+            .keys()
+            .enumerate()
+            .map(|(i, root)| (*root, i))
+            .collect::<HashMap<_, _>>();
+        let mut columns = Vec::with_capacity(projected_roots.len());
+        let mut remaining_leaves = Vec::new();
+        for (root, leaves) in &projected_roots {
+            if filter_roots.get(root) == Some(leaves) {
+                columns.push(Some(filter_columns[root]));
+            } else {
+                columns.push(None);
+                remaining_leaves.extend(leaves.iter().cloned());
+            }
+        }
+
+        let filter_reader = build_array_reader_with_pool(
+            schema_descr.clone(),
+            arrow_schema.clone(),
+            filter.column_indices,
+            self.file_reader.clone(),
+            self.pool.clone(),
+        )?;
+        let array_reader: Box<dyn ArrayReader> = if remaining_leaves.is_empty() {
+            Box::new(StructArrayReader::new(
+                ArrowType::Struct(Vec::new()),
+                Vec::new(),
+                0,
+                0,
+            ))
+        } else {
+            build_array_reader_with_pool(
+                schema_descr,
+                arrow_schema,
+                remaining_leaves,
+                self.file_reader.clone(),
+                self.pool.clone(),
+            )?
+        };
+
+        ParquetRecordBatchReader::try_new_with_filter(
+            batch_size,
+            array_reader,
+            filter_reader,
+            filter.predicate,
+            columns,
+        )
+    }
+}
+
+/// Returns the leaves of `column_indices` grouped by the index of their root column.
+fn leaves_by_root(
+    schema: &SchemaDescriptor,
+    column_indices: &[usize],
+) -> BTreeMap<usize, BTreeSet<usize>> {
+    let roots = schema
+        .root_schema()
+        .get_fields()
+        .iter()
+        .enumerate()
+        .map(|(i, field)| (field.name(), i))
+        .collect::<HashMap<_, _>>();
+    let mut leaves = BTreeMap::<usize, BTreeSet<usize>>::new();
+    for c in column_indices {
+        let root = roots[schema.get_column_root(*c).name()];
+        leaves.entry(root).or_default().insert(*c);
+    }
+    leaves
+}
+
+/// Selects the rows that a [`ParquetRecordBatchReader`] returns by a predicate over
+/// some of the columns of a Parquet file.
+pub struct RowFilter {
+    column_indices: Vec<usize>,
+    predicate: Box<dyn FnMut(&RecordBatch) -> ArrowResult<BooleanArray>>,
+}
+
+impl RowFilter {
+    /// Creates a filter that evaluates `predicate` on record batches of the leaf
+    /// columns identified by `column_indices`, and selects the rows for which it
+    /// returns `true`. Rows for which it returns `false` or null are skipped.
+    pub fn new<T, F>(column_indices: T, predicate: F) -> Self
+    where
+        T: IntoIterator<Item = usize>,
+        F: FnMut(&RecordBatch) -> ArrowResult<BooleanArray> + 'static,
+    {
+        Self {
+            column_indices: column_indices.into_iter().collect(),
+            predicate: Box::new(predicate),
+        }
+    }
+}
+
+/// A [`FileReader`] over a subset of the row groups of another reader.
+pub(in crate::arrow) struct RowGroupSubsetReader {
+    file_reader: Arc<dyn FileReader>,
+    /// Metadata with only the row groups in `row_groups`
+    metadata: ParquetMetaData,
+    /// Indices of the row groups in `file_reader`
+    row_groups: Vec<usize>,
+}
+
+impl RowGroupSubsetReader {
+    /// Creates a reader of the row groups of `file_reader` in `row_groups`.
+    pub(in crate::arrow) fn new(
+        file_reader: Arc<dyn FileReader>,
+        row_groups: Vec<usize>,
+    ) -> Self {
+        let metadata = file_reader.metadata();
+        let metadata = ParquetMetaData::new(
+            metadata.file_metadata().clone(),
+            row_groups
+                .iter()
+                .map(|i| metadata.row_group(*i).clone())
+                .collect(),
+        );
+        Self {
+            file_reader,
+            metadata,
+            row_groups,
+        }
+    }
+}
+
+impl FileReader for RowGroupSubsetReader {
+    fn metadata(&self) -> &ParquetMetaData {
+        &self.metadata
+    }
+
+    fn num_row_groups(&self) -> usize {
+        self.row_groups.len()
+    }
+
+    fn get_row_group(&self, i: usize) -> Result<Box<dyn RowGroupReader + '_>> {
+        self.file_reader.get_row_group(self.row_groups[i])
+    }
+
+    fn get_row_iter(&self, projection: Option<SchemaType>) -> Result<RowIter> {
+        RowIter::from_file(projection, self)
+    }
 }
 
 pub struct ParquetRecordBatchReader {
     batch_size: usize,
     array_reader: Box<dyn ArrayReader>,
     schema: SchemaRef,
+    /// The columns read first to select rows, if any. `array_reader` then reads the
+    /// remaining columns.
+    filter: Option<FilterReader>,
+}
+
+/// The state of a [`ParquetRecordBatchReader`] returned by
+/// [`ParquetFileArrowReader::get_record_reader_by_columns_with_filter`].
+struct FilterReader {
+    array_reader: Box<dyn ArrayReader>,
+    schema: SchemaRef,
+    predicate: Box<dyn FnMut(&RecordBatch) -> ArrowResult<BooleanArray>>,
+    /// Schema of the record batches of the remaining columns
+    remaining_schema: SchemaRef,
+    /// For each column of the returned record batches, the column of the filter
+    /// record batches it is taken from, or `None` if it is the next remaining column.
+    columns: Vec<Option<usize>>,
 }
 
 impl Iterator for ParquetRecordBatchReader {
     type Item = ArrowResult<RecordBatch>;
 
     fn next(&mut self) -> Option<Self::Item> {
+        if self.filter.is_some() {
+            return self.next_filtered().transpose();
+        }
+
         match self.array_reader.next_batch(self.batch_size) {
             Err(error) => Some(Err(error.into())),
             Ok(array) => {
@@ -212,23 +453,223 @@ impl ParquetRecordBatchReader {
         batch_size: usize,
         array_reader: Box<dyn ArrayReader>,
     ) -> Result<Self> {
-        // Check that array reader is struct array reader
-        array_reader
-            .as_any()
-            .downcast_ref::<StructArrayReader>()
-            .ok_or_else(|| general_err!("The input must be struct array reader!"))?;
-
-        let schema = match array_reader.get_data_type() {
-            ArrowType::Struct(ref fields) => Schema::new(fields.clone()),
-            _ => unreachable!("Struct array reader's data type is not struct!"),
-        };
+        let schema = struct_schema(array_reader.as_ref())?;
 
         Ok(Self {
             batch_size,
             array_reader,
             schema: Arc::new(schema),
+            filter: None,
+        })
+    }
+
+    fn try_new_with_filter(
+        batch_size: usize,
+        array_reader: Box<dyn ArrayReader>,
+        filter_reader: Box<dyn ArrayReader>,
+        predicate: Box<dyn FnMut(&RecordBatch) -> ArrowResult<BooleanArray>>,
+        columns: Vec<Option<usize>>,
+    ) -> Result<Self> {
+        let remaining_schema = Arc::new(struct_schema(array_reader.as_ref())?);
+        let filter_schema = Arc::new(struct_schema(filter_reader.as_ref())?);
+
+        let mut remaining_fields = remaining_schema.fields().iter();
+        let fields = columns
+            .iter()
+            .map(|column| match column {
+                Some(i) => filter_schema.field(*i).clone(),
+                None => remaining_fields.next().unwrap().clone(),
+            })
+            .collect();
+
+        Ok(Self {
+            batch_size,
+            array_reader,
+            schema: Arc::new(Schema::new(fields)),
+            filter: Some(FilterReader {
+                array_reader: filter_reader,
+                schema: filter_schema,
+                predicate,
+                remaining_schema,
+                columns,
+            }),
         })
     }
+
+    /// Returns the next record batch of the rows selected by the filter, skipping
+    /// record batches of the filter columns in which no row is selected.
+    fn next_filtered(&mut self) -> ArrowResult<Option<RecordBatch>> {
+        let filter = self.filter.as_mut().unwrap();
+        loop {
+            let filter_batch = read_record_batch(
+                filter.array_reader.as_mut(),
+                &filter.schema,
+                self.batch_size,
+            )?;
+            let num_rows = filter_batch.num_rows();
+            if num_rows == 0 {
+                return Ok(None);
+            }
+
+            let selection = (filter.predicate)(&filter_batch)?;
+            if selection.len() != num_rows {
+                return Err(ArrowError::ComputeError(format!(
+                    "Row filter returned {} values for {} rows",
+                    selection.len(),
+                    num_rows
+                )));
+            }
+            let selection = if selection.null_count() > 0 {
+                selection
+                    .iter()
+                    .map(|selected| Some(selected == Some(true)))
+                    .collect::<BooleanArray>()
+            } else {
+                selection
+            };
+
+            let selected_runs = selected_runs(&selection);
+            let mut remaining_columns = read_selected_rows(
+                self.array_reader.as_mut(),
+                &filter.remaining_schema,
+                &selected_runs,
+                num_rows,
+            )?
+            .into_iter();
+            if selected_runs.is_empty() {
+                continue;
+            }
+
+            let filter_rows = build_filter(&selection)?;
+            let columns = filter
+                .columns
+                .iter()
+                .map(|column| match column {
+                    Some(i) => make_array(filter_rows(&filter_batch.column(*i).data())),
+                    None => remaining_columns.next().unwrap(),
+                })
+                .collect();
+            return RecordBatch::try_new(self.schema.clone(), columns).map(Some);
+        }
+    }
+}
+
+/// Returns the schema of the record batches of a struct array reader.
+fn struct_schema(array_reader: &dyn ArrayReader) -> Result<Schema> {
+    // Check that array reader is struct array reader
+    array_reader
+        .as_any()
+        .downcast_ref::<StructArrayReader>()
+        .ok_or_else(|| general_err!("The input must be struct array reader!"))?;
+
+    match array_reader.get_data_type() {
+        ArrowType::Struct(ref fields) => Ok(Schema::new(fields.clone())),
+        _ => unreachable!("Struct array reader's data type is not struct!"),
+    }
+}
+
+/// Reads at most `batch_size` records of a struct array reader into a record batch.
+fn read_record_batch(
+    array_reader: &mut dyn ArrayReader,
+    schema: &SchemaRef,
+    batch_size: usize,
+) -> ArrowResult<RecordBatch> {
+    let array = array_reader
+        .next_batch(batch_size)
+        .map_err(|e| -> ArrowError { e.into() })?;
+    let struct_array = array
+        .as_any()
+        .downcast_ref::<StructArray>()
+        .ok_or_else(|| {
+            ArrowError::ParquetError(
+                "Struct array reader should return struct array".to_string(),
+            )
+        })?;
+    RecordBatch::try_new(schema.clone(), struct_array.columns_ref())
+}
+
+/// Returns the ranges of consecutive rows that `selection` selects.
+fn selected_runs(selection: &BooleanArray) -> Vec<(usize, usize)> {
+    let mut runs = Vec::new();
+    let mut start = None;
+    for i in 0..selection.len() {
+        match (start, selection.value(i)) {
+            (None, true) => start = Some(i),
+            (Some(run_start), false) => {
+                runs.push((run_start, i));
+                start = None;
+            }
+            _ => {}
+        }
+    }
+    if let Some(run_start) = start {
+        runs.push((run_start, selection.len()));
+    }
+    runs
+}
+
+/// Skips exactly `num_records` records of an array reader.
+fn skip_records(
+    array_reader: &mut dyn ArrayReader,
+    num_records: usize,
+) -> ArrowResult<()> {
+    if num_records == 0 {
+        return Ok(());
+    }
+    let num_skipped = array_reader
+        .skip_records(num_records)
+        .map_err(|e| -> ArrowError { e.into() })?;
+    if num_skipped != num_records {
+        return Err(ArrowError::ParquetError(format!(
+            "Expected to skip {} records, but only {} are left",
+            num_records, num_skipped
+        )));
+    }
+    Ok(())
+}
+
+/// Reads the rows in `selected_runs` of the next `num_rows` rows of a struct array
+/// reader, and skips the others. Returns the columns of the rows read.
+fn read_selected_rows(
+    array_reader: &mut dyn ArrayReader,
+    schema: &SchemaRef,
+    selected_runs: &[(usize, usize)],
+    num_rows: usize,
+) -> ArrowResult<Vec<ArrayRef>> {
+    if schema.fields().is_empty() {
+        return Ok(Vec::new());
+    }
+
+    let mut batches = Vec::with_capacity(selected_runs.len());
+    let mut position = 0;
+    for (start, end) in selected_runs {
+        skip_records(array_reader, start - position)?;
+        let batch = read_record_batch(array_reader, schema, end - start)?;
+        if batch.num_rows() != end - start {
+            return Err(ArrowError::ParquetError(format!(
+                "Expected to read {} records, but only {} are left",
+                end - start,
+                batch.num_rows()
+            )));
+        }
+        batches.push(batch);
+        position = *end;
+    }
+    skip_records(array_reader, num_rows - position)?;
+
+    match batches.len() {
+        0 => Ok(Vec::new()),
+        1 => Ok(batches[0].columns().to_vec()),
+        _ => (0..schema.fields().len())
+            .map(|i| {
+                let arrays = batches
+                    .iter()
+                    .map(|batch| batch.column(i).as_ref())
+                    .collect::<Vec<_>>();
+                concat(&arrays)
+            })
+            .collect(),
+    }
 }
 
 #[cfg(test)]
@@ -668,4 +1109,443 @@ mod tests {
             batch.unwrap();
         }
     }
+
+    #[test]
+    fn test_arrow_reader_memory_pool() {
+        use crate::arrow::ArrowWriter;
+        use crate::util::cursor::{InMemoryWriteableCursor, SliceableCursor};
+        use arrow::alloc::{MemoryPool, TrackingMemoryPool};
+        use arrow::datatypes::{DataType as ArrowDataType, Field, Schema};
+        use arrow::error::Result as ArrowResult;
+        use arrow::record_batch::RecordBatch;
+
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("a", ArrowDataType::Int64, false),
+            Field::new("b", ArrowDataType::Int32, true),
+        ]));
+        let a = Int64Array::from((0..1000).collect::<Vec<i64>>());
+        let b = Int32Array::from(
+            (0..1000)
+                .map(|i| if i % 3 == 0 { None } else { Some(i) })
+                .collect::<Vec<_>>(),
+        );
+        let batch =
+            RecordBatch::try_new(schema.clone(), vec![Arc::new(a), Arc::new(b)]).unwrap();
+        let cursor = InMemoryWriteableCursor::default();
+        let mut writer = ArrowWriter::try_new(cursor.clone(), schema, None).unwrap();
+        writer.write(&batch).unwrap();
+        writer.close().unwrap();
+
+        let pool = Arc::new(TrackingMemoryPool::new(None));
+        let file_reader =
+            SerializedFileReader::new(SliceableCursor::new(cursor.data())).unwrap();
+        let mut arrow_reader = ParquetFileArrowReader::new(Arc::new(file_reader))
+            .with_memory_pool(pool.clone());
+        let batches = arrow_reader
+            .get_record_reader(1000)
+            .unwrap()
+            .collect::<ArrowResult<Vec<_>>>()
+            .unwrap();
+        assert_eq!(batches.len(), 1);
+        assert_eq!(batches[0].columns(), batch.columns());
+        // the values of both columns are allocated from the pool
+        assert!(pool.allocated() >= 1000 * (8 + 4));
+        drop(batches);
+        drop(arrow_reader);
+        assert_eq!(pool.allocated(), 0);
+
+        // reading fails instead of exceeding the limit of the pool
+        let pool = Arc::new(TrackingMemoryPool::new(Some(1024)));
+        let file_reader =
+            SerializedFileReader::new(SliceableCursor::new(cursor.data())).unwrap();
+        let mut arrow_reader =
+            ParquetFileArrowReader::new(Arc::new(file_reader)).with_memory_pool(pool);
+        let failed = match arrow_reader.get_record_reader(1000) {
+            Ok(mut reader) => reader.next().unwrap().is_err(),
+            Err(_) => true,
+        };
+        assert!(failed);
+    }
+
+    #[test]
+    fn test_arrow_reader_prune_row_groups() {
+        use crate::arrow::ArrowWriter;
+        use crate::file::predicate::Predicate;
+        use crate::util::cursor::{InMemoryWriteableCursor, SliceableCursor};
+        use arrow::datatypes::{DataType as ArrowDataType, Field, Schema};
+        use arrow::record_batch::RecordBatch;
+
+        // 4 row groups, with ts in [0, 100), [100, 200), [200, 300) and [300, 400)
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("ts", ArrowDataType::Int64, false),
+            Field::new("name", ArrowDataType::Utf8, true),
+        ]));
+        let props = WriterProperties::builder()
+            .set_max_row_group_size(100)
+            .build();
+        let cursor = InMemoryWriteableCursor::default();
+        let mut writer =
+            ArrowWriter::try_new(cursor.clone(), schema.clone(), Some(props)).unwrap();
+        for start in (0..400).step_by(100) {
+            let ts = Int64Array::from((start..start + 100).collect::<Vec<i64>>());
+            // only the last row group has nulls
+            let name = StringArray::from(
+                (start..start + 100)
+                    .map(|i| if i >= 350 { None } else { Some("a") })
+                    .collect::<Vec<_>>(),
+            );
+            let batch =
+                RecordBatch::try_new(schema.clone(), vec![Arc::new(ts), Arc::new(name)])
+                    .unwrap();
+            writer.write(&batch).unwrap();
+        }
+        writer.close().unwrap();
+
+        let num_rows = |predicate: Predicate, expected_pruned: usize| {
+            let file_reader =
+                SerializedFileReader::new(SliceableCursor::new(cursor.data())).unwrap();
+            let mut arrow_reader = ParquetFileArrowReader::new(Arc::new(file_reader));
+            assert_eq!(
+                arrow_reader.prune_row_groups(&predicate).unwrap(),
+                expected_pruned
+            );
+            arrow_reader
+                .get_record_reader(1024)
+                .unwrap()
+                .map(|batch| batch.unwrap().num_rows())
+                .sum::<usize>()
+        };
+
+        assert_eq!(num_rows(Predicate::gt_eq("ts", 250_i64), 2), 200);
+        assert_eq!(num_rows(Predicate::lt("ts", 100_i64), 3), 100);
+        assert_eq!(num_rows(Predicate::eq("ts", 1000_i64), 4), 0);
+        assert_eq!(num_rows(Predicate::in_list("ts", vec![5_i64, 305]), 2), 200);
+        assert_eq!(num_rows(Predicate::is_null("name"), 3), 100);
+        assert_eq!(
+            num_rows(
+                Predicate::lt("ts", 100_i64).or(Predicate::is_null("name")),
+                2
+            ),
+            200
+        );
+        assert_eq!(
+            num_rows(
+                Predicate::lt("ts", 100_i64).and(Predicate::is_null("name")),
+                4
+            ),
+            0
+        );
+
+        // the same row groups are pruned by the file reader
+        let mut file_reader =
+            SerializedFileReader::new(SliceableCursor::new(cursor.data())).unwrap();
+        assert_eq!(
+            file_reader
+                .prune_row_groups(&Predicate::gt("ts", 150_i64))
+                .unwrap(),
+            1
+        );
+        assert_eq!(file_reader.metadata().num_row_groups(), 3);
+        assert_eq!(file_reader.get_row_iter(None).unwrap().count(), 300);
+    }
+
+    #[test]
+    fn test_arrow_reader_prune_row_groups_unsigned_order() {
+        use crate::arrow::ArrowWriter;
+        use crate::file::predicate::Predicate;
+        use crate::util::cursor::{InMemoryWriteableCursor, SliceableCursor};
+        use arrow::datatypes::{DataType as ArrowDataType, Field, Schema};
+        use arrow::record_batch::RecordBatch;
+
+        // the statistics of strings are ordered byte-wise and not by length first,
+        // and those of unsigned integers as unsigned integers
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("name", ArrowDataType::Utf8, false),
+            Field::new("id", ArrowDataType::UInt32, false),
+        ]));
+        let props = WriterProperties::builder()
+            .set_max_row_group_size(2)
+            .build();
+        let cursor = InMemoryWriteableCursor::default();
+        let mut writer =
+            ArrowWriter::try_new(cursor.clone(), schema.clone(), Some(props)).unwrap();
+        let row_groups = vec![
+            (vec!["b", "aa"], vec![5, 3_000_000_000]),
+            (vec!["z", "é"], vec![1, 2]),
+            (vec!["c", "d"], vec![7, 8]),
+        ];
+        for (names, ids) in row_groups {
+            let batch = RecordBatch::try_new(
+                schema.clone(),
+                vec![
+                    Arc::new(StringArray::from(names)),
+                    Arc::new(UInt32Array::from(ids)),
+                ],
+            )
+            .unwrap();
+            writer.write(&batch).unwrap();
+        }
+        writer.close().unwrap();
+
+        let names_of = |predicate: Predicate, expected_pruned: usize| {
+            let file_reader =
+                SerializedFileReader::new(SliceableCursor::new(cursor.data())).unwrap();
+            let mut arrow_reader = ParquetFileArrowReader::new(Arc::new(file_reader));
+            assert_eq!(
+                arrow_reader.prune_row_groups(&predicate).unwrap(),
+                expected_pruned
+            );
+            let mut names = vec![];
+            for batch in arrow_reader.get_record_reader(1024).unwrap() {
+                let batch = batch.unwrap();
+                let column = batch
+                    .column(0)
+                    .as_any()
+                    .downcast_ref::<StringArray>()
+                    .unwrap();
+                names.extend(column.iter().map(|name| name.unwrap().to_string()));
+            }
+            names
+        };
+
+        assert_eq!(names_of(Predicate::eq("name", "b"), 2), vec!["b", "aa"]);
+        assert_eq!(names_of(Predicate::eq("name", "é"), 2), vec!["z", "é"]);
+        assert_eq!(names_of(Predicate::gt("name", "zz"), 2), vec!["z", "é"]);
+        assert_eq!(
+            names_of(Predicate::eq("id", 3_000_000_000_u32 as i32), 2),
+            vec!["b", "aa"]
+        );
+        assert_eq!(
+            names_of(Predicate::gt("id", 6), 1),
+            vec!["b", "aa", "c", "d"]
+        );
+    }
+
+    #[test]
+    fn test_read_dictionary_column() {
+        use crate::arrow::ArrowWriter;
+        use crate::util::cursor::{InMemoryWriteableCursor, SliceableCursor};
+        use arrow::datatypes::{DataType as ArrowDataType, Field, Int16Type, Schema};
+        use arrow::record_batch::RecordBatch;
+
+        let schema = Arc::new(Schema::new(vec![Field::new_dict(
+            "name",
+            ArrowDataType::Dictionary(
+                Box::new(ArrowDataType::Int16),
+                Box::new(ArrowDataType::Utf8),
+            ),
+            true,
+            0,
+            false,
+        )]));
+        let values = (0..100)
+            .map(|i| {
+                if i % 7 == 0 {
+                    None
+                } else {
+                    Some(["a", "b", "c", "d"][i % 4])
+                }
+            })
+            .collect::<Vec<_>>();
+
+        // 2 row groups of 50 rows
+        let write = |dictionary_enabled: bool| {
+            let props = WriterProperties::builder()
+                .set_dictionary_enabled(dictionary_enabled)
+                .build();
+            let cursor = InMemoryWriteableCursor::default();
+            let mut writer =
+                ArrowWriter::try_new(cursor.clone(), schema.clone(), Some(props))
+                    .unwrap();
+            for chunk in values.chunks(50) {
+                let array = chunk
+                    .iter()
+                    .cloned()
+                    .collect::<DictionaryArray<Int16Type>>();
+                let batch =
+                    RecordBatch::try_new(schema.clone(), vec![Arc::new(array)]).unwrap();
+                writer.write(&batch).unwrap();
+                writer.flush().unwrap();
+            }
+            writer.close().unwrap();
+            cursor.data()
+        };
+        let read = |data: Vec<u8>, batch_size: usize| {
+            let file_reader =
+                SerializedFileReader::new(SliceableCursor::new(data)).unwrap();
+            let mut arrow_reader = ParquetFileArrowReader::new(Arc::new(file_reader));
+            arrow_reader
+                .get_record_reader(batch_size)
+                .unwrap()
+                .map(|batch| {
+                    let column = batch.unwrap().column(0).clone();
+                    assert_eq!(column.data_type(), schema.field(0).data_type());
+                    column
+                })
+                .collect::<Vec<_>>()
+        };
+        fn as_dictionary(array: &ArrayRef) -> &DictionaryArray<Int16Type> {
+            array
+                .as_any()
+                .downcast_ref::<DictionaryArray<Int16Type>>()
+                .unwrap()
+        }
+        let dictionary_values =
+            |array: &ArrayRef| as_dictionary(array).values().data().buffers()[1].as_ptr();
+        let to_strings = |arrays: &[ArrayRef]| {
+            arrays
+                .iter()
+                .map(as_dictionary)
+                .flat_map(|array| {
+                    let values = array.values();
+                    let values = values.as_any().downcast_ref::<StringArray>().unwrap();
+                    array
+                        .keys()
+                        .iter()
+                        .map(|key| key.map(|key| values.value(key as usize).to_owned()))
+                        .collect::<Vec<_>>()
+                })
+                .collect::<Vec<_>>()
+        };
+        let expected = values
+            .iter()
+            .map(|value| value.map(|value| value.to_owned()))
+            .collect::<Vec<_>>();
+
+        // batches within a row group share its dictionary
+        let data = write(true);
+        let arrays = read(data.clone(), 10);
+        assert_eq!(arrays.len(), 10);
+        assert_eq!(to_strings(&arrays), expected);
+        assert_eq!(dictionary_values(&arrays[0]), dictionary_values(&arrays[4]));
+        assert_ne!(dictionary_values(&arrays[4]), dictionary_values(&arrays[5]));
+
+        // a batch that spans row groups is cast to a dictionary array
+        let arrays = read(data, 30);
+        assert_eq!(arrays.len(), 4);
+        assert_eq!(to_strings(&arrays), expected);
+        assert_eq!(as_dictionary(&arrays[1]).values().len(), 4);
+
+        // as are values that are not dictionary encoded
+        let arrays = read(write(false), 30);
+        assert_eq!(to_strings(&arrays), expected);
+    }
+
+    #[test]
+    fn test_arrow_reader_row_filter() {
+        use crate::arrow::arrow_reader::RowFilter;
+        use crate::arrow::ArrowWriter;
+        use crate::util::cursor::{InMemoryWriteableCursor, SliceableCursor};
+        use arrow::compute::filter_record_batch;
+        use arrow::datatypes::{DataType as ArrowDataType, Field, Schema};
+        use arrow::record_batch::RecordBatch;
+
+        // 2 row groups of 500 rows, with small pages to skip some entirely
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("id", ArrowDataType::Int64, false),
+            Field::new("name", ArrowDataType::Utf8, true),
+            Field::new("value", ArrowDataType::Int32, true),
+        ]));
+        let props = WriterProperties::builder()
+            .set_max_row_group_size(500)
+            .set_data_pagesize_limit(256)
+            .set_write_batch_size(50)
+            .build();
+        let cursor = InMemoryWriteableCursor::default();
+        let mut writer =
+            ArrowWriter::try_new(cursor.clone(), schema.clone(), Some(props)).unwrap();
+        let make_batch = |start: i32, end: i32| {
+            let id = Int64Array::from((start as i64..end as i64).collect::<Vec<_>>());
+            let name = StringArray::from(
+                (start..end)
+                    .map(|i| {
+                        if i % 3 == 0 {
+                            None
+                        } else {
+                            Some(format!("name {}", i))
+                        }
+                    })
+                    .collect::<Vec<_>>(),
+            );
+            let value = Int32Array::from(
+                (start..end)
+                    .map(|i| if i % 5 == 0 { None } else { Some(i) })
+                    .collect::<Vec<_>>(),
+            );
+            RecordBatch::try_new(
+                schema.clone(),
+                vec![Arc::new(id), Arc::new(name), Arc::new(value)],
+            )
+            .unwrap()
+        };
+        writer.write(&make_batch(0, 500)).unwrap();
+        writer.write(&make_batch(500, 1000)).unwrap();
+        writer.close().unwrap();
+
+        // selects ids < 3 mod 10 and in [400, 700), but not multiples of 13
+        let is_selected = |id: i64| (id % 10 < 3 || (400..700).contains(&id));
+        let predicate = move |batch: &RecordBatch| {
+            let ids = batch
+                .column(0)
+                .as_any()
+                .downcast_ref::<Int64Array>()
+                .unwrap();
+            Ok(ids
+                .values()
+                .iter()
+                .map(|id| {
+                    if id % 13 == 0 {
+                        None
+                    } else {
+                        Some(is_selected(*id))
+                    }
+                })
+                .collect::<BooleanArray>())
+        };
+        let selection = (0..1000)
+            .map(|id| Some(id % 13 != 0 && is_selected(id)))
+            .collect::<BooleanArray>();
+        let expected = filter_record_batch(&make_batch(0, 1000), &selection).unwrap();
+
+        let read = |columns: Vec<usize>, batch_size: usize| {
+            let file_reader =
+                SerializedFileReader::new(SliceableCursor::new(cursor.data())).unwrap();
+            let mut arrow_reader = ParquetFileArrowReader::new(Arc::new(file_reader));
+            let record_reader = arrow_reader
+                .get_record_reader_by_columns_with_filter(
+                    columns,
+                    batch_size,
+                    RowFilter::new(vec![0], predicate),
+                )
+                .unwrap();
+            let schema = record_reader.schema();
+            let batches = record_reader
+                .map(|batch| batch.unwrap())
+                .collect::<Vec<_>>();
+            assert!(batches.iter().all(|batch| batch.num_rows() <= batch_size));
+            (0..schema.fields().len())
+                .map(|i| {
+                    let arrays = batches
+                        .iter()
+                        .map(|batch| batch.column(i).as_ref())
+                        .collect::<Vec<_>>();
+                    arrow::compute::concat(&arrays).unwrap()
+                })
+                .collect::<Vec<_>>()
+        };
+
+        for batch_size in vec![7, 100, 1024] {
+            // with the filter column, which is not read twice
+            let columns = read(vec![0, 1, 2], batch_size);
+            assert_eq!(&columns, expected.columns());
+
+            // without the filter column
+            let columns = read(vec![2, 1], batch_size);
+            assert_eq!(&columns, &expected.columns()[1..]);
+
+            // only the filter column
+            let columns = read(vec![0], batch_size);
+            assert_eq!(&columns, &expected.columns()[..1]);
+        }
+    }
 }
@@ -17,7 +17,8 @@
 
 //! Contains writer which writes arrow data into parquet data.
 
-use std::sync::Arc;
+use std::sync::{mpsc, Arc, Mutex};
+use std::thread;
 
 use arrow::array as arrow_array;
 use arrow::datatypes::{DataType as ArrowDataType, IntervalUnit, SchemaRef};
@@ -29,17 +30,22 @@ use super::schema::{
     add_encoded_arrow_schema_to_metadata, decimal_length_from_precision,
 };
 
-use crate::column::writer::ColumnWriter;
+use crate::column::writer::{BatchDictionary, ColumnWriter, ColumnWriterImpl};
 use crate::errors::{ParquetError, Result};
-use crate::file::properties::WriterProperties;
+use crate::file::properties::{WriterProperties, WriterPropertiesPtr};
+use crate::schema::types::SchemaDescPtr;
 use crate::{
     data_type::*,
-    file::writer::{FileWriter, ParquetWriter, RowGroupWriter, SerializedFileWriter},
+    file::writer::{
+        ColumnChunkEncoder, EncodedColumnChunk, FileWriter, ParquetWriter,
+        RowGroupWriter, SerializedFileWriter,
+    },
 };
 
 /// Arrow writer
 ///
-/// Writes Arrow `RecordBatch`es to a Parquet writer
+/// Writes Arrow `RecordBatch`es to a Parquet writer, buffering them in memory until
+/// enough rows or bytes have accumulated to fill a row group.
 pub struct ArrowWriter<W: ParquetWriter> {
     /// Underlying Parquet writer
     writer: SerializedFileWriter<W>,
@@ -47,6 +53,18 @@ pub struct ArrowWriter<W: ParquetWriter> {
     ///
     /// The schema is used to verify that each record batch written has the correct schema
     arrow_schema: SchemaRef,
+    /// Record batches that have not yet been written to a row group
+    buffer: Vec<RecordBatch>,
+    /// Number of rows in `buffer`
+    buffered_rows: usize,
+    /// Approximate in-memory size of the arrays in `buffer`
+    buffered_bytes: usize,
+    /// The maximum number of rows to write to a row group
+    max_row_group_size: usize,
+    /// The buffered size, in bytes, at which a row group is written
+    max_row_group_byte_size: usize,
+    /// The number of threads used to encode the columns of a row group
+    write_threads: usize,
 }
 
 impl<W: 'static + ParquetWriter> ArrowWriter<W> {
@@ -65,6 +83,10 @@ impl<W: 'static + ParquetWriter> ArrowWriter<W> {
         let mut props = props.unwrap_or_else(|| WriterProperties::builder().build());
         add_encoded_arrow_schema_to_metadata(&arrow_schema, &mut props);
 
+        let max_row_group_size = props.max_row_group_size();
+        let max_row_group_byte_size = props.max_row_group_byte_size();
+        let write_threads = props.write_threads();
+
         let file_writer = SerializedFileWriter::new(
             writer.try_clone()?,
             schema.root_schema_ptr(),
@@ -74,11 +96,23 @@ impl<W: 'static + ParquetWriter> ArrowWriter<W> {
         Ok(Self {
             writer: file_writer,
             arrow_schema,
+            buffer: vec![],
+            buffered_rows: 0,
+            buffered_bytes: 0,
+            max_row_group_size,
+            max_row_group_byte_size,
+            write_threads,
         })
     }
 
     /// Write a RecordBatch to writer
     ///
+    /// The batch is buffered, and only written out once the buffered batches reach
+    /// either `WriterProperties::max_row_group_size` rows or
+    /// `WriterProperties::max_row_group_byte_size` bytes. A batch is never split
+    /// across row groups; if adding it would exceed the row limit, the batches
+    /// buffered so far are written as a row group first.
+    ///
     /// *NOTE:* The writer currently does not support all Arrow data types
     pub fn write(&mut self, batch: &RecordBatch) -> Result<()> {
         // validate batch schema against writer's supplied schema
@@ -87,42 +121,211 @@ impl<W: 'static + ParquetWriter> ArrowWriter<W> {
                 "Record batch schema does not match writer schema".to_string(),
             ));
         }
-        // compute the definition and repetition levels of the batch
-        let batch_level = LevelInfo::new_from_batch(batch);
+        let num_rows = batch.num_rows();
+        if num_rows == 0 {
+            return Ok(());
+        }
+        if self.buffered_rows + num_rows > self.max_row_group_size {
+            self.flush()?;
+        }
+
+        self.buffered_rows += num_rows;
+        self.buffered_bytes += batch
+            .columns()
+            .iter()
+            .map(|array| array.get_array_memory_size())
+            .sum::<usize>();
+        self.buffer.push(batch.clone());
+
+        if self.buffered_rows >= self.max_row_group_size
+            || self.buffered_bytes >= self.max_row_group_byte_size
+        {
+            self.flush()?;
+        }
+        Ok(())
+    }
+
+    /// Write all buffered batches to a new row group
+    ///
+    /// This is a no-op if there are no buffered batches. It can be used to force a
+    /// row group boundary, e.g. at the end of a logical partition of the data.
+    pub fn flush(&mut self) -> Result<()> {
+        if self.buffer.is_empty() {
+            return Ok(());
+        }
+        let batches = std::mem::take(&mut self.buffer);
+        self.buffered_rows = 0;
+        self.buffered_bytes = 0;
+
+        // compute the definition and repetition levels of each batch
+        let batch_levels: Vec<LevelInfo> =
+            batches.iter().map(LevelInfo::new_from_batch).collect();
+        let columns: Vec<ColumnArrays> = self
+            .arrow_schema
+            .fields()
+            .iter()
+            .enumerate()
+            .map(|(i, field)| {
+                let arrays: Vec<_> =
+                    batches.iter().map(|b| b.column(i).clone()).collect();
+                let levels: Vec<_> = arrays
+                    .iter()
+                    .zip(&batch_levels)
+                    .map(|(array, batch_level)| {
+                        let mut levels = batch_level.calculate_array_levels(array, field);
+                        // leaves are written in order, popping their levels off the end
+                        levels.reverse();
+                        levels
+                    })
+                    .collect();
+                (arrays, levels)
+            })
+            .collect();
+
         let mut row_group_writer = self.writer.next_row_group()?;
-        for (array, field) in batch.columns().iter().zip(batch.schema().fields()) {
-            let mut levels = batch_level.calculate_array_levels(array, field);
-            write_leaves(&mut row_group_writer, array, &mut levels)?;
+        if self.write_threads > 1 {
+            let chunks = encode_columns(
+                self.writer.schema_descr(),
+                self.writer.properties(),
+                columns,
+                self.write_threads,
+            )?;
+            for chunk in chunks {
+                row_group_writer.append_column(chunk)?;
+            }
+        } else {
+            for (arrays, mut levels) in columns {
+                write_leaves(&mut row_group_writer, &arrays, &mut levels)?;
+            }
         }
 
         self.writer.close_row_group(row_group_writer)
     }
 
-    /// Close and finalize the underlying Parquet writer
+    /// Flush any buffered batches, then close and finalize the underlying Parquet writer
     pub fn close(&mut self) -> Result<parquet_format::FileMetaData> {
+        self.flush()?;
         self.writer.close()
     }
 }
 
-/// Convenience method to get the next ColumnWriter from the RowGroupWriter
-#[inline]
-#[allow(clippy::borrowed_box)]
-fn get_col_writer(
-    row_group_writer: &mut Box<dyn RowGroupWriter>,
-) -> Result<ColumnWriter> {
-    let col_writer = row_group_writer
-        .next_column()?
-        .expect("Unable to get column writer");
-    Ok(col_writer)
+/// The arrays of an Arrow column across buffered batches, and the levels of each array
+type ColumnArrays = (Vec<arrow_array::ArrayRef>, Vec<Vec<LevelInfo>>);
+
+/// Encodes the leaves of `columns` into in-memory column chunks on up to
+/// `num_threads` threads, returning the chunks in schema order.
+fn encode_columns(
+    schema_descr: &SchemaDescPtr,
+    props: &WriterPropertiesPtr,
+    columns: Vec<ColumnArrays>,
+    num_threads: usize,
+) -> Result<Vec<EncodedColumnChunk>> {
+    let num_columns = columns.len();
+    // pair each column with the index of its first leaf
+    let mut next_index = 0;
+    let jobs: Vec<_> = columns
+        .into_iter()
+        .map(|column| {
+            let column_index = next_index;
+            next_index += column.1.first().map_or(0, |levels| levels.len());
+            (column_index, column)
+        })
+        .collect();
+
+    let queue = Arc::new(Mutex::new(jobs.into_iter().enumerate()));
+    let (sender, receiver) = mpsc::channel();
+    let handles: Vec<_> = (0..num_threads.min(num_columns))
+        .map(|_| {
+            let queue = queue.clone();
+            let sender = sender.clone();
+            let schema_descr = schema_descr.clone();
+            let props = props.clone();
+            thread::spawn(move || loop {
+                let next = queue.lock().unwrap().next();
+                let (i, (column_index, (arrays, mut levels))) = match next {
+                    Some(next) => next,
+                    None => break,
+                };
+                let mut encoder = ColumnChunkEncoder::new(
+                    schema_descr.clone(),
+                    props.clone(),
+                    column_index,
+                );
+                let result = write_leaves(&mut encoder, &arrays, &mut levels)
+                    .map(|_| encoder.into_chunks());
+                if sender.send((i, result)).is_err() {
+                    break;
+                }
+            })
+        })
+        .collect();
+    drop(sender);
+
+    let mut results: Vec<_> = (0..num_columns).map(|_| None).collect();
+    for (i, result) in receiver {
+        results[i] = Some(result);
+    }
+    for handle in handles {
+        handle
+            .join()
+            .map_err(|_| general_err!("Column encoding thread panicked"))?;
+    }
+
+    let mut chunks = Vec::new();
+    for result in results {
+        let mut column_chunks =
+            result.ok_or_else(|| general_err!("Column was not encoded"))??;
+        chunks.append(&mut column_chunks);
+    }
+    Ok(chunks)
+}
+
+/// Provides the column writers that [`write_leaves`] writes to, in schema order
+trait LeafColumnWriters {
+    /// Returns the column writer of the next leaf
+    fn next_leaf_writer(&mut self) -> Result<ColumnWriter>;
+
+    /// Closes a column writer returned by `next_leaf_writer`
+    fn close_leaf_writer(&mut self, writer: ColumnWriter) -> Result<()>;
 }
 
-#[allow(clippy::borrowed_box)]
-fn write_leaves(
-    mut row_group_writer: &mut Box<dyn RowGroupWriter>,
-    array: &arrow_array::ArrayRef,
-    mut levels: &mut Vec<LevelInfo>,
+impl LeafColumnWriters for Box<dyn RowGroupWriter> {
+    fn next_leaf_writer(&mut self) -> Result<ColumnWriter> {
+        let col_writer = self.next_column()?.expect("Unable to get column writer");
+        Ok(col_writer)
+    }
+
+    fn close_leaf_writer(&mut self, writer: ColumnWriter) -> Result<()> {
+        self.close_column(writer)
+    }
+}
+
+impl LeafColumnWriters for ColumnChunkEncoder {
+    fn next_leaf_writer(&mut self) -> Result<ColumnWriter> {
+        let col_writer = self.next_column()?.expect("Unable to get column writer");
+        Ok(col_writer)
+    }
+
+    fn close_leaf_writer(&mut self, writer: ColumnWriter) -> Result<()> {
+        self.close_column(writer)
+    }
+}
+
+/// Write the leaves of `arrays` to the column writers, one column chunk per leaf.
+///
+/// All the arrays must be of the same type, and `levels` holds the levels of each
+/// array, with the levels of the first leaf at the end.
+fn write_leaves<L: LeafColumnWriters>(
+    writers: &mut L,
+    arrays: &[arrow_array::ArrayRef],
+    levels: &mut [Vec<LevelInfo>],
 ) -> Result<()> {
-    match array.data_type() {
+    assert_eq!(arrays.len(), levels.len());
+    let data_type = arrays
+        .first()
+        .expect("Expected at least one array to write")
+        .data_type();
+    match data_type {
         ArrowDataType::Null
         | ArrowDataType::Boolean
         | ArrowDataType::Int8
@@ -148,43 +351,73 @@ fn write_leaves(
         | ArrowDataType::LargeUtf8
         | ArrowDataType::Decimal(_, _)
         | ArrowDataType::FixedSizeBinary(_) => {
-            let mut col_writer = get_col_writer(&mut row_group_writer)?;
-            write_leaf(
-                &mut col_writer,
-                array,
-                levels.pop().expect("Levels exhausted"),
-            )?;
-            row_group_writer.close_column(col_writer)?;
+            let mut col_writer = writers.next_leaf_writer()?;
+            for (array, levels) in arrays.iter().zip(levels.iter_mut()) {
+                write_leaf(
+                    &mut col_writer,
+                    array,
+                    levels.pop().expect("Levels exhausted"),
+                )?;
+            }
+            writers.close_leaf_writer(col_writer)?;
             Ok(())
         }
         ArrowDataType::List(_) | ArrowDataType::LargeList(_) => {
-            // write the child list
-            let data = array.data();
-            let child_array = arrow_array::make_array(data.child_data()[0].clone());
-            write_leaves(&mut row_group_writer, &child_array, &mut levels)?;
+            // write the child lists
+            let child_arrays: Vec<_> = arrays
+                .iter()
+                .map(|array| {
+                    arrow_array::make_array(array.data().child_data()[0].clone())
+                })
+                .collect();
+            write_leaves(writers, &child_arrays, levels)?;
             Ok(())
         }
-        ArrowDataType::Struct(_) => {
-            let struct_array: &arrow_array::StructArray = array
-                .as_any()
-                .downcast_ref::<arrow_array::StructArray>()
-                .expect("Unable to get struct array");
-            for field in struct_array.columns() {
-                write_leaves(&mut row_group_writer, field, &mut levels)?;
+        ArrowDataType::Struct(fields) => {
+            // group the child arrays of each struct array by field
+            let mut field_arrays = vec![Vec::with_capacity(arrays.len()); fields.len()];
+            for array in arrays {
+                let struct_array: &arrow_array::StructArray = array
+                    .as_any()
+                    .downcast_ref::<arrow_array::StructArray>()
+                    .expect("Unable to get struct array");
+                for (field_array, column) in
+                    field_arrays.iter_mut().zip(struct_array.columns())
+                {
+                    field_array.push(column.clone());
+                }
+            }
+            for field_array in field_arrays {
+                write_leaves(writers, &field_array, levels)?;
             }
             Ok(())
         }
-        ArrowDataType::Dictionary(_, value_type) => {
-            // cast dictionary to a primitive
-            let array = arrow::compute::cast(array, value_type)?;
-
-            let mut col_writer = get_col_writer(&mut row_group_writer)?;
-            write_leaf(
-                &mut col_writer,
-                &array,
-                levels.pop().expect("Levels exhausted"),
-            )?;
-            row_group_writer.close_column(col_writer)?;
+        ArrowDataType::Dictionary(key_type, value_type) => {
+            let mut col_writer = writers.next_leaf_writer()?;
+            // the dictionary of the last array, reused by the next arrays with the same values
+            let mut dictionary = None;
+            for (array, levels) in arrays.iter().zip(levels.iter_mut()) {
+                let levels = levels.pop().expect("Levels exhausted");
+                match col_writer {
+                    ColumnWriter::ByteArrayColumnWriter(ref mut typed)
+                        if is_byte_array_type(value_type) =>
+                    {
+                        write_byte_array_dictionary_leaf(
+                            typed,
+                            array,
+                            key_type,
+                            &mut dictionary,
+                            levels,
+                        )?;
+                    }
+                    _ => {
+                        // cast dictionary to a primitive
+                        let array = arrow::compute::cast(array, value_type)?;
+                        write_leaf(&mut col_writer, &array, levels)?;
+                    }
+                }
+            }
+            writers.close_leaf_writer(col_writer)?;
             Ok(())
         }
         ArrowDataType::Float16 => Err(ParquetError::ArrowError(
@@ -194,7 +427,7 @@ fn write_leaves(
             Err(ParquetError::NYI(
                 format!(
                     "Attempting to write an Arrow type {:?} to parquet that is not yet implemented", 
-                    array.data_type()
+                    data_type
                 )
             ))
         }
@@ -382,6 +615,160 @@ fn write_leaf(
     Ok(written as i64)
 }
 
+fn is_byte_array_type(data_type: &ArrowDataType) -> bool {
+    matches!(
+        data_type,
+        ArrowDataType::Binary
+            | ArrowDataType::LargeBinary
+            | ArrowDataType::Utf8
+            | ArrowDataType::LargeUtf8
+    )
+}
+
+/// Writes a dictionary array of binary or string values without converting each of its
+/// values, by writing its keys into the parquet dictionary built from its values.
+///
+/// `dictionary` holds the values of the previously written array and their parquet
+/// dictionary, which is reused if `column` has the same values, so that the values are
+/// only converted and hashed again when the dictionary changes between arrays.
+fn write_byte_array_dictionary_leaf(
+    writer: &mut ColumnWriterImpl<ByteArrayType>,
+    column: &arrow_array::ArrayRef,
+    key_type: &ArrowDataType,
+    dictionary: &mut Option<(arrow_array::ArrayRef, BatchDictionary<ByteArrayType>)>,
+    levels: LevelInfo,
+) -> Result<i64> {
+    let indices = levels.filter_array_indices();
+    let (keys, values) = match key_type {
+        ArrowDataType::Int8 => {
+            get_dictionary_keys::<arrow::datatypes::Int8Type>(column, &indices)
+        }
+        ArrowDataType::Int16 => {
+            get_dictionary_keys::<arrow::datatypes::Int16Type>(column, &indices)
+        }
+        ArrowDataType::Int32 => {
+            get_dictionary_keys::<arrow::datatypes::Int32Type>(column, &indices)
+        }
+        ArrowDataType::Int64 => {
+            get_dictionary_keys::<arrow::datatypes::Int64Type>(column, &indices)
+        }
+        ArrowDataType::UInt8 => {
+            get_dictionary_keys::<arrow::datatypes::UInt8Type>(column, &indices)
+        }
+        ArrowDataType::UInt16 => {
+            get_dictionary_keys::<arrow::datatypes::UInt16Type>(column, &indices)
+        }
+        ArrowDataType::UInt32 => {
+            get_dictionary_keys::<arrow::datatypes::UInt32Type>(column, &indices)
+        }
+        ArrowDataType::UInt64 => {
+            get_dictionary_keys::<arrow::datatypes::UInt64Type>(column, &indices)
+        }
+        _ => {
+            return Err(ParquetError::ArrowError(format!(
+                "Dictionary key type {:?} is not supported",
+                key_type
+            )))
+        }
+    }?;
+
+    let reuse = match dictionary {
+        Some((previous, _)) => {
+            is_same_memory(previous.data_ref(), values.data_ref())
+                || previous.data_ref() == values.data_ref()
+        }
+        None => false,
+    };
+    if !reuse {
+        let dictionary_values = get_byte_array_dictionary_values(&values);
+        *dictionary = Some((values, BatchDictionary::new(dictionary_values)));
+    }
+    let (_, dictionary) = dictionary.as_mut().unwrap();
+
+    let written = writer.write_batch_with_dictionary(
+        dictionary,
+        &keys,
+        Some(levels.definition.as_slice()),
+        levels.repetition.as_deref(),
+    )?;
+    Ok(written as i64)
+}
+
+/// Returns whether `a` and `b` are views of the same memory, such as the values of a
+/// dictionary array and of its slices, in which case they are equal.
+fn is_same_memory(a: &arrow::array::ArrayData, b: &arrow::array::ArrayData) -> bool {
+    let same_buffer = |a: &arrow::buffer::Buffer, b: &arrow::buffer::Buffer| {
+        a.as_ptr() == b.as_ptr() && a.len() == b.len()
+    };
+    a.data_type() == b.data_type()
+        && a.len() == b.len()
+        && a.offset() == b.offset()
+        && a.buffers().len() == b.buffers().len()
+        && a.buffers()
+            .iter()
+            .zip(b.buffers())
+            .all(|(a, b)| same_buffer(a, b))
+        && match (a.null_buffer(), b.null_buffer()) {
+            (Some(a), Some(b)) => same_buffer(a, b),
+            (None, None) => true,
+            _ => false,
+        }
+}
+
+/// Returns the keys of the dictionary array `array` at `indices`, and its values.
+fn get_dictionary_keys<K: arrow::datatypes::ArrowDictionaryKeyType>(
+    array: &arrow_array::ArrayRef,
+    indices: &[usize],
+) -> Result<(Vec<usize>, arrow_array::ArrayRef)> {
+    use arrow::datatypes::ArrowNativeType;
+
+    let array = array
+        .as_any()
+        .downcast_ref::<arrow_array::DictionaryArray<K>>()
+        .expect("Unable to get dictionary array");
+    let keys = array.keys();
+    let keys = indices
+        .iter()
+        .map(|i| {
+            let key = keys.value(*i);
+            key.to_usize().ok_or_else(|| {
+                ParquetError::ArrowError(format!("Invalid dictionary key {:?}", key))
+            })
+        })
+        .collect::<Result<Vec<_>>>()?;
+    Ok((keys, array.values()))
+}
+
+/// Returns all the values of a binary or string array, with null values as empty values.
+fn get_byte_array_dictionary_values(array: &arrow_array::ArrayRef) -> Vec<ByteArray> {
+    macro_rules! values {
+        ($ty:ty) => {{
+            let array = array
+                .as_any()
+                .downcast_ref::<$ty>()
+                .expect("Unable to get dictionary values");
+            (0..array.len())
+                .map(|i| {
+                    let bytes: Vec<u8> = if array.is_valid(i) {
+                        array.value(i).into()
+                    } else {
+                        vec![]
+                    };
+                    ByteArray::from(bytes)
+                })
+                .collect()
+        }};
+    }
+
+    match array.data_type() {
+        ArrowDataType::Binary => values!(arrow_array::BinaryArray),
+        ArrowDataType::LargeBinary => values!(arrow_array::LargeBinaryArray),
+        ArrowDataType::Utf8 => values!(arrow_array::StringArray),
+        ArrowDataType::LargeUtf8 => values!(arrow_array::LargeStringArray),
+        _ => unreachable!("Dictionary values are checked by is_byte_array_type"),
+    }
+}
+
 macro_rules! def_get_binary_array_fn {
     ($name:ident, $ty:ty) => {
         fn $name(array: &$ty) -> Vec<ByteArray> {
@@ -505,7 +892,10 @@ mod tests {
     use arrow::{array::*, buffer::Buffer};
 
     use crate::arrow::{ArrowReader, ParquetFileArrowReader};
-    use crate::file::{reader::SerializedFileReader, writer::InMemoryWriteableCursor};
+    use crate::file::{
+        reader::{FileReader, SerializedFileReader},
+        writer::InMemoryWriteableCursor,
+    };
     use crate::util::test_common::get_temp_file;
 
     #[test]
@@ -805,7 +1195,69 @@ mod tests {
         )
         .unwrap();
 
-        roundtrip("test_arrow_writer_complex.parquet", batch);
+        roundtrip("test_arrow_writer_complex.parquet", batch.clone());
+
+        // encode the columns concurrently
+        let props = WriterProperties::builder().set_write_threads(2).build();
+        roundtrip_with_props(
+            "test_arrow_writer_complex_parallel.parquet",
+            batch,
+            Some(props),
+        );
+    }
+
+    #[test]
+    fn arrow_writer_parallel_matches_sequential() {
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("a", DataType::Int32, false),
+            Field::new("b", DataType::Utf8, true),
+            Field::new("c", DataType::Float64, true),
+        ]));
+        let batches: Vec<_> = (0..5)
+            .map(|i| {
+                let a = Int32Array::from((i * 100..(i + 1) * 100).collect::<Vec<_>>());
+                let b: StringArray = (0..100)
+                    .map(|j| {
+                        if j % 3 == 0 {
+                            None
+                        } else {
+                            Some(format!("{}", j))
+                        }
+                    })
+                    .collect();
+                let c: Float64Array = (0..100)
+                    .map(|j| if j % 7 == 0 { None } else { Some(j as f64) })
+                    .collect();
+                RecordBatch::try_new(
+                    schema.clone(),
+                    vec![Arc::new(a), Arc::new(b), Arc::new(c)],
+                )
+                .unwrap()
+            })
+            .collect();
+
+        let write = |write_threads: usize| {
+            let props = WriterProperties::builder()
+                .set_max_row_group_size(200)
+                .set_compression(crate::basic::Compression::SNAPPY)
+                .set_write_threads(write_threads)
+                .build();
+            let cursor = InMemoryWriteableCursor::default();
+            {
+                let mut writer =
+                    ArrowWriter::try_new(cursor.clone(), schema.clone(), Some(props))
+                        .unwrap();
+                for batch in &batches {
+                    writer.write(batch).unwrap();
+                }
+                writer.close().unwrap();
+            }
+            cursor.into_inner().unwrap()
+        };
+
+        let sequential = write(1);
+        assert_eq!(sequential, write(2));
+        assert_eq!(sequential, write(8));
     }
 
     #[test]
@@ -903,15 +1355,125 @@ mod tests {
         roundtrip("test_arrow_writer_2_level_struct_mixed_null.parquet", batch);
     }
 
+    /// Writes `batch_sizes` batches of sequential Int32 values, returning the number
+    /// of rows in each row group of the resulting file.
+    fn write_batches_row_groups(
+        filename: &str,
+        props: WriterProperties,
+        batch_sizes: &[i32],
+        flush_after: Option<usize>,
+    ) -> Vec<i64> {
+        let schema = Arc::new(Schema::new(vec![Field::new("a", DataType::Int32, false)]));
+        let file = get_temp_file(filename, &[]);
+        let mut writer =
+            ArrowWriter::try_new(file.try_clone().unwrap(), schema.clone(), Some(props))
+                .unwrap();
+
+        let mut start = 0;
+        for (i, size) in batch_sizes.iter().enumerate() {
+            let values = Int32Array::from((start..start + size).collect::<Vec<i32>>());
+            start += size;
+            let batch =
+                RecordBatch::try_new(schema.clone(), vec![Arc::new(values)]).unwrap();
+            writer.write(&batch).unwrap();
+            if flush_after == Some(i) {
+                writer.flush().unwrap();
+            }
+        }
+        writer.close().unwrap();
+
+        let reader = SerializedFileReader::new(file).unwrap();
+        let row_groups = reader
+            .metadata()
+            .row_groups()
+            .iter()
+            .map(|rg| rg.num_rows())
+            .collect();
+
+        // all values should be read back in order, across row groups
+        let mut arrow_reader = ParquetFileArrowReader::new(Arc::new(reader));
+        let mut record_batch_reader = arrow_reader.get_record_reader(1024).unwrap();
+        let actual_batch = record_batch_reader
+            .next()
+            .expect("No batch found")
+            .expect("Unable to get batch");
+        let expected = Int32Array::from((0..start).collect::<Vec<i32>>());
+        assert_eq!(expected.data(), actual_batch.column(0).data());
+
+        row_groups
+    }
+
+    #[test]
+    fn arrow_writer_buffers_batches_into_row_groups() {
+        let props = WriterProperties::builder()
+            .set_max_row_group_size(10)
+            .build();
+        let row_groups = write_batches_row_groups(
+            "test_arrow_writer_buffers_batches_into_row_groups.parquet",
+            props,
+            &[4; 7],
+            None,
+        );
+        assert_eq!(row_groups, vec![8, 8, 8, 4]);
+    }
+
+    #[test]
+    fn arrow_writer_row_group_exact_size() {
+        let props = WriterProperties::builder()
+            .set_max_row_group_size(10)
+            .build();
+        let row_groups = write_batches_row_groups(
+            "test_arrow_writer_row_group_exact_size.parquet",
+            props,
+            &[5, 5, 5, 20, 3],
+            None,
+        );
+        // a batch larger than the limit is written as a row group of its own
+        assert_eq!(row_groups, vec![10, 5, 20, 3]);
+    }
+
+    #[test]
+    fn arrow_writer_flush_row_group() {
+        let row_groups = write_batches_row_groups(
+            "test_arrow_writer_flush_row_group.parquet",
+            WriterProperties::builder().build(),
+            &[3, 3, 3],
+            Some(0),
+        );
+        assert_eq!(row_groups, vec![3, 6]);
+    }
+
+    #[test]
+    fn arrow_writer_max_row_group_byte_size() {
+        let props = WriterProperties::builder()
+            .set_max_row_group_byte_size(1)
+            .build();
+        let row_groups = write_batches_row_groups(
+            "test_arrow_writer_max_row_group_byte_size.parquet",
+            props,
+            &[3, 4, 5],
+            None,
+        );
+        assert_eq!(row_groups, vec![3, 4, 5]);
+    }
+
     const SMALL_SIZE: usize = 4;
 
     fn roundtrip(filename: &str, expected_batch: RecordBatch) {
+        roundtrip_with_props(filename, expected_batch, None)
+    }
+
+    fn roundtrip_with_props(
+        filename: &str,
+        expected_batch: RecordBatch,
+        props: Option<WriterProperties>,
+    ) {
         let file = get_temp_file(filename, &[]);
 
         let mut writer = ArrowWriter::try_new(
             file.try_clone().unwrap(),
             expected_batch.schema(),
-            None,
+            props,
         )
         .expect("Unable to write file");
         writer.write(&expected_batch).unwrap();
@@ -1344,6 +1906,64 @@ mod tests {
         );
     }
 
+    #[test]
+    fn arrow_writer_string_dictionary_batches() {
+        let schema = Arc::new(Schema::new(vec![Field::new_dict(
+            "dictionary",
+            DataType::Dictionary(Box::new(DataType::Int16), Box::new(DataType::Utf8)),
+            true,
+            42,
+            true,
+        )]));
+
+        let first: Int16DictionaryArray =
+            vec![Some("alpha"), None, Some("beta"), Some("alpha")]
+                .into_iter()
+                .collect();
+        // shares the dictionary of `first`
+        let second = first.slice(1, 3);
+        // a different dictionary, whose keys must be remapped
+        let third: Int16DictionaryArray = vec![Some("gamma"), Some("beta"), None]
+            .into_iter()
+            .collect();
+        let batches: Vec<RecordBatch> =
+            vec![Arc::new(first) as ArrayRef, second, Arc::new(third)]
+                .into_iter()
+                .map(|array| RecordBatch::try_new(schema.clone(), vec![array]).unwrap())
+                .collect();
+
+        let file =
+            get_temp_file("test_arrow_writer_string_dictionary_batches.parquet", &[]);
+        let mut writer =
+            ArrowWriter::try_new(file.try_clone().unwrap(), schema, None).unwrap();
+        for batch in &batches {
+            writer.write(batch).unwrap();
+        }
+        writer.close().unwrap();
+
+        let reader = SerializedFileReader::new(file).unwrap();
+        let metadata = reader.metadata().row_group(0).column(0);
+        assert!(metadata.dictionary_page_offset().is_some());
+        let mut arrow_reader = ParquetFileArrowReader::new(Arc::new(reader));
+        let mut record_batch_reader = arrow_reader.get_record_reader(1024).unwrap();
+        let actual = record_batch_reader.next().unwrap().unwrap();
+
+        let actual = arrow::compute::cast(actual.column(0), &DataType::Utf8).unwrap();
+        let expected: ArrayRef = Arc::new(StringArray::from(vec![
+            Some("alpha"),
+            None,
+            Some("beta"),
+            Some("alpha"),
+            None,
+            Some("beta"),
+            Some("alpha"),
+            Some("gamma"),
+            Some("beta"),
+            None,
+        ]));
+        assert_eq!(&actual, &expected);
+    }
+
     #[test]
     fn arrow_writer_primitive_dictionary() {
         // define schema
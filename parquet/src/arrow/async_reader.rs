@@ -0,0 +1,486 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Contains a reader which asynchronously reads parquet data into a stream of arrow
+//! record batches. Requires the `async` feature.
+
+use std::future::Future;
+use std::ops::Range;
+use std::pin::Pin;
+use std::sync::Arc;
+use std::task::{Context, Poll};
+
+use arrow::datatypes::{Schema, SchemaRef};
+use arrow::error::Result as ArrowResult;
+use arrow::record_batch::RecordBatch;
+use futures::future::{maybe_done, try_join_all, BoxFuture, FutureExt, MaybeDone};
+use futures::stream::Stream;
+
+use crate::arrow::array_reader::build_array_reader;
+use crate::arrow::arrow_reader::ParquetRecordBatchReader;
+use crate::arrow::schema::{parquet_to_arrow_schema, parquet_to_arrow_schema_by_columns};
+use crate::errors::{ParquetError, Result};
+use crate::file::async_reader::{parse_metadata, AsyncChunkReader};
+use crate::file::metadata::ParquetMetaData;
+use crate::file::prefetch::{coalesce_ranges, DEFAULT_MAX_HOLE_SIZE};
+use crate::file::serialized_reader::{BufferedChunks, SerializedFileReader};
+
+type RowGroupFetch = MaybeDone<BoxFuture<'static, Result<BufferedChunks>>>;
+
+/// A stream of arrow [`RecordBatch`]es read from a Parquet file through an
+/// [`AsyncChunkReader`].
+///
+/// The projected column chunks of a row group are requested concurrently, merging
+/// those that are close to each other into a single request, and the next row group
+/// is fetched while the current one is decoded, so that the stream waits on at most
+/// one round trip per row group. Decoding itself is synchronous and
+/// happens while polling the stream. Record batches do not span row groups.
+pub struct ParquetRecordBatchStream<R: AsyncChunkReader> {
+    chunk_reader: Arc<R>,
+    metadata: Arc<ParquetMetaData>,
+    /// The arrow schema of the whole file
+    file_schema: Schema,
+    /// The arrow schema of the returned record batches
+    schema: SchemaRef,
+    /// The leaf columns to read
+    column_indices: Vec<usize>,
+    batch_size: usize,
+    /// The largest gap between two column chunks for them to be fetched together
+    max_hole_size: u64,
+    /// The index of the next row group to fetch
+    next_row_group: usize,
+    /// The pending fetch of row group `next_row_group - 1`
+    fetch: Option<RowGroupFetch>,
+    /// The reader of the row group currently being decoded
+    reader: Option<ParquetRecordBatchReader>,
+}
+
+impl<R: AsyncChunkReader + 'static> ParquetRecordBatchStream<R> {
+    /// Fetches the metadata of the Parquet file read by `chunk_reader`, and returns
+    /// a stream of record batches of all its columns.
+    ///
+    /// See [`ArrowReader::get_record_reader`](crate::arrow::ArrowReader::get_record_reader)
+    /// for the meaning of `batch_size`.
+    pub async fn try_new(chunk_reader: R, batch_size: usize) -> Result<Self> {
+        let metadata = parse_metadata(&chunk_reader).await?;
+        let column_indices =
+            (0..metadata.file_metadata().schema_descr().num_columns()).collect();
+        Self::new_with_metadata(
+            Arc::new(chunk_reader),
+            metadata,
+            column_indices,
+            batch_size,
+        )
+    }
+
+    /// Fetches the metadata of the Parquet file read by `chunk_reader`, and returns
+    /// a stream of record batches of the leaf columns identified by `column_indices`.
+    pub async fn try_new_by_columns(
+        chunk_reader: R,
+        column_indices: Vec<usize>,
+        batch_size: usize,
+    ) -> Result<Self> {
+        let metadata = parse_metadata(&chunk_reader).await?;
+        Self::new_with_metadata(
+            Arc::new(chunk_reader),
+            metadata,
+            column_indices,
+            batch_size,
+        )
+    }
+
+    /// Returns a stream of record batches of the leaf columns identified by
+    /// `column_indices`, for a file whose metadata has already been fetched.
+    pub fn new_with_metadata(
+        chunk_reader: Arc<R>,
+        metadata: ParquetMetaData,
+        column_indices: Vec<usize>,
+        batch_size: usize,
+    ) -> Result<Self> {
+        let file_metadata = metadata.file_metadata();
+        let num_columns = file_metadata.schema_descr().num_columns();
+        if let Some(i) = column_indices.iter().find(|i| **i >= num_columns) {
+            return Err(general_err!(
+                "Column index {} out of bound, the file has {} columns",
+                i,
+                num_columns
+            ));
+        }
+        let file_schema = parquet_to_arrow_schema(
+            file_metadata.schema_descr(),
+            file_metadata.key_value_metadata(),
+        )?;
+        let schema = parquet_to_arrow_schema_by_columns(
+            file_metadata.schema_descr(),
+            column_indices.clone(),
+            file_metadata.key_value_metadata(),
+        )?;
+
+        Ok(Self {
+            chunk_reader,
+            metadata: Arc::new(metadata),
+            file_schema,
+            schema: Arc::new(schema),
+            column_indices,
+            batch_size,
+            max_hole_size: DEFAULT_MAX_HOLE_SIZE,
+            next_row_group: 0,
+            fetch: None,
+            reader: None,
+        })
+    }
+
+    /// Sets the largest gap between two projected column chunks of a row group for
+    /// them to be fetched with a single request. The bytes in between are discarded.
+    /// Defaults to [`DEFAULT_MAX_HOLE_SIZE`].
+    pub fn with_max_hole_size(mut self, max_hole_size: u64) -> Self {
+        self.max_hole_size = max_hole_size;
+        self
+    }
+
+    /// Returns the arrow schema of the record batches in this stream.
+    pub fn schema(&self) -> SchemaRef {
+        self.schema.clone()
+    }
+
+    /// Returns the metadata of the Parquet file being read.
+    pub fn metadata(&self) -> &ParquetMetaData {
+        &self.metadata
+    }
+
+    /// Starts fetching the projected column chunks of row group `i`. Column chunks
+    /// close to each other are fetched with a single request, and all requests are
+    /// issued concurrently.
+    fn fetch_row_group(&self, i: usize) -> RowGroupFetch {
+        let row_group = self.metadata.row_group(i);
+        let ranges: Vec<Range<u64>> = self
+            .column_indices
+            .iter()
+            .map(|c| {
+                let (start, length) = row_group.column(*c).byte_range();
+                start..start + length
+            })
+            .collect();
+        let ranges = coalesce_ranges(&ranges, self.max_hole_size);
+        let chunk_reader = self.chunk_reader.clone();
+
+        let fetch = async move {
+            let data = try_join_all(ranges.iter().map(|range| {
+                chunk_reader.get_bytes(range.start, (range.end - range.start) as usize)
+            }))
+            .await?;
+            let mut chunks = BufferedChunks::new(chunk_reader.len());
+            for (range, data) in ranges.into_iter().zip(data) {
+                chunks.insert(range.start, data);
+            }
+            Ok(chunks)
+        };
+        maybe_done(fetch.boxed())
+    }
+
+    /// Returns a reader decoding row group `i` from its fetched column chunks.
+    fn decode_row_group(
+        &self,
+        i: usize,
+        chunks: BufferedChunks,
+    ) -> Result<ParquetRecordBatchReader> {
+        let metadata = ParquetMetaData::new(
+            self.metadata.file_metadata().clone(),
+            vec![self.metadata.row_group(i).clone()],
+        );
+        let file_reader = SerializedFileReader::new_with_metadata(chunks, metadata);
+        let array_reader = build_array_reader(
+            self.metadata.file_metadata().schema_descr_ptr(),
+            self.file_schema.clone(),
+            self.column_indices.clone(),
+            Arc::new(file_reader),
+        )?;
+        ParquetRecordBatchReader::try_new(self.batch_size, array_reader)
+    }
+}
+
+impl<R: AsyncChunkReader + 'static> Stream for ParquetRecordBatchStream<R> {
+    type Item = ArrowResult<RecordBatch>;
+
+    fn poll_next(self: Pin<&mut Self>, cx: &mut Context<'_>) -> Poll<Option<Self::Item>> {
+        let this = self.get_mut();
+        loop {
+            // keep one row group in flight while the current one is decoded
+            if this.fetch.is_none()
+                && this.next_row_group < this.metadata.num_row_groups()
+            {
+                this.fetch = Some(this.fetch_row_group(this.next_row_group));
+                this.next_row_group += 1;
+            }
+            if let Some(fetch) = this.fetch.as_mut() {
+                // completion is stored in the `MaybeDone`, and taken below once the
+                // current row group is exhausted
+                let _ = Pin::new(fetch).poll(cx);
+            }
+
+            if let Some(reader) = this.reader.as_mut() {
+                match reader.next() {
+                    Some(batch) => return Poll::Ready(Some(batch)),
+                    None => this.reader = None,
+                }
+            }
+
+            let chunks = match this.fetch.as_mut() {
+                None => return Poll::Ready(None),
+                Some(fetch) => match Pin::new(fetch).take_output() {
+                    Some(chunks) => chunks,
+                    // the waker was registered when polling the fetch above
+                    None => return Poll::Pending,
+                },
+            };
+            this.fetch = None;
+
+            let row_group = this.next_row_group - 1;
+            match chunks.and_then(|chunks| this.decode_row_group(row_group, chunks)) {
+                Ok(reader) => this.reader = Some(reader),
+                Err(e) => {
+                    // stop fetching once an error is returned
+                    this.next_row_group = this.metadata.num_row_groups();
+                    return Poll::Ready(Some(Err(e.into())));
+                }
+            }
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use std::io::Read;
+    use std::sync::atomic::{AtomicUsize, Ordering};
+
+    use arrow::array::{Array, ArrayRef, Int32Array, StringArray};
+    use arrow::datatypes::{DataType, Field};
+    use futures::executor::block_on;
+    use futures::stream::TryStreamExt;
+
+    use crate::arrow::arrow_reader::{ArrowReader, ParquetFileArrowReader};
+    use crate::arrow::arrow_writer::ArrowWriter;
+    use crate::file::properties::WriterProperties;
+    use crate::file::reader::Length;
+    use crate::file::serialized_reader::SliceableCursor;
+    use crate::util::cursor::InMemoryWriteableCursor;
+    use crate::util::test_common::get_test_file;
+
+    /// Counts the requests made to the wrapped reader
+    struct CountingReader {
+        inner: SliceableCursor,
+        requests: AtomicUsize,
+    }
+
+    impl Length for CountingReader {
+        fn len(&self) -> u64 {
+            self.inner.len()
+        }
+    }
+
+    impl AsyncChunkReader for CountingReader {
+        fn get_bytes(&self, start: u64, length: usize) -> BoxFuture<'_, Result<Vec<u8>>> {
+            self.requests.fetch_add(1, Ordering::SeqCst);
+            self.inner.get_bytes(start, length)
+        }
+    }
+
+    /// Writes `num_rows` rows in batches of 100 rows
+    fn test_file(num_rows: i32, max_row_group_size: usize) -> Vec<u8> {
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("a", DataType::Int32, false),
+            Field::new("b", DataType::Utf8, true),
+            Field::new("c", DataType::Int32, true),
+        ]));
+        let props = WriterProperties::builder()
+            .set_max_row_group_size(max_row_group_size)
+            .build();
+        let cursor = InMemoryWriteableCursor::default();
+        let mut writer =
+            ArrowWriter::try_new(cursor.clone(), schema.clone(), Some(props)).unwrap();
+
+        for start in (0..num_rows).step_by(100) {
+            let rows = start..(start + 100).min(num_rows);
+            let a: ArrayRef =
+                Arc::new(Int32Array::from(rows.clone().collect::<Vec<_>>()));
+            let b: ArrayRef = Arc::new(StringArray::from(
+                rows.clone()
+                    .map(|i| {
+                        if i % 3 == 0 {
+                            None
+                        } else {
+                            Some(i.to_string())
+                        }
+                    })
+                    .collect::<Vec<_>>(),
+            ));
+            let c: ArrayRef = Arc::new(Int32Array::from(
+                rows.map(|i| if i % 2 == 0 { Some(-i) } else { None })
+                    .collect::<Vec<_>>(),
+            ));
+            let batch = RecordBatch::try_new(schema.clone(), vec![a, b, c]).unwrap();
+            writer.write(&batch).unwrap();
+        }
+        writer.close().unwrap();
+        cursor.data()
+    }
+
+    /// Reads all of `data` into a single record batch with the synchronous reader
+    fn read_sync(data: Vec<u8>, columns: Vec<usize>) -> RecordBatch {
+        let file_reader = SerializedFileReader::new(SliceableCursor::new(data)).unwrap();
+        let num_rows = file_reader.metadata().file_metadata().num_rows() as usize;
+        let mut arrow_reader = ParquetFileArrowReader::new(Arc::new(file_reader));
+        let mut batches = arrow_reader
+            .get_record_reader_by_columns(columns, num_rows)
+            .unwrap()
+            .collect::<ArrowResult<Vec<_>>>()
+            .unwrap();
+        assert_eq!(batches.len(), 1);
+        batches.remove(0)
+    }
+
+    fn assert_batches_eq(batches: &[RecordBatch], expected: &RecordBatch) {
+        for column in 0..expected.num_columns() {
+            let mut offset = 0;
+            for batch in batches {
+                assert_eq!(batch.schema().fields(), expected.schema().fields());
+                let expected = expected.column(column).slice(offset, batch.num_rows());
+                assert_eq!(batch.column(column).data(), expected.data());
+                offset += batch.num_rows();
+            }
+            assert_eq!(offset, expected.num_rows());
+        }
+    }
+
+    #[test]
+    fn test_async_reader_matches_sync_reader() {
+        let data = test_file(1000, 300);
+        let reader = SliceableCursor::new(data.clone());
+
+        let stream = block_on(ParquetRecordBatchStream::try_new_by_columns(
+            reader,
+            vec![0, 2],
+            128,
+        ))
+        .unwrap();
+        assert_eq!(stream.metadata().num_row_groups(), 4);
+        let schema = stream.schema();
+        let batches: Vec<RecordBatch> = block_on(stream.try_collect()).unwrap();
+
+        // batches do not span row groups
+        let batch_rows: Vec<usize> = batches.iter().map(|b| b.num_rows()).collect();
+        assert_eq!(
+            batch_rows,
+            vec![128, 128, 44, 128, 128, 44, 128, 128, 44, 100]
+        );
+
+        let expected = read_sync(data, vec![0, 2]);
+        assert_eq!(schema.fields(), expected.schema().fields());
+        assert_batches_eq(&batches, &expected);
+    }
+
+    #[test]
+    fn test_async_reader_requests() {
+        let reader = Arc::new(CountingReader {
+            inner: SliceableCursor::new(test_file(1000, 300)),
+            requests: AtomicUsize::new(0),
+        });
+        let metadata = block_on(parse_metadata(reader.as_ref())).unwrap();
+        assert_eq!(reader.requests.load(Ordering::SeqCst), 1);
+
+        let stream = ParquetRecordBatchStream::new_with_metadata(
+            reader.clone(),
+            metadata,
+            vec![1],
+            1024,
+        )
+        .unwrap();
+        let batches: Vec<RecordBatch> = block_on(stream.try_collect()).unwrap();
+        assert_eq!(batches.len(), 4);
+        let values = batches[3]
+            .column(0)
+            .as_any()
+            .downcast_ref::<StringArray>()
+            .unwrap();
+        assert!(values.is_null(0));
+        assert_eq!(values.value(1), "901");
+
+        // one request per projected column chunk
+        assert_eq!(reader.requests.load(Ordering::SeqCst), 1 + 4);
+    }
+
+    #[test]
+    fn test_async_reader_max_hole_size() {
+        let data = test_file(1000, 300);
+        let expected = read_sync(data.clone(), vec![0, 2]);
+
+        for (max_hole_size, expected_requests) in vec![(0, 8), (DEFAULT_MAX_HOLE_SIZE, 4)]
+        {
+            let reader = Arc::new(CountingReader {
+                inner: SliceableCursor::new(data.clone()),
+                requests: AtomicUsize::new(0),
+            });
+            let metadata = block_on(parse_metadata(reader.as_ref())).unwrap();
+            let stream = ParquetRecordBatchStream::new_with_metadata(
+                reader.clone(),
+                metadata,
+                vec![0, 2],
+                1024,
+            )
+            .unwrap()
+            .with_max_hole_size(max_hole_size);
+            let batches: Vec<RecordBatch> = block_on(stream.try_collect()).unwrap();
+            assert_batches_eq(&batches, &expected);
+            assert_eq!(
+                reader.requests.load(Ordering::SeqCst),
+                1 + expected_requests
+            );
+        }
+    }
+
+    #[test]
+    fn test_async_reader_invalid_column() {
+        let data = test_file(10, 300);
+        let result = block_on(ParquetRecordBatchStream::try_new_by_columns(
+            SliceableCursor::new(data),
+            vec![3],
+            1024,
+        ));
+        assert_eq!(
+            result.err().unwrap(),
+            general_err!("Column index 3 out of bound, the file has 3 columns")
+        );
+    }
+
+    #[test]
+    fn test_async_reader_test_file() {
+        let mut data = Vec::new();
+        get_test_file("alltypes_plain.parquet")
+            .read_to_end(&mut data)
+            .unwrap();
+        let stream = block_on(ParquetRecordBatchStream::try_new(
+            SliceableCursor::new(data.clone()),
+            3,
+        ))
+        .unwrap();
+        let batches: Vec<RecordBatch> = block_on(stream.try_collect()).unwrap();
+        let expected = read_sync(data, (0..batches[0].num_columns()).collect());
+        assert_batches_eq(&batches, &expected);
+    }
+}
@@ -52,8 +52,11 @@
 pub(in crate::arrow) mod array_reader;
 pub mod arrow_reader;
 pub mod arrow_writer;
+#[cfg(feature = "async")]
+pub mod async_reader;
 pub(in crate::arrow) mod converter;
 pub(in crate::arrow) mod levels;
+pub mod parallel_reader;
 pub(in crate::arrow) mod record_reader;
 pub mod schema;
 
@@ -0,0 +1,450 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Contains a reader which decodes the row groups of a parquet file into arrow
+//! record batches on a pool of threads.
+//!
+//! Each thread opens its own [`FileReader`] and reads whole row groups with a
+//! [`ParquetFileArrowReader`], so that readers such as [`File`](std::fs::File),
+//! whose clones share their position, are never read concurrently.
+//!
+//! ```no_run
+//! # use std::fs::File;
+//! # use std::sync::Arc;
+//! # use parquet::arrow::parallel_reader::ParallelRecordBatchReaderBuilder;
+//! # use parquet::file::reader::{FileReader, SerializedFileReader};
+//! let reader = ParallelRecordBatchReaderBuilder::new(|| {
+//!     let file = File::open("data.parquet")?;
+//!     Ok(Arc::new(SerializedFileReader::new(file)?) as Arc<dyn FileReader>)
+//! })
+//! .with_num_threads(4)
+//! .with_preserve_order(false)
+//! .build()
+//! .unwrap();
+//!
+//! for batch in reader {
+//!     println!("Read {} rows", batch.unwrap().num_rows());
+//! }
+//! ```
+
+use std::collections::VecDeque;
+use std::sync::mpsc::{sync_channel, Receiver, SyncSender};
+use std::sync::{Arc, Mutex};
+use std::thread;
+use std::vec::IntoIter;
+
+use arrow::datatypes::SchemaRef;
+use arrow::error::{ArrowError, Result as ArrowResult};
+use arrow::record_batch::{RecordBatch, RecordBatchReader};
+
+use crate::arrow::arrow_reader::{
+    ArrowReader, ParquetFileArrowReader, RowGroupSubsetReader,
+};
+use crate::errors::{ParquetError, Result};
+use crate::file::reader::FileReader;
+
+/// Opens a reader of the parquet file. Called once by each thread.
+type OpenFn = dyn Fn() -> Result<Arc<dyn FileReader>> + Send + Sync;
+
+/// A record batch of a row group, or `None` once all its record batches were sent.
+type Message = Option<ArrowResult<RecordBatch>>;
+
+/// The row groups left to read, with the sender of their record batches.
+type RowGroupQueue = Mutex<IntoIter<(usize, SyncSender<Message>)>>;
+
+/// Builder of a [`ParallelRecordBatchReader`].
+pub struct ParallelRecordBatchReaderBuilder {
+    open: Arc<OpenFn>,
+    column_indices: Option<Vec<usize>>,
+    batch_size: usize,
+    num_threads: usize,
+    max_buffered_batches: usize,
+    preserve_order: bool,
+}
+
+impl ParallelRecordBatchReaderBuilder {
+    /// Creates a builder of a reader of the file opened by `open`.
+    ///
+    /// `open` is called once to read the metadata of the file, and once by each
+    /// thread. All the readers it returns must have the same row groups.
+    pub fn new<F>(open: F) -> Self
+    where
+        F: Fn() -> Result<Arc<dyn FileReader>> + Send + Sync + 'static,
+    {
+        Self {
+            open: Arc::new(open),
+            column_indices: None,
+            batch_size: 1024,
+            num_threads: 4,
+            max_buffered_batches: 2,
+            preserve_order: true,
+        }
+    }
+
+    /// Sets the leaf columns to read, all of them by default.
+    pub fn with_projection(mut self, column_indices: Vec<usize>) -> Self {
+        self.column_indices = Some(column_indices);
+        self
+    }
+
+    /// Sets the number of rows of each record batch, 1024 by default. Only the last
+    /// record batch of each row group may contain fewer rows.
+    pub fn with_batch_size(mut self, batch_size: usize) -> Self {
+        self.batch_size = batch_size;
+        self
+    }
+
+    /// Sets the number of threads that read row groups, 4 by default.
+    pub fn with_num_threads(mut self, num_threads: usize) -> Self {
+        self.num_threads = num_threads;
+        self
+    }
+
+    /// Sets the number of record batches each thread may decode ahead of the
+    /// consumer before it waits, 2 by default.
+    pub fn with_max_buffered_batches(mut self, max_buffered_batches: usize) -> Self {
+        self.max_buffered_batches = max_buffered_batches;
+        self
+    }
+
+    /// Sets whether record batches are returned in the order of their row groups,
+    /// `true` by default.
+    ///
+    /// Otherwise record batches are returned as soon as they are decoded, and only
+    /// the record batches of each row group are in order.
+    pub fn with_preserve_order(mut self, preserve_order: bool) -> Self {
+        self.preserve_order = preserve_order;
+        self
+    }
+
+    /// Starts the threads and returns the reader of their record batches.
+    pub fn build(self) -> Result<ParallelRecordBatchReader> {
+        if self.num_threads == 0 {
+            return Err(general_err!("Number of threads must be positive"));
+        }
+        if self.max_buffered_batches == 0 {
+            return Err(general_err!("Number of buffered batches must be positive"));
+        }
+
+        let file_reader = (self.open)()?;
+        let num_row_groups = file_reader.num_row_groups();
+        let column_indices = match self.column_indices {
+            Some(column_indices) => column_indices,
+            None => {
+                let schema_descr = file_reader.metadata().file_metadata().schema_descr();
+                (0..schema_descr.num_columns()).collect()
+            }
+        };
+
+        // Builds a reader of no row groups for the schema of the record batches
+        let schema = ParquetFileArrowReader::new(Arc::new(RowGroupSubsetReader::new(
+            file_reader,
+            vec![],
+        )))
+        .get_record_reader_by_columns(column_indices.clone(), self.batch_size)?
+        .schema();
+
+        let mut receivers = VecDeque::new();
+        let mut jobs = Vec::with_capacity(num_row_groups);
+        let num_threads = self.num_threads.min(num_row_groups);
+        if self.preserve_order {
+            for row_group in 0..num_row_groups {
+                let (sender, receiver) = sync_channel(self.max_buffered_batches);
+                jobs.push((row_group, sender));
+                receivers.push_back((receiver, 1));
+            }
+        } else if num_row_groups > 0 {
+            let (sender, receiver) =
+                sync_channel(self.max_buffered_batches * num_threads);
+            for row_group in 0..num_row_groups {
+                jobs.push((row_group, sender.clone()));
+            }
+            receivers.push_back((receiver, num_row_groups));
+        }
+
+        let queue = Arc::new(Mutex::new(jobs.into_iter()));
+        let column_indices = Arc::new(column_indices);
+        for _ in 0..num_threads {
+            let open = self.open.clone();
+            let queue = queue.clone();
+            let column_indices = column_indices.clone();
+            let batch_size = self.batch_size;
+            thread::spawn(move || {
+                read_row_groups(open.as_ref(), &queue, &column_indices, batch_size)
+            });
+        }
+
+        Ok(ParallelRecordBatchReader { schema, receivers })
+    }
+}
+
+/// Reads the row groups of `queue` until it is empty or the reader is dropped.
+fn read_row_groups(
+    open: &OpenFn,
+    queue: &RowGroupQueue,
+    column_indices: &[usize],
+    batch_size: usize,
+) {
+    // Errors are reported for each row group, as the other threads may not fail
+    let file_reader = open().map_err(|e| e.to_string());
+    loop {
+        let next = queue.lock().unwrap().next();
+        let (row_group, sender) = match next {
+            Some(next) => next,
+            None => break,
+        };
+        let sent = match &file_reader {
+            Ok(file_reader) => read_row_group(
+                file_reader,
+                row_group,
+                column_indices,
+                batch_size,
+                &sender,
+            ),
+            Err(message) => sender
+                .send(Some(Err(ArrowError::ParquetError(message.clone()))))
+                .is_ok(),
+        };
+        if !sent || sender.send(None).is_err() {
+            break;
+        }
+    }
+}
+
+/// Sends the record batches of `row_group` to `sender`, up to the first error.
+/// Returns `false` if the reader was dropped.
+fn read_row_group(
+    file_reader: &Arc<dyn FileReader>,
+    row_group: usize,
+    column_indices: &[usize],
+    batch_size: usize,
+    sender: &SyncSender<Message>,
+) -> bool {
+    let mut arrow_reader = ParquetFileArrowReader::new(Arc::new(
+        RowGroupSubsetReader::new(file_reader.clone(), vec![row_group]),
+    ));
+    let batches = match arrow_reader
+        .get_record_reader_by_columns(column_indices.iter().cloned(), batch_size)
+    {
+        Ok(batches) => batches,
+        Err(e) => return sender.send(Some(Err(e.into()))).is_ok(),
+    };
+    for batch in batches {
+        let is_err = batch.is_err();
+        if sender.send(Some(batch)).is_err() {
+            return false;
+        }
+        if is_err {
+            break;
+        }
+    }
+    true
+}
+
+/// A [`RecordBatchReader`] of the record batches decoded by the threads of a
+/// [`ParallelRecordBatchReaderBuilder`].
+///
+/// Dropping the reader stops the threads once they have decoded their next record
+/// batch.
+pub struct ParallelRecordBatchReader {
+    schema: SchemaRef,
+    /// The receivers of the record batches, with the number of row groups they
+    /// receive that are not yet complete
+    receivers: VecDeque<(Receiver<Message>, usize)>,
+}
+
+impl Iterator for ParallelRecordBatchReader {
+    type Item = ArrowResult<RecordBatch>;
+
+    fn next(&mut self) -> Option<Self::Item> {
+        loop {
+            let (receiver, remaining) = self.receivers.front_mut()?;
+            match receiver.recv() {
+                Ok(Some(batch)) => return Some(batch),
+                Ok(None) => {
+                    *remaining -= 1;
+                    if *remaining == 0 {
+                        self.receivers.pop_front();
+                    }
+                }
+                Err(_) => {
+                    self.receivers.clear();
+                    return Some(Err(ArrowError::ParquetError(
+                        "Row group reader thread panicked".to_string(),
+                    )));
+                }
+            }
+        }
+    }
+}
+
+impl RecordBatchReader for ParallelRecordBatchReader {
+    fn schema(&self) -> SchemaRef {
+        self.schema.clone()
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use crate::arrow::ArrowWriter;
+    use crate::file::reader::SerializedFileReader;
+    use crate::util::cursor::{InMemoryWriteableCursor, SliceableCursor};
+    use arrow::array::{Array, Int32Array, StringArray};
+    use arrow::datatypes::{DataType as ArrowDataType, Field, Schema};
+
+    /// Writes `num_row_groups` row groups of 100 rows to memory.
+    fn write_file(num_row_groups: usize) -> SliceableCursor {
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("id", ArrowDataType::Int32, false),
+            Field::new("name", ArrowDataType::Utf8, true),
+        ]));
+        let cursor = InMemoryWriteableCursor::default();
+        let mut writer =
+            ArrowWriter::try_new(cursor.clone(), schema.clone(), None).unwrap();
+        for row_group in 0..num_row_groups as i32 {
+            let ids = (row_group * 100..(row_group + 1) * 100).collect::<Vec<_>>();
+            let names = ids
+                .iter()
+                .map(|id| {
+                    if id % 3 == 0 {
+                        None
+                    } else {
+                        Some(id.to_string())
+                    }
+                })
+                .collect::<StringArray>();
+            let batch = RecordBatch::try_new(
+                schema.clone(),
+                vec![Arc::new(Int32Array::from(ids)), Arc::new(names)],
+            )
+            .unwrap();
+            writer.write(&batch).unwrap();
+            writer.flush().unwrap();
+        }
+        writer.close().unwrap();
+        SliceableCursor::new(cursor.data())
+    }
+
+    fn builder(cursor: SliceableCursor) -> ParallelRecordBatchReaderBuilder {
+        ParallelRecordBatchReaderBuilder::new(move || {
+            Ok(Arc::new(SerializedFileReader::new(cursor.clone())?)
+                as Arc<dyn FileReader>)
+        })
+    }
+
+    fn read_ids(reader: ParallelRecordBatchReader) -> Vec<Vec<i32>> {
+        reader
+            .map(|batch| {
+                let batch = batch.unwrap();
+                let ids = batch
+                    .column(0)
+                    .as_any()
+                    .downcast_ref::<Int32Array>()
+                    .unwrap();
+                ids.values().to_vec()
+            })
+            .collect()
+    }
+
+    #[test]
+    fn test_parallel_reader_preserve_order() {
+        let cursor = write_file(10);
+        let expected = ParquetFileArrowReader::new(Arc::new(
+            SerializedFileReader::new(cursor.clone()).unwrap(),
+        ))
+        .get_record_reader(30)
+        .unwrap()
+        .map(|batch| batch.unwrap())
+        .collect::<Vec<_>>();
+
+        let reader = builder(cursor)
+            .with_batch_size(30)
+            .with_num_threads(3)
+            .with_max_buffered_batches(1)
+            .build()
+            .unwrap();
+        assert_eq!(reader.schema(), expected[0].schema());
+        let batches = reader.map(|batch| batch.unwrap()).collect::<Vec<_>>();
+        assert_eq!(batches.len(), expected.len());
+        for (batch, expected) in batches.iter().zip(expected.iter()) {
+            assert_eq!(batch.num_columns(), expected.num_columns());
+            for i in 0..batch.num_columns() {
+                assert_eq!(batch.column(i).as_ref(), expected.column(i).as_ref());
+            }
+        }
+    }
+
+    #[test]
+    fn test_parallel_reader_relaxed_order() {
+        let reader = builder(write_file(10))
+            .with_batch_size(40)
+            .with_num_threads(4)
+            .with_preserve_order(false)
+            .with_projection(vec![0])
+            .build()
+            .unwrap();
+        assert_eq!(reader.schema().fields().len(), 1);
+
+        let batches = read_ids(reader);
+        // 3 record batches of each row group
+        assert_eq!(batches.len(), 30);
+        let mut ids = batches.into_iter().flatten().collect::<Vec<_>>();
+        ids.sort_unstable();
+        assert_eq!(ids, (0..1000).collect::<Vec<_>>());
+    }
+
+    #[test]
+    fn test_parallel_reader_no_row_groups() {
+        for preserve_order in &[true, false] {
+            let reader = builder(write_file(0))
+                .with_preserve_order(*preserve_order)
+                .build()
+                .unwrap();
+            assert_eq!(reader.schema().fields().len(), 2);
+            assert!(read_ids(reader).is_empty());
+        }
+    }
+
+    #[test]
+    fn test_parallel_reader_drop() {
+        let mut reader = builder(write_file(10))
+            .with_batch_size(10)
+            .with_num_threads(2)
+            .build()
+            .unwrap();
+        assert_eq!(reader.next().unwrap().unwrap().num_rows(), 10);
+        // the threads are blocked on sending, and stop once the reader is dropped
+        drop(reader);
+    }
+
+    #[test]
+    fn test_parallel_reader_errors() {
+        let result = builder(write_file(1)).with_num_threads(0).build();
+        assert_eq!(
+            result.err().unwrap(),
+            general_err!("Number of threads must be positive")
+        );
+
+        let result = ParallelRecordBatchReaderBuilder::new(|| {
+            Err(general_err!("Cannot open file"))
+        })
+        .build();
+        assert_eq!(result.err().unwrap(), general_err!("Cannot open file"));
+    }
+}
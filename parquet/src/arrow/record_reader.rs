@@ -17,11 +17,13 @@
 
 use std::cmp::{max, min};
 use std::mem::{replace, size_of};
+use std::sync::Arc;
 
 use crate::column::{page::PageReader, reader::ColumnReaderImpl};
 use crate::data_type::DataType;
 use crate::errors::{ParquetError, Result};
 use crate::schema::types::ColumnDescPtr;
+use arrow::alloc::MemoryPool;
 use arrow::array::BooleanBufferBuilder;
 use arrow::bitmap::Bitmap;
 use arrow::buffer::{Buffer, MutableBuffer};
@@ -29,8 +31,14 @@ use arrow::buffer::{Buffer, MutableBuffer};
 const MIN_BATCH_SIZE: usize = 1024;
 
 /// A `RecordReader` is a stateful column reader that delimits semantic records.
+///
+/// The values, levels and null bitmap are decoded into arrow buffers, which are handed
+/// over to the arrays read without copying them. If the reader has a [`MemoryPool`],
+/// those buffers are allocated from it, so the pool accounts for the memory of the
+/// arrays read until they are dropped.
 pub struct RecordReader<T: DataType> {
     column_desc: ColumnDescPtr,
+    pool: Option<Arc<dyn MemoryPool>>,
 
     records: MutableBuffer,
     def_levels: Option<MutableBuffer>,
@@ -51,34 +59,51 @@ pub struct RecordReader<T: DataType> {
 
 impl<T: DataType> RecordReader<T> {
     pub fn new(column_schema: ColumnDescPtr) -> Self {
+        Self::try_new_with_pool(column_schema, None)
+            .expect("allocating without a memory pool cannot fail")
+    }
+
+    /// Creates a record reader whose buffers are allocated from `pool`, if any.
+    ///
+    /// Returns an error if `pool` cannot allocate the initial buffers.
+    pub fn try_new_with_pool(
+        column_schema: ColumnDescPtr,
+        pool: Option<Arc<dyn MemoryPool>>,
+    ) -> Result<Self> {
         let (def_levels, null_map) = if column_schema.max_def_level() > 0 {
             (
-                Some(MutableBuffer::new(MIN_BATCH_SIZE)),
-                Some(BooleanBufferBuilder::new(0)),
+                Some(new_buffer(&pool, MIN_BATCH_SIZE)?),
+                Some(new_bitmap_builder(&pool, 0)?),
             )
         } else {
             (None, None)
         };
 
         let rep_levels = if column_schema.max_rep_level() > 0 {
-            Some(MutableBuffer::new(MIN_BATCH_SIZE))
+            Some(new_buffer(&pool, MIN_BATCH_SIZE)?)
         } else {
             None
         };
 
-        Self {
-            records: MutableBuffer::new(MIN_BATCH_SIZE),
+        Ok(Self {
+            records: new_buffer(&pool, MIN_BATCH_SIZE)?,
             def_levels,
             rep_levels,
             null_bitmap: null_map,
             column_reader: None,
             column_desc: column_schema,
+            pool,
             num_records: 0,
             num_values: 0,
             values_seen: 0,
             values_written: 0,
             in_middle_of_record: false,
-        }
+        })
+    }
+
+    /// Returns the memory pool the buffers of this reader are allocated from, if any.
+    pub fn pool(&self) -> Option<&Arc<dyn MemoryPool>> {
+        self.pool.as_ref()
     }
 
     /// Set the current page reader.
@@ -137,6 +162,46 @@ impl<T: DataType> RecordReader<T> {
         Ok(records_read)
     }
 
+    /// Skips the next `num_records` records of a non-repeated column, and returns the
+    /// number of records skipped, which is less than `num_records` only if the column
+    /// chunk has fewer records left.
+    ///
+    /// Values read ahead into the internal buffer are skipped first, and the rest
+    /// by the column reader, mostly without decoding them. Records read before must
+    /// be consumed first.
+    pub fn skip_records(&mut self, num_records: usize) -> Result<usize> {
+        if self.rep_levels.is_some() {
+            return Err(nyi_err!(
+                "Skipping records of repeated column {}",
+                self.column_desc.path()
+            ));
+        }
+        if self.num_records > 0 {
+            return Err(general_err!(
+                "Cannot skip records while {} records are not consumed",
+                self.num_records
+            ));
+        }
+        if self.column_reader.is_none() {
+            return Ok(0);
+        }
+
+        let num_buffered = min(num_records, self.values_written - self.values_seen);
+        if num_buffered > 0 {
+            self.read_records(num_buffered)?;
+            self.consume_def_levels()?;
+            self.consume_record_data()?;
+            self.consume_bitmap_buffer()?;
+            self.reset();
+        }
+        let num_skipped = self
+            .column_reader
+            .as_mut()
+            .unwrap()
+            .skip_records(num_records - num_buffered)?;
+        Ok(num_buffered + num_skipped)
+    }
+
     /// Returns number of records stored in buffer.
     pub fn num_records(&self) -> usize {
         self.num_records
@@ -157,7 +222,7 @@ impl<T: DataType> RecordReader<T> {
         let new_buffer = if let Some(ref mut def_levels_buf) = &mut self.def_levels {
             let num_left_values = self.values_written - self.num_values;
             // create an empty buffer, as it will be resized below
-            let mut new_buffer = MutableBuffer::new(0);
+            let mut new_buffer = new_buffer(&self.pool, 0)?;
             let num_bytes = num_left_values * size_of::<i16>();
             let new_len = self.num_values * size_of::<i16>();
 
@@ -184,7 +249,7 @@ impl<T: DataType> RecordReader<T> {
         let new_buffer = if let Some(ref mut rep_levels_buf) = &mut self.rep_levels {
             let num_left_values = self.values_written - self.num_values;
             // create an empty buffer, as it will be resized below
-            let mut new_buffer = MutableBuffer::new(0);
+            let mut new_buffer = new_buffer(&self.pool, 0)?;
             let num_bytes = num_left_values * size_of::<i16>();
             let new_len = self.num_values * size_of::<i16>();
 
@@ -211,7 +276,7 @@ impl<T: DataType> RecordReader<T> {
         // TODO: Optimize to reduce the copy
         let num_left_values = self.values_written - self.num_values;
         // create an empty buffer, as it will be resized below
-        let mut new_buffer = MutableBuffer::new(0);
+        let mut new_buffer = new_buffer(&self.pool, 0)?;
         let num_bytes = num_left_values * T::get_type_size();
         let new_len = self.num_values * T::get_type_size();
 
@@ -234,10 +299,10 @@ impl<T: DataType> RecordReader<T> {
         if self.column_desc.max_def_level() > 0 {
             assert!(self.null_bitmap.is_some());
             let num_left_values = self.values_written - self.num_values;
-            let new_bitmap_builder = Some(BooleanBufferBuilder::new(max(
-                MIN_BATCH_SIZE,
-                num_left_values,
-            )));
+            let new_bitmap_builder = Some(new_bitmap_builder(
+                &self.pool,
+                max(MIN_BATCH_SIZE, num_left_values),
+            )?);
 
             let old_bitmap = replace(&mut self.null_bitmap, new_bitmap_builder)
                 .map(|mut builder| builder.finish())
@@ -277,7 +342,17 @@ impl<T: DataType> RecordReader<T> {
 
     /// Try to read one batch of data.
     fn read_one_batch(&mut self, batch_size: usize) -> Result<usize> {
-        // Reserve spaces
+        // Reserve spaces, failing if the memory pool cannot allocate them
+        self.records.try_reserve(batch_size * T::get_type_size())?;
+        if let Some(ref mut buf) = self.rep_levels {
+            buf.try_reserve(batch_size * size_of::<i16>())?;
+        }
+        if let Some(ref mut buf) = self.def_levels {
+            buf.try_reserve(batch_size * size_of::<i16>())?;
+        }
+        if let Some(ref mut builder) = self.null_bitmap {
+            builder.try_reserve(batch_size)?;
+        }
         self.records
             .resize(self.records.len() + batch_size * T::get_type_size(), 0);
         if let Some(ref mut buf) = self.rep_levels {
@@ -431,6 +506,28 @@ impl<T: DataType> RecordReader<T> {
     }
 }
 
+/// Returns an empty buffer of at least `capacity` bytes, allocated from `pool` if any.
+fn new_buffer(
+    pool: &Option<Arc<dyn MemoryPool>>,
+    capacity: usize,
+) -> Result<MutableBuffer> {
+    Ok(match pool {
+        Some(pool) => MutableBuffer::try_with_capacity_in(capacity, pool.clone())?,
+        None => MutableBuffer::new(capacity),
+    })
+}
+
+/// Returns a bitmap builder for at least `capacity` bits, allocated from `pool` if any.
+fn new_bitmap_builder(
+    pool: &Option<Arc<dyn MemoryPool>>,
+    capacity: usize,
+) -> Result<BooleanBufferBuilder> {
+    Ok(match pool {
+        Some(pool) => BooleanBufferBuilder::try_new_in(capacity, pool.clone())?,
+        None => BooleanBufferBuilder::new(capacity),
+    })
+}
+
 #[cfg(test)]
 mod tests {
     use super::RecordReader;
@@ -438,7 +535,7 @@ mod tests {
     use crate::column::page::Page;
     use crate::column::page::PageReader;
     use crate::data_type::Int32Type;
-    use crate::errors::Result;
+    use crate::errors::{ParquetError, Result};
     use crate::schema::parser::parse_message_type;
     use crate::schema::types::SchemaDescriptor;
     use crate::util::test_common::page_util::{DataPageBuilder, DataPageBuilderImpl};
@@ -644,6 +741,74 @@ mod tests {
         );
     }
 
+    #[test]
+    fn test_skip_records() {
+        // Construct column schema
+        let message_type = "
+        message test_schema {
+          OPTIONAL INT32 leaf;
+        }
+        ";
+
+        let desc = parse_message_type(message_type)
+            .map(|t| SchemaDescriptor::new(Arc::new(t)))
+            .map(|s| s.column(0))
+            .unwrap();
+
+        // Records data: 1, null, 2, 3, null, 4
+        let make_page_reader = || {
+            let values = [1, 2, 3, 4];
+            let def_levels = [1i16, 0i16, 1i16, 1i16, 0i16, 1i16];
+            let mut pb = DataPageBuilderImpl::new(desc.clone(), 6, true);
+            pb.add_def_levels(1, &def_levels);
+            pb.add_values::<Int32Type>(Encoding::PLAIN, &values);
+            Box::new(TestPageReader::new(vec![pb.consume()]))
+        };
+
+        let mut record_reader = RecordReader::<Int32Type>::new(desc.clone());
+
+        // Skips values buffered by reading ahead
+        record_reader.set_page_reader(make_page_reader()).unwrap();
+        assert_eq!(1, record_reader.read_records(1).unwrap());
+        assert_eq!(
+            record_reader.skip_records(1).unwrap_err(),
+            general_err!("Cannot skip records while 1 records are not consumed")
+        );
+        record_reader.consume_record_data().unwrap();
+        record_reader.consume_def_levels().unwrap();
+        record_reader.consume_bitmap().unwrap();
+        record_reader.reset();
+
+        assert_eq!(2, record_reader.skip_records(2).unwrap());
+        assert_eq!(2, record_reader.read_records(2).unwrap());
+        let mut bb = Int32BufferBuilder::new(2);
+        bb.append_slice(&[3, 0]);
+        assert_eq!(bb.finish(), record_reader.consume_record_data().unwrap());
+        let mut bb = Int16BufferBuilder::new(2);
+        bb.append_slice(&[1i16, 0i16]);
+        assert_eq!(
+            Some(bb.finish()),
+            record_reader.consume_def_levels().unwrap()
+        );
+        let mut bb = BooleanBufferBuilder::new(2);
+        bb.append_slice(&[true, false]);
+        assert_eq!(
+            Some(Bitmap::from(bb.finish())),
+            record_reader.consume_bitmap().unwrap()
+        );
+        record_reader.reset();
+        assert_eq!(1, record_reader.skip_records(5).unwrap());
+        assert_eq!(0, record_reader.read_records(1).unwrap());
+
+        // Skips values nothing was read ahead of
+        record_reader.set_page_reader(make_page_reader()).unwrap();
+        assert_eq!(4, record_reader.skip_records(4).unwrap());
+        assert_eq!(2, record_reader.read_records(10).unwrap());
+        let mut bb = Int32BufferBuilder::new(2);
+        bb.append_slice(&[0, 4]);
+        assert_eq!(bb.finish(), record_reader.consume_record_data().unwrap());
+    }
+
     #[test]
     fn test_read_repeated_records() {
         // Construct column schema
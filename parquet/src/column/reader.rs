@@ -33,6 +33,9 @@ use crate::errors::{ParquetError, Result};
 use crate::schema::types::ColumnDescPtr;
 use crate::util::memory::ByteBufferPtr;
 
+/// Number of values decoded at a time by [`ColumnReaderImpl::skip_records`].
+const SKIP_BATCH_SIZE: usize = 1024;
+
 /// Column reader for a Parquet type.
 pub enum ColumnReader {
     BoolColumnReader(ColumnReaderImpl<BoolType>),
@@ -159,10 +162,67 @@ impl<T: DataType> ColumnReaderImpl<T> {
     pub fn read_batch(
         &mut self,
         batch_size: usize,
-        mut def_levels: Option<&mut [i16]>,
-        mut rep_levels: Option<&mut [i16]>,
+        def_levels: Option<&mut [i16]>,
+        rep_levels: Option<&mut [i16]>,
         values: &mut [T::T],
     ) -> Result<(usize, usize)> {
+        self.read_batch_with(batch_size, def_levels, rep_levels, values, false, |d, b| {
+            d.get(b)
+        })
+    }
+
+    /// Reads a batch of at most `batch_size` indices into the dictionary of the column
+    /// chunk, see [`Self::dictionary`], rather than values.
+    ///
+    /// Behaves like [`Self::read_batch`], but stops before the first page whose
+    /// values are not dictionary encoded, see [`Self::is_dictionary_encoded`].
+    #[inline]
+    pub fn read_batch_keys(
+        &mut self,
+        batch_size: usize,
+        def_levels: Option<&mut [i16]>,
+        rep_levels: Option<&mut [i16]>,
+        keys: &mut [i32],
+    ) -> Result<(usize, usize)> {
+        self.read_batch_with(batch_size, def_levels, rep_levels, keys, true, |d, b| {
+            d.get_keys(b)
+        })
+    }
+
+    /// Returns the dictionary of the column chunk, once its dictionary page is read.
+    pub fn dictionary(&self) -> Option<&[T::T]> {
+        self.decoders
+            .get(&Encoding::RLE_DICTIONARY)
+            .and_then(|decoder| decoder.dictionary())
+    }
+
+    /// Returns whether the next values to read are dictionary encoded, reading the
+    /// next page if needed, or `None` if there are no values left.
+    pub fn is_dictionary_encoded(&mut self) -> Result<Option<bool>> {
+        if !self.has_next()? {
+            return Ok(None);
+        }
+        Ok(Some(
+            self.current_encoding == Some(Encoding::RLE_DICTIONARY),
+        ))
+    }
+
+    /// Reads a batch of levels, and of values or keys into `values` with
+    /// `read_values`, see [`Self::read_batch`]. If `dictionary_only` is true, stops
+    /// before the first page that is not dictionary encoded.
+    #[inline]
+    fn read_batch_with<V, F>(
+        &mut self,
+        batch_size: usize,
+        mut def_levels: Option<&mut [i16]>,
+        mut rep_levels: Option<&mut [i16]>,
+        values: &mut [V],
+        dictionary_only: bool,
+        mut read_values: F,
+    ) -> Result<(usize, usize)>
+    where
+        F: FnMut(&mut Box<dyn Decoder<T>>, &mut [V]) -> Result<usize>,
+    {
         let mut values_read = 0;
         let mut levels_read = 0;
 
@@ -181,6 +241,10 @@ impl<T: DataType> ColumnReaderImpl<T> {
             if !self.has_next()? {
                 break;
             }
+            if dictionary_only && self.current_encoding != Some(Encoding::RLE_DICTIONARY)
+            {
+                break;
+            }
 
             // Batch size for the current iteration
             let iter_batch_size = {
@@ -249,8 +313,10 @@ impl<T: DataType> ColumnReaderImpl<T> {
             // levels of batch size - [!] they will not be synced, because only definition
             // levels enforce number of non-null values to read.
 
-            let curr_values_read =
-                self.read_values(&mut values[values_read..values_read + values_to_read])?;
+            let curr_values_read = read_values(
+                self.current_decoder(),
+                &mut values[values_read..values_read + values_to_read],
+            )?;
 
             // Update all "return" counters and internal state.
 
@@ -264,6 +330,64 @@ impl<T: DataType> ColumnReaderImpl<T> {
         Ok((values_read, levels_read))
     }
 
+    /// Skips the next `num_records` records without returning them, and returns the
+    /// number of records skipped, which is less than `num_records` only if the column
+    /// chunk has fewer records left.
+    ///
+    /// Pages that are skipped entirely are not decoded. Of the others, only the
+    /// definition levels and values before the next record read are. As a record
+    /// of a repeated column spans a varying number of values, these are not supported.
+    pub fn skip_records(&mut self, num_records: usize) -> Result<usize> {
+        if self.descr.max_rep_level() > 0 {
+            return Err(nyi_err!(
+                "Skipping records of repeated column {}",
+                self.descr.path()
+            ));
+        }
+
+        let mut def_levels = Vec::new();
+        let mut values = Vec::new();
+        let mut records_skipped = 0;
+        while records_skipped < num_records && self.has_next()? {
+            let records_left = num_records - records_skipped;
+            let page_records_left =
+                (self.num_buffered_values - self.num_decoded_values) as usize;
+            if page_records_left <= records_left {
+                // Skip the rest of the page, the next read starts with a new one
+                self.num_decoded_values = self.num_buffered_values;
+                records_skipped += page_records_left;
+                continue;
+            }
+
+            let batch_size = min(records_left, SKIP_BATCH_SIZE);
+            let (num_levels, values_to_read) = if self.descr.max_def_level() > 0 {
+                def_levels.resize(batch_size, 0);
+                let num_levels = self.read_def_levels(&mut def_levels)?;
+                let max_def_level = self.descr.max_def_level();
+                let values_to_read = def_levels[..num_levels]
+                    .iter()
+                    .filter(|level| **level == max_def_level)
+                    .count();
+                (num_levels, values_to_read)
+            } else {
+                (batch_size, batch_size)
+            };
+            values.resize(values_to_read, T::T::default());
+            let values_read = self.read_values(&mut values)?;
+            if values_read != values_to_read {
+                return Err(eof_err!(
+                    "Expected to skip {} values, got {}",
+                    values_to_read,
+                    values_read
+                ));
+            }
+            self.num_decoded_values += num_levels as u32;
+            records_skipped += num_levels;
+        }
+
+        Ok(records_skipped)
+    }
+
     /// Reads a new page and set up the decoders for levels, values or dictionary.
     /// Returns false if there's no page left.
     fn read_new_page(&mut self) -> Result<bool> {
@@ -461,14 +585,17 @@ impl<T: DataType> ColumnReaderImpl<T> {
 
     #[inline]
     fn read_values(&mut self, buffer: &mut [T::T]) -> Result<usize> {
+        self.current_decoder().get(buffer)
+    }
+
+    #[inline]
+    fn current_decoder(&mut self) -> &mut Box<dyn Decoder<T>> {
         let encoding = self
             .current_encoding
             .expect("current_encoding should be set");
-        let current_decoder = self
-            .decoders
+        self.decoders
             .get_mut(&encoding)
-            .unwrap_or_else(|| panic!("decoder for encoding {} should be set", encoding));
-        current_decoder.get(buffer)
+            .unwrap_or_else(|| panic!("decoder for encoding {} should be set", encoding))
     }
 
     #[inline]
@@ -976,6 +1103,152 @@ mod tests {
         );
     }
 
+    #[test]
+    fn test_skip_records() {
+        let primitive_type = get_test_int32_type();
+        let desc = Arc::new(ColumnDescriptor::new(
+            Arc::new(primitive_type),
+            1,
+            0,
+            ColumnPath::new(Vec::new()),
+        ));
+
+        let mut pages = VecDeque::new();
+        let mut def_levels = Vec::new();
+        let mut values = Vec::new();
+        make_pages::<Int32Type>(
+            desc.clone(),
+            Encoding::RLE_DICTIONARY,
+            3,
+            16,
+            0,
+            100,
+            &mut def_levels,
+            &mut Vec::new(),
+            &mut values,
+            &mut pages,
+            false,
+        );
+        let page_reader = TestPageReader::new(Vec::from(pages));
+        let mut column_reader = get_typed_column_reader::<Int32Type>(get_column_reader(
+            desc,
+            Box::new(page_reader),
+        ));
+        let num_values = |levels: &[i16]| levels.iter().filter(|l| **l == 1).count();
+
+        let mut read_def_levels = vec![0; 48];
+        let mut read_values = vec![0; 48];
+        let mut check_read = |column_reader: &mut ColumnReaderImpl<Int32Type>,
+                              start: usize,
+                              num_records: usize| {
+            let (values_read, levels_read) = column_reader
+                .read_batch(
+                    num_records,
+                    Some(&mut read_def_levels),
+                    None,
+                    &mut read_values,
+                )
+                .unwrap();
+            let end = start + num_records;
+            let values_start = num_values(&def_levels[..start]);
+            let values_end = num_values(&def_levels[..end]);
+            assert_eq!(levels_read, num_records);
+            assert_eq!(&read_def_levels[..levels_read], &def_levels[start..end]);
+            assert_eq!(values_read, values_end - values_start);
+            assert_eq!(
+                &read_values[..values_read],
+                &values[values_start..values_end]
+            );
+        };
+
+        // within the first page
+        assert_eq!(column_reader.skip_records(5).unwrap(), 5);
+        check_read(&mut column_reader, 5, 10);
+        // the rest of the first page, all of the second page and some of the third
+        assert_eq!(column_reader.skip_records(20).unwrap(), 20);
+        check_read(&mut column_reader, 35, 13);
+        assert_eq!(column_reader.skip_records(1).unwrap(), 0);
+    }
+
+    #[test]
+    fn test_read_batch_keys() {
+        let primitive_type = get_test_int32_type();
+        let desc = Arc::new(ColumnDescriptor::new(
+            Arc::new(primitive_type),
+            1,
+            0,
+            ColumnPath::new(Vec::new()),
+        ));
+
+        let read = |encoding: Encoding| {
+            let mut pages = VecDeque::new();
+            let mut def_levels = Vec::new();
+            let mut values = Vec::new();
+            make_pages::<Int32Type>(
+                desc.clone(),
+                encoding,
+                2,
+                16,
+                0,
+                10,
+                &mut def_levels,
+                &mut Vec::new(),
+                &mut values,
+                &mut pages,
+                false,
+            );
+            let page_reader = TestPageReader::new(Vec::from(pages));
+            let mut column_reader = get_typed_column_reader::<Int32Type>(
+                get_column_reader(desc.clone(), Box::new(page_reader)),
+            );
+
+            let mut read_def_levels = vec![0; 32];
+            let mut keys = vec![0; 32];
+            let is_dictionary_encoded = column_reader.is_dictionary_encoded().unwrap();
+            let (keys_read, levels_read) = column_reader
+                .read_batch_keys(32, Some(&mut read_def_levels), None, &mut keys)
+                .unwrap();
+            let read_values = column_reader.dictionary().map(|dictionary| {
+                keys[..keys_read]
+                    .iter()
+                    .map(|key| dictionary[*key as usize])
+                    .collect::<Vec<_>>()
+            });
+            assert_eq!(&read_def_levels[..levels_read], &def_levels[..levels_read]);
+            (is_dictionary_encoded, keys_read, read_values, values)
+        };
+
+        let (is_dictionary_encoded, _, read_values, values) =
+            read(Encoding::RLE_DICTIONARY);
+        assert_eq!(is_dictionary_encoded, Some(true));
+        assert_eq!(read_values, Some(values));
+
+        let (is_dictionary_encoded, keys_read, read_values, _) = read(Encoding::PLAIN);
+        assert_eq!(is_dictionary_encoded, Some(false));
+        assert_eq!(keys_read, 0);
+        assert_eq!(read_values, None);
+    }
+
+    #[test]
+    fn test_skip_records_repeated() {
+        let primitive_type = get_test_int32_type();
+        let desc = Arc::new(ColumnDescriptor::new(
+            Arc::new(primitive_type),
+            1,
+            1,
+            ColumnPath::new(vec!["a".to_owned()]),
+        ));
+        let page_reader = TestPageReader::new(Vec::new());
+        let mut column_reader = get_typed_column_reader::<Int32Type>(get_column_reader(
+            desc,
+            Box::new(page_reader),
+        ));
+        assert_eq!(
+            column_reader.skip_records(1).unwrap_err(),
+            nyi_err!("Skipping records of repeated column a")
+        );
+    }
+
     // ----------------------------------------------------------------------
     // Helper methods to make pages and test
     //
@@ -16,9 +16,15 @@
 // under the License.
 
 //! Contains column writer API.
-use std::{cmp, collections::VecDeque, convert::TryFrom, marker::PhantomData, sync::Arc};
+use std::{
+    cmp,
+    collections::VecDeque,
+    convert::{TryFrom, TryInto},
+    marker::PhantomData,
+    sync::Arc,
+};
 
-use crate::basic::{Compression, Encoding, PageType, Type};
+use crate::basic::{ColumnOrder, Compression, Encoding, PageType, SortOrder, Type};
 use crate::column::page::{CompressedPage, Page, PageWriteSpec, PageWriter};
 use crate::compression::{create_codec, Codec};
 use crate::data_type::AsBytes;
@@ -30,7 +36,9 @@ use crate::encodings::{
 use crate::errors::{ParquetError, Result};
 use crate::file::statistics::Statistics;
 use crate::file::{
+    bloom_filter::Sbbf,
     metadata::ColumnChunkMetaData,
+    page_index::PageIndexBuilder,
     properties::{WriterProperties, WriterPropertiesPtr, WriterVersion},
 };
 use crate::schema::types::ColumnDescPtr;
@@ -161,10 +169,52 @@ pub fn get_typed_column_writer_mut<T: DataType>(
     })
 }
 
+/// The dictionary of the values written by
+/// [`ColumnWriterImpl::write_batch_with_dictionary`], such as the values of an Arrow
+/// dictionary array.
+///
+/// Once a value has been written, its index in the dictionary page of the column chunk
+/// is kept, so that each value is hashed at most once however many batches refer to
+/// it. A `BatchDictionary` must therefore only be used with a single column writer.
+pub struct BatchDictionary<T: DataType> {
+    values: Vec<T::T>,
+    /// The index of each value in the dictionary of the column writer, or -1 if the
+    /// value has not been written yet
+    indices: Vec<i32>,
+    /// The last mini batch in which each value was written
+    last_batch: Vec<u64>,
+    /// The number of mini batches written
+    num_batches: u64,
+    // Reused buffers
+    batch_indices: Vec<i32>,
+    batch_distinct: Vec<usize>,
+}
+
+impl<T: DataType> BatchDictionary<T> {
+    /// Creates a dictionary of `values`, to which the keys of batches refer by position.
+    pub fn new(values: Vec<T::T>) -> Self {
+        Self {
+            indices: vec![-1; values.len()],
+            last_batch: vec![0; values.len()],
+            values,
+            num_batches: 0,
+            batch_indices: vec![],
+            batch_distinct: vec![],
+        }
+    }
+
+    /// Returns the values of this dictionary.
+    pub fn values(&self) -> &[T::T] {
+        &self.values
+    }
+}
+
 /// Typed column writer for a primitive column.
 pub struct ColumnWriterImpl<T: DataType> {
     // Column writer properties
     descr: ColumnDescPtr,
+    // Order of the min and max statistics
+    sort_order: SortOrder,
     props: WriterPropertiesPtr,
     page_writer: Box<dyn PageWriter>,
     has_dictionary: bool,
@@ -192,6 +242,9 @@ pub struct ColumnWriterImpl<T: DataType> {
     max_column_value: Option<T::T>,
     num_column_nulls: u64,
     column_distinct_count: Option<u64>,
+    // Page index, only collected for non-repeated columns
+    page_index_builder: Option<PageIndexBuilder>,
+    bloom_filter: Option<Sbbf>,
     // Reused buffers
     def_levels_sink: Vec<i16>,
     rep_levels_sink: Vec<i16>,
@@ -230,8 +283,31 @@ impl<T: DataType> ColumnWriterImpl<T> {
         )
         .unwrap();
 
+        let page_index_builder =
+            if props.page_index_enabled() && descr.max_rep_level() == 0 {
+                Some(PageIndexBuilder::new())
+            } else {
+                None
+            };
+
+        let bloom_filter = if props.bloom_filter_enabled(descr.path()) {
+            Some(Sbbf::new_with_ndv_fpp(
+                props.bloom_filter_ndv(descr.path()),
+                props.bloom_filter_fpp(descr.path()),
+            ))
+        } else {
+            None
+        };
+
+        let sort_order = ColumnOrder::get_sort_order(
+            descr.logical_type(),
+            descr.converted_type(),
+            descr.physical_type(),
+        );
+
         Self {
             descr,
+            sort_order,
             props,
             page_writer,
             has_dictionary,
@@ -260,6 +336,8 @@ impl<T: DataType> ColumnWriterImpl<T> {
             max_column_value: None,
             num_column_nulls: 0,
             column_distinct_count: None,
+            page_index_builder,
+            bloom_filter,
             _phantom: PhantomData,
         }
     }
@@ -300,10 +378,18 @@ impl<T: DataType> ColumnWriterImpl<T> {
         // Process pre-calculated statistics
         match (min, max) {
             (Some(min), Some(max)) => {
-                if self.min_column_value.as_ref().map_or(true, |v| v > min) {
+                if self
+                    .min_column_value
+                    .as_ref()
+                    .map_or(true, |v| self.compare_greater(v, min))
+                {
                     self.min_column_value = Some(min.clone());
                 }
-                if self.max_column_value.as_ref().map_or(true, |v| v < max) {
+                if self
+                    .max_column_value
+                    .as_ref()
+                    .map_or(true, |v| self.compare_greater(max, v))
+                {
                     self.max_column_value = Some(max.clone());
                 }
             }
@@ -396,6 +482,65 @@ impl<T: DataType> ColumnWriterImpl<T> {
         )
     }
 
+    /// Writes a batch of values given as `keys`, the positions of the values in
+    /// `dictionary`, along with their definition and repetition levels. Returns the number
+    /// of values processed (written), like [`write_batch`](Self::write_batch).
+    ///
+    /// While the column is dictionary encoded, each value of `dictionary` is inserted into
+    /// the dictionary of the column chunk the first time it is written, and the keys are
+    /// then only remapped to the indices of the values in that dictionary. Otherwise, the
+    /// values are looked up and written like with `write_batch`.
+    pub fn write_batch_with_dictionary(
+        &mut self,
+        dictionary: &mut BatchDictionary<T>,
+        keys: &[usize],
+        def_levels: Option<&[i16]>,
+        rep_levels: Option<&[i16]>,
+    ) -> Result<usize> {
+        if let Some(key) = keys.iter().find(|key| **key >= dictionary.values.len()) {
+            return Err(general_err!(
+                "Dictionary key {} out of bounds for a dictionary of {} values",
+                key,
+                dictionary.values.len()
+            ));
+        }
+
+        // Find out the minimal length to prevent index out of bound errors.
+        let mut min_len = keys.len();
+        if let Some(levels) = def_levels {
+            min_len = cmp::min(min_len, levels.len());
+        }
+        if let Some(levels) = rep_levels {
+            min_len = cmp::min(min_len, levels.len());
+        }
+
+        // Find out number of batches to process, see `write_batch_internal`.
+        let write_batch_size = self.props.write_batch_size();
+        let num_batches = min_len / write_batch_size;
+
+        let mut values_offset = 0;
+        let mut levels_offset = 0;
+        for _ in 0..num_batches {
+            values_offset += self.write_dictionary_mini_batch(
+                dictionary,
+                &keys[values_offset..values_offset + write_batch_size],
+                def_levels.map(|lv| &lv[levels_offset..levels_offset + write_batch_size]),
+                rep_levels.map(|lv| &lv[levels_offset..levels_offset + write_batch_size]),
+            )?;
+            levels_offset += write_batch_size;
+        }
+
+        values_offset += self.write_dictionary_mini_batch(
+            dictionary,
+            &keys[values_offset..],
+            def_levels.map(|lv| &lv[levels_offset..]),
+            rep_levels.map(|lv| &lv[levels_offset..]),
+        )?;
+
+        // Return total number of values processed.
+        Ok(values_offset)
+    }
+
     /// Returns total number of bytes written by this column writer so far.
     /// This value is also returned when column writer is closed.
     pub fn get_total_bytes_written(&self) -> u64 {
@@ -432,6 +577,99 @@ impl<T: DataType> ColumnWriterImpl<T> {
         rep_levels: Option<&[i16]>,
         calculate_page_stats: bool,
     ) -> Result<usize> {
+        self.write_mini_batch_with(
+            values.len(),
+            def_levels,
+            rep_levels,
+            calculate_page_stats,
+            |writer, num_values| {
+                let values_to_write = &values[..num_values];
+                if calculate_page_stats {
+                    for val in values_to_write {
+                        writer.update_page_min_max(val);
+                    }
+                }
+
+                if let Some(bloom_filter) = writer.bloom_filter.as_mut() {
+                    for val in values_to_write {
+                        bloom_filter.insert(val);
+                    }
+                }
+
+                writer.write_values(values_to_write)
+            },
+        )
+    }
+
+    /// Writes a mini batch of values given as keys into `dictionary`, see
+    /// [`write_batch_with_dictionary`](Self::write_batch_with_dictionary).
+    fn write_dictionary_mini_batch(
+        &mut self,
+        dictionary: &mut BatchDictionary<T>,
+        keys: &[usize],
+        def_levels: Option<&[i16]>,
+        rep_levels: Option<&[i16]>,
+    ) -> Result<usize> {
+        if self.dict_encoder.is_none() {
+            // the column is not, or no longer, dictionary encoded
+            let values: Vec<T::T> = keys
+                .iter()
+                .map(|key| dictionary.values[*key].clone())
+                .collect();
+            return self.write_mini_batch(&values, def_levels, rep_levels, true);
+        }
+
+        self.write_mini_batch_with(
+            keys.len(),
+            def_levels,
+            rep_levels,
+            true,
+            |writer, num_values| {
+                let encoder = writer.dict_encoder.as_mut().unwrap();
+                dictionary.num_batches += 1;
+                dictionary.batch_indices.clear();
+                dictionary.batch_distinct.clear();
+                for key in &keys[..num_values] {
+                    let key = *key;
+                    let mut index = dictionary.indices[key];
+                    if index < 0 {
+                        index = encoder.get_or_insert(&dictionary.values[key]);
+                        dictionary.indices[key] = index;
+                    }
+                    if dictionary.last_batch[key] != dictionary.num_batches {
+                        dictionary.last_batch[key] = dictionary.num_batches;
+                        dictionary.batch_distinct.push(key);
+                    }
+                    dictionary.batch_indices.push(index);
+                }
+                encoder.put_indices(&dictionary.batch_indices);
+
+                // statistics only depend on the distinct values of the batch
+                for key in &dictionary.batch_distinct {
+                    let val = &dictionary.values[*key];
+                    writer.update_page_min_max(val);
+                    if let Some(bloom_filter) = writer.bloom_filter.as_mut() {
+                        bloom_filter.insert(val);
+                    }
+                }
+                Ok(())
+            },
+        )
+    }
+
+    /// Writes the levels of a mini batch, and its values with `write_values`, which is
+    /// passed the number of values to write out of the `num_provided` values.
+    fn write_mini_batch_with<F>(
+        &mut self,
+        num_provided: usize,
+        def_levels: Option<&[i16]>,
+        rep_levels: Option<&[i16]>,
+        calculate_page_stats: bool,
+        write_values: F,
+    ) -> Result<usize>
+    where
+        F: FnOnce(&mut Self, usize) -> Result<()>,
+    {
         let mut values_to_write = 0;
 
         // Check if number of definition levels is the same as number of repetition
@@ -466,7 +704,7 @@ impl<T: DataType> ColumnWriterImpl<T> {
             self.write_definition_levels(levels);
             u32::try_from(levels.len()).unwrap()
         } else {
-            values_to_write = values.len();
+            values_to_write = num_provided;
             u32::try_from(values_to_write).unwrap()
         };
 
@@ -493,24 +731,18 @@ impl<T: DataType> ColumnWriterImpl<T> {
         }
 
         // Check that we have enough values to write.
-        let values_to_write = values.get(0..values_to_write).ok_or_else(|| {
-            general_err!(
+        if values_to_write > num_provided {
+            return Err(general_err!(
                 "Expected to write {} values, but have only {}",
                 values_to_write,
-                values.len()
-            )
-        })?;
-
-        if calculate_page_stats {
-            for val in values_to_write {
-                self.update_page_min_max(val);
-            }
+                num_provided
+            ));
         }
 
-        self.write_values(values_to_write)?;
+        write_values(self, values_to_write)?;
 
         self.num_buffered_values += num_values;
-        self.num_buffered_encoded_values += u32::try_from(values_to_write.len()).unwrap();
+        self.num_buffered_encoded_values += u32::try_from(values_to_write).unwrap();
 
         if self.should_add_data_page() {
             self.add_data_page(calculate_page_stats)?;
@@ -520,7 +752,7 @@ impl<T: DataType> ColumnWriterImpl<T> {
             self.dict_fallback()?;
         }
 
-        Ok(values_to_write.len())
+        Ok(values_to_write)
     }
 
     #[inline]
@@ -606,6 +838,10 @@ impl<T: DataType> ColumnWriterImpl<T> {
             None
         };
 
+        if let Some(builder) = self.page_index_builder.as_mut() {
+            builder.add_page(page_statistics.as_ref(), self.total_rows_written);
+        }
+
         let compressed_page = match self.props.writer_version() {
             WriterVersion::PARQUET_1_0 => {
                 let mut buffer = vec![];
@@ -725,9 +961,11 @@ impl<T: DataType> ColumnWriterImpl<T> {
     /// dictionary encoding into underlying sink.
     #[inline]
     fn flush_data_pages(&mut self) -> Result<()> {
-        // Write all outstanding data to a new page.
-        let calculate_page_stats =
-            self.min_page_value.is_some() && self.max_page_value.is_some();
+        // Write all outstanding data to a new page. Nulls are only counted when page
+        // statistics are calculated, so a page of nulls also has statistics.
+        let calculate_page_stats = (self.min_page_value.is_some()
+            && self.max_page_value.is_some())
+            || self.num_page_nulls > 0;
         if self.num_buffered_values > 0 {
             self.add_data_page(calculate_page_stats)?;
         }
@@ -779,6 +1017,11 @@ impl<T: DataType> ColumnWriterImpl<T> {
             .set_data_page_offset(data_page_offset)
             .set_dictionary_page_offset(dict_page_offset)
             .set_statistics(statistics)
+            .set_page_index(match self.page_index_builder.take() {
+                Some(builder) => builder.build()?,
+                None => None,
+            })
+            .set_bloom_filter(self.bloom_filter.take())
             .build()?;
 
         self.page_writer.write_metadata(&metadata)?;
@@ -814,6 +1057,9 @@ impl<T: DataType> ColumnWriterImpl<T> {
     #[inline]
     fn write_data_page(&mut self, page: CompressedPage) -> Result<()> {
         let page_spec = self.page_writer.write_page(page)?;
+        if let Some(builder) = self.page_index_builder.as_mut() {
+            builder.add_page_location(page_spec.offset, page_spec.bytes_written)?;
+        }
         self.update_metrics_for_page(page_spec);
         Ok(())
     }
@@ -921,29 +1167,68 @@ impl<T: DataType> ColumnWriterImpl<T> {
         }
     }
 
-    fn update_page_min_max(&mut self, val: &T::T) {
-        if self.min_page_value.as_ref().map_or(true, |min| min > val) {
-            self.min_page_value = Some(val.clone());
-        }
-        if self.max_page_value.as_ref().map_or(true, |max| max < val) {
-            self.max_page_value = Some(val.clone());
+    /// Returns `true` if `a` is greater than `b` in the sort order of the column,
+    /// which readers use to compare values with the min and max statistics.
+    ///
+    /// This differs from `PartialOrd` for unsigned integers, which `T::T` holds as
+    /// signed integers, and for byte arrays, which `PartialOrd` compares by length
+    /// first.
+    fn compare_greater(&self, a: &T::T, b: &T::T) -> bool {
+        if self.sort_order == SortOrder::UNSIGNED {
+            match T::get_physical_type() {
+                Type::INT32 => {
+                    return u32::from_ne_bytes(a.as_bytes().try_into().unwrap())
+                        > u32::from_ne_bytes(b.as_bytes().try_into().unwrap())
+                }
+                Type::INT64 => {
+                    return u64::from_ne_bytes(a.as_bytes().try_into().unwrap())
+                        > u64::from_ne_bytes(b.as_bytes().try_into().unwrap())
+                }
+                Type::BYTE_ARRAY | Type::FIXED_LEN_BYTE_ARRAY => {
+                    return a.as_bytes() > b.as_bytes()
+                }
+                _ => {}
+            }
         }
+        a > b
     }
 
-    fn update_column_min_max(&mut self) {
+    fn update_page_min_max(&mut self, val: &T::T) {
         if self
-            .min_column_value
+            .min_page_value
             .as_ref()
-            .map_or(true, |min| min > self.min_page_value.as_ref().unwrap())
+            .map_or(true, |min| self.compare_greater(min, val))
         {
-            self.min_column_value = self.min_page_value.clone();
+            self.min_page_value = Some(val.clone());
         }
         if self
-            .max_column_value
+            .max_page_value
             .as_ref()
-            .map_or(true, |max| max < self.max_page_value.as_ref().unwrap())
+            .map_or(true, |max| self.compare_greater(val, max))
         {
-            self.max_column_value = self.max_page_value.clone();
+            self.max_page_value = Some(val.clone());
+        }
+    }
+
+    fn update_column_min_max(&mut self) {
+        // Pages of nulls have no min and max values
+        if let Some(page_min) = self.min_page_value.as_ref() {
+            if self
+                .min_column_value
+                .as_ref()
+                .map_or(true, |min| self.compare_greater(min, page_min))
+            {
+                self.min_column_value = Some(page_min.clone());
+            }
+        }
+        if let Some(page_max) = self.max_page_value.as_ref() {
+            if self
+                .max_column_value
+                .as_ref()
+                .map_or(true, |max| self.compare_greater(page_max, max))
+            {
+                self.max_column_value = Some(page_max.clone());
+            }
         }
     }
 }
@@ -1413,6 +1698,89 @@ mod tests {
         }
     }
 
+    #[test]
+    fn test_column_writer_batch_dictionary() {
+        let dictionary: Vec<ByteArray> =
+            vec!["b".into(), "a".into(), "d".into(), "c".into()];
+        let keys: Vec<usize> = (0..100).map(|i| (i * 7) % 3).collect();
+        // every fourth value is null
+        let def_levels: Vec<i16> = (0..133).map(|i| (i % 4 != 3) as i16).collect();
+        let values: Vec<ByteArray> =
+            keys.iter().map(|key| dictionary[*key].clone()).collect();
+
+        let run = |props: WriterProperties, with_dictionary: bool| {
+            let props = Arc::new(props);
+            let page_writer = get_test_page_writer();
+            let mut writer =
+                get_test_column_writer::<ByteArrayType>(page_writer, 1, 0, props);
+            let written = if with_dictionary {
+                let mut batch_dictionary = BatchDictionary::new(dictionary.clone());
+                // write in two batches, reusing the dictionary
+                let a = writer
+                    .write_batch_with_dictionary(
+                        &mut batch_dictionary,
+                        &keys[..30],
+                        Some(&def_levels[..40]),
+                        None,
+                    )
+                    .unwrap();
+                let b = writer
+                    .write_batch_with_dictionary(
+                        &mut batch_dictionary,
+                        &keys[30..],
+                        Some(&def_levels[40..]),
+                        None,
+                    )
+                    .unwrap();
+                a + b
+            } else {
+                writer
+                    .write_batch(&values, Some(&def_levels), None)
+                    .unwrap()
+            };
+            assert_eq!(written, 100);
+            writer.close().unwrap()
+        };
+
+        let props = vec![
+            WriterProperties::builder().set_write_batch_size(16).build(),
+            // falls back to plain encoding after a few mini batches
+            WriterProperties::builder()
+                .set_write_batch_size(16)
+                .set_dictionary_pagesize_limit(6)
+                .build(),
+            WriterProperties::builder()
+                .set_dictionary_enabled(false)
+                .build(),
+        ];
+        for props in props {
+            let (bytes, rows, metadata) = run(props.clone(), true);
+            let (expected_bytes, expected_rows, expected) = run(props, false);
+            assert_eq!(bytes, expected_bytes);
+            assert_eq!(rows, expected_rows);
+            assert_eq!(metadata.encodings(), expected.encodings());
+            assert_eq!(metadata.num_values(), expected.num_values());
+            assert_eq!(
+                metadata.dictionary_page_offset(),
+                expected.dictionary_page_offset()
+            );
+            assert_eq!(metadata.statistics(), expected.statistics());
+        }
+
+        let page_writer = get_test_page_writer();
+        let props = Arc::new(WriterProperties::builder().build());
+        let mut writer =
+            get_test_column_writer::<ByteArrayType>(page_writer, 0, 0, props);
+        let mut batch_dictionary = BatchDictionary::new(dictionary);
+        let err = writer
+            .write_batch_with_dictionary(&mut batch_dictionary, &[0, 4], None, None)
+            .unwrap_err();
+        assert_eq!(
+            err.to_string(),
+            "Parquet error: Dictionary key 4 out of bounds for a dictionary of 4 values"
+        );
+    }
+
     #[test]
     fn test_column_writer_precalculated_statistics() {
         let page_writer = get_test_page_writer();
@@ -1457,6 +1825,134 @@ mod tests {
         }
     }
 
+    #[test]
+    fn test_column_writer_page_index() {
+        let page_writer = get_test_page_writer();
+        let props = Arc::new(
+            WriterProperties::builder()
+                .set_dictionary_enabled(false)
+                .set_data_pagesize_limit(1)
+                .set_write_batch_size(4)
+                .set_page_index_enabled(true)
+                .build(),
+        );
+        let mut writer = get_test_column_writer::<Int32Type>(page_writer, 1, 0, props);
+        writer
+            .write_batch(&[1, 2, 3, 4], Some(&[1, 1, 1, 1, 0, 0, 0, 0]), None)
+            .unwrap();
+        let (_, rows_written, metadata) = writer.close().unwrap();
+        assert_eq!(rows_written, 8);
+        assert_eq!(metadata.statistics().unwrap().null_count(), 4);
+
+        let page_index = metadata.page_index().unwrap();
+        let offset_index = page_index.offset_index();
+        assert_eq!(offset_index.num_pages(), 2);
+        assert_eq!(offset_index.page_rows(0, 8), 0..4);
+        assert_eq!(offset_index.page_rows(1, 8), 4..8);
+
+        let column_index = page_index.column_index().unwrap();
+        assert!(!column_index.is_null_page(0));
+        assert!(column_index.is_null_page(1));
+        assert_eq!(column_index.null_count(0), Some(0));
+        assert_eq!(column_index.null_count(1), Some(4));
+        assert_eq!(
+            column_index.page_statistics(Type::INT32, 0),
+            Some(Statistics::int32(Some(1), Some(4), None, 0, false))
+        );
+    }
+
+    #[test]
+    fn test_column_writer_page_index_disabled() {
+        let props = Arc::new(WriterProperties::builder().build());
+        let mut writer =
+            get_test_column_writer::<Int32Type>(get_test_page_writer(), 0, 0, props);
+        writer.write_batch(&[1, 2, 3, 4], None, None).unwrap();
+        let (_, _, metadata) = writer.close().unwrap();
+        assert!(metadata.page_index().is_none());
+
+        // repeated columns have no page index, as pages may split records
+        let props = Arc::new(
+            WriterProperties::builder()
+                .set_page_index_enabled(true)
+                .build(),
+        );
+        let mut writer =
+            get_test_column_writer::<Int32Type>(get_test_page_writer(), 1, 1, props);
+        writer
+            .write_batch(&[1, 2, 3, 4], Some(&[1, 1, 1, 1]), Some(&[0, 1, 0, 1]))
+            .unwrap();
+        let (_, _, metadata) = writer.close().unwrap();
+        assert!(metadata.page_index().is_none());
+    }
+
+    #[test]
+    fn test_column_writer_page_index_precalculated_statistics() {
+        let props = Arc::new(
+            WriterProperties::builder()
+                .set_page_index_enabled(true)
+                .build(),
+        );
+        let mut writer =
+            get_test_column_writer::<Int32Type>(get_test_page_writer(), 0, 0, props);
+        writer
+            .write_batch_with_statistics(
+                &[1, 2, 3, 4],
+                None,
+                None,
+                &Some(1),
+                &Some(4),
+                Some(0),
+                None,
+            )
+            .unwrap();
+        let (_, _, metadata) = writer.close().unwrap();
+
+        // pages have no statistics, so there is only an offset index
+        let page_index = metadata.page_index().unwrap();
+        assert!(page_index.column_index().is_none());
+        assert_eq!(page_index.offset_index().num_pages(), 1);
+    }
+
+    #[test]
+    fn test_column_writer_bloom_filter() {
+        let props = Arc::new(
+            WriterProperties::builder()
+                .set_column_bloom_filter_enabled(ColumnPath::from("col"), true)
+                .set_column_bloom_filter_ndv(ColumnPath::from("col"), 100)
+                .build(),
+        );
+        let mut writer = get_test_column_writer::<ByteArrayType>(
+            get_test_page_writer(),
+            1,
+            0,
+            props.clone(),
+        );
+        let values: Vec<ByteArray> = vec!["a".into(), "b".into(), "c".into()];
+        writer
+            .write_batch(&values, Some(&[1, 0, 1, 1]), None)
+            .unwrap();
+        let (_, _, metadata) = writer.close().unwrap();
+
+        let bloom_filter = metadata.bloom_filter().unwrap();
+        assert_eq!(bloom_filter.num_bytes(), 128);
+        for value in &values {
+            assert!(bloom_filter.check(value));
+        }
+        assert!(!bloom_filter.check(&ByteArray::from("d")));
+
+        // bloom filters are only written for the columns they are enabled for
+        let tpe = SchemaType::primitive_type_builder("other", Type::BYTE_ARRAY)
+            .build()
+            .unwrap();
+        let path = ColumnPath::from("other");
+        let descr = Arc::new(ColumnDescriptor::new(Arc::new(tpe), 0, 0, path));
+        let mut writer =
+            ColumnWriterImpl::<ByteArrayType>::new(descr, props, get_test_page_writer());
+        writer.write_batch(&values, None, None).unwrap();
+        let (_, _, metadata) = writer.close().unwrap();
+        assert!(metadata.bloom_filter().is_none());
+    }
+
     #[test]
     fn test_column_writer_empty_column_roundtrip() {
         let props = WriterProperties::builder().build();
@@ -99,6 +99,22 @@ pub trait Decoder<T: DataType> {
 
     /// Returns the encoding for this decoder.
     fn encoding(&self) -> Encoding;
+
+    /// Returns the dictionary of a dictionary decoder, or `None` for other decoders.
+    fn dictionary(&self) -> Option<&[T::T]> {
+        None
+    }
+
+    /// Consumes the indices into the dictionary of the next values of a dictionary
+    /// decoder, rather than the values, and writes them to `buffer`.
+    ///
+    /// Returns the actual number of indices decoded.
+    fn get_keys(&mut self, _buffer: &mut [i32]) -> Result<usize> {
+        Err(general_err!(
+            "Cannot decode dictionary keys of {} encoded values",
+            self.encoding()
+        ))
+    }
 }
 
 /// Gets a decoder for the column descriptor `descr` and encoding type `encoding`.
@@ -268,6 +284,22 @@ impl<T: DataType> Decoder<T> for DictDecoder<T> {
     fn encoding(&self) -> Encoding {
         Encoding::RLE_DICTIONARY
     }
+
+    fn dictionary(&self) -> Option<&[T::T]> {
+        if self.has_dictionary {
+            Some(&self.dictionary)
+        } else {
+            None
+        }
+    }
+
+    fn get_keys(&mut self, buffer: &mut [i32]) -> Result<usize> {
+        assert!(self.rle_decoder.is_some());
+
+        let rle = self.rle_decoder.as_mut().unwrap();
+        let num_values = cmp::min(buffer.len(), self.num_values);
+        rle.get_batch(&mut buffer[..num_values])
+    }
 }
 
 // ----------------------------------------------------------------------
@@ -843,6 +875,36 @@ mod tests {
         );
     }
 
+    #[test]
+    fn test_dict_decoder_keys() {
+        let desc = create_test_col_desc_ptr(-1, Int32Type::get_physical_type());
+        let mut encoder =
+            DictEncoder::<Int32Type>::new(desc, Arc::new(MemTracker::new()));
+        encoder.put(&[7, 3, 7, 7, 9, 3]).unwrap();
+        let mut dictionary = PlainDecoder::<Int32Type>::new(-1);
+        dictionary
+            .set_data(encoder.write_dict().unwrap(), encoder.num_entries())
+            .unwrap();
+
+        let mut decoder = DictDecoder::<Int32Type>::new();
+        assert_eq!(decoder.dictionary(), None);
+        decoder.set_dict(Box::new(dictionary)).unwrap();
+        decoder
+            .set_data(encoder.write_indices().unwrap(), 6)
+            .unwrap();
+        assert_eq!(decoder.dictionary(), Some(&[7, 3, 9][..]));
+        let mut keys = vec![0; 6];
+        assert_eq!(decoder.get_keys(&mut keys).unwrap(), 6);
+        assert_eq!(keys, vec![0, 1, 0, 0, 2, 1]);
+
+        let mut decoder = PlainDecoder::<Int32Type>::new(-1);
+        assert_eq!(decoder.dictionary(), None);
+        assert_eq!(
+            decoder.get_keys(&mut keys).unwrap_err(),
+            general_err!("Cannot decode dictionary keys of PLAIN encoded values")
+        );
+    }
+
     #[test]
     fn test_plain_decode_int32() {
         let data = vec![42, 18, 52];
@@ -269,9 +269,10 @@ impl<T: DataType> DictEncoder<T> {
         Ok(ByteBufferPtr::new(encoder.consume()?))
     }
 
+    /// Returns the index of `value` in the dictionary, inserting it if it is not in the
+    /// dictionary yet. Unlike [`put`](Encoder::put), does not buffer the index.
     #[inline]
-    #[allow(clippy::unnecessary_wraps)]
-    fn put_one(&mut self, value: &T::T) -> Result<()> {
+    pub fn get_or_insert(&mut self, value: &T::T) -> i32 {
         let mut j = (hash_util::hash(value, 0) & self.mod_bitmask) as usize;
         let mut index = self.hash_slots[j];
 
@@ -286,7 +287,26 @@ impl<T: DataType> DictEncoder<T> {
         if index == HASH_SLOT_EMPTY {
             index = self.insert_fresh_slot(j, value.clone());
         }
+        index
+    }
+
+    /// Buffers `indices`, returned by [`get_or_insert`](Self::get_or_insert), to be
+    /// written out by `write_indices()` like the indices of the values passed to
+    /// [`put`](Encoder::put).
+    pub fn put_indices(&mut self, indices: &[i32]) {
+        debug_assert!(indices
+            .iter()
+            .all(|index| *index >= 0 && (*index as usize) < self.num_entries()));
+        self.buffered_indices.reserve(indices.len());
+        for index in indices {
+            self.buffered_indices.push(*index);
+        }
+    }
 
+    #[inline]
+    #[allow(clippy::unnecessary_wraps)]
+    fn put_one(&mut self, value: &T::T) -> Result<()> {
+        let index = self.get_or_insert(value);
         self.buffered_indices.push(index);
         Ok(())
     }
@@ -1017,6 +1037,29 @@ mod tests {
         FixedLenByteArrayType::test(Encoding::DELTA_BYTE_ARRAY, TEST_SET_SIZE, 100);
     }
 
+    #[test]
+    fn test_dict_encoder_put_indices() {
+        let values: Vec<ByteArray> = vec!["a".into(), "b".into(), "a".into(), "c".into()];
+        let mut expected = create_test_dict_encoder::<ByteArrayType>(-1);
+        expected.put(&values).unwrap();
+
+        let mut encoder = create_test_dict_encoder::<ByteArrayType>(-1);
+        let indices: Vec<i32> = values.iter().map(|v| encoder.get_or_insert(v)).collect();
+        assert_eq!(indices, vec![0, 1, 0, 2]);
+        assert_eq!(encoder.num_entries(), 3);
+        assert_eq!(encoder.dict_encoded_size(), expected.dict_encoded_size());
+        encoder.put_indices(&indices);
+
+        assert_eq!(
+            encoder.write_dict().unwrap().data(),
+            expected.write_dict().unwrap().data()
+        );
+        assert_eq!(
+            encoder.write_indices().unwrap().data(),
+            expected.write_indices().unwrap().data()
+        );
+    }
+
     #[test]
     fn test_dict_encoded_size() {
         fn run_test<T: DataType>(
@@ -398,11 +398,9 @@ impl RleDecoder {
             if self.rle_left > 0 {
                 let num_values =
                     cmp::min(buffer.len() - values_read, self.rle_left as usize);
-                for i in 0..num_values {
-                    let repeated_value = from_ne_slice(
-                        &self.current_value.as_mut().unwrap().to_ne_bytes(),
-                    );
-                    buffer[values_read + i] = repeated_value;
+                let repeated_bytes = self.current_value.unwrap().to_ne_bytes();
+                for value in &mut buffer[values_read..values_read + num_values] {
+                    *value = from_ne_slice(&repeated_bytes);
                 }
                 self.rle_left -= num_values as u32;
                 values_read += num_values;
@@ -416,6 +414,11 @@ impl RleDecoder {
                     &mut buffer[values_read..values_read + num_values],
                     self.bit_width as usize,
                 );
+                if num_values == 0 {
+                    // the run is cut short by the end of the data
+                    self.bit_packed_left = 0;
+                    continue;
+                }
                 self.bit_packed_left -= num_values as u32;
                 values_read += num_values;
             } else if !self.reload() {
@@ -457,21 +460,23 @@ impl RleDecoder {
                     cmp::min(max_values - values_read, self.bit_packed_left as usize);
 
                 num_values = cmp::min(num_values, self.index_buf.len());
-                loop {
-                    num_values = bit_reader.get_batch::<i32>(
-                        &mut self.index_buf[..num_values],
-                        self.bit_width as usize,
-                    );
-                    for i in 0..num_values {
-                        buffer[values_read + i]
-                            .clone_from(&dict[self.index_buf[i] as usize])
-                    }
-                    self.bit_packed_left -= num_values as u32;
-                    values_read += num_values;
-                    if num_values < self.index_buf.len() {
-                        break;
-                    }
+                num_values = bit_reader.get_batch::<i32>(
+                    &mut self.index_buf[..num_values],
+                    self.bit_width as usize,
+                );
+                if num_values == 0 {
+                    // the run is cut short by the end of the data
+                    self.bit_packed_left = 0;
+                    continue;
                 }
+                for (value, index) in buffer[values_read..values_read + num_values]
+                    .iter_mut()
+                    .zip(&self.index_buf[..num_values])
+                {
+                    value.clone_from(&dict[*index as usize]);
+                }
+                self.bit_packed_left -= num_values as u32;
+                values_read += num_values;
             } else if !self.reload() {
                 break;
             }
@@ -617,6 +622,27 @@ mod tests {
         assert_eq!(buffer, expected);
     }
 
+    #[test]
+    fn test_rle_decode_with_dict_long_bit_packed_run() {
+        // A bit-packed run of 256 groups of 8 values 0 and 1 alternating with bit
+        // width 1, longer than the runs written by `RleEncoder`
+        let mut data = vec![0x81, 0x04];
+        data.extend(std::iter::repeat(0xAA).take(256));
+        let dict = vec![10, 20];
+        let mut decoder: RleDecoder = RleDecoder::new(1);
+        decoder.set_data(ByteBufferPtr::new(data));
+
+        let expected: Vec<i32> = (0..2048).map(|i| dict[i % 2]).collect();
+        let mut buffer = vec![0; 1500];
+        let result = decoder.get_batch_with_dict::<i32>(&dict, &mut buffer, 1500);
+        assert_eq!(result.unwrap(), 1500);
+        assert_eq!(buffer.as_slice(), &expected[..1500]);
+
+        let result = decoder.get_batch_with_dict::<i32>(&dict, &mut buffer, 1500);
+        assert_eq!(result.unwrap(), 548);
+        assert_eq!(&buffer[..548], &expected[1500..]);
+    }
+
     fn validate_rle(
         values: &[i64],
         bit_width: u8,
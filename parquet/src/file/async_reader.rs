@@ -0,0 +1,216 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Contains asynchronous counterparts of the file reader APIs, for reading Parquet
+//! files from sources where every read is a high latency request, such as object
+//! stores. Only fetching bytes is asynchronous; once fetched, data is decoded by the
+//! synchronous readers.
+//!
+//! Requires the `async` feature.
+
+use std::{cmp::min, io::Read};
+
+use futures::future::{self, BoxFuture};
+
+use crate::errors::{ParquetError, Result};
+use crate::file::{
+    footer,
+    metadata::{ParquetMetaData, RowGroupMetaData},
+    reader::{ChunkReader, Length},
+    serialized_reader::{SerializedPageReader, SliceableCursor},
+    DEFAULT_FOOTER_READ_SIZE, FOOTER_SIZE,
+};
+
+/// The asynchronous counterpart of [`ChunkReader`].
+///
+/// Reads take `&self`, so that several byte ranges can be requested concurrently.
+pub trait AsyncChunkReader: Length + Send + Sync {
+    /// Fetches `length` bytes of the source starting at offset `start`.
+    fn get_bytes(&self, start: u64, length: usize) -> BoxFuture<'_, Result<Vec<u8>>>;
+}
+
+impl AsyncChunkReader for SliceableCursor {
+    fn get_bytes(&self, start: u64, length: usize) -> BoxFuture<'_, Result<Vec<u8>>> {
+        let bytes = self.get_read(start, length).and_then(|mut read| {
+            let mut buf = Vec::with_capacity(length);
+            read.read_to_end(&mut buf)?;
+            Ok(buf)
+        });
+        Box::pin(future::ready(bytes))
+    }
+}
+
+/// Asynchronously reads the [`ParquetMetaData`] of a Parquet file.
+///
+/// Like [`footer::parse_metadata`], this first fetches up to DEFAULT_FOOTER_READ_SIZE
+/// bytes from the end of the file, and only issues a second request if the metadata
+/// is larger than that.
+pub async fn parse_metadata<R: AsyncChunkReader>(
+    chunk_reader: &R,
+) -> Result<ParquetMetaData> {
+    // check file is large enough to hold footer
+    let file_size = chunk_reader.len();
+    if file_size < (FOOTER_SIZE as u64) {
+        return Err(general_err!(
+            "Invalid Parquet file. Size is smaller than footer"
+        ));
+    }
+
+    let default_end_len = min(DEFAULT_FOOTER_READ_SIZE, file_size as usize);
+    let default_end_buf = chunk_reader
+        .get_bytes(file_size - default_end_len as u64, default_end_len)
+        .await?;
+    if default_end_buf.len() != default_end_len {
+        return Err(eof_err!(
+            "Expected to read {} bytes of footer, got {}",
+            default_end_len,
+            default_end_buf.len()
+        ));
+    }
+
+    let metadata_len =
+        footer::decode_footer(&default_end_buf[default_end_len - FOOTER_SIZE..])?;
+    let footer_metadata_len = FOOTER_SIZE + metadata_len;
+    if footer_metadata_len > file_size as usize {
+        return Err(general_err!(
+            "Invalid Parquet file. Metadata start is less than zero ({})",
+            file_size as i64 - footer_metadata_len as i64
+        ));
+    }
+
+    if footer_metadata_len <= default_end_len {
+        // the whole metadata is in the bytes we already read
+        footer::decode_metadata(&default_end_buf[default_end_len - footer_metadata_len..])
+    } else {
+        // the end of file read by default is not long enough, fetch missing bytes
+        let mut metadata_buf = chunk_reader
+            .get_bytes(
+                file_size - footer_metadata_len as u64,
+                footer_metadata_len - default_end_len,
+            )
+            .await?;
+        metadata_buf.extend_from_slice(&default_end_buf);
+        footer::decode_metadata(metadata_buf.as_slice())
+    }
+}
+
+/// Fetches the `i`th column chunk of `row_group` with a single request, and returns a
+/// page reader over the fetched bytes.
+pub async fn get_column_page_reader<R: AsyncChunkReader>(
+    chunk_reader: &R,
+    row_group: &RowGroupMetaData,
+    i: usize,
+) -> Result<SerializedPageReader<SliceableCursor>> {
+    let col = row_group.column(i);
+    let (col_start, col_length) = col.byte_range();
+    let data = chunk_reader
+        .get_bytes(col_start, col_length as usize)
+        .await?;
+    SerializedPageReader::new(
+        SliceableCursor::new(data),
+        col.num_values(),
+        col.compression(),
+        col.column_descr().physical_type(),
+    )
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use futures::executor::block_on;
+
+    use crate::column::page::PageReader;
+    use crate::file::reader::FileReader;
+    use crate::file::serialized_reader::SerializedFileReader;
+    use crate::util::test_common::get_test_file;
+
+    fn test_file_cursor(file_name: &str) -> SliceableCursor {
+        let mut buf = Vec::new();
+        get_test_file(file_name).read_to_end(&mut buf).unwrap();
+        SliceableCursor::new(buf)
+    }
+
+    #[test]
+    fn test_async_parse_metadata() {
+        let cursor = test_file_cursor("alltypes_plain.parquet");
+        let expected = footer::parse_metadata(&cursor).unwrap();
+        let metadata = block_on(parse_metadata(&cursor)).unwrap();
+
+        assert_eq!(metadata.num_row_groups(), expected.num_row_groups());
+        assert_eq!(
+            metadata.file_metadata().num_rows(),
+            expected.file_metadata().num_rows()
+        );
+        assert_eq!(
+            metadata.file_metadata().schema_descr().num_columns(),
+            expected.file_metadata().schema_descr().num_columns()
+        );
+    }
+
+    #[test]
+    fn test_async_parse_metadata_corrupt_footer() {
+        let cursor = SliceableCursor::new(vec![1, 2, 3, 4, 5, 6, 7, 8]);
+        let result = block_on(parse_metadata(&cursor));
+        assert_eq!(
+            result.err().unwrap(),
+            ParquetError::General("Invalid Parquet file. Corrupt footer".to_owned())
+        );
+
+        let cursor = SliceableCursor::new(vec![1, 2, 3]);
+        let result = block_on(parse_metadata(&cursor));
+        assert_eq!(
+            result.err().unwrap(),
+            ParquetError::General(
+                "Invalid Parquet file. Size is smaller than footer".to_owned()
+            )
+        );
+    }
+
+    #[test]
+    fn test_async_column_page_reader() {
+        let cursor = test_file_cursor("alltypes_plain.parquet");
+        let reader =
+            SerializedFileReader::new(test_file_cursor("alltypes_plain.parquet"))
+                .unwrap();
+        let row_group = reader.metadata().row_group(0);
+
+        for i in 0..row_group.num_columns() {
+            let mut expected = reader
+                .get_row_group(0)
+                .unwrap()
+                .get_column_page_reader(i)
+                .unwrap();
+            let mut actual =
+                block_on(get_column_page_reader(&cursor, row_group, i)).unwrap();
+            loop {
+                match (
+                    expected.get_next_page().unwrap(),
+                    actual.get_next_page().unwrap(),
+                ) {
+                    (Some(expected), Some(actual)) => {
+                        assert_eq!(actual.page_type(), expected.page_type());
+                        assert_eq!(actual.num_values(), expected.num_values());
+                        assert_eq!(actual.buffer().data(), expected.buffer().data());
+                    }
+                    (None, None) => break,
+                    _ => panic!("page readers returned different numbers of pages"),
+                }
+            }
+        }
+    }
+}
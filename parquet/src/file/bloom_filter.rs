@@ -0,0 +1,305 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Contains the split block Bloom filter of a column chunk, which lets a reader
+//! rule out a column chunk for an equality or `IN` predicate on a value that is
+//! within the min and max statistics of the chunk, but not one of its values.
+//!
+//! Bloom filters are opt-in per column, see
+//! [`WriterPropertiesBuilder::set_column_bloom_filter_enabled`](crate::file::properties::WriterPropertiesBuilder::set_column_bloom_filter_enabled),
+//! and are stored after the row groups of a file. The filter itself follows the
+//! Parquet format specification: blocks of eight 32-bit words, with values hashed by
+//! XXH64 of their plain encoding. As the thrift definitions used by this crate do
+//! not have a field for the location of a Bloom filter, it is recorded in the key
+//! value metadata of the column chunk, and the filter is stored without a
+//! `BloomFilterHeader`.
+
+use std::io::Read;
+
+use byteorder::{ByteOrder, LittleEndian};
+use parquet_format::KeyValue;
+
+use crate::data_type::AsBytes;
+use crate::errors::{ParquetError, Result};
+use crate::file::{metadata::ColumnChunkMetaData, reader::ChunkReader};
+use crate::util::hash_util;
+
+/// Key value metadata key of the offset of the Bloom filter of a column chunk.
+const BLOOM_FILTER_OFFSET_KEY: &str = "parquet.bloom_filter.offset";
+/// Key value metadata key of the length of the Bloom filter of a column chunk.
+const BLOOM_FILTER_LENGTH_KEY: &str = "parquet.bloom_filter.length";
+
+/// Size of a block in bytes.
+const BLOCK_SIZE: usize = 32;
+
+/// Minimum size of a Bloom filter in bytes.
+pub const MIN_BLOOM_FILTER_SIZE: usize = BLOCK_SIZE;
+/// Maximum size of a Bloom filter in bytes.
+pub const MAX_BLOOM_FILTER_SIZE: usize = 128 * 1024 * 1024;
+
+/// Odd constants that select a bit of each word of a block, from the specification.
+const SALT: [u32; 8] = [
+    0x47b6137b, 0x44974d91, 0x8824ad5b, 0xa2b7289d, 0x705495c7, 0x2df1424b, 0x9efc4947,
+    0x5c6bfb31,
+];
+
+type Block = [u32; 8];
+
+/// Returns the block with the bit of each word that `key` selects set.
+#[inline]
+fn block_mask(key: u32) -> Block {
+    let mut mask = [0; 8];
+    for (word, salt) in mask.iter_mut().zip(SALT.iter()) {
+        *word = 1 << (key.wrapping_mul(*salt) >> 27);
+    }
+    mask
+}
+
+/// A split block Bloom filter.
+///
+/// May report that a value which was never inserted is contained, but never
+/// reports that an inserted value is not.
+#[derive(Debug, Clone, PartialEq)]
+pub struct Sbbf {
+    blocks: Vec<Block>,
+}
+
+impl Sbbf {
+    /// Creates an empty Bloom filter of `num_bytes` bytes, rounded to a power of two
+    /// between [`MIN_BLOOM_FILTER_SIZE`] and [`MAX_BLOOM_FILTER_SIZE`].
+    pub fn new(num_bytes: usize) -> Self {
+        let num_bytes = num_bytes
+            .max(MIN_BLOOM_FILTER_SIZE)
+            .min(MAX_BLOOM_FILTER_SIZE)
+            .next_power_of_two();
+        Self {
+            blocks: vec![[0; 8]; num_bytes / BLOCK_SIZE],
+        }
+    }
+
+    /// Creates an empty Bloom filter large enough to hold `ndv` distinct values with
+    /// a false positive probability of at most `fpp`.
+    pub fn new_with_ndv_fpp(ndv: u64, fpp: f64) -> Self {
+        Self::new(Self::optimal_num_bytes(ndv, fpp))
+    }
+
+    /// Returns the number of bytes a Bloom filter needs to hold `ndv` distinct values
+    /// with a false positive probability of at most `fpp`, before rounding.
+    pub fn optimal_num_bytes(ndv: u64, fpp: f64) -> usize {
+        let num_bits = -8.0 * ndv as f64 / (1.0 - fpp.powf(1.0 / 8.0)).ln();
+        if num_bits.is_finite() {
+            (num_bits / 8.0).ceil().min(MAX_BLOOM_FILTER_SIZE as f64) as usize
+        } else {
+            MAX_BLOOM_FILTER_SIZE
+        }
+    }
+
+    /// Creates a Bloom filter from its serialized bitset.
+    pub fn from_bytes(bytes: &[u8]) -> Result<Self> {
+        let num_bytes = bytes.len();
+        if num_bytes < MIN_BLOOM_FILTER_SIZE
+            || num_bytes > MAX_BLOOM_FILTER_SIZE
+            || !num_bytes.is_power_of_two()
+        {
+            return Err(general_err!("Invalid Bloom filter size: {}", num_bytes));
+        }
+        let blocks = bytes
+            .chunks(BLOCK_SIZE)
+            .map(|chunk| {
+                let mut block = [0; 8];
+                LittleEndian::read_u32_into(chunk, &mut block);
+                block
+            })
+            .collect();
+        Ok(Self { blocks })
+    }
+
+    /// Returns the serialized bitset of this Bloom filter.
+    pub fn to_bytes(&self) -> Vec<u8> {
+        let mut bytes = vec![0; self.num_bytes()];
+        for (block, chunk) in self.blocks.iter().zip(bytes.chunks_mut(BLOCK_SIZE)) {
+            LittleEndian::write_u32_into(block, chunk);
+        }
+        bytes
+    }
+
+    /// Returns the size of this Bloom filter in bytes.
+    pub fn num_bytes(&self) -> usize {
+        self.blocks.len() * BLOCK_SIZE
+    }
+
+    /// Inserts a value, given by its plain encoding.
+    #[inline]
+    pub fn insert<T: AsBytes + ?Sized>(&mut self, value: &T) {
+        self.insert_hash(hash_util::xxhash64(value.as_bytes(), 0));
+    }
+
+    /// Returns `false` if a value, given by its plain encoding, was certainly not
+    /// inserted, and `true` if it may have been.
+    #[inline]
+    pub fn check<T: AsBytes + ?Sized>(&self, value: &T) -> bool {
+        self.check_hash(hash_util::xxhash64(value.as_bytes(), 0))
+    }
+
+    /// Inserts the XXH64 hash of a value.
+    pub fn insert_hash(&mut self, hash: u64) {
+        let i = self.block_index(hash);
+        let mask = block_mask(hash as u32);
+        for (word, bit) in self.blocks[i].iter_mut().zip(mask.iter()) {
+            *word |= *bit;
+        }
+    }
+
+    /// Returns `false` if no value with the XXH64 hash `hash` was inserted, and
+    /// `true` if one may have been.
+    pub fn check_hash(&self, hash: u64) -> bool {
+        let i = self.block_index(hash);
+        let mask = block_mask(hash as u32);
+        self.blocks[i]
+            .iter()
+            .zip(mask.iter())
+            .all(|(word, bit)| word & bit != 0)
+    }
+
+    /// Returns the block that a hash selects, from its upper 32 bits.
+    #[inline]
+    fn block_index(&self, hash: u64) -> usize {
+        (((hash >> 32) * self.blocks.len() as u64) >> 32) as usize
+    }
+}
+
+/// Reads the Bloom filter of `column`, or returns `None` if it does not have one.
+pub fn read_bloom_filter<R: ChunkReader>(
+    chunk_reader: &R,
+    column: &ColumnChunkMetaData,
+) -> Result<Option<Sbbf>> {
+    let (offset, length) = match column.bloom_filter_range() {
+        Some(range) => range,
+        None => return Ok(None),
+    };
+    let mut bytes = Vec::with_capacity(length);
+    chunk_reader
+        .get_read(offset, length)?
+        .take(length as u64)
+        .read_to_end(&mut bytes)?;
+    if bytes.len() != length {
+        return Err(eof_err!(
+            "Expected to read {} bytes of Bloom filter, got {}",
+            length,
+            bytes.len()
+        ));
+    }
+    Sbbf::from_bytes(&bytes).map(Some)
+}
+
+/// Returns the key value metadata that records the location of a Bloom filter.
+pub(crate) fn location_to_thrift(offset: i64, length: i32) -> Vec<KeyValue> {
+    vec![
+        KeyValue {
+            key: BLOOM_FILTER_OFFSET_KEY.to_owned(),
+            value: Some(offset.to_string()),
+        },
+        KeyValue {
+            key: BLOOM_FILTER_LENGTH_KEY.to_owned(),
+            value: Some(length.to_string()),
+        },
+    ]
+}
+
+/// Returns the offset and length of a Bloom filter recorded in `key_value_metadata`,
+/// if any.
+pub(crate) fn location_from_thrift(
+    key_value_metadata: Option<&[KeyValue]>,
+) -> Option<(i64, i32)> {
+    let find = |key: &str| {
+        key_value_metadata?
+            .iter()
+            .find(|kv| kv.key == key)
+            .and_then(|kv| kv.value.as_deref())
+    };
+    let offset = find(BLOOM_FILTER_OFFSET_KEY)?.parse().ok()?;
+    let length = find(BLOOM_FILTER_LENGTH_KEY)?.parse().ok()?;
+    Some((offset, length))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use crate::data_type::ByteArray;
+
+    #[test]
+    fn test_sbbf_size() {
+        assert_eq!(Sbbf::new(0).num_bytes(), MIN_BLOOM_FILTER_SIZE);
+        assert_eq!(Sbbf::new(100).num_bytes(), 128);
+        assert_eq!(
+            Sbbf::new(MAX_BLOOM_FILTER_SIZE + 1).num_bytes(),
+            MAX_BLOOM_FILTER_SIZE
+        );
+
+        // about 6.9 bits per distinct value for a 5% false positive probability
+        let num_bytes = Sbbf::optimal_num_bytes(1000, 0.05);
+        assert!(num_bytes > 850 && num_bytes < 870, "{}", num_bytes);
+        assert_eq!(Sbbf::new_with_ndv_fpp(1000, 0.05).num_bytes(), 1024);
+        assert_eq!(Sbbf::optimal_num_bytes(1000, 0.0), MAX_BLOOM_FILTER_SIZE);
+        assert_eq!(Sbbf::optimal_num_bytes(0, 0.05), 0);
+    }
+
+    #[test]
+    fn test_sbbf_insert_and_check() {
+        let mut sbbf = Sbbf::new_with_ndv_fpp(1000, 0.01);
+        for i in 0..1000_i64 {
+            sbbf.insert(&i);
+        }
+        sbbf.insert(&ByteArray::from("parquet"));
+        for i in 0..1000_i64 {
+            assert!(sbbf.check(&i));
+        }
+        assert!(sbbf.check(&ByteArray::from("parquet")));
+        assert!(sbbf.check("parquet"));
+
+        let false_positives = (1000..11000_i64).filter(|i| sbbf.check(i)).count();
+        assert!(false_positives < 300, "{} false positives", false_positives);
+    }
+
+    #[test]
+    fn test_sbbf_bytes_roundtrip() {
+        let mut sbbf = Sbbf::new(64);
+        sbbf.insert(&42_i32);
+        let bytes = sbbf.to_bytes();
+        assert_eq!(bytes.len(), 64);
+        let result = Sbbf::from_bytes(&bytes).unwrap();
+        assert_eq!(result, sbbf);
+        assert!(result.check(&42_i32));
+
+        assert_eq!(
+            Sbbf::from_bytes(&bytes[..48]).unwrap_err(),
+            general_err!("Invalid Bloom filter size: 48")
+        );
+    }
+
+    #[test]
+    fn test_location_thrift_roundtrip() {
+        let key_value_metadata = location_to_thrift(1234, 1024);
+        assert_eq!(
+            location_from_thrift(Some(&key_value_metadata)),
+            Some((1234, 1024))
+        );
+        assert_eq!(location_from_thrift(Some(&key_value_metadata[..1])), None);
+        assert_eq!(location_from_thrift(None), None);
+    }
+}
@@ -59,22 +59,9 @@ pub fn parse_metadata<R: ChunkReader>(chunk_reader: &R) -> Result<ParquetMetaDat
     let mut default_len_end_buf = vec![0; default_end_len];
     default_end_reader.read_exact(&mut default_len_end_buf)?;
 
-    // check this is indeed a parquet file
-    if default_len_end_buf[default_end_len - 4..] != PARQUET_MAGIC {
-        return Err(general_err!("Invalid Parquet file. Corrupt footer"));
-    }
-
-    // get the metadata length from the footer
-    let metadata_len = LittleEndian::read_i32(
-        &default_len_end_buf[default_end_len - 8..default_end_len - 4],
-    ) as i64;
-    if metadata_len < 0 {
-        return Err(general_err!(
-            "Invalid Parquet file. Metadata length is less than zero ({})",
-            metadata_len
-        ));
-    }
-    let footer_metadata_len = FOOTER_SIZE + metadata_len as usize;
+    let metadata_len =
+        decode_footer(&default_len_end_buf[default_end_len - FOOTER_SIZE..])?;
+    let footer_metadata_len = FOOTER_SIZE + metadata_len;
 
     // build up the reader covering the entire metadata
     let mut default_end_cursor = Cursor::new(default_len_end_buf);
@@ -92,11 +79,36 @@ pub fn parse_metadata<R: ChunkReader>(chunk_reader: &R) -> Result<ParquetMetaDat
         // the end of file read by default is not long enough, read missing bytes
         let complementary_end_read = chunk_reader.get_read(
             file_size - footer_metadata_len as u64,
-            FOOTER_SIZE + metadata_len as usize - default_end_len,
+            FOOTER_SIZE + metadata_len - default_end_len,
         )?;
         metadata_read = Box::new(complementary_end_read.chain(default_end_cursor));
     }
 
+    decode_metadata(metadata_read)
+}
+
+/// Decodes the 8 byte Parquet footer, returning the length of the file metadata that
+/// immediately precedes it.
+pub fn decode_footer(footer: &[u8]) -> Result<usize> {
+    // check this is indeed a parquet file
+    if footer.len() != FOOTER_SIZE || footer[4..] != PARQUET_MAGIC {
+        return Err(general_err!("Invalid Parquet file. Corrupt footer"));
+    }
+
+    // get the metadata length from the footer
+    let metadata_len = LittleEndian::read_i32(&footer[..4]) as i64;
+    if metadata_len < 0 {
+        return Err(general_err!(
+            "Invalid Parquet file. Metadata length is less than zero ({})",
+            metadata_len
+        ));
+    }
+    Ok(metadata_len as usize)
+}
+
+/// Decodes [`ParquetMetaData`] from the Thrift encoded file metadata read from
+/// `metadata_read`. Any bytes following the metadata, such as the footer, are ignored.
+pub fn decode_metadata<R: Read>(metadata_read: R) -> Result<ParquetMetaData> {
     // TODO: row group filtering
     let mut prot = TCompactInputProtocol::new(metadata_read);
     let t_file_metadata: TFileMetaData = TFileMetaData::read_from_in_protocol(&mut prot)
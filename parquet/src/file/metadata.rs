@@ -39,6 +39,8 @@ use parquet_format::{ColumnChunk, ColumnMetaData, RowGroup};
 
 use crate::basic::{ColumnOrder, Compression, Encoding, Type};
 use crate::errors::{ParquetError, Result};
+use crate::file::bloom_filter::{self, Sbbf};
+use crate::file::page_index::PageIndex;
 use crate::file::statistics::{self, Statistics};
 use crate::schema::types::{
     ColumnDescPtr, ColumnDescriptor, ColumnPath, SchemaDescPtr, SchemaDescriptor,
@@ -346,6 +348,14 @@ pub struct ColumnChunkMetaData {
     index_page_offset: Option<i64>,
     dictionary_page_offset: Option<i64>,
     statistics: Option<Statistics>,
+    offset_index_offset: Option<i64>,
+    offset_index_length: Option<i32>,
+    column_index_offset: Option<i64>,
+    column_index_length: Option<i32>,
+    page_index: Option<Arc<PageIndex>>,
+    bloom_filter_offset: Option<i64>,
+    bloom_filter_length: Option<i32>,
+    bloom_filter: Option<Arc<Sbbf>>,
 }
 
 /// Represents common operations for a column chunk.
@@ -459,6 +469,66 @@ impl ColumnChunkMetaData {
         self.statistics.as_ref()
     }
 
+    /// Returns the offset and length in bytes of the offset index of this column
+    /// chunk, if it has one.
+    pub fn offset_index_range(&self) -> Option<(u64, usize)> {
+        index_range(self.offset_index_offset, self.offset_index_length)
+    }
+
+    /// Returns the offset and length in bytes of the column index of this column
+    /// chunk, if it has one.
+    pub fn column_index_range(&self) -> Option<(u64, usize)> {
+        index_range(self.column_index_offset, self.column_index_length)
+    }
+
+    /// Returns the page index of this column chunk, if it has been built by a
+    /// writer or loaded by a reader.
+    pub fn page_index(&self) -> Option<&PageIndex> {
+        self.page_index.as_deref()
+    }
+
+    /// Sets the page index of this column chunk.
+    pub(crate) fn set_page_index(&mut self, page_index: Option<PageIndex>) {
+        self.page_index = page_index.map(Arc::new);
+    }
+
+    /// Returns the offset and length in bytes of the Bloom filter of this column
+    /// chunk, if it has one.
+    pub fn bloom_filter_range(&self) -> Option<(u64, usize)> {
+        index_range(self.bloom_filter_offset, self.bloom_filter_length)
+    }
+
+    /// Returns the Bloom filter of this column chunk, if it has been built by a
+    /// writer or loaded by a reader.
+    pub fn bloom_filter(&self) -> Option<&Sbbf> {
+        self.bloom_filter.as_deref()
+    }
+
+    /// Sets the Bloom filter of this column chunk.
+    pub(crate) fn set_bloom_filter(&mut self, bloom_filter: Option<Sbbf>) {
+        self.bloom_filter = bloom_filter.map(Arc::new);
+    }
+
+    /// Sets the number of values of this column chunk, used when only some of its
+    /// pages are read.
+    pub(crate) fn set_num_values(&mut self, num_values: i64) {
+        self.num_values = num_values;
+    }
+
+    /// Shifts all file offsets of this column chunk by `offset` bytes.
+    ///
+    /// Used when a column chunk that was encoded into a separate buffer is appended
+    /// to a file.
+    pub(crate) fn shift_offsets(&mut self, offset: i64) {
+        self.file_offset += offset;
+        self.data_page_offset += offset;
+        self.index_page_offset = self.index_page_offset.map(|v| v + offset);
+        self.dictionary_page_offset = self.dictionary_page_offset.map(|v| v + offset);
+        if let Some(page_index) = self.page_index.as_mut() {
+            Arc::make_mut(page_index).shift_offsets(offset);
+        }
+    }
+
     /// Method to convert from Thrift.
     pub fn from_thrift(column_descr: ColumnDescPtr, cc: ColumnChunk) -> Result<Self> {
         if cc.meta_data.is_none() {
@@ -482,6 +552,9 @@ impl ColumnChunkMetaData {
         let index_page_offset = col_metadata.index_page_offset;
         let dictionary_page_offset = col_metadata.dictionary_page_offset;
         let statistics = statistics::from_thrift(column_type, col_metadata.statistics);
+        let bloom_filter_location = bloom_filter::location_from_thrift(
+            col_metadata.key_value_metadata.as_deref(),
+        );
         let result = ColumnChunkMetaData {
             column_type,
             column_path,
@@ -497,6 +570,14 @@ impl ColumnChunkMetaData {
             index_page_offset,
             dictionary_page_offset,
             statistics,
+            offset_index_offset: cc.offset_index_offset,
+            offset_index_length: cc.offset_index_length,
+            column_index_offset: cc.column_index_offset,
+            column_index_length: cc.column_index_length,
+            page_index: None,
+            bloom_filter_offset: bloom_filter_location.map(|(offset, _)| offset),
+            bloom_filter_length: bloom_filter_location.map(|(_, length)| length),
+            bloom_filter: None,
         };
         Ok(result)
     }
@@ -511,7 +592,10 @@ impl ColumnChunkMetaData {
             num_values: self.num_values,
             total_uncompressed_size: self.total_uncompressed_size,
             total_compressed_size: self.total_compressed_size,
-            key_value_metadata: None,
+            key_value_metadata: self
+                .bloom_filter_offset
+                .zip(self.bloom_filter_length)
+                .map(|(offset, length)| bloom_filter::location_to_thrift(offset, length)),
             data_page_offset: self.data_page_offset,
             index_page_offset: self.index_page_offset,
             dictionary_page_offset: self.dictionary_page_offset,
@@ -523,11 +607,21 @@ impl ColumnChunkMetaData {
             file_path: self.file_path().cloned(),
             file_offset: self.file_offset,
             meta_data: Some(column_metadata),
-            offset_index_offset: None,
-            offset_index_length: None,
-            column_index_offset: None,
-            column_index_length: None,
+            offset_index_offset: self.offset_index_offset,
+            offset_index_length: self.offset_index_length,
+            column_index_offset: self.column_index_offset,
+            column_index_length: self.column_index_length,
+        }
+    }
+}
+
+/// Returns the range of an index from its optional offset and length.
+fn index_range(offset: Option<i64>, length: Option<i32>) -> Option<(u64, usize)> {
+    match (offset, length) {
+        (Some(offset), Some(length)) if offset >= 0 && length > 0 => {
+            Some((offset as u64, length as usize))
         }
+        _ => None,
     }
 }
 
@@ -545,6 +639,8 @@ pub struct ColumnChunkMetaDataBuilder {
     index_page_offset: Option<i64>,
     dictionary_page_offset: Option<i64>,
     statistics: Option<Statistics>,
+    page_index: Option<PageIndex>,
+    bloom_filter: Option<Sbbf>,
 }
 
 impl ColumnChunkMetaDataBuilder {
@@ -563,6 +659,8 @@ impl ColumnChunkMetaDataBuilder {
             index_page_offset: None,
             dictionary_page_offset: None,
             statistics: None,
+            page_index: None,
+            bloom_filter: None,
         }
     }
 
@@ -632,6 +730,18 @@ impl ColumnChunkMetaDataBuilder {
         self
     }
 
+    /// Sets the page index built for this column chunk.
+    pub fn set_page_index(mut self, value: Option<PageIndex>) -> Self {
+        self.page_index = value;
+        self
+    }
+
+    /// Sets the Bloom filter built for this column chunk.
+    pub fn set_bloom_filter(mut self, value: Option<Sbbf>) -> Self {
+        self.bloom_filter = value;
+        self
+    }
+
     /// Builds column chunk metadata.
     pub fn build(self) -> Result<ColumnChunkMetaData> {
         Ok(ColumnChunkMetaData {
@@ -649,6 +759,14 @@ impl ColumnChunkMetaDataBuilder {
             index_page_offset: self.index_page_offset,
             dictionary_page_offset: self.dictionary_page_offset,
             statistics: self.statistics,
+            offset_index_offset: None,
+            offset_index_length: None,
+            column_index_offset: None,
+            column_index_length: None,
+            page_index: self.page_index.map(Arc::new),
+            bloom_filter_offset: None,
+            bloom_filter_length: None,
+            bloom_filter: self.bloom_filter.map(Arc::new),
         })
     }
 }
@@ -741,6 +859,37 @@ mod tests {
         assert_eq!(col_chunk_res, col_chunk_exp);
     }
 
+    #[test]
+    fn test_column_chunk_metadata_index_ranges() {
+        let column_descr = get_test_schema_descr().column(0);
+
+        let mut col_chunk = ColumnChunkMetaData::builder(column_descr.clone())
+            .build()
+            .unwrap()
+            .to_thrift();
+        col_chunk.offset_index_offset = Some(6000);
+        col_chunk.offset_index_length = Some(20);
+        col_chunk.column_index_offset = Some(5000);
+        col_chunk.column_index_length = Some(0);
+
+        let col_metadata =
+            ColumnChunkMetaData::from_thrift(column_descr.clone(), col_chunk.clone())
+                .unwrap();
+        assert_eq!(col_metadata.offset_index_range(), Some((6000, 20)));
+        assert_eq!(col_metadata.column_index_range(), None);
+        assert!(col_metadata.page_index().is_none());
+        assert_eq!(col_metadata.bloom_filter_range(), None);
+        assert_eq!(col_metadata.to_thrift(), col_chunk);
+
+        col_chunk.meta_data.as_mut().unwrap().key_value_metadata =
+            Some(bloom_filter::location_to_thrift(7000, 1024));
+        let col_metadata =
+            ColumnChunkMetaData::from_thrift(column_descr, col_chunk.clone()).unwrap();
+        assert_eq!(col_metadata.bloom_filter_range(), Some((7000, 1024)));
+        assert!(col_metadata.bloom_filter().is_none());
+        assert_eq!(col_metadata.to_thrift(), col_chunk);
+    }
+
     #[test]
     fn test_compressed_size() {
         let schema_descr = get_test_schema_descr();
@@ -95,8 +95,14 @@
 //!     println!("{}", row);
 //! }
 //! ```
+#[cfg(feature = "async")]
+pub mod async_reader;
+pub mod bloom_filter;
 pub mod footer;
 pub mod metadata;
+pub mod page_index;
+pub mod predicate;
+pub mod prefetch;
 pub mod properties;
 pub mod reader;
 pub mod serialized_reader;
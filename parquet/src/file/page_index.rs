@@ -0,0 +1,642 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Contains the page index of a column chunk, which is stored after the row groups
+//! of a file and consists of two structures:
+//!
+//! - the [`ColumnIndex`], with the min and max values and null counts of every data
+//! page;
+//! - the [`OffsetIndex`], with the location and first row of every data page.
+//!
+//! Together they let a reader evaluate a predicate per page, and read only the pages
+//! of the rows that can match, see [`RowRanges`] and
+//! [`SerializedFileReader::prune_pages`](crate::file::serialized_reader::SerializedFileReader::prune_pages).
+//!
+//! The page index is only written and used for non-repeated columns, whose pages
+//! always start at a row boundary.
+
+use std::{cmp, collections::VecDeque, ops::Range};
+
+use parquet_format::{
+    BoundaryOrder, ColumnIndex as TColumnIndex, OffsetIndex as TOffsetIndex,
+    PageLocation as TPageLocation, Statistics as TStatistics,
+};
+use thrift::protocol::TCompactInputProtocol;
+
+use crate::basic::Type;
+use crate::errors::{ParquetError, Result};
+use crate::file::{
+    metadata::ColumnChunkMetaData,
+    reader::ChunkReader,
+    statistics::{self, Statistics},
+};
+
+/// Location of a data page, as recorded in the [`OffsetIndex`].
+#[derive(Debug, Clone, PartialEq)]
+pub struct PageLocation {
+    /// Offset of the page header in the file.
+    pub offset: i64,
+    /// Size of the page in bytes, including its header.
+    pub compressed_page_size: i32,
+    /// Index of the first row of the page within its row group.
+    pub first_row_index: i64,
+}
+
+/// Locations of the data pages of a column chunk.
+#[derive(Debug, Clone, PartialEq)]
+pub struct OffsetIndex {
+    page_locations: Vec<PageLocation>,
+}
+
+impl OffsetIndex {
+    /// Creates an offset index from page locations ordered by their first row.
+    pub fn new(page_locations: Vec<PageLocation>) -> Self {
+        Self { page_locations }
+    }
+
+    /// Returns the locations of all data pages.
+    pub fn page_locations(&self) -> &[PageLocation] {
+        &self.page_locations
+    }
+
+    /// Returns the number of data pages.
+    pub fn num_pages(&self) -> usize {
+        self.page_locations.len()
+    }
+
+    /// Returns the rows of page `i`, in a row group of `num_rows` rows.
+    pub fn page_rows(&self, i: usize, num_rows: usize) -> Range<usize> {
+        let start = self.page_locations[i].first_row_index as usize;
+        let end = self
+            .page_locations
+            .get(i + 1)
+            .map_or(num_rows, |next| next.first_row_index as usize);
+        start..end
+    }
+
+    /// Returns the indices of the pages that contain any of `rows`.
+    pub fn selected_pages(&self, rows: &RowRanges, num_rows: usize) -> Vec<usize> {
+        (0..self.num_pages())
+            .filter(|i| rows.intersects(&self.page_rows(*i, num_rows)))
+            .collect()
+    }
+
+    /// Returns the rows of the pages that contain any of `rows`.
+    fn covering_rows(&self, rows: &RowRanges, num_rows: usize) -> RowRanges {
+        let mut covering = RowRanges::default();
+        for i in self.selected_pages(rows, num_rows) {
+            covering.push(self.page_rows(i, num_rows));
+        }
+        covering
+    }
+
+    /// Shifts all page offsets by `offset` bytes.
+    pub(crate) fn shift_offsets(&mut self, offset: i64) {
+        for location in self.page_locations.iter_mut() {
+            location.offset += offset;
+        }
+    }
+
+    /// Method to convert from Thrift.
+    pub fn from_thrift(offset_index: TOffsetIndex) -> Self {
+        let page_locations = offset_index
+            .page_locations
+            .into_iter()
+            .map(|location| PageLocation {
+                offset: location.offset,
+                compressed_page_size: location.compressed_page_size,
+                first_row_index: location.first_row_index,
+            })
+            .collect();
+        Self { page_locations }
+    }
+
+    /// Method to convert to Thrift.
+    pub fn to_thrift(&self) -> TOffsetIndex {
+        TOffsetIndex {
+            page_locations: self
+                .page_locations
+                .iter()
+                .map(|location| TPageLocation {
+                    offset: location.offset,
+                    compressed_page_size: location.compressed_page_size,
+                    first_row_index: location.first_row_index,
+                })
+                .collect(),
+        }
+    }
+}
+
+/// Statistics of the data pages of a column chunk.
+///
+/// Min and max values are encoded as in [`Statistics`], and are empty for pages that
+/// only contain nulls.
+#[derive(Debug, Clone, PartialEq)]
+pub struct ColumnIndex {
+    null_pages: Vec<bool>,
+    min_values: Vec<Vec<u8>>,
+    max_values: Vec<Vec<u8>>,
+    null_counts: Option<Vec<i64>>,
+}
+
+impl ColumnIndex {
+    /// Returns the number of data pages.
+    pub fn num_pages(&self) -> usize {
+        self.null_pages.len()
+    }
+
+    /// Returns `true` if page `i` only contains nulls.
+    pub fn is_null_page(&self, i: usize) -> bool {
+        self.null_pages[i]
+    }
+
+    /// Returns the number of nulls in page `i`, if known.
+    pub fn null_count(&self, i: usize) -> Option<i64> {
+        self.null_counts.as_ref().map(|counts| counts[i])
+    }
+
+    /// Returns the statistics of page `i` of a column of `physical_type`.
+    pub fn page_statistics(&self, physical_type: Type, i: usize) -> Option<Statistics> {
+        let (min, max) = if self.null_pages[i] {
+            (None, None)
+        } else {
+            (
+                Some(self.min_values[i].clone()),
+                Some(self.max_values[i].clone()),
+            )
+        };
+        let thrift_stats = TStatistics {
+            max: None,
+            min: None,
+            null_count: self.null_count(i),
+            distinct_count: None,
+            max_value: max,
+            min_value: min,
+        };
+        statistics::from_thrift(physical_type, Some(thrift_stats))
+    }
+
+    /// Method to convert from Thrift.
+    pub fn from_thrift(column_index: TColumnIndex) -> Result<Self> {
+        let num_pages = column_index.null_pages.len();
+        if column_index.min_values.len() != num_pages
+            || column_index.max_values.len() != num_pages
+            || column_index
+                .null_counts
+                .as_ref()
+                .map_or(false, |counts| counts.len() != num_pages)
+        {
+            return Err(general_err!("Inconsistent number of pages in column index"));
+        }
+        Ok(Self {
+            null_pages: column_index.null_pages,
+            min_values: column_index.min_values,
+            max_values: column_index.max_values,
+            null_counts: column_index.null_counts,
+        })
+    }
+
+    /// Method to convert to Thrift.
+    pub fn to_thrift(&self) -> TColumnIndex {
+        TColumnIndex {
+            null_pages: self.null_pages.clone(),
+            min_values: self.min_values.clone(),
+            max_values: self.max_values.clone(),
+            boundary_order: BoundaryOrder::Unordered,
+            null_counts: self.null_counts.clone(),
+        }
+    }
+}
+
+/// The page index of a column chunk.
+///
+/// The column index is optional, as it can only be built from page statistics.
+#[derive(Debug, Clone, PartialEq)]
+pub struct PageIndex {
+    column_index: Option<ColumnIndex>,
+    offset_index: OffsetIndex,
+}
+
+impl PageIndex {
+    /// Creates a page index, returns an error if the column index and the offset
+    /// index do not have the same number of pages.
+    pub fn new(
+        column_index: Option<ColumnIndex>,
+        offset_index: OffsetIndex,
+    ) -> Result<Self> {
+        if let Some(ref column_index) = column_index {
+            if column_index.num_pages() != offset_index.num_pages() {
+                return Err(general_err!(
+                    "Column index has {} pages, offset index has {} pages",
+                    column_index.num_pages(),
+                    offset_index.num_pages()
+                ));
+            }
+        }
+        Ok(Self {
+            column_index,
+            offset_index,
+        })
+    }
+
+    /// Returns the column index, if any.
+    pub fn column_index(&self) -> Option<&ColumnIndex> {
+        self.column_index.as_ref()
+    }
+
+    /// Returns the offset index.
+    pub fn offset_index(&self) -> &OffsetIndex {
+        &self.offset_index
+    }
+
+    /// Shifts all page offsets by `offset` bytes.
+    pub(crate) fn shift_offsets(&mut self, offset: i64) {
+        self.offset_index.shift_offsets(offset);
+    }
+}
+
+/// Reads the page index of `column` from `chunk_reader`, returns `None` if the column
+/// chunk has no offset index.
+pub fn read_page_index<R: ChunkReader>(
+    chunk_reader: &R,
+    column: &ColumnChunkMetaData,
+) -> Result<Option<PageIndex>> {
+    let (offset, length) = match column.offset_index_range() {
+        Some(range) => range,
+        None => return Ok(None),
+    };
+    let offset_index = {
+        let mut prot = TCompactInputProtocol::new(chunk_reader.get_read(offset, length)?);
+        OffsetIndex::from_thrift(TOffsetIndex::read_from_in_protocol(&mut prot)?)
+    };
+    let column_index = match column.column_index_range() {
+        Some((offset, length)) => {
+            let mut prot =
+                TCompactInputProtocol::new(chunk_reader.get_read(offset, length)?);
+            Some(ColumnIndex::from_thrift(
+                TColumnIndex::read_from_in_protocol(&mut prot)?,
+            )?)
+        }
+        None => None,
+    };
+    PageIndex::new(column_index, offset_index).map(Some)
+}
+
+/// Collects the page index of a column chunk while its data pages are written.
+///
+/// Pages are added when they are encoded, and located when they are written, in the
+/// same order; pages may be buffered in between.
+pub(crate) struct PageIndexBuilder {
+    null_pages: Vec<bool>,
+    min_values: Vec<Vec<u8>>,
+    max_values: Vec<Vec<u8>>,
+    null_counts: Vec<i64>,
+    // Unset once a page without statistics is added
+    column_index_valid: bool,
+    page_locations: Vec<PageLocation>,
+    // First rows of the pages added, but not located yet
+    pending_first_rows: VecDeque<i64>,
+}
+
+impl PageIndexBuilder {
+    pub(crate) fn new() -> Self {
+        Self {
+            null_pages: vec![],
+            min_values: vec![],
+            max_values: vec![],
+            null_counts: vec![],
+            column_index_valid: true,
+            page_locations: vec![],
+            pending_first_rows: VecDeque::new(),
+        }
+    }
+
+    /// Adds an encoded data page, starting at row `first_row_index` of the row group.
+    pub(crate) fn add_page(
+        &mut self,
+        statistics: Option<&Statistics>,
+        first_row_index: u64,
+    ) {
+        self.pending_first_rows.push_back(first_row_index as i64);
+        match statistics {
+            Some(stats) if stats.has_min_max_set() => {
+                self.null_pages.push(false);
+                self.min_values.push(stats.min_bytes().to_vec());
+                self.max_values.push(stats.max_bytes().to_vec());
+                self.null_counts.push(stats.null_count() as i64);
+            }
+            Some(stats) => {
+                self.null_pages.push(true);
+                self.min_values.push(vec![]);
+                self.max_values.push(vec![]);
+                self.null_counts.push(stats.null_count() as i64);
+            }
+            None => self.column_index_valid = false,
+        }
+    }
+
+    /// Locates the oldest data page added that has not been located yet.
+    pub(crate) fn add_page_location(
+        &mut self,
+        offset: u64,
+        compressed_page_size: u64,
+    ) -> Result<()> {
+        let first_row_index = self
+            .pending_first_rows
+            .pop_front()
+            .ok_or_else(|| general_err!("Data page written before it was added"))?;
+        self.page_locations.push(PageLocation {
+            offset: offset as i64,
+            compressed_page_size: compressed_page_size as i32,
+            first_row_index,
+        });
+        Ok(())
+    }
+
+    /// Builds the page index, or returns `None` if no data page has been written.
+    pub(crate) fn build(self) -> Result<Option<PageIndex>> {
+        if !self.pending_first_rows.is_empty() {
+            return Err(general_err!(
+                "{} data pages have not been written",
+                self.pending_first_rows.len()
+            ));
+        }
+        if self.page_locations.is_empty() {
+            return Ok(None);
+        }
+        let column_index = if self.column_index_valid {
+            Some(ColumnIndex {
+                null_pages: self.null_pages,
+                min_values: self.min_values,
+                max_values: self.max_values,
+                null_counts: Some(self.null_counts),
+            })
+        } else {
+            None
+        };
+        PageIndex::new(column_index, OffsetIndex::new(self.page_locations)).map(Some)
+    }
+}
+
+/// A set of rows of a row group, as sorted, disjoint and non adjacent ranges.
+#[derive(Debug, Clone, Default, PartialEq)]
+pub struct RowRanges {
+    ranges: Vec<Range<usize>>,
+}
+
+impl RowRanges {
+    /// Returns the set of all `num_rows` rows.
+    pub fn all(num_rows: usize) -> Self {
+        let mut rows = Self::default();
+        rows.push(0..num_rows);
+        rows
+    }
+
+    /// Adds `range` to this set, panics if it starts before the last range added.
+    pub fn push(&mut self, range: Range<usize>) {
+        if range.start >= range.end {
+            return;
+        }
+        match self.ranges.last_mut() {
+            Some(last) if range.start <= last.end => {
+                assert!(range.start >= last.start, "Row ranges must be sorted");
+                last.end = cmp::max(last.end, range.end);
+            }
+            _ => self.ranges.push(range),
+        }
+    }
+
+    /// Returns the ranges of this set.
+    pub fn ranges(&self) -> &[Range<usize>] {
+        &self.ranges
+    }
+
+    /// Returns the number of rows in this set.
+    pub fn row_count(&self) -> usize {
+        self.ranges
+            .iter()
+            .map(|range| range.end - range.start)
+            .sum()
+    }
+
+    /// Returns `true` if this set has no rows.
+    pub fn is_empty(&self) -> bool {
+        self.ranges.is_empty()
+    }
+
+    /// Returns `true` if any row of `range` is in this set.
+    pub fn intersects(&self, range: &Range<usize>) -> bool {
+        self.ranges
+            .iter()
+            .any(|r| r.start < range.end && range.start < r.end)
+    }
+
+    /// Returns the rows that are in this set or in `other`.
+    pub fn union(&self, other: &RowRanges) -> RowRanges {
+        let mut result = RowRanges::default();
+        let (mut left, mut right) = (
+            self.ranges.iter().peekable(),
+            other.ranges.iter().peekable(),
+        );
+        loop {
+            let next = match (left.peek(), right.peek()) {
+                (Some(l), Some(r)) if l.start <= r.start => left.next(),
+                (Some(_), Some(_)) => right.next(),
+                (Some(_), None) => left.next(),
+                (None, Some(_)) => right.next(),
+                (None, None) => break,
+            };
+            result.push(next.unwrap().clone());
+        }
+        result
+    }
+
+    /// Returns the rows that are both in this set and in `other`.
+    pub fn intersection(&self, other: &RowRanges) -> RowRanges {
+        let mut result = RowRanges::default();
+        let (mut i, mut j) = (0, 0);
+        while i < self.ranges.len() && j < other.ranges.len() {
+            let (l, r) = (&self.ranges[i], &other.ranges[j]);
+            result.push(cmp::max(l.start, r.start)..cmp::min(l.end, r.end));
+            if l.end < r.end {
+                i += 1;
+            } else {
+                j += 1;
+            }
+        }
+        result
+    }
+
+    /// Returns the smallest superset of this set that, for each of `offset_indexes`,
+    /// only consists of whole pages.
+    ///
+    /// Columns of a row group place their page boundaries at different rows; reading
+    /// the pages of such a set from every column yields the same rows.
+    pub fn align_to_pages(
+        &self,
+        offset_indexes: &[&OffsetIndex],
+        num_rows: usize,
+    ) -> RowRanges {
+        let mut rows = self.clone();
+        loop {
+            let aligned =
+                offset_indexes
+                    .iter()
+                    .fold(rows.clone(), |aligned, offset_index| {
+                        aligned.union(&offset_index.covering_rows(&rows, num_rows))
+                    });
+            if aligned == rows {
+                return rows;
+            }
+            rows = aligned;
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    fn offset_index(first_rows: &[i64]) -> OffsetIndex {
+        OffsetIndex::new(
+            first_rows
+                .iter()
+                .map(|first_row_index| PageLocation {
+                    offset: 100 * first_row_index,
+                    compressed_page_size: 10,
+                    first_row_index: *first_row_index,
+                })
+                .collect(),
+        )
+    }
+
+    fn row_ranges(ranges: &[Range<usize>]) -> RowRanges {
+        let mut rows = RowRanges::default();
+        for range in ranges {
+            rows.push(range.clone());
+        }
+        rows
+    }
+
+    #[test]
+    fn test_row_ranges() {
+        let rows = row_ranges(&[0..10, 10..20, 15..18, 30..40, 50..50]);
+        assert_eq!(rows.ranges(), &[0..20, 30..40]);
+        assert_eq!(rows.row_count(), 30);
+        assert!(rows.intersects(&(19..25)));
+        assert!(!rows.intersects(&(20..30)));
+        assert!(rows.intersects(&(25..35)));
+        assert!(!rows.intersects(&(40..100)));
+        assert!(RowRanges::default().is_empty());
+
+        let other = row_ranges(&[5..12, 25..31, 45..60]);
+        assert_eq!(rows.union(&other).ranges(), &[0..20, 25..40, 45..60]);
+        assert_eq!(rows.intersection(&other).ranges(), &[5..12, 30..31]);
+        assert!(rows.intersection(&RowRanges::default()).is_empty());
+    }
+
+    #[test]
+    fn test_align_to_pages() {
+        // pages of a: 0..10, 10..20, 20..30, 30..40
+        let a = offset_index(&[0, 10, 20, 30]);
+        // pages of b: 0..15, 15..25, 25..40
+        let b = offset_index(&[0, 15, 25]);
+
+        assert_eq!(a.selected_pages(&row_ranges(&[12..13]), 40), vec![1]);
+        assert_eq!(
+            row_ranges(&[12..13]).align_to_pages(&[&a], 40).ranges(),
+            &[10..20]
+        );
+        // 12 is in a's page 10..20 and in b's page 0..15, which brings in a's page
+        // 0..10, and 15..20 brings in b's page 15..25 and a's page 20..30, and so on
+        assert_eq!(
+            row_ranges(&[12..13]).align_to_pages(&[&a, &b], 40).ranges(),
+            &[0..40]
+        );
+        assert_eq!(
+            row_ranges(&[3..4]).align_to_pages(&[&a, &b], 40).ranges(),
+            &[0..15]
+        );
+        assert!(RowRanges::default()
+            .align_to_pages(&[&a, &b], 40)
+            .is_empty());
+    }
+
+    #[test]
+    fn test_page_index_builder() {
+        let mut builder = PageIndexBuilder::new();
+        builder.add_page(
+            Some(&Statistics::int32(Some(1), Some(5), None, 2, false)),
+            0,
+        );
+        builder.add_page(Some(&Statistics::int32(None, None, None, 10, false)), 10);
+        builder.add_page_location(4, 50).unwrap();
+        builder.add_page_location(54, 20).unwrap();
+        assert!(builder.add_page_location(74, 20).is_err());
+
+        let mut page_index = builder.build().unwrap().unwrap();
+        page_index.shift_offsets(100);
+        assert_eq!(
+            page_index.offset_index().page_locations(),
+            &[
+                PageLocation {
+                    offset: 104,
+                    compressed_page_size: 50,
+                    first_row_index: 0
+                },
+                PageLocation {
+                    offset: 154,
+                    compressed_page_size: 20,
+                    first_row_index: 10
+                }
+            ]
+        );
+        assert_eq!(page_index.offset_index().page_rows(1, 15), 10..15);
+
+        let column_index = page_index.column_index().unwrap();
+        assert!(!column_index.is_null_page(0));
+        assert!(column_index.is_null_page(1));
+        assert_eq!(column_index.null_count(1), Some(10));
+        assert_eq!(
+            column_index.page_statistics(Type::INT32, 0),
+            Some(Statistics::int32(Some(1), Some(5), None, 2, false))
+        );
+
+        let roundtrip = PageIndex::new(
+            Some(ColumnIndex::from_thrift(column_index.to_thrift()).unwrap()),
+            OffsetIndex::from_thrift(page_index.offset_index().to_thrift()),
+        )
+        .unwrap();
+        assert_eq!(roundtrip, page_index);
+    }
+
+    #[test]
+    fn test_page_index_builder_without_statistics() {
+        let mut builder = PageIndexBuilder::new();
+        builder.add_page(None, 0);
+        builder.add_page_location(4, 50).unwrap();
+        let page_index = builder.build().unwrap().unwrap();
+        assert!(page_index.column_index().is_none());
+        assert_eq!(page_index.offset_index().num_pages(), 1);
+
+        assert!(PageIndexBuilder::new().build().unwrap().is_none());
+
+        let mut builder = PageIndexBuilder::new();
+        builder.add_page(None, 0);
+        assert!(builder.build().is_err());
+    }
+}
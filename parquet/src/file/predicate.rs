@@ -0,0 +1,771 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Contains predicates over the leaf columns of a Parquet file, which are evaluated
+//! against column chunk [`Statistics`] to skip row groups that cannot contain any
+//! matching row.
+//!
+//! ```rust
+//! use parquet::file::predicate::Predicate;
+//!
+//! // ts >= 1000 AND (id IN (1, 2, 3) OR name IS NULL)
+//! let predicate = Predicate::gt_eq("ts", 1000_i64).and(
+//!     Predicate::in_list("id", vec![1, 2, 3]).or(Predicate::is_null("name")),
+//! );
+//! ```
+//!
+//! Evaluation is conservative: a row group is only skipped when its statistics
+//! prove that the predicate is false for every row. When the page index of a row
+//! group has been loaded, [`Predicate::matching_rows`] narrows this down to the pages
+//! that can contain matching rows, and when the Bloom filters of a row group have
+//! been loaded, equality and `IN` predicates also skip row groups whose Bloom filter
+//! does not contain any of the values. Columns are compared using the
+//! sort order of their logical type. Row groups are never skipped based on
+//! statistics of columns with an undefined sort order, or on deprecated min/max
+//! statistics of columns without a signed sort order.
+
+use std::cmp::Ordering;
+
+use crate::basic::{ColumnOrder, SortOrder, Type};
+use crate::data_type::ByteArray;
+use crate::errors::{ParquetError, Result};
+use crate::file::metadata::{ColumnChunkMetaData, RowGroupMetaData};
+use crate::file::page_index::{ColumnIndex, RowRanges};
+use crate::file::statistics::Statistics;
+use crate::schema::types::ColumnDescriptor;
+
+/// A literal value compared with the values of a column.
+///
+/// Literals are compared with columns of the matching physical type; for unsigned
+/// integer columns `Int32` and `Int64` hold the bits of the unsigned value.
+#[derive(Debug, Clone, PartialEq)]
+pub enum Literal {
+    Boolean(bool),
+    Int32(i32),
+    Int64(i64),
+    Float(f32),
+    Double(f64),
+    /// Compared with `BYTE_ARRAY` and `FIXED_LEN_BYTE_ARRAY` columns
+    ByteArray(ByteArray),
+}
+
+impl From<bool> for Literal {
+    fn from(value: bool) -> Self {
+        Literal::Boolean(value)
+    }
+}
+
+impl From<i32> for Literal {
+    fn from(value: i32) -> Self {
+        Literal::Int32(value)
+    }
+}
+
+impl From<i64> for Literal {
+    fn from(value: i64) -> Self {
+        Literal::Int64(value)
+    }
+}
+
+impl From<f32> for Literal {
+    fn from(value: f32) -> Self {
+        Literal::Float(value)
+    }
+}
+
+impl From<f64> for Literal {
+    fn from(value: f64) -> Self {
+        Literal::Double(value)
+    }
+}
+
+impl<'a> From<&'a str> for Literal {
+    fn from(value: &'a str) -> Self {
+        Literal::ByteArray(value.into())
+    }
+}
+
+impl From<String> for Literal {
+    fn from(value: String) -> Self {
+        Literal::ByteArray(value.into_bytes().into())
+    }
+}
+
+impl From<Vec<u8>> for Literal {
+    fn from(value: Vec<u8>) -> Self {
+        Literal::ByteArray(value.into())
+    }
+}
+
+impl From<ByteArray> for Literal {
+    fn from(value: ByteArray) -> Self {
+        Literal::ByteArray(value)
+    }
+}
+
+/// Comparison operators of [`Predicate::Compare`].
+#[derive(Debug, Clone, Copy, PartialEq, Eq)]
+pub enum CompareOp {
+    Eq,
+    NotEq,
+    Lt,
+    LtEq,
+    Gt,
+    GtEq,
+}
+
+/// A boolean expression over the leaf columns of a Parquet file.
+///
+/// Columns are identified by their dot separated path, e.g. `a.b.c`. As in SQL, a
+/// comparison or `In` is never true for a null value.
+#[derive(Debug, Clone)]
+pub enum Predicate {
+    /// `column op value`
+    Compare {
+        column: String,
+        op: CompareOp,
+        value: Literal,
+    },
+    /// `column IN (values)`
+    In {
+        column: String,
+        values: Vec<Literal>,
+    },
+    /// `column IS NULL`
+    IsNull(String),
+    /// `column IS NOT NULL`
+    IsNotNull(String),
+    And(Box<Predicate>, Box<Predicate>),
+    Or(Box<Predicate>, Box<Predicate>),
+}
+
+macro_rules! compare_func {
+    ($func:ident, $op:ident, $doc:expr) => {
+        #[doc = $doc]
+        pub fn $func<C: Into<String>, V: Into<Literal>>(column: C, value: V) -> Self {
+            Predicate::Compare {
+                column: column.into(),
+                op: CompareOp::$op,
+                value: value.into(),
+            }
+        }
+    };
+}
+
+impl Predicate {
+    compare_func![eq, Eq, "Returns the predicate `column = value`."];
+
+    compare_func![not_eq, NotEq, "Returns the predicate `column != value`."];
+
+    compare_func![lt, Lt, "Returns the predicate `column < value`."];
+
+    compare_func![lt_eq, LtEq, "Returns the predicate `column <= value`."];
+
+    compare_func![gt, Gt, "Returns the predicate `column > value`."];
+
+    compare_func![gt_eq, GtEq, "Returns the predicate `column >= value`."];
+
+    /// Returns the predicate `column IN (values)`.
+    pub fn in_list<C, I>(column: C, values: I) -> Self
+    where
+        C: Into<String>,
+        I: IntoIterator,
+        I::Item: Into<Literal>,
+    {
+        Predicate::In {
+            column: column.into(),
+            values: values.into_iter().map(|v| v.into()).collect(),
+        }
+    }
+
+    /// Returns the predicate `column IS NULL`.
+    pub fn is_null<C: Into<String>>(column: C) -> Self {
+        Predicate::IsNull(column.into())
+    }
+
+    /// Returns the predicate `column IS NOT NULL`.
+    pub fn is_not_null<C: Into<String>>(column: C) -> Self {
+        Predicate::IsNotNull(column.into())
+    }
+
+    /// Returns the conjunction of this predicate and `other`.
+    pub fn and(self, other: Predicate) -> Self {
+        Predicate::And(Box::new(self), Box::new(other))
+    }
+
+    /// Returns the disjunction of this predicate and `other`.
+    pub fn or(self, other: Predicate) -> Self {
+        Predicate::Or(Box::new(self), Box::new(other))
+    }
+
+    /// Returns `false` if the column chunk statistics or Bloom filters of `row_group`
+    /// prove that no row of it satisfies this predicate, and `true` otherwise.
+    ///
+    /// Returns an error if the predicate refers to a column that is not a leaf
+    /// column of the row group's schema.
+    pub fn can_match(&self, row_group: &RowGroupMetaData) -> Result<bool> {
+        match self {
+            Predicate::Compare { column, op, value } => {
+                let column = find_column(row_group, column)?;
+                Ok(compare_can_match(
+                    column.column_descr(),
+                    column.statistics(),
+                    column.num_values(),
+                    *op,
+                    value,
+                ) && (*op != CompareOp::Eq || bloom_filter_can_match(column, value)))
+            }
+            Predicate::In { column, values } => {
+                let column = find_column(row_group, column)?;
+                Ok(values.iter().any(|value| {
+                    compare_can_match(
+                        column.column_descr(),
+                        column.statistics(),
+                        column.num_values(),
+                        CompareOp::Eq,
+                        value,
+                    ) && bloom_filter_can_match(column, value)
+                }))
+            }
+            Predicate::IsNull(column) => {
+                let column = find_column(row_group, column)?;
+                // a null count that is not recorded is read as 0
+                Ok(column.statistics().map_or(true, |stats| {
+                    !stats.has_null_count_set() || stats.null_count() > 0
+                }))
+            }
+            Predicate::IsNotNull(column) => {
+                let column = find_column(row_group, column)?;
+                Ok(!all_null(column.statistics(), column.num_values()))
+            }
+            // both sides are evaluated, so that unknown columns are always reported
+            Predicate::And(left, right) => {
+                let left = left.can_match(row_group)?;
+                Ok(right.can_match(row_group)? && left)
+            }
+            Predicate::Or(left, right) => {
+                let left = left.can_match(row_group)?;
+                Ok(right.can_match(row_group)? || left)
+            }
+        }
+    }
+
+    /// Returns the rows of `row_group` that can satisfy this predicate.
+    ///
+    /// Rows are excluded by page when the column index of a column is part of its
+    /// loaded page index, and by row group otherwise. Returns an error if the
+    /// predicate refers to a column that is not a leaf column of the row group's
+    /// schema.
+    pub fn matching_rows(&self, row_group: &RowGroupMetaData) -> Result<RowRanges> {
+        let num_rows = row_group.num_rows() as usize;
+        let column = match self {
+            Predicate::And(left, right) => {
+                let left = left.matching_rows(row_group)?;
+                return Ok(left.intersection(&right.matching_rows(row_group)?));
+            }
+            Predicate::Or(left, right) => {
+                let left = left.matching_rows(row_group)?;
+                return Ok(left.union(&right.matching_rows(row_group)?));
+            }
+            Predicate::Compare { column, .. }
+            | Predicate::In { column, .. }
+            | Predicate::IsNull(column)
+            | Predicate::IsNotNull(column) => find_column(row_group, column)?,
+        };
+
+        if !self.can_match(row_group)? {
+            return Ok(RowRanges::default());
+        }
+        let page_index = match column.page_index() {
+            Some(page_index) if column.column_descr().max_rep_level() == 0 => page_index,
+            _ => return Ok(RowRanges::all(num_rows)),
+        };
+        let column_index = match page_index.column_index() {
+            Some(column_index) => column_index,
+            None => return Ok(RowRanges::all(num_rows)),
+        };
+
+        let offset_index = page_index.offset_index();
+        let mut rows = RowRanges::default();
+        for i in 0..offset_index.num_pages() {
+            let page_rows = offset_index.page_rows(i, num_rows);
+            let num_values = (page_rows.end - page_rows.start) as i64;
+            if self.page_can_match(column.column_descr(), column_index, i, num_values) {
+                rows.push(page_rows);
+            }
+        }
+        Ok(rows)
+    }
+
+    /// Returns `false` if the statistics of page `i` in `column_index` prove that no
+    /// value of it satisfies this leaf predicate, and `true` otherwise.
+    fn page_can_match(
+        &self,
+        descr: &ColumnDescriptor,
+        column_index: &ColumnIndex,
+        i: usize,
+        num_values: i64,
+    ) -> bool {
+        if column_index.is_null_page(i) {
+            return matches!(self, Predicate::IsNull(_));
+        }
+        let stats = column_index.page_statistics(descr.physical_type(), i);
+        match self {
+            Predicate::Compare { op, value, .. } => {
+                compare_can_match(descr, stats.as_ref(), num_values, *op, value)
+            }
+            Predicate::In { values, .. } => values.iter().any(|value| {
+                compare_can_match(descr, stats.as_ref(), num_values, CompareOp::Eq, value)
+            }),
+            // pages without null counts may contain nulls
+            Predicate::IsNull(_) => column_index.null_count(i).map_or(true, |n| n > 0),
+            Predicate::IsNotNull(_) | Predicate::And(..) | Predicate::Or(..) => true,
+        }
+    }
+}
+
+fn find_column<'a>(
+    row_group: &'a RowGroupMetaData,
+    column: &str,
+) -> Result<&'a ColumnChunkMetaData> {
+    row_group
+        .columns()
+        .iter()
+        .find(|c| c.column_path().string() == column)
+        .ok_or_else(|| general_err!("Column {} not found in schema", column))
+}
+
+/// Returns `true` if `statistics` of `num_values` values show that all of them are
+/// null.
+fn all_null(statistics: Option<&Statistics>, num_values: i64) -> bool {
+    statistics.map_or(false, |stats| stats.null_count() as i64 == num_values)
+}
+
+/// Returns `false` if the Bloom filter of `column` proves that none of its values
+/// equals `value`, and `true` otherwise.
+fn bloom_filter_can_match(column: &ColumnChunkMetaData, value: &Literal) -> bool {
+    let bloom_filter = match column.bloom_filter() {
+        Some(bloom_filter) => bloom_filter,
+        None => return true,
+    };
+    // values are hashed by their plain encoding, so literals of another type cannot
+    // be looked up; zeros of both signs are equal, but do not have the same encoding
+    match (column.column_type(), value) {
+        (Type::BOOLEAN, Literal::Boolean(v)) => bloom_filter.check(v),
+        (Type::INT32, Literal::Int32(v)) => bloom_filter.check(v),
+        (Type::INT64, Literal::Int64(v)) => bloom_filter.check(v),
+        (Type::FLOAT, Literal::Float(v)) if *v != 0.0 => bloom_filter.check(v),
+        (Type::DOUBLE, Literal::Double(v)) if *v != 0.0 => bloom_filter.check(v),
+        (Type::BYTE_ARRAY, Literal::ByteArray(v))
+        | (Type::FIXED_LEN_BYTE_ARRAY, Literal::ByteArray(v)) => bloom_filter.check(v),
+        _ => true,
+    }
+}
+
+fn compare_can_match(
+    descr: &ColumnDescriptor,
+    statistics: Option<&Statistics>,
+    num_values: i64,
+    op: CompareOp,
+    value: &Literal,
+) -> bool {
+    let stats = match statistics {
+        Some(stats) => stats,
+        None => return true,
+    };
+    if !stats.has_min_max_set() {
+        // no comparison is true for a null
+        return !all_null(statistics, num_values);
+    }
+    // how `value` compares with the smallest and the largest value of the column
+    let (vs_min, vs_max) = match compare_with_bounds(descr, stats, value) {
+        Some(bounds) => bounds,
+        None => return true,
+    };
+    match op {
+        CompareOp::Eq => vs_min != Ordering::Less && vs_max != Ordering::Greater,
+        CompareOp::NotEq => vs_min != Ordering::Equal || vs_max != Ordering::Equal,
+        CompareOp::Lt => vs_min == Ordering::Greater,
+        CompareOp::LtEq => vs_min != Ordering::Less,
+        CompareOp::Gt => vs_max == Ordering::Less,
+        CompareOp::GtEq => vs_max != Ordering::Greater,
+    }
+}
+
+/// Compares `value` with the min and max values of `stats`, or returns `None` if
+/// they cannot be compared.
+fn compare_with_bounds(
+    descr: &ColumnDescriptor,
+    stats: &Statistics,
+    value: &Literal,
+) -> Option<(Ordering, Ordering)> {
+    let sort_order = ColumnOrder::get_sort_order(
+        descr.logical_type(),
+        descr.converted_type(),
+        descr.physical_type(),
+    );
+    // deprecated min/max statistics were computed with signed comparisons
+    if stats.is_min_max_deprecated() && sort_order != SortOrder::SIGNED {
+        return None;
+    }
+
+    match (stats, value, sort_order) {
+        (Statistics::Boolean(s), Literal::Boolean(v), _) => {
+            compare_values(v, s.min(), s.max())
+        }
+        (Statistics::Int32(s), Literal::Int32(v), SortOrder::SIGNED) => {
+            compare_values(v, s.min(), s.max())
+        }
+        (Statistics::Int32(s), Literal::Int32(v), SortOrder::UNSIGNED) => {
+            compare_values(&(*v as u32), &(*s.min() as u32), &(*s.max() as u32))
+        }
+        (Statistics::Int64(s), Literal::Int64(v), SortOrder::SIGNED) => {
+            compare_values(v, s.min(), s.max())
+        }
+        (Statistics::Int64(s), Literal::Int64(v), SortOrder::UNSIGNED) => {
+            compare_values(&(*v as u64), &(*s.min() as u64), &(*s.max() as u64))
+        }
+        (Statistics::Float(s), Literal::Float(v), SortOrder::SIGNED) => {
+            compare_values(v, s.min(), s.max())
+        }
+        (Statistics::Double(s), Literal::Double(v), SortOrder::SIGNED) => {
+            compare_values(v, s.min(), s.max())
+        }
+        (Statistics::ByteArray(s), Literal::ByteArray(v), SortOrder::UNSIGNED) => {
+            compare_values(v.data(), s.min_bytes(), s.max_bytes())
+        }
+        (
+            Statistics::FixedLenByteArray(s),
+            Literal::ByteArray(v),
+            SortOrder::UNSIGNED,
+        ) => compare_values(v.data(), s.min_bytes(), s.max_bytes()),
+        _ => None,
+    }
+}
+
+fn compare_values<T: PartialOrd + ?Sized>(
+    value: &T,
+    min: &T,
+    max: &T,
+) -> Option<(Ordering, Ordering)> {
+    Some((value.partial_cmp(min)?, value.partial_cmp(max)?))
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use std::{ops::Range, sync::Arc};
+
+    use crate::file::{bloom_filter::Sbbf, page_index::PageIndexBuilder, statistics};
+    use crate::schema::{parser::parse_message_type, types::SchemaDescriptor};
+
+    fn test_row_group(statistics: Vec<Option<Statistics>>) -> RowGroupMetaData {
+        let message_type = "
+            message test_schema {
+                OPTIONAL INT32 a;
+                OPTIONAL INT32 b (UINT_32);
+                OPTIONAL BYTE_ARRAY c (UTF8);
+                OPTIONAL DOUBLE d;
+                OPTIONAL INT96 e;
+            }
+        ";
+        let schema = parse_message_type(message_type).unwrap();
+        let schema_descr = Arc::new(SchemaDescriptor::new(Arc::new(schema)));
+        let columns = schema_descr
+            .columns()
+            .iter()
+            .zip(statistics)
+            .map(|(descr, stats)| {
+                let builder =
+                    ColumnChunkMetaData::builder(descr.clone()).set_num_values(100);
+                let builder = match stats {
+                    Some(stats) => builder.set_statistics(stats),
+                    None => builder,
+                };
+                builder.build().unwrap()
+            })
+            .collect();
+        RowGroupMetaData::builder(schema_descr)
+            .set_num_rows(100)
+            .set_column_metadata(columns)
+            .build()
+            .unwrap()
+    }
+
+    fn default_row_group() -> RowGroupMetaData {
+        test_row_group(vec![
+            Some(Statistics::int32(Some(10), Some(20), None, 0, false)),
+            Some(Statistics::int32(Some(5), Some(-5), None, 0, false)),
+            Some(Statistics::byte_array(
+                Some("bar".into()),
+                Some("foo".into()),
+                None,
+                3,
+                false,
+            )),
+            Some(Statistics::double(None, None, None, 100, false)),
+            None,
+        ])
+    }
+
+    fn can_match(predicate: Predicate) -> bool {
+        predicate.can_match(&default_row_group()).unwrap()
+    }
+
+    #[test]
+    fn test_compare() {
+        assert!(!can_match(Predicate::eq("a", 9)));
+        assert!(can_match(Predicate::eq("a", 10)));
+        assert!(can_match(Predicate::eq("a", 20)));
+        assert!(!can_match(Predicate::eq("a", 21)));
+
+        assert!(can_match(Predicate::not_eq("a", 10)));
+        assert!(!can_match(Predicate::lt("a", 10)));
+        assert!(can_match(Predicate::lt("a", 11)));
+        assert!(!can_match(Predicate::lt_eq("a", 9)));
+        assert!(can_match(Predicate::lt_eq("a", 10)));
+        assert!(!can_match(Predicate::gt("a", 20)));
+        assert!(can_match(Predicate::gt("a", 19)));
+        assert!(!can_match(Predicate::gt_eq("a", 21)));
+        assert!(can_match(Predicate::gt_eq("a", 20)));
+
+        let single_value = test_row_group(vec![
+            Some(Statistics::int32(Some(7), Some(7), None, 0, false)),
+            None,
+            None,
+            None,
+            None,
+        ]);
+        assert!(!Predicate::not_eq("a", 7).can_match(&single_value).unwrap());
+        assert!(Predicate::not_eq("a", 8).can_match(&single_value).unwrap());
+    }
+
+    #[test]
+    fn test_compare_sort_orders() {
+        // as unsigned values, 5 <= b <= 4294967291
+        assert!(!can_match(Predicate::eq("b", 4)));
+        assert!(can_match(Predicate::eq("b", 6)));
+        assert!(can_match(Predicate::eq("b", -6)));
+        assert!(!can_match(Predicate::eq("b", -4)));
+
+        // byte arrays compare as unsigned bytes
+        assert!(can_match(Predicate::eq("c", "baz")));
+        assert!(!can_match(Predicate::eq("c", "fop")));
+        assert!(!can_match(Predicate::lt("c", "bar")));
+        assert!(!can_match(Predicate::gt("c", "foo")));
+
+        // deprecated statistics of byte arrays are ignored
+        let deprecated = test_row_group(vec![
+            None,
+            None,
+            Some(Statistics::byte_array(
+                Some("bar".into()),
+                Some("foo".into()),
+                None,
+                0,
+                true,
+            )),
+            None,
+            None,
+        ]);
+        assert!(Predicate::eq("c", "zzz").can_match(&deprecated).unwrap());
+    }
+
+    #[test]
+    fn test_compare_without_statistics() {
+        // d only contains nulls
+        assert!(!can_match(Predicate::eq("d", 1.0)));
+        assert!(!can_match(Predicate::is_not_null("d")));
+        assert!(can_match(Predicate::is_null("d")));
+
+        // e has no statistics
+        assert!(can_match(Predicate::gt("e", 1)));
+        assert!(can_match(Predicate::is_null("e")));
+        assert!(can_match(Predicate::is_not_null("e")));
+
+        // mismatched literal types never prune
+        assert!(can_match(Predicate::eq("a", 100_i64)));
+        assert!(can_match(Predicate::eq("a", "foo")));
+    }
+
+    #[test]
+    fn test_is_null() {
+        assert!(!can_match(Predicate::is_null("a")));
+        assert!(can_match(Predicate::is_not_null("a")));
+        assert!(can_match(Predicate::is_null("c")));
+        assert!(can_match(Predicate::is_not_null("c")));
+    }
+
+    #[test]
+    fn test_is_null_without_null_count() {
+        // other writers may record min and max, but not the null count
+        let thrift_stats = parquet_format::Statistics {
+            max: None,
+            min: None,
+            null_count: None,
+            distinct_count: None,
+            max_value: Some(20_i32.to_le_bytes().to_vec()),
+            min_value: Some(10_i32.to_le_bytes().to_vec()),
+        };
+        let stats = statistics::from_thrift(Type::INT32, Some(thrift_stats));
+        let row_group = test_row_group(vec![stats, None, None, None, None]);
+        let can_match = |predicate: Predicate| predicate.can_match(&row_group).unwrap();
+        assert!(can_match(Predicate::is_null("a")));
+        assert!(can_match(Predicate::is_not_null("a")));
+        assert!(!can_match(Predicate::gt("a", 20)));
+    }
+
+    #[test]
+    fn test_in_and_or() {
+        assert!(!can_match(Predicate::in_list("a", vec![1, 2, 30])));
+        assert!(can_match(Predicate::in_list("a", vec![1, 15, 30])));
+        assert!(!can_match(Predicate::in_list("a", Vec::<i32>::new())));
+
+        let in_range = Predicate::gt("a", 15);
+        let out_of_range = Predicate::lt("a", 5);
+        assert!(!can_match(in_range.clone().and(out_of_range.clone())));
+        assert!(can_match(in_range.clone().or(out_of_range.clone())));
+        assert!(!can_match(out_of_range.clone().or(Predicate::is_null("a"))));
+        assert!(can_match(out_of_range.or(Predicate::is_null("c"))));
+    }
+
+    #[test]
+    fn test_bloom_filter() {
+        // a contains the even values from 10 to 20, c contains "bar" and "foo"
+        let row_group = default_row_group();
+        let mut columns = row_group.columns().to_vec();
+        let mut a = Sbbf::new(1024);
+        for v in (10..=20).step_by(2) {
+            a.insert(&(v as i32));
+        }
+        columns[0].set_bloom_filter(Some(a));
+        let mut c = Sbbf::new(1024);
+        c.insert("bar");
+        c.insert("foo");
+        columns[2].set_bloom_filter(Some(c));
+        let row_group = RowGroupMetaData::builder(row_group.schema_descr_ptr())
+            .set_num_rows(100)
+            .set_column_metadata(columns)
+            .build()
+            .unwrap();
+        let can_match = |predicate: Predicate| predicate.can_match(&row_group).unwrap();
+
+        assert!(can_match(Predicate::eq("a", 12)));
+        assert!(!can_match(Predicate::eq("a", 13)));
+        assert!(can_match(Predicate::in_list("a", vec![13, 14])));
+        assert!(!can_match(Predicate::in_list("a", vec![9, 13, 15])));
+        assert!(can_match(Predicate::eq("c", "foo")));
+        assert!(!can_match(Predicate::eq("c", "baz")));
+
+        // only equality is checked with bloom filters
+        assert!(can_match(Predicate::not_eq("a", 12)));
+        assert!(can_match(Predicate::gt_eq("a", 13)));
+        // mismatched literal types are not looked up
+        assert!(can_match(Predicate::eq("a", 13_i64)));
+    }
+
+    #[test]
+    fn test_matching_rows() {
+        // a has pages 0..10 with values 0-9, 10..20 with values 10-19, and 20..30 with
+        // nulls, the other columns have no page index
+        let mut builder = PageIndexBuilder::new();
+        for (page, stats) in vec![
+            Statistics::int32(Some(0), Some(9), None, 0, false),
+            Statistics::int32(Some(10), Some(19), None, 0, false),
+            Statistics::int32(None, None, None, 10, false),
+        ]
+        .iter()
+        .enumerate()
+        {
+            builder.add_page(Some(stats), 10 * page as u64);
+            builder.add_page_location(100 * page as u64, 100).unwrap();
+        }
+        let page_index = builder.build().unwrap();
+
+        let row_group = test_row_group(vec![
+            Some(Statistics::int32(Some(0), Some(19), None, 10, false)),
+            None,
+            None,
+            None,
+            None,
+        ]);
+        let columns = row_group
+            .columns()
+            .iter()
+            .enumerate()
+            .map(|(i, column)| {
+                let mut column = column.clone();
+                column.set_num_values(30);
+                if i == 0 {
+                    column.set_page_index(page_index.clone());
+                }
+                column
+            })
+            .collect();
+        let row_group = RowGroupMetaData::builder(row_group.schema_descr_ptr())
+            .set_num_rows(30)
+            .set_column_metadata(columns)
+            .build()
+            .unwrap();
+
+        let matching_rows = |predicate: Predicate| {
+            predicate
+                .matching_rows(&row_group)
+                .unwrap()
+                .ranges()
+                .to_vec()
+        };
+        assert_eq!(matching_rows(Predicate::eq("a", 15)), vec![10..20]);
+        assert_eq!(
+            matching_rows(Predicate::eq("a", 25)),
+            Vec::<Range<usize>>::new()
+        );
+        assert_eq!(matching_rows(Predicate::is_null("a")), vec![20..30]);
+        assert_eq!(matching_rows(Predicate::is_not_null("a")), vec![0..20]);
+        assert_eq!(
+            matching_rows(Predicate::lt("a", 5).or(Predicate::gt("a", 18))),
+            vec![0..20]
+        );
+        assert_eq!(
+            matching_rows(
+                Predicate::in_list("a", vec![3, 4]).or(Predicate::is_null("a"))
+            ),
+            vec![0..10, 20..30]
+        );
+        assert_eq!(
+            matching_rows(Predicate::eq("a", 15).and(Predicate::is_null("a"))),
+            Vec::<Range<usize>>::new()
+        );
+        assert_eq!(
+            matching_rows(Predicate::eq("a", 15).and(Predicate::gt("e", 1))),
+            vec![10..20]
+        );
+        assert_eq!(matching_rows(Predicate::gt("e", 1)), vec![0..30]);
+    }
+
+    #[test]
+    fn test_unknown_column() {
+        let result = Predicate::eq("a", 1)
+            .and(Predicate::eq("z", 1))
+            .can_match(&default_row_group());
+        assert_eq!(
+            result.err().unwrap(),
+            general_err!("Column z not found in schema")
+        );
+    }
+}
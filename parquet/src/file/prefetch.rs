@@ -0,0 +1,447 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+//! Contains a [`ChunkReader`] that plans the reads of projected column chunks up
+//! front, for storage where the latency of a read dominates its size.
+//!
+//! Without planning, every column chunk is a separate `get_read` call on the
+//! underlying reader. [`PrefetchingChunkReader`] instead merges the byte ranges of the
+//! projected column chunks of each row group that are close to each other, reads a
+//! row group's merged ranges as soon as any of its column chunks is requested, and
+//! reads the next row group in a background thread while the current one is decoded.
+//!
+//! # Example
+//!
+//! ```rust,no_run
+//! use std::fs::File;
+//! use std::sync::Arc;
+//! use parquet::arrow::{ArrowReader, ParquetFileArrowReader};
+//! use parquet::file::footer::parse_metadata;
+//! use parquet::file::prefetch::{PrefetchingChunkReader, DEFAULT_MAX_HOLE_SIZE};
+//! use parquet::file::serialized_reader::SerializedFileReader;
+//!
+//! let file = File::open("data.parquet").unwrap();
+//! let metadata = parse_metadata(&file).unwrap();
+//! let columns = vec![0, 3, 4];
+//!
+//! let chunk_reader =
+//!     PrefetchingChunkReader::new(file, &metadata, &columns, DEFAULT_MAX_HOLE_SIZE);
+//! let file_reader = SerializedFileReader::new_with_metadata(chunk_reader, metadata);
+//! let mut arrow_reader = ParquetFileArrowReader::new(Arc::new(file_reader));
+//! for batch in arrow_reader.get_record_reader_by_columns(columns, 1024).unwrap() {
+//!     println!("Read {} records.", batch.unwrap().num_rows());
+//! }
+//! ```
+
+use std::collections::VecDeque;
+use std::io::Read;
+use std::ops::Range;
+use std::sync::{Arc, Mutex};
+use std::thread::{self, JoinHandle};
+
+use crate::errors::{ParquetError, Result};
+use crate::file::{
+    metadata::ParquetMetaData,
+    reader::{ChunkReader, Length},
+    serialized_reader::{BufferedChunks, SliceableCursor},
+};
+
+/// The default largest gap between two byte ranges for them to be read together.
+pub const DEFAULT_MAX_HOLE_SIZE: u64 = 1024 * 1024;
+
+/// The number of buffered row groups kept, besides the one being prefetched.
+const BUFFERED_ROW_GROUPS: usize = 2;
+
+/// Merges byte ranges whose gap is at most `max_hole_size` bytes, returning sorted,
+/// non overlapping ranges that cover all of `ranges`. Empty ranges are dropped.
+pub fn coalesce_ranges(ranges: &[Range<u64>], max_hole_size: u64) -> Vec<Range<u64>> {
+    let mut sorted: Vec<Range<u64>> =
+        ranges.iter().filter(|r| r.start < r.end).cloned().collect();
+    sorted.sort_unstable_by_key(|r| r.start);
+
+    let mut coalesced: Vec<Range<u64>> = Vec::with_capacity(sorted.len());
+    for range in sorted {
+        match coalesced.last_mut() {
+            Some(last) if range.start <= last.end + max_hole_size => {
+                last.end = last.end.max(range.end);
+            }
+            _ => coalesced.push(range),
+        }
+    }
+    coalesced
+}
+
+/// Returns the coalesced byte ranges of the column chunks in `column_indices`, for
+/// each row group of `metadata`.
+pub fn plan_column_chunk_reads(
+    metadata: &ParquetMetaData,
+    column_indices: &[usize],
+    max_hole_size: u64,
+) -> Vec<Vec<Range<u64>>> {
+    metadata
+        .row_groups()
+        .iter()
+        .map(|row_group| {
+            let ranges: Vec<Range<u64>> = column_indices
+                .iter()
+                .map(|i| {
+                    let (start, length) = row_group.column(*i).byte_range();
+                    start..start + length
+                })
+                .collect();
+            coalesce_ranges(&ranges, max_hole_size)
+        })
+        .collect()
+}
+
+/// A [`ChunkReader`] that reads the projected column chunks of each row group with
+/// a few large reads, and prefetches the next row group in a background thread.
+///
+/// Reads outside of the planned ranges, such as of the footer, are passed through to
+/// the wrapped reader. Reads of the wrapped reader are never concurrent, as readers
+/// such as [`File`](std::fs::File) share their position between clones.
+pub struct PrefetchingChunkReader<R: ChunkReader> {
+    inner: Arc<Mutex<R>>,
+    file_len: u64,
+    /// The coalesced byte ranges to read for each row group
+    row_groups: Vec<Vec<Range<u64>>>,
+    state: Mutex<PrefetchState>,
+}
+
+#[derive(Default)]
+struct PrefetchState {
+    /// The most recently loaded row groups, oldest first
+    loaded: VecDeque<(usize, BufferedChunks)>,
+    /// The row group being read in the background
+    prefetch: Option<(usize, JoinHandle<Result<BufferedChunks>>)>,
+}
+
+impl<R: 'static + ChunkReader + Send> PrefetchingChunkReader<R> {
+    /// Creates a reader of the column chunks in `column_indices` of the file read by
+    /// `inner`, whose metadata is `metadata`. Column chunks at most `max_hole_size`
+    /// bytes apart are read together.
+    pub fn new(
+        inner: R,
+        metadata: &ParquetMetaData,
+        column_indices: &[usize],
+        max_hole_size: u64,
+    ) -> Self {
+        Self {
+            file_len: inner.len(),
+            inner: Arc::new(Mutex::new(inner)),
+            row_groups: plan_column_chunk_reads(metadata, column_indices, max_hole_size),
+            state: Mutex::new(PrefetchState::default()),
+        }
+    }
+
+    /// Returns the planned row group containing `length` bytes starting at `start`.
+    fn find_row_group(&self, start: u64, length: usize) -> Option<usize> {
+        let end = start + length as u64;
+        self.row_groups
+            .iter()
+            .position(|ranges| ranges.iter().any(|r| r.start <= start && end <= r.end))
+    }
+
+    /// Returns the buffered ranges of `row_group`, waiting for its prefetch or reading
+    /// it now if it has not been loaded yet.
+    fn load_row_group(
+        &self,
+        state: &mut PrefetchState,
+        row_group: usize,
+    ) -> Result<BufferedChunks> {
+        match state.prefetch.take() {
+            Some((i, handle)) if i == row_group => handle
+                .join()
+                .map_err(|_| general_err!("Prefetch of row group {} panicked", i))?,
+            prefetch => {
+                state.prefetch = prefetch;
+                read_ranges(&self.inner, self.file_len, &self.row_groups[row_group])
+            }
+        }
+    }
+
+    /// Starts reading `row_group` in the background, if it is not already buffered
+    /// or being read.
+    fn prefetch_row_group(&self, state: &mut PrefetchState, row_group: usize) {
+        if row_group >= self.row_groups.len()
+            || state.prefetch.is_some()
+            || state.loaded.iter().any(|(i, _)| *i == row_group)
+        {
+            return;
+        }
+        let inner = self.inner.clone();
+        let file_len = self.file_len;
+        let ranges = self.row_groups[row_group].clone();
+        let handle = thread::spawn(move || read_ranges(&inner, file_len, &ranges));
+        state.prefetch = Some((row_group, handle));
+    }
+}
+
+/// Reads `ranges` of `reader` into memory, one read per range.
+fn read_ranges<R: ChunkReader>(
+    reader: &Mutex<R>,
+    file_len: u64,
+    ranges: &[Range<u64>],
+) -> Result<BufferedChunks> {
+    let mut chunks = BufferedChunks::new(file_len);
+    for range in ranges {
+        let data = read_range(reader, range.start, (range.end - range.start) as usize)?;
+        chunks.insert(range.start, data);
+    }
+    Ok(chunks)
+}
+
+fn read_range<R: ChunkReader>(
+    reader: &Mutex<R>,
+    start: u64,
+    length: usize,
+) -> Result<Vec<u8>> {
+    let reader = reader.lock().unwrap();
+    let mut data = vec![0; length];
+    reader.get_read(start, length)?.read_exact(&mut data)?;
+    Ok(data)
+}
+
+impl<R: ChunkReader> Length for PrefetchingChunkReader<R> {
+    fn len(&self) -> u64 {
+        self.file_len
+    }
+}
+
+impl<R: 'static + ChunkReader + Send> ChunkReader for PrefetchingChunkReader<R> {
+    type T = SliceableCursor;
+
+    fn get_read(&self, start: u64, length: usize) -> Result<Self::T> {
+        let row_group = match self.find_row_group(start, length) {
+            Some(row_group) => row_group,
+            None => {
+                let data = read_range(&self.inner, start, length)?;
+                return Ok(SliceableCursor::new(data));
+            }
+        };
+
+        let mut state = self.state.lock().unwrap();
+        if let Some((_, chunks)) = state.loaded.iter().find(|(i, _)| *i == row_group) {
+            return chunks.get_read(start, length);
+        }
+
+        let chunks = self.load_row_group(&mut state, row_group)?;
+        let read = chunks.get_read(start, length);
+        if state.loaded.len() == BUFFERED_ROW_GROUPS {
+            state.loaded.pop_front();
+        }
+        state.loaded.push_back((row_group, chunks));
+        self.prefetch_row_group(&mut state, row_group + 1);
+        read
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use std::sync::atomic::{AtomicUsize, Ordering};
+
+    use arrow::array::{Array, ArrayRef, Float64Array, Int32Array, StringArray};
+    use arrow::datatypes::{DataType, Field, Schema};
+    use arrow::record_batch::RecordBatch;
+
+    use crate::arrow::arrow_writer::ArrowWriter;
+    use crate::arrow::{ArrowReader, ParquetFileArrowReader};
+    use crate::file::footer::parse_metadata;
+    use crate::file::properties::WriterProperties;
+    use crate::file::serialized_reader::SerializedFileReader;
+    use crate::util::cursor::InMemoryWriteableCursor;
+
+    /// Counts the reads made of the wrapped reader
+    struct CountingReader {
+        inner: SliceableCursor,
+        reads: Arc<AtomicUsize>,
+    }
+
+    impl Length for CountingReader {
+        fn len(&self) -> u64 {
+            self.inner.len()
+        }
+    }
+
+    impl ChunkReader for CountingReader {
+        type T = SliceableCursor;
+
+        fn get_read(&self, start: u64, length: usize) -> Result<Self::T> {
+            self.reads.fetch_add(1, Ordering::SeqCst);
+            self.inner.get_read(start, length)
+        }
+    }
+
+    /// Writes a file of 4 row groups of 100 rows and 3 columns, with column 1 taking
+    /// more than 1KiB in each row group
+    fn test_file() -> Vec<u8> {
+        let schema = Arc::new(Schema::new(vec![
+            Field::new("a", DataType::Int32, false),
+            Field::new("b", DataType::Utf8, true),
+            Field::new("c", DataType::Float64, true),
+        ]));
+        let props = WriterProperties::builder()
+            .set_max_row_group_size(100)
+            .build();
+        let cursor = InMemoryWriteableCursor::default();
+        let mut writer =
+            ArrowWriter::try_new(cursor.clone(), schema.clone(), Some(props)).unwrap();
+        for start in (0..400).step_by(100) {
+            let rows = start..start + 100;
+            let a: ArrayRef =
+                Arc::new(Int32Array::from(rows.clone().collect::<Vec<_>>()));
+            let b: ArrayRef = Arc::new(StringArray::from(
+                rows.clone()
+                    .map(|i| {
+                        if i % 5 == 0 {
+                            None
+                        } else {
+                            Some(format!("{:0>32}", i))
+                        }
+                    })
+                    .collect::<Vec<_>>(),
+            ));
+            let c: ArrayRef = Arc::new(Float64Array::from(
+                rows.map(|i| if i % 2 == 0 { Some(i as f64) } else { None })
+                    .collect::<Vec<_>>(),
+            ));
+            let batch = RecordBatch::try_new(schema.clone(), vec![a, b, c]).unwrap();
+            writer.write(&batch).unwrap();
+        }
+        writer.close().unwrap();
+        cursor.data()
+    }
+
+    fn read_columns<R: 'static + ChunkReader>(
+        file_reader: SerializedFileReader<R>,
+        columns: Vec<usize>,
+    ) -> Vec<RecordBatch> {
+        let mut arrow_reader = ParquetFileArrowReader::new(Arc::new(file_reader));
+        arrow_reader
+            .get_record_reader_by_columns(columns, 64)
+            .unwrap()
+            .collect::<arrow::error::Result<Vec<_>>>()
+            .unwrap()
+    }
+
+    /// Reads `columns` through a `PrefetchingChunkReader`, checking the result against
+    /// a plain reader, and returns the number of reads of the underlying reader
+    fn check_prefetching_reader(columns: Vec<usize>, max_hole_size: u64) -> usize {
+        let data = test_file();
+        let expected = read_columns(
+            SerializedFileReader::new(SliceableCursor::new(data.clone())).unwrap(),
+            columns.clone(),
+        );
+
+        let reads = Arc::new(AtomicUsize::new(0));
+        let inner = CountingReader {
+            inner: SliceableCursor::new(data),
+            reads: reads.clone(),
+        };
+        let metadata = parse_metadata(&inner).unwrap();
+        assert_eq!(metadata.num_row_groups(), 4);
+        let reads_before = reads.load(Ordering::SeqCst);
+
+        let chunk_reader =
+            PrefetchingChunkReader::new(inner, &metadata, &columns, max_hole_size);
+        let actual = read_columns(
+            SerializedFileReader::new_with_metadata(chunk_reader, metadata),
+            columns,
+        );
+
+        assert_eq!(actual.len(), expected.len());
+        for (actual, expected) in actual.iter().zip(&expected) {
+            assert_eq!(actual.num_columns(), expected.num_columns());
+            for i in 0..actual.num_columns() {
+                assert_eq!(actual.column(i).data(), expected.column(i).data());
+            }
+        }
+        reads.load(Ordering::SeqCst) - reads_before
+    }
+
+    #[test]
+    fn test_coalesce_ranges() {
+        assert_eq!(coalesce_ranges(&[], 10), Vec::<Range<u64>>::new());
+        assert_eq!(
+            coalesce_ranges(&[30..40, 0..10, 15..20, 10..10, 18..25], 0),
+            vec![0..10, 15..25, 30..40]
+        );
+        assert_eq!(
+            coalesce_ranges(&[30..40, 0..10, 15..20, 18..25], 5),
+            vec![0..25, 30..40]
+        );
+        assert_eq!(
+            coalesce_ranges(&[30..40, 0..10, 15..20, 18..25], 10),
+            vec![0..40]
+        );
+        assert_eq!(coalesce_ranges(&[0..100, 10..20], 0), vec![0..100]);
+    }
+
+    #[test]
+    fn test_prefetching_reader_coalesces_adjacent_columns() {
+        // only the column chunk metadata separates columns, so each row group is
+        // read at once
+        assert_eq!(check_prefetching_reader(vec![0, 1], 1024), 4);
+        assert_eq!(check_prefetching_reader(vec![0, 1, 2], 1024), 4);
+    }
+
+    #[test]
+    fn test_prefetching_reader_max_hole_size() {
+        // the more than 1KiB of column 1 lies between columns 0 and 2
+        assert_eq!(check_prefetching_reader(vec![0, 2], 0), 8);
+        assert_eq!(check_prefetching_reader(vec![0, 2], 1024), 8);
+        assert_eq!(
+            check_prefetching_reader(vec![0, 2], DEFAULT_MAX_HOLE_SIZE),
+            4
+        );
+        assert_eq!(check_prefetching_reader(vec![2], DEFAULT_MAX_HOLE_SIZE), 4);
+    }
+
+    #[test]
+    fn test_prefetching_reader_unplanned_reads() {
+        let data = test_file();
+        let metadata = parse_metadata(&SliceableCursor::new(data.clone())).unwrap();
+        let chunk_reader = PrefetchingChunkReader::new(
+            SliceableCursor::new(data.clone()),
+            &metadata,
+            &[0],
+            0,
+        );
+
+        // the footer is outside of the plan, and read directly
+        let mut footer = vec![0; 8];
+        chunk_reader
+            .get_read(data.len() as u64 - 8, 8)
+            .unwrap()
+            .read_exact(&mut footer)
+            .unwrap();
+        assert_eq!(&footer[..], &data[data.len() - 8..]);
+
+        // reading the last row group first does not prefetch past the end
+        let (start, length) = metadata.row_group(3).column(0).byte_range();
+        let mut chunk = vec![0; length as usize];
+        chunk_reader
+            .get_read(start, length as usize)
+            .unwrap()
+            .read_exact(&mut chunk)
+            .unwrap();
+        assert_eq!(&chunk[..], &data[start as usize..(start + length) as usize]);
+        assert!(chunk_reader.state.lock().unwrap().prefetch.is_none());
+    }
+}
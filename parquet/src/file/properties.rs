@@ -62,7 +62,13 @@ const DEFAULT_DICTIONARY_ENABLED: bool = true;
 const DEFAULT_DICTIONARY_PAGE_SIZE_LIMIT: usize = DEFAULT_PAGE_SIZE;
 const DEFAULT_STATISTICS_ENABLED: bool = true;
 const DEFAULT_MAX_STATISTICS_SIZE: usize = 4096;
-const DEFAULT_MAX_ROW_GROUP_SIZE: usize = 128 * 1024 * 1024;
+const DEFAULT_MAX_ROW_GROUP_SIZE: usize = 1024 * 1024;
+const DEFAULT_MAX_ROW_GROUP_BYTE_SIZE: usize = 128 * 1024 * 1024;
+const DEFAULT_WRITE_THREADS: usize = 1;
+const DEFAULT_PAGE_INDEX_ENABLED: bool = false;
+const DEFAULT_BLOOM_FILTER_ENABLED: bool = false;
+const DEFAULT_BLOOM_FILTER_FPP: f64 = 0.05;
+const DEFAULT_BLOOM_FILTER_NDV: u64 = 1_000_000;
 const DEFAULT_CREATED_BY: &str = env!("PARQUET_CREATED_BY");
 
 /// Parquet writer version.
@@ -97,6 +103,9 @@ pub struct WriterProperties {
     dictionary_pagesize_limit: usize,
     write_batch_size: usize,
     max_row_group_size: usize,
+    max_row_group_byte_size: usize,
+    write_threads: usize,
+    page_index_enabled: bool,
     writer_version: WriterVersion,
     created_by: String,
     pub(crate) key_value_metadata: Option<Vec<KeyValue>>,
@@ -129,11 +138,39 @@ impl WriterProperties {
         self.write_batch_size
     }
 
-    /// Returns max size for a row group.
+    /// Returns max number of rows in a row group.
     pub fn max_row_group_size(&self) -> usize {
         self.max_row_group_size
     }
 
+    /// Returns max size in bytes of the data buffered for a row group.
+    ///
+    /// Writers that buffer data before writing it out, such as the Arrow writer,
+    /// start a new row group once their buffered data reaches this size.
+    pub fn max_row_group_byte_size(&self) -> usize {
+        self.max_row_group_byte_size
+    }
+
+    /// Returns the number of threads used to encode the columns of a row group.
+    ///
+    /// With the default of 1, columns are encoded sequentially on the calling thread.
+    /// Otherwise writers that support it, such as the Arrow writer, encode and compress
+    /// column chunks concurrently into memory, and append them to the file in schema
+    /// order.
+    pub fn write_threads(&self) -> usize {
+        self.write_threads
+    }
+
+    /// Returns `true` if a column index and an offset index are written for column
+    /// chunks of non-repeated columns, `false` otherwise.
+    ///
+    /// The page index lets readers skip data pages whose statistics rule out rows
+    /// matching a predicate, see
+    /// [`SerializedFileReader::prune_pages`](crate::file::serialized_reader::SerializedFileReader::prune_pages).
+    pub fn page_index_enabled(&self) -> bool {
+        self.page_index_enabled
+    }
+
     /// Returns configured writer version.
     pub fn writer_version(&self) -> WriterVersion {
         self.writer_version
@@ -215,6 +252,37 @@ impl WriterProperties {
             .or_else(|| self.default_column_properties.max_statistics_size())
             .unwrap_or(DEFAULT_MAX_STATISTICS_SIZE)
     }
+
+    /// Returns `true` if a Bloom filter is written for each chunk of a column.
+    pub fn bloom_filter_enabled(&self, col: &ColumnPath) -> bool {
+        self.column_properties
+            .get(col)
+            .and_then(|c| c.bloom_filter_enabled())
+            .or_else(|| self.default_column_properties.bloom_filter_enabled())
+            .unwrap_or(DEFAULT_BLOOM_FILTER_ENABLED)
+    }
+
+    /// Returns the target false positive probability of the Bloom filters of a
+    /// column.
+    /// Only applicable if Bloom filters are enabled.
+    pub fn bloom_filter_fpp(&self, col: &ColumnPath) -> f64 {
+        self.column_properties
+            .get(col)
+            .and_then(|c| c.bloom_filter_fpp())
+            .or_else(|| self.default_column_properties.bloom_filter_fpp())
+            .unwrap_or(DEFAULT_BLOOM_FILTER_FPP)
+    }
+
+    /// Returns the expected number of distinct values in a chunk of a column, which
+    /// the Bloom filters of the column are sized for.
+    /// Only applicable if Bloom filters are enabled.
+    pub fn bloom_filter_ndv(&self, col: &ColumnPath) -> u64 {
+        self.column_properties
+            .get(col)
+            .and_then(|c| c.bloom_filter_ndv())
+            .or_else(|| self.default_column_properties.bloom_filter_ndv())
+            .unwrap_or(DEFAULT_BLOOM_FILTER_NDV)
+    }
 }
 
 /// Writer properties builder.
@@ -223,6 +291,9 @@ pub struct WriterPropertiesBuilder {
     dictionary_pagesize_limit: usize,
     write_batch_size: usize,
     max_row_group_size: usize,
+    max_row_group_byte_size: usize,
+    write_threads: usize,
+    page_index_enabled: bool,
     writer_version: WriterVersion,
     created_by: String,
     key_value_metadata: Option<Vec<KeyValue>>,
@@ -238,6 +309,9 @@ impl WriterPropertiesBuilder {
             dictionary_pagesize_limit: DEFAULT_DICTIONARY_PAGE_SIZE_LIMIT,
             write_batch_size: DEFAULT_WRITE_BATCH_SIZE,
             max_row_group_size: DEFAULT_MAX_ROW_GROUP_SIZE,
+            max_row_group_byte_size: DEFAULT_MAX_ROW_GROUP_BYTE_SIZE,
+            write_threads: DEFAULT_WRITE_THREADS,
+            page_index_enabled: DEFAULT_PAGE_INDEX_ENABLED,
             writer_version: DEFAULT_WRITER_VERSION,
             created_by: DEFAULT_CREATED_BY.to_string(),
             key_value_metadata: None,
@@ -253,6 +327,9 @@ impl WriterPropertiesBuilder {
             dictionary_pagesize_limit: self.dictionary_pagesize_limit,
             write_batch_size: self.write_batch_size,
             max_row_group_size: self.max_row_group_size,
+            max_row_group_byte_size: self.max_row_group_byte_size,
+            write_threads: self.write_threads,
+            page_index_enabled: self.page_index_enabled,
             writer_version: self.writer_version,
             created_by: self.created_by,
             key_value_metadata: self.key_value_metadata,
@@ -288,12 +365,36 @@ impl WriterPropertiesBuilder {
         self
     }
 
-    /// Sets max size for a row group.
+    /// Sets max number of rows in a row group.
+    ///
+    /// Panics if the value is 0.
     pub fn set_max_row_group_size(mut self, value: usize) -> Self {
+        assert!(value > 0, "Cannot have a 0 max row group size");
         self.max_row_group_size = value;
         self
     }
 
+    /// Sets max size in bytes of the data buffered for a row group.
+    pub fn set_max_row_group_byte_size(mut self, value: usize) -> Self {
+        self.max_row_group_byte_size = value;
+        self
+    }
+
+    /// Sets the number of threads used to encode the columns of a row group.
+    ///
+    /// Panics if the value is 0.
+    pub fn set_write_threads(mut self, value: usize) -> Self {
+        assert!(value > 0, "Cannot write with 0 threads");
+        self.write_threads = value;
+        self
+    }
+
+    /// Sets whether the page index is written for non-repeated columns.
+    pub fn set_page_index_enabled(mut self, value: bool) -> Self {
+        self.page_index_enabled = value;
+        self
+    }
+
     /// Sets "created by" property.
     pub fn set_created_by(mut self, value: String) -> Self {
         self.created_by = value;
@@ -351,6 +452,30 @@ impl WriterPropertiesBuilder {
         self
     }
 
+    /// Sets flag to enable/disable Bloom filters for any column.
+    pub fn set_bloom_filter_enabled(mut self, value: bool) -> Self {
+        self.default_column_properties
+            .set_bloom_filter_enabled(value);
+        self
+    }
+
+    /// Sets the target false positive probability of Bloom filters for any column.
+    /// Applicable only if Bloom filters are enabled.
+    ///
+    /// Panics if the value is not strictly between 0 and 1.
+    pub fn set_bloom_filter_fpp(mut self, value: f64) -> Self {
+        self.default_column_properties.set_bloom_filter_fpp(value);
+        self
+    }
+
+    /// Sets the expected number of distinct values in a column chunk, which Bloom
+    /// filters are sized for, for any column.
+    /// Applicable only if Bloom filters are enabled.
+    pub fn set_bloom_filter_ndv(mut self, value: u64) -> Self {
+        self.default_column_properties.set_bloom_filter_ndv(value);
+        self
+    }
+
     // ----------------------------------------------------------------------
     // Setters for a specific column
 
@@ -408,6 +533,34 @@ impl WriterPropertiesBuilder {
         self.get_mut_props(col).set_max_statistics_size(value);
         self
     }
+
+    /// Sets flag to enable/disable Bloom filters for a column.
+    /// Takes precedence over globally defined settings.
+    pub fn set_column_bloom_filter_enabled(
+        mut self,
+        col: ColumnPath,
+        value: bool,
+    ) -> Self {
+        self.get_mut_props(col).set_bloom_filter_enabled(value);
+        self
+    }
+
+    /// Sets the target false positive probability of Bloom filters for a column.
+    /// Takes precedence over globally defined settings.
+    ///
+    /// Panics if the value is not strictly between 0 and 1.
+    pub fn set_column_bloom_filter_fpp(mut self, col: ColumnPath, value: f64) -> Self {
+        self.get_mut_props(col).set_bloom_filter_fpp(value);
+        self
+    }
+
+    /// Sets the expected number of distinct values in a chunk of a column, which its
+    /// Bloom filters are sized for.
+    /// Takes precedence over globally defined settings.
+    pub fn set_column_bloom_filter_ndv(mut self, col: ColumnPath, value: u64) -> Self {
+        self.get_mut_props(col).set_bloom_filter_ndv(value);
+        self
+    }
 }
 
 /// Container for column properties that can be changed as part of writer.
@@ -421,6 +574,9 @@ struct ColumnProperties {
     dictionary_enabled: Option<bool>,
     statistics_enabled: Option<bool>,
     max_statistics_size: Option<usize>,
+    bloom_filter_enabled: Option<bool>,
+    bloom_filter_fpp: Option<f64>,
+    bloom_filter_ndv: Option<u64>,
 }
 
 impl ColumnProperties {
@@ -432,6 +588,9 @@ impl ColumnProperties {
             dictionary_enabled: None,
             statistics_enabled: None,
             max_statistics_size: None,
+            bloom_filter_enabled: None,
+            bloom_filter_fpp: None,
+            bloom_filter_ndv: None,
         }
     }
 
@@ -471,6 +630,28 @@ impl ColumnProperties {
         self.max_statistics_size = Some(value);
     }
 
+    /// Sets whether or not Bloom filters are enabled for this column.
+    fn set_bloom_filter_enabled(&mut self, enabled: bool) {
+        self.bloom_filter_enabled = Some(enabled);
+    }
+
+    /// Sets the target false positive probability of Bloom filters for this column.
+    ///
+    /// Panics if the value is not strictly between 0 and 1.
+    fn set_bloom_filter_fpp(&mut self, value: f64) {
+        assert!(
+            value > 0.0 && value < 1.0,
+            "Bloom filter false positive probability must be between 0 and 1, got {}",
+            value
+        );
+        self.bloom_filter_fpp = Some(value);
+    }
+
+    /// Sets the expected number of distinct values in a chunk of this column.
+    fn set_bloom_filter_ndv(&mut self, value: u64) {
+        self.bloom_filter_ndv = Some(value);
+    }
+
     /// Returns optional encoding for this column.
     fn encoding(&self) -> Option<Encoding> {
         self.encoding
@@ -498,6 +679,23 @@ impl ColumnProperties {
     fn max_statistics_size(&self) -> Option<usize> {
         self.max_statistics_size
     }
+
+    /// Returns `Some(true)` if Bloom filters are enabled for this column, if disabled
+    /// then returns `Some(false)`. If result is `None`, then no setting has been
+    /// provided.
+    fn bloom_filter_enabled(&self) -> Option<bool> {
+        self.bloom_filter_enabled
+    }
+
+    /// Returns optional target false positive probability of Bloom filters.
+    fn bloom_filter_fpp(&self) -> Option<f64> {
+        self.bloom_filter_fpp
+    }
+
+    /// Returns optional expected number of distinct values in a column chunk.
+    fn bloom_filter_ndv(&self) -> Option<u64> {
+        self.bloom_filter_ndv
+    }
 }
 
 #[cfg(test)]
@@ -520,6 +718,12 @@ mod tests {
         );
         assert_eq!(props.write_batch_size(), DEFAULT_WRITE_BATCH_SIZE);
         assert_eq!(props.max_row_group_size(), DEFAULT_MAX_ROW_GROUP_SIZE);
+        assert_eq!(
+            props.max_row_group_byte_size(),
+            DEFAULT_MAX_ROW_GROUP_BYTE_SIZE
+        );
+        assert_eq!(props.write_threads(), DEFAULT_WRITE_THREADS);
+        assert_eq!(props.page_index_enabled(), DEFAULT_PAGE_INDEX_ENABLED);
         assert_eq!(props.writer_version(), DEFAULT_WRITER_VERSION);
         assert_eq!(props.created_by(), DEFAULT_CREATED_BY);
         assert_eq!(props.key_value_metadata(), &None);
@@ -540,6 +744,18 @@ mod tests {
             props.max_statistics_size(&ColumnPath::from("col")),
             DEFAULT_MAX_STATISTICS_SIZE
         );
+        assert_eq!(
+            props.bloom_filter_enabled(&ColumnPath::from("col")),
+            DEFAULT_BLOOM_FILTER_ENABLED
+        );
+        assert_eq!(
+            props.bloom_filter_fpp(&ColumnPath::from("col")),
+            DEFAULT_BLOOM_FILTER_FPP
+        );
+        assert_eq!(
+            props.bloom_filter_ndv(&ColumnPath::from("col")),
+            DEFAULT_BLOOM_FILTER_NDV
+        );
     }
 
     #[test]
@@ -603,6 +819,9 @@ mod tests {
             .set_dictionary_pagesize_limit(20)
             .set_write_batch_size(30)
             .set_max_row_group_size(40)
+            .set_max_row_group_byte_size(45)
+            .set_write_threads(4)
+            .set_page_index_enabled(true)
             .set_created_by("default".to_owned())
             .set_key_value_metadata(Some(vec![KeyValue::new(
                 "key".to_string(),
@@ -614,12 +833,18 @@ mod tests {
             .set_dictionary_enabled(false)
             .set_statistics_enabled(false)
             .set_max_statistics_size(50)
+            .set_bloom_filter_enabled(false)
+            .set_bloom_filter_fpp(0.1)
+            .set_bloom_filter_ndv(100)
             // specific column settings
             .set_column_encoding(ColumnPath::from("col"), Encoding::RLE)
             .set_column_compression(ColumnPath::from("col"), Compression::SNAPPY)
             .set_column_dictionary_enabled(ColumnPath::from("col"), true)
             .set_column_statistics_enabled(ColumnPath::from("col"), true)
             .set_column_max_statistics_size(ColumnPath::from("col"), 123)
+            .set_column_bloom_filter_enabled(ColumnPath::from("col"), true)
+            .set_column_bloom_filter_fpp(ColumnPath::from("col"), 0.01)
+            .set_column_bloom_filter_ndv(ColumnPath::from("col"), 1000)
             .build();
 
         assert_eq!(props.writer_version(), WriterVersion::PARQUET_2_0);
@@ -627,6 +852,9 @@ mod tests {
         assert_eq!(props.dictionary_pagesize_limit(), 20);
         assert_eq!(props.write_batch_size(), 30);
         assert_eq!(props.max_row_group_size(), 40);
+        assert_eq!(props.max_row_group_byte_size(), 45);
+        assert_eq!(props.write_threads(), 4);
+        assert!(props.page_index_enabled());
         assert_eq!(props.created_by(), "default");
         assert_eq!(
             props.key_value_metadata(),
@@ -641,6 +869,9 @@ mod tests {
         assert_eq!(props.dictionary_enabled(&ColumnPath::from("a")), false);
         assert_eq!(props.statistics_enabled(&ColumnPath::from("a")), false);
         assert_eq!(props.max_statistics_size(&ColumnPath::from("a")), 50);
+        assert_eq!(props.bloom_filter_enabled(&ColumnPath::from("a")), false);
+        assert_eq!(props.bloom_filter_fpp(&ColumnPath::from("a")), 0.1);
+        assert_eq!(props.bloom_filter_ndv(&ColumnPath::from("a")), 100);
 
         assert_eq!(
             props.encoding(&ColumnPath::from("col")),
@@ -653,6 +884,19 @@ mod tests {
         assert_eq!(props.dictionary_enabled(&ColumnPath::from("col")), true);
         assert_eq!(props.statistics_enabled(&ColumnPath::from("col")), true);
         assert_eq!(props.max_statistics_size(&ColumnPath::from("col")), 123);
+        assert_eq!(props.bloom_filter_enabled(&ColumnPath::from("col")), true);
+        assert_eq!(props.bloom_filter_fpp(&ColumnPath::from("col")), 0.01);
+        assert_eq!(props.bloom_filter_ndv(&ColumnPath::from("col")), 1000);
+    }
+
+    #[test]
+    #[should_panic(
+        expected = "Bloom filter false positive probability must be between 0 and 1, got 1"
+    )]
+    fn test_writer_properties_panic_when_bloom_filter_fpp_is_invalid() {
+        WriterProperties::builder()
+            .set_column_bloom_filter_fpp(ColumnPath::from("col"), 1.0)
+            .build();
     }
 
     #[test]
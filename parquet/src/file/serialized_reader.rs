@@ -18,7 +18,7 @@
 //! Contains implementations of the reader traits FileReader, RowGroupReader and PageReader
 //! Also contains implementations of the ChunkReader for files (with buffering) and byte arrays (RAM)
 
-use std::{convert::TryFrom, fs::File, io::Read, path::Path, sync::Arc};
+use std::{convert::TryFrom, fs::File, io::Read, ops::Range, path::Path, sync::Arc};
 
 use parquet_format::{PageHeader, PageType};
 use thrift::protocol::TCompactInputProtocol;
@@ -27,7 +27,15 @@ use crate::basic::{Compression, Encoding, Type};
 use crate::column::page::{Page, PageReader};
 use crate::compression::{create_codec, Codec};
 use crate::errors::{ParquetError, Result};
-use crate::file::{footer, metadata::*, reader::*, statistics};
+use crate::file::{
+    bloom_filter::read_bloom_filter,
+    footer,
+    metadata::*,
+    page_index::{read_page_index, OffsetIndex},
+    predicate::Predicate,
+    reader::*,
+    statistics,
+};
 use crate::record::reader::RowIter;
 use crate::record::Row;
 use crate::schema::types::Type as SchemaType;
@@ -74,6 +82,74 @@ impl ChunkReader for SliceableCursor {
     }
 }
 
+/// A [`ChunkReader`] over byte ranges of a file that have already been read into
+/// memory, such as the column chunks of a row group fetched from remote storage.
+///
+/// Every read must fall entirely within a single buffered range.
+pub struct BufferedChunks {
+    /// Buffered ranges, sorted by their start offset in the file
+    chunks: Vec<(u64, SliceableCursor)>,
+    /// Length of the whole file
+    file_len: u64,
+}
+
+impl BufferedChunks {
+    /// Creates an empty set of buffered ranges for a file of `file_len` bytes.
+    pub fn new(file_len: u64) -> Self {
+        Self {
+            chunks: Vec::new(),
+            file_len,
+        }
+    }
+
+    /// Buffers `data`, the contents of the file starting at offset `start`.
+    pub fn insert(&mut self, start: u64, data: Vec<u8>) {
+        let idx = match self.chunks.binary_search_by_key(&start, |(s, _)| *s) {
+            Ok(idx) | Err(idx) => idx,
+        };
+        self.chunks.insert(idx, (start, SliceableCursor::new(data)));
+    }
+
+    /// Returns the buffered range containing `length` bytes starting at `start`.
+    fn find(&self, start: u64, length: usize) -> Option<&(u64, SliceableCursor)> {
+        // the last range starting at or before `start` is the only one that can contain it
+        let idx = match self.chunks.binary_search_by_key(&start, |(s, _)| *s) {
+            Ok(idx) => idx,
+            Err(0) => return None,
+            Err(idx) => idx - 1,
+        };
+        let chunk = &self.chunks[idx];
+        if start - chunk.0 + length as u64 <= chunk.1.len() {
+            Some(chunk)
+        } else {
+            None
+        }
+    }
+}
+
+impl Length for BufferedChunks {
+    fn len(&self) -> u64 {
+        self.file_len
+    }
+}
+
+impl ChunkReader for BufferedChunks {
+    type T = SliceableCursor;
+
+    fn get_read(&self, start: u64, length: usize) -> Result<Self::T> {
+        match self.find(start, length) {
+            Some((chunk_start, chunk)) => chunk
+                .slice(start - chunk_start, length)
+                .map_err(|e| e.into()),
+            None => Err(general_err!(
+                "Byte range {}..{} has not been buffered",
+                start,
+                start + length as u64
+            )),
+        }
+    }
+}
+
 impl TryFrom<File> for SerializedFileReader<File> {
     type Error = ParquetError;
 
@@ -125,6 +201,15 @@ impl IntoIterator for SerializedFileReader<File> {
 pub struct SerializedFileReader<R: ChunkReader> {
     chunk_reader: Arc<R>,
     metadata: ParquetMetaData,
+    // Pages selected by `prune_pages` in each row group, empty if it was not called
+    selected_pages: Vec<Option<Arc<SelectedPages>>>,
+}
+
+/// The pages of a row group that are read after [`SerializedFileReader::prune_pages`].
+struct SelectedPages {
+    // For each column chunk, the byte ranges of the pages before its first data page,
+    // such as the dictionary page, followed by those of the selected data pages.
+    column_ranges: Vec<Vec<Range<u64>>>,
 }
 
 impl<R: 'static + ChunkReader> SerializedFileReader<R> {
@@ -132,10 +217,18 @@ impl<R: 'static + ChunkReader> SerializedFileReader<R> {
     /// Returns error if Parquet file does not exist or is corrupt.
     pub fn new(chunk_reader: R) -> Result<Self> {
         let metadata = footer::parse_metadata(&chunk_reader)?;
-        Ok(Self {
+        Ok(Self::new_with_metadata(chunk_reader, metadata))
+    }
+
+    /// Creates file reader from a Parquet file whose metadata has already been
+    /// decoded, for example by
+    /// [`async_reader::parse_metadata`](crate::file::async_reader::parse_metadata).
+    pub fn new_with_metadata(chunk_reader: R, metadata: ParquetMetaData) -> Self {
+        Self {
             chunk_reader: Arc::new(chunk_reader),
             metadata,
-        })
+            selected_pages: Vec::new(),
+        }
     }
 
     /// Filters row group metadata to only those row groups,
@@ -145,16 +238,192 @@ impl<R: 'static + ChunkReader> SerializedFileReader<R> {
         predicate: &dyn Fn(&RowGroupMetaData, usize) -> bool,
     ) {
         let mut filtered_row_groups = Vec::<RowGroupMetaData>::new();
+        let mut selected_pages = Vec::new();
         for (i, row_group_metadata) in self.metadata.row_groups().iter().enumerate() {
             if predicate(row_group_metadata, i) {
                 filtered_row_groups.push(row_group_metadata.clone());
+                if let Some(selection) = self.selected_pages.get(i) {
+                    selected_pages.push(selection.clone());
+                }
             }
         }
+        self.selected_pages = selected_pages;
         self.metadata = ParquetMetaData::new(
             self.metadata.file_metadata().clone(),
             filtered_row_groups,
         );
     }
+
+    /// Filters row group metadata to only those row groups whose column statistics
+    /// do not rule out rows satisfying `predicate`, and returns the number of row
+    /// groups removed.
+    pub fn prune_row_groups(&mut self, predicate: &Predicate) -> Result<usize> {
+        let mut keep = Vec::with_capacity(self.metadata.num_row_groups());
+        for row_group_metadata in self.metadata.row_groups() {
+            keep.push(predicate.can_match(row_group_metadata)?);
+        }
+        let num_row_groups = self.metadata.num_row_groups();
+        self.filter_row_groups(&|_, i| keep[i]);
+        Ok(num_row_groups - self.metadata.num_row_groups())
+    }
+
+    /// Reads the page index of every column chunk that has one, and makes it
+    /// available with [`ColumnChunkMetaData::page_index`].
+    pub fn load_page_indexes(&mut self) -> Result<()> {
+        let mut row_groups = Vec::with_capacity(self.metadata.num_row_groups());
+        for row_group in self.metadata.row_groups() {
+            let mut columns = Vec::with_capacity(row_group.num_columns());
+            for column in row_group.columns() {
+                let mut column = column.clone();
+                if column.page_index().is_none() {
+                    column.set_page_index(read_page_index(
+                        self.chunk_reader.as_ref(),
+                        &column,
+                    )?);
+                }
+                columns.push(column);
+            }
+            row_groups.push(with_columns(row_group, columns, row_group.num_rows())?);
+        }
+        self.metadata =
+            ParquetMetaData::new(self.metadata.file_metadata().clone(), row_groups);
+        Ok(())
+    }
+
+    /// Reads the Bloom filter of every column chunk that has one, and makes it
+    /// available with [`ColumnChunkMetaData::bloom_filter`], so that
+    /// [`prune_row_groups`](Self::prune_row_groups) and
+    /// [`prune_pages`](Self::prune_pages) also skip row groups by the values of
+    /// equality and `IN` predicates.
+    pub fn load_bloom_filters(&mut self) -> Result<()> {
+        let mut row_groups = Vec::with_capacity(self.metadata.num_row_groups());
+        for row_group in self.metadata.row_groups() {
+            let mut columns = Vec::with_capacity(row_group.num_columns());
+            for column in row_group.columns() {
+                let mut column = column.clone();
+                if column.bloom_filter().is_none() {
+                    column.set_bloom_filter(read_bloom_filter(
+                        self.chunk_reader.as_ref(),
+                        &column,
+                    )?);
+                }
+                columns.push(column);
+            }
+            row_groups.push(with_columns(row_group, columns, row_group.num_rows())?);
+        }
+        self.metadata =
+            ParquetMetaData::new(self.metadata.file_metadata().clone(), row_groups);
+        Ok(())
+    }
+
+    /// Skips the data pages whose statistics in the page index prove that none of
+    /// their rows satisfy `predicate`, and returns the number of rows skipped.
+    ///
+    /// The page indexes are loaded first. Row groups without any row that can match
+    /// are removed. In the other row groups every column reads the same rows: the
+    /// smallest set of whole pages of each column that contains all rows that can
+    /// match. Rows in those pages are not filtered.
+    ///
+    /// Row groups are read whole if any of their columns has no offset index, which
+    /// is always the case for repeated columns, and row groups whose pages have
+    /// already been pruned are left as they are.
+    pub fn prune_pages(&mut self, predicate: &Predicate) -> Result<usize> {
+        self.load_page_indexes()?;
+
+        let mut row_groups = Vec::with_capacity(self.metadata.num_row_groups());
+        let mut selected_pages = Vec::with_capacity(self.metadata.num_row_groups());
+        let mut rows_skipped = 0;
+        for (i, row_group) in self.metadata.row_groups().iter().enumerate() {
+            let previous = self.selected_pages.get(i).cloned().flatten();
+            if previous.is_some() {
+                row_groups.push(row_group.clone());
+                selected_pages.push(previous);
+                continue;
+            }
+
+            let num_rows = row_group.num_rows() as usize;
+            let rows = predicate.matching_rows(row_group)?;
+            if rows.is_empty() {
+                rows_skipped += num_rows;
+                continue;
+            }
+
+            let offset_indexes = row_group
+                .columns()
+                .iter()
+                .map(|column| {
+                    column
+                        .page_index()
+                        .map(|page_index| page_index.offset_index())
+                        .filter(|offset_index| {
+                            offset_index.num_pages() > 0
+                                && column.column_descr().max_rep_level() == 0
+                        })
+                })
+                .collect::<Option<Vec<&OffsetIndex>>>();
+            let offset_indexes = match offset_indexes {
+                Some(offset_indexes) => offset_indexes,
+                None => {
+                    row_groups.push(row_group.clone());
+                    selected_pages.push(None);
+                    continue;
+                }
+            };
+
+            let rows = rows.align_to_pages(&offset_indexes, num_rows);
+            let num_selected = rows.row_count();
+            if num_selected == num_rows {
+                row_groups.push(row_group.clone());
+                selected_pages.push(None);
+                continue;
+            }
+
+            let mut columns = Vec::with_capacity(row_group.num_columns());
+            let mut column_ranges = Vec::with_capacity(row_group.num_columns());
+            for (column, offset_index) in row_group.columns().iter().zip(offset_indexes) {
+                let locations = offset_index.page_locations();
+                let mut ranges = Vec::new();
+                let (col_start, _) = column.byte_range();
+                let first_data_page = locations[0].offset as u64;
+                if col_start < first_data_page {
+                    ranges.push(col_start..first_data_page);
+                }
+                for page in offset_index.selected_pages(&rows, num_rows) {
+                    let location = &locations[page];
+                    let start = location.offset as u64;
+                    ranges.push(start..start + location.compressed_page_size as u64);
+                }
+                column_ranges.push(ranges);
+
+                // only whole rows of non-repeated columns are selected
+                let mut column = column.clone();
+                column.set_num_values(num_selected as i64);
+                columns.push(column);
+            }
+
+            rows_skipped += num_rows - num_selected;
+            row_groups.push(with_columns(row_group, columns, num_selected as i64)?);
+            selected_pages.push(Some(Arc::new(SelectedPages { column_ranges })));
+        }
+
+        self.metadata =
+            ParquetMetaData::new(self.metadata.file_metadata().clone(), row_groups);
+        self.selected_pages = selected_pages;
+        Ok(rows_skipped)
+    }
+}
+
+/// Returns a copy of `row_group` with `columns` and `num_rows` rows.
+fn with_columns(
+    row_group: &RowGroupMetaData,
+    columns: Vec<ColumnChunkMetaData>,
+    num_rows: i64,
+) -> Result<RowGroupMetaData> {
+    RowGroupMetaData::builder(row_group.schema_descr_ptr())
+        .set_num_rows(num_rows)
+        .set_total_byte_size(row_group.total_byte_size())
+        .set_column_metadata(columns)
+        .build()
 }
 
 impl<R: 'static + ChunkReader> FileReader for SerializedFileReader<R> {
@@ -170,9 +439,11 @@ impl<R: 'static + ChunkReader> FileReader for SerializedFileReader<R> {
         let row_group_metadata = self.metadata.row_group(i);
         // Row groups should be processed sequentially.
         let f = Arc::clone(&self.chunk_reader);
+        let selected_pages = self.selected_pages.get(i).cloned().flatten();
         Ok(Box::new(SerializedRowGroupReader::new(
             f,
             row_group_metadata,
+            selected_pages,
         )))
     }
 
@@ -185,14 +456,20 @@ impl<R: 'static + ChunkReader> FileReader for SerializedFileReader<R> {
 pub struct SerializedRowGroupReader<'a, R: ChunkReader> {
     chunk_reader: Arc<R>,
     metadata: &'a RowGroupMetaData,
+    selected_pages: Option<Arc<SelectedPages>>,
 }
 
 impl<'a, R: ChunkReader> SerializedRowGroupReader<'a, R> {
     /// Creates new row group reader from a file and row group metadata.
-    fn new(chunk_reader: Arc<R>, metadata: &'a RowGroupMetaData) -> Self {
+    fn new(
+        chunk_reader: Arc<R>,
+        metadata: &'a RowGroupMetaData,
+        selected_pages: Option<Arc<SelectedPages>>,
+    ) -> Self {
         Self {
             chunk_reader,
             metadata,
+            selected_pages,
         }
     }
 }
@@ -209,6 +486,23 @@ impl<'a, R: 'static + ChunkReader> RowGroupReader for SerializedRowGroupReader<'
     // TODO: fix PARQUET-816
     fn get_column_page_reader(&self, i: usize) -> Result<Box<dyn PageReader>> {
         let col = self.metadata.column(i);
+        if let Some(selected_pages) = self.selected_pages.as_ref() {
+            let mut data = Vec::new();
+            for range in &selected_pages.column_ranges[i] {
+                let length = (range.end - range.start) as usize;
+                self.chunk_reader
+                    .get_read(range.start, length)?
+                    .read_to_end(&mut data)?;
+            }
+            let page_reader = SerializedPageReader::new(
+                SliceableCursor::new(data),
+                col.num_values(),
+                col.compression(),
+                col.column_descr().physical_type(),
+            )?;
+            return Ok(Box::new(page_reader));
+        }
+
         let (col_start, col_length) = col.byte_range();
         let file_chunk = self.chunk_reader.get_read(col_start, col_length as usize)?;
         let page_reader = SerializedPageReader::new(
@@ -393,8 +687,16 @@ impl<T: Read> PageReader for SerializedPageReader<T> {
 mod tests {
     use super::*;
     use crate::basic::ColumnOrder;
+    use crate::column::writer::ColumnWriter;
+    use crate::data_type::ByteArray;
+    use crate::file::{
+        properties::WriterProperties,
+        writer::{
+            FileWriter, InMemoryWriteableCursor, RowGroupWriter, SerializedFileWriter,
+        },
+    };
     use crate::record::RowAccessor;
-    use crate::schema::parser::parse_message_type;
+    use crate::schema::{parser::parse_message_type, types::ColumnPath};
     use crate::util::test_common::{get_test_file, get_test_path};
     use std::sync::Arc;
 
@@ -416,6 +718,35 @@ mod tests {
         assert!(file_iter.eq(cursor_iter));
     }
 
+    #[test]
+    fn test_buffered_chunks_reader() {
+        let mut buf: Vec<u8> = Vec::new();
+        get_test_file("alltypes_plain.parquet")
+            .read_to_end(&mut buf)
+            .unwrap();
+        let metadata =
+            footer::parse_metadata(&SliceableCursor::new(buf.clone())).unwrap();
+
+        // buffer only the column chunks, in reverse order
+        let mut chunks = BufferedChunks::new(buf.len() as u64);
+        for column in metadata.row_group(0).columns().iter().rev() {
+            let (start, length) = column.byte_range();
+            let range = start as usize..(start + length) as usize;
+            chunks.insert(start, buf[range].to_vec());
+        }
+        assert!(chunks.get_read(0, 4).is_err());
+        assert!(chunks.get_read(buf.len() as u64 - 8, 8).is_err());
+
+        let read_from_chunks = SerializedFileReader::new_with_metadata(chunks, metadata);
+        let read_from_file =
+            SerializedFileReader::new(get_test_file("alltypes_plain.parquet")).unwrap();
+
+        let file_iter = read_from_file.get_row_iter(None).unwrap();
+        let chunks_iter = read_from_chunks.get_row_iter(None).unwrap();
+
+        assert!(file_iter.eq(chunks_iter));
+    }
+
     #[test]
     fn test_file_reader_try_from() {
         // Valid file path
@@ -768,4 +1099,269 @@ mod tests {
 
         Ok(())
     }
+
+    /// Writes two row groups with columns `a` and `b`, both with values `0..100` in the
+    /// first and `100..200` in the second row group. Pages of `a` have 10 rows, pages
+    /// of `b` have 15 rows.
+    fn page_index_test_file(page_index_enabled: bool) -> SliceableCursor {
+        let message_type = "
+            message test_schema {
+                REQUIRED INT32 a;
+                OPTIONAL INT32 b;
+            }
+        ";
+        let schema = Arc::new(parse_message_type(message_type).unwrap());
+        let props = Arc::new(
+            WriterProperties::builder()
+                .set_data_pagesize_limit(1)
+                .set_write_batch_size(20)
+                .set_page_index_enabled(page_index_enabled)
+                .build(),
+        );
+        let cursor = InMemoryWriteableCursor::default();
+        let mut writer =
+            SerializedFileWriter::new(cursor.clone(), schema, props).unwrap();
+
+        for row_group in 0..2 {
+            let values: Vec<i32> = (row_group * 100..(row_group + 1) * 100).collect();
+            let mut row_group_writer = writer.next_row_group().unwrap();
+
+            let mut col_writer = row_group_writer.next_column().unwrap().unwrap();
+            if let ColumnWriter::Int32ColumnWriter(ref mut typed) = col_writer {
+                for chunk in values.chunks(10) {
+                    typed.write_batch(chunk, None, None).unwrap();
+                }
+            }
+            row_group_writer.close_column(col_writer).unwrap();
+
+            let mut col_writer = row_group_writer.next_column().unwrap().unwrap();
+            if let ColumnWriter::Int32ColumnWriter(ref mut typed) = col_writer {
+                for chunk in values.chunks(15) {
+                    let def_levels = vec![1; chunk.len()];
+                    typed.write_batch(chunk, Some(&def_levels), None).unwrap();
+                }
+            }
+            row_group_writer.close_column(col_writer).unwrap();
+
+            writer.close_row_group(row_group_writer).unwrap();
+        }
+        writer.close().unwrap();
+
+        SliceableCursor::new(cursor.data())
+    }
+
+    fn read_rows<R: 'static + ChunkReader>(
+        reader: &SerializedFileReader<R>,
+    ) -> Vec<(i32, i32)> {
+        reader
+            .get_row_iter(None)
+            .unwrap()
+            .map(|row| (row.get_int(0).unwrap(), row.get_int(1).unwrap()))
+            .collect()
+    }
+
+    #[test]
+    fn test_file_reader_load_page_indexes() {
+        let mut reader = SerializedFileReader::new(page_index_test_file(true)).unwrap();
+        assert!(reader
+            .metadata()
+            .row_group(0)
+            .column(0)
+            .page_index()
+            .is_none());
+
+        reader.load_page_indexes().unwrap();
+        for row_group in reader.metadata().row_groups() {
+            let a = row_group.column(0).page_index().unwrap();
+            assert_eq!(a.offset_index().num_pages(), 10);
+            let b = row_group.column(1).page_index().unwrap();
+            assert_eq!(b.offset_index().num_pages(), 7);
+            assert_eq!(b.offset_index().page_rows(1, 100), 15..30);
+            assert_eq!(b.offset_index().page_rows(6, 100), 90..100);
+        }
+
+        let mut reader = SerializedFileReader::new(page_index_test_file(false)).unwrap();
+        reader.load_page_indexes().unwrap();
+        assert!(reader
+            .metadata()
+            .row_group(0)
+            .column(0)
+            .page_index()
+            .is_none());
+    }
+
+    #[test]
+    fn test_file_reader_prune_pages() {
+        let mut reader = SerializedFileReader::new(page_index_test_file(true)).unwrap();
+
+        // 42 is in page 40..50 of a, which overlaps with pages 30..45 and 45..60 of
+        // b, which in turn overlap with pages 30..40 and 50..60 of a
+        let predicate = Predicate::eq("a", 42);
+        assert_eq!(reader.prune_pages(&predicate).unwrap(), 170);
+        assert_eq!(reader.num_row_groups(), 1);
+        assert_eq!(reader.metadata().row_group(0).num_rows(), 30);
+        let expected: Vec<(i32, i32)> = (30..60).map(|v| (v, v)).collect();
+        assert_eq!(read_rows(&reader), expected);
+
+        // pages that have been selected are not pruned again
+        assert_eq!(reader.prune_pages(&Predicate::eq("a", 55)).unwrap(), 0);
+        assert_eq!(read_rows(&reader), expected);
+
+        // without page index, only row groups are pruned
+        let mut reader = SerializedFileReader::new(page_index_test_file(false)).unwrap();
+        assert_eq!(reader.prune_pages(&predicate).unwrap(), 100);
+        let expected: Vec<(i32, i32)> = (0..100).map(|v| (v, v)).collect();
+        assert_eq!(read_rows(&reader), expected);
+    }
+
+    #[test]
+    fn test_file_reader_prune_pages_or() {
+        let mut reader = SerializedFileReader::new(page_index_test_file(true)).unwrap();
+
+        // in the first row group, page 0..10 of a and page 90..100 of b match, the
+        // former expands to 0..30 across both columns; in the second row group page
+        // 0..15 of b matches, and also expands to 0..30
+        let predicate = Predicate::lt("a", 5)
+            .or(Predicate::gt_eq("b", 95).and(Predicate::lt("b", 105)));
+        assert_eq!(reader.prune_pages(&predicate).unwrap(), 130);
+        assert_eq!(reader.num_row_groups(), 2);
+        let expected: Vec<(i32, i32)> = (0..30)
+            .chain(90..100)
+            .chain(100..130)
+            .map(|v| (v, v))
+            .collect();
+        assert_eq!(read_rows(&reader), expected);
+    }
+
+    #[test]
+    fn test_file_reader_prune_pages_unsigned_order() {
+        // strings are ordered byte-wise and not by length first, and UINT_32 values
+        // as unsigned integers
+        let message_type = "
+            message test_schema {
+                REQUIRED BYTE_ARRAY name (UTF8);
+                REQUIRED INT32 id (UINT_32);
+            }
+        ";
+        let schema = Arc::new(parse_message_type(message_type).unwrap());
+        let props = Arc::new(
+            WriterProperties::builder()
+                .set_data_pagesize_limit(1)
+                .set_write_batch_size(2)
+                .set_page_index_enabled(true)
+                .build(),
+        );
+        let cursor = InMemoryWriteableCursor::default();
+        let mut writer =
+            SerializedFileWriter::new(cursor.clone(), schema, props).unwrap();
+        let names: Vec<ByteArray> = vec!["b", "aa", "z", "é", "c", "d"]
+            .into_iter()
+            .map(ByteArray::from)
+            .collect();
+        let ids = vec![5, 3_000_000_000_u32 as i32, 1, 2, 7, 8];
+        let mut row_group_writer = writer.next_row_group().unwrap();
+        let mut col_writer = row_group_writer.next_column().unwrap().unwrap();
+        if let ColumnWriter::ByteArrayColumnWriter(ref mut typed) = col_writer {
+            for chunk in names.chunks(2) {
+                typed.write_batch(chunk, None, None).unwrap();
+            }
+        }
+        row_group_writer.close_column(col_writer).unwrap();
+        let mut col_writer = row_group_writer.next_column().unwrap().unwrap();
+        if let ColumnWriter::Int32ColumnWriter(ref mut typed) = col_writer {
+            for chunk in ids.chunks(2) {
+                typed.write_batch(chunk, None, None).unwrap();
+            }
+        }
+        row_group_writer.close_column(col_writer).unwrap();
+        writer.close_row_group(row_group_writer).unwrap();
+        writer.close().unwrap();
+
+        let names_of = |predicate: Predicate, expected_pruned: usize| {
+            let mut reader =
+                SerializedFileReader::new(SliceableCursor::new(cursor.data())).unwrap();
+            reader.load_page_indexes().unwrap();
+            let column = reader.metadata().row_group(0).column(0);
+            assert_eq!(column.page_index().unwrap().offset_index().num_pages(), 3);
+            assert_eq!(reader.prune_pages(&predicate).unwrap(), expected_pruned);
+            reader
+                .get_row_iter(None)
+                .unwrap()
+                .map(|row| row.get_string(0).unwrap().clone())
+                .collect::<Vec<_>>()
+        };
+
+        assert_eq!(names_of(Predicate::eq("name", "b"), 4), vec!["b", "aa"]);
+        assert_eq!(names_of(Predicate::eq("name", "é"), 4), vec!["z", "é"]);
+        assert_eq!(names_of(Predicate::gt("name", "zz"), 4), vec!["z", "é"]);
+        assert_eq!(
+            names_of(Predicate::eq("id", 3_000_000_000_u32 as i32), 4),
+            vec!["b", "aa"]
+        );
+        assert_eq!(names_of(Predicate::lt("id", 3), 4), vec!["z", "é"]);
+    }
+
+    #[test]
+    fn test_file_reader_load_bloom_filters() {
+        // ids of the row groups overlap, so that statistics cannot prune any of them
+        let message_type = "
+            message test_schema {
+                REQUIRED INT64 id;
+                REQUIRED BYTE_ARRAY name (UTF8);
+            }
+        ";
+        let schema = Arc::new(parse_message_type(message_type).unwrap());
+        let props = Arc::new(
+            WriterProperties::builder()
+                .set_column_bloom_filter_enabled(ColumnPath::from("id"), true)
+                .set_column_bloom_filter_ndv(ColumnPath::from("id"), 1000)
+                .build(),
+        );
+        let cursor = InMemoryWriteableCursor::default();
+        let mut writer =
+            SerializedFileWriter::new(cursor.clone(), schema, props).unwrap();
+        for row_group in 0..4 {
+            let ids: Vec<i64> = (0..100).map(|v| v * 4 + row_group).collect();
+            let names: Vec<ByteArray> = ids
+                .iter()
+                .map(|id| id.to_string().as_str().into())
+                .collect();
+            let mut row_group_writer = writer.next_row_group().unwrap();
+            let mut col_writer = row_group_writer.next_column().unwrap().unwrap();
+            if let ColumnWriter::Int64ColumnWriter(ref mut typed) = col_writer {
+                typed.write_batch(&ids, None, None).unwrap();
+            }
+            row_group_writer.close_column(col_writer).unwrap();
+            let mut col_writer = row_group_writer.next_column().unwrap().unwrap();
+            if let ColumnWriter::ByteArrayColumnWriter(ref mut typed) = col_writer {
+                typed.write_batch(&names, None, None).unwrap();
+            }
+            row_group_writer.close_column(col_writer).unwrap();
+            writer.close_row_group(row_group_writer).unwrap();
+        }
+        writer.close().unwrap();
+
+        let predicate = Predicate::eq("id", 202_i64);
+        let mut reader =
+            SerializedFileReader::new(SliceableCursor::new(cursor.data())).unwrap();
+        assert_eq!(reader.prune_row_groups(&predicate).unwrap(), 0);
+
+        let mut reader =
+            SerializedFileReader::new(SliceableCursor::new(cursor.data())).unwrap();
+        reader.load_bloom_filters().unwrap();
+        let row_group = reader.metadata().row_group(0);
+        assert!(row_group.column(0).bloom_filter().is_some());
+        assert!(row_group.column(1).bloom_filter().is_none());
+        assert_eq!(reader.prune_row_groups(&predicate).unwrap(), 3);
+        let row = reader.get_row_iter(None).unwrap().next().unwrap();
+        // the row group of 202 also contains other ids
+        assert_eq!(row.get_long(0).unwrap(), 2);
+
+        let mut reader =
+            SerializedFileReader::new(SliceableCursor::new(cursor.data())).unwrap();
+        reader.load_bloom_filters().unwrap();
+        let predicate = Predicate::in_list("id", vec![5_i64, 7]);
+        assert_eq!(reader.prune_row_groups(&predicate).unwrap(), 2);
+        assert_eq!(reader.num_row_groups(), 2);
+    }
 }
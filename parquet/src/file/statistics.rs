@@ -90,7 +90,9 @@ pub fn from_thrift(
 ) -> Option<Statistics> {
     match thrift_stats {
         Some(stats) => {
-            // Number of nulls recorded, when it is not available, we just mark it as 0.
+            // Number of nulls recorded, when it is not available, we just mark it as 0,
+            // and mark it as not set.
+            let null_count_set = stats.null_count.is_some();
             let null_count = stats.null_count.unwrap_or(0);
             assert!(
                 null_count >= 0,
@@ -121,7 +123,7 @@ pub fn from_thrift(
             // variable-length byte arrays do not include a length prefix.
             //
             // Instead of using actual decoder, we manually convert values.
-            let res = match physical_type {
+            let mut res = match physical_type {
                 Type::BOOLEAN => Statistics::boolean(
                     min.map(|data| data[0] != 0),
                     max.map(|data| data[0] != 0),
@@ -186,6 +188,9 @@ pub fn from_thrift(
                     old_format,
                 ),
             };
+            if !null_count_set {
+                res.unset_null_count();
+            }
 
             Some(res)
         }
@@ -200,7 +205,7 @@ pub fn to_thrift(stats: Option<&Statistics>) -> Option<TStatistics> {
     let mut thrift_stats = TStatistics {
         max: None,
         min: None,
-        null_count: if stats.has_nulls() {
+        null_count: if stats.has_null_count_set() {
             Some(stats.null_count() as i64)
         } else {
             None
@@ -292,6 +297,26 @@ impl Statistics {
         self.null_count() > 0
     }
 
+    /// Returns `true` if the number of null values is known. Some writers do not
+    /// record it, and then [`Statistics::null_count`] is 0 whatever the values.
+    pub fn has_null_count_set(&self) -> bool {
+        statistics_enum_func![self, has_null_count_set]
+    }
+
+    /// Marks the number of null values as not recorded.
+    fn unset_null_count(&mut self) {
+        match self {
+            Statistics::Boolean(typed) => typed.null_count_set = false,
+            Statistics::Int32(typed) => typed.null_count_set = false,
+            Statistics::Int64(typed) => typed.null_count_set = false,
+            Statistics::Int96(typed) => typed.null_count_set = false,
+            Statistics::Float(typed) => typed.null_count_set = false,
+            Statistics::Double(typed) => typed.null_count_set = false,
+            Statistics::ByteArray(typed) => typed.null_count_set = false,
+            Statistics::FixedLenByteArray(typed) => typed.null_count_set = false,
+        }
+    }
+
     /// Returns `true` if min value and max value are set.
     /// Normally both min/max values will be set to `Some(value)` or `None`.
     pub fn has_min_max_set(&self) -> bool {
@@ -348,6 +373,8 @@ pub struct TypedStatistics<T: DataType> {
     // Distinct count could be omitted in some cases
     distinct_count: Option<u64>,
     null_count: u64,
+    // Null count could be omitted by other writers
+    null_count_set: bool,
     is_min_max_deprecated: bool,
 }
 
@@ -365,6 +392,7 @@ impl<T: DataType> TypedStatistics<T> {
             max,
             distinct_count,
             null_count,
+            null_count_set: true,
             is_min_max_deprecated,
         }
     }
@@ -417,6 +445,11 @@ impl<T: DataType> TypedStatistics<T> {
         self.null_count
     }
 
+    /// Whether or not the null count is known.
+    fn has_null_count_set(&self) -> bool {
+        self.null_count_set
+    }
+
     /// Returns `true` if statistics were created using old min/max fields.
     fn is_min_max_deprecated(&self) -> bool {
         self.is_min_max_deprecated
@@ -468,6 +501,7 @@ impl<T: DataType> cmp::PartialEq for TypedStatistics<T> {
             && self.max == other.max
             && self.distinct_count == other.distinct_count
             && self.null_count == other.null_count
+            && self.null_count_set == other.null_count_set
             && self.is_min_max_deprecated == other.is_min_max_deprecated
     }
 }
@@ -510,6 +544,26 @@ mod tests {
         from_thrift(Type::INT32, Some(thrift_stats));
     }
 
+    #[test]
+    fn test_statistics_thrift_without_null_count() {
+        let thrift_stats = TStatistics {
+            max: None,
+            min: None,
+            null_count: None,
+            distinct_count: None,
+            max_value: Some(7_i32.to_le_bytes().to_vec()),
+            min_value: Some(1_i32.to_le_bytes().to_vec()),
+        };
+        let stats = from_thrift(Type::INT32, Some(thrift_stats.clone())).unwrap();
+        assert!(stats.has_min_max_set());
+        assert!(!stats.has_null_count_set());
+        assert_eq!(to_thrift(Some(&stats)), Some(thrift_stats));
+
+        let stats = Statistics::int32(Some(1), Some(7), None, 0, false);
+        assert!(stats.has_null_count_set());
+        assert_eq!(to_thrift(Some(&stats)).unwrap().null_count, Some(0));
+    }
+
     #[test]
     fn test_statistics_thrift_none() {
         assert_eq!(from_thrift(Type::INT32, None), None);
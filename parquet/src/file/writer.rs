@@ -34,7 +34,7 @@ use crate::column::{
 };
 use crate::errors::{ParquetError, Result};
 use crate::file::{
-    metadata::*, properties::WriterPropertiesPtr,
+    bloom_filter, metadata::*, properties::WriterPropertiesPtr,
     statistics::to_thrift as statistics_to_thrift, FOOTER_SIZE, PARQUET_MAGIC,
 };
 use crate::schema::types::{self, SchemaDescPtr, SchemaDescriptor, TypePtr};
@@ -109,6 +109,15 @@ pub trait RowGroupWriter {
     /// This should be called before requesting the next column writer.
     fn close_column(&mut self, column_writer: ColumnWriter) -> Result<()>;
 
+    /// Appends a column chunk that was encoded into memory with a
+    /// [`ColumnChunkEncoder`], in place of requesting the next column writer.
+    ///
+    /// This allows the columns of a row group to be encoded concurrently, and then
+    /// appended in schema order.
+    fn append_column(&mut self, _chunk: EncodedColumnChunk) -> Result<()> {
+        Err(nyi_err!("Appending encoded column chunks is not supported"))
+    }
+
     /// Closes this row group writer and returns row group metadata.
     /// After calling this method row group writer must not be used.
     ///
@@ -159,6 +168,16 @@ impl<W: ParquetWriter> SerializedFileWriter<W> {
         })
     }
 
+    /// Returns the descriptor of the schema being written.
+    pub fn schema_descr(&self) -> &SchemaDescPtr {
+        &self.descr
+    }
+
+    /// Returns the properties this writer was created with.
+    pub fn properties(&self) -> &WriterPropertiesPtr {
+        &self.props
+    }
+
     /// Writes magic bytes at the beginning of the file.
     fn start_file(buf: &mut W) -> Result<()> {
         buf.write_all(&PARQUET_MAGIC)?;
@@ -176,18 +195,84 @@ impl<W: ParquetWriter> SerializedFileWriter<W> {
         Ok(())
     }
 
+    /// Writes the Bloom filters of all column chunks that have one, and records their
+    /// locations in `row_groups`.
+    fn write_bloom_filters(
+        &mut self,
+        row_groups: &mut [parquet::RowGroup],
+    ) -> Result<()> {
+        for (row_group, metadata) in row_groups.iter_mut().zip(&self.row_groups) {
+            for (column, column_metadata) in
+                row_group.columns.iter_mut().zip(metadata.columns())
+            {
+                if let Some(bloom_filter) = column_metadata.bloom_filter() {
+                    let offset = self.buf.seek(SeekFrom::Current(0))?;
+                    let bytes = bloom_filter.to_bytes();
+                    self.buf.write_all(&bytes)?;
+                    let column_metadata = column.meta_data.as_mut().unwrap();
+                    column_metadata
+                        .key_value_metadata
+                        .get_or_insert_with(Vec::new)
+                        .extend(bloom_filter::location_to_thrift(
+                            offset as i64,
+                            bytes.len() as i32,
+                        ));
+                }
+            }
+        }
+        Ok(())
+    }
+
+    /// Writes the column indexes and then the offset indexes of all column chunks
+    /// that have a page index, and records their locations in `row_groups`.
+    fn write_page_indexes(&mut self, row_groups: &mut [parquet::RowGroup]) -> Result<()> {
+        for (row_group, metadata) in row_groups.iter_mut().zip(&self.row_groups) {
+            for (column, column_metadata) in
+                row_group.columns.iter_mut().zip(metadata.columns())
+            {
+                let column_index = column_metadata
+                    .page_index()
+                    .and_then(|page_index| page_index.column_index());
+                if let Some(column_index) = column_index {
+                    let (offset, length) = write_thrift(&mut self.buf, |protocol| {
+                        column_index.to_thrift().write_to_out_protocol(protocol)
+                    })?;
+                    column.column_index_offset = Some(offset);
+                    column.column_index_length = Some(length);
+                }
+            }
+        }
+
+        for (row_group, metadata) in row_groups.iter_mut().zip(&self.row_groups) {
+            for (column, column_metadata) in
+                row_group.columns.iter_mut().zip(metadata.columns())
+            {
+                if let Some(page_index) = column_metadata.page_index() {
+                    let (offset, length) = write_thrift(&mut self.buf, |protocol| {
+                        page_index
+                            .offset_index()
+                            .to_thrift()
+                            .write_to_out_protocol(protocol)
+                    })?;
+                    column.offset_index_offset = Some(offset);
+                    column.offset_index_length = Some(length);
+                }
+            }
+        }
+
+        Ok(())
+    }
+
     /// Assembles and writes metadata at the end of the file.
-    fn write_metadata(&mut self) -> Result<parquet::FileMetaData> {
+    fn write_metadata(
+        &mut self,
+        row_groups: Vec<parquet::RowGroup>,
+    ) -> Result<parquet::FileMetaData> {
         let file_metadata = parquet::FileMetaData {
             version: self.props.writer_version().as_num(),
             schema: types::to_thrift(self.schema.as_ref())?,
             num_rows: self.total_num_rows as i64,
-            row_groups: self
-                .row_groups
-                .as_slice()
-                .iter()
-                .map(|v| v.to_thrift())
-                .collect(),
+            row_groups,
             key_value_metadata: self.props.key_value_metadata().to_owned(),
             created_by: Some(self.props.created_by().to_owned()),
             column_orders: None,
@@ -259,7 +344,11 @@ impl<W: 'static + ParquetWriter> FileWriter for SerializedFileWriter<W> {
     fn close(&mut self) -> Result<parquet::FileMetaData> {
         self.assert_closed()?;
         self.assert_previous_writer_closed()?;
-        let metadata = self.write_metadata()?;
+        let mut row_groups: Vec<parquet::RowGroup> =
+            self.row_groups.iter().map(|v| v.to_thrift()).collect();
+        self.write_bloom_filters(&mut row_groups)?;
+        self.write_page_indexes(&mut row_groups)?;
+        let metadata = self.write_metadata(row_groups)?;
         self.is_closed = true;
         Ok(metadata)
     }
@@ -302,18 +391,49 @@ impl<W: 'static + ParquetWriter> SerializedRowGroupWriter<W> {
 
     /// Checks and finalises current column writer.
     fn finalise_column_writer(&mut self, writer: ColumnWriter) -> Result<()> {
-        let (bytes_written, rows_written, metadata) = match writer {
-            ColumnWriter::BoolColumnWriter(typed) => typed.close()?,
-            ColumnWriter::Int32ColumnWriter(typed) => typed.close()?,
-            ColumnWriter::Int64ColumnWriter(typed) => typed.close()?,
-            ColumnWriter::Int96ColumnWriter(typed) => typed.close()?,
-            ColumnWriter::FloatColumnWriter(typed) => typed.close()?,
-            ColumnWriter::DoubleColumnWriter(typed) => typed.close()?,
-            ColumnWriter::ByteArrayColumnWriter(typed) => typed.close()?,
-            ColumnWriter::FixedLenByteArrayColumnWriter(typed) => typed.close()?,
-        };
+        let (bytes_written, rows_written, metadata) = close_column_writer(writer)?;
+        self.update_metrics(bytes_written, rows_written, metadata)
+    }
 
-        // Update row group writer metrics
+    /// Writes an encoded column chunk to the sink, and finalises its metadata.
+    fn write_encoded_column(&mut self, chunk: EncodedColumnChunk) -> Result<()> {
+        let EncodedColumnChunk {
+            data,
+            bytes_written,
+            rows_written,
+            mut metadata,
+        } = chunk;
+
+        let expected_path = self.descr.column(self.column_index).path().clone();
+        if metadata.column_path() != &expected_path {
+            return Err(general_err!(
+                "Expected column chunk for {}, found {}",
+                expected_path,
+                metadata.column_path()
+            ));
+        }
+
+        let mut sink = FileSink::new(&self.buf);
+        metadata.shift_offsets(sink.pos() as i64);
+        sink.write_all(&data)?;
+        {
+            let mut protocol = TCompactOutputProtocol::new(&mut sink);
+            metadata.to_thrift().write_to_out_protocol(&mut protocol)?;
+            protocol.flush()?;
+        }
+        sink.flush()?;
+
+        self.column_index += 1;
+        self.update_metrics(bytes_written, rows_written, metadata)
+    }
+
+    /// Updates row group writer metrics with a closed column chunk.
+    fn update_metrics(
+        &mut self,
+        bytes_written: u64,
+        rows_written: u64,
+        metadata: ColumnChunkMetaData,
+    ) -> Result<()> {
         self.total_bytes_written += bytes_written;
         self.column_chunks.push(metadata);
         if let Some(rows) = self.total_rows_written {
@@ -379,6 +499,19 @@ impl<W: 'static + ParquetWriter> RowGroupWriter for SerializedRowGroupWriter<W>
         res
     }
 
+    fn append_column(&mut self, chunk: EncodedColumnChunk) -> Result<()> {
+        self.assert_closed()?;
+        self.assert_previous_writer_closed()?;
+
+        if self.column_index >= self.descr.num_columns() {
+            return Err(general_err!(
+                "Cannot append column chunk, all {} columns have been written",
+                self.descr.num_columns()
+            ));
+        }
+        self.write_encoded_column(chunk)
+    }
+
     #[inline]
     fn close(&mut self) -> Result<RowGroupMetaDataPtr> {
         if self.row_group_metadata.is_none() {
@@ -399,6 +532,173 @@ impl<W: 'static + ParquetWriter> RowGroupWriter for SerializedRowGroupWriter<W>
     }
 }
 
+/// Writes a thrift structure to `buf`, and returns its offset and length in bytes.
+fn write_thrift<W, F>(buf: &mut W, write: F) -> Result<(i64, i32)>
+where
+    W: Write + Seek,
+    F: FnOnce(&mut TCompactOutputProtocol<&mut W>) -> thrift::Result<()>,
+{
+    let start_pos = buf.seek(SeekFrom::Current(0))?;
+    {
+        let mut protocol = TCompactOutputProtocol::new(&mut *buf);
+        write(&mut protocol)?;
+        protocol.flush()?;
+    }
+    let end_pos = buf.seek(SeekFrom::Current(0))?;
+    Ok((start_pos as i64, (end_pos - start_pos) as i32))
+}
+
+/// Closes a column writer, returning total bytes written, total rows written and
+/// column chunk metadata.
+fn close_column_writer(writer: ColumnWriter) -> Result<(u64, u64, ColumnChunkMetaData)> {
+    match writer {
+        ColumnWriter::BoolColumnWriter(typed) => typed.close(),
+        ColumnWriter::Int32ColumnWriter(typed) => typed.close(),
+        ColumnWriter::Int64ColumnWriter(typed) => typed.close(),
+        ColumnWriter::Int96ColumnWriter(typed) => typed.close(),
+        ColumnWriter::FloatColumnWriter(typed) => typed.close(),
+        ColumnWriter::DoubleColumnWriter(typed) => typed.close(),
+        ColumnWriter::ByteArrayColumnWriter(typed) => typed.close(),
+        ColumnWriter::FixedLenByteArrayColumnWriter(typed) => typed.close(),
+    }
+}
+
+/// A column chunk whose pages have been encoded and compressed into memory.
+///
+/// Offsets in its metadata are relative to the start of the buffer, and are fixed up
+/// when the chunk is appended to a row group with [`RowGroupWriter::append_column`].
+pub struct EncodedColumnChunk {
+    data: Vec<u8>,
+    bytes_written: u64,
+    rows_written: u64,
+    metadata: ColumnChunkMetaData,
+}
+
+impl EncodedColumnChunk {
+    /// Returns the encoded pages of this column chunk.
+    pub fn data(&self) -> &[u8] {
+        &self.data
+    }
+
+    /// Returns the number of rows in this column chunk.
+    pub fn rows_written(&self) -> u64 {
+        self.rows_written
+    }
+
+    /// Returns the metadata of this column chunk.
+    pub fn metadata(&self) -> &ColumnChunkMetaData {
+        &self.metadata
+    }
+}
+
+/// Encodes consecutive columns of a row group into in-memory [`EncodedColumnChunk`]s.
+///
+/// The workflow mirrors [`RowGroupWriter`]: request a column writer with
+/// `next_column`, write to it, and close it with `close_column`. Unlike a row group
+/// writer, an encoder does not need access to the file, so several encoders can
+/// run concurrently on different columns of the same row group.
+pub struct ColumnChunkEncoder {
+    descr: SchemaDescPtr,
+    props: WriterPropertiesPtr,
+    column_index: usize,
+    end_column_index: usize,
+    buffer: Option<InMemoryWriteableCursor>,
+    chunks: Vec<EncodedColumnChunk>,
+}
+
+impl ColumnChunkEncoder {
+    /// Creates an encoder for the columns of `schema_descr` from `column_index`
+    /// onwards.
+    pub fn new(
+        schema_descr: SchemaDescPtr,
+        properties: WriterPropertiesPtr,
+        column_index: usize,
+    ) -> Self {
+        let end_column_index = schema_descr.num_columns();
+        Self {
+            descr: schema_descr,
+            props: properties,
+            column_index,
+            end_column_index,
+            buffer: None,
+            chunks: vec![],
+        }
+    }
+
+    /// Returns the column writer of the next column, if available; otherwise
+    /// returns `None`.
+    ///
+    /// The previous column writer must be closed using `close_column`.
+    pub fn next_column(&mut self) -> Result<Option<ColumnWriter>> {
+        if self.buffer.is_some() {
+            return Err(general_err!("Previous column writer was not closed"));
+        }
+        if self.column_index >= self.end_column_index {
+            return Ok(None);
+        }
+        let buffer = InMemoryWriteableCursor::default();
+        let page_writer = Box::new(InMemoryPageWriter {
+            inner: SerializedPageWriter::new(FileSink::new(&buffer)),
+        });
+        let column_writer = get_column_writer(
+            self.descr.column(self.column_index),
+            self.props.clone(),
+            page_writer,
+        );
+        self.column_index += 1;
+        self.buffer = Some(buffer);
+
+        Ok(Some(column_writer))
+    }
+
+    /// Closes column writer that was created using `next_column` method, and
+    /// keeps its encoded column chunk.
+    pub fn close_column(&mut self, column_writer: ColumnWriter) -> Result<()> {
+        let buffer = self
+            .buffer
+            .take()
+            .ok_or_else(|| general_err!("No column writer to close"))?;
+        let (bytes_written, rows_written, metadata) = close_column_writer(column_writer)?;
+        let data = buffer
+            .into_inner()
+            .ok_or_else(|| general_err!("Column chunk buffer is still in use"))?;
+        self.chunks.push(EncodedColumnChunk {
+            data,
+            bytes_written,
+            rows_written,
+            metadata,
+        });
+        Ok(())
+    }
+
+    /// Returns the column chunks encoded so far, in schema order.
+    pub fn into_chunks(self) -> Vec<EncodedColumnChunk> {
+        self.chunks
+    }
+}
+
+/// A [`PageWriter`] that writes pages into a column chunk buffer.
+///
+/// Column chunk metadata is not written, as its offsets are only known once the
+/// chunk is appended to a row group.
+struct InMemoryPageWriter {
+    inner: SerializedPageWriter<FileSink<InMemoryWriteableCursor>>,
+}
+
+impl PageWriter for InMemoryPageWriter {
+    fn write_page(&mut self, page: CompressedPage) -> Result<PageWriteSpec> {
+        self.inner.write_page(page)
+    }
+
+    fn write_metadata(&mut self, _metadata: &ColumnChunkMetaData) -> Result<()> {
+        Ok(())
+    }
+
+    fn close(&mut self) -> Result<()> {
+        self.inner.close()
+    }
+}
+
 /// A serialized implementation for Parquet [`PageWriter`].
 /// Writes and serializes pages and metadata into output stream.
 ///
@@ -543,6 +843,8 @@ mod tests {
     use crate::column::page::PageReader;
     use crate::compression::{create_codec, Codec};
     use crate::file::{
+        bloom_filter::read_bloom_filter,
+        page_index::read_page_index,
         properties::{WriterProperties, WriterVersion},
         reader::{FileReader, SerializedFileReader, SerializedPageReader},
         statistics::{from_thrift, to_thrift, Statistics},
@@ -666,6 +968,259 @@ mod tests {
         }
     }
 
+    #[test]
+    fn test_row_group_writer_append_encoded_columns() {
+        let file = get_temp_file("test_row_group_writer_append_encoded_columns", &[]);
+        let schema = Arc::new(
+            types::Type::group_type_builder("schema")
+                .with_fields(&mut vec![
+                    Arc::new(
+                        types::Type::primitive_type_builder("col1", Type::INT32)
+                            .with_repetition(Repetition::REQUIRED)
+                            .build()
+                            .unwrap(),
+                    ),
+                    Arc::new(
+                        types::Type::primitive_type_builder("col2", Type::INT32)
+                            .with_repetition(Repetition::REQUIRED)
+                            .build()
+                            .unwrap(),
+                    ),
+                ])
+                .build()
+                .unwrap(),
+        );
+        let props = Arc::new(WriterProperties::builder().build());
+        let mut writer =
+            SerializedFileWriter::new(file.try_clone().unwrap(), schema, props).unwrap();
+
+        // encode the second column first, as if on another thread
+        let mut encoder = ColumnChunkEncoder::new(
+            writer.schema_descr().clone(),
+            writer.properties().clone(),
+            1,
+        );
+        let mut col_writer = encoder.next_column().unwrap().unwrap();
+        if let ColumnWriter::Int32ColumnWriter(ref mut typed) = col_writer {
+            typed.write_batch(&[4, 5, 6], None, None).unwrap();
+        }
+        encoder.close_column(col_writer).unwrap();
+        assert!(encoder.next_column().unwrap().is_none());
+        let mut chunks = encoder.into_chunks();
+        assert_eq!(chunks.len(), 1);
+        assert_eq!(chunks[0].rows_written(), 3);
+        let chunk = chunks.pop().unwrap();
+
+        let mut row_group_writer = writer.next_row_group().unwrap();
+        let mut col_writer = row_group_writer.next_column().unwrap().unwrap();
+        if let ColumnWriter::Int32ColumnWriter(ref mut typed) = col_writer {
+            typed.write_batch(&[1, 2, 3], None, None).unwrap();
+        }
+        row_group_writer.close_column(col_writer).unwrap();
+        row_group_writer.append_column(chunk).unwrap();
+        writer.close_row_group(row_group_writer).unwrap();
+        writer.close().unwrap();
+
+        let reader = SerializedFileReader::new(file).unwrap();
+        let res = reader
+            .get_row_iter(None)
+            .unwrap()
+            .map(|row| (row.get_int(0).unwrap(), row.get_int(1).unwrap()))
+            .collect::<Vec<_>>();
+        assert_eq!(res, vec![(1, 4), (2, 5), (3, 6)]);
+    }
+
+    #[test]
+    fn test_file_writer_page_index() {
+        let file = get_temp_file("test_file_writer_page_index", &[]);
+        let schema = Arc::new(
+            types::Type::group_type_builder("schema")
+                .with_fields(&mut vec![
+                    Arc::new(
+                        types::Type::primitive_type_builder("col1", Type::INT32)
+                            .with_repetition(Repetition::REQUIRED)
+                            .build()
+                            .unwrap(),
+                    ),
+                    Arc::new(
+                        types::Type::primitive_type_builder("col2", Type::INT32)
+                            .with_repetition(Repetition::REQUIRED)
+                            .build()
+                            .unwrap(),
+                    ),
+                ])
+                .build()
+                .unwrap(),
+        );
+        let props = Arc::new(
+            WriterProperties::builder()
+                .set_dictionary_enabled(false)
+                .set_data_pagesize_limit(1)
+                .set_write_batch_size(2)
+                .set_page_index_enabled(true)
+                .build(),
+        );
+        let mut writer =
+            SerializedFileWriter::new(file.try_clone().unwrap(), schema, props).unwrap();
+
+        for row_group in 0..2 {
+            let values: Vec<i32> = (0..6).map(|v| v + row_group * 10).collect();
+            // the second column is encoded into memory, so that its page index is
+            // shifted when it is appended
+            let mut encoder = ColumnChunkEncoder::new(
+                writer.schema_descr().clone(),
+                writer.properties().clone(),
+                1,
+            );
+            let mut col_writer = encoder.next_column().unwrap().unwrap();
+            if let ColumnWriter::Int32ColumnWriter(ref mut typed) = col_writer {
+                typed.write_batch(&values, None, None).unwrap();
+            }
+            encoder.close_column(col_writer).unwrap();
+            let chunk = encoder.into_chunks().pop().unwrap();
+
+            let mut row_group_writer = writer.next_row_group().unwrap();
+            let mut col_writer = row_group_writer.next_column().unwrap().unwrap();
+            if let ColumnWriter::Int32ColumnWriter(ref mut typed) = col_writer {
+                typed.write_batch(&values, None, None).unwrap();
+            }
+            row_group_writer.close_column(col_writer).unwrap();
+            row_group_writer.append_column(chunk).unwrap();
+            writer.close_row_group(row_group_writer).unwrap();
+        }
+        writer.close().unwrap();
+
+        let reader = SerializedFileReader::new(file.try_clone().unwrap()).unwrap();
+        for (i, row_group) in reader.metadata().row_groups().iter().enumerate() {
+            for column in row_group.columns() {
+                let page_index = read_page_index(&file, column).unwrap().unwrap();
+                let locations = page_index.offset_index().page_locations();
+                assert_eq!(locations.len(), 3);
+                assert_eq!(locations[0].offset, column.data_page_offset());
+                for (page, location) in locations.iter().enumerate() {
+                    assert_eq!(location.first_row_index, 2 * page as i64);
+                    if page > 0 {
+                        let previous = &locations[page - 1];
+                        assert_eq!(
+                            location.offset,
+                            previous.offset + previous.compressed_page_size as i64
+                        );
+                    }
+                }
+
+                let column_index = page_index.column_index().unwrap();
+                let min = 10 * i as i32 + 2;
+                assert_eq!(
+                    column_index.page_statistics(Type::INT32, 1),
+                    Some(Statistics::int32(Some(min), Some(min + 1), None, 0, false))
+                );
+            }
+        }
+    }
+
+    #[test]
+    fn test_file_writer_bloom_filter() {
+        let file = get_temp_file("test_file_writer_bloom_filter", &[]);
+        let schema = Arc::new(
+            types::Type::group_type_builder("schema")
+                .with_fields(&mut vec![
+                    Arc::new(
+                        types::Type::primitive_type_builder("col1", Type::INT64)
+                            .with_repetition(Repetition::REQUIRED)
+                            .build()
+                            .unwrap(),
+                    ),
+                    Arc::new(
+                        types::Type::primitive_type_builder("col2", Type::INT64)
+                            .with_repetition(Repetition::REQUIRED)
+                            .build()
+                            .unwrap(),
+                    ),
+                ])
+                .build()
+                .unwrap(),
+        );
+        let props = Arc::new(
+            WriterProperties::builder()
+                .set_page_index_enabled(true)
+                .set_column_bloom_filter_enabled(types::ColumnPath::from("col1"), true)
+                .set_column_bloom_filter_ndv(types::ColumnPath::from("col1"), 100)
+                .build(),
+        );
+        let mut writer =
+            SerializedFileWriter::new(file.try_clone().unwrap(), schema, props).unwrap();
+        for row_group in 0..2 {
+            let values: Vec<i64> = (0..100).map(|v| v * 2 + row_group * 1000).collect();
+            let mut row_group_writer = writer.next_row_group().unwrap();
+            while let Some(mut col_writer) = row_group_writer.next_column().unwrap() {
+                if let ColumnWriter::Int64ColumnWriter(ref mut typed) = col_writer {
+                    typed.write_batch(&values, None, None).unwrap();
+                }
+                row_group_writer.close_column(col_writer).unwrap();
+            }
+            writer.close_row_group(row_group_writer).unwrap();
+        }
+        writer.close().unwrap();
+
+        let reader = SerializedFileReader::new(file.try_clone().unwrap()).unwrap();
+        for (i, row_group) in reader.metadata().row_groups().iter().enumerate() {
+            let column = row_group.column(0);
+            assert_eq!(column.bloom_filter_range().unwrap().1, 128);
+            let bloom_filter = read_bloom_filter(&file, column).unwrap().unwrap();
+            let offset = i as i64 * 1000;
+            assert!((0..100).all(|v| bloom_filter.check(&(v * 2 + offset))));
+            assert!(!bloom_filter.check(&(offset + 1)));
+            assert!(read_page_index(&file, column).unwrap().is_some());
+
+            let column = row_group.column(1);
+            assert!(column.bloom_filter_range().is_none());
+            assert!(read_bloom_filter(&file, column).unwrap().is_none());
+        }
+    }
+
+    #[test]
+    fn test_row_group_writer_append_wrong_column() {
+        let file = get_temp_file("test_row_group_writer_append_wrong_column", &[]);
+        let schema = Arc::new(
+            types::Type::group_type_builder("schema")
+                .with_fields(&mut vec![
+                    Arc::new(
+                        types::Type::primitive_type_builder("col1", Type::INT32)
+                            .build()
+                            .unwrap(),
+                    ),
+                    Arc::new(
+                        types::Type::primitive_type_builder("col2", Type::INT32)
+                            .build()
+                            .unwrap(),
+                    ),
+                ])
+                .build()
+                .unwrap(),
+        );
+        let props = Arc::new(WriterProperties::builder().build());
+        let mut writer = SerializedFileWriter::new(file, schema, props).unwrap();
+
+        let mut encoder = ColumnChunkEncoder::new(
+            writer.schema_descr().clone(),
+            writer.properties().clone(),
+            1,
+        );
+        let col_writer = encoder.next_column().unwrap().unwrap();
+        encoder.close_column(col_writer).unwrap();
+        let chunk = encoder.into_chunks().pop().unwrap();
+
+        let mut row_group_writer = writer.next_row_group().unwrap();
+        let res = row_group_writer.append_column(chunk);
+        assert!(res.is_err());
+        if let Err(err) = res {
+            assert_eq!(
+                format!("{}", err),
+                "Parquet error: Expected column chunk for \"col1\", found \"col2\""
+            );
+        }
+    }
+
     #[test]
     fn test_file_writer_empty_file() {
         let file = get_temp_file("test_file_writer_write_empty_file", &[]);
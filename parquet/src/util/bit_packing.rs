@@ -15,6 +15,58 @@
 // specific language governing permissions and limitations
 // under the License.
 
+use std::cmp;
+
+/// Unpacks as many blocks of 32 values with bit width `num_bits` as both `in_buf` and
+/// `out` have room for, and returns the number of values unpacked, a multiple of 32.
+/// The blocks take `4 * num_bits` bytes each.
+///
+/// Uses the AVX2 instructions of the CPU if it has them, for bit widths up to 25 and
+/// for the blocks followed by at least 16 bytes of `in_buf`.
+pub fn unpack32_batch(in_buf: &[u8], out: &mut [u32], num_bits: usize) -> usize {
+    assert!(num_bits <= 32);
+    if num_bits == 0 {
+        let num_values = out.len() / 32 * 32;
+        for value in &mut out[..num_values] {
+            *value = 0;
+        }
+        return num_values;
+    }
+
+    let block_size = 4 * num_bits;
+    let num_blocks = cmp::min(in_buf.len() / block_size, out.len() / 32);
+    #[allow(unused_mut)]
+    let mut block = 0;
+
+    #[cfg(any(target_arch = "x86", target_arch = "x86_64"))]
+    {
+        if num_bits <= avx2::MAX_BITS && is_x86_feature_detected!("avx2") {
+            block = cmp::min(
+                num_blocks,
+                in_buf.len().saturating_sub(avx2::PADDING) / block_size,
+            );
+            // SAFETY: the CPU supports AVX2, and `in_buf` has `avx2::PADDING` bytes
+            // after the `block` blocks
+            unsafe {
+                avx2::unpack(in_buf.as_ptr(), out.as_mut_ptr(), num_bits, block * 4)
+            };
+        }
+    }
+
+    while block < num_blocks {
+        // SAFETY: `in_buf` and `out` have room for the block
+        unsafe {
+            unpack32(
+                in_buf[block * block_size..].as_ptr() as *const u32,
+                out[block * 32..].as_mut_ptr(),
+                num_bits,
+            )
+        };
+        block += 1;
+    }
+    num_blocks * 32
+}
+
 /// Unpack 32 values with bit width `num_bits` from `in_ptr`, and write to `out_ptr`.
 /// Return the `in_ptr` where the starting offset points to the first byte after all the
 /// bytes that were consumed.
@@ -22,9 +74,6 @@
 //  However, this may require const generics:
 //     https://github.com/rust-lang/rust/issues/44580
 //  to eliminate the branching cost.
-// TODO: we should use SIMD instructions to further optimize this. I have explored
-//    https://github.com/tantivy-search/bitpacking
-// but the layout it uses for SIMD is different from Parquet.
 // TODO: support packing as well, which is used for encoding.
 pub unsafe fn unpack32(
     mut in_ptr: *const u32,
@@ -3660,3 +3709,120 @@ unsafe fn unpack32_32(mut in_buf: *const u32, mut out: *mut u32) -> *const u32 {
 
     in_buf.offset(1)
 }
+
+#[cfg(any(target_arch = "x86", target_arch = "x86_64"))]
+mod avx2 {
+    #[cfg(target_arch = "x86")]
+    use std::arch::x86::*;
+    #[cfg(target_arch = "x86_64")]
+    use std::arch::x86_64::*;
+
+    /// The largest bit width whose values all fit in the 4 bytes from the byte they
+    /// start in.
+    pub const MAX_BITS: usize = 25;
+
+    /// The number of bytes after the unpacked values which `unpack` may read.
+    pub const PADDING: usize = 16;
+
+    /// Unpacks `num_groups` groups of 8 values with bit width `num_bits` from `in_ptr`,
+    /// and writes them to `out_ptr`.
+    ///
+    /// 8 values take `num_bits` bytes, so all the groups have the same layout: the
+    /// low 128-bit lane shuffles the 4 bytes which each of the first 4 values starts in
+    /// into a 32-bit word, from the bytes at the start of the group, and the high lane
+    /// those of the last 4 values, from the byte which the fifth value starts in. The
+    /// words are then shifted by the bit offsets of the values, and masked.
+    ///
+    /// # Safety
+    ///
+    /// The CPU must support AVX2, `num_bits` must be between 1 and `MAX_BITS`,
+    /// `in_ptr` must be valid for reading `num_groups * num_bits + PADDING` bytes and
+    /// `out_ptr` for writing `num_groups * 8` values.
+    #[target_feature(enable = "avx2")]
+    pub unsafe fn unpack(
+        in_ptr: *const u8,
+        out_ptr: *mut u32,
+        num_bits: usize,
+        num_groups: usize,
+    ) {
+        debug_assert!(num_bits >= 1 && num_bits <= MAX_BITS);
+        let high_lane_offset = 4 * num_bits / 8;
+
+        let mut shuffle = [0u8; 32];
+        let mut shifts = [0u32; 8];
+        for i in 0..8 {
+            let bit = i * num_bits;
+            let start = if i < 4 {
+                bit / 8
+            } else {
+                bit / 8 - high_lane_offset
+            };
+            for j in 0..4 {
+                shuffle[i * 4 + j] = (start + j) as u8;
+            }
+            shifts[i] = (bit % 8) as u32;
+        }
+        let shuffle = _mm256_loadu_si256(shuffle.as_ptr() as *const __m256i);
+        let shifts = _mm256_loadu_si256(shifts.as_ptr() as *const __m256i);
+        let mask = _mm256_set1_epi32(((1u32 << num_bits) - 1) as i32);
+
+        for group in 0..num_groups {
+            let in_ptr = in_ptr.add(group * num_bits);
+            let low = _mm_loadu_si128(in_ptr as *const __m128i);
+            let high = _mm_loadu_si128(in_ptr.add(high_lane_offset) as *const __m128i);
+            let bytes = _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+            let words = _mm256_shuffle_epi8(bytes, shuffle);
+            let values = _mm256_and_si256(_mm256_srlv_epi32(words, shifts), mask);
+            _mm256_storeu_si256(out_ptr.add(group * 8) as *mut __m256i, values);
+        }
+    }
+}
+
+#[cfg(test)]
+mod tests {
+    use super::*;
+
+    use rand::{thread_rng, Rng};
+
+    fn unpack_bits(in_buf: &[u8], num_bits: usize, num_values: usize) -> Vec<u32> {
+        (0..num_values)
+            .map(|i| {
+                (0..num_bits).fold(0, |value, j| {
+                    let bit = i * num_bits + j;
+                    value | (((in_buf[bit / 8] >> (bit % 8)) as u32 & 1) << j)
+                })
+            })
+            .collect()
+    }
+
+    #[test]
+    fn test_unpack32_batch() {
+        let mut rng = thread_rng();
+        for num_bits in 0..=32 {
+            // without and with room for the blocks to be read with SIMD instructions
+            for &extra_bytes in &[0, 5, 16, 40] {
+                let num_blocks = 5;
+                let in_buf: Vec<u8> = (0..num_blocks * 4 * num_bits + extra_bytes)
+                    .map(|_| rng.gen())
+                    .collect();
+                let mut out = vec![1u32; num_blocks * 32 + 7];
+
+                let num_values = unpack32_batch(&in_buf, &mut out, num_bits);
+                let expected_blocks = if num_bits == 0 {
+                    num_blocks
+                } else {
+                    cmp::min(in_buf.len() / (4 * num_bits), num_blocks)
+                };
+                assert_eq!(num_values, expected_blocks * 32);
+                assert_eq!(
+                    &out[..num_values],
+                    unpack_bits(&in_buf, num_bits, num_values).as_slice(),
+                    "num_bits: {}, extra_bytes: {}",
+                    num_bits,
+                    extra_bytes
+                );
+                assert!(out[num_values..].iter().all(|value| *value == 1));
+            }
+        }
+    }
+}
@@ -19,7 +19,7 @@ use std::{cmp, mem::size_of};
 
 use crate::data_type::AsBytes;
 use crate::errors::{ParquetError, Result};
-use crate::util::{bit_packing::unpack32, memory::ByteBufferPtr};
+use crate::util::{bit_packing::unpack32_batch, memory::ByteBufferPtr};
 
 #[inline]
 pub fn from_ne_slice<T: FromBytes>(bs: &[u8]) -> T {
@@ -536,26 +536,29 @@ impl BitReader {
             }
         }
 
-        unsafe {
-            let in_buf = &self.buffer.data()[self.byte_offset..];
-            let mut in_ptr = in_buf as *const [u8] as *const u8 as *const u32;
-            // FIXME assert!(memory::is_ptr_aligned(in_ptr));
-            if size_of::<T>() == 4 {
-                while values_to_read - i >= 32 {
-                    let out_ptr = &mut batch[i..] as *mut [T] as *mut T as *mut u32;
-                    in_ptr = unpack32(in_ptr, out_ptr, num_bits);
-                    self.byte_offset += 4 * num_bits;
-                    i += 32;
-                }
-            } else {
-                let mut out_buf = [0u32; 32];
-                let out_ptr = &mut out_buf as &mut [u32] as *mut [u32] as *mut u32;
-                while values_to_read - i >= 32 {
-                    in_ptr = unpack32(in_ptr, out_ptr, num_bits);
-                    self.byte_offset += 4 * num_bits;
-                    for n in 0..32 {
-                        // We need to copy from smaller size to bigger size to avoid
-                        // overwriting other memory regions.
+        let in_buf = &self.buffer.data()[self.byte_offset..self.total_bytes];
+        if size_of::<T>() == 4 {
+            // SAFETY: `T` is a 32-bit integer type
+            let out = unsafe {
+                std::slice::from_raw_parts_mut(
+                    batch[i..].as_mut_ptr() as *mut u32,
+                    values_to_read - i,
+                )
+            };
+            let num_values = unpack32_batch(in_buf, out, num_bits);
+            self.byte_offset += num_values * num_bits / 8;
+            i += num_values;
+        } else {
+            let mut out_buf = [0u32; 32];
+            let mut in_buf = in_buf;
+            while values_to_read - i >= 32 {
+                unpack32_batch(in_buf, &mut out_buf, num_bits);
+                in_buf = &in_buf[4 * num_bits..];
+                self.byte_offset += 4 * num_bits;
+                for n in 0..32 {
+                    // We need to copy from smaller size to bigger size to avoid
+                    // overwriting other memory regions.
+                    unsafe {
                         if size_of::<T>() > size_of::<u32>() {
                             std::ptr::copy_nonoverlapping(
                                 out_buf[n..].as_ptr() as *const u32,
@@ -569,8 +572,8 @@ impl BitReader {
                                 1,
                             );
                         }
-                        i += 1;
                     }
+                    i += 1;
                 }
             }
         }
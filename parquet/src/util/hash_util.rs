@@ -15,6 +15,8 @@
 // specific language governing permissions and limitations
 // under the License.
 
+use byteorder::{ByteOrder, LittleEndian};
+
 use crate::data_type::AsBytes;
 
 /// Computes hash value for `data`, with a seed value `seed`.
@@ -97,6 +99,87 @@ unsafe fn murmur_hash2_64a(data_bytes: &[u8], seed: u64) -> u64 {
     h
 }
 
+const XXH_PRIME64_1: u64 = 0x9E3779B185EBCA87;
+const XXH_PRIME64_2: u64 = 0xC2B2AE3D27D4EB4F;
+const XXH_PRIME64_3: u64 = 0x165667B19E3779F9;
+const XXH_PRIME64_4: u64 = 0x85EBCA77C2B2AE63;
+const XXH_PRIME64_5: u64 = 0x27D4EB2F165667C5;
+
+/// Rust implementation of XXH64, the 64-bit version of xxHash.
+///
+/// Unlike [`hash`], the result does not depend on the platform, and it is the hash
+/// function that the Parquet format specifies for Bloom filters.
+pub fn xxhash64(data: &[u8], seed: u64) -> u64 {
+    let mut rest = data;
+    let mut h = if data.len() >= 32 {
+        let mut v1 = seed.wrapping_add(XXH_PRIME64_1).wrapping_add(XXH_PRIME64_2);
+        let mut v2 = seed.wrapping_add(XXH_PRIME64_2);
+        let mut v3 = seed;
+        let mut v4 = seed.wrapping_sub(XXH_PRIME64_1);
+        while rest.len() >= 32 {
+            v1 = xxh64_round(v1, LittleEndian::read_u64(&rest[0..8]));
+            v2 = xxh64_round(v2, LittleEndian::read_u64(&rest[8..16]));
+            v3 = xxh64_round(v3, LittleEndian::read_u64(&rest[16..24]));
+            v4 = xxh64_round(v4, LittleEndian::read_u64(&rest[24..32]));
+            rest = &rest[32..];
+        }
+        let mut h = v1
+            .rotate_left(1)
+            .wrapping_add(v2.rotate_left(7))
+            .wrapping_add(v3.rotate_left(12))
+            .wrapping_add(v4.rotate_left(18));
+        h = xxh64_merge_round(h, v1);
+        h = xxh64_merge_round(h, v2);
+        h = xxh64_merge_round(h, v3);
+        xxh64_merge_round(h, v4)
+    } else {
+        seed.wrapping_add(XXH_PRIME64_5)
+    };
+
+    h = h.wrapping_add(data.len() as u64);
+    while rest.len() >= 8 {
+        h ^= xxh64_round(0, LittleEndian::read_u64(&rest[0..8]));
+        h = h
+            .rotate_left(27)
+            .wrapping_mul(XXH_PRIME64_1)
+            .wrapping_add(XXH_PRIME64_4);
+        rest = &rest[8..];
+    }
+    if rest.len() >= 4 {
+        h ^= (LittleEndian::read_u32(&rest[0..4]) as u64).wrapping_mul(XXH_PRIME64_1);
+        h = h
+            .rotate_left(23)
+            .wrapping_mul(XXH_PRIME64_2)
+            .wrapping_add(XXH_PRIME64_3);
+        rest = &rest[4..];
+    }
+    for byte in rest {
+        h ^= (*byte as u64).wrapping_mul(XXH_PRIME64_5);
+        h = h.rotate_left(11).wrapping_mul(XXH_PRIME64_1);
+    }
+
+    h ^= h >> 33;
+    h = h.wrapping_mul(XXH_PRIME64_2);
+    h ^= h >> 29;
+    h = h.wrapping_mul(XXH_PRIME64_3);
+    h ^= h >> 32;
+    h
+}
+
+#[inline]
+fn xxh64_round(acc: u64, input: u64) -> u64 {
+    acc.wrapping_add(input.wrapping_mul(XXH_PRIME64_2))
+        .rotate_left(31)
+        .wrapping_mul(XXH_PRIME64_1)
+}
+
+#[inline]
+fn xxh64_merge_round(acc: u64, value: u64) -> u64 {
+    (acc ^ xxh64_round(0, value))
+        .wrapping_mul(XXH_PRIME64_1)
+        .wrapping_add(XXH_PRIME64_4)
+}
+
 /// CRC32 hash implementation using SSE4 instructions. Borrowed from Impala.
 #[cfg(any(target_arch = "x86", target_arch = "x86_64"))]
 #[target_feature(enable = "sse4.2")]
@@ -169,4 +252,15 @@ mod tests {
             }
         }
     }
+
+    #[test]
+    fn test_xxhash64() {
+        assert_eq!(xxhash64(b"", 0), 0xEF46DB3751D8E999);
+        assert_eq!(xxhash64(b"a", 0), 0xD24EC4F1A98C6E5B);
+        assert_eq!(xxhash64(b"abc", 0), 0x44BC2CF5AD770999);
+        assert_eq!(
+            xxhash64(b"Nobody inspects the spammish repetition", 0),
+            0xFBCEA83C8A378BF1
+        );
+    }
 }